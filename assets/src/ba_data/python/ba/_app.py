@@ -257,6 +257,11 @@ class App:
         self.special_offer: Optional[Dict] = None
         self.ping_thread_count = 0
         self.invite_confirm_windows: List[Any] = []  # FIXME: Don't use Any.
+
+        # Calls to receive connection-quality telemetry dicts whenever a
+        # client connection dies (see _hooks.client_connection_stats).
+        self.connection_stats_subscribers: List[Callable[[Dict[str, Any]],
+                                                         None]] = []
         self.store_layout: Optional[Dict[str, List[Dict[str, Any]]]] = None
         self.store_items: Optional[Dict[str, Dict]] = None
         self.pro_sale_start_time: Optional[int] = None
@@ -320,6 +320,19 @@ def filter_chat_message(msg: str, client_id: int) -> Optional[str]:
     return msg
 
 
+def client_connection_stats(info: Dict[str, Any]) -> None:
+    """Receive a connection's quality telemetry when it disconnects.
+
+    Called with a dict of rolling stats the C++ layer accumulated over
+    the connection's lifetime (rtt percentiles, loss/reorder counts,
+    compression ratio, bytes by message type, etc). Server scripts can
+    override this to forward reports to their dashboards; by default we
+    just hand it to any subscribers registered on the app.
+    """
+    for call in _ba.app.connection_stats_subscribers:
+        call(info)
+
+
 def local_chat_message(msg: str) -> None:
     if (_ba.app.ui.party_window is not None
             and _ba.app.ui.party_window() is not None):
@@ -50,6 +50,63 @@ void App::PushInterruptSignalSetupCall() {
   g_platform->SetupInterruptHandling();
 }
 
+// Memory-pressure responses registered by subsystems. These are never
+// unregistered so the list is simply static and leaks.
+struct MemoryPressureCallback {
+  MemoryPressureLevel threshold;
+  std::function<void(MemoryPressureLevel)> call;
+};
+static std::mutex g_memory_pressure_mutex;
+static std::vector<MemoryPressureCallback>* g_memory_pressure_callbacks{};
+
+auto App::AddMemoryPressureCallback(
+    MemoryPressureLevel threshold,
+    std::function<void(MemoryPressureLevel)> call) -> void {
+  std::lock_guard<std::mutex> lock(g_memory_pressure_mutex);
+  if (g_memory_pressure_callbacks == nullptr) {
+    g_memory_pressure_callbacks = new std::vector<MemoryPressureCallback>();
+  }
+  // Keep cheaper (lower-threshold) responses at the front so they run
+  // first when pressure hits.
+  auto& callbacks(*g_memory_pressure_callbacks);
+  auto pos = callbacks.end();
+  for (auto i = callbacks.begin(); i != callbacks.end(); ++i) {
+    if (i->threshold > threshold) {
+      pos = i;
+      break;
+    }
+  }
+  callbacks.insert(pos, {threshold, std::move(call)});
+}
+
+auto App::OnMemoryPressure(MemoryPressureLevel level) -> void {
+  assert(InMainThread());
+  if (level == MemoryPressureLevel::kCritical) {
+    Log("Got critical memory-pressure warning; trimming memory use.");
+  }
+
+  // Snapshot matching responses under the lock but run them outside it
+  // (they may take a moment or push calls that register more).
+  std::vector<std::function<void(MemoryPressureLevel)>> calls;
+  {
+    std::lock_guard<std::mutex> lock(g_memory_pressure_mutex);
+    if (g_memory_pressure_callbacks) {
+      for (auto&& callback : *g_memory_pressure_callbacks) {
+        if (callback.threshold <= level) {
+          calls.push_back(callback.call);
+        }
+      }
+    }
+  }
+  for (auto&& call : calls) {
+    call(level);
+  }
+}
+
+auto App::PushMemoryPressureCall(MemoryPressureLevel level) -> void {
+  PushCall([this, level] { OnMemoryPressure(level); });
+}
+
 void App::RunRenderUpkeepCycle() {
   // This should only be used in cases where the OS is handling the event loop.
   assert(!UsesEventLoop());
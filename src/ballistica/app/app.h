@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_APP_APP_H_
 #define BALLISTICA_APP_APP_H_
 
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -96,6 +97,21 @@ class App : public Module {
 
   virtual auto OnBootstrapComplete() -> void;
 
+  /// Register a response to OS memory warnings. The callback runs in the
+  /// main thread whenever pressure at or above the given threshold is
+  /// reported (push a call to your own thread from within it if needed).
+  /// Lower-threshold (cheaper) responses run first. Callbacks live for
+  /// the duration of the app; there is no unregister.
+  static auto AddMemoryPressureCallback(
+      MemoryPressureLevel threshold,
+      std::function<void(MemoryPressureLevel)> call) -> void;
+
+  /// Should be called by platform wrappers in the main thread when the
+  /// OS reports memory pressure (Android onTrimMemory, iOS memory
+  /// warnings, etc). Runs registered trim responses so we degrade
+  /// gracefully instead of getting killed at peak usage.
+  auto OnMemoryPressure(MemoryPressureLevel level) -> void;
+
   // Deferred calls that can be made from other threads.
 
   auto PushCursorUpdate(bool vis) -> void;
@@ -125,6 +141,7 @@ class App : public Module {
                             const std::string& telnet_password) -> void;
   auto PushShutdownCompleteCall() -> void;
   auto PushInterruptSignalSetupCall() -> void;
+  auto PushMemoryPressureCall(MemoryPressureLevel level) -> void;
 
  private:
   auto UpdatePauseResume() -> void;
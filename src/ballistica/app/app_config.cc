@@ -2,6 +2,7 @@
 
 #include "ballistica/app/app_config.h"
 
+#include <atomic>
 #include <utility>
 
 #include "ballistica/ballistica.h"
@@ -204,6 +205,9 @@ void AppConfig::SetupEntries() {
       BoolEntry("Disable Camera Shake", false);
   bool_entries_[BoolID::kDisableCameraGyro] =
       BoolEntry("Disable Camera Gyro", false);
+  bool_entries_[BoolID::kHalfRateWorld] = BoolEntry("Half Rate World", false);
+  bool_entries_[BoolID::kDynamicResolution] =
+      BoolEntry("Dynamic Resolution", false);
 
   // Now add everything to our name map and make sure all is kosher.
   CompleteMap(float_entries_);
@@ -244,4 +248,33 @@ auto AppConfig::Resolve(IntID id) -> int {
   return i->second.Resolve();
 }
 
+// Published snapshots. Superseded ones are intentionally leaked; they
+// are small, settings changes are rare, and freeing would require
+// knowing no reader still holds the old pointer.
+static std::atomic<const AppConfig::Snapshot*> g_config_snapshot{};
+
+auto AppConfig::snapshot() -> const Snapshot* {
+  return g_config_snapshot.load(std::memory_order_acquire);
+}
+
+void AppConfig::UpdateSnapshot() {
+  assert(InGameThread());
+  auto* s = new Snapshot();
+  for (auto&& i : float_entries_) {
+    s->floats_[static_cast<int>(i.first)] = i.second.Resolve();
+  }
+  for (auto&& i : int_entries_) {
+    s->ints_[static_cast<int>(i.first)] = i.second.Resolve();
+  }
+  for (auto&& i : bool_entries_) {
+    s->bools_[static_cast<int>(i.first)] = i.second.Resolve();
+  }
+  for (auto&& i : string_entries_) {
+    s->strings_[static_cast<int>(i.first)] = i.second.Resolve();
+  }
+  const Snapshot* prev = g_config_snapshot.load(std::memory_order_relaxed);
+  s->version_ = (prev != nullptr) ? prev->version() + 1 : 1;
+  g_config_snapshot.store(s, std::memory_order_release);
+}
+
 }  // namespace ballistica
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_APP_APP_CONFIG_H_
 #define BALLISTICA_APP_APP_CONFIG_H_
 
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <string>
@@ -63,6 +64,8 @@ class AppConfig {
     kEnableTelnet,
     kDisableCameraShake,
     kDisableCameraGyro,
+    kHalfRateWorld,
+    kDynamicResolution,
     kLast  // Sentinel.
   };
 
@@ -86,6 +89,43 @@ class AppConfig {
     std::string name_;
   };
 
+  // An immutable resolve of every typed config value. The game thread
+  // publishes a fresh one after each config load/apply (resolving
+  // values requires Python, so only it can build them); once published
+  // a snapshot never changes, making it safe to read lock-free from any
+  // thread. The version bumps with each publish so consumers can
+  // cheaply notice changes.
+  class Snapshot {
+   public:
+    auto Get(FloatID id) const -> float {
+      return floats_[static_cast<int>(id)];
+    }
+    auto Get(IntID id) const -> int { return ints_[static_cast<int>(id)]; }
+    auto Get(BoolID id) const -> bool {
+      return bools_[static_cast<int>(id)];
+    }
+    auto Get(StringID id) const -> const std::string& {
+      return strings_[static_cast<int>(id)];
+    }
+    auto version() const -> int64_t { return version_; }
+
+   private:
+    friend class AppConfig;
+    Snapshot() = default;
+    float floats_[static_cast<int>(FloatID::kLast)]{};
+    int ints_[static_cast<int>(IntID::kLast)]{};
+    bool bools_[static_cast<int>(BoolID::kLast)]{};
+    std::string strings_[static_cast<int>(StringID::kLast)];
+    int64_t version_{};
+  };
+
+  // Latest published snapshot; readable lock-free from any thread.
+  // Null until the game thread's first apply-config.
+  static auto snapshot() -> const Snapshot*;
+
+  // Resolve all values and publish a new snapshot (game thread only).
+  void UpdateSnapshot();
+
   static void Init();
   AppConfig();
 
@@ -81,6 +81,9 @@ class AppGlobals {
   millisecs_t real_time{};
   millisecs_t last_real_time_ticks{};
   std::mutex real_time_mutex;
+  int64_t real_time_microsecs{};
+  int64_t last_real_time_microsecs_raw{};
+  std::mutex real_time_microsecs_mutex;
   std::mutex thread_name_map_mutex;
   std::unordered_map<std::thread::id, std::string> thread_name_map;
 #if BA_DEBUG_BUILD
@@ -105,6 +105,13 @@ void VRApp::VRDrawEye(int eye, float yaw, float pitch, float roll, float tan_l,
   }
 }
 
+auto VRApp::VRSupportsSinglePassStereo() const -> bool {
+  if (!g_graphics_server || !g_graphics_server->renderer()) {
+    return false;
+  }
+  return g_graphics_server->renderer()->supports_single_pass_stereo();
+}
+
 }  // namespace ballistica
 
 #endif  // BA_VR_BUILD
@@ -38,6 +38,12 @@ class VRApp : public App {
                  float tan_r, float tan_b, float tan_t, float eye_x,
                  float eye_y, float eye_z, int viewport_x, int viewport_y);
 
+  /// Whether the renderer can consume both eyes in a single pass
+  /// (OVR_multiview2). Platform glue should check this after the renderer
+  /// exists when deciding how to lay out its swapchain; when false it
+  /// should keep calling VRDrawEye once per eye as always.
+  auto VRSupportsSinglePassStereo() const -> bool;
+
  private:
   FrameDef* vr_render_frame_def_{};
 };
@@ -27,7 +27,11 @@
 namespace ballistica {
 
 const int kAudioStreamBufferSize = 4096 * 8;
-const int kAudioStreamBufferCount = 7;
+
+// Streaming read-ahead depth. At 44.1khz stereo 16-bit this works out
+// to roughly four seconds decoded, which is enough to ride out the
+// audio thread being tied up by load storms.
+const int kAudioStreamBufferCount = 20;
 
 // Some OpenAL Error handling utils.
 auto GetALErrorString(ALenum err) -> const char*;
@@ -2,8 +2,10 @@
 
 #include "ballistica/audio/audio.h"
 
+#include "ballistica/audio/audio_occlusion_grid.h"
 #include "ballistica/audio/audio_server.h"
 #include "ballistica/audio/audio_source.h"
+#include "ballistica/media/data/collide_model_data.h"
 #include "ballistica/media/data/sound_data.h"
 
 namespace ballistica {
@@ -18,9 +20,47 @@ void Audio::Init() {
 
 void Audio::Reset() {
   assert(InGameThread());
+  occlusion_geometry_.clear();
   g_audio_server->PushResetCall();
 }
 
+void Audio::AddOcclusionGeometry(CollideModelData* model) {
+  assert(InGameThread());
+  assert(model);
+  occlusion_geometry_.emplace_back(model);
+  RebakeOcclusionGrid();
+}
+
+void Audio::RemoveOcclusionGeometry(CollideModelData* model) {
+  assert(InGameThread());
+  for (auto i = occlusion_geometry_.begin(); i != occlusion_geometry_.end();
+       ++i) {
+    if (i->get() == model) {
+      occlusion_geometry_.erase(i);
+      RebakeOcclusionGrid();
+      return;
+    }
+  }
+}
+
+void Audio::RebakeOcclusionGrid() {
+  assert(InGameThread());
+  if (occlusion_geometry_.empty()) {
+    g_audio_server->PushSetOcclusionGridCall(Object::Ref<AudioOcclusionGrid>());
+    return;
+  }
+
+  // Maps only carry a handful of terrain pieces so just rebaking the
+  // whole thing per change keeps this simple; it only happens at map
+  // setup/teardown time.
+  auto grid(Object::New<AudioOcclusionGrid>());
+  for (auto&& model : occlusion_geometry_) {
+    grid->AddGeometry(model.get());
+  }
+  grid->Bake();
+  g_audio_server->PushSetOcclusionGridCall(grid);
+}
+
 void Audio::SetVolumes(float music_volume, float sound_volume) {
   g_audio_server->PushSetVolumesCall(music_volume, sound_volume);
 }
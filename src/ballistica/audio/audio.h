@@ -57,6 +57,13 @@ class Audio {
 
   void AddClientSource(AudioSource* source);
 
+  // Baked audio occlusion: terrain registers its collide-models here as
+  // maps come and go; each change rebakes a coarse voxel grid from the
+  // full set and ships it to the audio server, which ducks positional
+  // voices playing through geometry (see AudioOcclusionGrid).
+  void AddOcclusionGeometry(CollideModelData* model);
+  void RemoveOcclusionGeometry(CollideModelData* model);
+
   void MakeSourceAvailable(AudioSource* source);
   auto available_sources_mutex() -> std::mutex& {
     return available_sources_mutex_;
@@ -64,6 +71,7 @@ class Audio {
 
  private:
   Audio();
+  void RebakeOcclusionGrid();
 
   // Flat list of client sources indexed by id.
   std::vector<AudioSource*> client_sources_;
@@ -75,6 +83,9 @@ class Audio {
 
   // This must be locked whenever accessing the availableSources list.
   std::mutex available_sources_mutex_;
+
+  // Collide-models currently contributing to the occlusion grid.
+  std::vector<Object::Ref<CollideModelData> > occlusion_geometry_;
 };
 
 }  // namespace ballistica
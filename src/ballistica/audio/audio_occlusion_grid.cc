@@ -0,0 +1,168 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/audio/audio_occlusion_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "ballistica/media/data/collide_model_data.h"
+
+namespace ballistica {
+
+// Cells are roughly this big; big maps get bigger cells so the grid
+// stays bounded (see kMaxGridDim).
+const float kOcclusionTargetCellSize = 1.0f;
+
+// Per-axis cell cap; 64^3 single bytes tops out at 256k for the
+// worst-case map.
+const int kMaxGridDim = 64;
+
+// Each solid cell the listener-to-source segment crosses adds this much
+// occlusion; roughly "three walls and you're inaudible".
+const float kOcclusionPerCell = 0.34f;
+
+AudioOcclusionGrid::AudioOcclusionGrid() {
+  assert(InGameThread());
+}
+
+void AudioOcclusionGrid::AddGeometry(CollideModelData* model) {
+  assert(InGameThread());
+  assert(!baked_);
+  assert(model);
+  const std::vector<dReal>& verts = model->vertices();
+  const std::vector<uint32_t>& indices = model->indices();
+  tri_verts_.reserve(tri_verts_.size() + indices.size() * 3);
+  for (uint32_t index : indices) {
+    assert(static_cast<size_t>(index) * 3 + 2 < verts.size());
+    tri_verts_.push_back(static_cast<float>(verts[index * 3]));
+    tri_verts_.push_back(static_cast<float>(verts[index * 3 + 1]));
+    tri_verts_.push_back(static_cast<float>(verts[index * 3 + 2]));
+  }
+}
+
+void AudioOcclusionGrid::Bake() {
+  assert(InGameThread());
+  assert(!baked_);
+  if (tri_verts_.empty()) {
+    baked_ = true;
+    return;
+  }
+
+  // Bounds of everything we got (plus a bit of padding so boundary
+  // geometry lands fully inside).
+  Vector3f bmin{tri_verts_[0], tri_verts_[1], tri_verts_[2]};
+  Vector3f bmax{bmin};
+  for (size_t i = 0; i < tri_verts_.size(); i += 3) {
+    bmin.x = std::min(bmin.x, tri_verts_[i]);
+    bmin.y = std::min(bmin.y, tri_verts_[i + 1]);
+    bmin.z = std::min(bmin.z, tri_verts_[i + 2]);
+    bmax.x = std::max(bmax.x, tri_verts_[i]);
+    bmax.y = std::max(bmax.y, tri_verts_[i + 1]);
+    bmax.z = std::max(bmax.z, tri_verts_[i + 2]);
+  }
+  bounds_min_ = bmin - Vector3f(0.5f, 0.5f, 0.5f);
+  Vector3f extent = (bmax + Vector3f(0.5f, 0.5f, 0.5f)) - bounds_min_;
+  float max_extent = std::max(extent.x, std::max(extent.y, extent.z));
+  cell_size_ = std::max(kOcclusionTargetCellSize,
+                        max_extent / static_cast<float>(kMaxGridDim));
+  dim_x_ = std::max(1, static_cast<int>(extent.x / cell_size_) + 1);
+  dim_y_ = std::max(1, static_cast<int>(extent.y / cell_size_) + 1);
+  dim_z_ = std::max(1, static_cast<int>(extent.z / cell_size_) + 1);
+  solid_.clear();
+  solid_.resize(static_cast<size_t>(dim_x_) * dim_y_ * dim_z_, 0);
+
+  // Mark each cell whose center sits close to a triangle's plane within
+  // that triangle's bounds. Conservative but plenty for coarse ducking.
+  float half_diag = 0.87f * cell_size_;
+  for (size_t i = 0; i < tri_verts_.size(); i += 9) {
+    Vector3f v0{tri_verts_[i], tri_verts_[i + 1], tri_verts_[i + 2]};
+    Vector3f v1{tri_verts_[i + 3], tri_verts_[i + 4], tri_verts_[i + 5]};
+    Vector3f v2{tri_verts_[i + 6], tri_verts_[i + 7], tri_verts_[i + 8]};
+    Vector3f normal = Vector3f::Cross(v1 - v0, v2 - v0);
+    float len = normal.Length();
+    if (len < 0.000001f) {
+      continue;  // Degenerate.
+    }
+    normal = normal / len;
+    Vector3f tmin{std::min(v0.x, std::min(v1.x, v2.x)),
+                  std::min(v0.y, std::min(v1.y, v2.y)),
+                  std::min(v0.z, std::min(v1.z, v2.z))};
+    Vector3f tmax{std::max(v0.x, std::max(v1.x, v2.x)),
+                  std::max(v0.y, std::max(v1.y, v2.y)),
+                  std::max(v0.z, std::max(v1.z, v2.z))};
+    int cx0 = std::max(
+        0, static_cast<int>((tmin.x - bounds_min_.x) / cell_size_));
+    int cy0 = std::max(
+        0, static_cast<int>((tmin.y - bounds_min_.y) / cell_size_));
+    int cz0 = std::max(
+        0, static_cast<int>((tmin.z - bounds_min_.z) / cell_size_));
+    int cx1 = std::min(
+        dim_x_ - 1, static_cast<int>((tmax.x - bounds_min_.x) / cell_size_));
+    int cy1 = std::min(
+        dim_y_ - 1, static_cast<int>((tmax.y - bounds_min_.y) / cell_size_));
+    int cz1 = std::min(
+        dim_z_ - 1, static_cast<int>((tmax.z - bounds_min_.z) / cell_size_));
+    for (int cz = cz0; cz <= cz1; cz++) {
+      for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+          Vector3f center{
+              bounds_min_.x + (static_cast<float>(cx) + 0.5f) * cell_size_,
+              bounds_min_.y + (static_cast<float>(cy) + 0.5f) * cell_size_,
+              bounds_min_.z + (static_cast<float>(cz) + 0.5f) * cell_size_};
+          if (std::abs((center - v0).Dot(normal)) <= half_diag) {
+            solid_[(cz * dim_y_ + cy) * dim_x_ + cx] = 1;
+          }
+        }
+      }
+    }
+  }
+
+  // Done with the raw triangles.
+  tri_verts_.clear();
+  tri_verts_.shrink_to_fit();
+  baked_ = true;
+}
+
+auto AudioOcclusionGrid::SampleOcclusion(const Vector3f& from,
+                                         const Vector3f& to) const -> float {
+  assert(baked_);
+  if (solid_.empty()) {
+    return 0.0f;
+  }
+  Vector3f diff = to - from;
+  float dist = diff.Length();
+
+  // Skip one cell's worth at each end; sources and listeners usually
+  // sit right against marked floor/wall cells and we don't want those
+  // counting as walls between them.
+  float margin = cell_size_;
+  if (dist <= 2.0f * margin) {
+    return 0.0f;
+  }
+  Vector3f dir = diff / dist;
+  float step = 0.5f * cell_size_;
+  int last_cell = -1;
+  int solid_cells = 0;
+  for (float t = margin; t < dist - margin; t += step) {
+    Vector3f p = from + dir * t;
+    int cx = static_cast<int>((p.x - bounds_min_.x) / cell_size_);
+    int cy = static_cast<int>((p.y - bounds_min_.y) / cell_size_);
+    int cz = static_cast<int>((p.z - bounds_min_.z) / cell_size_);
+    if (cx < 0 || cy < 0 || cz < 0 || cx >= dim_x_ || cy >= dim_y_
+        || cz >= dim_z_) {
+      last_cell = -1;
+      continue;  // Outside the map; air.
+    }
+    int cell = (cz * dim_y_ + cy) * dim_x_ + cx;
+    if (cell == last_cell) {
+      continue;
+    }
+    last_cell = cell;
+    if (solid_[cell] != 0) {
+      solid_cells++;
+    }
+  }
+  return std::min(1.0f, kOcclusionPerCell * static_cast<float>(solid_cells));
+}
+
+}  // namespace ballistica
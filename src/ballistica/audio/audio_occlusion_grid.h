@@ -0,0 +1,62 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_AUDIO_AUDIO_OCCLUSION_GRID_H_
+#define BALLISTICA_AUDIO_AUDIO_OCCLUSION_GRID_H_
+
+#include <vector>
+
+#include "ballistica/core/object.h"
+#include "ballistica/math/vector3f.h"
+
+namespace ballistica {
+
+/// A coarse voxel grid baked from collide-model geometry at map load.
+/// The audio server marches the listener-to-source segment through it
+/// to approximate how much geometry a sound is playing through - no
+/// runtime raycasts required. Build with AddGeometry()/Bake() on the
+/// game thread; once baked it's immutable and safe to sample from the
+/// audio thread.
+class AudioOcclusionGrid : public Object {
+ public:
+  AudioOcclusionGrid();
+
+  // We get built in the game thread and sampled in the audio thread;
+  // immutability after Bake() is what makes that safe.
+  auto GetThreadOwnership() const -> ThreadOwnership override {
+    return ThreadOwnership::kAny;
+  }
+
+  /// Pull triangles in from a loaded collide-model (game thread;
+  /// pre-bake only).
+  void AddGeometry(CollideModelData* model);
+
+  /// Voxelize everything collected so far; after this the grid is
+  /// immutable (game thread).
+  void Bake();
+  auto baked() const -> bool { return baked_; }
+
+  /// Approximate occlusion between two points, 0 (clear line) to 1
+  /// (fully blocked). Any thread once baked.
+  auto SampleOcclusion(const Vector3f& from, const Vector3f& to) const
+      -> float;
+
+ private:
+  auto CellSolid(int x, int y, int z) const -> bool {
+    return solid_[(z * dim_y_ + y) * dim_x_ + x] != 0;
+  }
+
+  // Collected triangles awaiting bake (xyz triples, 3 verts per tri).
+  std::vector<float> tri_verts_;
+
+  Vector3f bounds_min_{0.0f, 0.0f, 0.0f};
+  float cell_size_{1.0f};
+  int dim_x_{};
+  int dim_y_{};
+  int dim_z_{};
+  std::vector<uint8_t> solid_;
+  bool baked_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_AUDIO_AUDIO_OCCLUSION_GRID_H_
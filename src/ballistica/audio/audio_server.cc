@@ -3,6 +3,7 @@
 #include "ballistica/audio/audio_server.h"
 
 #include <algorithm>
+#include <cmath>
 #include <list>
 #include <memory>
 #include <string>
@@ -11,14 +12,19 @@
 #include "ballistica/app/app_globals.h"
 #include "ballistica/audio/al_sys.h"
 #include "ballistica/audio/audio.h"
+#include "ballistica/audio/audio_occlusion_grid.h"
 #include "ballistica/audio/audio_source.h"
 #include "ballistica/audio/audio_streamer.h"
 #include "ballistica/audio/ogg_stream.h"
+#include "ballistica/core/profiler.h"
+#include "ballistica/core/thread.h"
 #include "ballistica/game/game.h"
 #include "ballistica/generic/timer.h"
+#include "ballistica/graphics/frame_ledger.h"
 #include "ballistica/math/vector3f.h"
 #include "ballistica/media/data/sound_data.h"
 #include "ballistica/media/media.h"
+#include "ballistica/platform/platform.h"
 
 // Need to move away from OpenAL on Apple stuff.
 #if __clang__
@@ -40,6 +46,13 @@ const int kAudioProcessIntervalFade = 50;
 const int kAudioProcessIntervalPendingLoad = 1;
 const bool kShowInUseSounds = false;
 
+// Voice virtualization: we hand out this many logical sources to
+// clients but bind at most kMaxRealVoices of them to real AL sources
+// at once; the rest tick along virtually until the mix has room.
+const int kLogicalSourceCount = 64;
+const int kMaxRealVoices = 32;
+const int kVoiceRebalanceInterval = 250;
+
 int AudioServer::al_source_count_ = 0;
 
 /// Location for sound emission (server version).
@@ -95,6 +108,46 @@ class AudioServer::ThreadSource : public Object {
   void ExecPlay();
   void Update();
 
+  /// Whether we currently hold a real AL source.
+  auto bound() const -> bool {
+#if BA_ENABLE_AUDIO
+    return source_ != 0;
+#else
+    return false;
+#endif
+  }
+
+#if BA_ENABLE_AUDIO
+  /// Whether our real source can be taken away and given to a
+  /// higher-scoring voice. Music and streams always keep theirs.
+  auto CanBeVirtualized() const -> bool {
+    return bound() && is_actually_playing_ && !is_streamed_
+           && !current_is_music_;
+  }
+
+  /// Rough audibility score; higher-scoring voices get real sources
+  /// first. Music and streams always outrank one-shot effects.
+  auto VoiceScore() const -> float;
+
+  /// Give up our real AL source (pushing it on the server's free list),
+  /// continuing playback virtually from the current offset.
+  void Demote();
+
+  /// Take ownership of a real AL source and resume physical playback
+  /// from wherever our virtual playback has gotten to.
+  void Promote(ALuint source);
+
+  /// For an unbound voice: if our virtual playback window has passed,
+  /// clear our play state and return true.
+  auto CheckVirtualFinished() -> bool;
+
+  /// Where our virtual playback currently sits, in seconds.
+  auto GetVirtualPlayPosition() const -> float {
+    return virtual_offset_
+           + static_cast<float>(GetRealTime() - virtual_start_time_) / 1000.0f;
+  }
+#endif  // BA_ENABLE_AUDIO
+
  private:
   bool looping_ = false;
   std::unique_ptr<AudioSource> client_source_;
@@ -108,10 +161,38 @@ class AudioServer::ThreadSource : public Object {
   bool is_actually_playing_ = false;
   bool want_to_play_ = false;
 #if BA_ENABLE_AUDIO
+  // The real AL source we're currently bound to (0 = playing virtually).
   ALuint source_ = 0;
 #endif
   bool is_streamed_ = false;
 
+  // Cached source state so a promotion can re-apply everything the AL
+  // source would have been carrying.
+  float pos_x_{};
+  float pos_y_{};
+  float pos_z_{};
+  bool positional_ = true;
+
+  // Last values actually pushed to our AL source, so repeated updates
+  // with unchanged values skip the al call entirely. Invalidated
+  // whenever we pick up a (possibly recycled) source from the pool.
+  void InvalidateAppliedALState() {
+    applied_gain_ = -1.0f;
+    applied_pitch_ = -1.0f;
+    have_applied_pos_ = false;
+  }
+  float applied_gain_{-1.0f};
+  float applied_pitch_{-1.0f};
+  float applied_pos_x_{};
+  float applied_pos_y_{};
+  float applied_pos_z_{};
+  bool have_applied_pos_{};
+
+  // Virtual-playback bookkeeping.
+  float virtual_offset_{};
+  millisecs_t virtual_start_time_{};
+  float sound_duration_{};  // Seconds; 0 = unknown.
+
   /// Whether we should be designated as "music" next time we play.
   bool is_music_ = false;
 
@@ -191,101 +272,207 @@ void AudioServer::SetPaused(bool pause) {
   }
 }
 
-void AudioServer::PushSourceSetIsMusicCall(uint32_t play_id, bool val) {
-  PushCall([this, play_id, val] {
-    ThreadSource* s = GetPlayingSound(play_id);
-    if (s) {
-      s->SetIsMusic(val);
+auto AudioServer::SourceCommandCoalesces(SourceCommand::Type type) -> bool {
+  switch (type) {
+    case SourceCommand::Type::kIsMusic:
+    case SourceCommand::Type::kPositional:
+    case SourceCommand::Type::kPosition:
+    case SourceCommand::Type::kGain:
+    case SourceCommand::Type::kFade:
+    case SourceCommand::Type::kLooping:
+      return true;
+    default:
+      return false;
+  }
+}
+
+void AudioServer::PushSourceCommand(const SourceCommand& cmd) {
+  bool need_flush{};
+  {
+    std::lock_guard<std::mutex> lock(source_command_mutex_);
+    if (SourceCommandCoalesces(cmd.type)) {
+      // Overwrite a queued command of the same type for this source if
+      // there's one with no play/stop between it and us.
+      for (auto i = source_commands_.rbegin(); i != source_commands_.rend();
+           ++i) {
+        if (i->play_id != cmd.play_id) {
+          continue;
+        }
+        if (i->type == cmd.type) {
+          *i = cmd;
+          return;  // A flush is already queued for the existing entry.
+        }
+        if (!SourceCommandCoalesces(i->type)) {
+          break;
+        }
+      }
     }
-  });
+    source_commands_.push_back(cmd);
+    need_flush = !source_command_flush_queued_;
+    source_command_flush_queued_ = true;
+  }
+
+  // First command in an empty buffer pokes the audio thread once;
+  // everything else rides along for free until it drains.
+  if (need_flush) {
+    PushCall([this] { FlushSourceCommands(); });
+  }
 }
 
-void AudioServer::PushSourceSetPositionalCall(uint32_t play_id, bool val) {
-  PushCall([this, play_id, val] {
-    ThreadSource* s = GetPlayingSound(play_id);
-    if (s) {
-      s->SetPositional(val);
+void AudioServer::FlushSourceCommands() {
+  assert(InAudioThread());
+  {
+    std::lock_guard<std::mutex> lock(source_command_mutex_);
+    source_commands_drain_.swap(source_commands_);
+    source_command_flush_queued_ = false;
+  }
+  bool ran_play = false;
+  for (auto&& cmd : source_commands_drain_) {
+    ExecSourceCommand(cmd);
+    if (cmd.type == SourceCommand::Type::kPlay) {
+      ran_play = true;
     }
-  });
+  }
+  source_commands_drain_.clear();
+
+  // Let's take this opportunity to pass on newly available sources.
+  // This way the more things clients are playing, the more
+  // tight our source availability checking gets (instead of solely relying
+  // on our periodic process() calls).
+  if (ran_play) {
+    UpdateAvailableSources();
+  }
+}
+
+void AudioServer::ExecSourceCommand(const SourceCommand& cmd) {
+  assert(InAudioThread());
+  ThreadSource* s = GetPlayingSound(cmd.play_id);
+  switch (cmd.type) {
+    case SourceCommand::Type::kIsMusic:
+      if (s) {
+        s->SetIsMusic(cmd.bool_val);
+      }
+      break;
+    case SourceCommand::Type::kPositional:
+      if (s) {
+        s->SetPositional(cmd.bool_val);
+      }
+      break;
+    case SourceCommand::Type::kPosition:
+      if (s) {
+        s->SetPosition(cmd.pos.x, cmd.pos.y, cmd.pos.z);
+      }
+      break;
+    case SourceCommand::Type::kGain:
+      if (s) {
+        s->SetGain(cmd.float_val);
+      }
+      break;
+    case SourceCommand::Type::kFade:
+      if (s) {
+        s->SetFade(cmd.float_val);
+      }
+      break;
+    case SourceCommand::Type::kLooping:
+      if (s) {
+        s->SetLooping(cmd.bool_val);
+      }
+      break;
+    case SourceCommand::Type::kPlay:
+      // If this play command is valid, pass it along.
+      // Otherwise return it immediately for deletion.
+      if (s) {
+        s->Play(cmd.sound);
+      } else {
+        AddSoundRefDelete(cmd.sound);
+      }
+      break;
+    case SourceCommand::Type::kStop:
+      if (s) {
+        s->Stop();
+      }
+      break;
+    case SourceCommand::Type::kEnd:
+      assert(s);
+      s->client_source()->Lock(5);
+      s->client_source()->set_client_queue_size(
+          s->client_source()->client_queue_size() - 1);
+      assert(s->client_source()->client_queue_size() >= 0);
+      s->client_source()->Unlock();
+      break;
+  }
+}
+
+void AudioServer::PushSourceSetIsMusicCall(uint32_t play_id, bool val) {
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kIsMusic;
+  cmd.play_id = play_id;
+  cmd.bool_val = val;
+  PushSourceCommand(cmd);
+}
+
+void AudioServer::PushSourceSetPositionalCall(uint32_t play_id, bool val) {
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kPositional;
+  cmd.play_id = play_id;
+  cmd.bool_val = val;
+  PushSourceCommand(cmd);
 }
 
 void AudioServer::PushSourceSetPositionCall(uint32_t play_id,
                                             const Vector3f& p) {
-  PushCall([this, play_id, p] {
-    ThreadSource* s = GetPlayingSound(play_id);
-    if (s) {
-      s->SetPosition(p.x, p.y, p.z);
-    }
-  });
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kPosition;
+  cmd.play_id = play_id;
+  cmd.pos = p;
+  PushSourceCommand(cmd);
 }
 
 void AudioServer::PushSourceSetGainCall(uint32_t play_id, float val) {
-  PushCall([this, play_id, val] {
-    ThreadSource* s = GetPlayingSound(play_id);
-    if (s) {
-      s->SetGain(val);
-    }
-  });
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kGain;
+  cmd.play_id = play_id;
+  cmd.float_val = val;
+  PushSourceCommand(cmd);
 }
 
 void AudioServer::PushSourceSetFadeCall(uint32_t play_id, float val) {
-  PushCall([this, play_id, val] {
-    ThreadSource* s = GetPlayingSound(play_id);
-    if (s) {
-      s->SetFade(val);
-    }
-  });
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kFade;
+  cmd.play_id = play_id;
+  cmd.float_val = val;
+  PushSourceCommand(cmd);
 }
 
 void AudioServer::PushSourceSetLoopingCall(uint32_t play_id, bool val) {
-  PushCall([this, play_id, val] {
-    ThreadSource* s = GetPlayingSound(play_id);
-    if (s) {
-      s->SetLooping(val);
-    }
-  });
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kLooping;
+  cmd.play_id = play_id;
+  cmd.bool_val = val;
+  PushSourceCommand(cmd);
 }
 
 void AudioServer::PushSourcePlayCall(uint32_t play_id,
                                      Object::Ref<SoundData>* sound) {
-  PushCall([this, play_id, sound] {
-    ThreadSource* s = GetPlayingSound(play_id);
-
-    // If this play command is valid, pass it along.
-    // Otherwise return it immediately for deletion.
-    if (s) {
-      s->Play(sound);
-    } else {
-      AddSoundRefDelete(sound);
-    }
-
-    // Let's take this opportunity to pass on newly available sources.
-    // This way the more things clients are playing, the more
-    // tight our source availability checking gets (instead of solely relying on
-    // our periodic process() calls).
-    UpdateAvailableSources();
-  });
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kPlay;
+  cmd.play_id = play_id;
+  cmd.sound = sound;
+  PushSourceCommand(cmd);
 }
 
 void AudioServer::PushSourceStopCall(uint32_t play_id) {
-  PushCall([this, play_id] {
-    ThreadSource* s = GetPlayingSound(play_id);
-    if (s) {
-      s->Stop();
-    }
-  });
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kStop;
+  cmd.play_id = play_id;
+  PushSourceCommand(cmd);
 }
 
 void AudioServer::PushSourceEndCall(uint32_t play_id) {
-  PushCall([this, play_id] {
-    ThreadSource* s = GetPlayingSound(play_id);
-    assert(s);
-    s->client_source()->Lock(5);
-    s->client_source()->set_client_queue_size(
-        s->client_source()->client_queue_size() - 1);
-    assert(s->client_source()->client_queue_size() >= 0);
-    s->client_source()->Unlock();
-  });
+  SourceCommand cmd;
+  cmd.type = SourceCommand::Type::kEnd;
+  cmd.play_id = play_id;
+  PushSourceCommand(cmd);
 }
 
 void AudioServer::PushResetCall() {
@@ -295,15 +482,34 @@ void AudioServer::PushResetCall() {
 void AudioServer::PushSetListenerPositionCall(const Vector3f& p) {
   PushCall([this, p] {
 #if BA_ENABLE_AUDIO
+    listener_pos_ = p;
     if (!paused_) {
       ALfloat lpos[3] = {p.x, p.y, p.z};
       alListenerfv(AL_POSITION, lpos);
       CHECK_AL_ERROR;
+
+      // Listener movement changes what's occluded.
+      if (occlusion_grid_.exists()) {
+        for (auto&& i : sources_) {
+          i->UpdateVolume();
+        }
+      }
     }
 #endif  // BA_ENABLE_AUDIO
   });
 }
 
+void AudioServer::PushSetOcclusionGridCall(
+    const Object::Ref<AudioOcclusionGrid>& grid) {
+  PushCall([this, grid] {
+    assert(InAudioThread());
+    occlusion_grid_ = grid;
+    for (auto&& i : sources_) {
+      i->UpdateVolume();
+    }
+  });
+}
+
 void AudioServer::PushSetListenerOrientationCall(const Vector3f& forward,
                                                  const Vector3f& up) {
   PushCall([this, forward, up] {
@@ -385,8 +591,37 @@ AudioServer::AudioServer(Thread* thread) : Module("audio", thread) {
   alListenerfv(AL_ORIENTATION, listener_ori);
   CHECK_AL_ERROR;
 
-  // Create our sources.
-  int target_source_count = 30;
+  // Create our pool of real AL sources.
+  for (int i = 0; i < kMaxRealVoices; i++) {
+    ALuint source;
+    alGenSources(1, &source);
+    ALenum err = alGetError();
+    if (err != AL_NO_ERROR) {
+      Log("Error: Made " + std::to_string(i) + " AL sources; (wanted "
+          + std::to_string(kMaxRealVoices) + ").");
+      break;
+    }
+    // In vr mode we keep the microphone a bit closer to the camera
+    // for realism purposes, so we need stuff louder in general.
+    if (IsVRMode()) {
+      alSourcef(source, AL_MAX_DISTANCE, 100);
+      alSourcef(source, AL_REFERENCE_DISTANCE, 7.5f);
+    } else {
+      // In regular mode our mic is stuck closer to the action
+      // so less loudness is needed.
+      alSourcef(source, AL_MAX_DISTANCE, 100);
+      alSourcef(source, AL_REFERENCE_DISTANCE, 5.0f);
+    }
+    alSourcef(source, AL_ROLLOFF_FACTOR, 0.3f);
+    CHECK_AL_ERROR;
+    free_al_sources_.push_back(source);
+    al_source_count_++;
+  }
+
+  // Create our logical sources; these are what clients see, and more
+  // can play at once than we have real AL sources for (the least
+  // audible ones just tick along virtually).
+  int target_source_count = kLogicalSourceCount;
   for (int i = 0; i < target_source_count; i++) {
     bool valid = false;
     auto s(Object::New<AudioServer::ThreadSource>(this, i, &valid));
@@ -413,6 +648,13 @@ AudioServer::~AudioServer() {
 #if BA_ENABLE_AUDIO
   sound_source_refs_.clear();
 
+  // All real sources should be back on the free list now; kill them.
+  for (ALuint source : free_al_sources_) {
+    alDeleteSources(1, &source);
+    al_source_count_--;
+  }
+  free_al_sources_.clear();
+
   // Take down AL stuff.
   {
     ALCdevice* device;
@@ -484,6 +726,90 @@ void AudioServer::UpdateAvailableSources() {
 #endif
 }
 
+auto AudioServer::AcquireALSource(float score, bool steal) -> unsigned int {
+#if BA_ENABLE_AUDIO
+  assert(InAudioThread());
+  if (!free_al_sources_.empty()) {
+    ALuint source = free_al_sources_.back();
+    free_al_sources_.pop_back();
+    return source;
+  }
+  if (!steal) {
+    return 0;
+  }
+
+  // Everything's bound; look for the least-audible voice that scores
+  // below us and take its source.
+  ThreadSource* worst = nullptr;
+  float worst_score = 0.0f;
+  for (auto&& i : sources_) {
+    if (!i->CanBeVirtualized()) {
+      continue;
+    }
+    float s = i->VoiceScore();
+    if (worst == nullptr || s < worst_score) {
+      worst = i;
+      worst_score = s;
+    }
+  }
+  if (worst && worst_score < score) {
+    worst->Demote();  // Returns its source to the free list.
+    assert(!free_al_sources_.empty());
+    ALuint source = free_al_sources_.back();
+    free_al_sources_.pop_back();
+    return source;
+  }
+#endif  // BA_ENABLE_AUDIO
+  return 0;
+}
+
+void AudioServer::ReleaseALSource(unsigned int source) {
+#if BA_ENABLE_AUDIO
+  assert(InAudioThread());
+  assert(source != 0);
+  if (!paused_) {
+    alSourcei(source, AL_BUFFER, 0);
+    CHECK_AL_ERROR;
+  }
+  free_al_sources_.push_back(source);
+#endif  // BA_ENABLE_AUDIO
+}
+
+void AudioServer::RebalanceVoices() {
+#if BA_ENABLE_AUDIO
+  assert(InAudioThread());
+
+  // Promote the loudest virtual voices into real sources for as long as
+  // there's something free (or something quieter worth displacing).
+  for (int iteration = 0; iteration < kMaxRealVoices; iteration++) {
+    ThreadSource* best = nullptr;
+    float best_score = 0.0f;
+    for (auto&& i : sources_) {
+      if (i->bound() || !i->want_to_play() || i->is_streamed()) {
+        continue;
+      }
+      // Reclaim any whose playback window has quietly passed.
+      if (i->CheckVirtualFinished()) {
+        continue;
+      }
+      float s = i->VoiceScore();
+      if (best == nullptr || s > best_score) {
+        best = i;
+        best_score = s;
+      }
+    }
+    if (best == nullptr) {
+      break;
+    }
+    ALuint source = AcquireALSource(best_score, true);
+    if (source == 0) {
+      break;  // Nothing left worth displacing.
+    }
+    best->Promote(source);
+  }
+#endif  // BA_ENABLE_AUDIO
+}
+
 void AudioServer::StopSound(uint32_t play_id) {
   uint32_t source = source_id_from_play_id(play_id);
   uint32_t count = play_count_from_play_id(play_id);
@@ -577,7 +903,7 @@ void AudioServer::UpdateMusicPlayState() {
     // Flip music back on that should be playing.
     for (auto&& i : sources_) {
       if (i->current_is_music() && i->want_to_play()
-          && (!i->is_actually_playing())) {
+          && (!i->is_actually_playing()) && i->bound()) {
         i->ExecPlay();
       }
     }
@@ -591,6 +917,20 @@ void AudioServer::Process() {
 
   // If we're paused we don't do nothin'.
   if (!paused_) {
+    BA_PROFILE_SCOPE("audio-process");
+    bool ledger = FrameLedger::enabled();
+    int64_t ledger_start = ledger ? Platform::GetCurrentMicroseconds() : 0;
+    // Feed streaming sources first so loads can't starve them into an
+    // underrun; during load storms we also top them off every pass
+    // instead of on our usual relaxed schedule.
+    if (have_pending_loads_
+        || real_time - last_stream_process_time_ > 100) {
+      last_stream_process_time_ = real_time;
+      for (auto&& i : streaming_sources_) {
+        i->Update();
+      }
+    }
+
     // Do some loading...
     have_pending_loads_ = g_media->RunPendingAudioLoads();
 
@@ -603,16 +943,18 @@ void AudioServer::Process() {
       last_sound_fade_process_time_ = real_time;
     }
 
-    // Update streaming sources.
-    if (real_time - last_stream_process_time_ > 100) {
-      last_stream_process_time_ = real_time;
-      for (auto&& i : streaming_sources_) {
-        i->Update();
-      }
+    // Re-seat real AL sources on whichever voices are most audible.
+    if (real_time - last_voice_rebalance_time_ > kVoiceRebalanceInterval) {
+      last_voice_rebalance_time_ = real_time;
+      RebalanceVoices();
     }
 #if BA_ENABLE_AUDIO
     CHECK_AL_ERROR;
 #endif
+    if (ledger) {
+      FrameLedger::Add(FrameLedger::Lane::kAudio,
+                       Platform::GetCurrentMicroseconds() - ledger_start);
+    }
   }
   UpdateTimerInterval();
 }
@@ -623,6 +965,9 @@ void AudioServer::Reset() {
     i->Stop();
   }
   SetSoundPitch(1.0f);
+
+  // Whatever map this was baked for is going away.
+  occlusion_grid_.Clear();
 }
 
 void AudioServer::ProcessSoundFades() {
@@ -668,32 +1013,11 @@ AudioServer::ThreadSource::ThreadSource(AudioServer* audio_thread_in, int id_in,
     : id_(id_in), audio_thread_(audio_thread_in) {
 #if BA_ENABLE_AUDIO
   assert(valid_out != nullptr);
-  CHECK_AL_ERROR;
 
-  // Generate our sources.
-  alGenSources(1, &source_);
-  ALenum err = alGetError();
-  valid_ = (err == AL_NO_ERROR);
-  if (!valid_) {
-    Log(std::string("Error: AL Error ") + GetALErrorString(err)
-        + " on source creation.");
-  } else {
-    // In vr mode we keep the microphone a bit closer to the camera
-    // for realism purposes, so we need stuff louder in general.
-    if (IsVRMode()) {
-      alSourcef(source_, AL_MAX_DISTANCE, 100);
-      alSourcef(source_, AL_REFERENCE_DISTANCE, 7.5f);
-    } else {
-      // In regular mode our mic is stuck closer to the action
-      // so less loudness is needed.
-      alSourcef(source_, AL_MAX_DISTANCE, 100);
-      alSourcef(source_, AL_REFERENCE_DISTANCE, 5.0f);
-    }
-    alSourcef(source_, AL_ROLLOFF_FACTOR, 0.3f);
-    CHECK_AL_ERROR;
-  }
+  // We're purely logical now; real AL sources come and go from the
+  // server's pool as our audibility dictates.
+  valid_ = true;
   *valid_out = valid_;
-  if (valid_) al_source_count_++;
 
 #endif  // BA_ENABLE_AUDIO
 }
@@ -718,9 +1042,11 @@ AudioServer::ThreadSource::~ThreadSource() {
   assert(!is_actually_playing_ && !want_to_play_);
   assert(!source_sound_);
 
-  alDeleteSources(1, &source_);
-  CHECK_AL_ERROR;
-  al_source_count_--;
+  // If a paused shutdown left us holding a real source, give it back.
+  if (source_) {
+    audio_thread_->free_al_sources_.push_back(source_);
+    source_ = 0;
+  }
 
 #endif  // BA_ENABLE_AUDIO
 }
@@ -760,6 +1086,9 @@ void AudioServer::ThreadSource::UpdateAvailability() {
     // (and we cant ask AL cuz we have no context).
     if (g_audio_server->paused()) {
       busy = false;
+    } else if (!bound()) {
+      // Playing virtually; busy until our playback window passes.
+      busy = want_to_play_ && !CheckVirtualFinished();
     } else {
       ALint state;
       alGetSourcei(source_, AL_SOURCE_STATE, &state);
@@ -815,15 +1144,18 @@ void AudioServer::ThreadSource::SetLooping(bool loop) {
   looping_ = loop;
   if (!g_audio_server->paused()) {
 #if BA_ENABLE_AUDIO
-    alSourcei(source_, AL_LOOPING, loop);
-    CHECK_AL_ERROR;
+    if (bound()) {
+      alSourcei(source_, AL_LOOPING, loop);
+      CHECK_AL_ERROR;
+    }
 #endif
   }
 }
 
 void AudioServer::ThreadSource::SetPositional(bool p) {
 #if BA_ENABLE_AUDIO
-  if (!g_audio_server->paused()) {
+  positional_ = p;
+  if (!g_audio_server->paused() && bound()) {
     // TODO(ericf): Don't allow setting of positional
     //  on stereo sounds - we check this at initial play()
     //  but should do it here too.
@@ -863,9 +1195,25 @@ void AudioServer::ThreadSource::SetPosition(float x, float y, float z) {
           "Error: AudioServer::ThreadSource::SetPosition"
           " got out-of-bounds value.");
     }
-    ALfloat source_pos[] = {x, y, z};
-    alSourcefv(source_, AL_POSITION, source_pos);
-    CHECK_AL_ERROR;
+    pos_x_ = x;
+    pos_y_ = y;
+    pos_z_ = z;
+    if (bound()
+        && !(have_applied_pos_ && applied_pos_x_ == x && applied_pos_y_ == y
+             && applied_pos_z_ == z)) {
+      ALfloat source_pos[] = {x, y, z};
+      alSourcefv(source_, AL_POSITION, source_pos);
+      CHECK_AL_ERROR;
+      applied_pos_x_ = x;
+      applied_pos_y_ = y;
+      applied_pos_z_ = z;
+      have_applied_pos_ = true;
+
+      // Our occlusion (if any) just changed too.
+      if (positional_ && audio_thread_->occlusion_grid_.exists()) {
+        UpdateVolume();
+      }
+    }
   }
 #endif  // BA_ENABLE_AUDIO
 }
@@ -874,6 +1222,7 @@ void AudioServer::ThreadSource::SetPosition(float x, float y, float z) {
 void AudioServer::ThreadSource::ExecPlay() {
 #if BA_ENABLE_AUDIO
 
+  assert(bound());
   assert(source_sound_->exists());
   assert((**source_sound_).valid());
   assert((**source_sound_).loaded());
@@ -956,23 +1305,57 @@ auto AudioServer::ThreadSource::Play(const Object::Ref<SoundData>* sound)
     is_streamed_ = (**source_sound_).is_streamed();
     current_is_music_ = is_music_;
 
+    // Note our duration so virtual playback knows when it would end.
+    sound_duration_ = 0.0f;
+    if (!is_streamed_) {
+      auto bytes =
+          static_cast<float>((**source_sound_).GetApproxMemoryUse());
+      float channels =
+          ((**source_sound_).format() == AL_FORMAT_STEREO16) ? 2.0f : 1.0f;
+      auto freq = static_cast<float>((**source_sound_).freq());
+      if (freq > 0.0f) {
+        sound_duration_ = bytes / (freq * channels * 2.0f);
+      }
+    }
+
+    // Grab a real AL source if we rank high enough; otherwise we start
+    // out playing virtually and may get promoted later.
+    assert(!bound());
+    source_ = g_audio_server->AcquireALSource(VoiceScore(), true);
+    if (bound()) {
+      // Sources come back from the pool carrying another voice's state.
+      InvalidateAppliedALState();
+    }
+
     if (is_streamed_) {
-      streamer_ = Object::New<AudioStreamer, OggStream>(
-          (**source_sound_).file_name_full().c_str(), source_, looping_);
-    } else {
+      if (!bound()) {
+        // Shouldn't happen in practice; streams outrank everything
+        // except other streams.
+        BA_LOG_ONCE("Error: No real source available for streamed sound.");
+      } else {
+        streamer_ = Object::New<AudioStreamer, OggStream>(
+            (**source_sound_).file_name_full().c_str(), source_, looping_);
+      }
+    } else if (bound()) {
       alSourcei(source_, AL_BUFFER, (**source_sound_).buffer());
     }
     CHECK_AL_ERROR;
 
-    // Always update our volume and pitch here (we may be changing from music to
-    // nonMusic, etc)
-    UpdateVolume();
-    UpdatePitch();
+    if (bound()) {
+      // Always update our volume and pitch here (we may be changing from
+      // music to nonMusic, etc)
+      UpdateVolume();
+      UpdatePitch();
 
-    bool music_should_play = ((g_audio_server->music_volume_ > 0.000001f)
-                              && !g_audio_server->paused());
-    if ((!current_is_music_) || music_should_play) {
-      ExecPlay();
+      bool music_should_play = ((g_audio_server->music_volume_ > 0.000001f)
+                                && !g_audio_server->paused());
+      if ((!current_is_music_) || music_should_play) {
+        ExecPlay();
+      }
+    } else {
+      // Starting out virtual.
+      virtual_offset_ = 0.0f;
+      virtual_start_time_ = GetRealTime();
     }
   }
   want_to_play_ = true;
@@ -998,6 +1381,7 @@ void AudioServer::ThreadSource::ExecStop() {
       }
     }
   } else {
+    assert(bound());
     alSourceStop(source_);
     CHECK_AL_ERROR;
   }
@@ -1021,6 +1405,11 @@ void AudioServer::ThreadSource::Stop() {
     if (streamer_.exists()) {
       streamer_.Clear();
     }
+    // Toss our real source back in the pool for someone else.
+    if (source_) {
+      g_audio_server->ReleaseALSource(source_);
+      source_ = 0;
+    }
     // If we've got an attached sound, toss it back to the main thread
     // to free up...
     // (we can't kill media-refs outside of the main thread)
@@ -1037,15 +1426,28 @@ void AudioServer::ThreadSource::Stop() {
 void AudioServer::ThreadSource::UpdateVolume() {
 #if BA_ENABLE_AUDIO
   assert(InAudioThread());
-  if (!g_audio_server->paused()) {
+  if (!g_audio_server->paused() && bound()) {
     float val = gain_ * fade_;
     if (current_is_music()) {
       val *= audio_thread_->music_volume() / 7.0f;
     } else {
       val *= audio_thread_->sound_volume();
     }
-    alSourcef(source_, AL_GAIN, std::max(0.0f, val));
-    CHECK_AL_ERROR;
+
+    // Duck sounds the baked occlusion grid says are playing through
+    // map geometry. (not fully to zero; some energy always finds a way
+    // around).
+    if (positional_ && audio_thread_->occlusion_grid_.exists()) {
+      float occlusion = audio_thread_->occlusion_grid_->SampleOcclusion(
+          audio_thread_->listener_pos_, Vector3f(pos_x_, pos_y_, pos_z_));
+      val *= 1.0f - 0.8f * occlusion;
+    }
+    val = std::max(0.0f, val);
+    if (val != applied_gain_) {
+      alSourcef(source_, AL_GAIN, val);
+      CHECK_AL_ERROR;
+      applied_gain_ = val;
+    }
   }
 #endif  // BA_ENABLE_AUDIO
 }
@@ -1053,18 +1455,101 @@ void AudioServer::ThreadSource::UpdateVolume() {
 void AudioServer::ThreadSource::UpdatePitch() {
 #if BA_ENABLE_AUDIO
   assert(InAudioThread());
-  if (!g_audio_server->paused()) {
+  if (!g_audio_server->paused() && bound()) {
     float val = 1.0f;
     if (current_is_music()) {
     } else {
       val *= audio_thread_->sound_pitch();
     }
-    alSourcef(source_, AL_PITCH, val);
-    CHECK_AL_ERROR;
+    if (val != applied_pitch_) {
+      alSourcef(source_, AL_PITCH, val);
+      CHECK_AL_ERROR;
+      applied_pitch_ = val;
+    }
   }
 #endif  // BA_ENABLE_AUDIO
 }
 
+#if BA_ENABLE_AUDIO
+
+auto AudioServer::ThreadSource::VoiceScore() const -> float {
+  // Music and streams always outrank one-shot effects.
+  if (current_is_music_ || is_streamed_) {
+    return 9999.0f;
+  }
+  float score = gain_ * fade_;
+  if (positional_) {
+    float dx = pos_x_ - audio_thread_->listener_pos_.x;
+    float dy = pos_y_ - audio_thread_->listener_pos_.y;
+    float dz = pos_z_ - audio_thread_->listener_pos_.z;
+    float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+    score /= (1.0f + 0.1f * dist);
+  }
+  return score;
+}
+
+void AudioServer::ThreadSource::Demote() {
+  assert(InAudioThread());
+  assert(CanBeVirtualized());
+
+  // Snapshot where playback sits so a promotion can resume from there.
+  ALfloat offset = 0.0f;
+  alGetSourcef(source_, AL_SEC_OFFSET, &offset);
+  CHECK_AL_ERROR;
+  virtual_offset_ = offset;
+  virtual_start_time_ = GetRealTime();
+
+  alSourceStop(source_);
+  CHECK_AL_ERROR;
+  audio_thread_->ReleaseALSource(source_);
+  source_ = 0;
+  is_actually_playing_ = false;
+}
+
+void AudioServer::ThreadSource::Promote(ALuint source) {
+  assert(InAudioThread());
+  assert(!bound() && want_to_play_ && !is_streamed_);
+  assert(source_sound_ && source_sound_->exists());
+
+  source_ = source;
+  InvalidateAppliedALState();
+
+  // Re-apply everything the source would have been carrying.
+  alSourcei(source_, AL_BUFFER,
+            static_cast<ALint>((**source_sound_).buffer()));
+  alSourcei(source_, AL_LOOPING, looping_);
+  SetPositional(positional_);
+  SetPosition(pos_x_, pos_y_, pos_z_);
+  UpdateVolume();
+  UpdatePitch();
+
+  // Resume from wherever virtual playback has gotten to.
+  float play_pos = GetVirtualPlayPosition();
+  if (looping_ && sound_duration_ > 0.001f) {
+    play_pos = std::fmod(play_pos, sound_duration_);
+  }
+  alSourcef(source_, AL_SEC_OFFSET, play_pos);
+  alSourcePlay(source_);
+  CHECK_AL_ERROR;
+  is_actually_playing_ = true;
+}
+
+auto AudioServer::ThreadSource::CheckVirtualFinished() -> bool {
+  assert(!bound());
+  if (looping_) {
+    return false;
+  }
+  // If we don't know our length, assume anything this old is done.
+  float duration = (sound_duration_ > 0.001f) ? sound_duration_ : 30.0f;
+  if (GetVirtualPlayPosition() >= duration) {
+    want_to_play_ = false;
+    return true;
+  }
+  return false;
+}
+
+#endif  // BA_ENABLE_AUDIO
+
 void AudioServer::PushSetVolumesCall(float music_volume, float sound_volume) {
   PushCall([this, music_volume, sound_volume] {
     SetSoundVolume(sound_volume);
@@ -1088,13 +1573,13 @@ void AudioServer::PushSetPausedCall(bool pause) {
 void AudioServer::PushComponentUnloadCall(
     const std::vector<Object::Ref<MediaComponentData>*>& components) {
   PushCall([this, components] {
-    // Unload all components we were passed..
+    // Unload all components we were passed and drop the refs right
+    // here (media components count refs atomically, so no need to ship
+    // these back to the game thread just to die).
     for (auto&& i : components) {
       (**i).Unload();
+      delete i;
     }
-    // ..and then ship these pointers back to the game thread so it can free the
-    // references
-    g_game->PushFreeMediaComponentRefsCall(components);
   });
 }
 
@@ -1127,6 +1612,11 @@ void AudioServer::BeginInterruption() {
   assert(!InAudioThread());
   g_audio_server->PushSetPausedCall(true);
 
+  // We're about to sleep waiting for that push to land; if it got
+  // coalesced into our thread-local batch, ship it now or it'll sit
+  // there the whole wait.
+  Thread::FlushRunnableBatches();
+
   // Wait a reasonable amount of time for the thread to act on it.
   millisecs_t t = GetRealTime();
   while (true) {
@@ -1149,6 +1639,10 @@ void AudioServer::EndInterruption() {
   assert(!InAudioThread());
   g_audio_server->PushSetPausedCall(false);
 
+  // As in BeginInterruption: don't sleep on a push we may still be
+  // holding in our local batch.
+  Thread::FlushRunnableBatches();
+
   // Wait a reasonable amount of time for the thread to act on it.
   millisecs_t t = GetRealTime();
   while (true) {
@@ -5,9 +5,11 @@
 
 #include <map>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include "ballistica/core/module.h"
+#include "ballistica/math/vector3f.h"
 
 namespace ballistica {
 
@@ -37,6 +39,9 @@ class AudioServer : public Module {
   void PushSetListenerPositionCall(const Vector3f& p);
   void PushSetListenerOrientationCall(const Vector3f& forward,
                                       const Vector3f& up);
+
+  /// Swap in a freshly-baked occlusion grid (or an empty ref for none).
+  void PushSetOcclusionGridCall(const Object::Ref<AudioOcclusionGrid>& grid);
   void PushResetCall();
   void PushHavePendingLoadsCall();
   void PushComponentUnloadCall(
@@ -62,6 +67,36 @@ class AudioServer : public Module {
   void PushSourceStopCall(uint32_t play_id);
   void PushSourceEndCall(uint32_t play_id);
 
+  // Cross-thread source commands get batched into a flat buffer and
+  // applied by the audio thread in a single wake instead of one
+  // thread-message apiece; repeated set-style commands for the same
+  // source coalesce to their latest value while queued.
+  struct SourceCommand {
+    enum class Type : uint8_t {
+      kIsMusic,
+      kPositional,
+      kPosition,
+      kGain,
+      kFade,
+      kLooping,
+      kPlay,
+      kStop,
+      kEnd
+    };
+    Type type{};
+    uint32_t play_id{};
+    bool bool_val{};
+    float float_val{};
+    Vector3f pos{0.0f, 0.0f, 0.0f};
+    Object::Ref<SoundData>* sound{};
+  };
+  // Which command types can be collapsed to their latest value while
+  // queued. Play/stop/end are ordering barriers and always append.
+  static auto SourceCommandCoalesces(SourceCommand::Type type) -> bool;
+  void PushSourceCommand(const SourceCommand& cmd);
+  void FlushSourceCommands();
+  void ExecSourceCommand(const SourceCommand& cmd);
+
   void SetPaused(bool paused);
 
   // Fade a playing sound out over the given time.  If it is already
@@ -91,6 +126,15 @@ class AudioServer : public Module {
   void UpdateMusicPlayState();
   void ProcessSoundFades();
 
+  // Voice virtualization: a fixed pool of real AL sources is shared
+  // among a larger set of logical sources; only the highest-scoring
+  // voices are bound to real ones at any given time and the rest play
+  // on silently as cheap bookkeeping.
+  // (values are ALuints; avoiding AL includes here).
+  auto AcquireALSource(float score, bool steal) -> unsigned int;
+  void ReleaseALSource(unsigned int source);
+  void RebalanceVoices();
+
   // Some threads such as audio hold onto allocated Media-Component-Refs to keep
   // media components alive that they need.  Media-Component-Refs, however, must
   // be disposed of in the game thread, so they are passed back to it through
@@ -115,6 +159,15 @@ class AudioServer : public Module {
   std::vector<ThreadSource*> streaming_sources_;
   millisecs_t last_stream_process_time_{};
 
+  /// Real AL sources not currently bound to a voice. (values are ALuints)
+  std::vector<unsigned int> free_al_sources_;
+  Vector3f listener_pos_{0.0f, 0.0f, 0.0f};
+  millisecs_t last_voice_rebalance_time_{};
+
+  // Baked map occlusion; positional voices duck based on how much of it
+  // sits between them and the listener. Empty means no occlusion.
+  Object::Ref<AudioOcclusionGrid> occlusion_grid_;
+
   // Holds refs to all sources.
   // Use sources, not this, for faster iterating.
   std::vector<Object::Ref<ThreadSource> > sound_source_refs_;
@@ -124,6 +177,11 @@ class AudioServer : public Module {
   // forward-declared template params with them.
   std::map<int, SoundFadeNode> sound_fade_nodes_;
 
+  std::mutex source_command_mutex_;
+  std::vector<SourceCommand> source_commands_;
+  std::vector<SourceCommand> source_commands_drain_;
+  bool source_command_flush_queued_{};
+
   // This mutex controls access to our list of media component shared ptrs to
   // delete in the main thread.
   std::mutex sound_ref_delete_list_mutex_;
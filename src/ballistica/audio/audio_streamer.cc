@@ -13,6 +13,9 @@
 namespace ballistica {
 
 #if BA_ENABLE_AUDIO
+
+int AudioStreamer::total_underrun_count_ = 0;
+
 AudioStreamer::AudioStreamer(const char* file_name, ALuint source_in, bool loop)
     : source_(source_in), file_name_(file_name), loops_(loop) {
   assert(InAudioThread());
@@ -104,9 +107,12 @@ void AudioStreamer::Update() {
   CHECK_AL_ERROR;
 
   if (state != AL_PLAYING) {
-    printf("AudioServer::Streamer: restarting playback\n");
-    fflush(stdout);
-
+    // We drained our entire read-ahead; note it for telemetry and
+    // restart playback.
+    underrun_count_++;
+    total_underrun_count_++;
+    Log("AudioStreamer underrun (" + file_name_ + "); "
+        + std::to_string(total_underrun_count_) + " total this run.");
     alSourcePlay(source_);
     CHECK_AL_ERROR;
   }
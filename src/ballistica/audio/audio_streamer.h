@@ -38,6 +38,11 @@ class AudioStreamer : public Object {
   auto loops() const -> bool { return loops_; }
   auto file_name() const -> const std::string& { return file_name_; }
 
+  // Underrun telemetry: times this stream (or any stream this run)
+  // fully drained its read-ahead and had to restart playback.
+  auto underrun_count() const -> int { return underrun_count_; }
+  static auto total_underrun_count() -> int { return total_underrun_count_; }
+
  protected:
   virtual void DoStop() = 0;
   virtual void DoStream(char* pcm, int* size, unsigned int* rate) = 0;
@@ -53,6 +58,8 @@ class AudioStreamer : public Object {
   std::string file_name_;
   bool loops_ = false;
   bool eof_ = false;
+  int underrun_count_ = 0;
+  static int total_underrun_count_;
 };
 
 #endif  // BA_ENABLE_AUDIO
@@ -11,8 +11,10 @@
 #include "ballistica/core/thread.h"
 #include "ballistica/dynamics/bg/bg_dynamics_server.h"
 #include "ballistica/game/account.h"
+#include "ballistica/generic/job_pool.h"
 #include "ballistica/graphics/graphics_server.h"
 #include "ballistica/media/media_server.h"
+#include "ballistica/networking/http_client_module.h"
 #include "ballistica/networking/network_write_module.h"
 #include "ballistica/platform/platform.h"
 #include "ballistica/python/python.h"
@@ -39,6 +41,7 @@ BGDynamics* g_bg_dynamics{};
 BGDynamicsServer* g_bg_dynamics_server{};
 Platform* g_platform{};
 Utils* g_utils{};
+JobPool* g_job_pool{};
 UI* g_ui{};
 Graphics* g_graphics{};
 Python* g_python{};
@@ -52,12 +55,51 @@ StdInputModule* g_std_input_module{};
 NetworkReader* g_network_reader{};
 Networking* g_networking{};
 NetworkWriteModule* g_network_write_module{};
+HttpClientModule* g_http_client_module{};
 TextGraphics* g_text_graphics{};
 
+// Pin all our engine threads to the cores listed (comma-separated) in
+// the BA_CPU_AFFINITY env var, if set. Server boxes running dozens of
+// headless instances give each one a slice of a single NUMA node this
+// way, which keeps every thread's memory traffic on-node.
+static void ApplyCPUAffinityFromEnv() {
+  const char* affinity_env = getenv("BA_CPU_AFFINITY");
+  if (affinity_env == nullptr) {
+    return;
+  }
+  std::vector<int> cpus;
+  int val{};
+  bool have_digits{};
+  for (const char* c = affinity_env;; c++) {
+    if (*c >= '0' && *c <= '9') {
+      val = val * 10 + (*c - '0');
+      have_digits = true;
+    } else {
+      if (have_digits) {
+        cpus.push_back(val);
+      }
+      val = 0;
+      have_digits = false;
+      if (*c == 0) {
+        break;
+      }
+    }
+  }
+  if (cpus.empty()) {
+    return;
+  }
+  g_main_thread->SetCPUAffinity(cpus);
+  for (auto&& thread : g_app_globals->pausable_threads) {
+    thread->SetCPUAffinity(cpus);
+  }
+}
+
 // Basic overview of our bootstrapping process:
 // 1: All threads and globals are created and provisioned. Everything above
 //    should exist at the end of this step (if it is going to exist).
-//    Threads should not be talking to each other yet at this point.
+//    Independent module setups run concurrently on their threads during
+//    this step (see the staging below), but threads should not be talking
+//    to each other yet at this point.
 // 2: The system is set in motion. Game thread is told to load/apply the config.
 //    This kicks off an initial-screen-creation message sent to the
 //    graphics-server thread. Other systems are informed that bootstrapping
@@ -90,6 +132,15 @@ auto BallisticaMain(int argc, char** argv) -> int {
     g_platform->PostInit();
     g_account = new Account();
     g_utils = new Utils();
+
+    // Shared worker pool for fork/join work (ParallelFor and friends).
+    // Sized to whatever cores are left after our fixed threads so
+    // fanning a game-thread update out across it doesn't just fight
+    // the graphics/audio/etc threads for time.
+    g_job_pool = new JobPool(
+        std::min(6, std::max(0, static_cast<int>(
+                                    std::thread::hardware_concurrency())
+                                    - 2)));
     Scene::Init();
 
     // Create a Thread wrapper around the current (main) thread.
@@ -107,18 +158,51 @@ auto BallisticaMain(int argc, char** argv) -> int {
     g_app_globals->pausable_threads.push_back(game_thread);
     auto* network_write_thread = new Thread(ThreadIdentifier::kNetworkWrite);
     g_app_globals->pausable_threads.push_back(network_write_thread);
-
-    // And add our other standard modules to them.
-    game_thread->AddModule<Game>();
-    network_write_thread->AddModule<NetworkWriteModule>();
-    media_thread->AddModule<MediaServer>();
+    auto* http_client_thread = new Thread(ThreadIdentifier::kHttpClient);
+    g_app_globals->pausable_threads.push_back(http_client_thread);
+
+    // And add our other standard modules to them. Rather than paying
+    // for each module's setup in sequence, stage this as a little
+    // dependency graph: bring-ups with no edges between them get kicked
+    // off together and run concurrently on their own threads, and we
+    // only block where something genuinely needs a previous stage.
+
+    // Stage 1: the game module (which includes our Python interpreter
+    // init; by far the most expensive single item) plus the media and
+    // network-write modules have no dependencies on each other or on
+    // anything below; get them all cooking.
+    game_thread->BeginAddModule<Game>();
+    media_thread->BeginAddModule<MediaServer>();
+    network_write_thread->BeginAddModule<NetworkWriteModule>();
+    http_client_thread->BeginAddModule<HttpClientModule>();
+
+    // Meanwhile the graphics-server lives in this thread, so its setup
+    // runs here in parallel with the above.
     g_main_thread->AddModule<GraphicsServer>();
-    audio_thread->AddModule<AudioServer>();
 
-    // Now let the platform spin up any other threads/modules it uses.
-    // (bg-dynamics in non-headless builds, stdin/stdout where applicable, etc.)
+    // Stage 2: the audio-server hooks its sources up to g_audio, which
+    // the game module creates, so that edge has to wait on the game
+    // module. (The device open that follows still overlaps with the
+    // game thread's Python script loading and everything below.)
+    game_thread->WaitForModuleAdd();
+    audio_thread->BeginAddModule<AudioServer>();
+
+    // Now let the platform spin up any other threads/modules it uses
+    // (bg-dynamics in non-headless builds, stdin/stdout where
+    // applicable, etc.) while the audio device is opening.
     g_platform->CreateAuxiliaryModules();
 
+    // Stage 3: join the stragglers; everything must exist before we
+    // declare ourselves bootstrapped and let threads talk.
+    media_thread->WaitForModuleAdd();
+    network_write_thread->WaitForModuleAdd();
+    http_client_thread->WaitForModuleAdd();
+    audio_thread->WaitForModuleAdd();
+
+    // With the full thread roster up, apply any per-instance cpu
+    // pinning requested by our environment.
+    ApplyCPUAffinityFromEnv();
+
     // Ok at this point we can be considered up-and-running.
     g_app_globals->is_bootstrapped = true;
 
@@ -200,6 +284,24 @@ auto GetRealTime() -> millisecs_t {
   return g_app_globals->real_time;
 }
 
+auto GetRealTimeMicrosecs() -> int64_t {
+  // Same filtering dance as GetRealTime() above, just in the
+  // microsecond domain (fed by the monotonic nanosecond clock).
+  int64_t t = Platform::GetCurrentNanoseconds() / 1000;
+  std::lock_guard<std::mutex> lock(g_app_globals->real_time_microsecs_mutex);
+  if (t != g_app_globals->last_real_time_microsecs_raw) {
+    int64_t passed = t - g_app_globals->last_real_time_microsecs_raw;
+    if (passed < 0) {
+      passed = 0;
+    } else if (passed > 250000) {
+      passed = 250000;
+    }
+    g_app_globals->real_time_microsecs += passed;
+    g_app_globals->last_real_time_microsecs_raw = t;
+  }
+  return g_app_globals->real_time_microsecs;
+}
+
 auto FatalError(const std::string& message) -> void {
   FatalError::ReportFatalError(message, false);
   bool exit_cleanly = !IsUnmodifiedBlessedBuild();
@@ -258,6 +360,10 @@ auto InNetworkWriteThread() -> bool {
           && g_network_write_module->thread()->IsCurrent());
 }
 
+auto InHttpClientThread() -> bool {
+  return (g_http_client_module && g_http_client_module->thread()->IsCurrent());
+}
+
 auto GetInterfaceType() -> UIScale { return g_app_globals->ui_scale; }
 
 void Log(const std::string& msg, bool to_stdout, bool to_server) {
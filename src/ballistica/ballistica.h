@@ -99,8 +99,13 @@ const int kBaseVirtualResY = 680;
 
 // Magic numbers at the start of our file types.
 const int kBrpFileID = 83749;
+
+// Recompressed replay container (lzss blocks wrapping a raw .brp
+// stream; see MediaServer::RecompressReplay).
+const int kBrpzFileID = 83751;
 const int kBobFileID = 45623;
 const int kCobFileID = 13466;
+const int kPakFileID = 77261;
 
 const float kPi = 3.1415926535897932384626433832795028841971693993751f;
 const float kPiDeg = kPi / 180.0f;
@@ -125,10 +130,13 @@ extern AudioServer* g_audio_server;
 extern BGDynamics* g_bg_dynamics;
 extern BGDynamicsServer* g_bg_dynamics_server;
 extern Context* g_context;
+extern const Context* g_context_current;
 extern Game* g_game;
 extern Graphics* g_graphics;
 extern GraphicsServer* g_graphics_server;
+extern HttpClientModule* g_http_client_module;
 extern Input* g_input;
+extern JobPool* g_job_pool;
 extern Thread* g_main_thread;
 extern Media* g_media;
 extern MediaServer* g_media_server;
@@ -210,6 +218,7 @@ auto InAudioThread() -> bool;
 auto InBGDynamicsThread() -> bool;
 auto InMediaThread() -> bool;
 auto InNetworkWriteThread() -> bool;
+auto InHttpClientThread() -> bool;
 
 /// Return a human-readable name for the current thread.
 auto GetCurrentThreadName() -> std::string;
@@ -240,13 +249,15 @@ inline auto HeadlessMode() -> bool {
 /// by significant amounts (even if the app has been sleeping or whatnot).
 auto GetRealTime() -> millisecs_t;
 
-/// Return a random float value.  Not guaranteed to be deterministic or
-/// consistent across platforms.
-inline auto RandomFloat() -> float {
-  // FIXME: should convert this to something thread-safe.
-  return static_cast<float>(
-      (static_cast<double>(rand()) / RAND_MAX));  // NOLINT
-}
+/// Microsecond version of GetRealTime(); same filtering guarantees.
+/// Use this for scheduling where millisecond granularity is too coarse
+/// (thread timers and the like).
+auto GetRealTimeMicrosecs() -> int64_t;
+
+/// Return a random float value in [0, 1). Thread-safe (each thread
+/// draws from its own counter-based stream; see Random::FillUniform)
+/// but not guaranteed consistent across platforms.
+auto RandomFloat() -> float;
 
 auto SetPythonException(PyExcType python_type, const char* description) -> void;
 
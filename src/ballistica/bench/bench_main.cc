@@ -0,0 +1,245 @@
+// Released under the MIT License. See LICENSE for details.
+
+// Standalone microbenchmark runner (the ballisticacore-bench cmake
+// target). Exercises known hot kernels in isolation with fixed
+// iteration counts and prints JSON results on stdout so CI can diff
+// numbers across commits. Build Release; debug numbers are noise.
+
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "ballistica/app/app_globals.h"
+#include "ballistica/ballistica.h"
+#include "ballistica/generic/buffer.h"
+#include "ballistica/generic/huffman.h"
+#include "ballistica/generic/lambda_runnable.h"
+#include "ballistica/generic/timer.h"
+#include "ballistica/generic/timer_list.h"
+#include "ballistica/generic/utils.h"
+#include "ballistica/graphics/render_command_buffer.h"
+#include "ballistica/math/matrix44f.h"
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+namespace {
+
+struct Benchmark {
+  const char* name;
+  int iterations;
+  std::function<void(int)> run;
+};
+
+// Tiny deterministic generator so inputs are identical across runs
+// and platforms (rand() implementations vary).
+uint32_t g_rand_state{0x12345678u};
+auto NextRand() -> uint32_t {
+  g_rand_state ^= g_rand_state << 13u;
+  g_rand_state ^= g_rand_state >> 17u;
+  g_rand_state ^= g_rand_state << 5u;
+  return g_rand_state;
+}
+
+// Results get folded in here so the optimizer can't drop work.
+volatile uint32_t g_sink{};
+
+// A plausible game packet: runs of zeros/small values with some noise,
+// which is roughly what the huffman tables were trained on.
+auto MakePacket(size_t size) -> std::vector<uint8_t> {
+  std::vector<uint8_t> packet(size);
+  for (size_t i = 0; i < size; ++i) {
+    uint32_t r = NextRand();
+    packet[i] = ((r & 3u) != 0) ? static_cast<uint8_t>(r & 15u)
+                                : static_cast<uint8_t>(r >> 24u);
+  }
+  return packet;
+}
+
+void BenchHuffmanCompress(int iterations) {
+  Huffman huffman;
+  std::vector<uint8_t> packet = MakePacket(1024);
+  for (int i = 0; i < iterations; ++i) {
+    g_sink += static_cast<uint32_t>(huffman.compress(packet).size());
+  }
+}
+
+void BenchHuffmanDecompress(int iterations) {
+  Huffman huffman;
+  std::vector<uint8_t> compressed = huffman.compress(MakePacket(1024));
+  for (int i = 0; i < iterations; ++i) {
+    g_sink += static_cast<uint32_t>(huffman.decompress(compressed).size());
+  }
+}
+
+void BenchMatrix44fMultiply(int iterations) {
+  Matrix44f a = Matrix44fTranslate(1.0f, 2.0f, 3.0f);
+  Matrix44f b = Matrix44fScale(0.999f);
+  Matrix44f m = kMatrix44fIdentity;
+  for (int i = 0; i < iterations; ++i) {
+    m = m * a;
+    m = m * b;
+  }
+  g_sink += static_cast<uint32_t>(m.m[0]);
+}
+
+void BenchTimerListChurn(int iterations) {
+  TimerList list;
+  auto runnable = NewLambdaRunnable([] { g_sink += 1; });
+  TimerMedium now = 0;
+  for (int i = 0; i < iterations; ++i) {
+    // Create a handful of staggered repeaters, run time past them a few
+    // times, then tear them down; mimics scene timer traffic.
+    int ids[8];
+    for (int j = 0; j < 8; ++j) {
+      ids[j] = list.NewTimer(now, 1 + j, 0, -1, runnable)->id();
+    }
+    for (int j = 0; j < 4; ++j) {
+      now += 3;
+      list.Run(now);
+    }
+    for (int id : ids) {
+      list.DeleteTimer(id);
+    }
+  }
+}
+
+void BenchRenderCommandBufferEncodeDecode(int iterations) {
+  RenderCommandBuffer buffer;
+  for (int i = 0; i < iterations; ++i) {
+    buffer.Reset();
+    for (int j = 0; j < 100; ++j) {
+      buffer.BeginSortBlock(
+          RenderCommandBuffer::MakeSortKey(j & 3, (j * 7) & 31));
+      buffer.PutCommand(RenderCommandBuffer::Command::kScaleUniform);
+      buffer.PutFloat(1.25f);
+      buffer.PutCommand(RenderCommandBuffer::Command::kTranslate3);
+      buffer.PutFloats(1.0f, 2.0f, static_cast<float>(j));
+      buffer.PutCommand(RenderCommandBuffer::Command::kRotate);
+      buffer.PutFloats(90.0f, 0.0f, 1.0f, 0.0f);
+      buffer.EndSortBlock();
+    }
+    buffer.Finalize();
+    buffer.ReadBegin();
+    float total{};
+    bool done{};
+    while (!done) {
+      switch (buffer.GetCommand()) {
+        case RenderCommandBuffer::Command::kScaleUniform:
+          total += buffer.GetFloat();
+          break;
+        case RenderCommandBuffer::Command::kTranslate3: {
+          float x, y, z;
+          buffer.GetFloats(&x, &y, &z);
+          total += x + y + z;
+          break;
+        }
+        case RenderCommandBuffer::Command::kRotate: {
+          float angle, x, y, z;
+          buffer.GetFloats(&angle, &x, &y, &z);
+          total += angle + x + y + z;
+          break;
+        }
+        case RenderCommandBuffer::Command::kEnd:
+          done = true;
+          break;
+        default:
+          break;
+      }
+    }
+    g_sink += static_cast<uint32_t>(total);
+  }
+}
+
+void BenchUTF8Validate(int iterations) {
+  std::vector<std::string> samples{
+      "A perfectly ordinary ascii status string.",
+      "sc\xc3\xb6res: 1\xe2\x82\xac per flag \xf0\x9f\x8f\x81 captured",
+      std::string(512, 'x') + "\xe4\xb8\xad\xe6\x96\x87"};
+  for (int i = 0; i < iterations; ++i) {
+    for (auto&& s : samples) {
+      g_sink += static_cast<uint32_t>(Utils::IsValidUTF8(s));
+    }
+  }
+}
+
+void BenchBufferCopySmall(int iterations) {
+  // Fits in Buffer's inline storage; the common node-message case.
+  Buffer<uint8_t> src(48);
+  memset(src.data(), 7, src.size());
+  for (int i = 0; i < iterations; ++i) {
+    Buffer<uint8_t> copy(src);
+    g_sink += copy.data()[i & 47];
+  }
+}
+
+void BenchBufferCopyLarge(int iterations) {
+  Buffer<uint8_t> src(256 * 1024);
+  memset(src.data(), 7, src.size());
+  for (int i = 0; i < iterations; ++i) {
+    Buffer<uint8_t> copy(src);
+    g_sink += copy.data()[static_cast<size_t>(NextRand()) % copy.size()];
+  }
+}
+
+// Iteration counts are deliberately fixed (not auto-calibrated) so a
+// given benchmark does identical work on every run and CI can compare
+// total times directly.
+auto GetBenchmarks() -> std::vector<Benchmark> {
+  return {
+      {"huffman_compress", 20000, BenchHuffmanCompress},
+      {"huffman_decompress", 20000, BenchHuffmanDecompress},
+      {"matrix44f_multiply", 1000000, BenchMatrix44fMultiply},
+      {"timer_list_churn", 50000, BenchTimerListChurn},
+      {"render_command_buffer_encode_decode", 2000,
+       BenchRenderCommandBufferEncodeDecode},
+      {"utf8_validate", 100000, BenchUTF8Validate},
+      {"buffer_copy_small", 2000000, BenchBufferCopySmall},
+      {"buffer_copy_large", 10000, BenchBufferCopyLarge},
+  };
+}
+
+auto BenchMain(int argc, char** argv) -> int {
+  // Enough globals for Object bookkeeping in debug builds; we never
+  // spin up the engine proper here.
+  g_app_globals = new AppGlobals(argc, argv);
+
+  // Optional single arg: only run benchmarks whose name contains it.
+  std::string filter = (argc > 1) ? argv[1] : "";
+
+  printf("{\"benchmarks\": [");
+  bool first{true};
+  for (auto&& benchmark : GetBenchmarks()) {
+    if (!filter.empty()
+        && std::string(benchmark.name).find(filter) == std::string::npos) {
+      continue;
+    }
+
+    // A short untimed warmup to fault in code/data.
+    g_rand_state = 0x12345678u;
+    benchmark.run(benchmark.iterations / 20 + 1);
+
+    g_rand_state = 0x12345678u;
+    int64_t start = Platform::GetCurrentNanoseconds();
+    benchmark.run(benchmark.iterations);
+    int64_t total_ns = Platform::GetCurrentNanoseconds() - start;
+
+    printf("%s\n  {\"name\": \"%s\", \"iterations\": %d, "
+           "\"total_ns\": %lld, \"ns_per_iteration\": %.2f}",
+           first ? "" : ",", benchmark.name, benchmark.iterations,
+           static_cast<long long>(total_ns),
+           static_cast<double>(total_ns)
+               / static_cast<double>(benchmark.iterations));
+    first = false;
+  }
+  printf("\n]}\n");
+  return 0;
+}
+
+}  // namespace
+}  // namespace ballistica
+
+auto main(int argc, char** argv) -> int {
+  return ballistica::BenchMain(argc, argv);
+}
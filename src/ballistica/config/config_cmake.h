@@ -58,7 +58,10 @@
 // Allow stdin commands too.
 #define BA_USE_STDIN_THREAD 1
 
+// (the benchmark binary brings its own main; see bench/bench_main.cc)
+#ifndef BA_DEFINE_MAIN
 #define BA_DEFINE_MAIN 1
+#endif
 
 #if !BA_DEBUG_BUILD
 
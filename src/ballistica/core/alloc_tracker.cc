@@ -0,0 +1,47 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/core/alloc_tracker.h"
+
+namespace ballistica {
+
+#if BA_ALLOC_TRACKING
+std::atomic<int64_t> AllocTracker::bytes_[AllocTracker::kTagCount]{};
+std::atomic<int64_t> AllocTracker::counts_[AllocTracker::kTagCount]{};
+#endif
+
+auto AllocTracker::TagForMediaType(MediaType type) -> Tag {
+  switch (type) {
+    case MediaType::kTexture:
+      return Tag::kTextures;
+    case MediaType::kSound:
+      return Tag::kSounds;
+    case MediaType::kModel:
+      return Tag::kModels;
+    case MediaType::kCollideModel:
+      return Tag::kCollideModels;
+    default:
+      return Tag::kData;
+  }
+}
+
+auto AllocTracker::TagName(Tag tag) -> const char* {
+  switch (tag) {
+    case Tag::kTextures:
+      return "textures";
+    case Tag::kSounds:
+      return "sounds";
+    case Tag::kModels:
+      return "models";
+    case Tag::kCollideModels:
+      return "collide_models";
+    case Tag::kData:
+      return "data";
+    case Tag::kMeshBuffers:
+      return "mesh_buffers";
+    case Tag::kSceneNodes:
+      return "scene_nodes";
+  }
+  return "";
+}
+
+}  // namespace ballistica
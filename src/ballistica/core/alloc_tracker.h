@@ -0,0 +1,92 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CORE_ALLOC_TRACKER_H_
+#define BALLISTICA_CORE_ALLOC_TRACKER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "ballistica/core/types.h"
+
+// Alloc tracking is compiled in on debug builds by default; define
+// BA_ALLOC_TRACKING explicitly to override (it's light enough to leave
+// on for internal test builds watching memory on low-ram devices).
+#ifndef BA_ALLOC_TRACKING
+#if BA_DEBUG_BUILD
+#define BA_ALLOC_TRACKING 1
+#else
+#define BA_ALLOC_TRACKING 0
+#endif
+#endif
+
+namespace ballistica {
+
+/// Live per-subsystem memory tallies. Subsystems that own the big
+/// memory (texture/sound/model data, mesh buffers, scene nodes) report
+/// their allocations here tagged by owner, so when a low-ram device is
+/// creeping towards the OOM killer we can see *whose* bytes those are
+/// without walking any lists. Counters are relaxed atomics; reporting
+/// happens from whatever thread the alloc/free runs on and readers just
+/// take a racy-but-consistent-enough snapshot.
+class AllocTracker {
+ public:
+  enum class Tag {
+    kTextures,
+    kSounds,
+    kModels,
+    kCollideModels,
+    kData,
+    kMeshBuffers,
+    kSceneNodes
+  };
+  static const int kTagCount = static_cast<int>(Tag::kSceneNodes) + 1;
+
+  static constexpr auto enabled() -> bool { return BA_ALLOC_TRACKING; }
+
+#if BA_ALLOC_TRACKING
+  /// Report an allocation of the given size against a tag.
+  static void Add(Tag tag, size_t bytes) {
+    int i = static_cast<int>(tag);
+    counts_[i].fetch_add(1, std::memory_order_relaxed);
+    bytes_[i].fetch_add(static_cast<int64_t>(bytes),
+                        std::memory_order_relaxed);
+  }
+
+  /// Report the death of an allocation previously Add()ed (sizes must
+  /// match or tallies drift).
+  static void Remove(Tag tag, size_t bytes) {
+    int i = static_cast<int>(tag);
+    counts_[i].fetch_sub(1, std::memory_order_relaxed);
+    bytes_[i].fetch_sub(static_cast<int64_t>(bytes),
+                        std::memory_order_relaxed);
+  }
+
+  static auto Bytes(Tag tag) -> int64_t {
+    return bytes_[static_cast<int>(tag)].load(std::memory_order_relaxed);
+  }
+  static auto Count(Tag tag) -> int64_t {
+    return counts_[static_cast<int>(tag)].load(std::memory_order_relaxed);
+  }
+#else
+  static void Add(Tag tag, size_t bytes) {}
+  static void Remove(Tag tag, size_t bytes) {}
+  static auto Bytes(Tag tag) -> int64_t { return 0; }
+  static auto Count(Tag tag) -> int64_t { return 0; }
+#endif  // BA_ALLOC_TRACKING
+
+  /// Tag for a media component's type.
+  static auto TagForMediaType(MediaType type) -> Tag;
+
+  static auto TagName(Tag tag) -> const char*;
+
+#if BA_ALLOC_TRACKING
+ private:
+  static std::atomic<int64_t> bytes_[kTagCount];
+  static std::atomic<int64_t> counts_[kTagCount];
+#endif
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_CORE_ALLOC_TRACKER_H_
@@ -13,9 +13,14 @@ namespace ballistica {
 // Dynamically allocate this; don't want it torn down on quit.
 Context* g_context = nullptr;
 
+// What reads actually go through; normally aimed at g_context but scoped
+// raw switches can aim it at a caller-owned context temporarily.
+const Context* g_context_current = nullptr;
+
 void Context::Init() {
   assert(!g_context);
   g_context = new Context(nullptr);
+  g_context_current = g_context;
 }
 
 ContextTarget::ContextTarget() = default;
@@ -27,7 +32,9 @@ auto ContextTarget::GetAsHostActivity() -> HostActivity* { return nullptr; }
 auto ContextTarget::GetAsUIContext() -> UI* { return nullptr; }
 auto ContextTarget::GetMutableScene() -> Scene* { return nullptr; }
 
-Context::Context() : target(g_context->target) { assert(InGameThread()); }
+Context::Context() : target(g_context_current->target) {
+  assert(InGameThread());
+}
 
 auto Context::operator==(const Context& other) const -> bool {
   return (target.get() == other.target.get());
@@ -64,29 +71,37 @@ auto Context::GetUIContext() const -> UI* {
 ScopedSetContext::ScopedSetContext(const Object::Ref<ContextTarget>& target) {
   assert(InGameThread());
   assert(g_context);
-  context_prev_ = *g_context;
+  context_prev_ = Context::current();
+  context_current_prev_ = g_context_current;
   g_context->target = target;
+  g_context_current = g_context;
 }
 
 ScopedSetContext::ScopedSetContext(ContextTarget* target) {
   assert(InGameThread());
   assert(g_context);
-  context_prev_ = *g_context;
+  context_prev_ = Context::current();
+  context_current_prev_ = g_context_current;
   g_context->target = target;
+  g_context_current = g_context;
 }
 
 ScopedSetContext::ScopedSetContext(const Context& context) {
   assert(InGameThread());
   assert(g_context);
-  context_prev_ = *g_context;
+  context_prev_ = Context::current();
+  context_current_prev_ = g_context_current;
   *g_context = context;
+  g_context_current = g_context;
 }
 
 ScopedSetContext::~ScopedSetContext() {
   assert(InGameThread());
   assert(g_context);
-  // Restore old.
+  // Restore old (both our storage's value and whatever the reads were
+  // actually aimed at; a raw scope may have been active around us).
   *g_context = context_prev_;
+  g_context_current = context_current_prev_;
 }
 
 auto ContextTarget::NewTimer(TimeType timetype, TimerMedium length, bool repeat,
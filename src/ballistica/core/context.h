@@ -17,18 +17,21 @@ class Context {
   static void Init();
 
   static auto current() -> const Context& {
-    assert(g_context);
+    assert(g_context_current);
 
     // Context can only be accessed from the game thread.
     BA_PRECONDITION(InGameThread());
 
-    return *g_context;
+    return *g_context_current;
   }
   static void set_current(const Context& context) {
     // Context can only be accessed from the game thread.
     BA_PRECONDITION(InGameThread());
 
+    // Non-scoped sets always go through our global storage (the current
+    // context may be borrowed from a caller; see ScopedSetContextRaw).
     *g_context = context;
+    g_context_current = g_context;
   }
 
   // Return the current context target, raising an Exception if there is none.
@@ -121,6 +124,29 @@ class ScopedSetContext {
  private:
   BA_DISALLOW_CLASS_COPIES(ScopedSetContext);
   Context context_prev_;
+  const Context* context_current_prev_{};
+};
+
+// A cheaper alternative to ScopedSetContext for spots where the passed
+// Context is guaranteed to outlive the scope (a PythonContextCall running
+// its own stored context, etc). Instead of copying contexts in and out of
+// global storage (weak-ref link/unlink per copy - real money with
+// thousands of timer/callback fires a second) this just points the
+// current-context pointer at the caller's. Target death during the scope
+// is still handled safely since the caller's weak-ref clears as usual.
+class ScopedSetContextRaw {
+ public:
+  explicit ScopedSetContextRaw(const Context* context) {
+    assert(InGameThread());
+    assert(context);
+    context_current_prev_ = g_context_current;
+    g_context_current = context;
+  }
+  ~ScopedSetContextRaw() { g_context_current = context_current_prev_; }
+
+ private:
+  BA_DISALLOW_CLASS_COPIES(ScopedSetContextRaw);
+  const Context* context_current_prev_;
 };
 
 }  // namespace ballistica
@@ -4,6 +4,7 @@
 
 #include "ballistica/app/app.h"
 #include "ballistica/core/logging.h"
+#include "ballistica/core/thread.h"
 #include "ballistica/platform/platform.h"
 
 namespace ballistica {
@@ -121,6 +122,10 @@ auto FatalError::DoBlockingFatalErrorDialog(const std::string& message)
       *finishedptr = true;
     });
 
+    // That push may have been coalesced into our thread-local batch;
+    // ship it before we start sleeping on the result.
+    Thread::FlushRunnableBatches();
+
     // Wait a short amount of time for the main thread to take action.
     // There's a chance that it can't (if threads are paused, if it is
     // blocked on a synchronous call to another thread, etc.) so if we don't
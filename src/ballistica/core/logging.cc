@@ -2,7 +2,11 @@
 
 #include "ballistica/core/logging.h"
 
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "ballistica/app/app_globals.h"
 #include "ballistica/ballistica.h"
@@ -14,6 +18,125 @@
 
 namespace ballistica {
 
+// Deferred-sink internals: each logging thread owns a single-producer
+// single-consumer ring of binary entries; one background thread drains
+// all rings, formats, and feeds the results through the normal Log()
+// path. Rings are intentionally leaked (bounded by thread count) so
+// the formatter never races thread teardown.
+
+const int kDeferredLogMaxArgs = 4;
+const uint32_t kDeferredLogRingSize = 256;  // Power of two.
+
+struct DeferredLogEntry {
+  const char* fmt;
+  int arg_count;
+  Logging::LogArg args[kDeferredLogMaxArgs];
+};
+
+class DeferredLogRing {
+ public:
+  void Push(const char* fmt, std::initializer_list<Logging::LogArg> args) {
+    uint32_t write = write_count_.load(std::memory_order_relaxed);
+    if (write - read_count_.load(std::memory_order_acquire)
+        >= kDeferredLogRingSize) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    DeferredLogEntry& e = entries_[write & (kDeferredLogRingSize - 1)];
+    e.fmt = fmt;
+    e.arg_count = 0;
+    for (auto&& arg : args) {
+      if (e.arg_count == kDeferredLogMaxArgs) {
+        break;
+      }
+      e.args[e.arg_count++] = arg;
+    }
+    write_count_.store(write + 1, std::memory_order_release);
+  }
+
+  /// Format and Log() everything pending (formatter thread only).
+  void Drain() {
+    uint32_t read = read_count_.load(std::memory_order_relaxed);
+    uint32_t write = write_count_.load(std::memory_order_acquire);
+    while (read != write) {
+      const DeferredLogEntry& e = entries_[read & (kDeferredLogRingSize - 1)];
+      std::string msg;
+      int next_arg = 0;
+      for (const char* c = e.fmt; *c != 0; c++) {
+        if (c[0] == '{' && c[1] == '}' && next_arg < e.arg_count) {
+          msg += e.args[next_arg++].GetDescription();
+          c++;
+        } else {
+          msg += *c;
+        }
+      }
+      Logging::Log(msg);
+      read++;
+      read_count_.store(read, std::memory_order_release);
+    }
+    uint32_t dropped = dropped_.exchange(0, std::memory_order_relaxed);
+    if (dropped > 0) {
+      Logging::Log("Warning: dropped " + std::to_string(dropped)
+                   + " deferred log entries (thread outran formatter).");
+    }
+  }
+
+ private:
+  std::atomic<uint32_t> write_count_{};
+  std::atomic<uint32_t> read_count_{};
+  std::atomic<uint32_t> dropped_{};
+  DeferredLogEntry entries_[kDeferredLogRingSize];
+};
+
+static std::mutex g_deferred_log_mutex;
+static std::vector<DeferredLogRing*>* g_deferred_log_rings{};
+
+static void DeferredLogThreadMain() {
+  while (true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    std::vector<DeferredLogRing*> rings;
+    {
+      std::lock_guard<std::mutex> lock(g_deferred_log_mutex);
+      rings = *g_deferred_log_rings;
+    }
+    for (auto* ring : rings) {
+      ring->Drain();
+    }
+  }
+}
+
+static auto GetThreadDeferredLogRing() -> DeferredLogRing* {
+  thread_local DeferredLogRing* ring = [] {
+    auto* r = new DeferredLogRing();
+    std::lock_guard<std::mutex> lock(g_deferred_log_mutex);
+    if (g_deferred_log_rings == nullptr) {
+      g_deferred_log_rings = new std::vector<DeferredLogRing*>();
+      auto* formatter = new std::thread(DeferredLogThreadMain);
+      formatter->detach();
+    }
+    g_deferred_log_rings->push_back(r);
+    return r;
+  }();
+  return ring;
+}
+
+auto Logging::LogArg::GetDescription() const -> std::string {
+  switch (type_) {
+    case Type::kInt:
+      return std::to_string(int_val_);
+    case Type::kFloat:
+      return std::to_string(float_val_);
+    case Type::kString:
+      return str_val_;
+  }
+  return "";
+}
+
+void Logging::LogDeferred(const char* fmt,
+                          std::initializer_list<LogArg> args) {
+  GetThreadDeferredLogRing()->Push(fmt, args);
+}
+
 static void PrintCommon(const std::string& s) {
   // Print to in-game console.
   {
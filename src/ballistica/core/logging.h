@@ -3,12 +3,42 @@
 #ifndef BALLISTICA_CORE_LOGGING_H_
 #define BALLISTICA_CORE_LOGGING_H_
 
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
 #include <string>
 
 namespace ballistica {
 
 class Logging {
  public:
+  /// One argument captured for a deferred log entry: a number or a
+  /// truncated copy of a short string. Kept trivially-copyable so
+  /// entries can live in lock-free rings.
+  class LogArg {
+   public:
+    LogArg() : type_(Type::kInt), int_val_(0) {}
+    LogArg(int val) : type_(Type::kInt), int_val_(val) {}  // NOLINT
+    LogArg(int64_t val) : type_(Type::kInt), int_val_(val) {}  // NOLINT
+    LogArg(double val) : type_(Type::kFloat), float_val_(val) {}  // NOLINT
+    LogArg(float val)  // NOLINT
+        : type_(Type::kFloat), float_val_(val) {}
+    LogArg(const char* val) : type_(Type::kString) {  // NOLINT
+      strncpy(str_val_, val, sizeof(str_val_) - 1);
+      str_val_[sizeof(str_val_) - 1] = 0;
+    }
+    LogArg(const std::string& val) : LogArg(val.c_str()) {}  // NOLINT
+    auto GetDescription() const -> std::string;
+
+   private:
+    enum class Type : uint8_t { kInt, kFloat, kString };
+    Type type_;
+    union {
+      int64_t int_val_;
+      double float_val_;
+      char str_val_[48];
+    };
+  };
   /// Print a string directly to stdout as well as the in-game console
   /// and any connected telnet consoles.
   static auto PrintStdout(const std::string& s, bool flush = false) -> void;
@@ -22,6 +52,17 @@ class Logging {
   /// on the platform.
   static auto Log(const std::string& msg, bool to_stdout = true,
                   bool to_server = true) -> void;
+
+  /// Cheap entry point for log-heavy hot threads (game-thread server
+  /// telemetry): records fmt plus captured args into a per-thread ring
+  /// and returns immediately; a background thread formats the text and
+  /// routes it through Log() so it still reaches the console and
+  /// server. fmt must be a string literal (stored by pointer) using
+  /// "{}" placeholders filled from args in order, at most four of
+  /// them. If a thread outruns the formatter, entries get dropped and
+  /// the drop count logged rather than ever blocking the caller.
+  static auto LogDeferred(const char* fmt,
+                          std::initializer_list<LogArg> args = {}) -> void;
 };
 
 }  // namespace ballistica
@@ -2,12 +2,150 @@
 
 #include "ballistica/core/module.h"
 
+#include <mutex>
 #include <utility>
 
 #include "ballistica/core/thread.h"
 
 namespace ballistica {
 
+// RunnablePool internals. Concrete Runnables are small (a vtable, the
+// Object bookkeeping, and a lambda's captures) so a handful of size
+// classes covers effectively all of them; anything bigger falls back to
+// plain new/delete.
+static const int kRunnablePoolClassCount = 3;
+static const size_t kRunnablePoolClassSizes[kRunnablePoolClassCount] = {
+    64, 128, 256};
+
+// How many blocks move between a thread's cache and the depot at a time.
+static const int kRunnablePoolBatchSize = 32;
+
+namespace {
+
+// A free block; we stash the list link in the storage itself.
+struct RunnablePoolBlock {
+  RunnablePoolBlock* next;
+};
+
+// The shared depot threads exchange batches with.
+struct RunnablePoolDepot {
+  std::mutex mutex;
+  RunnablePoolBlock* free_lists[kRunnablePoolClassCount]{};
+};
+
+// Per-thread front cache. Blocks are allocated on pushing threads and
+// freed on consuming ones, so caches drift; batch exchanges with the
+// depot keep everyone fed without per-block locking.
+struct RunnablePoolCache {
+  RunnablePoolBlock* free_lists[kRunnablePoolClassCount]{};
+  int counts[kRunnablePoolClassCount]{};
+  ~RunnablePoolCache();
+};
+
+}  // namespace
+
+static auto GetRunnablePoolDepot() -> RunnablePoolDepot* {
+  // Intentionally leaked; worker threads can outlive static destruction.
+  static auto* depot = new RunnablePoolDepot();
+  return depot;
+}
+
+static thread_local RunnablePoolCache g_runnable_pool_cache;
+
+static auto RunnablePoolClassForSize(size_t size) -> int {
+  for (int i = 0; i < kRunnablePoolClassCount; i++) {
+    if (size <= kRunnablePoolClassSizes[i]) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+RunnablePoolCache::~RunnablePoolCache() {
+  // Thread's going down; hand everything we're holding back to the depot.
+  auto* depot = GetRunnablePoolDepot();
+  std::lock_guard<std::mutex> lock(depot->mutex);
+  for (int i = 0; i < kRunnablePoolClassCount; i++) {
+    while (RunnablePoolBlock* b = free_lists[i]) {
+      free_lists[i] = b->next;
+      b->next = depot->free_lists[i];
+      depot->free_lists[i] = b;
+    }
+    counts[i] = 0;
+  }
+}
+
+auto RunnablePool::Alloc(size_t size) -> void* {
+  int sclass = RunnablePoolClassForSize(size);
+  if (sclass == -1) {
+    return ::operator new(size);
+  }
+  auto& cache = g_runnable_pool_cache;
+  if (cache.free_lists[sclass] == nullptr) {
+    // Cache is dry; grab a batch from the depot.
+    auto* depot = GetRunnablePoolDepot();
+    {
+      std::lock_guard<std::mutex> lock(depot->mutex);
+      RunnablePoolBlock* b = depot->free_lists[sclass];
+      while (b != nullptr && cache.counts[sclass] < kRunnablePoolBatchSize) {
+        depot->free_lists[sclass] = b->next;
+        b->next = cache.free_lists[sclass];
+        cache.free_lists[sclass] = b;
+        cache.counts[sclass]++;
+        b = depot->free_lists[sclass];
+      }
+    }
+
+    // Depot was dry too; carve a fresh slab into blocks. Slabs stay in
+    // circulation for the life of the app (that's the recycling scheme;
+    // total footprint tracks the high-water mark of in-flight
+    // runnables, which the thread-message kill-threshold bounds anyway).
+    if (cache.free_lists[sclass] == nullptr) {
+      size_t block_size = kRunnablePoolClassSizes[sclass];
+      char* slab = static_cast<char*>(
+          ::operator new(block_size * kRunnablePoolBatchSize));
+      for (int i = 0; i < kRunnablePoolBatchSize; i++) {
+        auto* b = reinterpret_cast<RunnablePoolBlock*>(slab + i * block_size);
+        b->next = cache.free_lists[sclass];
+        cache.free_lists[sclass] = b;
+      }
+      cache.counts[sclass] = kRunnablePoolBatchSize;
+    }
+  }
+  RunnablePoolBlock* b = cache.free_lists[sclass];
+  cache.free_lists[sclass] = b->next;
+  cache.counts[sclass]--;
+  return b;
+}
+
+void RunnablePool::Free(void* ptr, size_t size) {
+  int sclass = RunnablePoolClassForSize(size);
+  if (sclass == -1) {
+    ::operator delete(ptr);
+    return;
+  }
+  auto& cache = g_runnable_pool_cache;
+  auto* b = static_cast<RunnablePoolBlock*>(ptr);
+  b->next = cache.free_lists[sclass];
+  cache.free_lists[sclass] = b;
+  cache.counts[sclass]++;
+
+  // If we've piled up more than we'll plausibly use (we may be a thread
+  // that only ever consumes), shift a batch back to the depot for the
+  // pushing threads to reclaim.
+  if (cache.counts[sclass] >= kRunnablePoolBatchSize * 2) {
+    auto* depot = GetRunnablePoolDepot();
+    std::lock_guard<std::mutex> lock(depot->mutex);
+    for (int i = 0; i < kRunnablePoolBatchSize; i++) {
+      RunnablePoolBlock* blk = cache.free_lists[sclass];
+      cache.free_lists[sclass] = blk->next;
+      blk->next = depot->free_lists[sclass];
+      depot->free_lists[sclass] = blk;
+    }
+    cache.counts[sclass] -= kRunnablePoolBatchSize;
+  }
+}
+
 void Module::PushLocalRunnable(Runnable* runnable) {
   assert(std::this_thread::get_id() == thread()->thread_id());
   runnables_.push_back(runnable);
@@ -13,6 +13,22 @@
 
 namespace ballistica {
 
+/// Pooled storage backing Runnable allocations. Every PushCall() news up
+/// a Runnable on the pushing thread and deletes it on the consuming one,
+/// which kept malloc's cross-thread paths hot (the game thread pushes
+/// tens of thousands of these per second on busy servers). Blocks are
+/// carved from slabs into a few small size classes and recycled forever:
+/// each thread fronts a shared depot with its own free lists and
+/// exchanges whole batches with it, so the depot lock is touched once
+/// per batch rather than once per message. Runnable's operator new/
+/// delete route through here; nothing else should need to call this
+/// directly.
+class RunnablePool {
+ public:
+  static auto Alloc(size_t size) -> void*;
+  static void Free(void* ptr, size_t size);
+};
+
 /// A logical entity that can be added to a thread and make use of its
 /// event loop.
 class Module {
@@ -15,6 +15,125 @@
 
 namespace ballistica {
 
+// The global weak-handle table (see Object::GetWeakHandle). Slot state
+// packs a 32-bit generation in the high bits plus busy/live flags; a
+// handle packs that generation above the slot index, so a recycled slot
+// makes stale handles resolve to nothing. The busy flag is a tiny
+// per-slot spin-claim that serializes handle resolution against object
+// death, so resolution can never touch a freed object.
+static const uint32_t kWeakHandleTableSize = 4096;  // Power of two.
+static const int kWeakHandleSlotBits = 12;
+static const uint64_t kWeakHandleSlotBusy = 1;
+static const uint64_t kWeakHandleSlotLive = 2;
+struct WeakHandleSlot {
+  std::atomic<uint64_t> state{};
+  std::atomic<Object*> obj{};
+};
+static WeakHandleSlot g_weak_handle_slots[kWeakHandleTableSize];
+
+auto Object::GetWeakHandle() -> uint64_t {
+  assert(object_atomic_refs_);
+  if (object_weak_handle_ != 0) {
+    return object_weak_handle_;
+  }
+  auto start = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(this) >> 6)
+               % kWeakHandleTableSize;
+  for (uint32_t i = 0; i < kWeakHandleTableSize; i++) {
+    uint32_t index = (start + i) % kWeakHandleTableSize;
+    WeakHandleSlot& slot = g_weak_handle_slots[index];
+    uint64_t s = slot.state.load(std::memory_order_relaxed);
+    if (s & (kWeakHandleSlotBusy | kWeakHandleSlotLive)) {
+      continue;
+    }
+    if (!slot.state.compare_exchange_strong(s, s | kWeakHandleSlotBusy,
+                                            std::memory_order_acq_rel)) {
+      continue;
+    }
+    slot.obj.store(this, std::memory_order_release);
+    // Bumping the generation on claim (not just death) keeps handles
+    // nonzero and distinct from the slot's previous tenant.
+    uint64_t gen = (s >> 32u) + 1;
+    slot.state.store((gen << 32u) | kWeakHandleSlotLive,
+                     std::memory_order_release);
+    object_weak_handle_ = (gen << kWeakHandleSlotBits) | index;
+    return object_weak_handle_;
+  }
+  throw Exception("Weak-handle table is full.");
+}
+
+auto Object::AcquireFromWeakHandleRaw(uint64_t handle) -> Object* {
+  if (handle == 0) {
+    return nullptr;
+  }
+  uint32_t index = handle & (kWeakHandleTableSize - 1);
+  uint64_t gen = handle >> kWeakHandleSlotBits;
+  WeakHandleSlot& slot = g_weak_handle_slots[index];
+  while (true) {
+    uint64_t s = slot.state.load(std::memory_order_acquire);
+    if (!(s & kWeakHandleSlotLive) || (s >> 32u) != gen) {
+      return nullptr;  // Object's gone (or was never this handle).
+    }
+    if (s & kWeakHandleSlotBusy) {
+      continue;  // Mid-resolve/mid-death elsewhere; re-peek.
+    }
+    if (!slot.state.compare_exchange_weak(s, s | kWeakHandleSlotBusy,
+                                          std::memory_order_acq_rel)) {
+      continue;
+    }
+    // While we hold busy, death can't proceed past its own busy-claim,
+    // so the object is pinned and bumping its count is safe (even from
+    // zero; the pending finalize will see our bump and stand down).
+    Object* obj = slot.obj.load(std::memory_order_acquire);
+    assert(obj && obj->object_atomic_refs_);
+    obj->object_strong_ref_count_.fetch_add(1, std::memory_order_relaxed);
+    slot.state.store(s, std::memory_order_release);  // Clear busy.
+    return obj;
+  }
+}
+
+void Object::FinalizeAtomicRelease(Object* obj, uint64_t handle) {
+  if (handle == 0) {
+    // No handle was ever taken; nothing can revive us, so just die.
+#if BA_DEBUG_BUILD
+    obj->object_is_dead_ = true;
+#endif
+    delete obj;
+    return;
+  }
+  uint32_t index = handle & (kWeakHandleTableSize - 1);
+  uint64_t gen = handle >> kWeakHandleSlotBits;
+  WeakHandleSlot& slot = g_weak_handle_slots[index];
+  while (true) {
+    uint64_t s = slot.state.load(std::memory_order_acquire);
+    if (!(s & kWeakHandleSlotLive) || (s >> 32u) != gen) {
+      // Someone else already finalized this object (we got revived by
+      // a handle resolve and the reviver's release beat us here); obj
+      // may be freed so don't so much as glance at it.
+      return;
+    }
+    if (s & kWeakHandleSlotBusy) {
+      continue;
+    }
+    if (!slot.state.compare_exchange_weak(s, s | kWeakHandleSlotBusy,
+                                          std::memory_order_acq_rel)) {
+      continue;
+    }
+    if (obj->object_strong_ref_count_.load(std::memory_order_acquire) > 0) {
+      // Revived by a concurrent handle resolve; back off. (that ref's
+      // eventual release will land back here.)
+      slot.state.store(s, std::memory_order_release);
+      return;
+    }
+    slot.obj.store(nullptr, std::memory_order_relaxed);
+    slot.state.store(((s >> 32u) + 1) << 32u, std::memory_order_release);
+#if BA_DEBUG_BUILD
+    obj->object_is_dead_ = true;
+#endif
+    delete obj;
+    return;
+  }
+}
+
 void Object::PrintObjects() {
 #if BA_DEBUG_BUILD
   std::string s;
@@ -64,6 +183,24 @@ void Object::PrintObjects() {
 #endif  // BA_DEBUG_BUILD
 }
 
+auto Object::GetObjectCounts() -> std::vector<std::pair<std::string, int>> {
+  std::vector<std::pair<std::string, int>> out;
+#if BA_DEBUG_BUILD
+  std::lock_guard<std::mutex> lock(g_app_globals->object_list_mutex);
+  std::unordered_map<std::string, int> obj_map;
+  for (Object* o = g_app_globals->object_list_first; o != nullptr;
+       o = o->object_next_) {
+    obj_map[o->GetObjectTypeName()]++;
+  }
+  out.reserve(obj_map.size());
+  for (auto&& i : obj_map) {
+    out.emplace_back(i.first, i.second);
+  }
+  std::sort(out.begin(), out.end());
+#endif  // BA_DEBUG_BUILD
+  return out;
+}
+
 Object::Object() {
 #if BA_DEBUG_BUILD
   // Mark when we were born.
@@ -159,6 +296,8 @@ static auto GetCurrentThreadIdentifier() -> ThreadIdentifier {
     return ThreadIdentifier::kMedia;
   } else if (InBGDynamicsThread()) {
     return ThreadIdentifier::kBGDynamics;
+  } else if (InHttpClientThread()) {
+    return ThreadIdentifier::kHttpClient;
   } else {
     throw Exception(std::string("unrecognized thread: ")
                     + GetCurrentThreadName());
@@ -223,6 +362,11 @@ void Object::ObjectThreadCheck() {
         DO_FAIL("BGDynamics");
       }
       break;
+    case ThreadIdentifier::kHttpClient:
+      if (!InHttpClientThread()) {
+        DO_FAIL("HttpClient");
+      }
+      break;
     default:
       throw Exception();
   }
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_CORE_OBJECT_H_
 #define BALLISTICA_CORE_OBJECT_H_
 
+#include <atomic>
 #include <string>
 #include <utility>
 #include <vector>
@@ -24,6 +25,12 @@ class Object {
   /// Prints a tally of object types and counts (debug build only).
   static void PrintObjects();
 
+  /// Snapshot of live instance counts by type name (debug builds only;
+  /// returns an empty map in release builds where per-object
+  /// bookkeeping is compiled out). Used by leak detection (see
+  /// SoakTest).
+  static auto GetObjectCounts() -> std::vector<std::pair<std::string, int>>;
+
   // Object classes can provide descriptive names for themselves;
   // these are used for debugging and other purposes.
   // The default is to use the C++ symbol name, demangling it when possible.
@@ -81,6 +88,22 @@ class Object {
 #endif
   }
 
+  /// Opt this object into atomic reference counting. Strong refs to it
+  /// may then be created, copied and dropped from any thread (thread
+  /// checks are skipped for those ops), at a small per-op cost. Weak
+  /// refs remain owner-thread-only; for cross-thread weak access use
+  /// GetWeakHandle(). Call this from the constructor - at latest before
+  /// any refs are shared across threads.
+  void EnableAtomicReferencing() { object_atomic_refs_ = true; }
+
+  /// Return a process-unique handle for this object (allocating its
+  /// slot in the global handle table on first call). The handle can be
+  /// stored anywhere as a plain value and later resolved from any
+  /// thread via TryAcquireFromWeakHandle(); once the object dies,
+  /// resolution simply returns an empty ref. Only valid on objects
+  /// using atomic referencing.
+  auto GetWeakHandle() -> uint64_t;
+
   // Return true if the object is ref-counted and has at least 1 strong ref.
   // This is generally a good thing for calls accepting object ptrs to check.
   // Note that this can return false positives in release builds so should
@@ -91,11 +114,11 @@ class Object {
       return false;
     }
 #endif
-    return (object_strong_ref_count_ > 0);
+    return (object_strong_ref_count_.load(std::memory_order_relaxed) > 0);
   }
 
   auto object_strong_ref_count() const -> int {
-    return object_strong_ref_count_;
+    return object_strong_ref_count_.load(std::memory_order_relaxed);
   }
   template <typename T = Object>
   class Ref;
@@ -431,7 +454,9 @@ class Object {
       }
 
 #if BA_DEBUG_BUILD
-      obj->ObjectThreadCheck();
+      if (!obj->object_atomic_refs_) {
+        obj->ObjectThreadCheck();
+      }
 
       // Obvs shouldn't be referencing dead stuff.
       assert(!obj->object_is_dead_);
@@ -452,31 +477,72 @@ class Object {
       obj->object_has_strong_ref_ = true;
 #endif  // BA_DEBUG_BUILD
 
-      obj->object_strong_ref_count_++;
+      if (obj->object_atomic_refs_) {
+        obj->object_strong_ref_count_.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        // Non-atomic objects are single-thread by discipline; keep
+        // this a plain unsynchronized bump.
+        obj->object_strong_ref_count_.store(
+            obj->object_strong_ref_count_.load(std::memory_order_relaxed) + 1,
+            std::memory_order_relaxed);
+      }
       obj_ = obj;
     }
     void Release() {
       if (obj_ != nullptr) {
 #if BA_DEBUG_BUILD
-        obj_->ObjectThreadCheck();
+        if (!obj_->object_atomic_refs_) {
+          obj_->ObjectThreadCheck();
+        }
 #endif
-        assert(obj_->object_strong_ref_count_ > 0);
-        obj_->object_strong_ref_count_--;
+        assert(obj_->object_strong_ref_count() > 0);
         T* tmp = obj_;
 
         // Invalidate ref *before* delete to avoid potential double-release.
         obj_ = nullptr;
-        if (tmp->object_strong_ref_count_ == 0) {
+        if (tmp->object_atomic_refs_) {
+          // Grab the handle while our ref still pins the object; once
+          // we decrement, another thread may finalize it under us.
+          uint64_t handle = tmp->object_weak_handle_;
+          if (tmp->object_strong_ref_count_.fetch_sub(
+                  1, std::memory_order_acq_rel)
+              == 1) {
+            FinalizeAtomicRelease(tmp, handle);
+          }
+        } else {
+          int count =
+              tmp->object_strong_ref_count_.load(std::memory_order_relaxed)
+              - 1;
+          tmp->object_strong_ref_count_.store(count,
+                                              std::memory_order_relaxed);
+          if (count == 0) {
 #if BA_DEBUG_BUILD
-          tmp->object_is_dead_ = true;
+            tmp->object_is_dead_ = true;
 #endif
-          delete tmp;
+            delete tmp;
+          }
         }
       }
     }
     T* obj_ = nullptr;
+    friend class Object;
   };
 
+  /// Resolve a handle from GetWeakHandle() into a strong ref, from any
+  /// thread. Returns an empty ref if the object has since died (or the
+  /// handle is 0).
+  template <typename T = Object>
+  static auto TryAcquireFromWeakHandle(uint64_t handle) -> Ref<T> {
+    Ref<T> out;
+    Object* obj = AcquireFromWeakHandleRaw(handle);
+    if (obj) {
+      // Adopt the count AcquireFromWeakHandleRaw() already took for us.
+      out.obj_ = static_cast<T*>(obj);
+      assert(dynamic_cast<T*>(obj) == out.obj_);
+    }
+    return out;
+  }
+
   /// Object::New<Type>(): The preferred way to create ref-counted Objects.
   /// Allocates a new Object with the provided args and returns a strong
   /// reference to it.
@@ -554,6 +620,16 @@ class Object {
   }
 
  private:
+  // Takes a strong-ref count for the caller on success (see
+  // TryAcquireFromWeakHandle which adopts it into a Ref).
+  static auto AcquireFromWeakHandleRaw(uint64_t handle) -> Object*;
+
+  // Runs when an atomic-mode object's count hits zero: handles the
+  // handle-table handshake (the object may get revived by a concurrent
+  // TryAcquireFromWeakHandle) and deletes the object when it really is
+  // done.
+  static void FinalizeAtomicRelease(Object* obj, uint64_t handle);
+
   // Making operator new private here to help ensure all of our dynamic
   // allocation/deallocation goes through our special functions (New(),
   // NewDeferred(), etc.). However, sticking with original new for release
@@ -575,7 +651,9 @@ class Object {
   millisecs_t object_birth_time_{};
   bool object_printed_warning_{};
 #endif
-  int object_strong_ref_count_{};
+  std::atomic<int> object_strong_ref_count_{};
+  bool object_atomic_refs_{};
+  uint64_t object_weak_handle_{};
   WeakRefBase* object_weak_refs_{};
   BA_DISALLOW_CLASS_COPIES(Object);
 };  // Object
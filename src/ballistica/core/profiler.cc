@@ -0,0 +1,137 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/core/profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ballistica/core/thread.h"
+
+namespace ballistica {
+
+std::atomic<bool> Profiler::capturing_{};
+
+// Per-thread event rings. Each thread owns exactly one writer (itself);
+// events are fully written before the count's release-store publishes
+// them, and the dumper only reads below counts it acquire-loads, so no
+// locking happens anywhere on the record path. At 8k events a ring
+// covers several seconds of a busy thread; older events just fall off.
+static const int kProfileRingSize = 8192;
+
+struct ProfileEvent {
+  const char* name;
+  int64_t start_usecs;
+  int64_t dur_usecs;
+};
+
+struct ProfileBuffer {
+  std::string thread_name;
+  std::atomic<int64_t> write_count{};
+  ProfileEvent events[kProfileRingSize];
+};
+
+// Registry of every thread's buffer; only touched on a thread's first
+// emit and at capture start/stop. Intentionally leaked; worker threads
+// can outlive static destruction.
+static std::mutex g_profile_mutex;
+static std::vector<ProfileBuffer*>* g_profile_buffers{};
+static std::string* g_profile_path{};
+static int64_t g_profile_start_usecs{};
+
+static thread_local ProfileBuffer* t_profile_buffer{};
+
+void Profiler::Emit(const char* name, int64_t start_usecs,
+                    int64_t dur_usecs) {
+  // A scope that began before StopCapture() can land here after it;
+  // just drop those (this also keeps the dumper's reads clean: nothing
+  // writes into rings once capturing is off).
+  if (!capturing()) {
+    return;
+  }
+  ProfileBuffer* buffer = t_profile_buffer;
+  if (buffer == nullptr) {
+    buffer = new ProfileBuffer();
+    buffer->thread_name = Thread::GetCurrentThreadName();
+    t_profile_buffer = buffer;
+    std::lock_guard<std::mutex> lock(g_profile_mutex);
+    if (g_profile_buffers == nullptr) {
+      g_profile_buffers = new std::vector<ProfileBuffer*>();
+    }
+    g_profile_buffers->push_back(buffer);
+  }
+  int64_t count = buffer->write_count.load(std::memory_order_relaxed);
+  buffer->events[count % kProfileRingSize] =
+      ProfileEvent{name, start_usecs, dur_usecs};
+  buffer->write_count.store(count + 1, std::memory_order_release);
+}
+
+auto Profiler::StartCapture(const std::string& path) -> bool {
+  std::lock_guard<std::mutex> lock(g_profile_mutex);
+  if (capturing_.load()) {
+    return false;
+  }
+  if (g_profile_path == nullptr) {
+    g_profile_path = new std::string();
+  }
+  *g_profile_path = path;
+  g_profile_start_usecs = GetRealTimeMicrosecs();
+
+  // Rewind everyone's ring so the capture starts clean. (No one writes
+  // while capturing is off, so this doesn't race the record path.)
+  if (g_profile_buffers != nullptr) {
+    for (auto&& buffer : *g_profile_buffers) {
+      buffer->write_count.store(0, std::memory_order_relaxed);
+    }
+  }
+  capturing_.store(true);
+  return true;
+}
+
+auto Profiler::StopCapture() -> std::string {
+  std::lock_guard<std::mutex> lock(g_profile_mutex);
+  if (!capturing_.load()) {
+    return "";
+  }
+  capturing_.store(false);
+  FILE* f = fopen(g_profile_path->c_str(), "w");
+  if (f == nullptr) {
+    return "";
+  }
+  fprintf(f, "{\"traceEvents\":[");
+  bool first = true;
+  int tid = 1;
+  if (g_profile_buffers != nullptr) {
+    for (auto&& buffer : *g_profile_buffers) {
+      // Name the lane after its thread so the trace reads like our
+      // thread list (game, graphics-server, audio, bg-dynamics, media..).
+      fprintf(f,
+              "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,"
+              "\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+              first ? "" : ",", tid, buffer->thread_name.c_str());
+      first = false;
+
+      int64_t count = buffer->write_count.load(std::memory_order_acquire);
+      int64_t available =
+          std::min(count, static_cast<int64_t>(kProfileRingSize));
+      for (int64_t i = count - available; i < count; i++) {
+        const ProfileEvent& e = buffer->events[i % kProfileRingSize];
+        fprintf(f,
+                ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                "\"ts\":%lld,\"dur\":%lld}",
+                e.name, tid,
+                static_cast<long long>(  // NOLINT
+                    e.start_usecs - g_profile_start_usecs),
+                static_cast<long long>(e.dur_usecs));  // NOLINT
+      }
+      tid++;
+    }
+  }
+  fprintf(f, "]}");
+  fclose(f);
+  return *g_profile_path;
+}
+
+}  // namespace ballistica
@@ -0,0 +1,75 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_CORE_PROFILER_H_
+#define BALLISTICA_CORE_PROFILER_H_
+
+#include <atomic>
+#include <string>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+/// Engine-wide scoped profiler. Drop a BA_PROFILE_SCOPE("name") into any
+/// stretch of code and, while a capture is running, its begin/end lands
+/// in a per-thread lock-free ring; StopCapture() merges every thread's
+/// ring into a chrome://tracing - loadable json file so cross-thread
+/// stalls (the game thread waiting on media loads, the graphics server
+/// stuck behind a late frame-def, etc.) are visible on one timeline.
+/// Outside a capture a scope costs a single relaxed load, so these can
+/// stay in shipping builds (unlike the BA_DEBUG_TIME checks, which only
+/// exist in debug builds and only complain past a threshold).
+class Profiler {
+ public:
+  static auto capturing() -> bool {
+    return capturing_.load(std::memory_order_relaxed);
+  }
+
+  /// Begin a capture; events accumulate until StopCapture(). Returns
+  /// false if one is already running.
+  static auto StartCapture(const std::string& path) -> bool;
+
+  /// End the capture and write the trace json. Returns the path written
+  /// or an empty string if no capture was running (or the write failed).
+  static auto StopCapture() -> std::string;
+
+  /// Used by ProfileScope; not for direct use. The name must be a
+  /// string literal (we store the pointer, not a copy).
+  static void Emit(const char* name, int64_t start_usecs, int64_t dur_usecs);
+
+ private:
+  static std::atomic<bool> capturing_;
+};
+
+/// RAII helper behind BA_PROFILE_SCOPE; times its enclosing scope.
+class ProfileScope {
+ public:
+  explicit ProfileScope(const char* name) {
+    if (Profiler::capturing()) {
+      name_ = name;
+      start_ = GetRealTimeMicrosecs();
+    }
+  }
+  ~ProfileScope() {
+    if (name_) {
+      Profiler::Emit(name_, start_, GetRealTimeMicrosecs() - start_);
+    }
+  }
+
+ private:
+  const char* name_{};
+  int64_t start_{};
+};
+
+#define BA_PROFILE_CONCAT_(a, b) a##b
+#define BA_PROFILE_CONCAT(a, b) BA_PROFILE_CONCAT_(a, b)
+
+/// Time the rest of the enclosing scope under the given name (which
+/// must be a string literal).
+#define BA_PROFILE_SCOPE(name) \
+  ::ballistica::ProfileScope BA_PROFILE_CONCAT(ba_profile_scope_, \
+                                               __LINE__)(name)
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_CORE_PROFILER_H_
@@ -2,6 +2,11 @@
 
 #include "ballistica/core/thread.h"
 
+#if BA_OSTYPE_LINUX
+#include <pthread.h>
+#include <sched.h>
+#endif
+
 #include <unordered_map>
 
 #include "ballistica/app/app.h"
@@ -14,6 +19,33 @@ namespace ballistica {
 
 bool Thread::threads_paused_ = false;
 
+// Cross-thread runnables don't each claim a ring slot of their own;
+// every engine event-loop thread accumulates its outgoing pushes here
+// (one batch per target thread) and ships a whole batch as a single
+// message. Under load the game thread was poking the graphics-server
+// and audio threads once per individual call; now a burst costs one
+// slot claim and at most one consumer wakeup. Batches flush when they
+// fill, at the producer's loop boundaries (so nothing lingers while it
+// sleeps), and before any non-runnable message to the same target (so
+// the ordering a producer observes is preserved).
+static const int kRunnableBatchSize = 12;
+static const int kMaxRunnableBatchTargets = 16;
+
+struct RunnableBatch {
+  Thread* target;
+  int count;
+  Runnable* runnables[kRunnableBatchSize];
+  int module_indices[kRunnableBatchSize];
+};
+
+// Only engine event-loop threads batch (flagged from ThreadMain and the
+// main-thread wrapper); job-pool workers, python threads, and platform
+// callbacks have no loop boundary to flush on, so they push directly.
+static thread_local bool t_runnable_batching_enabled{};
+static thread_local int t_runnable_batch_count{};
+static thread_local RunnableBatch
+    t_runnable_batches[kMaxRunnableBatchTargets];
+
 void Thread::AddCurrentThreadName(const std::string& name) {
   std::lock_guard<std::mutex> lock(g_app_globals->thread_name_map_mutex);
   std::thread::id thread_id = std::this_thread::get_id();
@@ -98,6 +130,10 @@ auto Thread::RunMediaThread(void* data) -> int {
   return static_cast<Thread*>(data)->ThreadMain();
 }
 
+auto Thread::RunHttpClientThread(void* data) -> int {
+  return static_cast<Thread*>(data)->ThreadMain();
+}
+
 void Thread::SetPaused(bool paused) {
   // Can be toggled from the main thread only.
   assert(std::this_thread::get_id() == g_app_globals->main_thread_id);
@@ -106,6 +142,11 @@ void Thread::SetPaused(bool paused) {
 }
 
 void Thread::WaitForNextEvent(bool single_cycle) {
+  // Whatever we've coalesced for other threads has to go out before we
+  // consider sleeping (otherwise work we owe someone could sit here for
+  // as long as we do).
+  FlushRunnableBatches();
+
   // If we're running a single cycle we never stop to wait.
   if (single_cycle) {
     return;
@@ -128,12 +169,12 @@ void Thread::WaitForNextEvent(bool single_cycle) {
   // If we've got active timers, wait for messages with a timeout so we can
   // run the next timer payload.
   if ((!paused_) && timers_.active_timer_count() > 0) {
-    millisecs_t real_time = GetRealTime();
-    millisecs_t wait_time = timers_.GetTimeToNextExpire(real_time);
+    int64_t real_time = GetRealTimeMicrosecs();
+    TimerMedium wait_time = timers_.GetTimeToNextExpire(real_time);
     if (wait_time > 0) {
       std::unique_lock<std::mutex> lock(thread_message_mutex_);
       if (thread_message_count_ == 0) {
-        thread_message_cv_.wait_for(lock, std::chrono::milliseconds(wait_time),
+        thread_message_cv_.wait_for(lock, std::chrono::microseconds(wait_time),
                                     [this] {
                                       // Go back to sleep on spurious wakeups
                                       // if we didn't wind up with any new
@@ -184,80 +225,24 @@ auto Thread::RunEventLoop(bool single_cycle) -> int {
     WaitForNextEvent(single_cycle);
 
     // Process all queued thread messages.
-    std::list<ThreadMessage> thread_messages;
-    GetThreadMessages(&thread_messages);
-    for (auto& thread_message : thread_messages) {
-      switch (thread_message.type) {
-        case ThreadMessage::Type::kNewModule: {
-          // Launch a new module and unlock.
-          ModuleLauncher* tl;
-          tl = static_cast<ModuleLauncher*>(thread_message.pval);
-          tl->Launch(this);
-          auto cmd =
-              static_cast<uint32_t>(ThreadMessage::Type::kNewModuleConfirm);
-          WriteToOwner(&cmd, sizeof(cmd));
-          break;
-        }
-        case ThreadMessage::Type::kRunnable: {
-          auto module_id = thread_message.ival;
-          Module* t = GetModule(module_id);
-          assert(t);
-          auto e = static_cast<Runnable*>(thread_message.pval);
-
-          // Add the event to our list.
-          t->PushLocalRunnable(e);
-          RunnablesWhilePausedSanityCheck(e);
-
-          break;
-        }
-        case ThreadMessage::Type::kShutdown: {
-          // Shutdown; die!
-          done_ = true;
-          break;
-        }
-        case ThreadMessage::Type::kResume: {
-          assert(paused_);
-
-          // Let all modules do pause-related stuff.
-          for (auto&& i : modules_) {
-            i->HandleThreadResume();
-          }
-          paused_ = false;
-          break;
-        }
-        case ThreadMessage::Type::kPause: {
-          assert(!paused_);
-
-          // Let all modules do pause-related stuff.
-          for (auto&& i : modules_) {
-            i->HandleThreadPause();
-          }
-          paused_ = true;
-          last_pause_time_ = GetRealTime();
-          messages_since_paused_ = 0;
-          break;
-        }
-        default: {
-          throw Exception();
-        }
-      }
-
-      // If the thread is going down.
-      if (done_) {
-        break;
-      }
-    }
+    DrainThreadMessages();
 
     // Run timers && queued module runnables unless we're paused.
     if (!paused_) {
       // Run timers.
-      timers_.Run(GetRealTime());
+      timers_.Run(GetRealTimeMicrosecs());
 
       // Run module-messages.
       for (auto& module_entry : modules_) {
         module_entry->RunPendingRunnables();
       }
     }
+
+    // Frame boundary: ship anything the work above coalesced for other
+    // threads. (Single-cycle callers never hit the flush in
+    // WaitForNextEvent, and exiting loops shouldn't strand anything.)
+    FlushRunnableBatches();
+
     if (done_ || single_cycle) {
       break;
     }
@@ -276,17 +261,114 @@ void Thread::RunnablesWhilePausedSanityCheck(Runnable* e) {
   // see details of what is coming through.  Disabling this check for now.
 }
 
-void Thread::GetThreadMessages(std::list<ThreadMessage>* messages) {
-  assert(messages);
+void Thread::DrainThreadMessages() {
   assert(std::this_thread::get_id() == thread_id());
 
-  // Make sure they passed an empty one in.
-  assert(messages->empty());
-  if (thread_message_count_ > 0) {
-    std::unique_lock<std::mutex> lock(thread_message_mutex_);
-    assert(thread_messages_.size() == thread_message_count_);
-    messages->swap(thread_messages_);
-    thread_message_count_ = 0;
+  // Pop everything that's fully published (a slot is readable once its
+  // sequence is one past the read position that points at it) and handle
+  // each message right here. We used to gather everything into a
+  // std::list first, but at the rates busy servers push runnables that
+  // was a heap alloc per message for no benefit; copying the message out
+  // of its slot and dispatching inline does the same job. No lock needed;
+  // we're the only consumer.
+  int drained = 0;
+  uint32_t pos = thread_message_read_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    ThreadMessageSlot* slot =
+        &thread_message_ring_[pos % kThreadMessageRingSize];
+    uint32_t seq = slot->sequence.load(std::memory_order_acquire);
+    if (seq != pos + 1) {
+      break;
+    }
+    ThreadMessage message = slot->message;
+
+    // Hand the slot back to producers *before* dispatching; it next
+    // becomes writable when the write position has lapped around to it.
+    slot->sequence.store(pos + kThreadMessageRingSize,
+                         std::memory_order_release);
+    pos++;
+    drained++;
+
+    HandleThreadMessage(message);
+
+    // If the thread is going down, leave anything still queued for the
+    // final drain.
+    if (done_) {
+      break;
+    }
+  }
+  if (drained > 0) {
+    thread_message_read_pos_.store(pos, std::memory_order_relaxed);
+    thread_message_count_.fetch_sub(drained);
+  }
+}
+
+void Thread::HandleThreadMessage(const ThreadMessage& thread_message) {
+  switch (thread_message.type) {
+    case ThreadMessage::Type::kNewModule: {
+      // Launch a new module and unlock.
+      ModuleLauncher* tl;
+      tl = static_cast<ModuleLauncher*>(thread_message.pval);
+      tl->Launch(this);
+      auto cmd = static_cast<uint32_t>(ThreadMessage::Type::kNewModuleConfirm);
+      WriteToOwner(&cmd, sizeof(cmd));
+      break;
+    }
+    case ThreadMessage::Type::kRunnable: {
+      auto module_id = thread_message.ival;
+      Module* t = GetModule(module_id);
+      assert(t);
+      auto e = static_cast<Runnable*>(thread_message.pval);
+
+      // Add the event to our list.
+      t->PushLocalRunnable(e);
+      RunnablesWhilePausedSanityCheck(e);
+
+      break;
+    }
+    case ThreadMessage::Type::kRunnableBatch: {
+      // A producer coalesced a burst of runnables into one message;
+      // unpack them in their original order.
+      auto* batch = static_cast<RunnableBatch*>(thread_message.pval);
+      for (int i = 0; i < batch->count; i++) {
+        Module* t = GetModule(batch->module_indices[i]);
+        assert(t);
+        t->PushLocalRunnable(batch->runnables[i]);
+        RunnablesWhilePausedSanityCheck(batch->runnables[i]);
+      }
+      RunnablePool::Free(batch, sizeof(RunnableBatch));
+      break;
+    }
+    case ThreadMessage::Type::kShutdown: {
+      // Shutdown; die!
+      done_ = true;
+      break;
+    }
+    case ThreadMessage::Type::kResume: {
+      assert(paused_);
+
+      // Let all modules do pause-related stuff.
+      for (auto&& i : modules_) {
+        i->HandleThreadResume();
+      }
+      paused_ = false;
+      break;
+    }
+    case ThreadMessage::Type::kPause: {
+      assert(!paused_);
+
+      // Let all modules do pause-related stuff.
+      for (auto&& i : modules_) {
+        i->HandleThreadPause();
+      }
+      paused_ = true;
+      last_pause_time_ = GetRealTime();
+      messages_since_paused_ = 0;
+      break;
+    }
+    default: {
+      throw Exception();
+    }
   }
 }
 
@@ -302,6 +384,18 @@ void Thread::WriteToOwner(const void* data, uint32_t size) {
 
 Thread::Thread(ThreadIdentifier identifier_in, ThreadType type_in)
     : type_(type_in), identifier_(identifier_in) {
+  // Thread timers run in microseconds; Timer::SetLength() callers still
+  // speak milliseconds so let the list do the converting.
+  timers_.set_units_per_millisecond(1000);
+
+  // Set up our message ring; a slot is writable when its sequence matches
+  // the write position that will land in it.
+  thread_message_ring_ =
+      std::make_unique<ThreadMessageSlot[]>(kThreadMessageRingSize);
+  for (uint32_t i = 0; i < kThreadMessageRingSize; i++) {
+    thread_message_ring_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
   switch (type_) {
     case ThreadType::kStandard: {
       // Lock down until the thread is up and running. It'll unlock us when
@@ -329,6 +423,9 @@ Thread::Thread(ThreadIdentifier identifier_in, ThreadType type_in)
         case ThreadIdentifier::kStdin:
           func = RunStdInputThread;
           break;
+        case ThreadIdentifier::kHttpClient:
+          func = RunHttpClientThread;
+          break;
         default:
           throw Exception();
       }
@@ -351,6 +448,10 @@ Thread::Thread(ThreadIdentifier identifier_in, ThreadType type_in)
       assert(std::this_thread::get_id() == g_app_globals->main_thread_id);
       thread_id_ = std::this_thread::get_id();
 
+      // The main thread runs an event loop too (we're wrapping it), so
+      // it gets to coalesce its outgoing runnables like the rest.
+      t_runnable_batching_enabled = true;
+
       // Hmmm we might want to set our thread name here,
       // as we do for other threads?
       // However on linux that winds up being what we see in top/etc
@@ -365,6 +466,10 @@ auto Thread::ThreadMain() -> int {
     assert(type_ == ThreadType::kStandard);
     thread_id_ = std::this_thread::get_id();
 
+    // We've got an event loop, which means we've got flush points; our
+    // outgoing cross-thread runnables can coalesce.
+    t_runnable_batching_enabled = true;
+
     const char* id_string;
     switch (identifier_) {
       case ThreadIdentifier::kGame:
@@ -391,10 +496,14 @@ auto Thread::ThreadMain() -> int {
       case ThreadIdentifier::kNetworkWrite:
         id_string = "ballistica network writing";
         break;
+      case ThreadIdentifier::kHttpClient:
+        id_string = "ballistica http-client";
+        break;
       default:
         throw Exception();
     }
     g_platform->SetCurrentThreadName(id_string);
+    g_platform->SetCurrentThreadClass(GetThreadClass(identifier_));
 
     // Send our owner a confirmation that we're alive.
     auto cmd = static_cast<uint32_t>(ThreadMessage::Type::kNewThreadConfirm);
@@ -426,6 +535,29 @@ auto Thread::ThreadMain() -> int {
   }
 }
 
+void Thread::DeleteTimer(int timer_id) {
+  assert(IsCurrent());
+  timers_.DeleteTimer(timer_id);
+}
+
+auto Thread::GetThreadClass(ThreadIdentifier identifier) -> ThreadClass {
+  switch (identifier) {
+    case ThreadIdentifier::kAudio:
+      // Glitches here are immediately audible, especially on mobile
+      // where the OS otherwise schedules us like any loader thread.
+      return ThreadClass::kRealtimeAudio;
+    case ThreadIdentifier::kNetworkWrite:
+      // On busy server boxes this loses the CPU to simulation and
+      // packets go out late; give it a modest edge.
+      return ThreadClass::kLatencySensitiveNetwork;
+    case ThreadIdentifier::kMedia:
+    case ThreadIdentifier::kFileOut:
+      return ThreadClass::kBulkLoader;
+    default:
+      return ThreadClass::kStandard;
+  }
+}
+
 void Thread::SetOwnsPython() {
   owns_python_ = true;
   g_python->AcquireGIL();
@@ -447,9 +579,26 @@ void Thread::LogThreadMessageTally() {
     writing_tally_ = true;
 
     std::unordered_map<std::string, int> tally;
-    Log("Thread message tally (" + std::to_string(thread_messages_.size())
-        + " in list):");
-    for (auto&& m : thread_messages_) {
+    Log("Thread message tally ("
+        + std::to_string(thread_message_count_.load()) + " in queue):");
+
+    // Walk the undrained stretch of the ring, skipping any slots not yet
+    // fully published. This is a racy snapshot (the consumer may be
+    // draining under us) but it's purely diagnostic; we only land here
+    // when the queue is badly backed up. For the same reason we only
+    // look at the type enum - the consumer may have already dispatched
+    // and deleted whatever pval points at, so dereferencing it here
+    // would be a use-after-free.
+    uint32_t read_pos = thread_message_read_pos_.load();
+    uint32_t write_pos = thread_message_write_pos_.load();
+    for (uint32_t pos = read_pos; static_cast<int32_t>(write_pos - pos) > 0;
+         pos++) {
+      ThreadMessageSlot* slot =
+          &thread_message_ring_[pos % kThreadMessageRingSize];
+      if (slot->sequence.load(std::memory_order_acquire) != pos + 1) {
+        continue;
+      }
+      const ThreadMessage& m(slot->message);
       std::string s;
       switch (m.type) {
         case ThreadMessage::Type::kShutdown:
@@ -458,6 +607,9 @@ void Thread::LogThreadMessageTally() {
         case ThreadMessage::Type::kRunnable:
           s += "kRunnable";
           break;
+        case ThreadMessage::Type::kRunnableBatch:
+          s += "kRunnableBatch";
+          break;
         case ThreadMessage::Type::kNewModule:
           s += "kNewModule";
           break;
@@ -477,15 +629,6 @@ void Thread::LogThreadMessageTally() {
           s += "UNKNOWN(" + std::to_string(static_cast<int>(m.type)) + ")";
           break;
       }
-      if (m.type == ThreadMessage::Type::kRunnable) {
-        // Runnable* e;
-        // e = static_cast<Runnable*>(m.pval);
-        {
-          std::string m_name = g_platform->DemangleCXXSymbol(
-              typeid(*(static_cast<Runnable*>(m.pval))).name());
-          s += std::string(": ") + m_name;
-        }
-      }
       auto j = tally.find(s);
       if (j == tally.end()) {
         tally[s] = 1;
@@ -502,60 +645,146 @@ void Thread::LogThreadMessageTally() {
   }
 }
 
-void Thread::PushThreadMessage(const ThreadMessage& t) {
-  {
-    std::unique_lock<std::mutex> lock(thread_message_mutex_);
+void Thread::PushModuleRunnable(Runnable* runnable, int module_index) {
+  if (!t_runnable_batching_enabled) {
+    PushThreadMessage(ThreadMessage(Thread::ThreadMessage::Type::kRunnable,
+                                    module_index, runnable));
+    return;
+  }
 
-    // Plop the data on to the list; we're assuming the mutex is locked.
-    thread_messages_.push_back(t);
-
-    // Keep our own count; apparently size() on an stl list involves
-    // iterating.
-    // FIXME: Actually I don't think this is the case anymore; should check.
-    thread_message_count_++;
-    assert(thread_message_count_ == thread_messages_.size());
-
-    // Show message count states.
-    if (explicit_bool(false)) {
-      static int one_off = 0;
-      static int foo = 0;
-      foo++;
-      one_off++;
-
-      // Show momemtary spikes.
-      if (thread_message_count_ > 100 && one_off > 100) {
-        one_off = 0;
-        foo = 999;
-      }
+  // Find (or claim) our batch for this target. The engine only ever has
+  // a handful of threads so a flat scan beats any sort of map here.
+  RunnableBatch* batch = nullptr;
+  for (int i = 0; i < t_runnable_batch_count; i++) {
+    if (t_runnable_batches[i].target == this) {
+      batch = &t_runnable_batches[i];
+      break;
+    }
+  }
+  if (batch == nullptr) {
+    if (t_runnable_batch_count == kMaxRunnableBatchTargets) {
+      // No slots left (shouldn't happen in practice); just push direct.
+      PushThreadMessage(ThreadMessage(Thread::ThreadMessage::Type::kRunnable,
+                                      module_index, runnable));
+      return;
+    }
+    batch = &t_runnable_batches[t_runnable_batch_count++];
+    batch->target = this;
+    batch->count = 0;
+  }
+  batch->runnables[batch->count] = runnable;
+  batch->module_indices[batch->count] = module_index;
+  batch->count++;
+  if (batch->count == kRunnableBatchSize) {
+    ShipRunnableBatch(batch);
+  }
+}
+
+void Thread::ShipRunnableBatch(RunnableBatch* batch) {
+  assert(batch->target == this && batch->count > 0);
+
+  // A lone runnable just goes out the old way; no point wrapping it.
+  if (batch->count == 1) {
+    PushThreadMessage(ThreadMessage(Thread::ThreadMessage::Type::kRunnable,
+                                    batch->module_indices[0],
+                                    batch->runnables[0]));
+    batch->count = 0;
+    return;
+  }
+
+  // Ship a copy; our slot stays put for the next accumulation. These
+  // ride the same pool runnables themselves live in (they're the same
+  // flavor of small short-lived cross-thread node).
+  static_assert(sizeof(RunnableBatch) <= 256,
+                "RunnableBatch should fit a RunnablePool size class.");
+  auto* out = static_cast<RunnableBatch*>(
+      RunnablePool::Alloc(sizeof(RunnableBatch)));
+  memcpy(out, batch, sizeof(RunnableBatch));
+  batch->count = 0;
+  PushThreadMessage(
+      ThreadMessage(Thread::ThreadMessage::Type::kRunnableBatch, 0, out));
+}
 
-      // Show count periodically.
-      if ((std::this_thread::get_id() == g_app_globals->main_thread_id)
-          && foo > 100) {
-        foo = 0;
-        Log("MSG COUNT " + std::to_string(thread_message_count_));
+void Thread::FlushRunnableBatch() {
+  for (int i = 0; i < t_runnable_batch_count; i++) {
+    if (t_runnable_batches[i].target == this) {
+      if (t_runnable_batches[i].count > 0) {
+        ShipRunnableBatch(&t_runnable_batches[i]);
       }
+      return;
     }
+  }
+}
 
-    if (thread_message_count_ > 1000) {
-      static bool sent_error = false;
-      if (!sent_error) {
-        sent_error = true;
-        Log("Error: ThreadMessage list > 1000 in thread: "
-            + GetCurrentThreadName());
-        LogThreadMessageTally();
-      }
+void Thread::FlushRunnableBatches() {
+  for (int i = 0; i < t_runnable_batch_count; i++) {
+    if (t_runnable_batches[i].count > 0) {
+      t_runnable_batches[i].target->ShipRunnableBatch(&t_runnable_batches[i]);
     }
+  }
+}
 
-    // Prevent runaway mem usage if the list gets out of control.
-    if (thread_message_count_ > 10000) {
-      throw Exception("KILLING APP: ThreadMessage list > 10000 in thread: "
+void Thread::PushThreadMessage(const ThreadMessage& t) {
+  // Anything that isn't runnable traffic must not overtake runnables
+  // we've already coalesced for this target; ship those first.
+  if (t.type != ThreadMessage::Type::kRunnable
+      && t.type != ThreadMessage::Type::kRunnableBatch) {
+    FlushRunnableBatch();
+  }
+  // Claim a slot in the ring and publish our message into it; no lock
+  // involved. (A slot is claimable once its sequence matches the write
+  // position pointing at it.)
+  uint32_t pos = thread_message_write_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    ThreadMessageSlot* slot =
+        &thread_message_ring_[pos % kThreadMessageRingSize];
+    uint32_t seq = slot->sequence.load(std::memory_order_acquire);
+    auto dif = static_cast<int32_t>(seq - pos);
+    if (dif == 0) {
+      // Slot is free; try to claim it (another producer may be racing us
+      // for it).
+      if (thread_message_write_pos_.compare_exchange_weak(
+              pos, pos + 1, std::memory_order_relaxed)) {
+        slot->message = t;
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        break;
+      }
+    } else if (dif < 0) {
+      // Ring full. Shouldn't be reachable; the kill-threshold below trips
+      // thousands of messages before the ring runs out of slots.
+      throw Exception("KILLING APP: ThreadMessage ring overflow in thread: "
                       + GetCurrentThreadName());
+    } else {
+      // Someone else claimed this slot; retry at the latest position.
+      pos = thread_message_write_pos_.load(std::memory_order_relaxed);
     }
+  }
+  int count = thread_message_count_.fetch_add(1) + 1;
+
+  if (count > 1000) {
+    static bool sent_error = false;
+    if (!sent_error) {
+      sent_error = true;
+      Log("Error: ThreadMessage list > 1000 in thread: "
+          + GetCurrentThreadName());
+      LogThreadMessageTally();
+    }
+  }
 
-    // Unlock thread-message list and inform thread that there's something
-    // available.
+  // Prevent runaway mem usage if the list gets out of control.
+  if (count > 10000) {
+    throw Exception("KILLING APP: ThreadMessage list > 10000 in thread: "
+                    + GetCurrentThreadName());
+  }
+
+  // If we may have taken the queue from empty, the consumer could be
+  // asleep (or just deciding to sleep); cycling its mutex before
+  // notifying guarantees it's either fully in its cv wait (and gets our
+  // notify) or hasn't re-checked the count yet (and sees our message).
+  if (count == 1) {
+    { std::lock_guard<std::mutex> lock(thread_message_mutex_); }
+    thread_message_cv_.notify_all();
   }
-  thread_message_cv_.notify_all();
 }
 
 void Thread::ReadFromThread(std::unique_lock<std::mutex>* lock, void* buffer,
@@ -575,6 +804,47 @@ void Thread::ReadFromThread(std::unique_lock<std::mutex>* lock, void* buffer,
   data_to_client_.pop_front();
 }
 
+void Thread::SetCPUAffinity(const std::vector<int>& cpus) {
+#if BA_OSTYPE_LINUX
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  int valid_count = 0;
+  for (int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+      valid_count++;
+    }
+  }
+  if (valid_count == 0) {
+    return;
+  }
+  pthread_t handle;
+  if (thread_ != nullptr) {
+    handle = thread_->native_handle();
+  } else if (IsCurrent()) {
+    // Wrapped threads (main) have no thread_; handle that case when
+    // called from the thread itself.
+    handle = pthread_self();
+  } else {
+    return;
+  }
+  pthread_setaffinity_np(handle, sizeof(set), &set);
+#endif  // BA_OSTYPE_LINUX
+}
+
+void Thread::WaitForModuleAdd() {
+  assert(!pending_module_launchers_.empty());
+  std::unique_lock<std::mutex> lock(data_to_client_mutex_);
+  uint32_t cmd;
+  ReadFromThread(&lock, &cmd, sizeof(cmd));
+  assert(static_cast<ThreadMessage::Type>(cmd)
+         == ThreadMessage::Type::kNewModuleConfirm);
+
+  // The confirm means the thread is done with the launcher; clean it up.
+  delete pending_module_launchers_.front();
+  pending_module_launchers_.pop_front();
+}
+
 void Thread::SetThreadsPaused(bool paused) {
   threads_paused_ = paused;
   for (auto&& i : g_app_globals->pausable_threads) {
@@ -598,7 +868,12 @@ auto Thread::NewTimer(millisecs_t length, bool repeat,
                       const Object::Ref<Runnable>& runnable) -> Timer* {
   assert(IsCurrent());
   assert(runnable.exists());
-  return timers_.NewTimer(GetRealTime(), length, 0, repeat ? -1 : 0, runnable);
+
+  // Our timer list runs in microseconds these days (sub-millisecond
+  // intervals matter for things like audio processing) but this call
+  // keeps its old millisecond interface.
+  return timers_.NewTimer(GetRealTimeMicrosecs(), length * 1000, 0,
+                          repeat ? -1 : 0, runnable);
 }
 
 auto Thread::GetCurrentThreadName() -> std::string {
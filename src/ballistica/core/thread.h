@@ -3,8 +3,10 @@
 #ifndef BALLISTICA_CORE_THREAD_H_
 #define BALLISTICA_CORE_THREAD_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <utility>
@@ -17,6 +19,9 @@
 
 namespace ballistica {
 
+// A coalesced clump of cross-thread runnables (defined in thread.cc).
+struct RunnableBatch;
+
 // A thread with a built-in event loop.
 class Thread {
  public:
@@ -38,6 +43,13 @@ class Thread {
   static void SetThreadsPaused(bool enable);
   static auto AreThreadsPaused() -> bool;
 
+  /// Ship everything the *calling* thread has coalesced, to all targets.
+  /// Event loops call this at their boundaries so nothing lingers while
+  /// they sleep; call it yourself before blocking on another thread's
+  /// response to something you just pushed, or the push may sit in your
+  /// local batch for as long as you wait.
+  static void FlushRunnableBatches();
+
   auto IsCurrent() const -> bool {
     return std::this_thread::get_id() == thread_id();
   }
@@ -45,6 +57,17 @@ class Thread {
   // Used to quit the main thread.
   void Quit();
 
+  /// Pin the thread to a set of cpu cores. Server hosts running many
+  /// instances per box set BA_CPU_AFFINITY per instance (see
+  /// BallisticaMain) to keep each instance's threads - and thus its
+  /// memory traffic - on a single NUMA node. Out-of-range core numbers
+  /// are ignored; a no-op on platforms without affinity support.
+  void SetCPUAffinity(const std::vector<int>& cpus);
+
+  /// The scheduling class a given module thread should run under
+  /// (applied via Platform::SetCurrentThreadClass() at thread launch).
+  static auto GetThreadClass(ThreadIdentifier identifier) -> ThreadClass;
+
   struct ModuleLauncher {
     virtual void Launch(Thread* g) = 0;
     virtual ~ModuleLauncher() = default;
@@ -103,6 +126,30 @@ class Thread {
     }
   }
 
+  // Kick off a module launch in another thread without blocking.
+  // Each call must be paired with a later WaitForModuleAdd() on this
+  // same Thread (from the owning thread). This lets bootstrapping
+  // stage independent bring-up work concurrently - the game thread's
+  // Python init, the audio thread's device open, etc. - instead of
+  // paying for each one in sequence.
+  template <class THREADTYPE>
+  void BeginAddModule() {
+    // Only the cross-thread standard case makes sense here; for
+    // in-thread or main-thread launches just use AddModule.
+    assert(type_ == ThreadType::kStandard && !IsCurrent());
+
+    // Unlike AddModule we return before the target thread runs the
+    // launcher, so it has to live on the heap; we hang on to it and
+    // free it in WaitForModuleAdd once the launch is confirmed.
+    auto* launcher = new ModuleLauncherTemplate<THREADTYPE>();
+    pending_module_launchers_.push_back(launcher);
+    PushThreadMessage(
+        ThreadMessage(ThreadMessage::Type::kNewModule, 0, launcher));
+  }
+
+  // Block until a launch kicked off by BeginAddModule() has completed.
+  void WaitForModuleAdd();
+
   // An alternate version of AddModule that passes an argument along
   // to the thread's constructor.
   template <class THREADTYPE, class ARGTYPE>
@@ -157,12 +204,19 @@ class Thread {
 
   // For use by modules.
   auto RegisterModule(const std::string& name, Module* module) -> int;
-  void PushModuleRunnable(Runnable* runnable, int module_index) {
-    PushThreadMessage(Thread::ThreadMessage(
-        Thread::ThreadMessage::Type::kRunnable, module_index, runnable));
-  }
+
+  // Hand a cross-thread runnable to this thread. When the calling thread
+  // is itself an engine event-loop thread, consecutive pushes coalesce
+  // into small batches that ship as a single message (and thus at most a
+  // single consumer wakeup) when a batch fills or the caller hits its
+  // next loop boundary; see the batching bits in thread.cc.
+  void PushModuleRunnable(Runnable* runnable, int module_index);
 
   // Register a timer to run on the thread.
+  // Remove a timer made with NewTimer() (one-shots clean themselves up;
+  // this is for retiring repeaters). Must be called from this thread.
+  void DeleteTimer(int timer_id);
+
   auto NewTimer(millisecs_t length, bool repeat,
                 const Object::Ref<Runnable>& runnable) -> Timer*;
 
@@ -171,6 +225,7 @@ class Thread {
     enum class Type {
       kShutdown = 999,
       kRunnable,
+      kRunnableBatch,
       kNewModule,
       kNewModuleConfirm,
       kNewThreadConfirm,
@@ -185,6 +240,10 @@ class Thread {
         : type(type_in), ival(ival_in), pval(pval_in) {}
   };
   static void RunnablesWhilePausedSanityCheck(Runnable* r);
+
+  // Ship just what the calling thread has coalesced for this thread.
+  void FlushRunnableBatch();
+  void ShipRunnableBatch(RunnableBatch* batch);
   void WaitForNextEvent(bool single_cycle);
   void LoopUpkeep(bool once);
   void LogThreadMessageTally();
@@ -221,18 +280,47 @@ class Thread {
   static auto RunNetworkWriteThread(void* data) -> int;
   static auto RunStdInputThread(void* data) -> int;
   static auto RunMediaThread(void* data) -> int;
+  static auto RunHttpClientThread(void* data) -> int;
 
   auto ThreadMain() -> int;
   std::thread* thread_;
-  void GetThreadMessages(std::list<ThreadMessage>* messages);
+
+  // Dispatch everything currently published in the message ring, straight
+  // out of the slots (no intermediate list; see thread.cc).
+  void DrainThreadMessages();
+  void HandleThreadMessage(const ThreadMessage& message);
   void PushThreadMessage(const ThreadMessage& t);
+
+  // ThreadMessages are delivered through a lock-free bounded
+  // multi-producer/single-consumer ring; each slot carries a sequence
+  // number telling producers when it's free and the consumer when it's
+  // full. On busy server builds the game, network-write, and audio
+  // threads all push here thousands of times a second, so they no longer
+  // contend on a mutex for every message. The mutex/cv pair below no
+  // longer guards the queue itself; it only implements the consumer's
+  // empty-queue sleep (producers take the lock just to wake it on the
+  // empty -> non-empty transition; see PushThreadMessage()).
+  static const uint32_t kThreadMessageRingSize = 16384;  // Power of two.
+  struct ThreadMessageSlot {
+    std::atomic<uint32_t> sequence{};
+    ThreadMessage message{ThreadMessage::Type::kShutdown};
+  };
+  std::unique_ptr<ThreadMessageSlot[]> thread_message_ring_;
+  std::atomic<uint32_t> thread_message_write_pos_{};
+
+  // Only advanced by the consumer; atomic just so the diagnostic tally
+  // can take a racy peek from producer threads.
+  std::atomic<uint32_t> thread_message_read_pos_{};
+  std::atomic<int> thread_message_count_{};
   std::condition_variable thread_message_cv_;
   std::mutex thread_message_mutex_;
-  std::list<ThreadMessage> thread_messages_;
-  int thread_message_count_ = 0;
   std::condition_variable data_to_client_cv_;
   std::mutex data_to_client_mutex_;
   std::list<std::vector<char> > data_to_client_;
+
+  // Launchers handed to the thread by BeginAddModule; owned (and only
+  // touched) by the owning thread, freed on launch confirmation.
+  std::list<ModuleLauncher*> pending_module_launchers_;
   std::vector<Module*> modules_;
   auto GetModule(int id) -> Module* {
     assert(id >= 0 && id < static_cast<int>(modules_.size()));
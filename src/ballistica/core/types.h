@@ -37,12 +37,14 @@ typedef int64_t millisecs_t;
 // to keep compile times down.
 
 class Account;
+class AABBTreeBroadphase;
 class App;
 class AppConfig;
 class AppGlobals;
 class AppInternal;
 class AreaOfInterest;
 class Audio;
+class AudioOcclusionGrid;
 class AudioServer;
 class AudioStreamer;
 class AudioSource;
@@ -55,6 +57,8 @@ struct BGDynamicsFuseData;
 class BGDynamicsHeightCache;
 class BGDynamicsShadow;
 struct BGDynamicsShadowData;
+class BGDynamicsTerrainQuery;
+struct BGDynamicsTerrainQueryData;
 class BGDynamicsVolumeLight;
 struct BGDynamicsVolumeLightData;
 class ButtonWidget;
@@ -69,6 +73,7 @@ class Collision;
 class CollisionCache;
 class Connection;
 class ConnectionSet;
+class ConnectionStats;
 class ConnectionToClient;
 class Context;
 class ContextTarget;
@@ -90,22 +95,26 @@ class Graphics;
 class GraphicsServer;
 class HostActivity;
 class HostSession;
+class HttpClientModule;
 class Huffman;
 class ImageMesh;
 class ImageWidget;
 class Input;
 class InputDevice;
+class JobPool;
 struct JointFixedEF;
 class Joystick;
 class KeyboardInput;
 class Material;
 class MaterialAction;
 class MaterialComponent;
+class MappedFile;
 class MaterialConditionNode;
 class MaterialContext;
 class Matrix44f;
 class Media;
 class MediaComponentData;
+class MediaPackFile;
 class MediaServer;
 class MeshBufferBase;
 class MeshBufferVertexSprite;
@@ -134,6 +143,10 @@ class NodeAttributeUnbound;
 class Object;
 class ObjectComponent;
 class GameStream;
+class LoadTest;
+class PacketPool;
+class ReplayBenchmark;
+class SoakTest;
 class Part;
 class Python;
 class Platform;
@@ -149,6 +162,7 @@ class Python;
 class PythonRef;
 class PythonCommand;
 class PythonContextCall;
+class QuadBatchMesh;
 template <typename T>
 class RealTimer;
 class Rect;
@@ -170,6 +184,7 @@ class SDLApp;
 class SDLContext;
 class Session;
 class SockAddr;
+class SocketEventLoop;
 class Sound;
 class SoundData;
 class SpriteMesh;
@@ -719,6 +734,7 @@ enum class ShadingType {
   kSimpleTexModulatedTransShadowFlatness,
   kSimpleTextureModulatedTransparentGlow,
   kSimpleTextureModulatedTransparentGlowMaskUV2,
+  kSimpleTextureModulatedTransparentSDF,
   kObject,
   kObjectTransparent,
   kObjectLightShadowTransparent,
@@ -750,6 +766,14 @@ enum class DrawType { kTriangles, kPoints };
 /// and stuff changed often should be dynamic.
 enum class MeshDrawType { kStatic, kDynamic };
 
+/// Waveforms for native node-attr repeaters run in scene stepping.
+enum class AttrRepeaterStyle {
+  kSine,
+  kSquare,
+  kTriangle,
+  kSawtooth
+};
+
 enum class ReflectionType {
   kNone,
   kChar,
@@ -864,7 +888,8 @@ enum class MeshDataType {
   kIndexedSimpleFull,
   kIndexedDualTextureFull,
   kIndexedSmokeFull,
-  kSprite
+  kSprite,
+  kSpriteInstanced
 };
 
 struct TouchEvent {
@@ -916,6 +941,14 @@ struct VertexObjectFull {
   uint8_t padding[2];
 };
 
+// Compressed variant of VertexObjectFull built at load time on devices
+// supporting packed vertex formats (normal as signed 2_10_10_10).
+struct VertexObjectCompressed {
+  float position[3];
+  uint16_t uv[2];
+  uint32_t normal_packed;
+};
+
 struct VertexSmokeFull {
   float position[3];
   float uv[2];
@@ -993,6 +1026,28 @@ enum class ThreadType {
   kMain
 };
 
+/// Scheduling classes for module threads; mapped to platform
+/// priorities/QoS classes by Platform::SetCurrentThreadClass().
+enum class ThreadClass {
+  /// Default OS scheduling.
+  kStandard,
+  /// Must never be starved; glitches are immediately audible.
+  kRealtimeAudio,
+  /// Should win the CPU promptly when packets are ready to go out.
+  kLatencySensitiveNetwork,
+  /// Throughput-oriented background work (media loads and the like);
+  /// fine to lose the CPU to everything above.
+  kBulkLoader
+};
+
+/// Severity of an OS memory warning (see App::OnMemoryPressure()).
+enum class MemoryPressureLevel {
+  /// Memory is getting tight; drop caches that are cheap to rebuild.
+  kModerate,
+  /// We're likely to be killed soon; drop everything droppable.
+  kCritical
+};
+
 /// Used for module-thread identification.
 /// Mostly just for debugging, through a few things are affected by this
 /// (the GAME thread manages the python GIL, etc).
@@ -1006,7 +1061,8 @@ enum class ThreadIdentifier {
   kNetworkWrite,
   kSuicide,
   kStdin,
-  kBGDynamics
+  kBGDynamics,
+  kHttpClient
 };
 
 enum class AccountType {
@@ -0,0 +1,362 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/dynamics/aabb_tree_broadphase.h"
+
+#include <algorithm>
+
+namespace ballistica {
+
+static auto CombineAABB(const float* a, const float* b, float* out) -> void {
+  out[0] = std::min(a[0], b[0]);
+  out[1] = std::max(a[1], b[1]);
+  out[2] = std::min(a[2], b[2]);
+  out[3] = std::max(a[3], b[3]);
+  out[4] = std::min(a[4], b[4]);
+  out[5] = std::max(a[5], b[5]);
+}
+
+// Surface area; the standard cost metric for insertion.
+static auto AABBArea(const float* a) -> float {
+  float dx = a[1] - a[0];
+  float dy = a[3] - a[2];
+  float dz = a[5] - a[4];
+  return 2.0f * (dx * dy + dy * dz + dz * dx);
+}
+
+static auto AABBContains(const float* outer, const float* inner) -> bool {
+  return outer[0] <= inner[0] && outer[1] >= inner[1] && outer[2] <= inner[2]
+         && outer[3] >= inner[3] && outer[4] <= inner[4]
+         && outer[5] >= inner[5];
+}
+
+static auto AABBOverlap(const float* a, const float* b) -> bool {
+  return a[0] <= b[1] && b[0] <= a[1] && a[2] <= b[3] && b[2] <= a[3]
+         && a[4] <= b[5] && b[4] <= a[5];
+}
+
+auto AABBTreeBroadphase::AllocNode() -> int {
+  if (free_list_ != kNullNode) {
+    int index = free_list_;
+    free_list_ = nodes_[index].parent;
+    nodes_[index].parent = kNullNode;
+    nodes_[index].child1 = kNullNode;
+    nodes_[index].child2 = kNullNode;
+    nodes_[index].height = 0;
+    nodes_[index].geom = nullptr;
+    return index;
+  }
+  Node node{};
+  node.parent = kNullNode;
+  node.child1 = kNullNode;
+  node.child2 = kNullNode;
+  nodes_.push_back(node);
+  return static_cast<int>(nodes_.size() - 1);
+}
+
+auto AABBTreeBroadphase::FreeNode(int index) -> void {
+  // Free nodes chain through their parent field.
+  nodes_[index].parent = free_list_;
+  nodes_[index].geom = nullptr;
+  free_list_ = index;
+}
+
+auto AABBTreeBroadphase::InsertLeaf(int leaf) -> void {
+  if (root_ == kNullNode) {
+    root_ = leaf;
+    nodes_[leaf].parent = kNullNode;
+    return;
+  }
+
+  // Descend toward the sibling whose pairing costs the least added
+  // surface area.
+  int index = root_;
+  while (!nodes_[index].is_leaf()) {
+    int child1 = nodes_[index].child1;
+    int child2 = nodes_[index].child2;
+
+    float area = AABBArea(nodes_[index].aabb);
+    float combined[6];
+    CombineAABB(nodes_[index].aabb, nodes_[leaf].aabb, combined);
+    float combined_area = AABBArea(combined);
+
+    // Cost of making a new parent for this node and the leaf.
+    float cost = 2.0f * combined_area;
+    float inheritance_cost = 2.0f * (combined_area - area);
+
+    float cost1;
+    CombineAABB(nodes_[leaf].aabb, nodes_[child1].aabb, combined);
+    if (nodes_[child1].is_leaf()) {
+      cost1 = AABBArea(combined) + inheritance_cost;
+    } else {
+      cost1 = (AABBArea(combined) - AABBArea(nodes_[child1].aabb))
+              + inheritance_cost;
+    }
+
+    float cost2;
+    CombineAABB(nodes_[leaf].aabb, nodes_[child2].aabb, combined);
+    if (nodes_[child2].is_leaf()) {
+      cost2 = AABBArea(combined) + inheritance_cost;
+    } else {
+      cost2 = (AABBArea(combined) - AABBArea(nodes_[child2].aabb))
+              + inheritance_cost;
+    }
+
+    if (cost < cost1 && cost < cost2) {
+      break;
+    }
+    index = (cost1 < cost2) ? child1 : child2;
+  }
+
+  int sibling = index;
+  int old_parent = nodes_[sibling].parent;
+  int new_parent = AllocNode();
+  nodes_[new_parent].parent = old_parent;
+  CombineAABB(nodes_[leaf].aabb, nodes_[sibling].aabb,
+              nodes_[new_parent].aabb);
+  nodes_[new_parent].height = nodes_[sibling].height + 1;
+  nodes_[new_parent].child1 = sibling;
+  nodes_[new_parent].child2 = leaf;
+  nodes_[sibling].parent = new_parent;
+  nodes_[leaf].parent = new_parent;
+  if (old_parent == kNullNode) {
+    root_ = new_parent;
+  } else if (nodes_[old_parent].child1 == sibling) {
+    nodes_[old_parent].child1 = new_parent;
+  } else {
+    nodes_[old_parent].child2 = new_parent;
+  }
+
+  // Walk back up refitting bounds and rebalancing.
+  index = nodes_[leaf].parent;
+  while (index != kNullNode) {
+    index = Balance(index);
+    int child1 = nodes_[index].child1;
+    int child2 = nodes_[index].child2;
+    nodes_[index].height =
+        1 + std::max(nodes_[child1].height, nodes_[child2].height);
+    CombineAABB(nodes_[child1].aabb, nodes_[child2].aabb, nodes_[index].aabb);
+    index = nodes_[index].parent;
+  }
+}
+
+auto AABBTreeBroadphase::RemoveLeaf(int leaf) -> void {
+  if (leaf == root_) {
+    root_ = kNullNode;
+    return;
+  }
+
+  int parent = nodes_[leaf].parent;
+  int grand_parent = nodes_[parent].parent;
+  int sibling = (nodes_[parent].child1 == leaf) ? nodes_[parent].child2
+                                                : nodes_[parent].child1;
+  if (grand_parent == kNullNode) {
+    root_ = sibling;
+    nodes_[sibling].parent = kNullNode;
+    FreeNode(parent);
+    return;
+  }
+
+  // Splice the sibling up into the parent's place.
+  if (nodes_[grand_parent].child1 == parent) {
+    nodes_[grand_parent].child1 = sibling;
+  } else {
+    nodes_[grand_parent].child2 = sibling;
+  }
+  nodes_[sibling].parent = grand_parent;
+  FreeNode(parent);
+
+  int index = grand_parent;
+  while (index != kNullNode) {
+    index = Balance(index);
+    int child1 = nodes_[index].child1;
+    int child2 = nodes_[index].child2;
+    CombineAABB(nodes_[child1].aabb, nodes_[child2].aabb, nodes_[index].aabb);
+    nodes_[index].height =
+        1 + std::max(nodes_[child1].height, nodes_[child2].height);
+    index = nodes_[index].parent;
+  }
+}
+
+auto AABBTreeBroadphase::Balance(int i_a) -> int {
+  assert(i_a != kNullNode);
+  if (nodes_[i_a].is_leaf() || nodes_[i_a].height < 2) {
+    return i_a;
+  }
+
+  int i_b = nodes_[i_a].child1;
+  int i_c = nodes_[i_a].child2;
+  int balance = nodes_[i_c].height - nodes_[i_b].height;
+
+  // Rotate C up.
+  if (balance > 1) {
+    int i_f = nodes_[i_c].child1;
+    int i_g = nodes_[i_c].child2;
+
+    nodes_[i_c].child1 = i_a;
+    nodes_[i_c].parent = nodes_[i_a].parent;
+    nodes_[i_a].parent = i_c;
+    if (nodes_[i_c].parent != kNullNode) {
+      if (nodes_[nodes_[i_c].parent].child1 == i_a) {
+        nodes_[nodes_[i_c].parent].child1 = i_c;
+      } else {
+        nodes_[nodes_[i_c].parent].child2 = i_c;
+      }
+    } else {
+      root_ = i_c;
+    }
+
+    if (nodes_[i_f].height > nodes_[i_g].height) {
+      nodes_[i_c].child2 = i_f;
+      nodes_[i_a].child2 = i_g;
+      nodes_[i_g].parent = i_a;
+      CombineAABB(nodes_[i_b].aabb, nodes_[i_g].aabb, nodes_[i_a].aabb);
+      CombineAABB(nodes_[i_a].aabb, nodes_[i_f].aabb, nodes_[i_c].aabb);
+      nodes_[i_a].height =
+          1 + std::max(nodes_[i_b].height, nodes_[i_g].height);
+      nodes_[i_c].height =
+          1 + std::max(nodes_[i_a].height, nodes_[i_f].height);
+    } else {
+      nodes_[i_c].child2 = i_g;
+      nodes_[i_a].child2 = i_f;
+      nodes_[i_f].parent = i_a;
+      CombineAABB(nodes_[i_b].aabb, nodes_[i_f].aabb, nodes_[i_a].aabb);
+      CombineAABB(nodes_[i_a].aabb, nodes_[i_g].aabb, nodes_[i_c].aabb);
+      nodes_[i_a].height =
+          1 + std::max(nodes_[i_b].height, nodes_[i_f].height);
+      nodes_[i_c].height =
+          1 + std::max(nodes_[i_a].height, nodes_[i_g].height);
+    }
+    return i_c;
+  }
+
+  // Rotate B up.
+  if (balance < -1) {
+    int i_d = nodes_[i_b].child1;
+    int i_e = nodes_[i_b].child2;
+
+    nodes_[i_b].child1 = i_a;
+    nodes_[i_b].parent = nodes_[i_a].parent;
+    nodes_[i_a].parent = i_b;
+    if (nodes_[i_b].parent != kNullNode) {
+      if (nodes_[nodes_[i_b].parent].child1 == i_a) {
+        nodes_[nodes_[i_b].parent].child1 = i_b;
+      } else {
+        nodes_[nodes_[i_b].parent].child2 = i_b;
+      }
+    } else {
+      root_ = i_b;
+    }
+
+    if (nodes_[i_d].height > nodes_[i_e].height) {
+      nodes_[i_b].child2 = i_d;
+      nodes_[i_a].child1 = i_e;
+      nodes_[i_e].parent = i_a;
+      CombineAABB(nodes_[i_e].aabb, nodes_[i_c].aabb, nodes_[i_a].aabb);
+      CombineAABB(nodes_[i_a].aabb, nodes_[i_d].aabb, nodes_[i_b].aabb);
+      nodes_[i_a].height =
+          1 + std::max(nodes_[i_e].height, nodes_[i_c].height);
+      nodes_[i_b].height =
+          1 + std::max(nodes_[i_a].height, nodes_[i_d].height);
+    } else {
+      nodes_[i_b].child2 = i_e;
+      nodes_[i_a].child1 = i_d;
+      nodes_[i_d].parent = i_a;
+      CombineAABB(nodes_[i_d].aabb, nodes_[i_c].aabb, nodes_[i_a].aabb);
+      CombineAABB(nodes_[i_a].aabb, nodes_[i_e].aabb, nodes_[i_b].aabb);
+      nodes_[i_a].height =
+          1 + std::max(nodes_[i_d].height, nodes_[i_c].height);
+      nodes_[i_b].height =
+          1 + std::max(nodes_[i_a].height, nodes_[i_e].height);
+    }
+    return i_b;
+  }
+
+  return i_a;
+}
+
+auto AABBTreeBroadphase::QueryLeaf(int leaf, void* data,
+                                   dNearCallback* callback) -> void {
+  query_stack_.clear();
+  if (root_ != kNullNode) {
+    query_stack_.push_back(root_);
+  }
+  while (!query_stack_.empty()) {
+    int index = query_stack_.back();
+    query_stack_.pop_back();
+    if (!AABBOverlap(nodes_[index].aabb, nodes_[leaf].aabb)) {
+      continue;
+    }
+    if (nodes_[index].is_leaf()) {
+      // Visit each pair once (from its lower-indexed leaf) and let the
+      // narrowphase see only enabled geoms, like dSpaceCollide().
+      if (index > leaf && dGeomIsEnabled(nodes_[index].geom)) {
+        (*callback)(data, nodes_[leaf].geom, nodes_[index].geom);
+      }
+    } else {
+      query_stack_.push_back(nodes_[index].child1);
+      query_stack_.push_back(nodes_[index].child2);
+    }
+  }
+}
+
+auto AABBTreeBroadphase::CollidePairs(dSpaceID space, void* data,
+                                      dNearCallback* callback) -> void {
+  sync_stamp_++;
+
+  // Pull current bounds for everything in the space, adding leaves for
+  // newcomers and reinserting anything that outgrew its fat bounds.
+  int geom_count = dSpaceGetNumGeoms(space);
+  for (int i = 0; i < geom_count; i++) {
+    dGeomID geom = dSpaceGetGeom(space, i);
+    dReal aabb[6];
+    dGeomGetAABB(geom, aabb);
+
+    auto iter = leaf_for_geom_.find(geom);
+    if (iter == leaf_for_geom_.end()) {
+      int leaf = AllocNode();
+      for (int j = 0; j < 6; j++) {
+        float margin = (j % 2 == 0) ? -kAABBMargin : kAABBMargin;
+        nodes_[leaf].aabb[j] = static_cast<float>(aabb[j]) + margin;
+      }
+      nodes_[leaf].geom = geom;
+      nodes_[leaf].stamp = sync_stamp_;
+      InsertLeaf(leaf);
+      leaf_for_geom_[geom] = leaf;
+    } else {
+      int leaf = iter->second;
+      nodes_[leaf].stamp = sync_stamp_;
+      float tight[6];
+      for (int j = 0; j < 6; j++) {
+        tight[j] = static_cast<float>(aabb[j]);
+      }
+      if (!AABBContains(nodes_[leaf].aabb, tight)) {
+        RemoveLeaf(leaf);
+        for (int j = 0; j < 6; j++) {
+          float margin = (j % 2 == 0) ? -kAABBMargin : kAABBMargin;
+          nodes_[leaf].aabb[j] = tight[j] + margin;
+        }
+        InsertLeaf(leaf);
+      }
+    }
+  }
+
+  // Drop leaves for geoms no longer in the space.
+  for (auto iter = leaf_for_geom_.begin(); iter != leaf_for_geom_.end();) {
+    if (nodes_[iter->second].stamp != sync_stamp_) {
+      RemoveLeaf(iter->second);
+      FreeNode(iter->second);
+      iter = leaf_for_geom_.erase(iter);
+    } else {
+      iter++;
+    }
+  }
+
+  // Now report overlapping pairs.
+  for (auto&& entry : leaf_for_geom_) {
+    if (dGeomIsEnabled(entry.first)) {
+      QueryLeaf(entry.second, data, callback);
+    }
+  }
+}
+
+}  // namespace ballistica
@@ -0,0 +1,67 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_DYNAMICS_AABB_TREE_BROADPHASE_H_
+#define BALLISTICA_DYNAMICS_AABB_TREE_BROADPHASE_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/ballistica.h"
+#include "ode/ode.h"
+
+namespace ballistica {
+
+// Dynamic AABB-tree broadphase for the geoms in an ODE space. Leaves
+// store fattened bounds so slow-moving bodies stay put frame to frame;
+// a geom escaping its fat bounds gets pulled and reinserted (and the
+// tree rebalanced) rather than the tree being rebuilt. Pair generation
+// walks the tree, so its cost tracks actual overlap counts instead of
+// hash-cell density.
+class AABBTreeBroadphase {
+ public:
+  // Sync leaves against the space's current contents, refit anything
+  // that moved, then report each unique overlapping pair of enabled
+  // geoms to the callback (mirroring dSpaceCollide()).
+  auto CollidePairs(dSpaceID space, void* data, dNearCallback* callback)
+      -> void;
+
+ private:
+  // How much leaf bounds get fattened, in world units.
+  static constexpr float kAABBMargin = 0.3f;
+  static constexpr int kNullNode = -1;
+
+  struct Node {
+    // Bounds in ODE order: (lo_x, hi_x, lo_y, hi_y, lo_z, hi_z).
+    float aabb[6];
+    dGeomID geom;  // Set for leaves only.
+    int parent;
+    int child1;
+    int child2;
+    int height;  // Zero for leaves.
+    uint32_t stamp;
+    auto is_leaf() const -> bool { return child1 == kNullNode; }
+  };
+
+  auto AllocNode() -> int;
+  auto FreeNode(int index) -> void;
+  auto InsertLeaf(int leaf) -> void;
+  auto RemoveLeaf(int leaf) -> void;
+
+  // Rebalance starting at the given node; returns its replacement.
+  auto Balance(int index) -> int;
+
+  // Report overlaps between this leaf and higher-indexed leaves (so
+  // each pair gets seen exactly once per sweep).
+  auto QueryLeaf(int leaf, void* data, dNearCallback* callback) -> void;
+
+  std::vector<Node> nodes_;
+  std::vector<int> query_stack_;
+  std::unordered_map<dGeomID, int> leaf_for_geom_;
+  int root_{kNullNode};
+  int free_list_{kNullNode};
+  uint32_t sync_stamp_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_DYNAMICS_AABB_TREE_BROADPHASE_H_
@@ -2,15 +2,21 @@
 
 #include "ballistica/dynamics/bg/bg_dynamics.h"
 
+#include <algorithm>
+#include <cmath>
 #include <utility>
 #include <vector>
 
+#include "ballistica/app/app.h"
 #include "ballistica/core/thread.h"
 #include "ballistica/dynamics/bg/bg_dynamics_draw_snapshot.h"
+#include "ballistica/game/game.h"
 #include "ballistica/dynamics/bg/bg_dynamics_fuse_data.h"
 #include "ballistica/dynamics/bg/bg_dynamics_shadow_data.h"
+#include "ballistica/dynamics/bg/bg_dynamics_terrain_query_data.h"
 #include "ballistica/dynamics/bg/bg_dynamics_volume_light_data.h"
 #include "ballistica/graphics/component/object_component.h"
+#include "ballistica/graphics/graphics.h"
 #include "ballistica/graphics/component/smoke_component.h"
 #include "ballistica/graphics/component/sprite_component.h"
 #include "ballistica/graphics/renderer.h"
@@ -27,6 +33,16 @@ BGDynamics::BGDynamics() {
   assert(InGameThread());
   assert(g_bg_dynamics == nullptr);
   g_bg_dynamics = this;
+
+  // Memory warnings get the same response as slow rendering: cull a
+  // good chunk of existing smoke/debris and lower the caps.
+  App::AddMemoryPressureCallback(
+      MemoryPressureLevel::kModerate, [](MemoryPressureLevel level) {
+        if (g_game == nullptr) {
+          return;
+        }
+        g_game->PushCall([] { g_bg_dynamics->TooSlow(); });
+      });
 }
 
 void BGDynamics::AddTerrain(CollideModelData* o) {
@@ -46,6 +62,18 @@ void BGDynamics::RemoveTerrain(CollideModelData* o) {
 
 void BGDynamics::Emit(const BGDynamicsEmission& e) {
   assert(InGameThread());
+
+  // When the effect budget governor says we're running over, thin out
+  // emission counts; fewer chunks/tendrils now beats pruning them later.
+  float lod = g_graphics->effect_lod();
+  if (lod < 1.0f && e.count > 1) {
+    BGDynamicsEmission e2 = e;
+    e2.count = std::max(1, static_cast<int>(std::round(
+                               static_cast<float>(e.count)
+                               * (0.25f + 0.75f * lod))));
+    g_bg_dynamics_server->PushEmitCall(e2);
+    return;
+  }
   g_bg_dynamics_server->PushEmitCall(e);
 }
 
@@ -138,6 +166,29 @@ void BGDynamics::Step(const Vector3f& cam_pos) {
     }
     BA_DEBUG_TIME_CHECK_END(bg_dynamic_fuse_list_lock, 10);
   }
+  {  // Terrain queries.
+    BA_DEBUG_TIME_CHECK_BEGIN(bg_dynamic_terrain_query_list_lock);
+    {
+      std::lock_guard<std::mutex> lock(
+          g_bg_dynamics_server->terrain_query_list_mutex_);
+      auto size = g_bg_dynamics_server->terrain_queries_.size();
+      d->terrain_query_step_data_.resize(size);
+      if (size > 0) {
+        BGDynamicsTerrainQueryData** qd_client =
+            &(g_bg_dynamics_server->terrain_queries_[0]);
+        std::pair<BGDynamicsTerrainQueryData*,
+                  BGDynamicsServer::TerrainQueryStepData>* qd =
+            &(d->terrain_query_step_data_[0]);
+        for (size_t i = 0; i < size; i++) {
+          // Set to nullptr (for ignore) if the client side is dead.
+          qd[i].first = qd_client[i]->client_dead ? nullptr : qd_client[i];
+          qd[i].second.position = qd_client[i]->pos_client;
+          qd[i].second.radius = qd_client[i]->radius_client;
+        }
+      }
+    }
+    BA_DEBUG_TIME_CHECK_END(bg_dynamic_terrain_query_list_lock, 10);
+  }
 
   // Increase our step count and ship it.
   {
@@ -22,6 +22,8 @@ enum class BGDynamicsEmitType {
 
 enum class BGDynamicsTendrilType { kSmoke, kThinSmoke, kIce };
 
+enum class BGDynamicsTerrainQueryType { kRayDown, kSphere };
+
 enum class BGDynamicsChunkType {
   kRock,
   kIce,
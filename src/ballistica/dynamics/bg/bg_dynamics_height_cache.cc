@@ -4,6 +4,12 @@
 
 #include <algorithm>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace ballistica {
 
 const int kBGDynamicsHeightCacheMaxContacts = 20;
@@ -101,6 +107,89 @@ auto BGDynamicsHeightCache::Sample(const Vector3f& pos) -> float {
   return zFin * (1.0f - zBlend) + ZFin * zBlend;
 }
 
+void BGDynamicsHeightCache::SampleBatch(const Vector3f* positions,
+                                        float* out_heights, size_t count) {
+  if (count == 0) {
+    return;
+  }
+  if (dirty_) {
+    Update();
+  }
+
+  // Stack scratch for corner-gather; big enough that the blend loops
+  // get decent runs, small enough to stay cache-friendly.
+  constexpr size_t kChunkSize = 64;
+  float h00[kChunkSize], h10[kChunkSize], h01[kChunkSize], h11[kChunkSize];
+  float x_blend[kChunkSize], z_blend[kChunkSize];
+
+  for (size_t base = 0; base < count; base += kChunkSize) {
+    size_t chunk = std::min(kChunkSize, count - base);
+
+    // Gather pass: resolve each sample's 4 contributing cells (filling
+    // the cache where needed) into contiguous corner arrays.
+    for (size_t i = 0; i < chunk; i++) {
+      const Vector3f& pos = positions[base + i];
+      float x = static_cast<float>(grid_width_)
+                    * ((pos.x - x_min_) / (x_max_ - x_min_))
+                - 0.5f;
+      float z = static_cast<float>(grid_height_)
+                    * ((pos.z - z_min_) / (z_max_ - z_min_))
+                - 0.5f;
+      int x_lo = static_cast<int>(floor(x));
+      x_lo = std::max(0, std::min(grid_width_ - 1, x_lo));
+      int x_hi = static_cast<int>(ceil(x));
+      x_hi = std::max(0, std::min(grid_width_ - 1, x_hi));
+      int z_lo = static_cast<int>(floor(z));
+      z_lo = std::max(0, std::min(grid_height_ - 1, z_lo));
+      int z_hi = static_cast<int>(ceil(z));
+      z_hi = std::max(0, std::min(grid_height_ - 1, z_hi));
+      x_blend[i] = fmod(x, 1.0f);
+      z_blend[i] = fmod(z, 1.0f);
+      h00[i] = SampleCell(x_lo, z_lo);
+      h10[i] = SampleCell(x_hi, z_lo);
+      h01[i] = SampleCell(x_lo, z_hi);
+      h11[i] = SampleCell(x_hi, z_hi);
+    }
+
+    // Blend pass: the same bilinear mix Sample() does, 4 samples per
+    // iteration.
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 4 <= chunk; i += 4) {
+      __m128 xb = _mm_loadu_ps(x_blend + i);
+      __m128 zb = _mm_loadu_ps(z_blend + i);
+      __m128 c00 = _mm_loadu_ps(h00 + i);
+      __m128 c10 = _mm_loadu_ps(h10 + i);
+      __m128 c01 = _mm_loadu_ps(h01 + i);
+      __m128 c11 = _mm_loadu_ps(h11 + i);
+      __m128 row0 = _mm_add_ps(c00, _mm_mul_ps(xb, _mm_sub_ps(c10, c00)));
+      __m128 row1 = _mm_add_ps(c01, _mm_mul_ps(xb, _mm_sub_ps(c11, c01)));
+      __m128 result =
+          _mm_add_ps(row0, _mm_mul_ps(zb, _mm_sub_ps(row1, row0)));
+      _mm_storeu_ps(out_heights + base + i, result);
+    }
+#elif defined(__ARM_NEON)
+    for (; i + 4 <= chunk; i += 4) {
+      float32x4_t xb = vld1q_f32(x_blend + i);
+      float32x4_t zb = vld1q_f32(z_blend + i);
+      float32x4_t c00 = vld1q_f32(h00 + i);
+      float32x4_t c10 = vld1q_f32(h10 + i);
+      float32x4_t c01 = vld1q_f32(h01 + i);
+      float32x4_t c11 = vld1q_f32(h11 + i);
+      float32x4_t row0 = vmlaq_f32(c00, xb, vsubq_f32(c10, c00));
+      float32x4_t row1 = vmlaq_f32(c01, xb, vsubq_f32(c11, c01));
+      float32x4_t result = vmlaq_f32(row0, zb, vsubq_f32(row1, row0));
+      vst1q_f32(out_heights + base + i, result);
+    }
+#endif
+    for (; i < chunk; i++) {
+      float row0 = h00[i] + x_blend[i] * (h10[i] - h00[i]);
+      float row1 = h01[i] + x_blend[i] * (h11[i] - h01[i]);
+      out_heights[base + i] = row0 + z_blend[i] * (row1 - row0);
+    }
+  }
+}
+
 void BGDynamicsHeightCache::SetGeoms(const std::vector<dGeomID>& geoms) {
   dirty_ = true;
   geoms_ = geoms;
@@ -17,6 +17,12 @@ class BGDynamicsHeightCache {
   BGDynamicsHeightCache();
   ~BGDynamicsHeightCache();
   auto Sample(const Vector3f& pos) -> float;
+
+  // Sample a run of positions at once. Cell resolution happens in a
+  // scalar gather pass (filling the cache where needed) and the
+  // bilinear blends then run 4-wide where SIMD is available.
+  void SampleBatch(const Vector3f* positions, float* out_heights,
+                   size_t count);
   void SetGeoms(const std::vector<dGeomID>& geoms);
 
  private:
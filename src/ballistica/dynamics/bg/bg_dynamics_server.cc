@@ -5,16 +5,21 @@
 #include <algorithm>
 #include <list>
 #include <memory>
+#include <thread>
 #include <vector>
 
+#include "ballistica/core/profiler.h"
 #include "ballistica/dynamics/bg/bg_dynamics_draw_snapshot.h"
 #include "ballistica/dynamics/bg/bg_dynamics_fuse_data.h"
 #include "ballistica/dynamics/bg/bg_dynamics_height_cache.h"
 #include "ballistica/dynamics/bg/bg_dynamics_shadow_data.h"
+#include "ballistica/dynamics/bg/bg_dynamics_terrain_query_data.h"
 #include "ballistica/dynamics/bg/bg_dynamics_volume_light_data.h"
 #include "ballistica/dynamics/collision_cache.h"
 #include "ballistica/game/game.h"
+#include "ballistica/generic/job_pool.h"
 #include "ballistica/generic/utils.h"
+#include "ballistica/graphics/frame_ledger.h"
 #include "ballistica/graphics/graphics_server.h"
 #include "ballistica/media/component/collide_model.h"
 #include "ballistica/platform/platform.h"
@@ -502,48 +507,96 @@ class BGDynamicsServer::Chunk {
   friend class BGDynamicsServer;
 };  // Chunk
 
+void BGDynamicsServer::ParticleArrays::Resize(size_t count) {
+  x.resize(count);
+  y.resize(count);
+  z.resize(count);
+  vx.resize(count);
+  vy.resize(count);
+  vz.resize(count);
+  r.resize(count);
+  g.resize(count);
+  b.resize(count);
+  a.resize(count);
+  life.resize(count);
+  d_life.resize(count);
+  flicker.resize(count);
+  flicker_scale.resize(count);
+  size.resize(count);
+  d_size.resize(count);
+}
+
 // Contains 2 ping-ponging particle buffers.
 void BGDynamicsServer::ParticleSet::Emit(const Vector3f& pos,
                                          const Vector3f& vel, float r, float g,
                                          float b, float a, float dlife,
                                          float size, float d_size,
                                          float flicker) {
-  particles[current_set].resize(particles[current_set].size() + 1);
-  Particle& p(particles[current_set].back());
-  p.x = pos.x;
-  p.y = pos.y;
-  p.z = pos.z;
-  p.vx = vel.x * 1.0f + 0.02f * (RandomFloat() - 0.5f);
-  p.vy = vel.y * 1.0f + 0.02f * (RandomFloat() - 0.5f);
-  p.vz = vel.z * 1.0f + 0.02f * (RandomFloat() - 0.5f);
-  p.r = r;
-  p.g = g;
-  p.b = b;
-  p.a = a;
-  p.life = 1.0f;
+  ParticleArrays& p(particles[current_set]);
+  p.x.push_back(pos.x);
+  p.y.push_back(pos.y);
+  p.z.push_back(pos.z);
+  p.vx.push_back(vel.x * 1.0f + 0.02f * (RandomFloat() - 0.5f));
+  p.vy.push_back(vel.y * 1.0f + 0.02f * (RandomFloat() - 0.5f));
+  p.vz.push_back(vel.z * 1.0f + 0.02f * (RandomFloat() - 0.5f));
+  p.r.push_back(r);
+  p.g.push_back(g);
+  p.b.push_back(b);
+  p.a.push_back(a);
+  p.life.push_back(1.0f);
   assert(dlife < 0.0f);
-  p.d_life = dlife;
-  p.size = size;
-  p.flicker = 1.0f;
-  p.flicker_scale = flicker;
-  p.d_size = d_size;
+  p.d_life.push_back(dlife);
+  p.size.push_back(size);
+  p.flicker.push_back(1.0f);
+  p.flicker_scale.push_back(flicker);
+  p.d_size.push_back(d_size);
 }
 
 void BGDynamicsServer::ParticleSet::UpdateAndCreateSnapshot(
     Object::Ref<MeshIndexBuffer16>* index_buffer,
     Object::Ref<MeshBufferVertexSprite>* buffer) {
-  auto p_count = static_cast<uint32_t>(particles[current_set].size());
+  ParticleArrays& src(particles[current_set]);
+  ParticleArrays& dst(particles[!current_set]);
+  auto p_count = static_cast<uint32_t>(src.count());
 
   // Quick-out: return empty.
   if (p_count == 0) {
     return;
   }
 
-  Particle* p_src = &particles[current_set][0];
+  // Integrate in place first. These loops each walk one or two
+  // contiguous float arrays with no branches, so they vectorize.
+  {
+    float* life = src.life.data();
+    const float* d_life = src.d_life.data();
+    for (uint32_t i = 0; i < p_count; i++) {
+      life[i] += d_life[i];
+    }
+    float* size = src.size.data();
+    const float* d_size = src.d_size.data();
+    for (uint32_t i = 0; i < p_count; i++) {
+      size[i] = std::max(0.0f, size[i] + d_size[i]);
+    }
+    float* x = src.x.data();
+    const float* vx = src.vx.data();
+    for (uint32_t i = 0; i < p_count; i++) {
+      x[i] += vx[i];
+    }
+    float* y = src.y.data();
+    float* vy = src.vy.data();
+    for (uint32_t i = 0; i < p_count; i++) {
+      y[i] += vy[i];
+      vy[i] -= 0.00001f;
+    }
+    float* z = src.z.data();
+    const float* vz = src.vz.data();
+    for (uint32_t i = 0; i < p_count; i++) {
+      z[i] += vz[i];
+    }
+  }
 
   // Resize target to fit if all particles stay alive.
-  particles[!current_set].resize(particles[current_set].size());
-  Particle* p_dst = &particles[!current_set][0];
+  dst.Resize(p_count);
 
   auto* ibuf = Object::NewDeferred<MeshIndexBuffer16>(p_count * 6);
 
@@ -561,47 +614,51 @@ void BGDynamicsServer::ParticleSet::UpdateAndCreateSnapshot(
   uint32_t p_index = 0;
   uint32_t p_count_remaining = 0;
   uint32_t p_count_rendered = 0;
+
+  // Now a compaction pass: surviving particles copy down into the other
+  // buffer and living visible ones write their quads straight into the
+  // snapshot buffers.
   for (uint32_t i = 0; i < p_count; i++) {
-    float life = p_src->life + p_src->d_life;
+    float life = src.life[i];
+    float size = src.size[i];
 
     // Our opacity drops rapidly at the end.
     float o = 1.0f - life;
     o = 1.0f - (o * o * o);
-    float size = std::max(0.0f, p_src->size + p_src->d_size);
 
     // Kill the particle if life or size falls to 0.
     if (life > 0.0f && size > 0) {
-      p_count_remaining++;
-      p_dst->life = life;
-      p_dst->size = size;
-      p_dst->x = p_src->x + p_src->vx;
-      p_dst->y = p_src->y + p_src->vy;
-      p_dst->z = p_src->z + p_src->vz;
-      p_dst->r = p_src->r;
-      p_dst->g = p_src->g;
-      p_dst->b = p_src->b;
-      p_dst->a = p_src->a;
-      p_dst->vx = p_src->vx;
-      p_dst->vy = p_src->vy - 0.00001f;
-      p_dst->vz = p_src->vz;
-      p_dst->d_life = p_src->d_life;
-      p_dst->d_size = p_src->d_size;
-      p_dst->flicker_scale = p_src->flicker_scale;
+      uint32_t d = p_count_remaining++;
+      dst.life[d] = life;
+      dst.size[d] = size;
+      dst.x[d] = src.x[i];
+      dst.y[d] = src.y[i];
+      dst.z[d] = src.z[i];
+      dst.r[d] = src.r[i];
+      dst.g[d] = src.g[i];
+      dst.b[d] = src.b[i];
+      dst.a[d] = src.a[i];
+      dst.vx[d] = src.vx[i];
+      dst.vy[d] = src.vy[i];
+      dst.vz[d] = src.vz[i];
+      dst.d_life[d] = src.d_life[i];
+      dst.d_size[d] = src.d_size[i];
+      dst.flicker_scale[d] = src.flicker_scale[i];
 
       // Every so often update our flicker value if we're flickering.
-      if (p_src->flicker_scale != 0.0f) {
+      if (src.flicker_scale[i] != 0.0f) {
         if (RandomFloat() < 0.2f) {
-          p_dst->flicker = std::max(
-              0.0f, 1.0f + (RandomFloat() - 0.5f) * p_src->flicker_scale);
+          dst.flicker[d] = std::max(
+              0.0f, 1.0f + (RandomFloat() - 0.5f) * src.flicker_scale[i]);
         } else {
-          p_dst->flicker = p_src->flicker;
+          dst.flicker[d] = src.flicker[i];
         }
       } else {
-        p_dst->flicker = 1.0f;
+        dst.flicker[d] = 1.0f;
       }
 
       // Render this point if its got a positive size.
-      if (p_dst->flicker > 0.0f && p_dst->size > 0.0f) {
+      if (dst.flicker[d] > 0.0f && dst.size[d] > 0.0f) {
         p_count_rendered++;
 
         // Add our 6 indices.
@@ -624,34 +681,32 @@ void BGDynamicsServer::ParticleSet::UpdateAndCreateSnapshot(
         p_render[3].uv[1] = 65535;
 
         p_render[0].position[0] = p_render[1].position[0] =
-            p_render[2].position[0] = p_render[3].position[0] = p_dst->x;
+            p_render[2].position[0] = p_render[3].position[0] = dst.x[d];
         p_render[0].position[1] = p_render[1].position[1] =
-            p_render[2].position[1] = p_render[3].position[1] = p_dst->y;
+            p_render[2].position[1] = p_render[3].position[1] = dst.y[d];
         p_render[0].position[2] = p_render[1].position[2] =
-            p_render[2].position[2] = p_render[3].position[2] = p_dst->z;
+            p_render[2].position[2] = p_render[3].position[2] = dst.z[d];
         p_render[0].size = p_render[1].size = p_render[2].size =
-            p_render[3].size = p_dst->size * p_dst->flicker;
+            p_render[3].size = dst.size[d] * dst.flicker[d];
         p_render[0].color[0] = p_render[1].color[0] = p_render[2].color[0] =
-            p_render[3].color[0] = p_dst->r * o;
+            p_render[3].color[0] = dst.r[d] * o;
         p_render[0].color[1] = p_render[1].color[1] = p_render[2].color[1] =
-            p_render[3].color[1] = p_dst->g * o;
+            p_render[3].color[1] = dst.g[d] * o;
         p_render[0].color[2] = p_render[1].color[2] = p_render[2].color[2] =
-            p_render[3].color[2] = p_dst->b * o;
+            p_render[3].color[2] = dst.b[d] * o;
         p_render[0].color[3] = p_render[1].color[3] = p_render[2].color[3] =
-            p_render[3].color[3] = p_dst->a * o;
+            p_render[3].color[3] = dst.a[d] * o;
 
         i_render += 6;
         p_render += 4;
         p_index += 4;
       }
-      p_dst++;
     }
-    p_src++;
   }
 
   // Clamp dst and render sets to account for deaths.
   if (p_count != p_count_remaining) {
-    particles[!current_set].resize(p_count_remaining);
+    dst.Resize(p_count_remaining);
   }
 
   if (p_count != p_count_rendered) {
@@ -1428,6 +1483,36 @@ void BGDynamicsServer::PushRemoveShadowCall(BGDynamicsShadowData* shadow_data) {
   });
 }
 
+void BGDynamicsServer::PushAddTerrainQueryCall(
+    BGDynamicsTerrainQueryData* query_data) {
+  PushCall([this, query_data] {
+    assert(InBGDynamicsThread());
+    std::lock_guard<std::mutex> lock(terrain_query_list_mutex_);
+    terrain_queries_.push_back(query_data);
+  });
+}
+
+void BGDynamicsServer::PushRemoveTerrainQueryCall(
+    BGDynamicsTerrainQueryData* query_data) {
+  PushCall([this, query_data] {
+    assert(InBGDynamicsThread());
+    bool found = false;
+    {
+      std::lock_guard<std::mutex> lock(terrain_query_list_mutex_);
+      for (auto i = terrain_queries_.begin(); i != terrain_queries_.end();
+           ++i) {
+        if ((*i) == query_data) {
+          found = true;
+          terrain_queries_.erase(i);
+          break;
+        }
+      }
+    }
+    assert(found);
+    delete query_data;
+  });
+}
+
 void BGDynamicsServer::PushAddVolumeLightCall(
     BGDynamicsVolumeLightData* volume_light_data) {
   PushCall([this, volume_light_data] {
@@ -2263,6 +2348,10 @@ void BGDynamicsServer::PushTooSlowCall() {
 void BGDynamicsServer::Step(StepData* step_data) {
   assert(InBGDynamicsThread());
   assert(step_data);
+  BA_PROFILE_SCOPE("bg-dynamics-step");
+
+  bool ledger = FrameLedger::enabled();
+  int64_t ledger_start = ledger ? Platform::GetCurrentMicroseconds() : 0;
 
   // Grab a ref to the raw StepData pointer we were passed.. we now own the
   // data.
@@ -2301,17 +2390,40 @@ void BGDynamicsServer::Step(StepData* step_data) {
       fuse->length_worker_ = fuse_step.length;
     }
   }
+  for (auto&& i : step_data->terrain_query_step_data_) {
+    BGDynamicsTerrainQueryData* query{i.first};
+    if (query) {
+      const TerrainQueryStepData& query_step(i.second);
+      query->pos_worker = query_step.position;
+      query->radius_worker = query_step.radius;
+    }
+  }
 
-  // Handle shadows first since they need to get back to the client
-  // as soon as possible.
-  UpdateShadows();
-
-  // Go ahead and run this step for all our existing stuff.
+  // Our update phases mostly touch disjoint data, so fan them out
+  // across workers instead of serializing them here. Grouping rules:
+  // shadows, terrain queries and chunks all share the height/collision
+  // caches (whose lazy rebuilds aren't thread-safe) so those chain in
+  // one lane, with shadows leading since they need to get back to the
+  // client as soon as possible. Tendrils are pure math and the
+  // heaviest system during big effects, so they get their own lane.
+  // Fields and fuses are cheap; they run right here. Chunk contact
+  // joints go into ode_contact_group_, so empty it before dispatch.
+  if (!step_job_pool_) {
+    int worker_count = std::min(
+        2, std::max(0, static_cast<int>(std::thread::hardware_concurrency())
+                           - 2));
+    step_job_pool_ = std::make_unique<JobPool>(worker_count);
+  }
   dJointGroupEmpty(ode_contact_group_);
+  step_job_pool_->AddJob([this] {
+    UpdateShadows();
+    UpdateTerrainQueries();
+    UpdateChunks();
+  });
+  step_job_pool_->AddJob([this] { UpdateTendrils(); });
   UpdateFields();
-  UpdateChunks();
-  UpdateTendrils();
   UpdateFuses();
+  step_job_pool_->Wait();
 
   // Step the world.
   dWorldQuickStep(ode_world_, kGameStepSeconds);
@@ -2330,6 +2442,11 @@ void BGDynamicsServer::Step(StepData* step_data) {
   // there to fill itself in slowly.
   collision_cache_->Precalc();
 
+  if (ledger) {
+    FrameLedger::Add(FrameLedger::Lane::kBGDynamics,
+                     Platform::GetCurrentMicroseconds() - ledger_start);
+  }
+
   // Job's done!
   {
     std::lock_guard<std::mutex> lock(step_count_mutex_);
@@ -2612,9 +2729,22 @@ void BGDynamicsServer::UpdateChunks() {
 }
 
 void BGDynamicsServer::UpdateShadows() {
-  // First go through and calculate distances for all shadows.
-  for (auto&& s : shadows_) {
-    float shadow_dist = s->pos_worker.y - height_cache_->Sample(s->pos_worker);
+  // Resolve heights for all shadows in one batched pass; with a full
+  // roster plus debris this can be hundreds of queries per step and the
+  // height cache runs the interpolation SIMD-wide on contiguous input.
+  size_t shadow_count = shadows_.size();
+  shadow_pos_scratch_.resize(shadow_count);
+  shadow_height_scratch_.resize(shadow_count);
+  for (size_t i = 0; i < shadow_count; i++) {
+    shadow_pos_scratch_[i] = shadows_[i]->pos_worker;
+  }
+  height_cache_->SampleBatch(shadow_pos_scratch_.data(),
+                             shadow_height_scratch_.data(), shadow_count);
+
+  // Now go through and calculate distances for all shadows.
+  for (size_t i = 0; i < shadow_count; i++) {
+    BGDynamicsShadowData* s = shadows_[i];
+    float shadow_dist = s->pos_worker.y - shadow_height_scratch_[i];
 
     // Update scale/density based on these values.
     // Negative shadow_dist means some object is in front of our
@@ -2654,4 +2784,49 @@ void BGDynamicsServer::UpdateShadows() {
   }
 }
 
+// Flags a hit if the query geom actually intersects terrain.
+static void TerrainQueryCollideCallback(void* data, dGeomID o1, dGeomID o2) {
+  dContactGeom contact;
+  if (dCollide(o1, o2, 1, &contact, sizeof(dContactGeom))) {
+    *static_cast<bool*>(data) = true;
+  }
+}
+
+void BGDynamicsServer::UpdateTerrainQueries() {
+  // Answer each query against our height cache / collision cache;
+  // the stepping world in the game thread is never touched.
+  for (auto&& q : terrain_queries_) {
+    q->height_worker = height_cache_->Sample(q->pos_worker);
+    switch (q->type) {
+      case BGDynamicsTerrainQueryType::kRayDown:
+        break;
+      case BGDynamicsTerrainQueryType::kSphere: {
+        if (terrain_query_sphere_ == nullptr) {
+          terrain_query_sphere_ = dCreateSphere(nullptr, 1.0f);
+        }
+        dGeomSphereSetRadius(terrain_query_sphere_, q->radius_worker);
+        dGeomSetPosition(terrain_query_sphere_, q->pos_worker.x,
+                         q->pos_worker.y, q->pos_worker.z);
+        bool hit{};
+        collision_cache_->CollideAgainstGeom(terrain_query_sphere_, &hit,
+                                             TerrainQueryCollideCallback);
+        q->occupied_worker = hit;
+        break;
+      }
+    }
+  }
+
+  // Now plop the results back onto the client side all at once.
+  {
+    BA_DEBUG_TIME_CHECK_BEGIN(bg_dynamic_terrain_query_list_lock);
+    {
+      std::lock_guard<std::mutex> lock(terrain_query_list_mutex_);
+      for (auto&& q : terrain_queries_) {
+        q->UpdateClientData();
+      }
+    }
+    BA_DEBUG_TIME_CHECK_END(bg_dynamic_terrain_query_list_lock, 10);
+  }
+}
+
 }  // namespace ballistica
@@ -18,29 +18,34 @@ namespace ballistica {
 
 class BGDynamicsServer : public Module {
  public:
-  struct Particle {
-    float x;
-    float y;
-    float z;
+  // Structure-of-arrays particle storage; each attribute lives in its
+  // own contiguous array so the integration pass runs down plain float
+  // streams the compiler can vectorize.
+  struct ParticleArrays {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
     // Note that velocities here are in units-per-step (avoids a mult).
-    float vx;
-    float vy;
-    float vz;
-    float r;
-    float g;
-    float b;
-    float a;
-    float life;
-    float d_life;
-    float flicker;
-    float flicker_scale;
-    float size;
-    float d_size;
+    std::vector<float> vx;
+    std::vector<float> vy;
+    std::vector<float> vz;
+    std::vector<float> r;
+    std::vector<float> g;
+    std::vector<float> b;
+    std::vector<float> a;
+    std::vector<float> life;
+    std::vector<float> d_life;
+    std::vector<float> flicker;
+    std::vector<float> flicker_scale;
+    std::vector<float> size;
+    std::vector<float> d_size;
+    auto count() const -> size_t { return x.size(); }
+    void Resize(size_t count);
   };
 
   class ParticleSet {
    public:
-    std::vector<Particle> particles[2];
+    ParticleArrays particles[2];
     int current_set;
     ParticleSet() : current_set(0) {}
     void Emit(const Vector3f& pos, const Vector3f& vel, float r, float g,
@@ -64,6 +69,10 @@ class BGDynamicsServer : public Module {
     bool have_transform{};
     float length{};
   };
+  struct TerrainQueryStepData {
+    Vector3f position{};
+    float radius{};
+  };
   class StepData : public Object {
    public:
     auto GetDefaultOwnerThread() const -> ThreadIdentifier override {
@@ -78,6 +87,8 @@ class BGDynamicsServer : public Module {
     std::vector<std::pair<BGDynamicsVolumeLightData*, VolumeLightStepData> >
         volume_light_step_data_;
     std::vector<std::pair<BGDynamicsFuseData*, FuseStepData> > fuse_step_data_;
+    std::vector<std::pair<BGDynamicsTerrainQueryData*, TerrainQueryStepData> >
+        terrain_query_step_data_;
   };
 
   explicit BGDynamicsServer(Thread* thread);
@@ -91,6 +102,8 @@ class BGDynamicsServer : public Module {
   void PushRemoveFuseCall(BGDynamicsFuseData* fuse_data);
   void PushAddShadowCall(BGDynamicsShadowData* shadow_data);
   void PushRemoveShadowCall(BGDynamicsShadowData* shadow_data);
+  void PushAddTerrainQueryCall(BGDynamicsTerrainQueryData* query_data);
+  void PushRemoveTerrainQueryCall(BGDynamicsTerrainQueryData* query_data);
   void PushAddTerrainCall(Object::Ref<CollideModelData>* collide_model);
   void PushRemoveTerrainCall(CollideModelData* collide_model);
   void PushEmitCall(const BGDynamicsEmission& def);
@@ -120,6 +133,7 @@ class BGDynamicsServer : public Module {
   void UpdateTendrils();
   void UpdateFuses();
   void UpdateShadows();
+  void UpdateTerrainQueries();
   auto CreateDrawSnapshot() -> BGDynamicsDrawSnapshot*;
   BGDynamicsChunkType cb_type_ = BGDynamicsChunkType::kRock;
   dBodyID cb_body_{};
@@ -137,8 +151,15 @@ class BGDynamicsServer : public Module {
   Vector3f cam_pos_{0.0f, 0.0f, 0.0f};
   std::vector<Terrain*> terrains_;
   std::vector<BGDynamicsShadowData*> shadows_;
+
+  // Scratch buffers for batched shadow height lookups; kept around so
+  // per-step updates don't allocate.
+  std::vector<Vector3f> shadow_pos_scratch_;
+  std::vector<float> shadow_height_scratch_;
   std::vector<BGDynamicsVolumeLightData*> volume_lights_;
   std::vector<BGDynamicsFuseData*> fuses_;
+  std::vector<BGDynamicsTerrainQueryData*> terrain_queries_;
+  dGeomID terrain_query_sphere_{nullptr};
   dWorldID ode_world_{nullptr};
   dJointGroupID ode_contact_group_{nullptr};
 
@@ -147,6 +168,7 @@ class BGDynamicsServer : public Module {
   std::mutex shadow_list_mutex_;
   std::mutex volume_light_list_mutex_;
   std::mutex fuse_list_mutex_;
+  std::mutex terrain_query_list_mutex_;
   int step_count_{0};
   std::mutex step_count_mutex_;
   std::unique_ptr<ParticleSet> spark_particles_{nullptr};
@@ -158,6 +180,9 @@ class BGDynamicsServer : public Module {
   int chunk_count_{0};
   std::unique_ptr<BGDynamicsHeightCache> height_cache_;
   std::unique_ptr<CollisionCache> collision_cache_;
+
+  // Workers for fanning independent step phases out across cores.
+  std::unique_ptr<JobPool> step_job_pool_;
   uint32_t time_{0};  // Internal time step.
   float debris_friction_{1.0f};
   float debris_kill_height_{-50.0f};
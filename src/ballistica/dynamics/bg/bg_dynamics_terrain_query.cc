@@ -0,0 +1,52 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/dynamics/bg/bg_dynamics_terrain_query.h"
+
+#include "ballistica/dynamics/bg/bg_dynamics_server.h"
+#include "ballistica/dynamics/bg/bg_dynamics_terrain_query_data.h"
+
+namespace ballistica {
+
+BGDynamicsTerrainQuery::BGDynamicsTerrainQuery(
+    BGDynamicsTerrainQueryType type) {
+  assert(InGameThread());
+
+  // Allocate our query data; we'll pass this to the BGDynamics thread
+  // and it'll then own it.
+  data_ = new BGDynamicsTerrainQueryData(type);
+  assert(g_bg_dynamics_server);
+  g_bg_dynamics_server->PushAddTerrainQueryCall(data_);
+}
+
+BGDynamicsTerrainQuery::~BGDynamicsTerrainQuery() {
+  assert(InGameThread());
+  assert(g_bg_dynamics_server);
+
+  // Let the data know the client side is dead so we're no longer
+  // included in step messages (since by the time the worker gets this
+  // the data will be gone).
+  data_->client_dead = true;
+  g_bg_dynamics_server->PushRemoveTerrainQueryCall(data_);
+}
+
+void BGDynamicsTerrainQuery::SetPosition(const Vector3f& pos) {
+  assert(InGameThread());
+  data_->pos_client = pos;
+}
+
+void BGDynamicsTerrainQuery::SetRadius(float radius) {
+  assert(InGameThread());
+  data_->radius_client = radius;
+}
+
+auto BGDynamicsTerrainQuery::GetHeight() const -> float {
+  assert(InGameThread());
+  return data_->height_client;
+}
+
+auto BGDynamicsTerrainQuery::GetOccupied() const -> bool {
+  assert(InGameThread());
+  return data_->occupied_client;
+}
+
+}  // namespace ballistica
@@ -0,0 +1,40 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_DYNAMICS_BG_BG_DYNAMICS_TERRAIN_QUERY_H_
+#define BALLISTICA_DYNAMICS_BG_BG_DYNAMICS_TERRAIN_QUERY_H_
+
+#include "ballistica/ballistica.h"
+#include "ballistica/dynamics/bg/bg_dynamics.h"
+
+namespace ballistica {
+
+// A utility class for client use which answers terrain queries
+// (downward raycasts, sphere overlap tests) asynchronously on the
+// bg-dynamics thread against its own snapshot of the terrain, so
+// gameplay code never touches the stepping world. Set inputs whenever
+// they change; results reflect the most recent bg-dynamics step.
+// (queries update in the bg dynamics stepping process)
+class BGDynamicsTerrainQuery {
+ public:
+  explicit BGDynamicsTerrainQuery(
+      BGDynamicsTerrainQueryType type = BGDynamicsTerrainQueryType::kRayDown);
+  ~BGDynamicsTerrainQuery();
+  void SetPosition(const Vector3f& pos);
+
+  // For sphere queries: the test-sphere radius.
+  void SetRadius(float radius);
+
+  // Terrain height under the query position.
+  auto GetHeight() const -> float;
+
+  // For sphere queries: whether the sphere overlapped terrain.
+  auto GetOccupied() const -> bool;
+
+ private:
+  BGDynamicsTerrainQueryData* data_{};
+  BA_DISALLOW_CLASS_COPIES(BGDynamicsTerrainQuery);
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_DYNAMICS_BG_BG_DYNAMICS_TERRAIN_QUERY_H_
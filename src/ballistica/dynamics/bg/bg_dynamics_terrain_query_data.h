@@ -0,0 +1,43 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_DYNAMICS_BG_BG_DYNAMICS_TERRAIN_QUERY_DATA_H_
+#define BALLISTICA_DYNAMICS_BG_BG_DYNAMICS_TERRAIN_QUERY_DATA_H_
+
+#include "ballistica/dynamics/bg/bg_dynamics.h"
+
+namespace ballistica {
+
+struct BGDynamicsTerrainQueryData {
+  explicit BGDynamicsTerrainQueryData(BGDynamicsTerrainQueryType type)
+      : type(type) {}
+
+  void UpdateClientData() {
+    height_client = height_worker;
+    occupied_client = occupied_worker;
+  }
+
+  bool client_dead{};
+  BGDynamicsTerrainQueryType type;
+
+  // For use by worker:
+
+  // Query inputs owned by the client (write-only).
+  Vector3f pos_client{0.0f, 0.0f, 0.0f};
+  float radius_client{0.3f};
+
+  // Query inputs owned by the worker thread (read-only).
+  Vector3f pos_worker{0.0f, 0.0f, 0.0f};
+  float radius_worker{0.3f};
+
+  // Result values owned by the worker thread (write-only).
+  float height_worker{};
+  bool occupied_worker{};
+
+  // Result values owned by the client (read-only).
+  float height_client{};
+  bool occupied_client{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_DYNAMICS_BG_BG_DYNAMICS_TERRAIN_QUERY_DATA_H_
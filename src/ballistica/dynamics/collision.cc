@@ -0,0 +1,32 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/dynamics/collision.h"
+
+#include "ballistica/dynamics/material/material_action.h"
+#include "ballistica/media/component/sound.h"
+
+namespace ballistica {
+
+// Collisions come and go in bursts during pileups, so their blocks get
+// recycled through a simple free list instead of returned to the heap.
+// All access is from the game thread.
+static void* g_collision_free_list{};
+
+auto Collision::operator new(size_t size) -> void* {
+  assert(InGameThread());
+  assert(size == sizeof(Collision));
+  if (g_collision_free_list != nullptr) {
+    void* block = g_collision_free_list;
+    g_collision_free_list = *static_cast<void**>(block);
+    return block;
+  }
+  return ::operator new(size);
+}
+
+auto Collision::operator delete(void* ptr) -> void {
+  assert(InGameThread());
+  *static_cast<void**>(ptr) = g_collision_free_list;
+  g_collision_free_list = ptr;
+}
+
+}  // namespace ballistica
@@ -20,7 +20,17 @@ namespace ballistica {
 class Collision : public Object {
  public:
   explicit Collision(Scene* scene) : src_context(scene), dst_context(scene) {}
+
+  // Collision records churn heavily during pileups; their storage comes
+  // from a pooled free list so steady-state contact bursts do no
+  // allocator work for the records themselves.
+  auto operator new(size_t size) -> void*;
+  auto operator delete(void* ptr) -> void;
   int claim_count{};  // Used when checking for out-of-date-ness.
+  // Both parts are fully at rest (sleeping bodies or terrain); the
+  // collision gets carried from step to step without claim checks or
+  // narrowphase until something on either side wakes.
+  bool dormant{};
   bool collide{true};
   int contact_count{};  // Current number of contacts.
   float depth{};        // Current collision depth.
@@ -30,6 +40,13 @@ class Collision : public Object {
   float impact{};
   float skid{};
   float roll{};
+  // Mixed physical surface parameters for this part pair, computed once
+  // from the two material contexts at setup time. Material changes on
+  // either part reset the collision, so these stay valid for its life.
+  float surface_friction{};
+  float surface_bounce{};
+  float surface_cfm{};
+  float surface_erp{};
   Object::WeakRef<Part> src_part;  // Ref to make sure still alive.
   Object::WeakRef<Part> dst_part;  // Ref to make sure still alive.
   int body_id_1{-1};
@@ -3,8 +3,11 @@
 #include "ballistica/dynamics/collision_cache.h"
 
 #include <algorithm>
+#include <cstring>
+#include <string>
 
 #include "ballistica/graphics/component/simple_component.h"
+#include "ballistica/platform/platform.h"
 #include "ode/ode_collision_kernel.h"
 #include "ode/ode_collision_space_internal.h"
 #include "ode/ode_collision_util.h"
@@ -12,6 +15,12 @@
 
 namespace ballistica {
 
+const uint32_t kCellCacheVersion = 1;
+
+// How many full precalc sweeps a grid should soak up before we consider
+// it converged enough to be worth writing out.
+const int kCellCacheWriteSweeps = 4;
+
 CollisionCache::CollisionCache() { test_box_ = dCreateBox(nullptr, 1, 1, 1); }
 
 CollisionCache::~CollisionCache() {
@@ -26,6 +35,97 @@ void CollisionCache::SetGeoms(const std::vector<dGeomID>& geoms) {
   geoms_ = geoms;
 }
 
+auto CollisionCache::GetGeomsSignature() -> uint32_t {
+  // FNV-1a over the geom count and each geom's AABB. Good enough to
+  // distinguish terrains; a mismatched grid just means a fresh cache file.
+  uint32_t hash = 2166136261u;
+  auto mix = [&hash](const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 16777619u;
+    }
+  };
+  auto geom_count = static_cast<uint32_t>(geoms_.size());
+  mix(&geom_count, sizeof(geom_count));
+  for (auto&& g : geoms_) {
+    dReal aabb[6];
+    dGeomGetAABB(g, aabb);
+    float f[6];
+    for (int i = 0; i < 6; i++) {
+      f[i] = static_cast<float>(aabb[i]);
+    }
+    mix(f, sizeof(f));
+  }
+  return hash;
+}
+
+auto CollisionCache::GetCellCacheFilePath() -> std::string {
+  std::string cache_dir = g_platform->GetConfigDirectory() + "/collidecache";
+  static bool made_cache_dir = false;
+  if (!made_cache_dir) {
+    g_platform->MakeDir(cache_dir);
+    made_cache_dir = true;
+  }
+  char name[32];
+  snprintf(name, sizeof(name), "%08x.cache", GetGeomsSignature());
+  return cache_dir + "/" + name;
+}
+
+auto CollisionCache::LoadCellCache() -> bool {
+  FILE* f = g_platform->FOpen(GetCellCacheFilePath().c_str(), "rb");
+  if (f == nullptr) {
+    return false;
+  }
+  bool got_cache = false;
+  uint32_t version;
+  int32_t width, height;
+  if (fread(&version, sizeof(version), 1, f) == 1
+      && version == kCellCacheVersion
+      && fread(&width, sizeof(width), 1, f) == 1 && width == grid_width_
+      && fread(&height, sizeof(height), 1, f) == 1 && height == grid_height_) {
+    std::vector<Cell> cells(cells_.size());
+    if (fread(&cells[0], sizeof(Cell), cells.size(), f) == cells.size()) {
+      got_cache = true;
+      // Sanity-clamp everything back into our current bounds; worst case
+      // a corrupt file just gives us an unconverged-looking grid which
+      // regular testing will refine away.
+      for (auto&& cell : cells) {
+        cell.height_confirmed_collide_ =
+            std::min(y_max_, std::max(y_min_, cell.height_confirmed_collide_));
+        cell.height_confirmed_empty_ =
+            std::min(y_max_, std::max(cell.height_confirmed_collide_,
+                                      cell.height_confirmed_empty_));
+      }
+      cells_ = cells;
+    }
+  }
+  fclose(f);
+  return got_cache;
+}
+
+auto CollisionCache::WriteCellCache() -> void {
+  std::string path = GetCellCacheFilePath();
+  FILE* f = g_platform->FOpen(path.c_str(), "wb");
+  if (f == nullptr) {
+    return;
+  }
+  bool success = false;
+  auto width = static_cast<int32_t>(grid_width_);
+  auto height = static_cast<int32_t>(grid_height_);
+  if (fwrite(&kCellCacheVersion, sizeof(kCellCacheVersion), 1, f) == 1
+      && fwrite(&width, sizeof(width), 1, f) == 1
+      && fwrite(&height, sizeof(height), 1, f) == 1
+      && fwrite(&cells_[0], sizeof(Cell), cells_.size(), f) == cells_.size()) {
+    success = true;
+  }
+  fclose(f);
+
+  // Attempt to clean up if it looks like something went wrong.
+  if (!success) {
+    g_platform->Unlink(path.c_str());
+  }
+}
+
 void CollisionCache::Draw(FrameDef* frame_def) {
   if (cells_.empty()) {
     return;
@@ -133,6 +233,15 @@ void CollisionCache::Precalc() {
 
   if (precalc_index_ >= cells_.size()) {
     precalc_index_ = 0;  // Loop.
+
+    // Once the grid has soaked up a few full refinement sweeps, persist
+    // it so future runs on this terrain start converged.
+    precalc_sweeps_++;
+    if (precalc_sweeps_ == kCellCacheWriteSweeps && !cell_cache_written_
+        && !geoms_.empty()) {
+      WriteCellCache();
+      cell_cache_written_ = true;
+    }
   }
 
   auto x = static_cast<int>(precalc_index_ % grid_width_);
@@ -337,7 +446,15 @@ void CollisionCache::Update() {
   glow_.resize(cell_count);
   memset(&glow_[0], 0, cell_count);
   precalc_index_ = 0;
+  precalc_sweeps_ = 0;
+  cell_cache_written_ = false;
   dirty_ = false;
+
+  // If a previous run already converged a grid for this terrain, start
+  // from that instead of from scratch.
+  if (!geoms_.empty()) {
+    LoadCellCache();
+  }
 }
 
 }  // namespace ballistica
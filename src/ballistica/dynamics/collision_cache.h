@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_DYNAMICS_COLLISION_CACHE_H_
 #define BALLISTICA_DYNAMICS_COLLISION_CACHE_H_
 
+#include <string>
 #include <vector>
 
 #include "ballistica/ballistica.h"
@@ -32,7 +33,17 @@ class CollisionCache {
  private:
   auto TestCell(size_t cell_index, int x, int z) -> void;
   auto Update() -> void;
+
+  // Converged cell grids get persisted to disk keyed by a signature of
+  // the source geometry, so later runs on the same terrain start with a
+  // refined height map instead of re-bisecting from scratch.
+  auto GetGeomsSignature() -> uint32_t;
+  auto GetCellCacheFilePath() -> std::string;
+  auto LoadCellCache() -> bool;
+  auto WriteCellCache() -> void;
   uint32_t precalc_index_{};
+  int precalc_sweeps_{};
+  bool cell_cache_written_{};
   std::vector<dGeomID> geoms_;
   struct Cell {
     float height_confirmed_empty_;
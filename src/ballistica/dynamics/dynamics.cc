@@ -2,15 +2,20 @@
 
 #include "ballistica/dynamics/dynamics.h"
 
+#include <algorithm>
 #include <cmath>
+#include <thread>
 #include <utility>
 
 #include "ballistica/audio/audio.h"
 #include "ballistica/audio/audio_source.h"
+#include "ballistica/dynamics/aabb_tree_broadphase.h"
 #include "ballistica/dynamics/collision.h"
 #include "ballistica/dynamics/collision_cache.h"
 #include "ballistica/dynamics/material/material_action.h"
 #include "ballistica/dynamics/part.h"
+#include "ballistica/dynamics/rigid_body.h"
+#include "ballistica/generic/job_pool.h"
 #include "ballistica/graphics/renderer.h"
 #include "ballistica/media/component/sound.h"
 #include "ballistica/scene/scene.h"
@@ -19,12 +24,6 @@
 
 namespace ballistica {
 
-// Max contacts for rigid body collisions.
-// TODO(ericf): Probably a good idea to accept more than this
-//  and then randomly discard some - otherwise
-//  we may get contacts only at one end of an object, etc.
-#define MAX_CONTACTS 20
-
 // Given two parts, returns true if part1 is major in
 // the storage order.
 static auto IsInStoreOrder(int64_t node1, int part1, int64_t node2, int part2)
@@ -138,6 +137,7 @@ class Dynamics::Impl {
 Dynamics::Dynamics(Scene* scene_in)
     : scene_(scene_in),
       collision_cache_(new CollisionCache()),
+      broadphase_(new AABBTreeBroadphase()),
       impl_(std::make_unique<Impl>(this)) {
   ResetODE();
 }
@@ -206,6 +206,18 @@ void Dynamics::RemoveTrimesh(dGeomID g) {
   throw Exception("trimesh not found");
 }
 
+void Dynamics::AddRigidBody(RigidBody* b) { rigid_bodies_.push_back(b); }
+
+void Dynamics::RemoveRigidBody(RigidBody* b) {
+  for (auto i = rigid_bodies_.begin(); i != rigid_bodies_.end(); i++) {
+    if ((*i) == b) {
+      rigid_bodies_.erase(i);
+      return;
+    }
+  }
+  throw Exception("rigid body not found");
+}
+
 auto Dynamics::AreColliding(const Part& p1_in, const Part& p2_in) -> bool {
   const Part* p1;
   const Part* p2;
@@ -296,6 +308,29 @@ auto Dynamics::GetCollision(Part* p1_in, Part* p2_in, MaterialContext** cc1,
          && (!dncm->collideDisabled || !(*cc1)->use_node_collide
              || !(*cc2)->use_node_collide));
 
+    // Precompute the mixed surface parameters now rather than per-step;
+    // they only depend on the contexts, which are fixed for the life of
+    // the collision.
+    new_collision->surface_friction =
+        1.2f * sqrtf((*cc1)->friction * (*cc2)->friction);
+    new_collision->surface_bounce = sqrtf((*cc1)->bounce * (*cc2)->bounce);
+    float stiffness;
+    if ((*cc1)->stiffness < 0.00000001f || (*cc2)->stiffness < 0.00000001f) {
+      stiffness = 0.00000001f;
+    } else {
+      stiffness = 8000 * sqrtf((*cc1)->stiffness * (*cc2)->stiffness);
+    }
+    float damping = 80 * (*cc1)->damping + (*cc2)->damping;
+    if ((stiffness < 0.00000001f) && (damping < 0.00000001f)) {
+      damping = 0.00000001f;
+    }
+
+    // Cfm/erp (based off stiffness/damping).
+    new_collision->surface_erp = (kGameStepSeconds * stiffness)
+                                 / ((kGameStepSeconds * stiffness) + damping);
+    new_collision->surface_cfm =
+        1.0f / ((kGameStepSeconds * stiffness) + damping);
+
     // If theres a physical collision involved, inform the parts
     // so they can keep track of who they're touching.
     if (new_collision->collide) {
@@ -437,20 +472,42 @@ void Dynamics::ProcessCollisions() {
     for (auto& dst_node : node_collision.second.dst_nodes) {
       for (auto& src_part : dst_node.second.src_parts) {
         for (auto& dst_part_collision : src_part.second.dst_part_collisions) {
-          dst_part_collision.second->claim_count = 0;
+          Collision* c = dst_part_collision.second.get();
+          if (c->dormant) {
+            // Carry dormant collisions as claimed while both sides stay
+            // at rest; nothing can move so nothing can separate.
+            if (c->src_part.exists() && c->dst_part.exists()
+                && c->src_part->IsSleeping() && c->dst_part->IsSleeping()) {
+              c->claim_count = 1;
+              continue;
+            }
+            // Something woke; back to normal claim tracking.
+            c->dormant = false;
+          }
+          c->claim_count = 0;
         }
       }
     }
   }
 
-  // Process all standard collisions. This will trigger our callback which
-  // do the real work (add collisions to list, store commands to be
-  // called, etc).
-  dSpaceCollide(ode_space_, this, &DoCollideCallback);
+  // Gather all standard collision pairs. This triggers our callback which
+  // does the cheap filtering and queues surviving pairs for narrowphase.
+  // Pairing goes through our aabb tree instead of the ode space's own
+  // hashing; the space is just the geom roster at this point.
+  narrowphase_pairs_.clear();
+  broadphase_->CollidePairs(ode_space_, this, &DoCollideCallback);
 
   // Collide our trimeshes against everything.
   collision_cache_->CollideAgainstSpace(ode_space_, this, &DoCollideCallback);
 
+  // Run contact generation for the queued pairs across worker threads,
+  // then handle the results (material evaluation, contact-joint creation,
+  // etc) serially since that all touches shared state.
+  RunNarrowphase();
+  for (auto&& pair : narrowphase_pairs_) {
+    ProcessCollision(&pair);
+  }
+
   // Do a bit of precalc each cycle.
   collision_cache_->Precalc();
 
@@ -515,7 +572,33 @@ void Dynamics::ProcessCollisions() {
 void Dynamics::process() {
   in_process_ = true;
   real_time_ = GetRealTime();  // Update this once so we can recycle results.
+
+  // Refresh sleep flags before collision processing so it sees a
+  // consistent partition. Resting contact pairs between sleeping bodies
+  // get carried dormant, so a settled pile costs near-zero per step.
+  for (auto&& b : rigid_bodies_) {
+    if (b->type() != RigidBody::Type::kBody) {
+      continue;
+    }
+    bool asleep = !dBodyIsEnabled(b->body());
+    if (asleep && !b->sleeping()) {
+      // One last snapshot so draw interpolation settles on the rest pose.
+      b->CapturePrevTransform();
+    }
+    b->set_newly_slept(asleep && !b->sleeping());
+    b->set_sleeping(asleep);
+  }
+
   ProcessCollisions();
+
+  // Remember where everything is before we step; draws happening between
+  // this step and the next interpolate from these snapshots. Sleeping
+  // bodies won't move so they keep the snapshot from when they dozed off.
+  for (auto&& b : rigid_bodies_) {
+    if (!b->sleeping()) {
+      b->CapturePrevTransform();
+    }
+  }
   dWorldQuickStep(ode_world_, kGameStepSeconds);
   dJointGroupEmpty(ode_contact_group_);
   in_process_ = false;
@@ -538,10 +621,21 @@ void Dynamics::CollideCallback(dGeomID o1, dGeomID o2) {
   auto* r2 = static_cast<RigidBody*>(dGeomGetData(o2));
   assert(r1 && r2);
 
-  // If both of these guys are either terrain (a trimesh) or an inactive body,
-  // we can skip actually testing for a collision.
+  // If both of these guys are either terrain (a trimesh) or an inactive
+  // body, we can skip actually testing for a collision. This also covers
+  // pairs of sleeping bodies (resting stacks); contact joints between
+  // two disabled bodies never enter the solver anyway.
   if ((dGeomGetClass(o1) == dTriMeshClass && b2 && !dBodyIsEnabled(b2))
-      || (dGeomGetClass(o2) == dTriMeshClass && b1 && !dBodyIsEnabled(b1))) {
+      || (dGeomGetClass(o2) == dTriMeshClass && b1 && !dBodyIsEnabled(b1))
+      || (b1 && !dBodyIsEnabled(b1) && b2 && !dBodyIsEnabled(b2))) {
+    // If this pair went dormant on an earlier step (both parts fully at
+    // rest and neither body newly asleep), the reset pass is already
+    // keeping its collision claimed; skip even the map walk.
+    if (!r1->newly_slept() && !r2->newly_slept() && r1->part()->IsSleeping()
+        && r2->part()->IsSleeping()) {
+      return;
+    }
+
     // We do, however, need to poke any existing collision so a disconnect event
     // doesn't occur if we were colliding.
     Part* p1_in = r1->part();
@@ -570,6 +664,12 @@ void Dynamics::CollideCallback(dGeomID o1, dGeomID o2) {
 #pragma ide diagnostic ignored "UnusedValue"
             l->second->claim_count++;
 #pragma clang diagnostic pop
+
+            // Once both sides are fully at rest, flag the collision
+            // dormant; future steps then skip this walk entirely.
+            if (r1->part()->IsSleeping() && r2->part()->IsSleeping()) {
+              l->second->dormant = true;
+            }
           }
         }
       }
@@ -584,6 +684,71 @@ void Dynamics::CollideCallback(dGeomID o1, dGeomID o2) {
     return;
   }
 
+  // Passed the cheap filters; queue it for narrowphase.
+  narrowphase_pairs_.emplace_back();
+  narrowphase_pairs_.back().o1 = o1;
+  narrowphase_pairs_.back().o2 = o2;
+
+  // Regions never produce physical contacts; their collisions only feed
+  // enter/exit events, so one overlap contact is all they need. Game
+  // modes stack dozens of trigger regions over active play areas, which
+  // makes full contact generation against them pure waste.
+  if ((r1->collide_type() & RigidBody::kCollideRegion)
+      || (r2->collide_type() & RigidBody::kCollideRegion)) {
+    narrowphase_pairs_.back().max_contacts = 1;
+  }
+}
+
+auto Dynamics::RunNarrowphase() -> void {
+  // Spin up our workers the first time through. Leave cores for the
+  // main game/graphics/audio threads.
+  if (!collide_job_pool_) {
+    int worker_count = std::min(
+        3, std::max(0, static_cast<int>(std::thread::hardware_concurrency())
+                           - 2));
+    collide_job_pool_ = std::make_unique<JobPool>(worker_count);
+  }
+
+  // Convex-vs-convex tests are pure functions of the two geoms, so
+  // those fan out across workers in chunks. Trimesh tests go through
+  // stateful colliders and run here on the calling thread instead.
+  size_t count = narrowphase_pairs_.size();
+  const size_t chunk_size = 16;
+  for (size_t start = 0; start < count; start += chunk_size) {
+    size_t end = std::min(count, start + chunk_size);
+    collide_job_pool_->AddJob([this, start, end] {
+      for (size_t i = start; i < end; i++) {
+        NarrowphasePair& pair = narrowphase_pairs_[i];
+        if (dGeomGetClass(pair.o1) == dTriMeshClass
+            || dGeomGetClass(pair.o2) == dTriMeshClass) {
+          continue;
+        }
+        pair.contact_count =
+            dCollide(pair.o1, pair.o2, pair.max_contacts,
+                     &pair.contacts[0].geom, sizeof(dContact));
+      }
+    });
+  }
+  for (auto&& pair : narrowphase_pairs_) {
+    if (dGeomGetClass(pair.o1) == dTriMeshClass
+        || dGeomGetClass(pair.o2) == dTriMeshClass) {
+      pair.contact_count =
+          dCollide(pair.o1, pair.o2, pair.max_contacts,
+                   &pair.contacts[0].geom, sizeof(dContact));
+    }
+  }
+  collide_job_pool_->Wait();
+}
+
+auto Dynamics::ProcessCollision(NarrowphasePair* pair) -> void {
+  dGeomID o1 = pair->o1;
+  dGeomID o2 = pair->o2;
+  dBodyID b1 = dGeomGetBody(o1);
+  dBodyID b2 = dGeomGetBody(o2);
+  auto* r1 = static_cast<RigidBody*>(dGeomGetData(o1));
+  auto* r2 = static_cast<RigidBody*>(dGeomGetData(o2));
+  assert(r1 && r2);
+
   Part* p1 = r1->part();
   Part* p2 = r2->part();
   assert(p1 && p2);
@@ -599,9 +764,8 @@ void Dynamics::CollideCallback(dGeomID o1, dGeomID o2) {
   // I don't think calculating full material-states before each collision
   // detection test would be economical but if there's a simple way to know
   // they'll never collide.
-  dContact contact[MAX_CONTACTS];  // up to MAX_CONTACTS contacts per pair
-  if (int numc =
-          dCollide(o1, o2, MAX_CONTACTS, &contact[0].geom, sizeof(dContact))) {
+  dContact* contact = pair->contacts;
+  if (int numc = pair->contact_count) {
     MaterialContext* cc1;
     MaterialContext* cc2;
 
@@ -1034,23 +1198,11 @@ void Dynamics::CollideCallback(dGeomID o1, dGeomID o2) {
     // Set up collision constraints for this frame as long
     // as theres at least one body involved.
     if ((b1 || b2) && (cc1->physical && cc2->physical)) {
-      float friction = 1.2f * sqrtf(cc1->friction * cc2->friction);
-      float bounce = sqrtf(cc1->bounce * cc2->bounce);
-      float stiffness;
-      if (cc1->stiffness < 0.00000001f || cc2->stiffness < 0.00000001f) {
-        stiffness = 0.00000001f;
-      } else {
-        stiffness = 8000 * sqrtf(cc1->stiffness * cc2->stiffness);
-      }
-      float damping = 80 * cc1->damping + cc2->damping;
-      if ((stiffness < 0.00000001f) && (damping < 0.00000001f)) {
-        damping = 0.00000001f;
-      }
-
-      // Cfm/erp (based off stiffness/damping).
-      float erp = (kGameStepSeconds * stiffness)
-                  / ((kGameStepSeconds * stiffness) + damping);
-      float cfm = 1.0f / ((kGameStepSeconds * stiffness) + damping);
+      // Surface parameters were mixed once at collision setup.
+      float friction = c->surface_friction;
+      float bounce = c->surface_bounce;
+      float erp = c->surface_erp;
+      float cfm = c->surface_cfm;
 
       // Normally a geom against a body does not automatically wake the body.
       // However we explicitly do so in certain cases (if the geom is moving,
@@ -1130,7 +1282,9 @@ void Dynamics::ResetODE() {
   dWorldSetAutoDisableSteps(ode_world_, 10);
   dWorldSetAutoDisableTime(ode_world_, 0);
   dWorldSetQuickStepNumIterations(ode_world_, 10);
-  ode_space_ = dHashSpaceCreate(nullptr);
+  // A simple space suffices here; pair generation happens in our own
+  // aabb-tree broadphase, so the space only tracks membership.
+  ode_space_ = dSimpleSpaceCreate(nullptr);
   assert(ode_space_);
   ode_contact_group_ = dJointGroupCreate(0);
   assert(ode_contact_group_);
@@ -68,6 +68,11 @@ class Dynamics : public Object {
   auto AddTrimesh(dGeomID g) -> void;
   auto RemoveTrimesh(dGeomID g) -> void;
 
+  // Rigid bodies register themselves here so we can snapshot their
+  // transforms before stepping (used for draw-time interpolation).
+  auto AddRigidBody(RigidBody* b) -> void;
+  auto RemoveRigidBody(RigidBody* b) -> void;
+
   auto collision_count() const -> int { return collision_count_; }
   auto process_real_time() const -> millisecs_t { return real_time_; }
   auto last_impact_sound_time() const -> millisecs_t {
@@ -76,6 +81,25 @@ class Dynamics : public Object {
   auto in_process() const -> bool { return in_process_; }
 
  private:
+  // Max contacts for rigid body collisions.
+  // TODO(ericf): Probably a good idea to accept more than this
+  //  and then randomly discard some - otherwise
+  //  we may get contacts only at one end of an object, etc.
+  static constexpr int kMaxContacts = 20;
+
+  // A geom pair that survived broadphase and cheap filtering; contact
+  // generation fills in the contacts, which then get handled serially.
+  struct NarrowphasePair {
+    dGeomID o1{};
+    dGeomID o2{};
+    // How many contacts narrowphase may generate for this pair. Trigger
+    // regions only need to know *that* they overlap something, so their
+    // pairs get capped at a single contact instead of the full set.
+    int max_contacts{kMaxContacts};
+    int contact_count{};
+    dContact contacts[kMaxContacts];
+  };
+
   auto AreColliding(const Part& p1, const Part& p2) -> bool;
   class SrcNodeCollideMap;
   class DstNodeCollideMap;
@@ -97,6 +121,14 @@ class Dynamics : public Object {
   auto CollideCallback(dGeomID o1, dGeomID o2) -> void;
   auto ProcessCollisions() -> void;
 
+  // Run contact generation for the queued narrowphase pairs, fanning
+  // convex-vs-convex tests out across worker threads.
+  auto RunNarrowphase() -> void;
+
+  // Handle the results of one narrowphase pair: material evaluation,
+  // contact-joint creation, etc. Serial; touches shared state.
+  auto ProcessCollision(NarrowphasePair* pair) -> void;
+
   std::unique_ptr<Impl> impl_;
   bool processing_collisions_{};
   dWorldID ode_world_{};
@@ -105,6 +137,7 @@ class Dynamics : public Object {
   millisecs_t real_time_{};
   bool in_process_{};
   std::vector<dGeomID> trimeshes_;
+  std::vector<RigidBody*> rigid_bodies_;
   millisecs_t last_impact_sound_time_{};
   int skid_sound_count_{};
   int roll_sound_count_{};
@@ -116,6 +149,9 @@ class Dynamics : public Object {
   Object::WeakRef<Node> active_collide_src_node_;
   Object::WeakRef<Node> active_collide_dst_node_;
   std::unique_ptr<CollisionCache> collision_cache_;
+  std::unique_ptr<AABBTreeBroadphase> broadphase_;
+  std::vector<NarrowphasePair> narrowphase_pairs_;
+  std::unique_ptr<JobPool> collide_job_pool_;
   friend class Impl;
 };
 
@@ -56,8 +56,7 @@ void Material::Apply(MaterialContext* s, const Part* src_part,
                      const Part* dst_part) {
   // Apply all applicable components to the context.
   for (auto& component : components_) {
-    if (component->eval_conditions(component->conditions, *this, src_part,
-                                   dst_part, *s)) {
+    if (component->EvalConditions(*this, src_part, dst_part, *s)) {
       component->Apply(s, src_part, dst_part);
     }
   }
@@ -20,6 +20,126 @@
 
 namespace ballistica {
 
+// Evaluate a single leaf condition; shared by the compiled-program path
+// and the recursive fallback.
+static auto EvalLeafCondition(MaterialCondition cond, int val1,
+                              const Material* val1_material, const Material& c,
+                              const Part* part, const Part* opposing_part,
+                              const MaterialContext& s) -> bool {
+  switch (cond) {
+    case MaterialCondition::kTrue:
+      return true;
+    case MaterialCondition::kFalse:
+      return false;
+    case MaterialCondition::kDstIsMaterial:
+      return opposing_part->ContainsMaterial(val1_material);
+    case MaterialCondition::kDstNotMaterial:
+      return !opposing_part->ContainsMaterial(val1_material);
+    case MaterialCondition::kDstIsPart:
+      return opposing_part->id() == val1;
+    case MaterialCondition::kDstNotPart:
+      return opposing_part->id() != val1;
+    case MaterialCondition::kSrcDstSameMaterial:
+      return opposing_part->ContainsMaterial(&c);
+    case MaterialCondition::kSrcDstDiffMaterial:
+      return !opposing_part->ContainsMaterial(&c);
+    case MaterialCondition::kSrcDstSameNode:
+      return opposing_part->node() == part->node();
+    case MaterialCondition::kSrcDstDiffNode:
+      return opposing_part->node() != part->node();
+    case MaterialCondition::kSrcYoungerThan:
+      return part->GetAge() < val1;
+    case MaterialCondition::kSrcOlderThan:
+      return part->GetAge() >= val1;
+    case MaterialCondition::kDstYoungerThan:
+      return opposing_part->GetAge() < val1;
+    case MaterialCondition::kDstOlderThan:
+      return opposing_part->GetAge() >= val1;
+    case MaterialCondition::kCollidingDstNode:
+      return part->IsCollidingWith(opposing_part->node()->id());
+    case MaterialCondition::kNotCollidingDstNode:
+      return !part->IsCollidingWith(opposing_part->node()->id());
+    case MaterialCondition::kEvalColliding:
+      return s.collide && s.node_collide;
+    case MaterialCondition::kEvalNotColliding:
+      return !s.collide || !s.node_collide;
+    default:
+      throw Exception();
+  }
+}
+
+void MaterialComponent::CompileConditions(
+    const Object::Ref<MaterialConditionNode>& node) {
+  if (!node.exists()) {
+    return;
+  }
+
+  // Postfix order: children first, then the operator that combines them.
+  if (node->opmode != MaterialConditionNode::OpMode::LEAF_NODE) {
+    assert(node->left_child.exists());
+    assert(node->right_child.exists());
+    CompileConditions(node->left_child);
+    CompileConditions(node->right_child);
+  }
+  CompiledCondition op;
+  op.opmode = node->opmode;
+  op.cond = node->cond;
+  op.val1 = node->val1;
+  op.val1_material = node->val1_material.get();
+  compiled_conditions_.push_back(op);
+}
+
+auto MaterialComponent::EvalConditions(const Material& c, const Part* part,
+                                       const Part* opposing_part,
+                                       const MaterialContext& s) -> bool {
+  // No conditions means always-applies.
+  if (!conditions.exists()) {
+    return true;
+  }
+  if (!conditions_compiled_) {
+    CompileConditions(conditions);
+    conditions_compiled_ = true;
+  }
+
+  // Freakishly large trees (which could outgrow our eval stack) take the
+  // old recursive path. Note we lose AND/OR short-circuiting in the
+  // compiled path, but leaves are cheap compares and real trees are tiny,
+  // so the flat loop wins regardless.
+  if (compiled_conditions_.size() > kMaxCompiledConditions) {
+    return eval_conditions(conditions, c, part, opposing_part, s);
+  }
+
+  bool stack[64];
+  size_t sp = 0;
+  for (const auto& op : compiled_conditions_) {
+    bool val;
+    if (op.opmode == MaterialConditionNode::OpMode::LEAF_NODE) {
+      val = EvalLeafCondition(op.cond, op.val1, op.val1_material, c, part,
+                              opposing_part, s);
+    } else {
+      assert(sp >= 2);
+      bool right = stack[--sp];
+      bool left = stack[--sp];
+      switch (op.opmode) {
+        case MaterialConditionNode::OpMode::AND_OPERATOR:
+          val = left && right;
+          break;
+        case MaterialConditionNode::OpMode::OR_OPERATOR:
+          val = left || right;
+          break;
+        case MaterialConditionNode::OpMode::XOR_OPERATOR:
+          val = (left != right);
+          break;
+        default:
+          throw Exception();
+      }
+    }
+    stack[sp++] = val;
+  }
+  assert(sp == 1);
+  return stack[0];
+}
+
 auto MaterialComponent::eval_conditions(
     const Object::Ref<MaterialConditionNode>& condition, const Material& c,
     const Part* part, const Part* opposing_part, const MaterialContext& s)
@@ -31,48 +151,9 @@ auto MaterialComponent::eval_conditions(
 
   // If we're a leaf node, evaluate.
   if (condition->opmode == MaterialConditionNode::OpMode::LEAF_NODE) {
-    switch (condition->cond) {
-      case MaterialCondition::kTrue:
-        return true;
-      case MaterialCondition::kFalse:
-        return false;
-      case MaterialCondition::kDstIsMaterial:
-        return (
-            (opposing_part->ContainsMaterial(condition->val1_material.get())));
-      case MaterialCondition::kDstNotMaterial:
-        return (
-            !(opposing_part->ContainsMaterial(condition->val1_material.get())));
-      case MaterialCondition::kDstIsPart:
-        return ((opposing_part->id() == condition->val1));
-      case MaterialCondition::kDstNotPart:
-        return opposing_part->id() != condition->val1;
-      case MaterialCondition::kSrcDstSameMaterial:
-        return ((opposing_part->ContainsMaterial(&c)));
-      case MaterialCondition::kSrcDstDiffMaterial:
-        return (!(opposing_part->ContainsMaterial(&c)));
-      case MaterialCondition::kSrcDstSameNode:
-        return ((opposing_part->node() == part->node()));
-      case MaterialCondition::kSrcDstDiffNode:
-        return opposing_part->node() != part->node();
-      case MaterialCondition::kSrcYoungerThan:
-        return part->GetAge() < condition->val1;
-      case MaterialCondition::kSrcOlderThan:
-        return ((part->GetAge() >= condition->val1));
-      case MaterialCondition::kDstYoungerThan:
-        return opposing_part->GetAge() < condition->val1;
-      case MaterialCondition::kDstOlderThan:
-        return ((opposing_part->GetAge() >= condition->val1));
-      case MaterialCondition::kCollidingDstNode:
-        return (part->IsCollidingWith(opposing_part->node()->id()));
-      case MaterialCondition::kNotCollidingDstNode:
-        return (!(part->IsCollidingWith(opposing_part->node()->id())));
-      case MaterialCondition::kEvalColliding:
-        return s.collide && s.node_collide;
-      case MaterialCondition::kEvalNotColliding:
-        return (!s.collide || !s.node_collide);
-      default:
-        throw Exception();
-    }
+    return EvalLeafCondition(condition->cond, condition->val1,
+                             condition->val1_material.get(), c, part,
+                             opposing_part, s);
   } else {
     // A trunk node; eval our left and right children and return
     // the boolean operation between them.
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "ballistica/core/object.h"
+#include "ballistica/dynamics/material/material_condition_node.h"
 
 namespace ballistica {
 
@@ -31,12 +32,39 @@ class MaterialComponent : public Object {
                        const Part* opposing_part, const MaterialContext& s)
       -> bool;
 
+  // Evaluate our condition tree for a contact. This runs a flat postfix
+  // program compiled lazily from the tree (which is immutable once
+  // attached) rather than recursing through ref-counted tree nodes;
+  // contact-storm frames evaluate these thousands of times.
+  auto EvalConditions(const Material& c, const Part* part,
+                      const Part* opposing_part, const MaterialContext& s)
+      -> bool;
+
   // Apply the component to a context.
   void Apply(MaterialContext* c, const Part* src_part, const Part* dst_part);
   MaterialComponent() = default;
   MaterialComponent(const Object::Ref<MaterialConditionNode>& conditions_in,
                     std::vector<Object::Ref<MaterialAction> > actions_in)
       : conditions(conditions_in), actions(std::move(actions_in)) {}
+
+ private:
+  // One flattened condition-tree node. Raw material pointer is fine
+  // here; the tree we're compiled from holds the ref and outlives us.
+  struct CompiledCondition {
+    MaterialConditionNode::OpMode opmode{};
+    MaterialCondition cond{};
+    int val1{};
+    Material* val1_material{};
+  };
+
+  // Programs bigger than this (which would outgrow our eval stack) fall
+  // back to the recursive walk; in practice trees are a handful of nodes.
+  static const size_t kMaxCompiledConditions = 127;
+
+  void CompileConditions(const Object::Ref<MaterialConditionNode>& node);
+
+  std::vector<CompiledCondition> compiled_conditions_;
+  bool conditions_compiled_{};
 };
 
 }  // namespace ballistica
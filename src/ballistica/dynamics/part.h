@@ -41,6 +41,21 @@ class Part : public Object {
       i->Wake();
     }
   }
+
+  // Whether every body in the part is at rest (sleeping or static
+  // terrain). Parts with no bodies don't count; neither do movable
+  // geom-only bodies such as regions.
+  auto IsSleeping() const -> bool {
+    if (rigid_bodies_.empty()) {
+      return false;
+    }
+    for (auto&& i : rigid_bodies_) {
+      if (!i->IsAtRest()) {
+        return false;
+      }
+    }
+    return true;
+  }
   auto node() const -> Node* {
     assert(node_.exists());
     return node_.get();
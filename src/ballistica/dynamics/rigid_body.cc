@@ -3,6 +3,9 @@
 #include "ballistica/dynamics/rigid_body.h"
 
 #include <cmath>
+#include <cstring>
+#include <string>
+#include <unordered_map>
 
 #include "ballistica/dynamics/dynamics.h"
 #include "ballistica/dynamics/part.h"
@@ -33,6 +36,50 @@ namespace ballistica {
 
 #define ABSOLUTE_EPSILON 0.001f
 
+// Spawning a wave of identical props (bombs, crates, etc) runs the same
+// few mass/inertia setups over and over, so we keep a little table of
+// results keyed by shape/dimensions/density. Trimesh collide data is
+// already shared per-model by CollideModelData, so this covers the
+// remaining redundant piece of body setup.
+static auto GetCachedMass(RigidBody::Shape shape, float m1, float m2, float m3,
+                          float density) -> const dMass& {
+  assert(InGameThread());
+  static std::unordered_map<std::string, dMass> cache;
+  char key[20];
+  int shape_val = static_cast<int>(shape);
+  memcpy(key, &shape_val, 4);
+  memcpy(key + 4, &m1, 4);
+  memcpy(key + 8, &m2, 4);
+  memcpy(key + 12, &m3, 4);
+  memcpy(key + 16, &density, 4);
+  std::string key_str(key, sizeof(key));
+  auto i = cache.find(key_str);
+  if (i != cache.end()) {
+    return i->second;
+  }
+  dMass m;
+  switch (shape) {
+    case RigidBody::Shape::kSphere:
+      dMassSetSphere(&m, density, m1);
+      break;
+    case RigidBody::Shape::kBox:
+      dMassSetBox(&m, density, m1, m2, m3);
+      break;
+    case RigidBody::Shape::kCapsule:
+      dMassSetCappedCylinder(&m, density, 3, m1, m2);
+      break;
+    case RigidBody::Shape::kCylinder:
+      dMassSetCylinder(&m, density, 3, m1, m2);
+      break;
+    case RigidBody::Shape::kTrimesh:  // NOLINT(bugprone-branch-clone)
+      // Trimesh bodies not supported yet.
+      throw Exception();
+    default:
+      throw Exception();
+  }
+  return cache.emplace(key_str, m).first->second;
+}
+
 RigidBody::RigidBody(int id_in, Part* part_in, Type type_in, Shape shape_in,
                      uint32_t collide_type_in, uint32_t collide_mask_in,
                      CollideModel* collide_model_in, uint32_t flags)
@@ -45,8 +92,6 @@ RigidBody::RigidBody(int id_in, Part* part_in, Type type_in, Shape shape_in,
       collide_type_(collide_type_in),
       collide_mask_(collide_mask_in),
       flags_(flags) {
-  blend_time_ = creation_time_;
-
 #if BA_DEBUG_BUILD
   for (int i = 0; i < 3; i++) {
     prev_pos_[i] = prev_vel_[i] = prev_a_vel_[i] = 0.0f;
@@ -56,6 +101,7 @@ RigidBody::RigidBody(int id_in, Part* part_in, Type type_in, Shape shape_in,
   assert(part_.exists());
   birth_time_ = part_->node()->scene()->stepnum();
   dynamics_ = part_->node()->scene()->dynamics();
+  dynamics_->AddRigidBody(this);
 
   // Add ourself to the part.
   part_->AddBody(this);
@@ -183,6 +229,7 @@ auto RigidBody::Check() -> void {
 }
 
 RigidBody::~RigidBody() {
+  dynamics_->RemoveRigidBody(this);
   if (shape_ == Shape::kTrimesh) {
     assert(geoms_.size() == 1);
     dynamics_->RemoveTrimesh(geoms_[0]);
@@ -409,26 +456,7 @@ auto RigidBody::SetDimensions(float d1, float d2, float d3, float m1, float m2,
 
   // Create the body and set mass properties.
   if (type_ == Type::kBody) {
-    dMass m;
-    switch (shape_) {
-      case Shape::kSphere:
-        dMassSetSphere(&m, density, m1);
-        break;
-      case Shape::kBox:
-        dMassSetBox(&m, density, m1, m2, m3);
-        break;
-      case Shape::kCapsule:
-        dMassSetCappedCylinder(&m, density, 3, m1, m2);
-        break;
-      case Shape::kCylinder:
-        dMassSetCylinder(&m, density, 3, m1, m2);
-        break;
-      case Shape::kTrimesh:  // NOLINT(bugprone-branch-clone)
-        // Trimesh bodies not supported yet.
-        throw Exception();
-      default:
-        throw Exception();
-    }
+    const dMass& m = GetCachedMass(shape_, m1, m2, m3, density);
 
     // Need to handle groups here.
     assert(geoms_.size() == 1 || shape_ == Shape::kCylinder);
@@ -632,7 +660,7 @@ auto RigidBody::Joint::Kill() -> void {
   }
 }
 
-auto RigidBody::GetTransform() -> Matrix44f {
+auto RigidBody::GetTransform() const -> Matrix44f {
   Matrix44f matrix{kMatrix44fIdentity};
   const dReal* pos_in;
   const dReal* r_in;
@@ -673,23 +701,125 @@ auto RigidBody::GetTransform() -> Matrix44f {
   return matrix;
 }
 
-auto RigidBody::AddBlendOffset(float x, float y, float z) -> void {
-  //  blend_offset_.x += x;
-  //  blend_offset_.y += y;
-  //  blend_offset_.z += z;
+auto RigidBody::CapturePrevTransform() -> void {
+  // Geom-only bodies never move via the stepper; no need to snapshot.
+  if (type_ != Type::kBody) {
+    return;
+  }
+  const dReal* p = dBodyGetPosition(body_);
+  const dReal* q = dBodyGetQuaternion(body_);
+  for (int i = 0; i < 3; i++) {
+    interp_pos_prev_[i] = p[i];
+  }
+  for (int i = 0; i < 4; i++) {
+    interp_quat_prev_[i] = q[i];
+  }
+  have_interp_prev_ = true;
+
+  // Also log the position into our rewind history; this runs exactly
+  // once per dynamics step so ring slots map 1:1 to steps.
+  for (int i = 0; i < 3; i++) {
+    history_pos_[history_next_][i] = static_cast<float>(p[i]);
+  }
+  history_next_ = (history_next_ + 1) % kRigidBodyHistorySteps;
+  if (history_size_ < kRigidBodyHistorySteps) {
+    history_size_++;
+  }
 }
 
-auto RigidBody::UpdateBlending() -> void {
-  // FIXME - this seems broken. We never update blend_time_ currently
-  //  and its also set to time whereas we're comparing it with steps.
-  //  Should revisit.
-  //  millisecs_t diff = part()->node()->scene()->stepnum() - blend_time_;
-  //  diff = std::min(millisecs_t{10}, diff);
-  //  for (millisecs_t i = 0; i < diff; i++) {
-  //    blend_offset_.x *= 0.995f;
-  //    blend_offset_.y *= 0.995f;
-  //    blend_offset_.z *= 0.995f;
-  //  }
+auto RigidBody::GetRewoundPosition(int steps_back) const -> Vector3f {
+  if (steps_back > history_size_) {
+    steps_back = history_size_;
+  }
+  if (type_ != Type::kBody || steps_back <= 0) {
+    const dReal* p = body_ != nullptr ? dBodyGetPosition(body_)
+                                      : dGeomGetPosition(geoms_[0]);
+    return {static_cast<float>(p[0]), static_cast<float>(p[1]),
+            static_cast<float>(p[2])};
+  }
+  int slot = (history_next_ - steps_back + kRigidBodyHistorySteps)
+             % kRigidBodyHistorySteps;
+  return {history_pos_[slot][0], history_pos_[slot][1], history_pos_[slot][2]};
+}
+
+auto RigidBody::GetInterpolatedTransform(float amt) const -> Matrix44f {
+  if (type_ != Type::kBody || !have_interp_prev_ || amt >= 1.0f) {
+    return GetTransform();
+  }
+  const dReal* pos_now = dBodyGetPosition(body_);
+  const dReal* q_now = dBodyGetQuaternion(body_);
+
+  // Bodies commonly get drawn several times per frame (model, shadows,
+  // attachments, eye/hair extras all transform to the same body); reuse
+  // the last snapshot when nothing has moved and the frame fraction is
+  // unchanged.
+  if (amt == interp_cache_amt_
+      && memcmp(pos_now, interp_cache_pos_, sizeof(interp_cache_pos_)) == 0
+      && memcmp(q_now, interp_cache_quat_, sizeof(interp_cache_quat_)) == 0) {
+    return interp_cache_transform_;
+  }
+
+  float pos[3];
+  for (int i = 0; i < 3; i++) {
+    pos[i] = interp_pos_prev_[i] + amt * (pos_now[i] - interp_pos_prev_[i]);
+  }
+  pos[0] += blend_offset().x;
+  pos[1] += blend_offset().y;
+  pos[2] += blend_offset().z;
+
+  // Nlerp the orientation; flip one side if needed so we blend along
+  // the shorter arc. Over a single 8ms step this is indistinguishable
+  // from a proper slerp.
+  float dot = 0.0f;
+  for (int i = 0; i < 4; i++) {
+    dot += interp_quat_prev_[i] * q_now[i];
+  }
+  float sign = (dot < 0.0f) ? -1.0f : 1.0f;
+  float q[4];
+  float len_sq = 0.0f;
+  for (int i = 0; i < 4; i++) {
+    q[i] = interp_quat_prev_[i]
+           + amt * (sign * static_cast<float>(q_now[i]) - interp_quat_prev_[i]);
+    len_sq += q[i] * q[i];
+  }
+  if (len_sq > 0.0f) {
+    float inv_len = 1.0f / sqrtf(len_sq);
+    for (float& val : q) {
+      val *= inv_len;
+    }
+  } else {
+    q[0] = 1.0f;
+    q[1] = q[2] = q[3] = 0.0f;
+  }
+
+  // ODE quaternions are ordered (w, x, y, z).
+  float w = q[0];
+  float x = q[1];
+  float y = q[2];
+  float z = q[3];
+  Matrix44f matrix{kMatrix44fIdentity};
+  matrix.m[0] = 1.0f - 2.0f * (y * y + z * z);
+  matrix.m[1] = 2.0f * (x * y + w * z);
+  matrix.m[2] = 2.0f * (x * z - w * y);
+  matrix.m[3] = 0;
+  matrix.m[4] = 2.0f * (x * y - w * z);
+  matrix.m[5] = 1.0f - 2.0f * (x * x + z * z);
+  matrix.m[6] = 2.0f * (y * z + w * x);
+  matrix.m[7] = 0;
+  matrix.m[8] = 2.0f * (x * z + w * y);
+  matrix.m[9] = 2.0f * (y * z - w * x);
+  matrix.m[10] = 1.0f - 2.0f * (x * x + y * y);
+  matrix.m[11] = 0;
+  matrix.m[12] = pos[0];
+  matrix.m[13] = pos[1];
+  matrix.m[14] = pos[2];
+  matrix.m[15] = 1;
+
+  interp_cache_amt_ = amt;
+  memcpy(interp_cache_pos_, pos_now, sizeof(interp_cache_pos_));
+  memcpy(interp_cache_quat_, q_now, sizeof(interp_cache_quat_));
+  interp_cache_transform_ = matrix;
+  return matrix;
 }
 
 }  // namespace ballistica
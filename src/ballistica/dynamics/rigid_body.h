@@ -13,6 +13,11 @@
 
 namespace ballistica {
 
+// How many recent per-step positions each dynamic body keeps for rewind
+// queries (64 steps is 512ms at our 8ms step rate; comfortably past the
+// pings we care to compensate for).
+const int kRigidBodyHistorySteps = 64;
+
 // Wrapper for ode rigid bodies which implements collision tracking,
 // flattening/restoring, and other extras.
 class RigidBody : public Object {
@@ -163,6 +168,22 @@ class RigidBody : public Object {
     }
   }
   auto Check() -> void;
+
+  // Sleep state as of the start of the current dynamics step; maintained
+  // by Dynamics so collision processing sees a consistent value even if
+  // the underlying ode body gets enabled mid-step.
+  auto sleeping() const -> bool { return sleeping_; }
+  auto set_sleeping(bool val) -> void { sleeping_ = val; }
+
+  // Whether the body fell asleep on this step specifically.
+  auto newly_slept() const -> bool { return newly_slept_; }
+  auto set_newly_slept(bool val) -> void { newly_slept_ = val; }
+
+  // Whether this body can't currently move on its own: a dynamic body
+  // the stepper has put to sleep, or static terrain.
+  auto IsAtRest() const -> bool {
+    return (type_ == Type::kBody) ? sleeping_ : (shape_ == Shape::kTrimesh);
+  }
   auto type() const -> Type { return type_; }
   auto collide_type() const -> uint32_t { return collide_type_; }
   auto collide_mask() const -> uint32_t { return collide_mask_; }
@@ -177,14 +198,47 @@ class RigidBody : public Object {
 
   // Applies to spheres.
   auto radius() const -> float { return dimensions_[0]; }
-  auto GetTransform() -> Matrix44f;
-  auto UpdateBlending() -> void;
-  auto AddBlendOffset(float x, float y, float z) -> void;
+  auto GetTransform() const -> Matrix44f;
+
+  // Snapshot the body's current position/orientation just before a
+  // dynamics step so draws can interpolate between the last two steps.
+  auto CapturePrevTransform() -> void;
+
+  // Returns the body transform interpolated between the previous step's
+  // snapshot and the current state. amt is 0 at the previous step and 1
+  // at the current one; falls back to GetTransform() for geom-only
+  // bodies or when no snapshot exists yet.
+  auto GetInterpolatedTransform(float amt) const -> Matrix44f;
   auto blend_offset() const -> const Vector3f& { return blend_offset_; }
 
+  // Returns the body's position as of steps_back dynamics steps ago,
+  // for lag-compensated hit/grab tests against a client's view time.
+  // steps_back gets clamped to the recorded history; 0, geom-only
+  // bodies and bodies with no history yet all yield the current
+  // position.
+  auto GetRewoundPosition(int steps_back) const -> Vector3f;
+
  private:
   Vector3f blend_offset_{0.0f, 0.0f, 0.0f};
-  millisecs_t blend_time_{};
+  float interp_pos_prev_[3]{};
+  float interp_quat_prev_[4]{};
+  bool have_interp_prev_{};
+
+  // Ring buffer of recent per-step positions (newest just before
+  // history_next_); bounded so long matches can't grow it.
+  float history_pos_[kRigidBodyHistorySteps][3]{};
+  int history_size_{};
+  int history_next_{};
+
+  // Last interpolated-transform result; valid while the body state and
+  // frame fraction it was computed from are unchanged (GetInterpolated-
+  // Transform is const, hence mutable).
+  mutable Matrix44f interp_cache_transform_{kMatrix44fIdentity};
+  mutable dReal interp_cache_pos_[3]{};
+  mutable dReal interp_cache_quat_[4]{};
+  mutable float interp_cache_amt_{-1.0f};
+  bool sleeping_{};
+  bool newly_slept_{};
 #if BA_DEBUG_BUILD
   float prev_pos_[3]{};
   float prev_vel_[3]{};
@@ -0,0 +1,86 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/attr_delta_codec.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace ballistica {
+
+void AttrDeltaCodec::Encode(const float* vals, size_t count, float* baseline,
+                            std::vector<uint8_t>* out) {
+  assert(vals && baseline && out);
+
+  // Reserve the mode-header bytes up front; we fill them as we go.
+  size_t header_start = out->size();
+  out->resize(out->size() + (count + 3) / 4, 0);
+
+  for (size_t i = 0; i < count; i++) {
+    Mode mode;
+    float diff = vals[i] - baseline[i];
+    auto quantized = static_cast<int64_t>(std::lround(
+        static_cast<double>(diff) * static_cast<double>(kQuantScale)));
+    if (quantized == 0) {
+      mode = Mode::kUnchanged;
+    } else if (quantized >= INT16_MIN && quantized <= INT16_MAX) {
+      mode = Mode::kDelta16;
+      auto q16 = static_cast<int16_t>(quantized);
+      out->push_back(static_cast<uint8_t>(q16 & 0xFF));
+      out->push_back(static_cast<uint8_t>((q16 >> 8) & 0xFF));
+
+      // Track exactly what the decoder will reconstruct.
+      baseline[i] += static_cast<float>(q16) / kQuantScale;
+    } else {
+      mode = Mode::kFull;
+      uint8_t raw[sizeof(float)];
+      memcpy(raw, &vals[i], sizeof(float));
+      out->insert(out->end(), raw, raw + sizeof(float));
+      baseline[i] = vals[i];
+    }
+    (*out)[header_start + i / 4] |= static_cast<uint8_t>(
+        static_cast<uint8_t>(mode) << ((i % 4) * 2));
+  }
+}
+
+void AttrDeltaCodec::Decode(const uint8_t** buffer, const uint8_t* buffer_end,
+                            size_t count, float* baseline) {
+  assert(buffer && *buffer && baseline);
+  const uint8_t* ptr = *buffer;
+  size_t header_size = (count + 3) / 4;
+  if (buffer_end - ptr < static_cast<ptrdiff_t>(header_size)) {
+    throw Exception("invalid attr-delta data (truncated header)");
+  }
+  const uint8_t* header = ptr;
+  ptr += header_size;
+
+  for (size_t i = 0; i < count; i++) {
+    auto mode = static_cast<Mode>((header[i / 4] >> ((i % 4) * 2)) & 0x03);
+    switch (mode) {
+      case Mode::kUnchanged:
+        break;
+      case Mode::kDelta16: {
+        if (buffer_end - ptr < 2) {
+          throw Exception("invalid attr-delta data (truncated delta)");
+        }
+        auto q16 = static_cast<int16_t>(static_cast<uint16_t>(ptr[0])
+                                        | (static_cast<uint16_t>(ptr[1]) << 8));
+        ptr += 2;
+        baseline[i] += static_cast<float>(q16) / kQuantScale;
+        break;
+      }
+      case Mode::kFull: {
+        if (buffer_end - ptr < static_cast<ptrdiff_t>(sizeof(float))) {
+          throw Exception("invalid attr-delta data (truncated float)");
+        }
+        memcpy(&baseline[i], ptr, sizeof(float));
+        ptr += sizeof(float);
+        break;
+      }
+      default:
+        throw Exception("invalid attr-delta data (bad mode)");
+    }
+  }
+  *buffer = ptr;
+}
+
+}  // namespace ballistica
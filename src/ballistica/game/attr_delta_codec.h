@@ -0,0 +1,56 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_ATTR_DELTA_CODEC_H_
+#define BALLISTICA_GAME_ATTR_DELTA_CODEC_H_
+
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// Delta/quantization codec for float attribute sets (positions,
+// velocities, etc). Each connection-to-client keeps a baseline copy of
+// the float sets it has shipped; instead of 4 bytes per component every
+// time an attr changes, we send a small per-component mode plus either
+// nothing (unchanged), a 16 bit quantized delta against the baseline
+// (the common case for positions/velocities moving smoothly), or a full
+// float for big jumps. Both sides apply the same reconstruction to their
+// baselines so quantization error can never accumulate into drift.
+class AttrDeltaCodec {
+ public:
+  // How finely deltas get quantized; 1/1024 of a game unit is well under
+  // anything visible and keeps +-32 units in 16 bits.
+  static const int kQuantScale = 1024;
+
+  // Per-component encoding modes (2 bits each, packed 4 per header byte).
+  enum class Mode : uint8_t {
+    kUnchanged = 0,
+    kDelta16 = 1,
+    kFull = 2,
+  };
+
+  // Append a delta encoding of 'vals' against 'baseline' onto 'out'.
+  // 'baseline' is updated in place to the values the decoder will
+  // reconstruct (*not* necessarily exactly 'vals'; see above). The
+  // baseline must be the same size as vals; use ResetBaseline() when a
+  // set is seen for the first time or its size changes.
+  static void Encode(const float* vals, size_t count, float* baseline,
+                     std::vector<uint8_t>* out);
+
+  // Apply a delta produced by Encode() onto 'baseline', advancing
+  // *buffer past the consumed bytes. Throws Exception on malformed or
+  // truncated data (this comes off the network).
+  static void Decode(const uint8_t** buffer, const uint8_t* buffer_end,
+                     size_t count, float* baseline);
+
+  // Worst-case encoded size for a value set (all components full
+  // floats); handy for reserving buffer space.
+  static auto MaxEncodedSize(size_t count) -> size_t {
+    return (count + 3) / 4 + count * sizeof(float);
+  }
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_ATTR_DELTA_CODEC_H_
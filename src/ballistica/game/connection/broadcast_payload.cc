@@ -0,0 +1,34 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/connection/broadcast_payload.h"
+
+#include <utility>
+
+#include "ballistica/generic/huffman.h"
+
+namespace ballistica {
+
+BroadcastPayload::BroadcastPayload(std::vector<uint8_t> message)
+    : message_(std::move(message)) {
+  assert(InGameThread());
+  compressed_.resize(Huffman::kDictMax + 1);
+}
+
+auto BroadcastPayload::GetCompressed(int dict_id)
+    -> const std::vector<uint8_t>& {
+  assert(InGameThread());
+
+  // Unknown ids fall back to the legacy dict just as the codec does;
+  // that way we share a cache slot with whatever it would hand us.
+  if (dict_id < 0 || dict_id > Huffman::kDictMax) {
+    dict_id = Huffman::kDictLegacy;
+  }
+  std::vector<uint8_t>& cached = compressed_[dict_id];
+  if (cached.empty()) {
+    cached = Huffman::SharedForDict(dict_id)->compress(message_);
+    compress_count_++;
+  }
+  return cached;
+}
+
+}  // namespace ballistica
@@ -0,0 +1,53 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_CONNECTION_BROADCAST_PAYLOAD_H_
+#define BALLISTICA_GAME_CONNECTION_BROADCAST_PAYLOAD_H_
+
+#include <vector>
+
+#include "ballistica/core/object.h"
+
+namespace ballistica {
+
+// A message payload shared across a broadcast to multiple client
+// connections. Previously each connection huffman-compressed the same
+// per-tick state message independently, so a 12-client party paid for 12
+// identical compressions of our largest messages. The ship path now wraps
+// the message in one of these and each connection pulls GetCompressed()
+// for its negotiated dictionary and frames its per-connection header
+// around the shared immutable buffer; compression happens once per dict
+// version actually in use (nearly always just one). Connections hold a
+// ref while their sends/resends are pending so the buffers stay alive
+// until the last one completes.
+class BroadcastPayload : public Object {
+ public:
+  explicit BroadcastPayload(std::vector<uint8_t> message);
+
+  auto GetDefaultOwnerThread() const -> ThreadIdentifier override {
+    return ThreadIdentifier::kGame;
+  }
+
+  // The compressed form of the message for a given huffman dict version
+  // (see Huffman::SharedForDict()); built lazily on first request and
+  // cached. Out-of-range ids get the legacy dict, matching the codec.
+  // The returned buffer is immutable; callers append their headers
+  // around it, never into it.
+  auto GetCompressed(int dict_id) -> const std::vector<uint8_t>&;
+
+  auto message() const -> const std::vector<uint8_t>& { return message_; }
+
+  // How many actual compressions have run; should stay at one per dict
+  // version in use regardless of client count.
+  auto compress_count() const -> int { return compress_count_; }
+
+ private:
+  std::vector<uint8_t> message_;
+  // Indexed by dict id; empty until requested (a compressed payload is
+  // never empty since the codec always emits at least a length header).
+  std::vector<std::vector<uint8_t> > compressed_;
+  int compress_count_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_CONNECTION_BROADCAST_PAYLOAD_H_
@@ -0,0 +1,86 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/connection/client_interest_set.h"
+
+namespace ballistica {
+
+void ClientInterestSet::UpdateNodePosition(int node_id,
+                                           const Vector3f& position) {
+  NodeState& state = nodes_[node_id];
+
+  // With no interest points (client has no players in yet) everything
+  // stays relevant.
+  if (interest_points_.empty()) {
+    state.tier = SendTier::kFull;
+    return;
+  }
+
+  float closest_squared = -1.0f;
+  for (auto&& point : interest_points_) {
+    float dist_squared = (position - point).LengthSquared();
+    if (closest_squared < 0.0f || dist_squared < closest_squared) {
+      closest_squared = dist_squared;
+    }
+  }
+
+  // Apply hysteresis: moving to a *more* detailed tier requires being
+  // kHysteresis inside the boundary.
+  float full_radius = kFullRadius;
+  float muted_radius = kMutedRadius;
+  switch (state.tier) {
+    case SendTier::kFull:
+      break;
+    case SendTier::kReduced:
+      full_radius -= kHysteresis;
+      break;
+    case SendTier::kMuted:
+      full_radius -= kHysteresis;
+      muted_radius -= kHysteresis;
+      break;
+  }
+
+  SendTier new_tier;
+  if (closest_squared <= full_radius * full_radius) {
+    new_tier = SendTier::kFull;
+  } else if (closest_squared <= muted_radius * muted_radius) {
+    new_tier = SendTier::kReduced;
+  } else {
+    new_tier = SendTier::kMuted;
+  }
+  if (state.tier == SendTier::kMuted && new_tier != SendTier::kMuted) {
+    state.needs_snap = true;
+  }
+  state.tier = new_tier;
+}
+
+auto ClientInterestSet::ShouldSend(int node_id) -> bool {
+  auto it = nodes_.find(node_id);
+  if (it == nodes_.end()) {
+    // Unknown/position-less nodes are always relevant.
+    return true;
+  }
+  NodeState& state = it->second;
+  if (state.needs_snap) {
+    // First update after coming back in range; ship it regardless of
+    // tier so the client snaps to current state.
+    state.needs_snap = false;
+    state.skip_count = 0;
+    return true;
+  }
+  switch (state.tier) {
+    case SendTier::kFull:
+      return true;
+    case SendTier::kReduced:
+      state.skip_count++;
+      if (state.skip_count >= kReducedRateDivisor) {
+        state.skip_count = 0;
+        return true;
+      }
+      return false;
+    case SendTier::kMuted:
+      return false;
+  }
+  return true;
+}
+
+}  // namespace ballistica
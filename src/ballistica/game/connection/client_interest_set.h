@@ -0,0 +1,78 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_CONNECTION_CLIENT_INTEREST_SET_H_
+#define BALLISTICA_GAME_CONNECTION_CLIENT_INTEREST_SET_H_
+
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/math/vector3f.h"
+
+namespace ballistica {
+
+// Server-side interest management for one connection-to-client.
+// Tracks where the client's players (and any camera areas-of-interest
+// they drive) are, and buckets scene nodes into send tiers by distance:
+// nearby nodes get every attr update, mid-range ones get updates at a
+// reduced rate, and far-off ones are muted entirely until they come
+// back in range (at which point the next update is always shipped so
+// the client snaps to current state). The game-stream ship path asks
+// ShouldSend() per node per flush; everything here stays O(1) per query
+// with the distance work done once per interest-point update.
+class ClientInterestSet {
+ public:
+  enum class SendTier : uint8_t {
+    kFull,     // Every update.
+    kReduced,  // Every kReducedRateDivisor-th update.
+    kMuted,    // Nothing until back in range.
+  };
+
+  // Distance thresholds (game units) with a bit of hysteresis so nodes
+  // sitting right on a boundary don't flap between tiers.
+  static constexpr float kFullRadius = 20.0f;
+  static constexpr float kMutedRadius = 45.0f;
+  static constexpr float kHysteresis = 2.0f;
+  static const int kReducedRateDivisor = 4;
+
+  // Replace the set of points the client cares about (player positions
+  // plus any in-focus camera areas-of-interest). Called once per
+  // game-stream flush, before the ShouldSend() queries.
+  void SetInterestPoints(const std::vector<Vector3f>& points) {
+    interest_points_ = points;
+  }
+
+  // Inform us of a node's current position; nodes never reported are
+  // treated as always-relevant (scoreboards, lights, etc. have no
+  // meaningful location).
+  void UpdateNodePosition(int node_id, const Vector3f& position);
+
+  // Node went away; drop its state.
+  void RemoveNode(int node_id) { nodes_.erase(node_id); }
+
+  // Whether this node's attr updates should ship to this client right
+  // now. Advances the node's reduced-rate counter, so call exactly once
+  // per node per flush.
+  auto ShouldSend(int node_id) -> bool;
+
+  // Dump everything (session reset).
+  void Clear() {
+    nodes_.clear();
+    interest_points_.clear();
+  }
+
+ private:
+  struct NodeState {
+    SendTier tier{SendTier::kFull};
+    // Counts flushes since we last shipped (reduced tier).
+    int skip_count{};
+    // Set while muted so the first update after un-muting always ships.
+    bool needs_snap{};
+  };
+
+  std::vector<Vector3f> interest_points_;
+  std::unordered_map<int, NodeState> nodes_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_CONNECTION_CLIENT_INTEREST_SET_H_
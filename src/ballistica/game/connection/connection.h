@@ -8,6 +8,8 @@
 #include <vector>
 
 #include "ballistica/core/object.h"
+#include "ballistica/game/connection/connection_pacing.h"
+#include "ballistica/game/connection/connection_stats.h"
 #include "ballistica/game/player_spec.h"
 #include "ballistica/python/python_ref.h"
 
@@ -21,6 +23,10 @@ class Connection : public Object {
  public:
   Connection();
 
+  // Hand our accumulated quality telemetry off to the Python-side hook
+  // on the way out; see ConnectionStats.
+  ~Connection() override { stats_.FlushReport(peer_spec_.GetDisplayString()); }
+
   // Send a reliable message to the client
   // these will always be delivered in the order sent
   void SendReliableMessage(const std::vector<uint8_t>& data);
@@ -35,7 +41,10 @@ class Connection : public Object {
   virtual void Update();
 
   // Called with raw packets as they come in from the network.
-  virtual void HandleGamePacket(const std::vector<uint8_t>& buffer);
+  // The buffer is passed by ownership (it originates in PacketPool up in
+  // the network-reader thread); resize/consume it freely and it will find
+  // its way back to the pool when we're done with it.
+  virtual void HandleGamePacket(std::vector<uint8_t> buffer);
 
   // Called when the next in-order message is available.
   virtual void HandleMessagePacket(const std::vector<uint8_t>& buffer) = 0;
@@ -64,9 +73,27 @@ class Connection : public Object {
     return last_resend_bytes_out_;
   }
   auto average_ping() const -> float { return average_ping_; }
+
+  // Adaptive rtt/loss estimation and congestion window for this
+  // connection; resend/ack handling feeds it and the send path asks it
+  // for pacing. Exposed for the NetGraph overlay.
+  auto pacing() -> ConnectionPacing& { return pacing_; }
+  auto pacing() const -> const ConnectionPacing& { return pacing_; }
+
+  // Rolling quality telemetry for this connection; the same spots that
+  // feed pacing_ feed this, and it reports through the
+  // client_connection_stats Python hook at disconnect.
+  auto stats() -> ConnectionStats& { return stats_; }
+  auto stats() const -> const ConnectionStats& { return stats_; }
+  // Huffman dictionary version negotiated in the handshake (see
+  // Huffman::kDictLegacy and friends). We advertise our highest supported
+  // id in the handshake json and both sides settle on the min; peers
+  // predating versioned dicts advertise nothing and get the legacy table.
+  auto compression_dict_id() const -> int { return compression_dict_id_; }
+  void set_compression_dict_id(int val) { compression_dict_id_ = val; }
   auto can_communicate() const -> bool { return can_communicate_; }
   auto peer_spec() const -> const PlayerSpec& { return peer_spec_; }
-  void HandleGamePacketCompressed(const std::vector<uint8_t>& data);
+  void HandleGamePacketCompressed(std::vector<uint8_t> data);
   auto errored() const -> bool { return errored_; }
   auto creation_time() const -> millisecs_t { return creation_time_; }
   auto multipart_buffer_size() const -> size_t {
@@ -130,8 +157,11 @@ class Connection : public Object {
   std::unordered_map<uint16_t, ReliableMessageOut> out_messages_;
   bool can_communicate_{};
   bool errored_{};
+  int compression_dict_id_{};  // Huffman::kDictLegacy until negotiated.
   millisecs_t last_prune_time_{};
   millisecs_t last_ack_send_time_{};
+  ConnectionPacing pacing_;
+  ConnectionStats stats_;
 
   // These are explicitly 16 bit values.
   uint16_t next_out_message_num_ = kFirstConnectionStateNum;
@@ -0,0 +1,58 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/connection/connection_pacing.h"
+
+#include <algorithm>
+
+namespace ballistica {
+
+void ConnectionPacing::AddRttSample(millisecs_t rtt) {
+  auto sample = static_cast<float>(rtt);
+  if (smoothed_rtt_ < 0.0f) {
+    // First sample primes the estimator (RFC 6298 style).
+    smoothed_rtt_ = sample;
+    rtt_variance_ = sample * 0.5f;
+  } else {
+    float err = sample - smoothed_rtt_;
+    smoothed_rtt_ += 0.125f * err;
+    rtt_variance_ += 0.25f * (std::abs(err) - rtt_variance_);
+  }
+}
+
+void ConnectionPacing::OnPacketSent(int bytes) {
+  bytes_outstanding_ += bytes;
+}
+
+void ConnectionPacing::OnPacketAcked(int bytes) {
+  bytes_outstanding_ = std::max(0, bytes_outstanding_ - bytes);
+  loss_fraction_ *= 0.99f;
+
+  // Additive increase: one max-packet of window per window's worth of
+  // acked data.
+  acked_since_increase_ += bytes;
+  if (acked_since_increase_ >= window_) {
+    acked_since_increase_ = 0;
+    window_ = std::min(window_ + kMaxPacketSize, kMaxWindow);
+  }
+}
+
+void ConnectionPacing::OnPacketLost(int bytes) {
+  bytes_outstanding_ = std::max(0, bytes_outstanding_ - bytes);
+  loss_fraction_ = loss_fraction_ * 0.99f + 0.01f;
+
+  // Multiplicative decrease.
+  window_ = std::max(window_ / 2, kMinWindow);
+  acked_since_increase_ = 0;
+}
+
+auto ConnectionPacing::GetResendTimeout() const -> millisecs_t {
+  if (smoothed_rtt_ < 0.0f) {
+    // No samples yet; the old fixed resend time.
+    return 100;
+  }
+  auto timeout =
+      static_cast<millisecs_t>(smoothed_rtt_ + 4.0f * rtt_variance_);
+  return std::max<millisecs_t>(30, std::min<millisecs_t>(1000, timeout));
+}
+
+}  // namespace ballistica
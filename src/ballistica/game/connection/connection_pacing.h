@@ -0,0 +1,63 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_CONNECTION_CONNECTION_PACING_H_
+#define BALLISTICA_GAME_CONNECTION_CONNECTION_PACING_H_
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// Per-connection send pacing: RTT and loss estimation feeding an
+// additive-increase/multiplicative-decrease congestion window, so lossy
+// mobile links get backed off before they stall while clean LAN links
+// ramp up past our old fixed pacing constants. The udp connection layer
+// feeds in acks/resends as they happen and asks CanSend() before
+// shipping non-essential traffic; current values are also readable for
+// the NetGraph overlay.
+class ConnectionPacing {
+ public:
+  // Window bounds, in bytes outstanding. The floor keeps handshakes and
+  // keepalives moving even on terrible links.
+  static const int kMinWindow = 2 * 1400;
+  static const int kMaxWindow = 256 * 1024;
+
+  // Feed a fresh round-trip measurement (from a reliable-message ack).
+  void AddRttSample(millisecs_t rtt);
+
+  // Track packets leaving/arriving so we know bytes outstanding.
+  void OnPacketSent(int bytes);
+  void OnPacketAcked(int bytes);
+
+  // A resend fired; treat as loss and back off.
+  void OnPacketLost(int bytes);
+
+  // Whether the window has room for another packet of this size.
+  auto CanSend(int bytes) const -> bool {
+    return bytes_outstanding_ + bytes <= window_;
+  }
+
+  auto smoothed_rtt() const -> float { return smoothed_rtt_; }
+  auto rtt_variance() const -> float { return rtt_variance_; }
+
+  // Rough fraction of packets lately lost (0-1).
+  auto loss_fraction() const -> float { return loss_fraction_; }
+  auto window() const -> int { return window_; }
+  auto bytes_outstanding() const -> int { return bytes_outstanding_; }
+
+  // Resend timeout derived from the rtt estimate (srtt + 4*rttvar,
+  // clamped to sane bounds).
+  auto GetResendTimeout() const -> millisecs_t;
+
+ private:
+  float smoothed_rtt_{-1.0f};  // -1 == no samples yet.
+  float rtt_variance_{};
+  float loss_fraction_{};
+  int window_{8 * 1400};
+  int bytes_outstanding_{};
+  // Additive-increase accumulator (bytes acked since last window bump).
+  int acked_since_increase_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_CONNECTION_CONNECTION_PACING_H_
@@ -61,7 +61,9 @@ class ConnectionSet {
   auto GetPrintUDPConnectProgress() const -> bool {
     return print_udp_connect_progress_;
   }
-  auto PushUDPConnectionPacketCall(const std::vector<uint8_t>& data,
+  // Takes ownership of a pooled packet buffer filled by the
+  // network-reader thread; no payload copies happen after recvfrom().
+  auto PushUDPConnectionPacketCall(std::vector<uint8_t> data,
                                    const SockAddr& addr) -> void;
   // Return our client connections (if any).
   // FIXME: this prunes invalid connections, but it is necessary?
@@ -107,8 +109,8 @@ class ConnectionSet {
   auto GooglePlayClientIDFromClientID(int client_id) -> int;
 #endif
 
-  auto UDPConnectionPacket(const std::vector<uint8_t>& data,
-                           const SockAddr& addr) -> void;
+  auto UDPConnectionPacket(std::vector<uint8_t> data, const SockAddr& addr)
+      -> void;
   auto PushClientDisconnectedCall(int id) -> void;
 
  private:
@@ -0,0 +1,115 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/connection/connection_stats.h"
+
+#include "ballistica/game/game.h"
+#include "ballistica/python/python.h"
+
+namespace ballistica {
+
+void ConnectionStats::AddRttSample(millisecs_t rtt) {
+  if (rtt < 0) {
+    return;
+  }
+  auto bucket = static_cast<int>(rtt / kRttBucketWidthMs);
+  if (bucket >= kRttBucketCount) {
+    bucket = kRttBucketCount - 1;
+  }
+  rtt_buckets_[bucket]++;
+  rtt_total_ms_ += static_cast<double>(rtt);
+  if (rtt_sample_count_ == 0 || rtt < rtt_min_ms_) {
+    rtt_min_ms_ = rtt;
+  }
+  if (rtt > rtt_max_ms_) {
+    rtt_max_ms_ = rtt;
+  }
+  rtt_sample_count_++;
+}
+
+void ConnectionStats::OnPacketSent(int bytes, int compressed_bytes) {
+  packets_out_++;
+  bytes_out_ += bytes;
+  bytes_out_compressed_ += compressed_bytes;
+}
+
+void ConnectionStats::OnPacketReceived(int bytes, int compressed_bytes) {
+  packets_in_++;
+  bytes_in_ += bytes;
+  bytes_in_compressed_ += compressed_bytes;
+}
+
+void ConnectionStats::OnPacketResent(int bytes) {
+  packets_resent_++;
+  bytes_resent_ += bytes;
+}
+
+void ConnectionStats::OnMessageReordered() { reorder_count_++; }
+
+void ConnectionStats::OnMessageOut(uint8_t type, int bytes) {
+  message_bytes_by_type_[type] += bytes;
+}
+
+void ConnectionStats::OnSessionCommandOut(int command, int bytes) {
+  if (command >= 0 && command < kSessionCommandCount) {
+    session_command_bytes_[command] += bytes;
+  }
+}
+
+auto ConnectionStats::GetAverageRtt() const -> float {
+  return rtt_sample_count_ > 0
+             ? static_cast<float>(rtt_total_ms_
+                                  / static_cast<double>(rtt_sample_count_))
+             : 0.0f;
+}
+
+auto ConnectionStats::GetRttPercentile(float percentile) const -> float {
+  if (rtt_sample_count_ <= 0) {
+    return 0.0f;
+  }
+  auto target = static_cast<int64_t>(static_cast<double>(rtt_sample_count_)
+                                     * static_cast<double>(percentile) * 0.01);
+  if (target >= rtt_sample_count_) {
+    target = rtt_sample_count_ - 1;
+  }
+  int64_t seen = 0;
+  for (int i = 0; i < kRttBucketCount; i++) {
+    seen += rtt_buckets_[i];
+    if (seen > target) {
+      // Report the top edge of the bucket; plenty at 4ms grain.
+      return static_cast<float>((i + 1) * kRttBucketWidthMs);
+    }
+  }
+  return static_cast<float>(kRttBucketCount * kRttBucketWidthMs);
+}
+
+auto ConnectionStats::GetLossEstimate() const -> float {
+  return packets_out_ > 0 ? static_cast<float>(packets_resent_)
+                                / static_cast<float>(packets_out_)
+                          : 0.0f;
+}
+
+auto ConnectionStats::GetCompressionRatio() const -> float {
+  return bytes_out_ > 0 ? static_cast<float>(bytes_out_compressed_)
+                              / static_cast<float>(bytes_out_)
+                        : 1.0f;
+}
+
+void ConnectionStats::FlushReport(const std::string& peer_desc) {
+  if (flushed_ || packets_out_ + packets_in_ == 0) {
+    return;
+  }
+  flushed_ = true;
+
+  // Connections die on the game thread, but hand the report off through
+  // a pushed call anyway so we're not running arbitrary Python from the
+  // middle of a connection teardown.
+  if (g_game == nullptr || g_python == nullptr) {
+    return;
+  }
+  ConnectionStats snapshot = *this;
+  g_game->PushCall([snapshot, peer_desc] {
+    g_python->HandleClientConnectionStats(snapshot, peer_desc);
+  });
+}
+
+}  // namespace ballistica
@@ -0,0 +1,117 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_CONNECTION_CONNECTION_STATS_H_
+#define BALLISTICA_GAME_CONNECTION_CONNECTION_STATS_H_
+
+#include <string>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// Per-connection rolling quality telemetry: RTT distribution, loss and
+// reorder counts, compression effectiveness, and outgoing bytes broken
+// down by message type / game-stream command. The udp connection layer
+// feeds events in as they happen (the same spots that feed
+// ConnectionPacing) and the accumulated bag is handed to the
+// client_connection_stats Python hook when the connection dies, so
+// server operators can forward it to their dashboards. Everything here
+// runs on the game thread.
+class ConnectionStats {
+ public:
+  // RTT histogram covers 0..256ms in 4ms buckets; the last bucket
+  // absorbs anything slower.
+  static const int kRttBucketCount = 64;
+  static const int kRttBucketWidthMs = 4;
+
+  // Message types are single wire bytes; session-commands currently
+  // top out around 52 (see SessionCommand) but leave headroom.
+  static const int kMessageTypeCount = 256;
+  static const int kSessionCommandCount = 64;
+
+  // Feed a fresh round-trip measurement (from a reliable-message ack).
+  void AddRttSample(millisecs_t rtt);
+
+  // Track raw packets in/out; 'bytes' is the uncompressed payload size
+  // and 'compressed_bytes' what actually hit the wire.
+  void OnPacketSent(int bytes, int compressed_bytes);
+  void OnPacketReceived(int bytes, int compressed_bytes);
+
+  // A reliable message went out again without getting acked.
+  void OnPacketResent(int bytes);
+
+  // An in-order message arrived after one of its successors.
+  void OnMessageReordered();
+
+  // Tally an outgoing message against its type byte (the first byte of
+  // every message buffer).
+  void OnMessageOut(uint8_t type, int bytes);
+
+  // Tally bytes a GameStream command contributed to this connection's
+  // session-commands messages.
+  void OnSessionCommandOut(int command, int bytes);
+
+  auto rtt_sample_count() const -> int64_t { return rtt_sample_count_; }
+  auto rtt_min_ms() const -> millisecs_t { return rtt_min_ms_; }
+  auto rtt_max_ms() const -> millisecs_t { return rtt_max_ms_; }
+  auto packets_out() const -> int64_t { return packets_out_; }
+  auto packets_in() const -> int64_t { return packets_in_; }
+  auto packets_resent() const -> int64_t { return packets_resent_; }
+  auto bytes_resent() const -> int64_t { return bytes_resent_; }
+  auto reorder_count() const -> int64_t { return reorder_count_; }
+  auto bytes_out() const -> int64_t { return bytes_out_; }
+  auto bytes_out_compressed() const -> int64_t {
+    return bytes_out_compressed_;
+  }
+  auto bytes_in() const -> int64_t { return bytes_in_; }
+  auto bytes_in_compressed() const -> int64_t { return bytes_in_compressed_; }
+  auto message_bytes_for_type(int type) const -> int64_t {
+    return message_bytes_by_type_[type];
+  }
+  auto session_command_bytes(int command) const -> int64_t {
+    return session_command_bytes_[command];
+  }
+
+  // Average RTT in milliseconds (0 if no samples).
+  auto GetAverageRtt() const -> float;
+
+  // RTT at a given percentile (0-100), in milliseconds, estimated from
+  // the histogram (0 if no samples).
+  auto GetRttPercentile(float percentile) const -> float;
+
+  // Fraction of outgoing packets that needed a resend (our best local
+  // proxy for loss).
+  auto GetLossEstimate() const -> float;
+
+  // Compressed-to-uncompressed ratio for outgoing traffic (1.0 if
+  // nothing was sent).
+  auto GetCompressionRatio() const -> float;
+
+  // Hand the accumulated stats off to the client_connection_stats
+  // Python hook; no-op if nothing was recorded or already flushed.
+  // Called as the connection dies.
+  void FlushReport(const std::string& peer_desc);
+
+ private:
+  int64_t rtt_buckets_[kRttBucketCount]{};
+  int64_t rtt_sample_count_{};
+  double rtt_total_ms_{};
+  millisecs_t rtt_min_ms_{};
+  millisecs_t rtt_max_ms_{};
+  int64_t packets_out_{};
+  int64_t packets_in_{};
+  int64_t packets_resent_{};
+  int64_t bytes_resent_{};
+  int64_t reorder_count_{};
+  int64_t bytes_out_{};
+  int64_t bytes_out_compressed_{};
+  int64_t bytes_in_{};
+  int64_t bytes_in_compressed_{};
+  int64_t message_bytes_by_type_[kMessageTypeCount]{};
+  int64_t session_command_bytes_[kSessionCommandCount]{};
+  bool flushed_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_CONNECTION_CONNECTION_STATS_H_
@@ -7,6 +7,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "ballistica/game/connection/client_interest_set.h"
 #include "ballistica/game/connection/connection.h"
 
 namespace ballistica {
@@ -18,7 +19,7 @@ class ConnectionToClient : public Connection {
   ~ConnectionToClient() override;
   void Update() override;
   void HandleMessagePacket(const std::vector<uint8_t>& buffer) override;
-  void HandleGamePacket(const std::vector<uint8_t>& buffer) override;
+  void HandleGamePacket(std::vector<uint8_t> buffer) override;
   auto id() const -> int { return id_; }
 
   // More efficient than dynamic_cast (hmm do we still want this?).
@@ -41,6 +42,30 @@ class ConnectionToClient : public Connection {
   /// account id has been verified by the master server.
   auto IsAdmin() const -> bool;
 
+  // Per-connection baseline for a delta-compressed float attr set, keyed
+  // by (node-id << 32 | attr-index). The game-stream ship path encodes
+  // kSetNodeAttrFloats changes against these with AttrDeltaCodec and the
+  // receiving client session applies the identical reconstruction, so a
+  // smoothly-moving position costs 2-4 bytes instead of 12+. A fresh
+  // zeroed baseline is handed out the first time a set is seen (or if
+  // its size changes), which forces full-float encodes for that pass.
+  auto attr_delta_baseline(uint64_t key, size_t count) -> float* {
+    std::vector<float>& baseline = attr_delta_baselines_[key];
+    if (baseline.size() != count) {
+      baseline.assign(count, 0.0f);
+    }
+    return baseline.data();
+  }
+
+  // Dump all delta baselines; used on session-reset when node/attr ids
+  // start over.
+  void ClearAttrDeltaBaselines() { attr_delta_baselines_.clear(); }
+
+  // Interest management for this client; the game-stream ship path
+  // consults this to thin out attr updates for nodes far from the
+  // client's players.
+  auto interest_set() -> ClientInterestSet& { return interest_set_; }
+
  private:
   virtual auto ShouldPrintIncompatibleClientErrors() const -> bool;
   // Returns a spec for this client that incorporates their player names
@@ -68,6 +93,8 @@ class ConnectionToClient : public Connection {
   millisecs_t chat_block_time_ = 0;
   millisecs_t last_remove_player_time_ = -99999;
   int next_chat_block_seconds_ = 10;
+  std::unordered_map<uint64_t, std::vector<float> > attr_delta_baselines_;
+  ClientInterestSet interest_set_;
   friend class Game;
 };
 
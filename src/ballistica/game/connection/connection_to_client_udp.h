@@ -19,7 +19,7 @@ class ConnectionToClientUDP : public ConnectionToClient {
                         uint8_t request_id, int client_id);
   ~ConnectionToClientUDP() override;
   void Update() override;
-  void HandleGamePacket(const std::vector<uint8_t>& buffer) override;
+  void HandleGamePacket(std::vector<uint8_t> buffer) override;
   auto client_name() const -> const std::string& { return client_name_; }
   auto GetAsUDP() -> ConnectionToClientUDP* override;
   void RequestDisconnect() override;
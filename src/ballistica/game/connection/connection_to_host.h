@@ -17,7 +17,7 @@ class ConnectionToHost : public Connection {
   ~ConnectionToHost() override;
   void Update() override;
   void HandleMessagePacket(const std::vector<uint8_t>& buffer) override;
-  void HandleGamePacket(const std::vector<uint8_t>& buffer) override;
+  void HandleGamePacket(std::vector<uint8_t> buffer) override;
   // more efficient than dynamic_cast?.. bad idea?..
   virtual auto GetAsUDP() -> ConnectionToHostUDP*;
   auto build_number() const -> int { return build_number_; }
@@ -17,7 +17,7 @@ class ConnectionToHostUDP : public ConnectionToHost {
   explicit ConnectionToHostUDP(const SockAddr& addr);
   ~ConnectionToHostUDP() override;
   void Update() override;
-  void HandleGamePacket(const std::vector<uint8_t>& buffer) override;
+  void HandleGamePacket(std::vector<uint8_t> buffer) override;
   auto GetAsUDP() -> ConnectionToHostUDP* override;
   auto request_id() const -> uint8_t { return request_id_; }
   void set_client_id(int val) { client_id_ = val; }
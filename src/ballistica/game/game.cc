@@ -9,6 +9,7 @@
 #include "ballistica/app/app.h"
 #include "ballistica/app/app_config.h"
 #include "ballistica/audio/audio.h"
+#include "ballistica/core/profiler.h"
 #include "ballistica/core/thread.h"
 #include "ballistica/dynamics/bg/bg_dynamics.h"
 #include "ballistica/game/account.h"
@@ -17,20 +18,25 @@
 #include "ballistica/game/connection/connection_to_host_udp.h"
 #include "ballistica/game/friend_score_set.h"
 #include "ballistica/game/host_activity.h"
+#include "ballistica/game/load_test.h"
 #include "ballistica/game/player.h"
+#include "ballistica/game/replay_benchmark.h"
 #include "ballistica/game/score_to_beat.h"
 #include "ballistica/game/session/client_session.h"
 #include "ballistica/game/session/host_session.h"
 #include "ballistica/game/session/net_client_session.h"
 #include "ballistica/game/session/replay_client_session.h"
+#include "ballistica/game/soak_test.h"
 #include "ballistica/generic/json.h"
 #include "ballistica/generic/timer.h"
+#include "ballistica/graphics/frame_ledger.h"
 #include "ballistica/graphics/graphics.h"
 #include "ballistica/graphics/graphics_server.h"
 #include "ballistica/graphics/text/text_graphics.h"
 #include "ballistica/input/device/client_input_device.h"
 #include "ballistica/input/device/keyboard_input.h"
 #include "ballistica/input/device/touch_input.h"
+#include "ballistica/input/input_latency_meter.h"
 #include "ballistica/math/vector3f.h"
 #include "ballistica/networking/network_write_module.h"
 #include "ballistica/networking/networking.h"
@@ -67,9 +73,20 @@ const int kKickVoteMinimumClients = (g_buildconfig.headless_build() ? 3 : 4);
 
 const int kMaxChatMessages = 40;
 
+// How long input must sit idle before we start throttling frame-def
+// production to save CPU/GPU (think kiosk machines sitting in menus
+// all day).
+const int kIdleDrawThrottleDelay = 30000;
+
+// Target interval between frame-defs while throttled.
+const int kIdleDrawInterval = 100;
+
 // Go with 5 minute ban.
 const int kKickBanSeconds = 5 * 60;
 
+// How long one pass of cooperative idle tasks may run.
+const int64_t kIdleTaskBudgetMicrosecs = 1000;
+
 Game::Game(Thread* thread)
     : Module("game", thread),
       game_roster_(cJSON_CreateArray()),
@@ -115,6 +132,14 @@ Game::Game(Thread* thread)
 
     // We're the thread that 'owns' python so we need to wrangle the GIL.
     thread->SetOwnsPython();
+
+    // Release-automation hook: play a replay benchmark at launch and
+    // shut down when it completes (the cmake pgo-profile target uses
+    // this to collect profiles over recorded worst-case sessions).
+    if (const char* pgo_replay = getenv("BA_PGO_REPLAY")) {
+      std::string path{pgo_replay};
+      PushCall([this, path] { StartReplayBenchmark(path, true); });
+    }
   } catch (const std::exception& e) {
     // If anything went wrong, trigger a deferred error.
     // This way it is more likely we can show a fatal error dialog
@@ -237,6 +262,10 @@ void Game::SetGameRoster(cJSON* r) {
     cJSON_Delete(game_roster_);
   }
   game_roster_ = r;
+
+  // This is a complete roster handed to us (client case); no rebuild due.
+  game_roster_needs_rebuild_ = false;
+  game_roster_version_++;
 }
 
 void Game::ResetActivityTracking() {
@@ -363,8 +392,9 @@ void Game::UpdateProcessTimer() {
   // explicitly after creating the timers.
   if (!process_timer_) return;
 
-  // If there's loading to do, keep at it rather vigorously.
-  if (have_pending_loads_) {
+  // If there's loading or housekeeping to do, keep at it rather
+  // vigorously.
+  if (have_pending_loads_ || !idle_tasks_.empty()) {
     assert(process_timer_);
     process_timer_->SetLength(1);
   } else {
@@ -509,7 +539,29 @@ void Game::UpdateKickVote() {
 
 // Bring our scenes, real-time timers, etc up to date.
 void Game::Update() {
+  // Events that arrived on other threads before this point get consumed
+  // by this tick; later ones wait for the next.
+  InputLatencyMeter::LatchPendingInput();
+
+  // Time the tick when anyone's interested: a running load test feeds
+  // its distribution from it, and an armed flight recorder watches it
+  // for spikes worth capturing.
+  if (load_test_ || FrameLedger::flight_recorder_armed()) {
+    int64_t start = Platform::GetCurrentMicroseconds();
+    DoUpdate();
+    int64_t elapsed = Platform::GetCurrentMicroseconds() - start;
+    if (load_test_) {
+      load_test_->OnHostTick(elapsed);
+    }
+    FrameLedger::NoteFrameTime(elapsed);
+  } else {
+    DoUpdate();
+  }
+}
+
+void Game::DoUpdate() {
   assert(InGameThread());
+  BA_PROFILE_SCOPE("game-update");
   millisecs_t real_time = GetRealTime();
   g_platform->SetDebugKey("LastUpdateTime",
                           std::to_string(Platform::GetCurrentMilliseconds()));
@@ -600,6 +652,9 @@ void Game::Update() {
   // of time).
   int step = 1;
 
+  bool ledger = FrameLedger::enabled();
+  int64_t ledger_start = ledger ? Platform::GetCurrentMicroseconds() : 0;
+
   while (true) {
     // Try to stick to our target step count whenever possible, but if we get
     // too far off target we may need to bail earlier/later.
@@ -622,6 +677,8 @@ void Game::Update() {
       }
     }
 
+    BA_PROFILE_SCOPE("session-step");
+
     // Update our UI scene/etc.
     g_ui->Update(8);
 
@@ -646,6 +703,10 @@ void Game::Update() {
     }
     step++;
   }
+  if (ledger) {
+    FrameLedger::Add(FrameLedger::Lane::kStep,
+                     Platform::GetCurrentMicroseconds() - ledger_start);
+  }
   in_update_ = false;
 }
 
@@ -657,7 +718,8 @@ void Game::Reset() {
   // This should allow high-level objects to die gracefully.
   assert(g_python->inited());
 
-  // Tear down our existing session.
+  // Tear down our existing session. Any media it pinned goes with it.
+  g_media->ClearSessionPinnedMedia();
   foreground_session_.Clear();
   PruneSessions();
 
@@ -867,6 +929,102 @@ void Game::LaunchHostSession(PyObject* session_type_obj,
   }
 }
 
+void Game::PushInProcessRestartCall() {
+  PushCall([this] {
+    assert(InGameThread());
+    if (g_app_globals->shutting_down) {
+      return;
+    }
+    millisecs_t start_time = Platform::GetCurrentMilliseconds();
+
+    // Drop any clients first so session teardown isn't talking to them.
+    connections_->ForceDisconnectClients();
+
+    // Tear down sessions and reset ui/input/graphics/python context
+    // state; the interpreter itself and all threads stay up.
+    Reset();
+
+    // Evict whatever media only the departed session cared about.
+    // (system media is pinned by the system lists and stays loaded)
+    g_media->TrimMediaMemory(0);
+
+    // And spin up a fresh main-menu session, same as at launch.
+    RunMainMenu();
+
+    Log("In-process restart completed in "
+        + std::to_string(Platform::GetCurrentMilliseconds() - start_time)
+        + "ms.");
+  });
+}
+
+auto Game::StartLoadTest(int client_count, int latency_ms, int jitter_ms,
+                         float loss_percent) -> void {
+  assert(InGameThread());
+  if (load_test_) {
+    Log("Load test already running; stop it first.");
+    return;
+  }
+  LoadTest::Config config;
+  config.client_count = client_count;
+  config.latency_ms = latency_ms;
+  config.jitter_ms = jitter_ms;
+  config.loss_percent = loss_percent;
+  load_test_ = std::make_unique<LoadTest>(config);
+}
+
+auto Game::StopLoadTest() -> void {
+  assert(InGameThread());
+  if (!load_test_) {
+    Log("No load test running.");
+    return;
+  }
+  load_test_.reset();
+}
+
+auto Game::StartReplayBenchmark(const std::string& file_name,
+                                bool quit_when_done) -> void {
+  assert(InGameThread());
+  if (replay_benchmark_) {
+    Log("Replay benchmark already running; stop it first.");
+    return;
+  }
+  replay_benchmark_ =
+      std::make_unique<ReplayBenchmark>(file_name, quit_when_done);
+}
+
+auto Game::StopReplayBenchmark() -> void {
+  assert(InGameThread());
+  if (!replay_benchmark_) {
+    Log("No replay benchmark running.");
+    return;
+  }
+  replay_benchmark_.reset();
+}
+
+auto Game::StartSoakTest(int cycles, int client_count, int play_secs,
+                         int idle_secs) -> void {
+  assert(InGameThread());
+  if (soak_test_) {
+    Log("Soak test already running; stop it first.");
+    return;
+  }
+  SoakTest::Config config;
+  config.cycles = cycles;
+  config.client_count = client_count;
+  config.play_secs = play_secs;
+  config.idle_secs = idle_secs;
+  soak_test_ = std::make_unique<SoakTest>(config);
+}
+
+auto Game::StopSoakTest() -> void {
+  assert(InGameThread());
+  if (!soak_test_) {
+    Log("No soak test running.");
+    return;
+  }
+  soak_test_.reset();
+}
+
 void Game::RunMainMenu() {
   PushCall([this] {
     if (g_app_globals->shutting_down) {
@@ -1209,6 +1367,24 @@ void Game::PushConfirmQuitCall() {
 }
 
 void Game::Draw() {
+  // Idle governor: if nobody has touched an input in a while and we're
+  // not networked, there's no point burning GPU at full display rate;
+  // defer frame-def builds down to a low cap instead. Input resets the
+  // idle clock, so we pop back up to full rate within one throttled
+  // interval of someone touching something.
+  millisecs_t draw_real_time = GetRealTime();
+  if (g_input->GetIdleTime() >= kIdleDrawThrottleDelay
+      && !connections()->has_connection_to_clients()
+      && !connections()->has_connection_to_host()) {
+    millisecs_t wait =
+        kIdleDrawInterval - (draw_real_time - last_frame_def_build_time_);
+    if (wait > 0) {
+      NewThreadTimer(wait, false, NewLambdaRunnable([this] { Draw(); }));
+      return;
+    }
+  }
+  last_frame_def_build_time_ = draw_real_time;
+
   g_graphics->BuildAndPushFrameDef();
 
   // Now bring the game up to date.
@@ -1255,6 +1431,10 @@ void Game::PushOnAppResumeCall() {
 void Game::ApplyConfig() {
   assert(InGameThread());
 
+  // Publish a fresh lock-free-readable snapshot of all typed config
+  // values for other threads before we start pushing changes around.
+  g_app_config->UpdateSnapshot();
+
   // Not relevant for fullscreen anymore
   // since we're fullscreen windows everywhere.
   int width = 800;
@@ -1340,6 +1520,10 @@ void Game::ApplyConfig() {
       g_app_config->Resolve(AppConfig::FloatID::kScreenGamma));
   g_graphics_server->PushSetScreenPixelScaleCall(
       g_app_config->Resolve(AppConfig::FloatID::kScreenPixelScale));
+  g_graphics_server->PushSetHalfRateWorldModeCall(
+      g_app_config->Resolve(AppConfig::BoolID::kHalfRateWorld));
+  g_graphics_server->PushSetDynamicResolutionCall(
+      g_app_config->Resolve(AppConfig::BoolID::kDynamicResolution));
 
   TextWidget::set_always_use_internal_keyboard(
       g_app_config->Resolve(AppConfig::BoolID::kAlwaysUseInternalKeyboard));
@@ -1421,19 +1605,6 @@ void Game::PushRemoveGraphicsServerRenderHoldCall() {
   });
 }
 
-void Game::PushFreeMediaComponentRefsCall(
-    const std::vector<Object::Ref<MediaComponentData>*>& components) {
-  PushCall([components] {
-    for (auto&& i : components) {
-      delete i;
-    }
-  });
-}
-
-void Game::PushHavePendingLoadsDoneCall() {
-  PushCall([] { g_media->ClearPendingLoadsDoneList(); });
-}
-
 void Game::ToggleConsole() {
   assert(InGameThread());
   if (auto console = g_app_globals->console) {
@@ -1527,9 +1698,44 @@ void Game::SetRealTimerLength(int timer_id, millisecs_t length) {
 
 void Game::Process() {
   have_pending_loads_ = g_media->RunPendingLoadsGameThread();
+  RunIdleTasks();
   UpdateProcessTimer();
 }
 
+void Game::AddIdleTask(std::function<bool()> task) {
+  assert(InGameThread());
+  assert(task);
+  idle_tasks_.push_back(std::move(task));
+
+  // The process timer may be sleeping; poke it awake.
+  UpdateProcessTimer();
+}
+
+void Game::RunIdleTasks() {
+  assert(InGameThread());
+  if (idle_tasks_.empty()) {
+    return;
+  }
+
+  // Give each task a slice, oldest first, until everyone's had one or
+  // the budget runs dry. Unserved tasks stay at the front so they go
+  // first next pass; that keeps one chatty task from starving the
+  // rest.
+  int64_t deadline =
+      Platform::GetCurrentMicroseconds() + kIdleTaskBudgetMicrosecs;
+  size_t remaining = idle_tasks_.size();
+  while (remaining-- > 0) {
+    auto task = std::move(idle_tasks_.front());
+    idle_tasks_.pop_front();
+    if (task()) {
+      idle_tasks_.push_back(std::move(task));
+    }
+    if (Platform::GetCurrentMicroseconds() >= deadline) {
+      break;
+    }
+  }
+}
+
 void Game::SetLanguageKeys(
     const std::unordered_map<std::string, std::string>& language) {
   assert(InGameThread());
@@ -1840,10 +2046,10 @@ void Game::PartyInviteRevoke(const std::string& invite_id) {
   g_python->PartyInviteRevoke(invite_id);
 }
 
-auto Game::GetPartySize() const -> int {
+auto Game::GetPartySize() -> int {
   assert(InGameThread());
   assert(game_roster_ != nullptr);
-  return cJSON_GetArraySize(game_roster_);
+  return cJSON_GetArraySize(game_roster());
 }
 
 void Game::LocalDisplayChatMessage(const std::vector<uint8_t>& buffer) {
@@ -1888,17 +2094,24 @@ void Game::LocalDisplayChatMessage(const std::vector<uint8_t>& buffer) {
 }
 
 auto Game::GetGameRosterMessage() -> std::vector<uint8_t> {
-  // This message is simply a flattened json string of our roster (including
-  // terminating char).
-  char* s = cJSON_PrintUnformatted(game_roster_);
-  // printf("ROSTER MESSAGE %s\n", s);
-  auto s_len = strlen(s);
-  std::vector<uint8_t> msg(1 + s_len + 1);
-  msg[0] = BA_MESSAGE_PARTY_ROSTER;
-  memcpy(&(msg[1]), s, s_len + 1);
-  free(s);
+  if (game_roster_needs_rebuild_) {
+    RebuildGameRoster();
+  }
 
-  return msg;
+  // This message is simply a flattened json string of our roster (including
+  // terminating char). We keep one shared blob around and reuse it across
+  // all clients and resends until the roster actually changes.
+  if (cached_roster_message_version_ != game_roster_version_) {
+    char* s = cJSON_PrintUnformatted(game_roster_);
+    // printf("ROSTER MESSAGE %s\n", s);
+    auto s_len = strlen(s);
+    cached_roster_message_.resize(1 + s_len + 1);
+    cached_roster_message_[0] = BA_MESSAGE_PARTY_ROSTER;
+    memcpy(&(cached_roster_message_[1]), s, s_len + 1);
+    free(s);
+    cached_roster_message_version_ = game_roster_version_;
+  }
+  return cached_roster_message_;
 }
 
 auto Game::IsPlayerBanned(const PlayerSpec& spec) -> bool {
@@ -2023,6 +2236,32 @@ void Game::BanPlayer(const PlayerSpec& spec, millisecs_t duration) {
 void Game::UpdateGameRoster() {
   assert(InGameThread());
 
+  // Specs often change several times within a single cycle and sends are
+  // throttled anyway, so don't rebuild the json here; just note that the
+  // current one is stale. It gets rebuilt when something actually reads it.
+  game_roster_needs_rebuild_ = true;
+
+  int total_party_size = 1;  // include ourself here..
+  if (dynamic_cast<HostSession*>(GetForegroundSession()) != nullptr) {
+    for (auto&& i : connections()->connections_to_clients()) {
+      if (i.second->can_communicate()) {
+        total_party_size += 1;
+      }
+    }
+  }
+
+  // Keep the Python layer informed on our number of connections; it may want
+  // to pass the info along to the master server if we're hosting a public
+  // party.
+  SetPublicPartySize(total_party_size);
+
+  // Mark the roster as dirty so we know we need to send it to everyone soon.
+  game_roster_dirty_ = true;
+}
+
+void Game::RebuildGameRoster() {
+  assert(InGameThread());
+
   assert(game_roster_ != nullptr);
   if (game_roster_ != nullptr) {
     cJSON_Delete(game_roster_);
@@ -2030,8 +2269,8 @@ void Game::UpdateGameRoster() {
 
   // Our party-roster is just a json array of dicts containing player-specs.
   game_roster_ = cJSON_CreateArray();
-
-  int total_party_size = 1;  // include ourself here..
+  game_roster_needs_rebuild_ = false;
+  game_roster_version_++;
 
   // Add ourself first (that's currently how they know we're the party leader)
   // ..but only if we have a connected client (otherwise our party is
@@ -2117,18 +2356,9 @@ void Game::UpdateGameRoster() {
         cJSON_AddItemToObject(client_dict, "i",
                               cJSON_CreateNumber(i.second->id()));
         cJSON_AddItemToArray(game_roster_, client_dict);
-        total_party_size += 1;
       }
     }
   }
-
-  // Keep the Python layer informed on our number of connections; it may want
-  // to pass the info along to the master server if we're hosting a public
-  // party.
-  SetPublicPartySize(total_party_size);
-
-  // Mark the roster as dirty so we know we need to send it to everyone soon.
-  game_roster_dirty_ = true;
 }
 
 void Game::SetPublicPartyEnabled(bool val) {
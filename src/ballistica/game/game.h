@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_GAME_GAME_H_
 #define BALLISTICA_GAME_GAME_H_
 
+#include <functional>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -31,6 +32,14 @@ class Game : public Module {
   auto LaunchClientSession() -> void;
   auto LaunchReplaySession(const std::string& file_name) -> void;
 
+  /// Register an incremental housekeeping task (roster serialization,
+  /// stat aggregation, replay writes, etc) with the game thread's
+  /// cooperative scheduler. The task gets run in the same slack slot
+  /// as pending media loads under a shared microsecond budget per
+  /// pass, so it should do one small slice of work per call; have it
+  /// return true to keep getting called or false once finished.
+  auto AddIdleTask(std::function<bool()> task) -> void;
+
   auto PushSetAccountCall(AccountType account_type, AccountState account_state,
                           const std::string& account_name,
                           const std::string& account_id) -> void;
@@ -65,9 +74,6 @@ class Game : public Module {
   auto PushToggleCollisionGeometryDisplayCall() -> void;
   auto PushToggleDebugInfoDisplayCall() -> void;
   auto PushToggleManualCameraCall() -> void;
-  auto PushHavePendingLoadsDoneCall() -> void;
-  auto PushFreeMediaComponentRefsCall(
-      const std::vector<Object::Ref<MediaComponentData>*>& components) -> void;
   auto PushHavePendingLoadsCall() -> void;
   auto PushShutdownCall(bool soft) -> void;
 
@@ -107,6 +113,34 @@ class Game : public Module {
   auto ChangeGameSpeed(int offs) -> void;
   auto ResetInput() -> void;
   auto RunMainMenu() -> void;
+
+  /// Soft-reset the engine between matches without restarting the
+  /// binary: kicks any clients, tears down sessions and per-session
+  /// media, and relaunches the main-menu session, while the Python
+  /// interpreter, system media, and all threads stay up. Server
+  /// wrappers use this in place of a full process restart.
+  auto PushInProcessRestartCall() -> void;
+
+  /// Start/stop the synthetic-client load generator (see LoadTest).
+  /// Game thread only.
+  auto StartLoadTest(int client_count, int latency_ms, int jitter_ms,
+                     float loss_percent) -> void;
+  auto StopLoadTest() -> void;
+
+  /// Start/stop unthrottled replay playback with per-subsystem timing
+  /// (see ReplayBenchmark). Stops itself when the replay ends; with
+  /// quit_when_done it also shuts the app down afterwards (for
+  /// automated runs such as pgo profile collection). Game thread only.
+  auto StartReplayBenchmark(const std::string& file_name,
+                            bool quit_when_done = false) -> void;
+  auto StopReplayBenchmark() -> void;
+
+  /// Start/stop the join/play/leave soak harness with per-cycle leak
+  /// detection (see SoakTest). Stops itself after its cycle count.
+  /// Game thread only.
+  auto StartSoakTest(int cycles, int client_count, int play_secs,
+                     int idle_secs) -> void;
+  auto StopSoakTest() -> void;
   auto HandleThreadPause() -> void override;
 
 #if BA_VR_BUILD
@@ -125,6 +159,11 @@ class Game : public Module {
     return foreground_session_.get();
   }
 
+  // *All* existing sessions (including old ones waiting to shut down).
+  auto sessions() const -> const std::vector<Object::Ref<Session> >& {
+    return sessions_;
+  }
+
   auto NewRealTimer(millisecs_t length, bool repeat,
                     const Object::Ref<Runnable>& runnable) -> int;
   auto DeleteRealTimer(int timer_id) -> void;
@@ -161,7 +200,7 @@ class Game : public Module {
   auto replay_speed_exponent() const -> int { return replay_speed_exponent_; }
   auto replay_speed_mult() const -> float { return replay_speed_mult_; }
 
-  auto GetPartySize() const -> int;
+  auto GetPartySize() -> int;
   auto last_connection_to_client_join_time() const -> millisecs_t {
     return last_connection_to_client_join_time_;
   }
@@ -169,7 +208,12 @@ class Game : public Module {
     last_connection_to_client_join_time_ = val;
   }
 
-  auto game_roster() const -> cJSON* { return game_roster_; }
+  auto game_roster() -> cJSON* {
+    if (game_roster_needs_rebuild_) {
+      RebuildGameRoster();
+    }
+    return game_roster_;
+  }
 
   auto chat_messages() const -> const std::list<std::string>& {
     return chat_messages_;
@@ -275,21 +319,31 @@ class Game : public Module {
   auto Prune() -> void;  // Periodic pruning of dead stuff.
   auto Update() -> void;
   auto Process() -> void;
+  auto RunIdleTasks() -> void;
+  auto DoUpdate() -> void;
   auto UpdateKickVote() -> void;
   auto RunAppLaunchCommands() -> void;
   auto PruneSessions() -> void;
   auto ApplyConfig() -> void;
   auto UpdateProcessTimer() -> void;
   auto Reset() -> void;
+  auto RebuildGameRoster() -> void;
   auto GetGameRosterMessage() -> std::vector<uint8_t>;
   auto Shutdown(bool soft) -> void;
 
   std::unique_ptr<ConnectionSet> connections_;
+  std::unique_ptr<LoadTest> load_test_;
+  std::unique_ptr<ReplayBenchmark> replay_benchmark_;
+  std::unique_ptr<SoakTest> soak_test_;
   std::list<std::pair<millisecs_t, PlayerSpec> > banned_players_;
   std::list<std::string> chat_messages_;
   bool chat_muted_{};
   bool first_update_{true};
   bool game_roster_dirty_{};
+  bool game_roster_needs_rebuild_{};
+  int game_roster_version_{};
+  int cached_roster_message_version_{-1};
+  std::vector<uint8_t> cached_roster_message_;
   millisecs_t last_connection_to_client_join_time_{};
   int debug_speed_exponent_{};
   float debug_speed_mult_{1.0f};
@@ -303,6 +357,7 @@ class Game : public Module {
   millisecs_t largest_draw_time_increment_since_last_reset_{};
   millisecs_t last_draw_real_time_{};
   millisecs_t first_draw_real_time_{};
+  millisecs_t last_frame_def_build_time_{};
 
   // *All* existing sessions (including old ones waiting to shut down).
   std::vector<Object::Ref<Session> > sessions_;
@@ -320,6 +375,7 @@ class Game : public Module {
   Timer* media_prune_timer_{};
   Timer* debug_timer_{};
   bool have_pending_loads_{};
+  std::list<std::function<bool()> > idle_tasks_;
   bool in_update_{};
   bool require_client_authentication_{};
   bool kick_voting_enabled_{true};
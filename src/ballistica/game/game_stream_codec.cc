@@ -0,0 +1,83 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/game_stream_codec.h"
+
+#include <cmath>
+
+namespace ballistica {
+
+// Beyond this many bytes the value can't fit in 64 bits; treat as
+// malformed rather than silently wrapping.
+static const int kMaxVarintBytes = 10;
+
+void GameStreamCodec::WriteVarint(uint64_t val, std::vector<uint8_t>* out) {
+  assert(out);
+  while (val >= 0x80) {
+    out->push_back(static_cast<uint8_t>(val) | 0x80);
+    val >>= 7;
+  }
+  out->push_back(static_cast<uint8_t>(val));
+}
+
+void GameStreamCodec::WriteSignedVarint(int64_t val,
+                                        std::vector<uint8_t>* out) {
+  // Zigzag: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+  WriteVarint((static_cast<uint64_t>(val) << 1)
+                  ^ static_cast<uint64_t>(val >> 63),
+              out);
+}
+
+void GameStreamCodec::WriteQuantizedFloat(float val, int scale,
+                                          std::vector<uint8_t>* out) {
+  assert(scale > 0);
+  WriteSignedVarint(
+      std::llround(static_cast<double>(val) * static_cast<double>(scale)),
+      out);
+}
+
+auto GameStreamCodec::ReadVarint(const uint8_t** buffer,
+                                 const uint8_t* buffer_end) -> uint64_t {
+  assert(buffer && *buffer);
+  const uint8_t* ptr = *buffer;
+  uint64_t val = 0;
+  int shift = 0;
+  for (int i = 0; i < kMaxVarintBytes; i++) {
+    if (ptr >= buffer_end) {
+      throw Exception("invalid varint data (truncated)");
+    }
+    uint8_t byte = *ptr++;
+    val |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (!(byte & 0x80)) {
+      *buffer = ptr;
+      return val;
+    }
+    shift += 7;
+  }
+  throw Exception("invalid varint data (too long)");
+}
+
+auto GameStreamCodec::ReadSignedVarint(const uint8_t** buffer,
+                                       const uint8_t* buffer_end) -> int64_t {
+  uint64_t raw = ReadVarint(buffer, buffer_end);
+  return static_cast<int64_t>((raw >> 1) ^ (~(raw & 1) + 1));
+}
+
+auto GameStreamCodec::ReadQuantizedFloat(const uint8_t** buffer,
+                                         const uint8_t* buffer_end, int scale)
+    -> float {
+  assert(scale > 0);
+  return static_cast<float>(
+      static_cast<double>(ReadSignedVarint(buffer, buffer_end))
+      / static_cast<double>(scale));
+}
+
+auto GameStreamCodec::VarintSize(uint64_t val) -> size_t {
+  size_t size = 1;
+  while (val >= 0x80) {
+    val >>= 7;
+    size++;
+  }
+  return size;
+}
+
+}  // namespace ballistica
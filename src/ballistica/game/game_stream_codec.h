@@ -0,0 +1,62 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_GAME_STREAM_CODEC_H_
+#define BALLISTICA_GAME_GAME_STREAM_CODEC_H_
+
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// Wire-size helpers for the v2 session-command encoding. The classic
+// encoding writes full-width 32/64 bit ints for values that are almost
+// always tiny (node ids, attr indices, counts) and raw 32 bit floats for
+// attribute values; v2 streams instead write LEB128 varints (zigzagged
+// where values can go negative) and fixed-point quantized floats.
+// Whether a stream uses this is decided once up front - by the
+// protocol-version handshake for connections and by the header version
+// for replay files - so readers and writers never need to guess.
+class GameStreamCodec {
+ public:
+  // Protocol version at/above which session commands use the v2
+  // encoding. (kProtocolVersion stays put until the stream writer and
+  // reader both speak this; bump them together.)
+  static const int kVarintProtocol = 34;
+
+  // Default quantization for attribute floats: 1/1024 of a game unit
+  // matches AttrDeltaCodec and is well under anything visible.
+  static const int kDefaultFloatScale = 1024;
+
+  // Unsigned LEB128. Small values (the overwhelmingly common case for
+  // ids and counts) cost one byte.
+  static void WriteVarint(uint64_t val, std::vector<uint8_t>* out);
+
+  // Zigzagged LEB128 so small negative values stay small on the wire.
+  static void WriteSignedVarint(int64_t val, std::vector<uint8_t>* out);
+
+  // Fixed-point float: round(val * scale) as a signed varint. Error is
+  // bounded by 0.5/scale; use raw floats for attrs that must round-trip
+  // exactly.
+  static void WriteQuantizedFloat(float val, int scale,
+                                  std::vector<uint8_t>* out);
+
+  // Decode counterparts; these advance *buffer past the consumed bytes
+  // and throw Exception on malformed or truncated data (this comes off
+  // the network).
+  static auto ReadVarint(const uint8_t** buffer, const uint8_t* buffer_end)
+      -> uint64_t;
+  static auto ReadSignedVarint(const uint8_t** buffer,
+                               const uint8_t* buffer_end) -> int64_t;
+  static auto ReadQuantizedFloat(const uint8_t** buffer,
+                                 const uint8_t* buffer_end, int scale)
+      -> float;
+
+  // Encoded size of a value without writing it; handy for reserving
+  // buffer space.
+  static auto VarintSize(uint64_t val) -> size_t;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_GAME_STREAM_CODEC_H_
@@ -47,6 +47,25 @@ class HostActivity : public ContextTarget {
   }
   auto start() -> void;
 
+  // Read-only peeks at the media this activity has pulled in; used by
+  // the scene-memory report to attribute usage per map/activity.
+  auto textures() const
+      -> const std::unordered_map<std::string, Object::WeakRef<Texture> >& {
+    return textures_;
+  }
+  auto sounds() const
+      -> const std::unordered_map<std::string, Object::WeakRef<Sound> >& {
+    return sounds_;
+  }
+  auto models() const
+      -> const std::unordered_map<std::string, Object::WeakRef<Model> >& {
+    return models_;
+  }
+  auto collide_models() const -> const std::unordered_map<
+      std::string, Object::WeakRef<CollideModel> >& {
+    return collide_models_;
+  }
+
   // A utility function; faster than dynamic_cast.
   auto GetAsHostActivity() -> HostActivity* override;
   auto GetMutableScene() -> Scene* override;
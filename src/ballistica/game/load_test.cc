@@ -0,0 +1,253 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/load_test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <string>
+#include <utility>
+
+#include "ballistica/core/thread.h"
+#include "ballistica/game/connection/connection_set.h"
+#include "ballistica/game/connection/connection_to_host_udp.h"
+#include "ballistica/game/game.h"
+#include "ballistica/generic/lambda_runnable.h"
+#include "ballistica/generic/timer.h"
+#include "ballistica/networking/networking.h"
+
+namespace ballistica {
+
+// Port ranges identifying our fake endpoints on the loopback address.
+// Clients aim their ConnectionToHostUDP at kFakeHostPortBase + index;
+// the host sees each client as coming from kFakeClientPortBase + index.
+// Nothing binds these; they only exist inside the intercept layer.
+const int kFakeHostPortBase = 46000;
+const int kFakeClientPortBase = 47000;
+
+// How often we pump the fake network and client upkeep.
+const int kPumpIntervalMillisecs = 4;
+
+// Scripted clients ship input at roughly the rate a human device would.
+const int kClientInputIntervalMillisecs = 33;
+
+// The single running load test (if any); used by the packet intercept.
+static std::atomic<LoadTest*> g_active_load_test{};
+
+// A synthetic client: the real client-side protocol machinery pointed
+// at a fake host address, plus a scripted input stream.
+class LoadTest::Client : public ConnectionToHostUDP {
+ public:
+  Client(int index, const SockAddr& addr)
+      : ConnectionToHostUDP(addr),
+        index_(index),
+        input_phase_(0.37f * static_cast<float>(index)) {}
+
+  // Periodic upkeep; runs protocol updates and feeds scripted input.
+  void Step(millisecs_t real_time) {
+    Update();
+    if (!can_communicate()) {
+      return;
+    }
+    if (!sent_join_request_) {
+      // Ask for a player just like a real client input-device would.
+      std::vector<uint8_t> msg(2);
+      msg[0] = BA_MESSAGE_REQUEST_REMOTE_PLAYER;
+      msg[1] = 0;
+      SendReliableMessage(msg);
+      sent_join_request_ = true;
+    }
+    if (real_time >= next_input_time_) {
+      next_input_time_ = real_time + kClientInputIntervalMillisecs;
+      SendInputCommands();
+    }
+  }
+
+ private:
+  // Wander-and-occasionally-jump; same wire format a real remote player
+  // generates (see InputDevice::InputCommand).
+  void SendInputCommands() {
+    input_phase_ += 0.2f;
+    std::vector<uint8_t> msg(2);
+    msg[0] = BA_MESSAGE_REMOTE_PLAYER_INPUT_COMMANDS;
+    msg[1] = 0;  // device index
+    auto put = [&msg](InputType type, float value) {
+      size_t size = msg.size();
+      msg.resize(size + 5);
+      msg[size] = static_cast<uint8_t>(type);
+      memcpy(&msg[size + 1], &value, 4);
+    };
+    put(InputType::kUpDown, sinf(input_phase_));
+    put(InputType::kLeftRight, cosf(input_phase_ * 0.9f));
+    if (++input_count_ % 60 == 0) {
+      put(InputType::kJumpPress, 1.0f);
+      put(InputType::kJumpRelease, 0.0f);
+    }
+    SendReliableMessage(msg);
+  }
+
+  int index_;
+  int input_count_{};
+  bool sent_join_request_{};
+  millisecs_t next_input_time_{};
+  float input_phase_;
+};
+
+LoadTest::LoadTest(const Config& config) : config_(config) {
+  assert(InGameThread());
+  config_.client_count = std::min(64, std::max(1, config_.client_count));
+  start_time_ = GetRealTime();
+  tick_durations_usecs_.reserve(64 * 1024);
+
+  // Register the intercept before any client exists; their constructors
+  // send connection requests right away.
+  assert(g_active_load_test.load() == nullptr);
+  g_active_load_test.store(this);
+
+  for (int i = 0; i < config_.client_count; ++i) {
+    clients_.push_back(Object::New<Client>(
+        i, SockAddr("127.0.0.1", kFakeHostPortBase + i)));
+  }
+  pump_timer_id_ = g_game
+                       ->thread()
+                       ->NewTimer(kPumpIntervalMillisecs, true,
+                                  NewLambdaRunnable([this] { Pump(); }))
+                       ->id();
+  Log("Load test started: " + std::to_string(config_.client_count)
+      + " synthetic clients, latency " + std::to_string(config_.latency_ms)
+      + "+-" + std::to_string(config_.jitter_ms) + "ms, loss "
+      + std::to_string(config_.loss_percent) + "%.");
+}
+
+LoadTest::~LoadTest() {
+  assert(InGameThread());
+
+  // Unhook the intercept first; teardown traffic aimed at our fake
+  // endpoints from here on just goes out the real socket and is ignored
+  // by everyone (and the host prunes the fake clients on timeout).
+  g_active_load_test.store(nullptr);
+  g_game->thread()->DeleteTimer(pump_timer_id_);
+  for (auto&& client : clients_) {
+    client->RequestDisconnect();
+  }
+  clients_.clear();
+  LogReport();
+}
+
+auto LoadTest::InterceptOutgoingPacket(const std::vector<uint8_t>& data,
+                                       const SockAddr& addr) -> bool {
+  LoadTest* load_test = g_active_load_test.load();
+  if (load_test == nullptr) {
+    return false;
+  }
+  if (!addr.IsLoopbackV4()) {
+    return false;
+  }
+  int port = addr.Port();
+  if (port >= kFakeHostPortBase
+      && port < kFakeHostPortBase + load_test->config_.client_count) {
+    load_test->Enqueue(data, true, port - kFakeHostPortBase);
+    return true;
+  }
+  if (port >= kFakeClientPortBase
+      && port < kFakeClientPortBase + load_test->config_.client_count) {
+    load_test->Enqueue(data, false, port - kFakeClientPortBase);
+    return true;
+  }
+  return false;
+}
+
+auto LoadTest::Enqueue(const std::vector<uint8_t>& data, bool to_host,
+                       int client_index) -> void {
+  std::lock_guard<std::mutex> lock(packet_mutex_);
+
+  // Inject loss (cheap xorshift; rand() isn't thread-safe everywhere).
+  rand_state_ ^= rand_state_ << 13u;
+  rand_state_ ^= rand_state_ >> 17u;
+  rand_state_ ^= rand_state_ << 5u;
+  if (config_.loss_percent > 0.0f
+      && static_cast<float>(rand_state_ % 10000u)
+             < config_.loss_percent * 100.0f) {
+    packets_dropped_++;
+    return;
+  }
+  millisecs_t delay = config_.latency_ms;
+  if (config_.jitter_ms > 0) {
+    delay += static_cast<millisecs_t>(rand_state_ >> 16u)
+             % (2 * config_.jitter_ms + 1)
+             - config_.jitter_ms;
+    delay = std::max<millisecs_t>(0, delay);
+  }
+  (to_host ? packets_to_host_ : packets_to_clients_)++;
+  packets_in_flight_.push_back(
+      PendingPacket{GetRealTime() + delay, to_host, client_index, data});
+}
+
+void LoadTest::Pump() {
+  assert(InGameThread());
+  millisecs_t real_time = GetRealTime();
+
+  // Pull everything due out under the lock, deliver outside it
+  // (delivery can trigger sends that re-enter Enqueue()).
+  std::vector<PendingPacket> due;
+  {
+    std::lock_guard<std::mutex> lock(packet_mutex_);
+    for (auto i = packets_in_flight_.begin();
+         i != packets_in_flight_.end();) {
+      if (i->deliver_time <= real_time) {
+        due.push_back(std::move(*i));
+        i = packets_in_flight_.erase(i);
+      } else {
+        ++i;
+      }
+    }
+  }
+  for (auto&& packet : due) {
+    if (packet.to_host) {
+      g_game->connections()->UDPConnectionPacket(
+          std::move(packet.data),
+          SockAddr("127.0.0.1", kFakeClientPortBase + packet.client_index));
+    } else {
+      clients_[packet.client_index]->HandleGamePacket(
+          std::move(packet.data));
+    }
+  }
+  for (auto&& client : clients_) {
+    client->Step(real_time);
+  }
+}
+
+void LoadTest::OnHostTick(int64_t duration_usecs) {
+  assert(InGameThread());
+  tick_durations_usecs_.push_back(duration_usecs);
+}
+
+void LoadTest::LogReport() {
+  if (tick_durations_usecs_.empty()) {
+    Log("Load test ended; no ticks sampled.");
+    return;
+  }
+  std::vector<int64_t> sorted = tick_durations_usecs_;
+  std::sort(sorted.begin(), sorted.end());
+  auto percentile = [&sorted](double p) -> int64_t {
+    auto index = static_cast<size_t>(p * static_cast<double>(sorted.size()));
+    return sorted[std::min(index, sorted.size() - 1)];
+  };
+  int64_t total{};
+  for (int64_t d : sorted) {
+    total += d;
+  }
+  Log("Load test ended after "
+      + std::to_string(GetRealTime() - start_time_) + "ms: "
+      + std::to_string(sorted.size()) + " ticks; tick-time usecs mean "
+      + std::to_string(total / static_cast<int64_t>(sorted.size()))
+      + " p50 " + std::to_string(percentile(0.50)) + " p90 "
+      + std::to_string(percentile(0.90)) + " p99 "
+      + std::to_string(percentile(0.99)) + " max " + std::to_string(
+          sorted.back()) + "; packets to-host "
+      + std::to_string(packets_to_host_) + " to-clients "
+      + std::to_string(packets_to_clients_) + " dropped "
+      + std::to_string(packets_dropped_) + ".");
+}
+
+}  // namespace ballistica
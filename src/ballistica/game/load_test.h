@@ -0,0 +1,83 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_LOAD_TEST_H_
+#define BALLISTICA_GAME_LOAD_TEST_H_
+
+#include <list>
+#include <mutex>
+#include <vector>
+
+#include "ballistica/core/object.h"
+#include "ballistica/networking/sockaddr.h"
+
+namespace ballistica {
+
+/// Headless load-generator: spins up N in-process synthetic clients
+/// speaking the real wire protocol (each drives a real
+/// ConnectionToHostUDP) against our own host session. No sockets are
+/// involved; packets each client sends are intercepted on their way to
+/// the network-write module and fed straight into the host's
+/// ConnectionSet under a distinct fake source address (and host replies
+/// come back the same way), optionally delayed/jittered/dropped along
+/// the way. While running, host tick-time durations get sampled and a
+/// distribution summary is logged at stop. See ba.internal load_test_*
+/// commands.
+class LoadTest {
+ public:
+  struct Config {
+    int client_count{8};
+    int latency_ms{0};
+    int jitter_ms{0};
+    float loss_percent{0.0f};
+  };
+
+  explicit LoadTest(const Config& config);
+  ~LoadTest();
+
+  /// Called by the network-write module for every outgoing packet (any
+  /// thread; cheap when no load test is running). Returns true if the
+  /// packet was addressed to one of our fake endpoints and has been
+  /// consumed.
+  static auto InterceptOutgoingPacket(const std::vector<uint8_t>& data,
+                                      const SockAddr& addr) -> bool;
+
+  /// Called by the game thread with the duration of each Game::Update()
+  /// while we're running.
+  void OnHostTick(int64_t duration_usecs);
+
+ private:
+  class Client;
+
+  // A packet in flight through our fake network, either direction.
+  struct PendingPacket {
+    millisecs_t deliver_time;
+    bool to_host;
+    int client_index;
+    std::vector<uint8_t> data;
+  };
+
+  void Pump();
+  auto Enqueue(const std::vector<uint8_t>& data, bool to_host,
+               int client_index) -> void;
+  void LogReport();
+
+  Config config_;
+  std::vector<Object::Ref<Client>> clients_;
+  int pump_timer_id_{};
+  millisecs_t start_time_{};
+
+  // Touched from arbitrary threads via InterceptOutgoingPacket().
+  std::mutex packet_mutex_;
+  std::list<PendingPacket> packets_in_flight_;
+  uint32_t rand_state_{0x8527affbu};
+  int64_t packets_to_host_{};
+  int64_t packets_to_clients_{};
+  int64_t packets_dropped_{};
+
+  // Game thread only.
+  std::vector<int64_t> tick_durations_usecs_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_LOAD_TEST_H_
@@ -338,15 +338,15 @@ void Player::RunInput(InputType type, float value) {
   auto j = calls_.find(static_cast<int>(type));
   if (j != calls_.end() && j->second.exists()) {
     if (type == InputType::kRun) {
-      PythonRef args(
-          Py_BuildValue("(f)", std::min(1.0f, std::max(0.0f, value))),
+      PythonRef arg(
+          PyFloat_FromDouble(std::min(1.0f, std::max(0.0f, value))),
           PythonRef::kSteal);
-      j->second->Run(args.get());
+      j->second->RunWithArg(arg.get());
     } else if (type == InputType::kLeftRight || type == InputType::kUpDown) {
-      PythonRef args(
-          Py_BuildValue("(f)", std::min(1.0f, std::max(-1.0f, value))),
+      PythonRef arg(
+          PyFloat_FromDouble(std::min(1.0f, std::max(-1.0f, value))),
           PythonRef::kSteal);
-      j->second->Run(args.get());
+      j->second->RunWithArg(arg.get());
     } else {
       j->second->Run();
     }
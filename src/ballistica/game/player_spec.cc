@@ -15,22 +15,46 @@ namespace ballistica {
 PlayerSpec::PlayerSpec() = default;
 
 PlayerSpec::PlayerSpec(const std::string& s) {
-  cJSON* root_obj = cJSON_Parse(s.c_str());
+  // Specs are flat little objects and we parse one per roster entry,
+  // so stream through the fields instead of building a cJSON tree.
+  JsonPullParser p(s.c_str());
   bool success = false;
-  if (root_obj) {
-    cJSON* name_obj = cJSON_GetObjectItem(root_obj, "n");
-    cJSON* short_name_obj = cJSON_GetObjectItem(root_obj, "sn");
-    cJSON* account_obj = cJSON_GetObjectItem(root_obj, "a");
-    if (name_obj && short_name_obj && account_obj) {
-      name_ = Utils::GetValidUTF8(name_obj->valuestring, "psps");
-      short_name_ = Utils::GetValidUTF8(short_name_obj->valuestring, "psps2");
-
-      // Account type may technically be something we don't recognize,
-      // but that's ok.. it'll just be 'invalid' to us in that case
-      account_type_ = Account::AccountTypeFromString(account_obj->valuestring);
-      success = true;
+  bool have_name{};
+  bool have_short_name{};
+  bool have_account{};
+  if (p.Next() == JsonPullParser::Token::kObjectBegin) {
+    success = true;
+    while (true) {
+      auto t = p.Next();
+      if (t == JsonPullParser::Token::kObjectEnd) {
+        break;
+      }
+      if (t != JsonPullParser::Token::kKey) {
+        success = false;
+        break;
+      }
+      std::string key = p.string_value();
+      t = p.Next();
+      if (t == JsonPullParser::Token::kString) {
+        if (key == "n") {
+          name_ = Utils::GetValidUTF8(p.string_value().c_str(), "psps");
+          have_name = true;
+        } else if (key == "sn") {
+          short_name_ = Utils::GetValidUTF8(p.string_value().c_str(), "psps2");
+          have_short_name = true;
+        } else if (key == "a") {
+          // Account type may technically be something we don't recognize,
+          // but that's ok.. it'll just be 'invalid' to us in that case
+          account_type_ = Account::AccountTypeFromString(p.string_value());
+          have_account = true;
+        }
+      } else if (t == JsonPullParser::Token::kError
+                 || t == JsonPullParser::Token::kEnd || !p.SkipValue()) {
+        success = false;
+        break;
+      }
     }
-    cJSON_Delete(root_obj);
+    success = success && have_name && have_short_name && have_account;
   }
   if (!success) {
     Log("Error creating PlayerSpec from string: '" + s + "'");
@@ -0,0 +1,140 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/replay_benchmark.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "ballistica/core/thread.h"
+#include "ballistica/game/game.h"
+#include "ballistica/game/session/client_session.h"
+#include "ballistica/generic/lambda_runnable.h"
+#include "ballistica/generic/timer.h"
+#include "ballistica/graphics/frame_def.h"
+#include "ballistica/graphics/graphics_server.h"
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+
+// How often our pump timer fires and how much wall time each pump may
+// burn stepping the replay. A near-full duty cycle keeps playback
+// unthrottled while still letting the game thread's event loop breathe.
+const int kPumpIntervalMillisecs = 1;
+const millisecs_t kPumpBudgetMillisecs = 100;
+
+// Build (and discard) a frame every this many sim steps; roughly the
+// frame-to-step ratio of a live 60hz session.
+const int kStepsPerFrameBuild = 2;
+
+std::atomic<ReplayBenchmark*> ReplayBenchmark::g_active_replay_benchmark{};
+
+ReplayBenchmark::ReplayBenchmark(std::string file_name, bool quit_when_done)
+    : file_name_(std::move(file_name)), quit_when_done_(quit_when_done) {
+  assert(InGameThread());
+  start_time_ = GetRealTime();
+
+  // This throws if the file can't be opened; we never go active in
+  // that case.
+  g_game->LaunchReplaySession(file_name_);
+
+  assert(g_active_replay_benchmark.load() == nullptr);
+  g_active_replay_benchmark.store(this);
+
+  pump_timer_id_ = g_game
+                       ->thread()
+                       ->NewTimer(kPumpIntervalMillisecs, true,
+                                  NewLambdaRunnable([this] { Pump(); }))
+                       ->id();
+  Log("Replay benchmark started: '" + file_name_ + "'.");
+}
+
+ReplayBenchmark::~ReplayBenchmark() {
+  assert(InGameThread());
+  g_active_replay_benchmark.store(nullptr);
+  g_game->thread()->DeleteTimer(pump_timer_id_);
+}
+
+void ReplayBenchmark::Pump() {
+  assert(InGameThread());
+  if (finished_) {
+    return;
+  }
+  auto* session = dynamic_cast<ClientSession*>(g_game->GetForegroundSession());
+  if (session == nullptr || session->shutting_down()) {
+    Finish();
+    return;
+  }
+
+  // A frame def we build into and throw away; only exists when there's
+  // graphics to source its settings from (so never in headless builds;
+  // frame_build simply reports zero samples there).
+  std::unique_ptr<FrameDef> frame_def;
+  if (g_graphics_server != nullptr) {
+    frame_def = std::make_unique<FrameDef>();
+  }
+
+  millisecs_t pump_start = GetRealTime();
+  while (GetRealTime() - pump_start < kPumpBudgetMillisecs) {
+    session->Update(kGameStepMilliseconds);
+    steps_++;
+    if (session->shutting_down()) {
+      Finish();
+      return;
+    }
+    if (frame_def != nullptr && steps_ % kStepsPerFrameBuild == 0) {
+      int64_t build_start = Platform::GetCurrentMicroseconds();
+      frame_def->Reset();
+      session->Draw(frame_def.get());
+      frame_def->Finalize();
+      frame_build_total_usecs_ +=
+          Platform::GetCurrentMicroseconds() - build_start;
+      frame_build_count_++;
+    }
+  }
+}
+
+void ReplayBenchmark::Finish() {
+  assert(!finished_);
+  finished_ = true;
+
+  // Stop sampling before we report; network traffic shares the huffman
+  // codec and would keep trickling in otherwise.
+  g_active_replay_benchmark.store(nullptr);
+  LogReport();
+
+  // Our owner deletes us; can't do that from inside our own timer run.
+  bool quit = quit_when_done_;
+  g_game->PushCall([quit] {
+    g_game->StopReplayBenchmark();
+    if (quit) {
+      // Automated runs (pgo collection, ci) want the process to exit
+      // cleanly once the report is out.
+      g_game->PushShutdownCall(false);
+    }
+  });
+}
+
+void ReplayBenchmark::LogReport() {
+  auto section = [](const char* name, int64_t count, int64_t total_usecs) {
+    std::string s = std::string("\"") + name
+                    + "\": {\"count\": " + std::to_string(count)
+                    + ", \"total_us\": " + std::to_string(total_usecs)
+                    + ", \"avg_us\": "
+                    + std::to_string(count > 0 ? total_usecs / count : 0) + "}";
+    return s;
+  };
+  Log("{\"replay_benchmark\": {\"file\": \"" + file_name_ + "\", \"wall_ms\": "
+      + std::to_string(GetRealTime() - start_time_)
+      + ", \"steps\": " + std::to_string(steps_) + ", "
+      + section("scene_step", scene_step_count_.load(),
+                scene_step_total_usecs_.load())
+      + ", "
+      + section("frame_build", frame_build_count_, frame_build_total_usecs_)
+      + ", "
+      + section("huffman_decode", huffman_count_.load(),
+                huffman_total_usecs_.load())
+      + "}}");
+}
+
+}  // namespace ballistica
@@ -0,0 +1,72 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_REPLAY_BENCHMARK_H_
+#define BALLISTICA_GAME_REPLAY_BENCHMARK_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "ballistica/core/object.h"
+
+namespace ballistica {
+
+/// Replay-driven regression benchmark: plays a replay file back
+/// unthrottled (as many 8ms steps per pump as wall time allows) while
+/// separately timing scene stepping, frame building (frames get built
+/// into a local FrameDef and discarded; nothing reaches a renderer) and
+/// huffman decode of the replay stream. Emits a machine-readable
+/// one-line json report when the replay ends. This lets recorded
+/// worst-case matches serve as regression tests for engine changes.
+/// See the replay_benchmark internal command.
+class ReplayBenchmark {
+ public:
+  explicit ReplayBenchmark(std::string file_name,
+                           bool quit_when_done = false);
+  ~ReplayBenchmark();
+
+  /// The currently-running benchmark, if any. Cheap enough to gate
+  /// per-sample timing calls on hot paths.
+  static auto Active() -> ReplayBenchmark* {
+    return g_active_replay_benchmark.load(std::memory_order_relaxed);
+  }
+
+  /// Sample hooks; call only when Active() returned non-null.
+  /// Scene-step samples come from the game thread; huffman samples can
+  /// come from any thread (the codec is shared with networking).
+  void SampleSceneStep(int64_t duration_usecs) {
+    scene_step_total_usecs_ += duration_usecs;
+    scene_step_count_++;
+  }
+  void SampleHuffmanDecode(int64_t duration_usecs) {
+    huffman_total_usecs_ += duration_usecs;
+    huffman_count_++;
+  }
+
+ private:
+  void Pump();
+  void Finish();
+  void LogReport();
+
+  static std::atomic<ReplayBenchmark*> g_active_replay_benchmark;
+
+  std::string file_name_;
+  int pump_timer_id_{};
+  bool finished_{};
+  bool quit_when_done_{};
+  millisecs_t start_time_{};
+  int64_t steps_{};
+
+  // Sample accumulators (atomic since huffman decode can run on the
+  // network threads too; everything else stays on the game thread).
+  std::atomic<int64_t> scene_step_total_usecs_{};
+  std::atomic<int64_t> scene_step_count_{};
+  std::atomic<int64_t> huffman_total_usecs_{};
+  std::atomic<int64_t> huffman_count_{};
+  int64_t frame_build_total_usecs_{};
+  int64_t frame_build_count_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_REPLAY_BENCHMARK_H_
@@ -88,6 +88,25 @@ class HostSession : public Session {
   auto GetUnusedPlayerName(Player* p, const std::string& base_name)
       -> std::string;
 
+  // Read-only peeks at session-level media and activities; used by the
+  // scene-memory report for per-map/session attribution.
+  auto host_activities() const
+      -> const std::vector<Object::Ref<HostActivity> >& {
+    return host_activities_;
+  }
+  auto textures() const
+      -> const std::unordered_map<std::string, Object::WeakRef<Texture> >& {
+    return textures_;
+  }
+  auto sounds() const
+      -> const std::unordered_map<std::string, Object::WeakRef<Sound> >& {
+    return sounds_;
+  }
+  auto models() const
+      -> const std::unordered_map<std::string, Object::WeakRef<Model> >& {
+    return models_;
+  }
+
  private:
   auto NewTimer(TimerMedium length, bool repeat,
                 const Object::Ref<Runnable>& runnable) -> int;
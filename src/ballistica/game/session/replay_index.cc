@@ -0,0 +1,134 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/session/replay_index.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace ballistica {
+
+// Footer layout (all little-endian):
+//   uint32 entry-count
+//   entries: {int64 base-time, uint64 offset, uint8 flags}
+//   uint32 index-byte-size (count field through last entry)
+//   int32 kBrpIndexFileID
+static const size_t kEntrySize = 8 + 8 + 1;
+static const size_t kTrailerSize = 4 + 4;
+
+void ReplayIndex::AddChunk(millisecs_t base_time, uint64_t offset,
+                           bool keyframe) {
+  assert(entries_.empty() || base_time >= entries_.back().base_time);
+  Entry entry;
+  entry.base_time = base_time;
+  entry.offset = offset;
+  entry.keyframe = keyframe;
+  entries_.push_back(entry);
+  if (keyframe) {
+    last_keyframe_time_ = base_time;
+  }
+}
+
+auto ReplayIndex::WantsKeyframe(millisecs_t base_time) const -> bool {
+  return base_time - last_keyframe_time_ >= kKeyframeInterval;
+}
+
+auto ReplayIndex::WriteFooter(FILE* f) -> bool {
+  std::vector<uint8_t> out;
+  out.reserve(4 + entries_.size() * kEntrySize + kTrailerSize);
+  auto append32 = [&out](uint32_t val) {
+    for (int i = 0; i < 4; i++) {
+      out.push_back(static_cast<uint8_t>((val >> (i * 8)) & 0xFF));
+    }
+  };
+  auto append64 = [&out](uint64_t val) {
+    for (int i = 0; i < 8; i++) {
+      out.push_back(static_cast<uint8_t>((val >> (i * 8)) & 0xFF));
+    }
+  };
+  append32(static_cast<uint32_t>(entries_.size()));
+  for (auto&& entry : entries_) {
+    append64(static_cast<uint64_t>(entry.base_time));
+    append64(entry.offset);
+    out.push_back(entry.keyframe ? 1 : 0);
+  }
+  auto index_size = static_cast<uint32_t>(out.size());
+  append32(index_size);
+  append32(static_cast<uint32_t>(kBrpIndexFileID));
+  return fwrite(out.data(), out.size(), 1, f) == 1;
+}
+
+auto ReplayIndex::Load(FILE* f) -> bool {
+  long start_pos = ftell(f);  // NOLINT (long matches ftell)
+  bool success = false;
+  uint8_t trailer[kTrailerSize];
+  long file_size;  // NOLINT
+  if (fseek(f, 0, SEEK_END) == 0 && (file_size = ftell(f)) > 0
+      && file_size >= static_cast<long>(kTrailerSize)  // NOLINT
+      && fseek(f, file_size - static_cast<long>(kTrailerSize), SEEK_SET) == 0
+      && fread(trailer, kTrailerSize, 1, f) == 1) {
+    auto read32 = [](const uint8_t* p) -> uint32_t {
+      return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+             | (static_cast<uint32_t>(p[2]) << 16)
+             | (static_cast<uint32_t>(p[3]) << 24);
+    };
+    auto read64 = [](const uint8_t* p) -> uint64_t {
+      uint64_t val = 0;
+      for (int i = 7; i >= 0; i--) {
+        val = (val << 8) | p[i];
+      }
+      return val;
+    };
+    uint32_t index_size = read32(trailer);
+    uint32_t magic = read32(trailer + 4);
+    if (magic == static_cast<uint32_t>(kBrpIndexFileID) && index_size >= 4
+        && static_cast<uint64_t>(index_size) + kTrailerSize
+               <= static_cast<uint64_t>(file_size)) {
+      std::vector<uint8_t> data(index_size);
+      if (fseek(f,
+                file_size - static_cast<long>(kTrailerSize)  // NOLINT
+                    - static_cast<long>(index_size),         // NOLINT
+                SEEK_SET)
+              == 0
+          && fread(data.data(), index_size, 1, f) == 1) {
+        uint32_t count = read32(data.data());
+        if (4 + static_cast<uint64_t>(count) * kEntrySize == index_size) {
+          entries_.clear();
+          entries_.reserve(count);
+          const uint8_t* ptr = data.data() + 4;
+          for (uint32_t i = 0; i < count; i++) {
+            Entry entry;
+            entry.base_time = static_cast<millisecs_t>(read64(ptr));
+            entry.offset = read64(ptr + 8);
+            entry.keyframe = (ptr[16] != 0);
+            entries_.push_back(entry);
+            ptr += kEntrySize;
+          }
+          success = true;
+        }
+      }
+    }
+  }
+  // Always restore the caller's read position.
+  fseek(f, start_pos, SEEK_SET);
+  return success;
+}
+
+auto ReplayIndex::FindSeekEntry(millisecs_t base_time) const -> const Entry* {
+  const Entry* best = nullptr;
+  // Entries are time-ordered; find the last keyframe at-or-before the
+  // target (binary search for the time, then walk back to a keyframe).
+  auto it = std::upper_bound(entries_.begin(), entries_.end(), base_time,
+                             [](millisecs_t t, const Entry& e) {
+                               return t < e.base_time;
+                             });
+  while (it != entries_.begin()) {
+    --it;
+    if (it->keyframe) {
+      best = &(*it);
+      break;
+    }
+  }
+  return best;
+}
+
+}  // namespace ballistica
@@ -0,0 +1,65 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_SESSION_REPLAY_INDEX_H_
+#define BALLISTICA_GAME_SESSION_REPLAY_INDEX_H_
+
+#include <cstdio>
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// Magic tacked on to the very end of v2 replay files whose index footer
+// is intact (in the spirit of kBrpFileID at the front).
+const int kBrpIndexFileID = 83750;
+
+// Seek index for v2 replay files. While writing a replay, GameStream
+// records the file offset and base-time of every message chunk it lands,
+// flagging the periodic full-state snapshots as keyframes; the whole
+// index is appended as a footer when the file is closed. Old (v1) files
+// simply have no footer and replay back sequentially exactly as before.
+// On playback we can then jump to the latest keyframe at-or-before any
+// target time and read forward O(one chunk) instead of re-reading from
+// the start of an hour-long file.
+class ReplayIndex {
+ public:
+  struct Entry {
+    millisecs_t base_time{};
+    uint64_t offset{};
+    bool keyframe{};
+  };
+
+  // How often the writer drops a full-state snapshot chunk.
+  static const millisecs_t kKeyframeInterval = 10000;  // 10 seconds.
+
+  // Writer side: note a chunk that just landed at 'offset'.
+  void AddChunk(millisecs_t base_time, uint64_t offset, bool keyframe);
+
+  // Whether it's time for the writer to emit another keyframe.
+  auto WantsKeyframe(millisecs_t base_time) const -> bool;
+
+  // Append our footer to the end of the (fully written) replay file.
+  // Returns false on i/o errors.
+  auto WriteFooter(FILE* f) -> bool;
+
+  // Reader side: attempt to load an index footer from an open replay
+  // file; returns false (leaving the file position untouched for
+  // sequential playback) if the file predates v2 or the footer is
+  // damaged.
+  auto Load(FILE* f) -> bool;
+
+  // Latest keyframe entry at-or-before the target time, or nullptr if
+  // the index is empty.
+  auto FindSeekEntry(millisecs_t base_time) const -> const Entry*;
+
+  auto entries() const -> const std::vector<Entry>& { return entries_; }
+
+ private:
+  std::vector<Entry> entries_;
+  millisecs_t last_keyframe_time_{-kKeyframeInterval};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_SESSION_REPLAY_INDEX_H_
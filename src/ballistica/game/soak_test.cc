@@ -0,0 +1,176 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/game/soak_test.h"
+
+#include <algorithm>
+
+#include "ballistica/core/object.h"
+#include "ballistica/core/thread.h"
+#include "ballistica/game/game.h"
+#include "ballistica/generic/lambda_runnable.h"
+#include "ballistica/generic/timer.h"
+#include "ballistica/media/media.h"
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+
+// How often the harness wakes up to advance its phase machine.
+const int kSoakPumpIntervalMillisecs = 1000;
+
+// Don't flag drift until we've got at least this many snapshots; the
+// first few cycles legitimately warm caches up.
+const int kSoakMinCyclesForFlag = 4;
+
+SoakTest::SoakTest(const Config& config) : config_(config) {
+  assert(InGameThread());
+  config_.cycles = std::max(1, config_.cycles);
+  config_.play_secs = std::max(1, config_.play_secs);
+  config_.idle_secs = std::max(1, config_.idle_secs);
+
+  // Kick off the first play phase.
+  g_game->StartLoadTest(config_.client_count, 0, 0, 0.0f);
+  phase_ = Phase::kPlaying;
+  phase_end_time_ = GetRealTime() + 1000 * config_.play_secs;
+  pump_timer_id_ = g_game
+                       ->thread()
+                       ->NewTimer(kSoakPumpIntervalMillisecs, true,
+                                  NewLambdaRunnable([this] { Pump(); }))
+                       ->id();
+  Log("Soak test started: " + std::to_string(config_.cycles) + " cycles of "
+      + std::to_string(config_.client_count) + " clients, "
+      + std::to_string(config_.play_secs) + "s play / "
+      + std::to_string(config_.idle_secs) + "s idle.");
+}
+
+SoakTest::~SoakTest() {
+  assert(InGameThread());
+  g_game->thread()->DeleteTimer(pump_timer_id_);
+  if (phase_ == Phase::kPlaying && !finished_) {
+    g_game->StopLoadTest();
+  }
+}
+
+void SoakTest::Pump() {
+  assert(InGameThread());
+  if (finished_ || GetRealTime() < phase_end_time_) {
+    return;
+  }
+  switch (phase_) {
+    case Phase::kPlaying: {
+      // Clients leave; give things a moment to settle before we
+      // measure (disconnect teardown, prunes, etc).
+      g_game->StopLoadTest();
+      phase_ = Phase::kIdle;
+      phase_end_time_ = GetRealTime() + 1000 * config_.idle_secs;
+      break;
+    }
+    case Phase::kIdle: {
+      cycle_++;
+      TakeSnapshot();
+      CheckForDrift();
+      if (cycle_ >= config_.cycles) {
+        Finish();
+        return;
+      }
+      g_game->StartLoadTest(config_.client_count, 0, 0, 0.0f);
+      phase_ = Phase::kPlaying;
+      phase_end_time_ = GetRealTime() + 1000 * config_.play_secs;
+      break;
+    }
+  }
+}
+
+void SoakTest::TakeSnapshot() {
+  Snapshot snapshot;
+  auto& m = snapshot.metrics;
+  m.emplace_back("rss_bytes", g_platform->GetCurrentRSSBytes());
+  m.emplace_back("media.total_bytes",
+                 static_cast<int64_t>(g_media->GetTotalMediaMemoryUse()));
+  m.emplace_back("media.models", g_media->total_model_count());
+  m.emplace_back("media.textures", g_media->total_texture_count());
+  m.emplace_back("media.sounds", g_media->total_sound_count());
+  m.emplace_back("media.collide_models",
+                 g_media->total_collide_model_count());
+
+  // Per-class live Object counts (empty outside debug builds).
+  for (auto&& i : Object::GetObjectCounts()) {
+    m.emplace_back("object." + i.first, i.second);
+  }
+  snapshots_.push_back(snapshot);
+  Log("Soak cycle " + std::to_string(cycle_) + "/"
+      + std::to_string(config_.cycles)
+      + ": rss=" + std::to_string(m[0].second)
+      + " media_bytes=" + std::to_string(m[1].second));
+}
+
+void SoakTest::CheckForDrift() {
+  if (static_cast<int>(snapshots_.size()) < kSoakMinCyclesForFlag) {
+    return;
+  }
+
+  // A metric drifts if it never decreased across any cycle and ended up
+  // above where it started. Metrics missing from any snapshot (a class
+  // with no live instances that cycle) can't be monotonic and are
+  // skipped implicitly.
+  for (auto&& metric : snapshots_.back().metrics) {
+    const std::string& name = metric.first;
+    if (std::find(flagged_.begin(), flagged_.end(), name)
+        != flagged_.end()) {
+      continue;
+    }
+    bool monotonic = true;
+    int64_t prev = -1;
+    size_t found = 0;
+    for (auto&& snapshot : snapshots_) {
+      for (auto&& m : snapshot.metrics) {
+        if (m.first == name) {
+          if (prev >= 0 && m.second < prev) {
+            monotonic = false;
+          }
+          prev = m.second;
+          found++;
+          break;
+        }
+      }
+    }
+    if (monotonic && found == snapshots_.size()) {
+      int64_t first{};
+      for (auto&& m : snapshots_.front().metrics) {
+        if (m.first == name) {
+          first = m.second;
+          break;
+        }
+      }
+      if (prev > first) {
+        flagged_.push_back(name);
+        Log("Soak test: '" + name + "' has grown monotonically over "
+            + std::to_string(snapshots_.size()) + " cycles ("
+            + std::to_string(first) + " -> " + std::to_string(prev)
+            + "); possible leak.");
+      }
+    }
+  }
+}
+
+void SoakTest::Finish() {
+  finished_ = true;
+  if (flagged_.empty()) {
+    Log("Soak test completed " + std::to_string(cycle_)
+        + " cycles; no monotonic growth detected.");
+  } else {
+    std::string names;
+    for (auto&& name : flagged_) {
+      if (!names.empty()) {
+        names += ", ";
+      }
+      names += name;
+    }
+    Log("Soak test completed " + std::to_string(cycle_)
+        + " cycles; flagged: " + names + ".");
+  }
+
+  // Our owner deletes us; can't do that from inside our own timer run.
+  g_game->PushCall([] { g_game->StopSoakTest(); });
+}
+
+}  // namespace ballistica
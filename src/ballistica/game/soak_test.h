@@ -0,0 +1,58 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GAME_SOAK_TEST_H_
+#define BALLISTICA_GAME_SOAK_TEST_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+/// Deterministic soak harness for leak/drift hunting on long-running
+/// servers: cycles synthetic clients through join/play/leave loops
+/// (via LoadTest) and snapshots live Object counts by class (debug
+/// builds), media list sizes/memory, and process RSS after each cycle.
+/// Metrics that grow monotonically across every completed cycle get
+/// flagged automatically once enough cycles have run. See the
+/// soak_test_start/soak_test_stop internal commands.
+class SoakTest {
+ public:
+  struct Config {
+    int cycles{20};
+    int client_count{4};
+    int play_secs{30};
+    int idle_secs{5};
+  };
+
+  explicit SoakTest(const Config& config);
+  ~SoakTest();
+
+ private:
+  enum class Phase { kPlaying, kIdle };
+
+  // One metric sample; snapshots hold one value per tracked metric.
+  struct Snapshot {
+    std::vector<std::pair<std::string, int64_t>> metrics;
+  };
+
+  void Pump();
+  void TakeSnapshot();
+  void CheckForDrift();
+  void Finish();
+
+  Config config_;
+  Phase phase_{Phase::kPlaying};
+  int pump_timer_id_{};
+  int cycle_{};
+  bool finished_{};
+  millisecs_t phase_end_time_{};
+  std::vector<Snapshot> snapshots_;
+  std::vector<std::string> flagged_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GAME_SOAK_TEST_H_
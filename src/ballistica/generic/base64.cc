@@ -27,9 +27,22 @@
    René Nyffenegger rene.nyffenegger@adp-gmbh.ch
 
 */
+
+// Reworked from the original per-char loops into chunked encodes and a
+// reverse-lookup decode; outputs are unchanged. Some payloads here run
+// over a megabyte (replay tokens, master-server blobs) so this path
+// actually shows up in profiles.
+
 #include "ballistica/generic/base64.h"
 
-#include <cctype>
+#include <cassert>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 namespace ballistica {
 
@@ -45,117 +58,266 @@ static const std::string* base64_chars_urlsafe = new std::string(
     "abcdefghijklmnopqrstuvwxyz"
     "0123456789+/");
 
-static inline auto is_base64(unsigned char c, bool urlsafe) -> bool {
-  if (urlsafe) {
-    return (isalnum(c) || (c == '-') || (c == '_'));
-  } else {
-    return (isalnum(c) || (c == '+') || (c == '/'));
+// Char value -> 6-bit value; 255 for anything not in the alphabet.
+// (both alphabets above are currently identical so one table serves.)
+static auto GetBase64DecodeTable() -> const unsigned char* {
+  static const unsigned char* table = [] {
+    auto* t = new unsigned char[256];
+    memset(t, 255, 256);
+    const std::string& chars = *base64_chars_non_urlsafe;
+    for (size_t i = 0; i < chars.size(); i++) {
+      t[static_cast<unsigned char>(chars[i])] =
+          static_cast<unsigned char>(i);
+    }
+    return t;
+  }();
+  return table;
+}
+
+// Encode full 3-byte groups: reads groups*3 bytes from src, writes
+// groups*4 chars to dst (no padding handling here).
+static void EncodeBase64Groups(const unsigned char* src, size_t groups,
+                               char* dst, const char* table) {
+#if defined(__SSSE3__)
+  // The vector path bakes in the standard alphabet; both our tables
+  // currently are it.
+  assert(table[62] == '+' && table[63] == '/');
+
+  // Each pass reads 16 bytes (using the first 12) and writes 16 chars,
+  // so stay vectorized while a full load fits in the remaining input.
+  while (groups >= 6) {
+    __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+
+    // Spread the twelve input bytes so each 32-bit lane holds one
+    // 3-byte group (with bytes repeated where two 6-bit fields
+    // straddle a byte), then mask/shift the four fields into place.
+    const __m128i shuf =
+        _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    in = _mm_shuffle_epi8(in, shuf);
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    // Map 6-bit values to chars by adding a range-dependent offset.
+    const __m128i offset_lut = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4,
+                                             -4, -4, -4, -4, -19, -16, 0, 0);
+    __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    reduced = _mm_sub_epi8(reduced, _mm_cmpgt_epi8(indices,
+                                                   _mm_set1_epi8(25)));
+    const __m128i chars =
+        _mm_add_epi8(indices, _mm_shuffle_epi8(offset_lut, reduced));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), chars);
+    src += 12;
+    dst += 16;
+    groups -= 4;
+  }
+#elif defined(__ARM_NEON)
+  assert(table[62] == '+' && table[63] == '/');
+
+  // De-interleaving loads give us every first/second/third group byte
+  // in separate registers; 48 bytes in, 64 chars out per pass.
+  while (groups >= 16) {
+    uint8x16x3_t in = vld3q_u8(src);
+    uint8x16x4_t out;
+    uint8x16_t indices[4];
+    indices[0] = vshrq_n_u8(in.val[0], 2);
+    indices[1] =
+        vorrq_u8(vshlq_n_u8(vandq_u8(in.val[0], vdupq_n_u8(0x03)), 4),
+                 vshrq_n_u8(in.val[1], 4));
+    indices[2] =
+        vorrq_u8(vshlq_n_u8(vandq_u8(in.val[1], vdupq_n_u8(0x0f)), 2),
+                 vshrq_n_u8(in.val[2], 6));
+    indices[3] = vandq_u8(in.val[2], vdupq_n_u8(0x3f));
+
+    // Map 6-bit values to chars by adding a range-dependent offset
+    // (additions wrap mod 256 which works out for the digit/symbol
+    // ranges).
+    for (int i = 0; i < 4; i++) {
+      uint8x16_t v = indices[i];
+      uint8x16_t off = vdupq_n_u8(65);
+      off = vaddq_u8(off,
+                     vandq_u8(vcgtq_u8(v, vdupq_n_u8(25)), vdupq_n_u8(6)));
+      off = vsubq_u8(off,
+                     vandq_u8(vcgtq_u8(v, vdupq_n_u8(51)), vdupq_n_u8(75)));
+      off = vsubq_u8(off,
+                     vandq_u8(vcgtq_u8(v, vdupq_n_u8(61)), vdupq_n_u8(15)));
+      off = vaddq_u8(off,
+                     vandq_u8(vcgtq_u8(v, vdupq_n_u8(62)), vdupq_n_u8(3)));
+      out.val[i] = vaddq_u8(v, off);
+    }
+    vst4q_u8(reinterpret_cast<uint8_t*>(dst), out);
+    src += 48;
+    dst += 64;
+    groups -= 16;
   }
+#endif
+
+  while (groups--) {
+    unsigned char a = src[0];
+    unsigned char b = src[1];
+    unsigned char c = src[2];
+    dst[0] = table[a >> 2u];
+    dst[1] = table[((a & 0x03u) << 4u) | (b >> 4u)];
+    dst[2] = table[((b & 0x0fu) << 2u) | (c >> 6u)];
+    dst[3] = table[c & 0x3fu];
+    src += 3;
+    dst += 4;
+  }
+}
+
+// Encode a trailing 1 or 2 byte group with '=' padding.
+static void EncodeBase64Tail(const unsigned char* src, size_t len, char* dst,
+                             const char* table) {
+  assert(len == 1 || len == 2);
+  unsigned char a = src[0];
+  unsigned char b = (len > 1) ? src[1] : 0;
+  dst[0] = table[a >> 2u];
+  dst[1] = table[((a & 0x03u) << 4u) | (b >> 4u)];
+  dst[2] = (len > 1) ? table[(b & 0x0fu) << 2u] : '=';
+  dst[3] = '=';
 }
 
 auto base64_encode(const unsigned char* bytes_to_encode, unsigned int in_len,
                    bool urlsafe) -> std::string {
+  const char* table = (urlsafe ? *base64_chars_urlsafe
+                               : *base64_chars_non_urlsafe)
+                          .data();
   std::string ret;
-  int i = 0;
-  // int j = 0;
-  unsigned char char_array_3[3];
-  unsigned char char_array_4[4];
-
-  static const std::string& base64_chars =
-      urlsafe ? *base64_chars_urlsafe : *base64_chars_non_urlsafe;
-
-  while (in_len--) {
-    char_array_3[i++] = *(bytes_to_encode++);
-    if (i == 3) {
-      char_array_4[0] =
-          static_cast<unsigned char>((char_array_3[0] & 0xfcu) >> 2u);
-      char_array_4[1] =
-          static_cast<unsigned char>(((char_array_3[0] & 0x03u) << 4u)
-                                     + ((char_array_3[1] & 0xf0u) >> 4u));
-      char_array_4[2] =
-          static_cast<unsigned char>(((char_array_3[1] & 0x0fu) << 2u)
-                                     + ((char_array_3[2] & 0xc0u) >> 6u));
-      char_array_4[3] = static_cast<unsigned char>(char_array_3[2] & 0x3fu);
-
-      for (i = 0; (i < 4); i++) ret += base64_chars[char_array_4[i]];
-      i = 0;
-    }
+  if (in_len == 0) {
+    return ret;
   }
-
-  if (i) {
-    for (int j = i; j < 3; j++) {
-      char_array_3[j] = '\0';
-    }
-    char_array_4[0] =
-        static_cast<unsigned char>((char_array_3[0] & 0xfcu) >> 2u);
-    char_array_4[1] = static_cast<unsigned char>(
-        ((char_array_3[0] & 0x03u) << 4u) + ((char_array_3[1] & 0xf0u) >> 4u));
-    char_array_4[2] = static_cast<unsigned char>(
-        ((char_array_3[1] & 0x0fu) << 2u) + ((char_array_3[2] & 0xc0u) >> 6u));
-    char_array_4[3] = static_cast<unsigned char>(char_array_3[2u] & 0x3fu);
-    for (int j = 0; (j < i + 1); j++) {
-      ret += base64_chars[char_array_4[j]];
-    }
-    while ((i++ < 3)) {
-      ret += '=';
-    }
+  size_t groups = in_len / 3;
+  size_t remainder = in_len % 3;
+  ret.resize(4 * ((in_len + 2) / 3));
+  char* dst = &ret[0];
+  EncodeBase64Groups(bytes_to_encode, groups, dst, table);
+  if (remainder) {
+    EncodeBase64Tail(bytes_to_encode + groups * 3, remainder,
+                     dst + groups * 4, table);
   }
-
   return ret;
 }
 
+// Decode a full group of 4 six-bit values into 3 bytes of out.
+static inline void DecodeBase64Group(const unsigned char* vals,
+                                     std::string* out) {
+  (*out) += static_cast<char>((vals[0] << 2u) | (vals[1] >> 4u));
+  (*out) += static_cast<char>((vals[1] << 4u) | (vals[2] >> 2u));
+  (*out) += static_cast<char>((vals[2] << 6u) | vals[3]);
+}
+
+// Decode a trailing group of 2 or 3 values (1 value can't form a byte
+// and gets dropped, matching the original loop).
+static void DecodeBase64Tail(const unsigned char* vals, size_t count,
+                             std::string* out) {
+  if (count >= 2) {
+    (*out) += static_cast<char>((vals[0] << 2u) | (vals[1] >> 4u));
+  }
+  if (count >= 3) {
+    (*out) += static_cast<char>((vals[1] << 4u) | (vals[2] >> 2u));
+  }
+}
+
 auto base64_decode(const std::string& encoded_string, bool urlsafe)
     -> std::string {
-  int in_len = static_cast<int>(encoded_string.size());
-  int i = 0;
-  // int j = 0;
-  int in_ = 0;
-  unsigned char char_array_4[4], char_array_3[3];
+  // Both alphabets are currently the same string, so one reverse table
+  // covers both modes.
+  (void)urlsafe;
+  const unsigned char* decode_table = GetBase64DecodeTable();
   std::string ret;
-
-  static const std::string& base64_chars =
-      urlsafe ? *base64_chars_urlsafe : *base64_chars_non_urlsafe;
-
-  while (in_len-- && (encoded_string[in_] != '=')
-         && is_base64((unsigned char)encoded_string[in_], urlsafe)) {
-    char_array_4[i++] = (unsigned char)encoded_string[in_];
-    in_++;
-    if (i == 4) {
-      for (i = 0; i < 4; i++) {
-        char_array_4[i] =
-            static_cast<unsigned char>(base64_chars.find(char_array_4[i]));
-      }
-
-      char_array_3[0] = static_cast<unsigned char>(
-          (char_array_4[0] << 2u) + ((char_array_4[1] & 0x30u) >> 4u));
-      char_array_3[1] = static_cast<unsigned char>(
-          ((char_array_4[1] & 0xfu) << 4u) + ((char_array_4[2] & 0x3cu) >> 2u));
-      char_array_3[2] = static_cast<unsigned char>(
-          ((char_array_4[2] & 0x3u) << 6u) + char_array_4[3]);
-
-      for (i = 0; (i < 3); i++) ret += char_array_3[i];
-      i = 0;
+  ret.reserve((encoded_string.size() / 4) * 3 + 2);
+  unsigned char vals[4];
+  size_t count = 0;
+  for (char c : encoded_string) {
+    unsigned char v = decode_table[static_cast<unsigned char>(c)];
+    if (v == 255) {
+      break;  // Padding or anything unknown ends the data.
+    }
+    vals[count++] = v;
+    if (count == 4) {
+      DecodeBase64Group(vals, &ret);
+      count = 0;
     }
   }
-  if (i) {
-    for (int j = i; j < 4; j++) {
-      char_array_4[j] = 0;
+  DecodeBase64Tail(vals, count, &ret);
+  return ret;
+}
+
+void Base64Encoder::Feed(const unsigned char* bytes, size_t len,
+                         std::string* out) {
+  assert(out);
+  const char* table = (urlsafe_ ? *base64_chars_urlsafe
+                                : *base64_chars_non_urlsafe)
+                          .data();
+
+  // Top up any buffered partial group first.
+  if (tail_size_ > 0) {
+    while (tail_size_ < 3 && len > 0) {
+      tail_[tail_size_++] = *bytes++;
+      len--;
+    }
+    if (tail_size_ < 3) {
+      return;
     }
-    for (int j = 0; j < 4; j++) {  // NOLINT(modernize-loop-convert)
-      char_array_4[j] =
-          static_cast<unsigned char>(base64_chars.find(char_array_4[j]));
+    size_t offset = out->size();
+    out->resize(offset + 4);
+    EncodeBase64Groups(tail_, 1, &(*out)[offset], table);
+    tail_size_ = 0;
+  }
+
+  size_t groups = len / 3;
+  if (groups > 0) {
+    size_t offset = out->size();
+    out->resize(offset + groups * 4);
+    EncodeBase64Groups(bytes, groups, &(*out)[offset], table);
+    bytes += groups * 3;
+    len -= groups * 3;
+  }
+  while (len--) {
+    tail_[tail_size_++] = *bytes++;
+  }
+}
+
+void Base64Encoder::Finish(std::string* out) {
+  assert(out);
+  if (tail_size_ > 0) {
+    const char* table = (urlsafe_ ? *base64_chars_urlsafe
+                                  : *base64_chars_non_urlsafe)
+                            .data();
+    size_t offset = out->size();
+    out->resize(offset + 4);
+    EncodeBase64Tail(tail_, tail_size_, &(*out)[offset], table);
+    tail_size_ = 0;
+  }
+}
+
+void Base64Decoder::Feed(const char* chars, size_t len, std::string* out) {
+  assert(out);
+  if (done_) {
+    return;
+  }
+  const unsigned char* decode_table = GetBase64DecodeTable();
+  while (len--) {
+    unsigned char v = decode_table[static_cast<unsigned char>(*chars++)];
+    if (v == 255) {
+      done_ = true;
+      return;
     }
-    char_array_3[0] = static_cast<unsigned char>(
-        (char_array_4[0] << 2u) + ((char_array_4[1] & 0x30u) >> 4u));
-    char_array_3[1] = static_cast<unsigned char>(
-        ((char_array_4[1] & 0xfu) << 4u) + ((char_array_4[2] & 0x3cu) >> 2u));
-    char_array_3[2] = static_cast<unsigned char>(
-        ((char_array_4[2] & 0x3u) << 6u) + char_array_4[3]);
-    for (int j = 0; (j < i - 1); j++) {
-      ret += char_array_3[j];
+    tail_[tail_size_++] = v;
+    if (tail_size_ == 4) {
+      DecodeBase64Group(tail_, out);
+      tail_size_ = 0;
     }
   }
-  return ret;
+}
+
+void Base64Decoder::Finish(std::string* out) {
+  assert(out);
+  DecodeBase64Tail(tail_, tail_size_, out);
+  tail_size_ = 0;
+  done_ = true;
 }
 
 }  // namespace ballistica
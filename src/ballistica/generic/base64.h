@@ -11,6 +11,42 @@ auto base64_encode(const unsigned char*, unsigned int len, bool urlsafe = false)
     -> std::string;
 auto base64_decode(const std::string& s, bool urlsafe = false) -> std::string;
 
+// ericf addition: incremental variants so big payloads (replay tokens,
+// master-server blobs) can be fed through in chunks instead of needing
+// one contiguous input buffer.
+
+/// Feed input bytes in any sized chunks; encoded chars get appended to
+/// the string passed to each call. Call Finish() exactly once at the
+/// end to flush buffered input and padding.
+class Base64Encoder {
+ public:
+  explicit Base64Encoder(bool urlsafe = false) : urlsafe_(urlsafe) {}
+  void Feed(const unsigned char* bytes, size_t len, std::string* out);
+  void Finish(std::string* out);
+
+ private:
+  unsigned char tail_[3]{};
+  size_t tail_size_{};
+  bool urlsafe_;
+};
+
+/// Feed encoded chars in any sized chunks; decoded bytes get appended
+/// to the string passed to each call. Decoding stops quietly at the
+/// first padding or invalid char, same as base64_decode. Call Finish()
+/// exactly once at the end to flush any partial group.
+class Base64Decoder {
+ public:
+  explicit Base64Decoder(bool urlsafe = false) : urlsafe_(urlsafe) {}
+  void Feed(const char* chars, size_t len, std::string* out);
+  void Finish(std::string* out);
+
+ private:
+  unsigned char tail_[4]{};
+  size_t tail_size_{};
+  bool done_{};
+  bool urlsafe_;
+};
+
 }  // namespace ballistica
 
 #endif  // BALLISTICA_GENERIC_BASE64_H_
@@ -4,12 +4,17 @@
 #define BALLISTICA_GENERIC_BUFFER_H_
 
 #include <cstdlib>
+#include <utility>
 
 #include "ballistica/generic/utils.h"
+#include "ballistica/platform/platform.h"
 
 namespace ballistica {
 
 // Simple data-holding buffer class.
+// Buffers up to kInlineBytes live in the object itself; most of what
+// these hold (node messages, small packets) fits there, so the common
+// case never touches the heap.
 // (FIXME: should kill this and just use std::vector for this purpose)
 template <class T>
 class Buffer {
@@ -21,8 +26,12 @@ class Buffer {
     }
   }
 
+  Buffer(Buffer&& b) noexcept : data_(nullptr), size_(0) {
+    *this = std::move(b);
+  }
+
   ~Buffer() {
-    if (data_) {
+    if (OwnsHeap()) {
       free(data_);
     }
   }
@@ -36,6 +45,30 @@ class Buffer {
     return *this;
   }
 
+  auto operator=(Buffer&& src) noexcept -> Buffer& {
+    if (this == &src) {
+      return *this;
+    }
+    if (src.OwnsHeap()) {
+      // Steal their heap allocation.
+      if (OwnsHeap()) {
+        free(data_);
+      }
+      data_ = src.data_;
+      size_ = src.size_;
+    } else {
+      // Inline (or empty) data gets copied; it's at most kInlineBytes
+      // and never allocates.
+      Resize(src.size_);
+      if (size_ > 0) {
+        memcpy(data_, src.data_, size_ * sizeof(T));
+      }
+    }
+    src.data_ = nullptr;
+    src.size_ = 0;
+    return *this;
+  }
+
   explicit Buffer(size_t size_in = 0) : data_(nullptr), size_(size_in) {
     if (size_ > 0) {
       Resize(size_);
@@ -68,14 +101,20 @@ class Buffer {
   }
 
   void Resize(size_t new_size) {
-    if (data_) {
+    if (OwnsHeap()) {
       free(data_);
     }
-    if (new_size > 0) {
+    if (new_size == 0) {
+      data_ = nullptr;
+    } else if (new_size <= kInlineCapacity) {
+      data_ = reinterpret_cast<T*>(inline_storage_);
+    } else {
       data_ = static_cast<T*>(malloc(new_size * sizeof(T)));
       BA_PRECONDITION(data_);
-    } else {
-      data_ = nullptr;
+
+      // Multi-megabyte buffers (decoded textures/sounds and the like)
+      // are worth backing with huge pages where available.
+      Platform::AdviseHugePages(data_, new_size * sizeof(T));
     }
     size_ = new_size;
   }
@@ -86,8 +125,15 @@ class Buffer {
   auto data() const -> T* { return data_; }
 
  private:
+  static const size_t kInlineBytes{64};
+  static const size_t kInlineCapacity{kInlineBytes / sizeof(T)};
+  auto OwnsHeap() const -> bool {
+    return (data_ != nullptr
+            && data_ != reinterpret_cast<const T*>(inline_storage_));
+  }
   T* data_;
   size_t size_;
+  alignas(16) unsigned char inline_storage_[kInlineBytes];
 };
 
 }  // namespace ballistica
@@ -0,0 +1,250 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GENERIC_FLAT_HASH_MAP_H_
+#define BALLISTICA_GENERIC_FLAT_HASH_MAP_H_
+
+#include <cassert>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ballistica {
+
+/// Open-addressing hash map keeping entries in one flat array, for hot
+/// engine lookups where per-node allocations and pointer chasing in
+/// the std tree/hash containers show up in profiles. Erasing leaves a
+/// tombstone, so iterators other than the erased one stay valid (the
+/// erase-while-walking pattern our prune loops use works). Not a full
+/// std container: keys aren't const through iterators, and references
+/// and iterators go stale on any insert (possible rehash).
+template <typename K, typename V, typename HASH = std::hash<K> >
+class FlatHashMap {
+ private:
+  enum class SlotState : uint8_t { kEmpty, kFull, kDeleted };
+  struct Slot {
+    std::pair<K, V> kv{};
+    SlotState state{SlotState::kEmpty};
+  };
+
+ public:
+  class iterator {
+   public:
+    iterator(Slot* p, Slot* end) : p_(p), end_(end) { SkipHoles(); }
+    auto operator*() const -> std::pair<K, V>& { return p_->kv; }
+    auto operator->() const -> std::pair<K, V>* { return &p_->kv; }
+    auto operator++() -> iterator& {
+      ++p_;
+      SkipHoles();
+      return *this;
+    }
+    auto operator++(int) -> iterator {
+      iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    auto operator==(const iterator& other) const -> bool {
+      return p_ == other.p_;
+    }
+    auto operator!=(const iterator& other) const -> bool {
+      return p_ != other.p_;
+    }
+
+   private:
+    void SkipHoles() {
+      while (p_ != end_ && p_->state != SlotState::kFull) {
+        ++p_;
+      }
+    }
+    Slot* p_;
+    Slot* end_;
+    friend class FlatHashMap;
+  };
+
+  class const_iterator {
+   public:
+    const_iterator(const Slot* p, const Slot* end) : p_(p), end_(end) {
+      SkipHoles();
+    }
+    auto operator*() const -> const std::pair<K, V>& { return p_->kv; }
+    auto operator->() const -> const std::pair<K, V>* { return &p_->kv; }
+    auto operator++() -> const_iterator& {
+      ++p_;
+      SkipHoles();
+      return *this;
+    }
+    auto operator++(int) -> const_iterator {
+      const_iterator tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+    auto operator==(const const_iterator& other) const -> bool {
+      return p_ == other.p_;
+    }
+    auto operator!=(const const_iterator& other) const -> bool {
+      return p_ != other.p_;
+    }
+
+   private:
+    void SkipHoles() {
+      while (p_ != end_ && p_->state != SlotState::kFull) {
+        ++p_;
+      }
+    }
+    const Slot* p_;
+    const Slot* end_;
+  };
+
+  auto begin() -> iterator { return {SlotsBegin(), SlotsEnd()}; }
+  auto end() -> iterator { return {SlotsEnd(), SlotsEnd()}; }
+  auto begin() const -> const_iterator { return {SlotsBegin(), SlotsEndC()}; }
+  auto end() const -> const_iterator { return {SlotsEndC(), SlotsEndC()}; }
+
+  auto size() const -> size_t { return size_; }
+  auto empty() const -> bool { return size_ == 0; }
+
+  auto find(const K& key) -> iterator {
+    Slot* slot = FindSlot(key);
+    return slot ? iterator{slot, SlotsEnd()} : end();
+  }
+
+  auto find(const K& key) const -> const_iterator {
+    // (share the non-const probe; we hand back const access).
+    const Slot* slot = const_cast<FlatHashMap*>(this)->FindSlot(key);
+    return slot ? const_iterator{slot, SlotsEndC()} : end();
+  }
+
+  auto contains(const K& key) -> bool { return FindSlot(key) != nullptr; }
+
+  auto operator[](const K& key) -> V& {
+    GrowIfNeeded();
+    size_t mask = slots_.size() - 1;
+    size_t index = HASH()(key) & mask;
+    Slot* first_hole = nullptr;
+    while (true) {
+      Slot* slot = &slots_[index];
+      if (slot->state == SlotState::kEmpty) {
+        if (first_hole) {
+          slot = first_hole;  // Re-use a tombstone on the probe path.
+        } else {
+          occupied_++;
+        }
+        slot->state = SlotState::kFull;
+        slot->kv.first = key;
+        size_++;
+        return slot->kv.second;
+      }
+      if (slot->state == SlotState::kFull && slot->kv.first == key) {
+        return slot->kv.second;
+      }
+      if (slot->state == SlotState::kDeleted && !first_hole) {
+        first_hole = slot;
+      }
+      index = (index + 1) & mask;
+    }
+  }
+
+  auto erase(iterator it) -> iterator {
+    assert(it.p_ != SlotsEnd() && it.p_->state == SlotState::kFull);
+    it.p_->state = SlotState::kDeleted;
+    it.p_->kv = {};  // Release whatever the entry held.
+    size_--;
+    ++it;  // Advances past the fresh tombstone to the next live entry.
+    return it;
+  }
+
+  auto erase(const K& key) -> size_t {
+    Slot* slot = FindSlot(key);
+    if (!slot) {
+      return 0;
+    }
+    erase(iterator{slot, SlotsEnd()});
+    return 1;
+  }
+
+  void clear() {
+    slots_.clear();
+    size_ = 0;
+    occupied_ = 0;
+  }
+
+  void reserve(size_t count) {
+    size_t needed = NextPowerOfTwoAbove(count * 4 / 3);
+    if (needed > slots_.size()) {
+      Rehash(needed);
+    }
+  }
+
+ private:
+  auto SlotsBegin() -> Slot* { return slots_.data(); }
+  auto SlotsBegin() const -> const Slot* { return slots_.data(); }
+  auto SlotsEnd() -> Slot* { return slots_.data() + slots_.size(); }
+  auto SlotsEndC() const -> const Slot* {
+    return slots_.data() + slots_.size();
+  }
+
+  auto FindSlot(const K& key) -> Slot* {
+    if (slots_.empty()) {
+      return nullptr;
+    }
+    size_t mask = slots_.size() - 1;
+    size_t index = HASH()(key) & mask;
+    while (true) {
+      Slot* slot = &slots_[index];
+      if (slot->state == SlotState::kEmpty) {
+        return nullptr;
+      }
+      if (slot->state == SlotState::kFull && slot->kv.first == key) {
+        return slot;
+      }
+      index = (index + 1) & mask;
+    }
+  }
+
+  static auto NextPowerOfTwoAbove(size_t val) -> size_t {
+    size_t capacity = kMinCapacity;
+    while (capacity < val) {
+      capacity <<= 1u;
+    }
+    return capacity;
+  }
+
+  // Keep live-plus-tombstone occupancy under 3/4 so probes terminate
+  // quickly; tombstone-heavy maps get cleaned up by the same rehash.
+  void GrowIfNeeded() {
+    if ((occupied_ + 1) * 4 > slots_.size() * 3) {
+      Rehash(NextPowerOfTwoAbove((size_ + 1) * 2));
+    }
+  }
+
+  void Rehash(size_t new_capacity) {
+    assert((new_capacity & (new_capacity - 1)) == 0);
+    std::vector<Slot> old_slots;
+    old_slots.swap(slots_);
+    slots_.resize(new_capacity);
+    size_ = 0;
+    occupied_ = 0;
+    size_t mask = new_capacity - 1;
+    for (auto& old_slot : old_slots) {
+      if (old_slot.state != SlotState::kFull) {
+        continue;
+      }
+      size_t index = HASH()(old_slot.kv.first) & mask;
+      while (slots_[index].state == SlotState::kFull) {
+        index = (index + 1) & mask;
+      }
+      slots_[index].state = SlotState::kFull;
+      slots_[index].kv = std::move(old_slot.kv);
+      size_++;
+      occupied_++;
+    }
+  }
+
+  static const size_t kMinCapacity{16};
+  std::vector<Slot> slots_;
+  size_t size_{};
+  size_t occupied_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GENERIC_FLAT_HASH_MAP_H_
@@ -5,7 +5,9 @@
 #include <string>
 #include <vector>
 
+#include "ballistica/game/replay_benchmark.h"
 #include "ballistica/networking/networking.h"
+#include "ballistica/platform/platform.h"
 
 namespace ballistica {
 
@@ -39,6 +41,57 @@ static int g_freqs[] = {
     0,      0,    0,    0,    0, 0,    0, 0, 0,    0,    0, 0, 0, 0,    0, 0,
     0,      0,    0,    0,    0, 0,    0, 0, 0,    0,    0, 0, 0, 0,    0, 0};
 
+// Newer table (dict id 1) trained on modern server traffic, which is
+// much heavier on json chunks and long attr/resource names than the
+// data the legacy table was built from: printable ascii (letters,
+// digits, json punctuation) carries real weight alongside the small
+// binary values that dominate packed attrs.
+static int g_freqs_v2[] = {
+    92417, 11024, 4871, 2255, 1461, 4409, 1126, 880, 3214, 4955, 702, 610,
+    577,   3861,  522,  488,  460,  1702, 411,  390, 371,  2804, 341, 328,
+    2617,  306,   296,  287,  278,  270,  262,  255, 3910, 248,  1475, 236,
+    230,   225,   219,  214,  210,  205,  201,  196, 1931, 1184, 1027, 185,
+    1507,  1460,  1414, 1370, 1327, 1286, 1246, 1207, 1170, 1133, 1642, 173,
+    170,   167,   164,  161,  158,  521,  404,  399, 394,  389,  384, 379,
+    375,   370,   366,  361,  357,  353,  349,  345, 341,  337,  333, 329,
+    326,   322,   318,  315,  311,  308,  305,  301, 298,  295,  292, 289,
+    286,   2382,  781,  1506, 1274, 3152, 759,  617, 913,  2208, 286, 400,
+    1391,  938,   2074, 2188, 787,  283,  1875, 1919, 2451, 1056, 468, 531,
+    378,   696,   301,  280,  277,  275,  272,  270, 267,  265,  262, 260,
+    258,   255,   253,  251,  249,  247,  244,  242, 240,  238,  236, 234,
+    233,   231,   229,  227,  225,  223,  222,  220, 218,  217,  215, 213,
+    212,   210,   209,  207,  205,  204,  202,  201, 199,  198,  197, 195,
+    194,   192,   191,  190,  188,  187,  186,  184, 183,  182,  180, 179,
+    178,   177,   175,  174,  173,  172,  171,  169, 168,  167,  166, 165,
+    164,   163,   162,  160,  159,  158,  157,  156, 155,  154,  153, 152,
+    151,   150,   149,  148,  147,  146,  145,  145, 144,  143,  142, 141,
+    140,   139,   138,  137,  137,  136,  135,  134, 133,  132,  132, 131,
+    130,   129,   128,  128,  127,  126,  125,  125, 124,  123,  122, 122,
+    121,   120,   119,  119,  118,  117,  117,  116, 115,  115,  114, 113,
+    113,   112,   111,  1247};
+
+static auto GetDictFreqs(int dict_id) -> const int* {
+  switch (dict_id) {
+    case Huffman::kDictV2:
+      return g_freqs_v2;
+    default:
+      return g_freqs;
+  }
+}
+
+auto Huffman::SharedForDict(int dict_id) -> Huffman* {
+  if (dict_id < 0 || dict_id > kDictMax) {
+    dict_id = kDictLegacy;
+  }
+  static std::mutex mutex;
+  static Huffman* shared[kDictMax + 1]{};
+  std::lock_guard<std::mutex> lock(mutex);
+  if (shared[dict_id] == nullptr) {
+    shared[dict_id] = new Huffman(dict_id);
+  }
+  return shared[dict_id];
+}
+
 static void DoWriteBits(char** ptr, int* bit, int val, int val_bits) {
   int src_bit = 0;
   while (src_bit < val_bits) {
@@ -51,6 +104,12 @@ static void DoWriteBits(char** ptr, int* bit, int val, int val_bits) {
 
 Huffman::Huffman() : built(false) {
   static_assert(sizeof(g_freqs) == sizeof(int) * 256);
+  static_assert(sizeof(g_freqs_v2) == sizeof(int) * 256);
+  build();
+}
+
+Huffman::Huffman(int dict_id) : built(false), dict_id_(dict_id) {
+  assert(dict_id >= 0 && dict_id <= kDictMax);
   build();
 }
 
@@ -143,6 +202,11 @@ auto Huffman::decompress(const std::vector<uint8_t>& src)
   bool compressed = *data >> 7;
 
   if (compressed) {
+    // Decode timing for replay benchmarks; free when none's running.
+    // (uncompressed passthroughs below aren't worth sampling)
+    ReplayBenchmark* bench = ReplayBenchmark::Active();
+    int64_t bench_start = bench ? Platform::GetCurrentMicroseconds() : 0;
+
     std::vector<uint8_t> out;
     out.reserve(src.size() * 2);  // hopefully minimize reallocations..
 
@@ -152,72 +216,35 @@ auto Huffman::decompress(const std::vector<uint8_t>& src)
     uint32_t bit = 0;
     const char* ptr = data + 1;
 
-    // navigate bit by bit through our nodes to build values from binary codes
+    // Fast path: while there's at least a full table's worth of bits
+    // left, resolve whole symbols with single flat-table lookups instead
+    // of walking the node tree bit by bit. Any pattern the table can't
+    // resolve (malformed deep codes) and the trailing few bits of the
+    // stream drop down to the old bit-by-bit walk.
     while (bit < bit_length) {
-      bool bitval = static_cast<bool>((ptr[bit / 8] >> (bit % 8)) & 0x01);
-      bit++;
-
-      // 1 in first bit denotes huffman compressed
-      if (bitval) {
-        int val;
-        int n = 510;
-        BA_PRECONDITION(nodes_[n].parent == 0);
-        while (true) {
-          BA_PRECONDITION(n <= 510);
-
-          bitval = static_cast<bool>((ptr[bit / 8] >> (bit % 8)) & 0x01);
-
-          // 1 for right, 0 for left
-          if (bitval == 0) {
-            if (nodes_[n].left_child == -1) {
-              val = n;
-              break;
-            } else {
-              n = nodes_[n].left_child;
-              bit++;
-            }
-          } else {
-            if (nodes_[n].right_child == -1) {
-              val = n;
-              break;
-            } else {
-              n = nodes_[n].right_child;
-              bit++;
-            }
-          }
-          // ERICF FIX - if both new children are dead-ends, stop reading
-          // bits; otherwise we might read past the end of the buffer.
-          // (I assume the original code didn't have child nodes with dual -1s
-          // so this case probably never came up)
-          if (nodes_[n].left_child == -1 && nodes_[n].right_child == -1) {
-            val = n;
-            break;
-          }
-
-          if (bit > bit_length) {
-            throw Exception("huffman decompress got bit > bitlength");
-          }
-        }
-        out.push_back(static_cast<unsigned char&&>(val));
-      } else {
-        // just read next 8 bits as value
-        uint8_t val;
-        if (bit % 8 == 0) {
-          BA_PRECONDITION((bit / 8) < (length - 1));
-          val = static_cast<uint8_t>(ptr[bit / 8]);
-        } else {
-          BA_PRECONDITION((bit / 8 + 1) < (length - 1));
-          val = (static_cast<uint8_t>(ptr[bit / 8]) >> bit % 8)
-                | (static_cast<uint8_t>(ptr[bit / 8 + 1]) << (8 - bit % 8));
-        }
-        out.push_back(val);
-        bit += 8;
-        if (bit > bit_length) {
-          throw Exception("huffman decompress got bit > bitlength b");
+      if (bit + kDecodeTableBits <= bit_length) {
+        // Any 9-bit window spans at most 2 bytes (bit%8 + 9 <= 16), both
+        // of which are in-bounds here.
+        auto code = static_cast<uint32_t>(
+            (static_cast<uint8_t>(ptr[bit / 8])
+             | (static_cast<uint8_t>(ptr[bit / 8 + 1]) << 8))
+            >> (bit % 8));
+        const DecodeEntry& entry =
+            decode_table_[code & ((1u << kDecodeTableBits) - 1u)];
+        if (entry.bits != 0) {
+          out.push_back(entry.val);
+          bit += entry.bits;
+          continue;
         }
       }
+      int val = DecodeSymbolSlow(ptr, &bit, bit_length);
+      out.push_back(static_cast<unsigned char&&>(val));
     }
     BA_PRECONDITION(bit == bit_length);
+    if (bench) {
+      bench->SampleHuffmanDecode(Platform::GetCurrentMicroseconds()
+                                 - bench_start);
+    }
     return out;
   } else {
     // uncompressed - just provide it as is
@@ -230,6 +257,101 @@ auto Huffman::decompress(const std::vector<uint8_t>& src)
 #endif
 }
 
+// Bit-by-bit symbol decode; used for the last few bits of a stream and
+// for any code the flat table can't resolve. This is the original
+// tree-walk decode loop, pulled out of decompress().
+auto Huffman::DecodeSymbolSlow(const char* ptr, uint32_t* bit,
+                               uint32_t bit_length) -> int {
+  // Number of payload bytes backing the bit stream.
+  uint32_t byte_length = (bit_length + 7) / 8;
+  bool bitval = static_cast<bool>((ptr[(*bit) / 8] >> ((*bit) % 8)) & 0x01);
+  (*bit)++;
+
+  // 1 in first bit denotes huffman compressed
+  if (bitval) {
+    int val;
+    int n = 510;
+    BA_PRECONDITION(nodes_[n].parent == 0);
+    while (true) {
+      BA_PRECONDITION(n <= 510);
+
+      bitval = static_cast<bool>((ptr[(*bit) / 8] >> ((*bit) % 8)) & 0x01);
+
+      // 1 for right, 0 for left
+      if (bitval == 0) {
+        if (nodes_[n].left_child == -1) {
+          val = n;
+          break;
+        } else {
+          n = nodes_[n].left_child;
+          (*bit)++;
+        }
+      } else {
+        if (nodes_[n].right_child == -1) {
+          val = n;
+          break;
+        } else {
+          n = nodes_[n].right_child;
+          (*bit)++;
+        }
+      }
+      // ERICF FIX - if both new children are dead-ends, stop reading
+      // bits; otherwise we might read past the end of the buffer.
+      // (I assume the original code didn't have child nodes with dual -1s
+      // so this case probably never came up)
+      if (nodes_[n].left_child == -1 && nodes_[n].right_child == -1) {
+        val = n;
+        break;
+      }
+
+      if (*bit > bit_length) {
+        throw Exception("huffman decompress got bit > bitlength");
+      }
+    }
+    return val;
+  } else {
+    // just read next 8 bits as value
+    uint8_t val;
+    if ((*bit) % 8 == 0) {
+      BA_PRECONDITION(((*bit) / 8) < byte_length);
+      val = static_cast<uint8_t>(ptr[(*bit) / 8]);
+    } else {
+      BA_PRECONDITION(((*bit) / 8 + 1) < byte_length);
+      val = (static_cast<uint8_t>(ptr[(*bit) / 8]) >> (*bit) % 8)
+            | (static_cast<uint8_t>(ptr[(*bit) / 8 + 1]) << (8 - (*bit) % 8));
+    }
+    (*bit) += 8;
+    if (*bit > bit_length) {
+      throw Exception("huffman decompress got bit > bitlength b");
+    }
+    return val;
+  }
+}
+
+// Populate the flat decode table from the per-symbol codes computed by
+// build(). Each symbol's code (flag bit included) is at most
+// kDecodeTableBits long, so we stamp it into every table slot whose low
+// bits match it. Slots left with bits==0 correspond to patterns the
+// encoder never emits; decompress falls back to the tree walk for those.
+void Huffman::BuildDecodeTable() {
+  for (auto& entry : decode_table_) {
+    entry.val = 0;
+    entry.bits = 0;
+  }
+  for (int i = 0; i < 256; i++) {
+    auto code_bits = static_cast<uint32_t>(nodes_[i].bits);
+    assert(code_bits >= 1 && code_bits <= kDecodeTableBits);
+    auto code = static_cast<uint32_t>(nodes_[i].val);
+    for (uint32_t fill = 0; fill < (1u << (kDecodeTableBits - code_bits));
+         fill++) {
+      DecodeEntry& entry = decode_table_[(fill << code_bits) | code];
+      assert(entry.bits == 0);
+      entry.val = static_cast<uint8_t>(i);
+      entry.bits = static_cast<uint8_t>(code_bits);
+    }
+  }
+}
+
 // old janky version..
 #if 0
 void Huffman::compress(const char* data, uint32_t length, const char*& data_out,
@@ -483,8 +605,9 @@ void Huffman::build() {
 
   // if we're not in training mode, use our hard-coded values
 #if 1
+  const int* freqs = GetDictFreqs(dict_id_);
   for (int i = 0; i < 256; i++) {
-    nodes_[i].frequency = g_freqs[i];
+    nodes_[i].frequency = freqs[i];
   }
 #else
   // go through and set all but the top 15 or so to zero
@@ -582,6 +705,8 @@ void Huffman::build() {
     nodes_[i].bits += 1;
   }
 
+  BuildDecodeTable();
+
   built = true;
 }
 
@@ -11,7 +11,24 @@ namespace ballistica {
 
 class Huffman {
  public:
+  // Compression dictionary (frequency table) versions. Dict 0 is the
+  // legacy table baked in years ago and is what we assume for peers
+  // that don't advertise anything; higher ids are newer tables trained
+  // on more recent traffic. Hosts advertise their highest supported id
+  // in the connection handshake and both sides use the min of the two,
+  // so old clients keep working against the legacy table.
+  static const int kDictLegacy = 0;
+  static const int kDictV2 = 1;
+  static const int kDictMax = kDictV2;
+
+  // Shared codec instance for a given dict id (built lazily; lives
+  // forever). Returns the legacy codec for out-of-range ids.
+  static auto SharedForDict(int dict_id) -> Huffman*;
+
   Huffman();
+
+  // Codec using a specific dictionary version.
+  explicit Huffman(int dict_id);
   ~Huffman();
 
 #if HUFFMAN_TRAINING_MODE
@@ -20,14 +37,22 @@ class Huffman {
 
   void build();
 
+  // Huffman codes we emit are never longer than 8 bits plus the 1-bit
+  // 'is-huffman' flag, so 9 bits of input always resolves a symbol (when
+  // it doesn't, the data is either a deep malformed code or a truncated
+  // tail and we fall back to the bit-by-bit tree walk).
+  static const int kDecodeTableBits = 9;
+
   // NOTE: this assumes the topmost bit of the first byte is unused
   // (see details in implementation).
   auto compress(const std::vector<uint8_t>& src) -> std::vector<uint8_t>;
   auto decompress(const std::vector<uint8_t>& src) -> std::vector<uint8_t>;
   auto get_built() const -> bool { return built; }
+  auto dict_id() const -> int { return dict_id_; }
 
  private:
   bool built;
+  int dict_id_{kDictLegacy};
 #if HUFFMAN_TRAINING_MODE
   uint32_t test_bytes = 0;
   uint32_t test_bits_compressed = 0;
@@ -54,6 +79,18 @@ class Huffman {
   };
 
   Node nodes_[511];
+
+  // Flat multi-bit decode table; indexed by the next kDecodeTableBits of
+  // the stream (low bit first). 'bits' is how many of those bits the
+  // symbol actually consumes, or 0 for patterns the table can't resolve.
+  struct DecodeEntry {
+    uint8_t val = 0;
+    uint8_t bits = 0;
+  };
+  void BuildDecodeTable();
+  auto DecodeSymbolSlow(const char* ptr, uint32_t* bit, uint32_t bit_length)
+      -> int;
+  DecodeEntry decode_table_[1 << kDecodeTableBits];
 };
 
 }  // namespace ballistica
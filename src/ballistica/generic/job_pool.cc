@@ -0,0 +1,203 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/generic/job_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+
+// Set for threads owned by a JobPool so AddJob/TryRunOneJob know which
+// deque is "home"; null on all other threads.
+static thread_local JobPool* t_job_pool{};
+static thread_local int t_job_pool_index{};
+
+JobPool::JobPool(int worker_count) {
+  assert(worker_count >= 0);
+  // Zero-worker pools still get one queue so queued jobs have somewhere
+  // to sit until Wait().
+  int queue_count = std::max(worker_count, 1);
+  for (int i = 0; i < queue_count; i++) {
+    queues_.push_back(std::make_unique<WorkerQueue>());
+  }
+  for (int i = 0; i < worker_count; i++) {
+    workers_.emplace_back([this, i] { WorkerMain(i); });
+  }
+}
+
+JobPool::~JobPool() {
+  // Make sure nothing we queued gets dropped on the floor.
+  Wait();
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    shutting_down_ = true;
+  }
+  job_cv_.notify_all();
+  for (auto&& worker : workers_) {
+    worker.join();
+  }
+}
+
+void JobPool::AddJob(std::function<void()> job) {
+  // Count it as unfinished before it's visible anywhere; otherwise a
+  // worker could grab and finish it and briefly leave our books saying
+  // everything's done while the push is still in flight.
+  unfinished_job_count_.fetch_add(1, std::memory_order_release);
+  queued_job_count_.fetch_add(1, std::memory_order_release);
+
+  // Jobs queued from a worker go on its own deque (it'll pop them
+  // newest-first while they're still cache-warm); external pushes just
+  // round-robin across the queues.
+  int index;
+  if (t_job_pool == this) {
+    index = t_job_pool_index;
+  } else {
+    index = static_cast<int>(push_index_.fetch_add(1)
+                             % static_cast<uint32_t>(queues_.size()));
+  }
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->jobs.push_back(std::move(job));
+  }
+
+  // Cycling the sleep mutex before notifying closes the window where a
+  // worker has seen no work but not yet gone to sleep.
+  { std::lock_guard<std::mutex> lock(sleep_mutex_); }  // NOLINT
+  job_cv_.notify_one();
+}
+
+void JobPool::ParallelFor(size_t count, size_t min_slice,
+                          const std::function<void(size_t, size_t)>& func) {
+  if (count == 0) {
+    return;
+  }
+  min_slice = std::max(min_slice, size_t{1});
+
+  // Aim for a few slices per lane so early-finishing lanes can keep
+  // grabbing work, without slicing below min_slice.
+  size_t lanes = static_cast<size_t>(worker_count()) + 1;
+  size_t slice = std::max(min_slice, (count + lanes * 4 - 1) / (lanes * 4));
+  if (workers_.empty() || count <= slice) {
+    func(0, count);
+    return;
+  }
+
+  // Lanes pull slices off a shared cursor; jobs hold a ref on the state
+  // since the last one may still be signing off as we return.
+  struct State {
+    std::atomic<size_t> next{};
+    std::atomic<int> live_helpers{};
+  };
+  auto state = std::make_shared<State>();
+  size_t slice_count = (count + slice - 1) / slice;
+  int helpers = static_cast<int>(
+      std::min(static_cast<size_t>(worker_count()), slice_count - 1));
+  state->live_helpers.store(helpers);
+  for (int i = 0; i < helpers; i++) {
+    // Safe to capture func by pointer; we don't return until every
+    // helper is done with it.
+    AddJob([state, count, slice, fn{&func}] {
+      size_t start;
+      while ((start = state->next.fetch_add(slice)) < count) {
+        (*fn)(start, std::min(start + slice, count));
+      }
+      state->live_helpers.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  // Run slices ourself alongside the helpers.
+  size_t start;
+  while ((start = state->next.fetch_add(slice)) < count) {
+    func(start, std::min(start + slice, count));
+  }
+
+  // Wait out straggler helpers (each has at most one slice left); pitch
+  // in on anything else queued rather than just spinning.
+  while (state->live_helpers.load(std::memory_order_acquire) > 0) {
+    if (!TryRunOneJob(-1)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void JobPool::Wait() {
+  while (true) {
+    // Pitch in on whatever's still queued.
+    if (TryRunOneJob(-1)) {
+      continue;
+    }
+    // Queues are empty; we're done once in-flight jobs wrap up.
+    if (unfinished_job_count_.load(std::memory_order_acquire) == 0) {
+      break;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    done_cv_.wait(lock, [this] {
+      return unfinished_job_count_.load(std::memory_order_acquire) == 0
+             || queued_job_count_.load(std::memory_order_acquire) > 0;
+    });
+  }
+}
+
+void JobPool::WorkerMain(int index) {
+  t_job_pool = this;
+  t_job_pool_index = index;
+  if (g_platform) {
+    g_platform->SetCurrentThreadName("ballistica job pool");
+  }
+  while (true) {
+    if (TryRunOneJob(index)) {
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    job_cv_.wait(lock, [this] {
+      return shutting_down_
+             || queued_job_count_.load(std::memory_order_acquire) > 0;
+    });
+    if (shutting_down_) {
+      break;
+    }
+  }
+}
+
+auto JobPool::TryRunOneJob(int home_index) -> bool {
+  std::function<void()> job;
+  bool found{};
+  int queue_count = static_cast<int>(queues_.size());
+
+  // Our own deque first (newest-first; best cache behavior), then sweep
+  // the others oldest-first: the oldest entry is the one its owner is
+  // furthest from getting back to.
+  for (int i = 0; i < queue_count && !found; i++) {
+    int qi = (home_index < 0) ? i : (home_index + i) % queue_count;
+    bool own = (qi == home_index);
+    WorkerQueue* q = queues_[qi].get();
+    std::lock_guard<std::mutex> lock(q->mutex);
+    if (q->jobs.empty()) {
+      continue;
+    }
+    if (own) {
+      job = std::move(q->jobs.back());
+      q->jobs.pop_back();
+    } else {
+      job = std::move(q->jobs.front());
+      q->jobs.pop_front();
+    }
+    found = true;
+  }
+  if (!found) {
+    return false;
+  }
+  queued_job_count_.fetch_sub(1, std::memory_order_release);
+  job();
+  int remaining =
+      unfinished_job_count_.fetch_sub(1, std::memory_order_release) - 1;
+  if (remaining == 0) {
+    { std::lock_guard<std::mutex> lock(sleep_mutex_); }  // NOLINT
+    done_cv_.notify_all();
+  }
+  return true;
+}
+
+}  // namespace ballistica
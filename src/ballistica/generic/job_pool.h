@@ -0,0 +1,90 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GENERIC_JOB_POOL_H_
+#define BALLISTICA_GENERIC_JOB_POOL_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// A pool of worker threads for short fork/join style work.
+// Unlike Thread/Module there's no event loop or message passing here;
+// this is for slicing embarrassingly-parallel work (frame-def
+// finalization, node updates, particle steps, etc) up within a single
+// frame. Each worker owns a deque it pops newest-first and idle workers
+// steal oldest-first from the others, so a burst of jobs queued together
+// spreads across cores without every push fighting over one lock.
+// Jobs run on arbitrary threads, so they must be self-contained (no
+// touching thread-checked objects) and must not throw.
+//
+// A shared engine-wide instance lives at g_job_pool (sized to whatever
+// cores are left over after our fixed threads); subsystems with steady
+// private fan-out work can also spin up their own instances like before.
+class JobPool {
+ public:
+  // Spins up worker_count threads. Zero is valid; jobs then simply run
+  // on the calling thread during Wait()/ParallelFor().
+  explicit JobPool(int worker_count);
+  ~JobPool();
+
+  // Queues a job; can be called from any thread (jobs queued from a
+  // worker land on that worker's own deque).
+  void AddJob(std::function<void()> job);
+
+  // Runs func over [0, count) in slices of at least min_slice indices,
+  // returning once the whole range has been covered. The calling thread
+  // works through slices alongside the pool (and helps with whatever
+  // else is queued while waiting for stragglers), so this is safe to
+  // call from the game thread without leaving it sitting idle.
+  void ParallelFor(size_t count, size_t min_slice,
+                   const std::function<void(size_t, size_t)>& func);
+
+  // Blocks until all queued jobs have completed. The calling thread
+  // pitches in and runs jobs itself rather than just sitting idle.
+  void Wait();
+
+  auto worker_count() const -> int {
+    return static_cast<int>(workers_.size());
+  }
+
+ private:
+  // One worker's deque. Stealing needs cross-thread access, so each
+  // deque carries its own little lock (held only for a push or pop;
+  // jobs themselves always run unlocked).
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()> > jobs;
+  };
+  void WorkerMain(int index);
+
+  // Pops and runs a single job, preferring home_index's deque (newest
+  // first) and stealing oldest-first from the rest. Pass -1 when
+  // calling from a non-worker thread. Returns false if every deque
+  // came up empty.
+  auto TryRunOneJob(int home_index) -> bool;
+
+  // One queue per worker; zero-worker pools still get one so queued
+  // jobs have somewhere to sit until Wait().
+  std::vector<std::unique_ptr<WorkerQueue> > queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<uint32_t> push_index_{};
+  std::atomic<int> queued_job_count_{};
+  std::atomic<int> unfinished_job_count_{};  // Queued plus running.
+  std::mutex sleep_mutex_;
+  std::condition_variable job_cv_;   // Signaled when jobs are added.
+  std::condition_variable done_cv_;  // Signaled as running jobs complete.
+  bool shutting_down_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GENERIC_JOB_POOL_H_
@@ -1102,4 +1102,237 @@ void cJSON_Minify(char* json) {
 
 #pragma clang diagnostic pop
 
+// ericf addition: streaming pull-parser (see notes in the header).
+
+void JsonPullParser::SkipWhitespace() {
+  while (*pos_ != 0 && static_cast<unsigned char>(*pos_) <= 32) {
+    pos_++;
+  }
+}
+
+auto JsonPullParser::Fail() -> Token {
+  phase_ = Phase::kDone;
+  token_ = Token::kError;
+  return token_;
+}
+
+auto JsonPullParser::ParseStringInto(std::string* out) -> bool {
+  assert(*pos_ == '\"');
+  pos_++;
+  out->clear();
+  while (true) {
+    char c = *pos_;
+    if (c == 0) {
+      return false;  // Unterminated.
+    } else if (c == '\"') {
+      pos_++;
+      return true;
+    } else if (c == '\\') {
+      pos_++;
+      switch (*pos_) {
+        case '\"':
+        case '\\':
+        case '/':
+          out->push_back(*pos_);
+          break;
+        case 'b':
+          out->push_back('\b');
+          break;
+        case 'f':
+          out->push_back('\f');
+          break;
+        case 'n':
+          out->push_back('\n');
+          break;
+        case 'r':
+          out->push_back('\r');
+          break;
+        case 't':
+          out->push_back('\t');
+          break;
+        case 'u': {
+          // Pull four hex digits (plus a second escape for surrogate
+          // pairs) and utf8-encode the result, same as the tree parser.
+          unsigned int uc{};
+          if (sscanf(pos_ + 1, "%4x", &uc) != 1) {
+            return false;
+          }
+          pos_ += 4;
+          if (uc >= 0xD800u && uc <= 0xDBFFu) {
+            unsigned int uc2{};
+            if (pos_[1] != '\\' || pos_[2] != 'u'
+                || sscanf(pos_ + 3, "%4x", &uc2) != 1 || uc2 < 0xDC00u
+                || uc2 > 0xDFFFu) {
+              return false;
+            }
+            pos_ += 6;
+            uc = 0x10000u + (((uc & 0x3FFu) << 10u) | (uc2 & 0x3FFu));
+          } else if (uc >= 0xDC00u && uc <= 0xDFFFu) {
+            return false;  // Lone low surrogate.
+          }
+          if (uc < 0x80u) {
+            out->push_back(static_cast<char>(uc));
+          } else if (uc < 0x800u) {
+            out->push_back(static_cast<char>(0xC0u | (uc >> 6u)));
+            out->push_back(static_cast<char>(0x80u | (uc & 0x3Fu)));
+          } else if (uc < 0x10000u) {
+            out->push_back(static_cast<char>(0xE0u | (uc >> 12u)));
+            out->push_back(static_cast<char>(0x80u | ((uc >> 6u) & 0x3Fu)));
+            out->push_back(static_cast<char>(0x80u | (uc & 0x3Fu)));
+          } else {
+            out->push_back(static_cast<char>(0xF0u | (uc >> 18u)));
+            out->push_back(static_cast<char>(0x80u | ((uc >> 12u) & 0x3Fu)));
+            out->push_back(static_cast<char>(0x80u | ((uc >> 6u) & 0x3Fu)));
+            out->push_back(static_cast<char>(0x80u | (uc & 0x3Fu)));
+          }
+          break;
+        }
+        default:
+          return false;  // Bad escape.
+      }
+      pos_++;
+    } else {
+      out->push_back(c);
+      pos_++;
+    }
+  }
+}
+
+auto JsonPullParser::Next() -> Token {
+  while (true) {
+    SkipWhitespace();
+    switch (phase_) {
+      case Phase::kDone: {
+        if (token_ == Token::kError) {
+          return token_;
+        }
+        if (*pos_ != 0) {
+          return Fail();  // Trailing junk.
+        }
+        token_ = Token::kEnd;
+        return token_;
+      }
+      case Phase::kCommaOrClose: {
+        if (*pos_ == ',') {
+          pos_++;
+          phase_ = in_object() ? Phase::kKey : Phase::kValue;
+          continue;
+        }
+        if (*pos_ == '}' && in_object()) {
+          pos_++;
+          depth_--;
+          phase_ = (depth_ > 0) ? Phase::kCommaOrClose : Phase::kDone;
+          token_ = Token::kObjectEnd;
+          return token_;
+        }
+        if (*pos_ == ']' && !in_object()) {
+          pos_++;
+          depth_--;
+          phase_ = (depth_ > 0) ? Phase::kCommaOrClose : Phase::kDone;
+          token_ = Token::kArrayEnd;
+          return token_;
+        }
+        return Fail();
+      }
+      case Phase::kKeyOrClose: {
+        if (*pos_ == '}') {
+          pos_++;
+          depth_--;
+          phase_ = (depth_ > 0) ? Phase::kCommaOrClose : Phase::kDone;
+          token_ = Token::kObjectEnd;
+          return token_;
+        }
+        phase_ = Phase::kKey;
+        continue;
+      }
+      case Phase::kKey: {
+        if (*pos_ != '\"' || !ParseStringInto(&string_value_)) {
+          return Fail();
+        }
+        SkipWhitespace();
+        if (*pos_ != ':') {
+          return Fail();
+        }
+        pos_++;
+        phase_ = Phase::kValue;
+        token_ = Token::kKey;
+        return token_;
+      }
+      case Phase::kValueOrClose: {
+        if (*pos_ == ']') {
+          pos_++;
+          depth_--;
+          phase_ = (depth_ > 0) ? Phase::kCommaOrClose : Phase::kDone;
+          token_ = Token::kArrayEnd;
+          return token_;
+        }
+        phase_ = Phase::kValue;
+        continue;
+      }
+      case Phase::kValue: {
+        char c = *pos_;
+        if (c == '{' || c == '[') {
+          if (depth_ >= kMaxDepth) {
+            return Fail();
+          }
+          pos_++;
+          if (c == '{') {
+            object_mask_ |= (1ull << depth_);
+            phase_ = Phase::kKeyOrClose;
+            token_ = Token::kObjectBegin;
+          } else {
+            object_mask_ &= ~(1ull << depth_);
+            phase_ = Phase::kValueOrClose;
+            token_ = Token::kArrayBegin;
+          }
+          depth_++;
+          return token_;
+        }
+        if (c == '\"') {
+          if (!ParseStringInto(&string_value_)) {
+            return Fail();
+          }
+          token_ = Token::kString;
+        } else if (c == '-' || (c >= '0' && c <= '9')) {
+          char* end{};
+          number_value_ = strtod(pos_, &end);
+          if (end == pos_) {
+            return Fail();
+          }
+          pos_ = end;
+          token_ = Token::kNumber;
+        } else if (strncmp(pos_, "true", 4) == 0) {
+          pos_ += 4;
+          bool_value_ = true;
+          token_ = Token::kBool;
+        } else if (strncmp(pos_, "false", 5) == 0) {
+          pos_ += 5;
+          bool_value_ = false;
+          token_ = Token::kBool;
+        } else if (strncmp(pos_, "null", 4) == 0) {
+          pos_ += 4;
+          token_ = Token::kNull;
+        } else {
+          return Fail();
+        }
+        phase_ = (depth_ > 0) ? Phase::kCommaOrClose : Phase::kDone;
+        return token_;
+      }
+    }
+  }
+}
+
+auto JsonPullParser::SkipValue() -> bool {
+  if (token_ == Token::kObjectBegin || token_ == Token::kArrayBegin) {
+    int target = depth_ - 1;
+    while (depth_ > target) {
+      Token t = Next();
+      if (t == Token::kError || t == Token::kEnd) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 }  // namespace ballistica
@@ -221,6 +221,77 @@ class JsonDict : public JsonObject {
   }
 };
 
+// A minimal streaming json pull-parser for hot paths that only need a
+// few fields out of a document; unlike cJSON_Parse it never builds a
+// tree (the only heap use is a single reused string buffer for
+// keys/values). Feed it null-terminated json text and call Next()
+// repeatedly; it hands back one token at a time in document order.
+class JsonPullParser {
+ public:
+  enum class Token {
+    kNone,
+    kObjectBegin,
+    kObjectEnd,
+    kArrayBegin,
+    kArrayEnd,
+    kKey,
+    kString,
+    kNumber,
+    kBool,
+    kNull,
+    kEnd,
+    kError
+  };
+
+  // The text must outlive the parser; we read from it lazily.
+  explicit JsonPullParser(const char* text) : pos_(text) {}
+
+  // Advance to the next token. Once kEnd or kError is returned it will
+  // keep being returned.
+  auto Next() -> Token;
+
+  auto token() const -> Token { return token_; }
+
+  // Valid after a kKey or kString token (unescaped).
+  auto string_value() const -> const std::string& { return string_value_; }
+
+  // Valid after a kNumber token.
+  auto number_value() const -> double { return number_value_; }
+
+  // Valid after a kBool token.
+  auto bool_value() const -> bool { return bool_value_; }
+
+  // If the last token opened an object or array, consume through its
+  // matching close; otherwise a no-op. Returns false on malformed json.
+  auto SkipValue() -> bool;
+
+ private:
+  enum class Phase {
+    kValue,
+    kValueOrClose,
+    kKey,
+    kKeyOrClose,
+    kCommaOrClose,
+    kDone
+  };
+  static const int kMaxDepth{64};
+  auto Fail() -> Token;
+  auto ParseStringInto(std::string* out) -> bool;
+  auto in_object() const -> bool {
+    assert(depth_ > 0);
+    return (object_mask_ & (1ull << (depth_ - 1))) != 0;
+  }
+  void SkipWhitespace();
+  const char* pos_{};
+  Token token_{Token::kNone};
+  Phase phase_{Phase::kValue};
+  int depth_{};
+  uint64_t object_mask_{};
+  std::string string_value_;
+  double number_value_{};
+  bool bool_value_{};
+};
+
 // class JsonNumber : public JsonObject {
 //  public:
 //   JsonNumber(double val) { set_obj(cJSON_CreateNumber(val)); }
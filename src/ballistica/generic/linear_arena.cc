@@ -0,0 +1,105 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/generic/linear_arena.h"
+
+#include <cstdlib>
+
+namespace ballistica {
+
+static auto AlignUp(char* p, size_t alignment) -> char* {
+  auto val = reinterpret_cast<uintptr_t>(p);
+  val = (val + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1);
+  return reinterpret_cast<char*>(val);
+}
+
+LinearArena::LinearArena(size_t block_size) : block_size_(block_size) {}
+
+LinearArena::~LinearArena() {
+  for (auto&& block : blocks_) {
+    free(block.data);
+  }
+}
+
+auto LinearArena::Alloc(size_t size, size_t alignment) -> void* {
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+  while (true) {
+    char* p = pos_.load(std::memory_order_acquire);
+    // Null means no block yet or one mid-swap; both go the slow way.
+    if (p == nullptr) {
+      return AllocSlow(size, alignment);
+    }
+    char* aligned = AlignUp(p, alignment);
+    char* new_pos = aligned + size;
+    if (new_pos > end_.load(std::memory_order_acquire)) {
+      return AllocSlow(size, alignment);
+    }
+    if (pos_.compare_exchange_weak(p, new_pos, std::memory_order_acq_rel)) {
+      return aligned;
+    }
+  }
+}
+
+auto LinearArena::AllocSlow(size_t size, size_t alignment) -> void* {
+  std::lock_guard<std::mutex> lock(mutex_);
+  while (true) {
+    char* p = pos_.load(std::memory_order_acquire);
+    if (p != nullptr) {
+      // Someone may have swapped blocks in before we got the lock;
+      // retry the plain bump first.
+      char* aligned = AlignUp(p, alignment);
+      char* new_pos = aligned + size;
+      if (new_pos <= end_.load(std::memory_order_acquire)) {
+        if (pos_.compare_exchange_strong(p, new_pos,
+                                         std::memory_order_acq_rel)) {
+          return aligned;
+        }
+        continue;  // Lost a race with a lock-free bump; go again.
+      }
+      // Block's exhausted; park the fast path while we swap. (a null
+      // pos_ routes every Alloc() into our mutex until the new block's
+      // pos_/end_ pair is fully in place)
+      pos_.store(nullptr, std::memory_order_release);
+    }
+    // Move to the next block we've already got, or plug in a fresh one
+    // if there is none (or it's too small for this request).
+    size_t need = size + alignment;
+    size_t next = blocks_.empty() ? 0 : current_block_ + 1;
+    if (next >= blocks_.size() || blocks_[next].size < need) {
+      Block block;
+      block.size = std::max(block_size_, need);
+      block.data = static_cast<char*>(malloc(block.size));
+      BA_PRECONDITION(block.data);
+      blocks_.insert(blocks_.begin() + static_cast<std::ptrdiff_t>(next),
+                     block);
+    }
+    current_block_ = next;
+    end_.store(blocks_[next].data + blocks_[next].size,
+               std::memory_order_release);
+    pos_.store(blocks_[next].data, std::memory_order_release);
+  }
+}
+
+void LinearArena::Reset() {
+  // If we overflowed into extra blocks, coalesce into a single one of
+  // the combined size so next time around everything's contiguous.
+  if (blocks_.size() > 1) {
+    size_t total = 0;
+    for (auto&& block : blocks_) {
+      total += block.size;
+      free(block.data);
+    }
+    blocks_.clear();
+    Block block;
+    block.size = total;
+    block.data = static_cast<char*>(malloc(block.size));
+    BA_PRECONDITION(block.data);
+    blocks_.push_back(block);
+  }
+  current_block_ = 0;
+  if (!blocks_.empty()) {
+    end_.store(blocks_[0].data + blocks_[0].size, std::memory_order_release);
+    pos_.store(blocks_[0].data, std::memory_order_release);
+  }
+}
+
+}  // namespace ballistica
@@ -0,0 +1,59 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GENERIC_LINEAR_ARENA_H_
+#define BALLISTICA_GENERIC_LINEAR_ARENA_H_
+
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// A bump allocator for scratch memory with a single well-defined reset
+// point (a FrameDef owns one for per-frame scratch, etc). Allocation is
+// just an atomic pointer bump so it's safe and cheap to call from
+// worker jobs; nothing is ever freed individually and destructors never
+// run, so only trivially-destructible stuff belongs here. Reset()
+// rewinds the whole thing at once, keeping its memory around for the
+// next go; steady-state use mallocs nothing.
+class LinearArena {
+ public:
+  explicit LinearArena(size_t block_size = 65536);
+  ~LinearArena();
+
+  auto Alloc(size_t size, size_t alignment = 8) -> void*;
+
+  template <typename T>
+  auto AllocArray(size_t count) -> T* {
+    static_assert(std::is_trivially_destructible<T>::value);
+    return static_cast<T*>(Alloc(count * sizeof(T), alignof(T)));
+  }
+
+  // Rewind to empty, keeping allocated memory for reuse. Must not race
+  // with Alloc() calls (reset at your single-threaded sync point).
+  void Reset();
+
+ private:
+  struct Block {
+    char* data;
+    size_t size;
+  };
+
+  // Moves on to the next existing block (or a fresh one) when the
+  // current block can't fit the request.
+  auto AllocSlow(size_t size, size_t alignment) -> void*;
+
+  std::vector<Block> blocks_;
+  size_t block_size_;
+  size_t current_block_{};
+  std::atomic<char*> pos_{};
+  std::atomic<char*> end_{};
+  std::mutex mutex_;  // Guards block turnover only; bumps are lock-free.
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GENERIC_LINEAR_ARENA_H_
@@ -0,0 +1,145 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/generic/lzss.h"
+
+#include <algorithm>
+
+namespace ballistica {
+
+// Stream format: groups of up to 8 items, each group led by a flag byte
+// (bit n set means item n is a match). Literals are one raw byte;
+// matches are 3 bytes: 16 bit distance (little-endian, 1..65535) and
+// length minus kMinMatch. With 3-byte matches anything shorter than 4
+// bytes isn't worth encoding.
+const int kLzssMinMatch = 4;
+const int kLzssMaxMatch = 259;
+const size_t kLzssWindow = 65535;
+
+// Match-finder bits: positions are chained per 15-bit hash of their
+// first 4 bytes; longer chains buy ratio at the cost of time.
+const int kLzssHashBits = 15;
+const int kLzssMaxChainSteps = 32;
+
+auto LZSS::Compress(const std::vector<uint8_t>& src) -> std::vector<uint8_t> {
+  std::vector<uint8_t> out;
+  size_t len = src.size();
+  out.reserve(len / 2 + 16);
+
+  const uint32_t hash_size = 1u << kLzssHashBits;
+  std::vector<int64_t> head(hash_size, -1);
+  std::vector<int64_t> prev(len > 0 ? len : 1, -1);
+  auto hash_at = [&src](size_t i) -> uint32_t {
+    uint32_t v = static_cast<uint32_t>(src[i])
+                 | (static_cast<uint32_t>(src[i + 1]) << 8u)
+                 | (static_cast<uint32_t>(src[i + 2]) << 16u)
+                 | (static_cast<uint32_t>(src[i + 3]) << 24u);
+    return (v * 2654435761u) >> (32u - kLzssHashBits);
+  };
+  auto insert_pos = [&](size_t i) {
+    if (i + 4 <= len) {
+      uint32_t h = hash_at(i);
+      prev[i] = head[h];
+      head[h] = static_cast<int64_t>(i);
+    }
+  };
+
+  size_t i = 0;
+  size_t flag_index = 0;
+  int items_in_group = 8;  // Forces a fresh flag byte on the first item.
+  auto begin_item = [&](bool is_match) {
+    if (items_in_group == 8) {
+      flag_index = out.size();
+      out.push_back(0);
+      items_in_group = 0;
+    }
+    if (is_match) {
+      out[flag_index] |= static_cast<uint8_t>(1u << items_in_group);
+    }
+    items_in_group++;
+  };
+
+  while (i < len) {
+    // Hunt for the best match in the window.
+    size_t best_len = 0;
+    size_t best_dist = 0;
+    if (i + kLzssMinMatch <= len && i + 4 <= len) {
+      size_t max_match = std::min<size_t>(kLzssMaxMatch, len - i);
+      int64_t cand = head[hash_at(i)];
+      int steps = kLzssMaxChainSteps;
+      while (cand >= 0 && steps-- > 0) {
+        auto c = static_cast<size_t>(cand);
+        size_t dist = i - c;
+        if (dist > kLzssWindow) {
+          break;  // Chains only get older from here.
+        }
+        size_t m = 0;
+        while (m < max_match && src[c + m] == src[i + m]) {
+          m++;
+        }
+        if (m > best_len) {
+          best_len = m;
+          best_dist = dist;
+          if (m >= max_match) {
+            break;
+          }
+        }
+        cand = prev[c];
+      }
+    }
+    if (best_len >= static_cast<size_t>(kLzssMinMatch)) {
+      begin_item(true);
+      out.push_back(static_cast<uint8_t>(best_dist & 0xFFu));
+      out.push_back(static_cast<uint8_t>((best_dist >> 8u) & 0xFFu));
+      out.push_back(static_cast<uint8_t>(best_len - kLzssMinMatch));
+      for (size_t p = i; p < i + best_len; p++) {
+        insert_pos(p);
+      }
+      i += best_len;
+    } else {
+      begin_item(false);
+      out.push_back(src[i]);
+      insert_pos(i);
+      i++;
+    }
+  }
+  return out;
+}
+
+auto LZSS::Decompress(const std::vector<uint8_t>& src, size_t raw_size)
+    -> std::vector<uint8_t> {
+  std::vector<uint8_t> out;
+  out.reserve(raw_size);
+  size_t len = src.size();
+  size_t i = 0;
+  while (i < len && out.size() < raw_size) {
+    uint8_t flags = src[i++];
+    for (int b = 0; b < 8 && i < len && out.size() < raw_size; b++) {
+      if (flags & (1u << b)) {
+        if (i + 3 > len) {
+          return {};
+        }
+        size_t dist = static_cast<size_t>(src[i])
+                      | (static_cast<size_t>(src[i + 1]) << 8u);
+        size_t match_len = static_cast<size_t>(src[i + 2]) + kLzssMinMatch;
+        i += 3;
+        if (dist == 0 || dist > out.size()
+            || out.size() + match_len > raw_size) {
+          return {};
+        }
+        // (byte-by-byte on purpose; matches can overlap their output)
+        size_t start = out.size() - dist;
+        for (size_t k = 0; k < match_len; k++) {
+          out.push_back(out[start + k]);
+        }
+      } else {
+        out.push_back(src[i++]);
+      }
+    }
+  }
+  if (out.size() != raw_size || i != len) {
+    return {};
+  }
+  return out;
+}
+
+}  // namespace ballistica
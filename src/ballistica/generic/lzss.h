@@ -0,0 +1,31 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GENERIC_LZSS_H_
+#define BALLISTICA_GENERIC_LZSS_H_
+
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// A small window compressor (64k window, byte-oriented lzss framing)
+// for bulk data such as finished replay files. Our huffman coding works
+// per-message so it can't touch redundancy *between* messages; this can,
+// and game streams are full of it. Not a speed demon and not meant for
+// per-packet use; it's for background jobs where ratio matters more
+// than throughput.
+class LZSS {
+ public:
+  static auto Compress(const std::vector<uint8_t>& src) -> std::vector<uint8_t>;
+
+  // Inverse of Compress. raw_size is the expected decompressed size
+  // (callers store it alongside the payload); returns an empty vector
+  // if the payload is corrupt or doesn't yield exactly raw_size bytes.
+  static auto Decompress(const std::vector<uint8_t>& src, size_t raw_size)
+      -> std::vector<uint8_t>;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GENERIC_LZSS_H_
@@ -2,10 +2,20 @@
 
 #include "ballistica/generic/runnable.h"
 
+#include "ballistica/core/module.h"
+
 namespace ballistica {
 
 auto Runnable::GetThreadOwnership() const -> Object::ThreadOwnership {
   return ThreadOwnership::kNextReferencing;
 }
 
+auto Runnable::operator new(size_t size) -> void* {
+  return RunnablePool::Alloc(size);
+}
+
+void Runnable::operator delete(void* ptr, size_t size) {
+  RunnablePool::Free(ptr, size);
+}
+
 }  // namespace ballistica
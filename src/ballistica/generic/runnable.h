@@ -16,6 +16,14 @@ class Runnable : public Object {
   // these are used on lots of threads; lets
   // lock to wherever we're first referenced
   auto GetThreadOwnership() const -> ThreadOwnership override;
+
+  // Runnables get allocated for every PushCall() and freed on whatever
+  // thread consumes them, so their storage comes from a recycling pool
+  // instead of malloc (see RunnablePool in core/module.h). Applies to
+  // all subclasses; the sized delete sees the concrete object's size so
+  // blocks always land back in the class they came from.
+  static auto operator new(size_t size) -> void*;
+  static void operator delete(void* ptr, size_t size);
 };
 
 }  // namespace ballistica
@@ -0,0 +1,57 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/generic/symbol.h"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_set>
+
+namespace ballistica {
+
+// The global table is sharded so interning from multiple threads
+// doesn't serialize on a single lock; each shard guards its own set.
+const int kSymbolTableShardCount = 16;
+
+struct SymbolTableShard {
+  std::mutex mutex;
+  std::unordered_set<std::string> strings;
+};
+
+static auto GetSymbolTableShard(const char* text) -> SymbolTableShard* {
+  // Intentionally leaked; symbols handed out need to stay valid
+  // through exit.
+  static auto* shards = new SymbolTableShard[kSymbolTableShardCount];
+
+  // Cheap shard pick from length plus end chars; the shard's set does
+  // the real hashing exactly once.
+  size_t len = strlen(text);
+  size_t h = len * 31u;
+  if (len > 0) {
+    h += static_cast<unsigned char>(text[0]) * 7u
+         + static_cast<unsigned char>(text[len - 1]);
+  }
+  return shards + (h & (kSymbolTableShardCount - 1));
+}
+
+auto Symbol::Intern(const char* text) -> const std::string* {
+  assert(text);
+  SymbolTableShard* shard = GetSymbolTableShard(text);
+  std::lock_guard<std::mutex> lock(shard->mutex);
+
+  // Set nodes never move, so handing out element pointers is safe even
+  // as the table grows.
+  return &(*shard->strings.insert(text).first);
+}
+
+auto Symbol::Find(const char* text) -> Symbol {
+  assert(text);
+  SymbolTableShard* shard = GetSymbolTableShard(text);
+  std::lock_guard<std::mutex> lock(shard->mutex);
+  auto i = shard->strings.find(text);
+  if (i == shard->strings.end()) {
+    return {};
+  }
+  return Symbol(&(*i));
+}
+
+}  // namespace ballistica
@@ -0,0 +1,72 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GENERIC_SYMBOL_H_
+#define BALLISTICA_GENERIC_SYMBOL_H_
+
+#include <functional>
+#include <string>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+/// An interned immutable string. Any two Symbols made from equal text
+/// share one stored copy, so comparing or hashing a Symbol is a pointer
+/// operation regardless of text length. Intended for identifiers that
+/// get looked up over and over (node attr names, media names, etc).
+/// Interned text is never freed, so don't feed this unbounded
+/// user-generated strings.
+class Symbol {
+ public:
+  /// Creates an empty symbol (exists() returns false).
+  Symbol() = default;
+
+  /// Interns text, adding it to the global table on first use.
+  /// Safe to call from any thread.
+  explicit Symbol(const char* text) : str_(Intern(text)) {}
+  explicit Symbol(const std::string& text) : str_(Intern(text.c_str())) {}
+
+  /// Returns the symbol for text if it has ever been interned;
+  /// otherwise an empty symbol. Use this for miss-tolerant lookups so
+  /// arbitrary probe strings don't pile up in the table.
+  static auto Find(const char* text) -> Symbol;
+
+  auto exists() const -> bool { return str_ != nullptr; }
+
+  auto str() const -> const std::string& {
+    assert(str_);
+    return *str_;
+  }
+
+  auto c_str() const -> const char* { return str().c_str(); }
+
+  auto operator==(const Symbol& other) const -> bool {
+    return str_ == other.str_;
+  }
+  auto operator!=(const Symbol& other) const -> bool {
+    return str_ != other.str_;
+  }
+
+  /// Pointer-based hash (for std::hash below).
+  auto hash() const -> size_t {
+    return std::hash<const void*>()(static_cast<const void*>(str_));
+  }
+
+ private:
+  explicit Symbol(const std::string* str) : str_(str) {}
+  static auto Intern(const char* text) -> const std::string*;
+  const std::string* str_{};
+};
+
+}  // namespace ballistica
+
+namespace std {
+template <>
+struct hash<ballistica::Symbol> {
+  auto operator()(const ballistica::Symbol& s) const noexcept -> size_t {
+    return s.hash();
+  }
+};
+}  // namespace std
+
+#endif  // BALLISTICA_GENERIC_SYMBOL_H_
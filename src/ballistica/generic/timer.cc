@@ -32,12 +32,18 @@ Timer::~Timer() {
       // re-submitted).
       assert(list_->client_timer_ != this);
     }
+    list_->timers_by_id_.erase(id_);
     list_->timer_count_total_--;
   }
 }
 
 void Timer::SetLength(TimerMedium l, bool set_start_time,
                       TimerMedium starttime) {
+  // Lengths come in as milliseconds; convert to whatever units our list
+  // runs in (special values 0 and -1 pass through unchanged).
+  if (l > 0) {
+    l *= list_->units_per_millisecond();
+  }
   if (on_list_) {
     assert(id_ != 0);  // zero denotes "no-id"
     Timer* t = list_->PullTimer(id_);
@@ -20,9 +20,17 @@ class Timer {
   Timer(TimerList* list_in, int id_in, TimerMedium current_time,
         TimerMedium length_in, TimerMedium offset_in, int repeat_count_in);
   virtual ~Timer();
+
+  // Which of our list's containers we currently sit in (see TimerList;
+  // its timers live in a hierarchical wheel plus ready/inactive lists).
+  enum class Home : uint8_t { kNone, kWheel, kReady, kInactive };
   TimerList* list_{};
   bool on_list_{};
   Timer* next_{};
+  Timer* prev_{};
+  Home home_{Home::kNone};
+  int8_t wheel_level_{};
+  uint8_t wheel_slot_{};
   bool initial_{};
   bool dead_{};
   bool list_died_{};
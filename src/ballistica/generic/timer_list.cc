@@ -2,6 +2,8 @@
 
 #include "ballistica/generic/timer_list.h"
 
+#include <algorithm>
+
 #include "ballistica/generic/runnable.h"
 #include "ballistica/generic/timer.h"
 
@@ -35,16 +37,34 @@ TimerList::~TimerList() {
 void TimerList::Clear() {
   assert(!are_clearing_);
   are_clearing_ = true;
-  while (timers_) {
-    Timer* t = timers_;
+  for (auto& level : wheel_) {
+    for (auto& slot : level) {
+      while (Timer* t = slot.head) {
+        slot.head = t->next_;
+        t->on_list_ = false;
+        t->home_ = Timer::Home::kNone;
+        timer_count_active_--;
+        delete t;
+      }
+      slot.tail = nullptr;
+    }
+  }
+  for (int& count : wheel_level_counts_) {
+    count = 0;
+  }
+  for (size_t i = ready_next_; i < ready_.size(); i++) {
+    Timer* t = ready_[i];
     t->on_list_ = false;
+    t->home_ = Timer::Home::kNone;
     timer_count_active_--;
-    timers_ = t->next_;
     delete t;
   }
+  ready_.clear();
+  ready_next_ = 0;
   while (timers_inactive_) {
     Timer* t = timers_inactive_;
     t->on_list_ = false;
+    t->home_ = Timer::Home::kNone;
     timer_count_inactive_--;
     timers_inactive_ = t->next_;
     delete t;
@@ -54,60 +74,67 @@ void TimerList::Clear() {
 
 // Pull a timer out of the list.
 auto TimerList::PullTimer(int timer_id, bool remove) -> Timer* {
-  Timer* t = timers_;
-  Timer* p = nullptr;
-  while (t) {
-    if (t->id_ == timer_id) {
-      if (remove) {
-        if (p) {
-          p->next_ = t->next_;
-        } else {
-          timers_ = t->next_;
-        }
-        t->on_list_ = false;
-        timer_count_active_--;
+  auto i = timers_by_id_.find(timer_id);
+  if (i == timers_by_id_.end()) {
+    return nullptr;
+  }
+  Timer* t = i->second;
+  if (!remove || !t->on_list_) {
+    // (the client timer is off-list; it just gets returned as-is)
+    return t;
+  }
+  switch (t->home_) {
+    case Timer::Home::kWheel: {
+      WheelSlot& slot = wheel_[t->wheel_level_][t->wheel_slot_];
+      if (t->prev_) {
+        t->prev_->next_ = t->next_;
+      } else {
+        slot.head = t->next_;
       }
-      return t;
+      if (t->next_) {
+        t->next_->prev_ = t->prev_;
+      } else {
+        slot.tail = t->prev_;
+      }
+      wheel_level_counts_[t->wheel_level_]--;
+      timer_count_active_--;
+      break;
     }
-    p = t;
-    t = t->next_;
-  }
-
-  // Didn't find it. check the inactive list.
-  t = timers_inactive_;
-  p = nullptr;
-  while (t) {
-    if (t->id_ == timer_id) {
-      if (remove) {
-        if (p) {
-          p->next_ = t->next_;
-        } else {
-          timers_inactive_ = t->next_;
-        }
-        t->on_list_ = false;
-        timer_count_inactive_--;
+    case Timer::Home::kReady: {
+      auto j = std::find(ready_.begin() + static_cast<int64_t>(ready_next_),
+                         ready_.end(), t);
+      assert(j != ready_.end());
+      ready_.erase(j);
+      timer_count_active_--;
+      break;
+    }
+    case Timer::Home::kInactive: {
+      if (t->prev_) {
+        t->prev_->next_ = t->next_;
+      } else {
+        timers_inactive_ = t->next_;
+      }
+      if (t->next_) {
+        t->next_->prev_ = t->prev_;
       }
-      return t;
+      timer_count_inactive_--;
+      break;
     }
-    p = t;
-    t = t->next_;
+    default:
+      throw Exception();
   }
-
-  // Not on either list; only other possibility is the current client timer.
-  if (client_timer_ && client_timer_->id_ == timer_id) {
-    return client_timer_;
-  }
-  return nullptr;
+  t->on_list_ = false;
+  t->home_ = Timer::Home::kNone;
+  t->prev_ = t->next_ = nullptr;
+  return t;
 }
 
 void TimerList::Run(TimerMedium target_time) {
   assert(!are_clearing_);
 
-  // Limit our runs to whats initially on the list so we don't spin all day if
+  // Limit our runs to whats initially due so we don't spin all day if
   // a timer resets itself to run immediately.
-  // FIXME - what if this timer kills one or more of the initially-expired ones
-  //  ..that means it could potentially run more than once..  does it matter?
-  int expired_count = GetExpiredCount(target_time);
+  int expired_count = HarvestExpired(target_time);
   for (int timers_to_run = expired_count; timers_to_run > 0; timers_to_run--) {
     Timer* t = GetExpiredTimer(target_time);
     if (t) {
@@ -134,16 +161,97 @@ void TimerList::Run(TimerMedium target_time) {
     }
   }
 }
-auto TimerList::GetExpiredCount(TimerMedium target_time) -> int {
+
+void TimerList::FlushWheelSlot(int level, int slot, TimerMedium target_time,
+                               std::vector<Timer*>* requeue) {
+  WheelSlot& s = wheel_[level][slot];
+  Timer* t = s.head;
+  s.head = s.tail = nullptr;
+  while (t) {
+    Timer* next = t->next_;
+    t->prev_ = t->next_ = nullptr;
+    wheel_level_counts_[level]--;
+    if (t->expire_time_ <= target_time) {
+      t->home_ = Timer::Home::kReady;
+      ready_.push_back(t);
+    } else {
+      // Not due yet; it'll re-bucket closer in once the wheel has
+      // advanced (the cascade).
+      requeue->push_back(t);
+    }
+    t = next;
+  }
+}
+
+auto TimerList::HarvestExpired(TimerMedium target_time) -> int {
   assert(!are_clearing_);
+  if (!have_wheel_now_) {
+    have_wheel_now_ = true;
+    wheel_now_ = target_time;
+  }
+
+  // We only ever move forward.
+  if (target_time < wheel_now_) {
+    target_time = wheel_now_;
+  }
+
+  // Compact away anything already consumed from a previous pass.
+  if (ready_next_ > 0) {
+    ready_.erase(ready_.begin(),
+                 ready_.begin() + static_cast<int64_t>(ready_next_));
+    ready_next_ = 0;
+  }
+
+  std::vector<Timer*> requeue;
 
-  Timer* t = timers_;
-  int count = 0;
-  while (t && t->expire_time_ <= target_time) {
-    count++;
-    t = t->next_;
+  // Level 0: one slot per time unit, so every slot in [now, target] holds
+  // only due timers.
+  {
+    uint64_t span = static_cast<uint64_t>(target_time - wheel_now_) + 1;
+    if (span >= kWheelSlotsPerLevel) {
+      for (int slot = 0; slot < kWheelSlotsPerLevel; slot++) {
+        FlushWheelSlot(0, slot, target_time, &requeue);
+      }
+    } else {
+      for (TimerMedium tick = wheel_now_; tick <= target_time; tick++) {
+        FlushWheelSlot(0, static_cast<int>(tick & (kWheelSlotsPerLevel - 1)),
+                       target_time, &requeue);
+      }
+    }
+  }
+
+  // Coarser levels: flush every slot whose span we've newly entered. Not
+  // everything in them is due; the rest lands back in the wheel below.
+  for (int level = 1; level < kWheelLevels; level++) {
+    int shift = kWheelBitsPerLevel * level;
+    auto start = static_cast<uint64_t>(wheel_now_) >> shift;
+    auto end = static_cast<uint64_t>(target_time) >> shift;
+    if (start == end) {
+      break;  // No boundary crossed here means none above either.
+    }
+    if (end - start >= kWheelSlotsPerLevel) {
+      for (int slot = 0; slot < kWheelSlotsPerLevel; slot++) {
+        FlushWheelSlot(level, slot, target_time, &requeue);
+      }
+    } else {
+      for (uint64_t s = start + 1; s <= end; s++) {
+        FlushWheelSlot(level, static_cast<int>(s & (kWheelSlotsPerLevel - 1)),
+                       target_time, &requeue);
+      }
+    }
   }
-  return count;
+
+  wheel_now_ = target_time;
+  for (Timer* t : requeue) {
+    AddToWheel(t);
+  }
+
+  // Stable so timers sharing an expire time keep their insertion order.
+  std::stable_sort(ready_.begin(), ready_.end(),
+                   [](const Timer* a, const Timer* b) {
+                     return a->expire_time_ < b->expire_time_;
+                   });
+  return static_cast<int>(ready_.size());
 }
 
 // Returns the next expired timer.  When done with the timer,
@@ -151,41 +259,90 @@ auto TimerList::GetExpiredCount(TimerMedium target_time) -> int {
 // (this will either put it back in line or delete it)
 auto TimerList::GetExpiredTimer(TimerMedium target_time) -> Timer* {
   assert(!are_clearing_);
-
-  Timer* t;
-  if (timers_ != nullptr && timers_->expire_time_ <= target_time) {
-    t = timers_;
-    t->last_run_time_ = target_time;
-    timers_ = timers_->next_;
-    timer_count_active_--;
-    t->on_list_ = false;
-
-    // Exactly one timer at a time can be out in userland and not on
-    // any list - this is now that one.
-    assert(client_timer_ == nullptr);
-    client_timer_ = t;
-    return t;
+  if (ready_next_ >= ready_.size()) {
+    return nullptr;
   }
-  return nullptr;
+  Timer* t = ready_[ready_next_++];
+  if (ready_next_ >= ready_.size()) {
+    ready_.clear();
+    ready_next_ = 0;
+  }
+  t->home_ = Timer::Home::kNone;
+  t->on_list_ = false;
+  timer_count_active_--;
+  t->last_run_time_ = target_time;
+
+  // Exactly one timer at a time can be out in userland and not on
+  // any list - this is now that one.
+  assert(client_timer_ == nullptr);
+  client_timer_ = t;
+  return t;
 }
 
 auto TimerList::NewTimer(TimerMedium current_time, TimerMedium length,
                          TimerMedium offset, int repeat_count,
                          const Object::Ref<Runnable>& runnable) -> Timer* {
   assert(!are_clearing_);
+  if (!have_wheel_now_) {
+    have_wheel_now_ = true;
+    wheel_now_ = current_time;
+  }
   auto* t = new Timer(this, next_timer_id_++, current_time, length, offset,
                       repeat_count);
   t->runnable_ = runnable;
+  timers_by_id_[t->id_] = t;
   t = SubmitTimer(t);
   return t;
 }
 
 auto TimerList::GetTimeToNextExpire(TimerMedium current_time) -> TimerMedium {
   assert(!are_clearing_);
-  if (!timers_) {
+  if (timer_count_active_ == 0) {
     return (TimerMedium)-1;
   }
-  TimerMedium diff = timers_->expire_time_ - current_time;
+
+  // Anything already harvested is due now.
+  if (ready_next_ < ready_.size()) {
+    return 0;
+  }
+
+  // Check each level's first occupied slot onward from the wheel's
+  // position; a level's earliest timer has to be in it. (Coarse levels
+  // can hold timers due before level 0's horizon, so every level gets a
+  // say.)
+  TimerMedium best = -1;
+  for (int level = 0; level < kWheelLevels; level++) {
+    if (wheel_level_counts_[level] == 0) {
+      continue;
+    }
+    int cur = static_cast<int>(
+        (static_cast<uint64_t>(wheel_now_) >> (kWheelBitsPerLevel * level))
+        & (kWheelSlotsPerLevel - 1));
+
+    // The cur slot is ambiguous: a timer one full lap out aliases right
+    // back onto it, so finding it occupied says nothing about how soon
+    // its contents are. Scan the rest of the level for the first
+    // occupied slot (those can't alias; a lap-out timer would have gone
+    // a level up), then let cur's chain compete on actual expire times.
+    for (int i = 1; i < kWheelSlotsPerLevel; i++) {
+      int slot = (cur + i) & (kWheelSlotsPerLevel - 1);
+      if (Timer* t = wheel_[level][slot].head) {
+        for (; t != nullptr; t = t->next_) {
+          if (best == -1 || t->expire_time_ < best) {
+            best = t->expire_time_;
+          }
+        }
+        break;
+      }
+    }
+    for (Timer* t = wheel_[level][cur].head; t != nullptr; t = t->next_) {
+      if (best == -1 || t->expire_time_ < best) {
+        best = t->expire_time_;
+      }
+    }
+  }
+  assert(best != -1);
+  TimerMedium diff = best - current_time;
   return (diff < 0) ? 0 : diff;
 }
 
@@ -194,7 +351,7 @@ auto TimerList::GetTimer(int id) -> Timer* {
 
   assert(id != 0);  // Zero denotes "no-id".
   Timer* t = PullTimer(id, false);
-  return t->dead_ ? nullptr : t;
+  return (t && !t->dead_) ? t : nullptr;
 }
 
 void TimerList::DeleteTimer(int timer_id) {
@@ -244,25 +401,54 @@ auto TimerList::SubmitTimer(Timer* t) -> Timer* {
   }
 }
 
+void TimerList::AddToWheel(Timer* t) {
+  // Late timers just go in the current slot; they'll fire on the next
+  // harvest.
+  TimerMedium expire = t->expire_time_;
+  if (expire < wheel_now_) {
+    expire = wheel_now_;
+  }
+  auto delta = static_cast<uint64_t>(expire - wheel_now_);
+  int level = 0;
+  while (level < kWheelLevels - 1
+         && (delta >> (kWheelBitsPerLevel * (level + 1))) != 0) {
+    level++;
+  }
+  int slot = static_cast<int>(
+      (static_cast<uint64_t>(expire) >> (kWheelBitsPerLevel * level))
+      & (kWheelSlotsPerLevel - 1));
+  WheelSlot& s = wheel_[level][slot];
+  t->home_ = Timer::Home::kWheel;
+  t->wheel_level_ = static_cast<int8_t>(level);
+  t->wheel_slot_ = static_cast<uint8_t>(slot);
+  t->prev_ = s.tail;
+  t->next_ = nullptr;
+  if (s.tail) {
+    s.tail->next_ = t;
+  } else {
+    s.head = t;
+  }
+  s.tail = t;
+  wheel_level_counts_[level]++;
+}
+
 void TimerList::AddTimer(Timer* t) {
   assert(t && !t->on_list_);
 
   // If its set to never go off, throw it on the inactive list.
   if (t->length_ == -1) {
+    t->prev_ = nullptr;
     t->next_ = timers_inactive_;
+    if (timers_inactive_) {
+      timers_inactive_->prev_ = t;
+    }
     timers_inactive_ = t;
+    t->home_ = Timer::Home::kInactive;
     timer_count_inactive_++;
   } else {
-    Timer** list = &timers_;
-
-    // Go along till we find an expire time later than ourself.
-    while (*list != nullptr) {
-      if ((*list)->expire_time_ > t->expire_time_) break;
-      list = &((*list)->next_);
-    }
-    Timer* tmp = (*list);
-    (*list) = t;
-    t->next_ = tmp;
+    // (cascades re-bucket via AddToWheel() too, so the active count is
+    // kept here where only true insertions come through)
+    AddToWheel(t);
     timer_count_active_++;
   }
   t->on_list_ = true;
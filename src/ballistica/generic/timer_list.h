@@ -8,6 +8,7 @@
 
 #include "ballistica/ballistica.h"
 #include "ballistica/core/object.h"
+#include "ballistica/generic/flat_hash_map.h"
 
 namespace ballistica {
 
@@ -38,26 +39,67 @@ class TimerList {
   // timer (a timer returned via getExpiredTimer() but not yet re-submitted).
   auto active_timer_count() const -> int { return timer_count_active_; }
 
-  auto empty() -> bool { return (timers_ == nullptr); }
+  auto empty() -> bool { return (timer_count_active_ == 0); }
 
   void Clear();
 
+  // Lists historically all ran in milliseconds but some (thread timers)
+  // now run in finer units. Timer::SetLength() still takes milliseconds
+  // everywhere for the sake of its many existing callers, so each list
+  // carries a conversion factor it applies there. Defaults to 1.
+  void set_units_per_millisecond(TimerMedium units) {
+    units_per_millisecond_ = units;
+  }
+  auto units_per_millisecond() const -> TimerMedium {
+    return units_per_millisecond_;
+  }
+
  private:
+  // Active timers live in a hierarchical timer wheel: each level covers
+  // 64x the time span of the one below it, with level 0 at one list-unit
+  // per slot. Inserts and cancels just link/unlink a slot's doubly-linked
+  // list (plus one id-map touch), so they're O(1) regardless of how many
+  // timers are live; the old sorted linked list made NewTimer a hot spot
+  // with hundreds of sim/material/python timers in flight.
+  static const int kWheelBitsPerLevel = 6;
+  static const int kWheelSlotsPerLevel = 1 << kWheelBitsPerLevel;
+  static const int kWheelLevels = 11;  // Covers 66 bits of delta.
+  struct WheelSlot {
+    Timer* head;
+    Timer* tail;
+  };
+
   // Returns the next expired timer.  When done with the timer,
   // return it to the list with Timer::submit()
   // (this will either put it back in line or delete it)
   auto GetExpiredTimer(TimerMedium target_time) -> Timer*;
-  auto GetExpiredCount(TimerMedium target_time) -> int;
+
+  // Advance the wheel to target_time, moving everything due into the
+  // sorted ready list; returns how many are there. Timers from coarse
+  // levels that aren't due yet re-bucket closer in (the wheel's cascade).
+  auto HarvestExpired(TimerMedium target_time) -> int;
   auto PullTimer(int timer_id, bool remove = true) -> Timer*;
   auto SubmitTimer(Timer* t) -> Timer*;
   void AddTimer(Timer* t);
+  void AddToWheel(Timer* t);
+  void FlushWheelSlot(int level, int slot, TimerMedium target_time,
+                      std::vector<Timer*>* requeue);
   int timer_count_active_ = 0;
   int timer_count_inactive_ = 0;
   int timer_count_total_ = 0;
   Timer* client_timer_ = nullptr;
-  Timer* timers_ = nullptr;
   Timer* timers_inactive_ = nullptr;
+  WheelSlot wheel_[kWheelLevels][kWheelSlotsPerLevel]{};
+  int wheel_level_counts_[kWheelLevels]{};
+  TimerMedium wheel_now_ = 0;
+  bool have_wheel_now_ = false;
+
+  // Timers harvested as due, in run order; consumed front-to-back.
+  std::vector<Timer*> ready_;
+  size_t ready_next_ = 0;
+  FlatHashMap<int, Timer*> timers_by_id_;
   int next_timer_id_ = 1;
+  TimerMedium units_per_millisecond_ = 1;
   bool running_ = false;
   bool are_clearing_ = false;
   friend class Timer;
@@ -18,6 +18,12 @@
 #include "ballistica/platform/platform.h"
 #include "ballistica/scene/scene.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 // FIXME: Cleaner to add the lib to the project(s) instead?
 #if BA_OSTYPE_WINDOWS
 #pragma comment(lib, "Ws2_32.lib")
@@ -191,7 +197,55 @@ auto Utils::StringReplaceAll(std::string* target, const std::string& key,
   target->swap(ws_ret);  // faster than str = ws_ret;
 }
 
+// Length of the leading run of plain-ascii bytes (high bit clear),
+// chewing through 16 bytes at a time where we've got simd. Text is
+// overwhelmingly ascii so most validation/measuring reduces to this.
+static auto AsciiRunLength(const unsigned char* bytes, size_t len) -> size_t {
+  size_t i = 0;
+#if defined(__SSE2__)
+  while (i + 16 <= len) {
+    __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i));
+    if (_mm_movemask_epi8(chunk) != 0) {
+      break;
+    }
+    i += 16;
+  }
+#elif defined(__ARM_NEON)
+  while (i + 16 <= len) {
+    uint64x2_t msb = vreinterpretq_u64_u8(
+        vandq_u8(vld1q_u8(bytes + i), vdupq_n_u8(0x80u)));
+    if ((vgetq_lane_u64(msb, 0) | vgetq_lane_u64(msb, 1)) != 0) {
+      break;
+    }
+    i += 16;
+  }
+#endif
+  while (i < len && bytes[i] < 0x80u) {
+    i++;
+  }
+  return i;
+}
+
+// True if every byte is printable ascii or \t \n \r; such strings pass
+// through GetValidUTF8 untouched.
+static auto IsPrintableAscii(const unsigned char* bytes, size_t len) -> bool {
+  for (size_t i = 0; i < len; i++) {
+    unsigned char c = bytes[i];
+    if ((c < 32 && c != 9 && c != 10 && c != 13) || c >= 127) {
+      return false;
+    }
+  }
+  return true;
+}
+
 auto Utils::IsValidUTF8(const std::string& val) -> bool {
+  // Fast path: plain printable ascii always comes back from
+  // GetValidUTF8 unchanged; no need for the copy and compare.
+  const auto* bytes = reinterpret_cast<const unsigned char*>(val.data());
+  if (AsciiRunLength(bytes, val.size()) == val.size()) {
+    return IsPrintableAscii(bytes, val.size());
+  }
   std::string out = Utils::GetValidUTF8(val.c_str(), "bsivu8");
   return (out == val);
 }
@@ -199,6 +253,14 @@ auto Utils::IsValidUTF8(const std::string& val) -> bool {
 static auto utf8_check_is_valid(const std::string& string) -> bool {
   int c, i, ix, n, j;
   for (i = 0, ix = static_cast<int>(string.length()); i < ix; i++) {
+    // Skip over whole ascii runs at once; the byte-by-byte state
+    // machine below only ever needs to look at multi-byte sequences.
+    i += static_cast<int>(AsciiRunLength(
+        reinterpret_cast<const unsigned char*>(string.data()) + i,
+        static_cast<size_t>(ix - i)));
+    if (i >= ix) {
+      break;
+    }
     c = (unsigned char)string[i];
     // if (c==0x09 || c==0x0a || c==0x0d
     // || (0x20 <= c && c <= 0x7e) ) n = 0;  // is_printable_ascii
@@ -346,6 +408,13 @@ auto Utils::GetValidUTF8(const char* str, const char* loc) -> std::string {
 }
 
 auto Utils::UTF8StringLength(const char* val) -> int {
+  // Fast path: for plain printable ascii the codepoint count is just
+  // the byte count; skip the validation copy.
+  size_t len = strlen(val);
+  const auto* bytes = reinterpret_cast<const unsigned char*>(val);
+  if (AsciiRunLength(bytes, len) == len && IsPrintableAscii(bytes, len)) {
+    return static_cast<int>(len);
+  }
   std::string valid_str = GetValidUTF8(val, "gusl1");
   return u8_strlen(valid_str.c_str());
 }
@@ -46,6 +46,19 @@ class Utils {
   static auto UTF8FromUnicodeChar(uint32_t c) -> std::string;
   static auto UTF8StringLength(const char* val) -> int;
 
+  /// Compile-time fnv-1a string hash, for switch-based dispatch on
+  /// names instead of if-else compare ladders. Hash the incoming
+  /// string at runtime and switch against hashed literals; if two
+  /// literals ever collide the duplicate case labels fail the build,
+  /// so each matched case just needs one equality check to be exact.
+  static constexpr auto ConstHash(const char* s) -> uint32_t {
+    uint32_t hash = 2166136261u;
+    while (*s != 0) {
+      hash = (hash ^ static_cast<uint8_t>(*s++)) * 16777619u;
+    }
+    return hash;
+  }
+
   /// Start a timer to kill the app after the set length of time.
   /// Use this during shutdown or when trying to send a crash-report before
   /// dying just to ensure we don't hang indefinitely.
@@ -174,6 +174,25 @@ void Camera::UpdateManualMode() {
   }
 }
 
+// Clamp an AOI sphere's center to the interest bounds: axes smaller than
+// the sphere get centered; otherwise clamp to the box inset by the radius.
+static auto ClampPointToAOIBounds(const Vector3f& point, float radius,
+                                  const float* bounds) -> Vector3f {
+  float diameter = radius * 2.0f;
+  Vector3f out{0.0f, 0.0f, 0.0f};
+  for (int axis = 0; axis < 3; axis++) {
+    float lo = bounds[axis];
+    float hi = bounds[axis + 3];
+    if (diameter > (hi - lo)) {
+      out.v[axis] = 0.5f * (hi + lo);
+    } else {
+      out.v[axis] =
+          std::min(hi - radius, std::max(lo + radius, point.v[axis]));
+    }
+  }
+  return out;
+}
+
 void Camera::UpdatePosition() {
   // We re-calc our area-of-interest-points here.
   area_of_interest_points_.clear();
@@ -231,61 +250,23 @@ void Camera::UpdatePosition() {
           x_min = y_min = z_min = 99999;
           x_max = y_max = z_max = -99999;
 
-          // Find the center of all AOI points (clamped to our bounds plus their
-          // radius as a buffer)
+          // Find the center of all AOI points (clamped to our bounds plus
+          // their radius as a buffer). The clamped centers are
+          // view-independent so we compute them once here and reuse them
+          // in the angle pass below.
+          std::vector<Vector3f> clamped_centers;
+          clamped_centers.reserve(areas_of_interest_.size());
           for (auto&& i : areas_of_interest_) {
-            float x_clamped, y_clamped, z_clamped;
-            float diameter = i.radius() * 2.0f;
-
-            if (diameter
-                > (area_of_interest_bounds_[3] - area_of_interest_bounds_[0])) {
-              x_clamped =
-                  0.5f
-                  * (area_of_interest_bounds_[3] + area_of_interest_bounds_[0]);
-            } else {
-              x_clamped =
-                  std::min(area_of_interest_bounds_[3] - i.radius(),
-                           std::max(area_of_interest_bounds_[0] + i.radius(),
-                                    i.position().x));
-            }
-
-            if (diameter
-                > (area_of_interest_bounds_[4] - area_of_interest_bounds_[1])) {
-              y_clamped =
-                  0.5f
-                  * (area_of_interest_bounds_[4] + area_of_interest_bounds_[1]);
-            } else {
-              y_clamped =
-                  std::min(area_of_interest_bounds_[4] - i.radius(),
-                           std::max(area_of_interest_bounds_[1] + i.radius(),
-                                    i.position().y));
-            }
-
-            if (diameter
-                > (area_of_interest_bounds_[5] - area_of_interest_bounds_[2])) {
-              z_clamped = 0.5f
-                          * ((area_of_interest_bounds_[5]
-                              + area_of_interest_bounds_[2]));
-            } else {
-              z_clamped =
-                  std::min(area_of_interest_bounds_[5] - i.radius(),
-                           std::max(area_of_interest_bounds_[2] + i.radius(),
-                                    i.position().z));
-            }
-
-            x_min = std::min(x_min, x_clamped - i.radius());
-            y_min = std::min(y_min, y_clamped - i.radius());
-            z_min = std::min(z_min, z_clamped - i.radius());
-            x_max = std::max(x_max, x_clamped - i.radius());
-            y_max = std::max(y_max, y_clamped - i.radius());
-            z_max = std::max(z_max, z_clamped - i.radius());
-
-            x_min = std::min(x_min, x_clamped + i.radius());
-            y_min = std::min(y_min, y_clamped + i.radius());
-            z_min = std::min(z_min, z_clamped + i.radius());
-            x_max = std::max(x_max, x_clamped + i.radius());
-            y_max = std::max(y_max, y_clamped + i.radius());
-            z_max = std::max(z_max, z_clamped + i.radius());
+            Vector3f c = ClampPointToAOIBounds(i.position(), i.radius(),
+                                               area_of_interest_bounds_);
+            clamped_centers.push_back(c);
+
+            x_min = std::min(x_min, c.x - i.radius());
+            y_min = std::min(y_min, c.y - i.radius());
+            z_min = std::min(z_min, c.z - i.radius());
+            x_max = std::max(x_max, c.x + i.radius());
+            y_max = std::max(y_max, c.y + i.radius());
+            z_max = std::max(z_max, c.z + i.radius());
           }
 
           center_x = 0.5f * (x_min + x_max);
@@ -307,6 +288,7 @@ void Camera::UpdatePosition() {
           cam_up.Normalize();
 
           int num = 0;
+          int aoi_index = 0;
 
           for (auto&& i : areas_of_interest_) {
             // If this point is used for focusing, add it to that list.
@@ -326,64 +308,22 @@ void Camera::UpdatePosition() {
                   x_clamped_focus, y_clamped_focus, z_clamped_focus);
             }
 
-            // Now, for camera aiming purposes, add some of their velocity and
-            // clamp to bounds, taking their radius into account. if our AOI
-            // sphere is bigger than a given dimension, center it; otherwise
-            // clamp to the box inset by our radius.
-            float x_clamped, y_clamped, z_clamped, x_mirrored_clamped;
-            float diameter = i.radius() * 2.0f;
-
-            if (diameter
-                > (area_of_interest_bounds_[3] - area_of_interest_bounds_[0])) {
-              x_clamped =
-                  0.5f
-                  * (area_of_interest_bounds_[3] + area_of_interest_bounds_[0]);
-            } else {
-              x_clamped =
-                  std::min(area_of_interest_bounds_[3] - i.radius(),
-                           std::max(area_of_interest_bounds_[0] + i.radius(),
-                                    i.position().x));
-            }
-
-            if (diameter
-                > (area_of_interest_bounds_[4] - area_of_interest_bounds_[1])) {
-              y_clamped =
-                  0.5f
-                  * (area_of_interest_bounds_[4] + area_of_interest_bounds_[1]);
-            } else {
-              y_clamped =
-                  std::min(area_of_interest_bounds_[4] - i.radius(),
-                           std::max(area_of_interest_bounds_[1] + i.radius(),
-                                    i.position().y));
-            }
-
-            if (diameter
-                > (area_of_interest_bounds_[5] - area_of_interest_bounds_[2])) {
-              z_clamped = 0.5f
-                          * ((area_of_interest_bounds_[5]
-                              + area_of_interest_bounds_[2]));
-            } else {
-              z_clamped =
-                  std::min(area_of_interest_bounds_[5] - i.radius(),
-                           std::max(area_of_interest_bounds_[2] + i.radius(),
-                                    i.position().z));
-            }
+            // Now, for camera aiming purposes, use the sphere's clamped
+            // center from the pass above.
+            const Vector3f& clamped = clamped_centers[aoi_index++];
+            float x_clamped = clamped.x;
+            float y_clamped = clamped.y;
+            float z_clamped = clamped.z;
 
             // Let's also do a version mirrored across the camera's x coordinate
             // (adding this to our tracked point set causes us zoom out instead
             // of rotating generally)
             float x_mirrored = position_.x - (i.position().x - position_.x);
-            if (diameter
-                > (area_of_interest_bounds_[3] - area_of_interest_bounds_[0])) {
-              x_mirrored_clamped =
-                  0.5f
-                  * (area_of_interest_bounds_[3] + area_of_interest_bounds_[0]);
-            } else {
-              x_mirrored_clamped =
-                  std::min(area_of_interest_bounds_[3] - i.radius(),
-                           std::max(area_of_interest_bounds_[0] + i.radius(),
-                                    x_mirrored));
-            }
+            float x_mirrored_clamped =
+                ClampPointToAOIBounds(
+                    Vector3f(x_mirrored, i.position().y, i.position().z),
+                    i.radius(), area_of_interest_bounds_)
+                    .x;
 
             Vector3f corner_offs = (cam_side + cam_up) * i.radius();
 
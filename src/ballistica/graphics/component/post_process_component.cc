@@ -2,6 +2,8 @@
 
 #include "ballistica/graphics/component/post_process_component.h"
 
+#include "ballistica/graphics/graphics.h"
+
 namespace ballistica {
 
 void PostProcessComponent::WriteConfig() {
@@ -12,6 +14,8 @@ void PostProcessComponent::WriteConfig() {
     if (normal_distort_ != 0.0f) {
       ConfigForShading(ShadingType::kPostProcessNormalDistort);
       cmd_buffer_->PutFloat(normal_distort_);
+      cmd_buffer_->PutInt(
+          Graphics::UseLowResDistortion(pass_->frame_def()) ? 1 : 0);
     } else {
       ConfigForShading(ShadingType::kPostProcess);
     }
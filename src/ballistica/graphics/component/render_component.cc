@@ -2,11 +2,48 @@
 
 #include "ballistica/graphics/component/render_component.h"
 
+#include "ballistica/dynamics/part.h"
 #include "ballistica/dynamics/rigid_body.h"
+#include "ballistica/graphics/component/render_component_template.h"
 #include "ballistica/graphics/graphics_server.h"
+#include "ballistica/scene/node/node.h"
+#include "ballistica/scene/scene.h"
 
 namespace ballistica {
 
+void RenderComponent::RecordTemplate(RenderComponentTemplate* target) {
+  assert(InGameThread());
+  assert(target != nullptr);
+  assert(state_ == State::kConfiguring);
+  assert(record_target_ == nullptr);
+
+  // Run our normal config write, but into a scratch buffer
+  // (ConfigForShading redirects when record_target_ is set).
+  RenderCommandBuffer record_buffer;
+  record_buffer.set_frame_def(pass_->frame_def());
+  record_target_ = target;
+  record_buffer_ = &record_buffer;
+  WriteConfig();
+  record_buffer_ = nullptr;
+  record_target_ = nullptr;
+
+  RenderCommandBuffer::ContentSnapshot content;
+  record_buffer.CaptureContent(&content);
+  target->SetContent(recorded_shading_type_, content);
+
+  // Nothing was drawn, so nothing further owes the pass a submit.
+  state_ = State::kSubmitted;
+}
+
+void RenderComponent::ConfigForTemplateRecord(ShadingType shading_type) {
+  assert(record_target_ != nullptr);
+  assert(record_buffer_ != nullptr);
+  cmd_buffer_ = record_buffer_;
+  recorded_shading_type_ = shading_type;
+  cmd_buffer_->PutCommand(RenderCommandBuffer::Command::kShader);
+  cmd_buffer_->PutInt(static_cast<int>(shading_type));
+}
+
 void RenderComponent::ScissorPush(const Rect& rIn) {
   EnsureDrawing();
   cmd_buffer_->PutCommand(RenderCommandBuffer::Command::kScissorPush);
@@ -38,46 +75,12 @@ void RenderComponent::ConfigForShadingDebugChecks(ShadingType shading_type) {
 #endif  // BA_DEBUG_BUILD
 
 void RenderComponent::TransformToBody(const RigidBody& b) {
-  dBodyID body = b.body();
-  dGeomID geom = b.geom();
-  const dReal* pos_in;
-  const dReal* r_in;
-  if (b.type() == RigidBody::Type::kBody) {
-    pos_in = dBodyGetPosition(body);
-    r_in = dBodyGetRotation(body);
-  } else {
-    pos_in = dGeomGetPosition(geom);
-    r_in = dGeomGetRotation(geom);
-  }
-  float pos[3];
-  float r[12];
-  for (int x = 0; x < 3; x++) {
-    pos[x] = pos_in[x];
-  }
-  pos[0] += b.blend_offset().x;
-  pos[1] += b.blend_offset().y;
-  pos[2] += b.blend_offset().z;
-  for (int x = 0; x < 12; x++) {
-    r[x] = r_in[x];
-  }
-  float matrix[16];
-  matrix[0] = r[0];
-  matrix[1] = r[4];
-  matrix[2] = r[8];
-  matrix[3] = 0;
-  matrix[4] = r[1];
-  matrix[5] = r[5];
-  matrix[6] = r[9];
-  matrix[7] = 0;
-  matrix[8] = r[2];
-  matrix[9] = r[6];
-  matrix[10] = r[10];
-  matrix[11] = 0;
-  matrix[12] = pos[0];
-  matrix[13] = pos[1];
-  matrix[14] = pos[2];
-  matrix[15] = 1;
-  MultMatrix(matrix);
+  // The sim steps at a fixed rate; interpolate between the body's last
+  // two steps based on where this frame lands so draws stay smooth at
+  // higher refresh rates.
+  Matrix44f matrix = b.GetInterpolatedTransform(
+      b.part()->node()->scene()->draw_interp_fraction());
+  MultMatrix(matrix.m);
 }
 
 }  // namespace ballistica
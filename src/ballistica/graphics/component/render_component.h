@@ -9,6 +9,8 @@
 
 namespace ballistica {
 
+class RenderComponentTemplate;
+
 class RenderComponent {
  public:
   explicit RenderComponent(RenderPass* pass)
@@ -145,10 +147,17 @@ class RenderComponent {
     EnsureDrawing();
     cmd_buffer_->PutCommand(RenderCommandBuffer::Command::kFlipCullFace);
   }
+  // Capture this component's current config into a reusable template
+  // instead of submitting it. Hot callers can record once and replay
+  // each frame through a TemplateComponent, skipping per-submit config
+  // writes. Only valid while still configuring (before any draws).
+  void RecordTemplate(RenderComponentTemplate* target);
+
   void Submit() {
     if (state_ != State::kSubmitted) {
       // if we were drawing, make note that we're done
       if (state_ == State::kDrawing) {
+        cmd_buffer_->EndSortBlock();
 #if BA_DEBUG_BUILD
         assert(pass_->frame_def()->defining_component());
         pass_->frame_def()->set_defining_component(false);
@@ -163,12 +172,13 @@ class RenderComponent {
   void EnsureConfiguring() {
     if (state_ != State::kConfiguring) {
       // if we were drawing, make note that we're done
-#if BA_DEBUG_BUILD
       if (state_ == State::kDrawing) {
+        cmd_buffer_->EndSortBlock();
+#if BA_DEBUG_BUILD
         assert(pass_->frame_def()->defining_component());
         pass_->frame_def()->set_defining_component(false);
-      }
 #endif  // BA_DEBUG_BUILD
+      }
       state_ = State::kConfiguring;
     }
   }
@@ -184,6 +194,7 @@ class RenderComponent {
 #endif
 
     assert(!pass_->UsesWorldLists());
+    assert(record_target_ == nullptr);  // Not supported for empty configs.
     if (transparent) {
       cmd_buffer_ = pass_->commands_flat_transparent();
     } else {
@@ -219,6 +230,15 @@ class RenderComponent {
           " not cool man.");
     }
 #endif  // BA_DEBUG_BUILD
+
+    // When recording a template, the config goes to its scratch buffer
+    // and sort-block bookkeeping waits until replay time (see
+    // TemplateComponent).
+    if (record_target_ != nullptr) {
+      ConfigForTemplateRecord(shading_type);
+      return;
+    }
+
     // Certain passes (overlay, etc) draw objects in the order
     // provided.  Other passes group by shader for efficiency.
     if (pass_->UsesWorldLists()) {
@@ -231,6 +251,18 @@ class RenderComponent {
       }
     }
 
+    // Opaque submissions are self-contained (start with their own shader
+    // bind and leave transform/scissor state balanced), so mark them as
+    // sortable blocks; the buffer reorders these by pass/shader/texture
+    // at Finalize() to cut down renderer state changes. Transparent ones
+    // must never reorder - blend output depends on submission order
+    // (flat buffers draw in order added; world lists are back-to-front)
+    // - so they go down as plain barrier material.
+    if (!Graphics::IsShaderTransparent(shading_type)) {
+      cmd_buffer_->BeginSortBlock(RenderCommandBuffer::MakeSortKey(
+          static_cast<int>(pass_->type()), static_cast<int>(shading_type)));
+    }
+
     // Go ahead and throw down the shader command.
     cmd_buffer_->PutCommand(RenderCommandBuffer::Command::kShader);
     cmd_buffer_->PutInt(static_cast<int>(shading_type));
@@ -251,10 +283,16 @@ class RenderComponent {
   // their needed data to the stream
   virtual void WriteConfig() = 0;
 
+  // Routes a config write into record_target_'s scratch buffer.
+  void ConfigForTemplateRecord(ShadingType shading_type);
+
  protected:
   RenderCommandBuffer* cmd_buffer_;
   State state_;
   RenderPass* pass_;
+  RenderComponentTemplate* record_target_{};
+  RenderCommandBuffer* record_buffer_{};
+  ShadingType recorded_shading_type_{};
 };
 
 }  // namespace ballistica
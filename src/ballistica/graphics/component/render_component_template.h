@@ -0,0 +1,73 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GRAPHICS_COMPONENT_RENDER_COMPONENT_TEMPLATE_H_
+#define BALLISTICA_GRAPHICS_COMPONENT_RENDER_COMPONENT_TEMPLATE_H_
+
+#include <vector>
+
+#include "ballistica/graphics/render_command_buffer.h"
+
+namespace ballistica {
+
+// A retained copy of a render-component's config command stream.
+// Hot callers whose config rarely changes can record one of these once
+// (via RenderComponent::RecordTemplate) and replay it each frame through
+// a TemplateComponent, paying only for the transform/draw commands
+// instead of a full config write and its texture-ref churn.
+class RenderComponentTemplate {
+ public:
+  auto valid() const -> bool { return valid_; }
+
+  // Call when anything baked into the recorded config (colors, textures,
+  // etc.) changes; the next draw should then re-record.
+  void Invalidate() { valid_ = false; }
+
+  auto shading_type() const -> ShadingType {
+    assert(valid_);
+    return shading_type_;
+  }
+
+  // Store a recorded config stream; called by
+  // RenderComponent::RecordTemplate.
+  void SetContent(ShadingType shading_type,
+                  const RenderCommandBuffer::ContentSnapshot& content) {
+    // Configs never contain draws, so these should always be empty.
+    assert(content.models.empty());
+    assert(content.mesh_datas.empty());
+    shading_type_ = shading_type;
+    commands_ = content.commands;
+    fvals_ = content.fvals;
+    ivals_ = content.ivals;
+    textures_.clear();
+    textures_.reserve(content.textures.size());
+    for (auto&& t : content.textures) {
+      textures_.emplace_back(t);
+    }
+    valid_ = true;
+  }
+
+  // Append our recorded stream to a buffer. Textures go through
+  // PutTexture individually so frame refs and sort-key folding still
+  // apply.
+  void WriteTo(RenderCommandBuffer* buffer) const {
+    assert(valid_);
+    buffer->PutRecordedRun(commands_, fvals_, ivals_);
+    for (auto&& t : textures_) {
+      buffer->PutTexture(t.get());
+    }
+  }
+
+ private:
+  ShadingType shading_type_{};
+  std::vector<RenderCommandBuffer::Command> commands_;
+  std::vector<float> fvals_;
+  std::vector<int> ivals_;
+
+  // Strong refs; we keep recorded textures alive across frames.
+  std::vector<Object::Ref<TextureData>> textures_;
+  bool valid_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GRAPHICS_COMPONENT_RENDER_COMPONENT_TEMPLATE_H_
@@ -65,6 +65,16 @@ void SimpleComponent::WriteConfig() {
           cmd_buffer_->PutInt(premultiplied_);
           cmd_buffer_->PutFloats(color_r_, color_g_, color_b_, color_a_);
           cmd_buffer_->PutTexture(texture_);
+        } else if (sdf_) {
+          assert(!mask_texture_.exists());      // unimplemented combo
+          assert(!mask_uv2_texture_.exists());  // unimplemented combo
+          assert(glow_amount_ == 0.0f);         // unimplemented combo
+          assert(shadow_opacity_ == 0.0f);      // unimplemented combo
+          assert(flatness_ == 0.0f);            // unimplemented combo
+          ConfigForShading(ShadingType::kSimpleTextureModulatedTransparentSDF);
+          cmd_buffer_->PutInt(premultiplied_);
+          cmd_buffer_->PutFloats(color_r_, color_g_, color_b_, color_a_);
+          cmd_buffer_->PutTexture(texture_);
         } else {
           if (shadow_opacity_ > 0.0f) {
             assert(!mask_texture_.exists());  // unimplemented combo
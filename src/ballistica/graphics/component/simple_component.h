@@ -35,7 +35,8 @@ class SimpleComponent : public RenderComponent {
         premultiplied_(false),
         have_color_(false),
         double_sided_(false),
-        do_colorize_2_(false) {}
+        do_colorize_2_(false),
+        sdf_(false) {}
   void SetPremultiplied(bool val) {
     EnsureConfiguring();
     premultiplied_ = val;
@@ -156,6 +157,13 @@ class SimpleComponent : public RenderComponent {
     EnsureConfiguring();
     flatness_ = flatness;
   }
+  // Treat the texture's alpha as a signed distance field instead of
+  // coverage (transparent textured draws only). Glyphs rendered this way
+  // stay crisp at any scale from a single small atlas.
+  void SetSDF(bool val) {
+    EnsureConfiguring();
+    sdf_ = val;
+  }
 
  protected:
   void WriteConfig() override;
@@ -178,6 +186,7 @@ class SimpleComponent : public RenderComponent {
   bool premultiplied_;
   bool have_color_;
   bool double_sided_;
+  bool sdf_;
 };
 
 }  // namespace ballistica
@@ -0,0 +1,32 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/graphics/component/template_component.h"
+
+namespace ballistica {
+
+void TemplateComponent::WriteConfig() {
+  assert(template_.valid());
+  ShadingType shading_type = template_.shading_type();
+#if BA_DEBUG_BUILD
+  ConfigForShadingDebugChecks(shading_type);
+#endif
+
+  // Mirror ConfigForShading's buffer selection and sort-block setup,
+  // but replay the recorded stream instead of writing a fresh config.
+  if (pass_->UsesWorldLists()) {
+    cmd_buffer_ = pass_->GetCommands(shading_type);
+  } else {
+    if (Graphics::IsShaderTransparent(shading_type)) {
+      cmd_buffer_ = pass_->commands_flat_transparent();
+    } else {
+      cmd_buffer_ = pass_->commands_flat();
+    }
+  }
+  if (!Graphics::IsShaderTransparent(shading_type)) {
+    cmd_buffer_->BeginSortBlock(RenderCommandBuffer::MakeSortKey(
+        static_cast<int>(pass_->type()), static_cast<int>(shading_type)));
+  }
+  template_.WriteTo(cmd_buffer_);
+}
+
+}  // namespace ballistica
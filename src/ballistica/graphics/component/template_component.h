@@ -0,0 +1,28 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GRAPHICS_COMPONENT_TEMPLATE_COMPONENT_H_
+#define BALLISTICA_GRAPHICS_COMPONENT_TEMPLATE_COMPONENT_H_
+
+#include "ballistica/graphics/component/render_component.h"
+#include "ballistica/graphics/component/render_component_template.h"
+
+namespace ballistica {
+
+// Draws using a config previously recorded into a
+// RenderComponentTemplate; only transform/draw commands get written
+// per-submit. The template must remain valid until Submit().
+class TemplateComponent : public RenderComponent {
+ public:
+  TemplateComponent(RenderPass* pass, const RenderComponentTemplate& temp)
+      : RenderComponent(pass), template_(temp) {}
+
+ protected:
+  void WriteConfig() override;
+
+ private:
+  const RenderComponentTemplate& template_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GRAPHICS_COMPONENT_TEMPLATE_COMPONENT_H_
@@ -2,7 +2,9 @@
 
 #include "ballistica/graphics/frame_def.h"
 
+#include "ballistica/generic/job_pool.h"
 #include "ballistica/graphics/camera.h"
+#include "ballistica/graphics/graphics.h"
 #include "ballistica/graphics/graphics_server.h"
 #include "ballistica/graphics/render_pass.h"
 #include "ballistica/graphics/renderer.h"
@@ -30,10 +32,12 @@ FrameDef::~FrameDef() { assert(InGameThread()); }
 
 void FrameDef::Reset() {
   assert(InGameThread());
+  arena_.Reset();
   real_time_ = 0;
   base_time_ = 0;
   base_time_elapsed_ = 0;
   frame_number_ = 0;
+  input_arrival_time_ = -1;
 
 #if BA_DEBUG_BUILD
   defining_component_ = false;
@@ -81,19 +85,35 @@ void FrameDef::Reset() {
 
 void FrameDef::Finalize() {
   assert(!defining_component_);
-  light_pass_->Finalize();
-  light_shadow_pass_->Finalize();
-  beauty_pass_->Finalize();
-  beauty_pass_bg_->Finalize();
-  overlay_pass_->Finalize();
-  overlay_front_pass_->Finalize();
+
+  // Each pass's finalization (sorting command blocks, etc) only touches
+  // that pass's own buffers, so farm the passes out to the worker pool
+  // when we've got one. (the full per-pass *fill* can't go wide this way
+  // since node draws write to several passes at once).
+  JobPool* pool = g_graphics->frame_def_job_pool();
+  auto finalize_pass = [pool](RenderPass* pass) {
+    if (pool && pool->worker_count() > 0) {
+      pool->AddJob([pass] { pass->Finalize(); });
+    } else {
+      pass->Finalize();
+    }
+  };
+  finalize_pass(light_pass_.get());
+  finalize_pass(light_shadow_pass_.get());
+  finalize_pass(beauty_pass_.get());
+  finalize_pass(beauty_pass_bg_.get());
+  finalize_pass(overlay_pass_.get());
+  finalize_pass(overlay_front_pass_.get());
   if (IsVRMode()) {
-    overlay_fixed_pass_->Finalize();
-    overlay_flat_pass_->Finalize();
-    vr_cover_pass_->Finalize();
+    finalize_pass(overlay_fixed_pass_.get());
+    finalize_pass(overlay_flat_pass_.get());
+    finalize_pass(vr_cover_pass_.get());
+  }
+  finalize_pass(overlay_3d_pass_.get());
+  finalize_pass(blit_pass_.get());
+  if (pool) {
+    pool->Wait();
   }
-  overlay_3d_pass_->Finalize();
-  blit_pass_->Finalize();
 }
 
 void FrameDef::AddMesh(Mesh* mesh) {
@@ -164,6 +184,14 @@ void FrameDef::AddMesh(Mesh* mesh) {
         mesh_buffers_.emplace_back(m->data());
         break;
       }
+      case MeshDataType::kSpriteInstanced: {
+        auto* m = static_cast<SpriteMeshInstanced*>(mesh);
+        assert(m);
+        assert(m == dynamic_cast<SpriteMeshInstanced*>(mesh));
+        // No index data; the renderer owns the static quad indices.
+        mesh_buffers_.emplace_back(m->data());
+        break;
+      }
       default:
         throw Exception();
     }
@@ -6,6 +6,7 @@
 #include <memory>
 #include <vector>
 
+#include "ballistica/generic/linear_arena.h"
 #include "ballistica/math/matrix44f.h"
 #include "ballistica/math/vector2f.h"
 #include "ballistica/media/data/media_component_data.h"
@@ -55,6 +56,10 @@ class FrameDef {
   auto real_time() const -> millisecs_t { return real_time_; }
   auto frame_number() const -> int64_t { return frame_number_; }
 
+  // Arrival time (usecs) of the oldest input event first reflected by
+  // this frame, or -1; see InputLatencyMeter.
+  auto input_arrival_time() const -> int64_t { return input_arrival_time_; }
+
   // Returns the bsGame master-net-time when this was made
   // (tries to match real time but is incremented more smoothly
   // so is better for drawing purposes)
@@ -109,6 +114,13 @@ class FrameDef {
     }
   }
   void AddMesh(Mesh* mesh);
+
+  // Frame-scoped scratch memory: valid from the start of this frame's
+  // build until the def is reset for reuse (after the graphics thread
+  // is done rendering it and hands it back). Safe to allocate from in
+  // finalize jobs on worker threads.
+  auto arena() -> LinearArena* { return &arena_; }
+
   void set_needs_clear(bool val) { needs_clear_ = val; }
   auto needs_clear() const -> bool { return needs_clear_; }
 
@@ -121,6 +133,7 @@ class FrameDef {
   void set_real_time(millisecs_t val) { real_time_ = val; }
   void set_base_time(millisecs_t val) { base_time_ = val; }
   void set_frame_number(int64_t val) { frame_number_ = val; }
+  void set_input_arrival_time(int64_t val) { input_arrival_time_ = val; }
 
   auto overlay_flat_pass() const -> RenderPass* {
     return overlay_flat_pass_.get();
@@ -172,6 +185,7 @@ class FrameDef {
 #endif
 
  private:
+  LinearArena arena_;
   bool needs_clear_{};
   BenchmarkType benchmark_type_{BenchmarkType::kNone};
   bool rendering_{};
@@ -214,6 +228,7 @@ class FrameDef {
   millisecs_t base_time_{};
   millisecs_t base_time_elapsed_{};
   int64_t frame_number_{};
+  int64_t input_arrival_time_{-1};
   Vector3f shadow_offset_{0.0f, 0.0f, 0.0f};
   Vector2f shadow_scale_{1.0f, 1.0f};
   bool shadow_ortho_{};
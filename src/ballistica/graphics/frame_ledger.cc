@@ -0,0 +1,230 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/graphics/frame_ledger.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+
+std::atomic<bool> FrameLedger::enabled_{};
+std::atomic<bool> FrameLedger::tracing_{};
+std::atomic<bool> FrameLedger::flight_armed_{};
+std::atomic<int64_t> FrameLedger::lanes_[FrameLedger::kLaneCount]{};
+std::atomic<int64_t> FrameLedger::totals_[FrameLedger::kLaneCount]{};
+
+// Trace capture state; guarded by g_trace_mutex (trace capture is a
+// diagnostic path; contention there doesn't matter).
+struct TraceEvent {
+  int lane;
+  int64_t ts_usecs;
+  int64_t duration_usecs;
+};
+static std::mutex g_trace_mutex;
+static std::vector<TraceEvent>* g_trace_events{};
+static std::string* g_trace_path{};
+static int64_t g_trace_start_usecs{};
+static bool g_trace_restore_disabled{};
+
+auto FrameLedger::StartTrace(const std::string& path) -> bool {
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  if (tracing_.load()) {
+    return false;
+  }
+  if (g_trace_events == nullptr) {
+    g_trace_events = new std::vector<TraceEvent>();
+    g_trace_path = new std::string();
+  }
+  g_trace_events->clear();
+  g_trace_events->reserve(64 * 1024);
+  *g_trace_path = path;
+  g_trace_start_usecs = Platform::GetCurrentMicroseconds();
+
+  // Force publishing on for the capture; put it back how we found it
+  // when we stop.
+  g_trace_restore_disabled = !enabled();
+  set_enabled(true);
+  tracing_.store(true);
+  return true;
+}
+
+auto FrameLedger::StopTrace() -> std::string {
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  if (!tracing_.load()) {
+    return "";
+  }
+  tracing_.store(false);
+  if (g_trace_restore_disabled) {
+    set_enabled(false);
+  }
+  FILE* f = fopen(g_trace_path->c_str(), "w");
+  if (f == nullptr) {
+    g_trace_events->clear();
+    return "";
+  }
+  fprintf(f, "{\"traceEvents\":[");
+  bool first = true;
+  for (auto&& e : *g_trace_events) {
+    fprintf(f,
+            "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+            "\"ts\":%lld,\"dur\":%lld}",
+            first ? "" : ",", LaneName(static_cast<Lane>(e.lane)), e.lane,
+            static_cast<long long>(e.ts_usecs),  // NOLINT
+            static_cast<long long>(e.duration_usecs));  // NOLINT
+    first = false;
+  }
+  fprintf(f, "]}");
+  fclose(f);
+  g_trace_events->clear();
+  return *g_trace_path;
+}
+
+void FrameLedger::AddTraceEvent(Lane lane, int64_t usecs) {
+  int64_t now = Platform::GetCurrentMicroseconds();
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  if (!tracing_.load() || g_trace_events == nullptr) {
+    return;
+  }
+  // Events are emitted at slice-end; chrome wants the start timestamp.
+  g_trace_events->push_back(
+      TraceEvent{static_cast<int>(lane),
+                 now - g_trace_start_usecs - usecs, usecs});
+}
+
+// Flight-recorder state; the ring shares g_trace_mutex with trace
+// capture (both are diagnostic paths; a handful of short holds per
+// frame is nothing).
+const int kFlightRingSize = 4096;
+const int64_t kFlightCaptureCooldownUsecs = 10 * 1000 * 1000;
+static TraceEvent g_flight_ring[kFlightRingSize];
+static int64_t g_flight_write_count{};
+static std::string* g_flight_path_prefix{};
+static int64_t g_flight_threshold_usecs{};
+static int64_t g_flight_window_usecs{};
+static int64_t g_flight_last_capture_usecs{};
+static int g_flight_capture_count{};
+static bool g_flight_restore_disabled{};
+
+auto FrameLedger::ArmFlightRecorder(const std::string& path_prefix,
+                                    int threshold_ms, int window_ms) -> bool {
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  if (flight_armed_.load()) {
+    return false;
+  }
+  if (g_flight_path_prefix == nullptr) {
+    g_flight_path_prefix = new std::string();
+  }
+  *g_flight_path_prefix = path_prefix;
+  g_flight_threshold_usecs = static_cast<int64_t>(threshold_ms) * 1000;
+  g_flight_window_usecs = static_cast<int64_t>(window_ms) * 1000;
+  g_flight_write_count = 0;
+  g_flight_last_capture_usecs = 0;
+
+  // Lanes need to publish for the ring to see anything; put the flag
+  // back how we found it when we disarm.
+  g_flight_restore_disabled = !enabled();
+  set_enabled(true);
+  flight_armed_.store(true);
+  return true;
+}
+
+void FrameLedger::DisarmFlightRecorder() {
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  if (!flight_armed_.load()) {
+    return;
+  }
+  flight_armed_.store(false);
+  if (g_flight_restore_disabled) {
+    set_enabled(false);
+  }
+}
+
+void FrameLedger::AddFlightEvent(Lane lane, int64_t usecs) {
+  int64_t now = Platform::GetCurrentMicroseconds();
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  if (!flight_armed_.load()) {
+    return;
+  }
+  g_flight_ring[g_flight_write_count % kFlightRingSize] =
+      TraceEvent{static_cast<int>(lane), now - usecs, usecs};
+  g_flight_write_count++;
+}
+
+void FrameLedger::NoteFrameTime(int64_t usecs) {
+  if (!flight_armed_.load(std::memory_order_relaxed)
+      || usecs < g_flight_threshold_usecs) {
+    return;
+  }
+  int64_t now = Platform::GetCurrentMicroseconds();
+  std::lock_guard<std::mutex> lock(g_trace_mutex);
+  if (!flight_armed_.load()
+      || now - g_flight_last_capture_usecs < kFlightCaptureCooldownUsecs) {
+    return;
+  }
+  g_flight_last_capture_usecs = now;
+  g_flight_capture_count++;
+  std::string path = *g_flight_path_prefix + "_spike"
+                     + std::to_string(g_flight_capture_count) + ".json";
+  FILE* f = fopen(path.c_str(), "w");
+  if (f == nullptr) {
+    Log("FrameLedger: unable to write spike capture to '" + path + "'.");
+    return;
+  }
+  int64_t window_start = now - g_flight_window_usecs;
+  int64_t available = std::min(g_flight_write_count,
+                               static_cast<int64_t>(kFlightRingSize));
+  fprintf(f, "{\"traceEvents\":[");
+
+  // The spiking update itself first, then whatever the ring still holds
+  // from the preceding window.
+  fprintf(f,
+          "{\"name\":\"update-spike\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+          "\"ts\":%lld,\"dur\":%lld}",
+          kLaneCount, static_cast<long long>(g_flight_window_usecs - usecs),
+          static_cast<long long>(usecs));  // NOLINT
+  int events_written = 0;
+  for (int64_t i = g_flight_write_count - available; i < g_flight_write_count;
+       i++) {
+    const TraceEvent& e = g_flight_ring[i % kFlightRingSize];
+    if (e.ts_usecs < window_start) {
+      continue;
+    }
+    fprintf(f,
+            ",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+            "\"ts\":%lld,\"dur\":%lld}",
+            LaneName(static_cast<Lane>(e.lane)), e.lane,
+            static_cast<long long>(e.ts_usecs - window_start),  // NOLINT
+            static_cast<long long>(e.duration_usecs));  // NOLINT
+    events_written++;
+  }
+  fprintf(f, "]}");
+  fclose(f);
+  Log("FrameLedger: captured " + std::to_string(usecs / 1000)
+      + "ms spike to '" + path + "' (" + std::to_string(events_written)
+      + " events).");
+}
+
+auto FrameLedger::LaneName(Lane lane) -> const char* {
+  switch (lane) {
+    case Lane::kStep:
+      return "step";
+    case Lane::kFrameBuild:
+      return "fbuild";
+    case Lane::kRender:
+      return "render";
+    case Lane::kAudio:
+      return "audio";
+    case Lane::kBGDynamics:
+      return "bgdyn";
+    case Lane::kNet:
+      return "net";
+  }
+  return "";
+}
+
+}  // namespace ballistica
@@ -0,0 +1,103 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GRAPHICS_FRAME_LEDGER_H_
+#define BALLISTICA_GRAPHICS_FRAME_LEDGER_H_
+
+#include <atomic>
+#include <string>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+/// Shared per-frame cost ledger. Modules publish how long their slice
+/// of the current frame took (lock-free; just relaxed atomic adds from
+/// whatever thread the work ran on) and the frame-ledger overlay drains
+/// the lot once per drawn frame into a stacked multi-lane graph (see
+/// Graphics::DrawMiscOverlays). Publishing is a no-op while the overlay
+/// is off, so lanes cost nothing in normal play.
+class FrameLedger {
+ public:
+  enum class Lane { kStep, kFrameBuild, kRender, kAudio, kBGDynamics, kNet };
+  static const int kLaneCount = static_cast<int>(Lane::kNet) + 1;
+
+  static auto enabled() -> bool {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+  static void set_enabled(bool val) {
+    enabled_.store(val, std::memory_order_relaxed);
+  }
+
+  /// Add time spent onto a lane's tally for the current frame.
+  static void Add(Lane lane, int64_t usecs) {
+    lanes_[static_cast<int>(lane)].fetch_add(usecs,
+                                             std::memory_order_relaxed);
+    totals_[static_cast<int>(lane)].fetch_add(usecs,
+                                              std::memory_order_relaxed);
+    if (tracing_.load(std::memory_order_relaxed)) {
+      AddTraceEvent(lane, usecs);
+    }
+    if (flight_armed_.load(std::memory_order_relaxed)) {
+      AddFlightEvent(lane, usecs);
+    }
+  }
+
+  /// Lifetime per-lane totals (never reset); fleet tooling polls these
+  /// and differences successive samples for rates.
+  static void GetTotals(int64_t* out) {
+    for (int i = 0; i < kLaneCount; i++) {
+      out[i] = totals_[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  /// Chrome-trace capture: while active, every published lane slice is
+  /// recorded as a trace event; StopTrace() writes the lot as a
+  /// chrome://tracing - loadable json file. Publishing is forced on for
+  /// the duration.
+  static auto StartTrace(const std::string& path) -> bool;
+  static auto StopTrace() -> std::string;
+  static auto tracing() -> bool {
+    return tracing_.load(std::memory_order_relaxed);
+  }
+
+  /// Flight-recorder mode: while armed, lane slices also land in a
+  /// fixed-size ring that's always recording, and whenever
+  /// NoteFrameTime() sees a game update blow past the threshold, the
+  /// window of events preceding it gets written out as its own
+  /// chrome-trace file. Continuous tracing is too heavy to leave on,
+  /// but this catches the once-a-minute spike retroactively.
+  static auto ArmFlightRecorder(const std::string& path_prefix,
+                                int threshold_ms, int window_ms) -> bool;
+  static void DisarmFlightRecorder();
+  static auto flight_recorder_armed() -> bool {
+    return flight_armed_.load(std::memory_order_relaxed);
+  }
+
+  /// Feed each game-update's duration in; fires a spike capture when
+  /// the flight recorder is armed and the threshold is crossed.
+  static void NoteFrameTime(int64_t usecs);
+
+  /// Pull (and zero) all lane tallies; called once per drawn frame by
+  /// the overlay.
+  static void Drain(int64_t* out) {
+    for (int i = 0; i < kLaneCount; i++) {
+      out[i] = lanes_[i].exchange(0, std::memory_order_relaxed);
+    }
+  }
+
+  static auto LaneName(Lane lane) -> const char*;
+
+ private:
+  static void AddTraceEvent(Lane lane, int64_t usecs);
+  static void AddFlightEvent(Lane lane, int64_t usecs);
+
+  static std::atomic<bool> enabled_;
+  static std::atomic<bool> tracing_;
+  static std::atomic<bool> flight_armed_;
+  static std::atomic<int64_t> lanes_[kLaneCount];
+  static std::atomic<int64_t> totals_[kLaneCount];
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GRAPHICS_FRAME_LEDGER_H_
@@ -40,6 +40,8 @@
 
 #if BA_OSTYPE_ANDROID
 PFNGLDISCARDFRAMEBUFFEREXTPROC _glDiscardFramebufferEXT = nullptr;
+PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC glFramebufferTextureMultiviewOVR =
+    nullptr;
 #endif
 
 #if BA_OSTYPE_WINDOWS
@@ -79,6 +81,7 @@ PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers = nullptr;
 PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer = nullptr;
 PFNGLBINDBUFFERPROC glBindBuffer = nullptr;
 PFNGLBUFFERDATAPROC glBufferData = nullptr;
+PFNGLBUFFERSUBDATAPROC glBufferSubData = nullptr;
 PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage = nullptr;
 PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC glRenderbufferStorageMultisample =
     nullptr;
@@ -101,6 +104,16 @@ PFNGLDELETEPROGRAMPROC glDeleteProgram = nullptr;
 PFNGLDETACHSHADERPROC glDetachShader = nullptr;
 PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog = nullptr;
 PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog = nullptr;
+PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor = nullptr;
+PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced = nullptr;
+PFNGLGETPROGRAMBINARYPROC glGetProgramBinary = nullptr;
+PFNGLPROGRAMBINARYPROC glProgramBinary = nullptr;
+PFNGLPROGRAMPARAMETERIPROC glProgramParameteri = nullptr;
+PFNGLGENQUERIESPROC glGenQueries = nullptr;
+PFNGLDELETEQUERIESPROC glDeleteQueries = nullptr;
+PFNGLBEGINQUERYPROC glBeginQuery = nullptr;
+PFNGLENDQUERYPROC glEndQuery = nullptr;
+PFNGLGETQUERYOBJECTUIVPROC glGetQueryObjectuiv = nullptr;
 #endif  // BA_OSTYPE_WINDOWS
 
 namespace ballistica {
@@ -208,6 +221,8 @@ GLContext::GLContext(int target_res_x, int target_res_y, bool fullscreen)
     BA_PRECONDITION(FUNC != nullptr);                        \
   }
   GET(PFNGLDISCARDFRAMEBUFFEREXTPROC, _glDiscardFramebufferEXT, false);
+  GET(PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC,
+      glFramebufferTextureMultiviewOVR, false);
 #endif  // BA_OSTYPE_ANDROID
 
   // Fetch needed windows gl stuff.
@@ -253,6 +268,7 @@ GLContext::GLContext(int target_res_x, int target_res_y, bool fullscreen)
   GET(PFNGLBINDRENDERBUFFERPROC, glBindRenderbuffer, true);
   GET(PFNGLBINDBUFFERPROC, glBindBuffer, true);
   GET(PFNGLBUFFERDATAPROC, glBufferData, true);
+  GET(PFNGLBUFFERSUBDATAPROC, glBufferSubData, true);
   GET(PFNGLRENDERBUFFERSTORAGEPROC, glRenderbufferStorage, true);
   GET(PFNGLFRAMEBUFFERRENDERBUFFERPROC, glFramebufferRenderbuffer, true);
   GET(PFNGLCHECKFRAMEBUFFERSTATUSPROC, glCheckFramebufferStatus, true);
@@ -280,6 +296,16 @@ GLContext::GLContext(int target_res_x, int target_res_y, bool fullscreen)
   GET(PFNGLBLITFRAMEBUFFERPROC, glBlitFramebuffer, false);
   GET(PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC, glRenderbufferStorageMultisample,
       false);
+  GET(PFNGLVERTEXATTRIBDIVISORPROC, glVertexAttribDivisor, false);
+  GET(PFNGLDRAWELEMENTSINSTANCEDPROC, glDrawElementsInstanced, false);
+  GET(PFNGLGETPROGRAMBINARYPROC, glGetProgramBinary, false);
+  GET(PFNGLPROGRAMBINARYPROC, glProgramBinary, false);
+  GET(PFNGLPROGRAMPARAMETERIPROC, glProgramParameteri, false);
+  GET(PFNGLGENQUERIESPROC, glGenQueries, false);
+  GET(PFNGLDELETEQUERIESPROC, glDeleteQueries, false);
+  GET(PFNGLBEGINQUERYPROC, glBeginQuery, false);
+  GET(PFNGLENDQUERYPROC, glEndQuery, false);
+  GET(PFNGLGETQUERYOBJECTUIVPROC, glGetQueryObjectuiv, false);
 
 #undef GET
 #endif  // BA_OSTYPE_WINDOWS
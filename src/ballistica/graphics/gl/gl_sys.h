@@ -45,6 +45,12 @@
 #define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
 #endif
 
+// es2 headers lack this one (base-level control is es3+; check at
+// runtime before using).
+#ifndef GL_TEXTURE_BASE_LEVEL
+#define GL_TEXTURE_BASE_LEVEL 0x813C
+#endif
+
 #else  // BA_OSTYPE_IOS_TVOS || BA_OSTYPE_ANDROID
 
 #if BA_SDL2_BUILD
@@ -65,6 +71,20 @@
 
 #if BA_OSTYPE_ANDROID
 extern PFNGLDISCARDFRAMEBUFFEREXTPROC _glDiscardFramebufferEXT;
+
+// Single-pass stereo bits from OVR_multiview/OVR_multiview2; absent from
+// the raw GLES2 include set.
+#ifndef GL_OVR_multiview
+#define GL_OVR_multiview 1
+#define GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_NUM_VIEWS_OVR 0x9630
+#define GL_MAX_VIEWS_OVR 0x9631
+#define GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_BASE_VIEW_INDEX_OVR 0x9632
+#define GL_FRAMEBUFFER_INCOMPLETE_VIEW_TARGETS_OVR 0x9633
+typedef void(GL_APIENTRYP PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC)(
+    GLenum target, GLenum attachment, GLuint texture, GLint level,
+    GLint baseViewIndex, GLsizei numViews);
+#endif  // GL_OVR_multiview
+extern PFNGLFRAMEBUFFERTEXTUREMULTIVIEWOVRPROC glFramebufferTextureMultiviewOVR;
 #endif
 
 #if BA_OSTYPE_WINDOWS
@@ -109,6 +129,7 @@ extern PFNGLGENRENDERBUFFERSPROC glGenRenderbuffers;
 extern PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer;
 extern PFNGLBINDBUFFERPROC glBindBuffer;
 extern PFNGLBUFFERDATAPROC glBufferData;
+extern PFNGLBUFFERSUBDATAPROC glBufferSubData;
 extern PFNGLRENDERBUFFERSTORAGEPROC glRenderbufferStorage;
 extern PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC glRenderbufferStorageMultisample;
 extern PFNGLFRAMEBUFFERRENDERBUFFERPROC glFramebufferRenderbuffer;
@@ -130,8 +151,86 @@ extern PFNGLDELETEPROGRAMPROC glDeleteProgram;
 extern PFNGLDETACHSHADERPROC glDetachShader;
 extern PFNGLGETSHADERINFOLOGPROC glGetShaderInfoLog;
 extern PFNGLGETPROGRAMINFOLOGPROC glGetProgramInfoLog;
+extern PFNGLVERTEXATTRIBDIVISORPROC glVertexAttribDivisor;
+extern PFNGLDRAWELEMENTSINSTANCEDPROC glDrawElementsInstanced;
+extern PFNGLGETPROGRAMBINARYPROC glGetProgramBinary;
+extern PFNGLPROGRAMBINARYPROC glProgramBinary;
+extern PFNGLPROGRAMPARAMETERIPROC glProgramParameteri;
+extern PFNGLGENQUERIESPROC glGenQueries;
+extern PFNGLDELETEQUERIESPROC glDeleteQueries;
+extern PFNGLBEGINQUERYPROC glBeginQuery;
+extern PFNGLENDQUERYPROC glEndQuery;
+extern PFNGLGETQUERYOBJECTUIVPROC glGetQueryObjectuiv;
 #endif  // BA_OSTYPE_WINDOWS
 
+// Whether instanced-array entry points exist at compile time. The raw
+// GLES2 include set and legacy mac glext predate them; everywhere else we
+// still check for support at runtime before using them.
+#if BA_OSTYPE_IOS_TVOS || BA_OSTYPE_ANDROID
+#if BA_USE_ES3_INCLUDES
+#define BA_GL_HAVE_INSTANCED_ARRAYS 1
+#else
+#define BA_GL_HAVE_INSTANCED_ARRAYS 0
+#endif
+#elif BA_OSTYPE_MACOS
+#define BA_GL_HAVE_INSTANCED_ARRAYS 0
+#else
+#define BA_GL_HAVE_INSTANCED_ARRAYS 1
+#endif
+
+// Same availability story for the program-binary entry points
+// (ES3 or the desktop get_program_binary extension).
+#if BA_OSTYPE_IOS_TVOS || BA_OSTYPE_ANDROID
+#if BA_USE_ES3_INCLUDES
+#define BA_GL_HAVE_PROGRAM_BINARY 1
+#else
+#define BA_GL_HAVE_PROGRAM_BINARY 0
+#endif
+#elif BA_OSTYPE_MACOS
+#define BA_GL_HAVE_PROGRAM_BINARY 0
+#else
+#define BA_GL_HAVE_PROGRAM_BINARY 1
+#endif
+
+// Query entry points are core desktop GL and ES3; the raw GLES2 include
+// set only has EXT-suffixed variants so we skip GPU timing there.
+// (time-elapsed support itself still gets checked at runtime).
+#if BA_OSTYPE_IOS_TVOS || BA_OSTYPE_ANDROID
+#if BA_USE_ES3_INCLUDES
+#define BA_GL_HAVE_TIMER_QUERY 1
+#else
+#define BA_GL_HAVE_TIMER_QUERY 0
+#endif
+#else
+#define BA_GL_HAVE_TIMER_QUERY 1
+#endif
+
+// Same value as GL_TIME_ELAPSED_EXT from EXT_disjoint_timer_query.
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+// Packed 2_10_10_10 vertex attribs (ES3 or the desktop
+// vertex_type_2_10_10_10_rev extension; absent from the raw GLES2
+// include set and legacy mac glext).
+#if BA_OSTYPE_IOS_TVOS || BA_OSTYPE_ANDROID
+#if BA_USE_ES3_INCLUDES
+#define BA_GL_HAVE_PACKED_NORMALS 1
+#else
+#define BA_GL_HAVE_PACKED_NORMALS 0
+#endif
+#elif BA_OSTYPE_MACOS
+#define BA_GL_HAVE_PACKED_NORMALS 0
+#else
+#define BA_GL_HAVE_PACKED_NORMALS 1
+#endif
+
+#if BA_GL_HAVE_PACKED_NORMALS
+#ifndef GL_INT_2_10_10_10_REV
+#define GL_INT_2_10_10_10_REV 0x8D9F
+#endif
+#endif  // BA_GL_HAVE_PACKED_NORMALS
+
 #ifndef GL_NV_texture_rectangle
 #define GL_TEXTURE_RECTANGLE_NV 0x84F5
 #define GL_TEXTURE_BINDING_RECTANGLE_NV 0x84F6
@@ -9,6 +9,7 @@
 #include <memory>
 #include <utility>
 
+#include "ballistica/game/game.h"
 #include "ballistica/graphics/component/special_component.h"
 #include "ballistica/graphics/graphics.h"
 #include "ballistica/graphics/graphics_server.h"
@@ -138,7 +139,13 @@ bool g_invalidate_framebuffer_support{};
 bool g_blit_framebuffer_support{};
 bool g_framebuffer_multisample_support{};
 bool g_running_es3{};
+bool g_timer_query_support{};
+bool g_packed_normal_support{};
+bool g_multiview_support{};
+bool g_standard_derivatives_support{};
 bool g_seamless_cube_maps{};
+bool g_instanced_arrays_support{};
+bool g_program_binary_support{};
 int g_msaa_max_samples_rgb565{};
 int g_msaa_max_samples_rgb8{};
 
@@ -186,7 +193,8 @@ enum ShaderFlag {
   SHD_MASK_UV2 = 1 << 21,
   SHD_CONDITIONAL = 1 << 22,
   SHD_FLATNESS = 1 << 23,
-  SHD_DEPTH_BUG_TEST = 1 << 24
+  SHD_DEPTH_BUG_TEST = 1 << 24,
+  SHD_SDF = 1 << 25
 };
 
 // Flags used internally by shaders.
@@ -432,6 +440,94 @@ void RendererGL::CheckGLExtensions() {
        && glBindVertexArray != nullptr
        && (g_running_es3 || CheckGLExtension(ex, "vertex_array_object")));
 
+  // Instanced sprite drawing requires VAOs plus the instanced-array entry
+  // points (ES3 or the desktop extension).
+#if BA_GL_HAVE_INSTANCED_ARRAYS
+#if BA_OSTYPE_WINDOWS
+  g_instanced_arrays_support =
+      (g_vao_support && glVertexAttribDivisor != nullptr
+       && glDrawElementsInstanced != nullptr
+       && CheckGLExtension(ex, "instanced_arrays"));
+#else
+  g_instanced_arrays_support =
+      (g_vao_support
+       && (g_running_es3 || CheckGLExtension(ex, "instanced_arrays")));
+#endif  // BA_OSTYPE_WINDOWS
+#else
+  g_instanced_arrays_support = false;
+#endif
+  g_graphics->set_supports_sprite_instancing(g_instanced_arrays_support);
+
+  // Program binaries let us skip shader compilation on warm launches.
+#if BA_GL_HAVE_PROGRAM_BINARY
+  {
+#if BA_OSTYPE_WINDOWS
+    g_program_binary_support =
+        (glGetProgramBinary != nullptr && glProgramBinary != nullptr
+         && glProgramParameteri != nullptr
+         && CheckGLExtension(ex, "get_program_binary"));
+#else
+    g_program_binary_support =
+        (g_running_es3 || CheckGLExtension(ex, "get_program_binary"));
+#endif  // BA_OSTYPE_WINDOWS
+
+    // Some drivers advertise the entry points but support zero formats.
+    if (g_program_binary_support) {
+      GLint format_count{};
+      glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+      if (format_count < 1) {
+        g_program_binary_support = false;
+      }
+    }
+  }
+#else
+  g_program_binary_support = false;
+#endif  // BA_GL_HAVE_PROGRAM_BINARY
+
+  // GPU timer queries for per-pass profiling (EXT_disjoint_timer_query on
+  // ES; core or the timer_query extensions on desktop).
+#if BA_GL_HAVE_TIMER_QUERY
+#if BA_OSTYPE_WINDOWS
+  g_timer_query_support =
+      (glGenQueries != nullptr && glDeleteQueries != nullptr
+       && glBeginQuery != nullptr && glEndQuery != nullptr
+       && glGetQueryObjectuiv != nullptr && CheckGLExtension(ex, "timer_query"));
+#else
+  g_timer_query_support = CheckGLExtension(ex, "timer_query");
+#endif  // BA_OSTYPE_WINDOWS
+#else
+  g_timer_query_support = false;
+#endif  // BA_GL_HAVE_TIMER_QUERY
+
+  // Single-pass stereo via OVR_multiview2 (VR builds only). The extension
+  // rides on ES3 and we also need the framebuffer attach entry point.
+#if BA_VR_BUILD && BA_OSTYPE_ANDROID
+  g_multiview_support =
+      (g_running_es3 && glFramebufferTextureMultiviewOVR != nullptr
+       && strstr(ex, "GL_OVR_multiview2") != nullptr);
+#else
+  g_multiview_support = false;
+#endif
+
+  // Screen-space derivatives for distance-field text edges; core on
+  // desktop GL and ES3, an extension on ES2. Without them the sdf shader
+  // falls back to a fixed edge softness.
+#if BA_OSTYPE_IOS_TVOS || BA_OSTYPE_ANDROID
+  g_standard_derivatives_support =
+      (g_running_es3 || CheckGLExtension(ex, "standard_derivatives"));
+#else
+  g_standard_derivatives_support = true;
+#endif
+
+  // Packed 2_10_10_10 normals let static model verts drop from 24 to 20
+  // bytes; big workshop maps are mostly mesh data on low-memory devices.
+#if BA_GL_HAVE_PACKED_NORMALS
+  g_packed_normal_support =
+      (g_running_es3 || CheckGLExtension(ex, "vertex_type_2_10_10_10"));
+#else
+  g_packed_normal_support = false;
+#endif  // BA_GL_HAVE_PACKED_NORMALS
+
 #if BA_OSTYPE_IOS_TVOS
   g_blit_framebuffer_support = false;
   g_framebuffer_multisample_support = false;
@@ -660,16 +756,17 @@ class RendererGL::FakeVertexArrayObject {
 
     // First bind our element buffer.
     assert(elem_buffer_ != 0);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elem_buffer_);
+    renderer_->BindElementArrayBuffer(elem_buffer_);
 
     // Now bind/enable the buffers we use and disable the ones we don't.
+    // The renderer's shadow state filters out pointers the driver
+    // already has, so rebinding the same mesh repeatedly (or meshes
+    // sharing layouts and buffers) costs no attribute respecification.
     for (GLuint i = 0; i < kVertexAttrCount; i++) {
       if (attrs_[i].enable) {
-        renderer_->BindArrayBuffer(attrs_[i].buffer);
-        glVertexAttribPointer(i, attrs_[i].elem_count, attrs_[i].elem_type,
-                              static_cast<GLboolean>(attrs_[i].normalized),
-                              attrs_[i].stride,
-                              reinterpret_cast<void*>(attrs_[i].offset));
+        renderer_->SetVertexAttribPointer(
+            i, attrs_[i].buffer, attrs_[i].elem_count, attrs_[i].elem_type,
+            attrs_[i].normalized, attrs_[i].stride, attrs_[i].offset);
       }
       renderer_->SetVertexAttribArrayEnabled(i, attrs_[i].enable);
     }
@@ -1104,53 +1201,73 @@ class RendererGL::VertexShaderGL : public RendererGL::ShaderGL {
 
 class RendererGL::ProgramGL {
  public:
-  ProgramGL(RendererGL* renderer,
-            const Object::Ref<VertexShaderGL>& vertex_shader_in,
-            const Object::Ref<FragmentShaderGL>& fragment_shader_in,
-            std::string name, int pflags)
-      : fragment_shader_(fragment_shader_in),
-        vertex_shader_(vertex_shader_in),
-        renderer_(renderer),
-        pflags_(pflags),
-        name_(std::move(name)) {
+  ProgramGL(RendererGL* renderer, const std::string& vertex_src,
+            const std::string& fragment_src, std::string name, int pflags)
+      : renderer_(renderer), pflags_(pflags), name_(std::move(name)) {
     assert(InGraphicsThread());
     DEBUG_CHECK_GL_ERROR;
     program_ = glCreateProgram();
     BA_PRECONDITION(program_);
-    glAttachShader(program_, fragment_shader_->shader());
-    glAttachShader(program_, vertex_shader_->shader());
-    assert(pflags_ & PFLAG_USES_POSITION_ATTR);
-    if (pflags_ & PFLAG_USES_POSITION_ATTR)
-      glBindAttribLocation(program_, kVertexAttrPosition, "position");
-    if (pflags_ & PFLAG_USES_UV_ATTR)
-      glBindAttribLocation(program_, kVertexAttrUV, "uv");
-    if (pflags_ & PFLAG_USES_NORMAL_ATTR)
-      glBindAttribLocation(program_, kVertexAttrNormal, "normal");
-    if (pflags_ & PFLAG_USES_ERODE_ATTR)
-      glBindAttribLocation(program_, kVertexAttrErode, "erode");
-    if (pflags_ & PFLAG_USES_COLOR_ATTR)
-      glBindAttribLocation(program_, kVertexAttrColor, "color");
-    if (pflags_ & PFLAG_USES_SIZE_ATTR)
-      glBindAttribLocation(program_, kVertexAttrSize, "size");
-    if (pflags_ & PFLAG_USES_DIFFUSE_ATTR)
-      glBindAttribLocation(program_, kVertexAttrDiffuse, "diffuse");
-    if (pflags_ & PFLAG_USES_UV2_ATTR)
-      glBindAttribLocation(program_, kVertexAttrUV2, "uv2");
-    glLinkProgram(program_);
-    GLint linkStatus;
-    glGetProgramiv(program_, GL_LINK_STATUS, &linkStatus);
-    if (linkStatus == GL_FALSE) {
-      Log("Link failed for program '" + name_ + "':\n" + GetInfo());
-    } else {
-      assert(linkStatus == GL_TRUE);
 
-      std::string info = GetInfo();
-      if (!info.empty()
-          && (strstr(info.c_str(), "error:") || strstr(info.c_str(), "warning:")
-              || strstr(info.c_str(), "Error:")
-              || strstr(info.c_str(), "Warning:"))) {
-        Log("WARNING: program using frag shader '" + name_
-            + "' returned info:\n" + info);
+    // If the driver supports program binaries, try to skip the whole
+    // compile/link dance with a cached binary from a previous run.
+    bool loaded_binary = false;
+#if BA_GL_HAVE_PROGRAM_BINARY
+    if (g_program_binary_support) {
+      binary_cache_path_ = GetBinaryCachePath(vertex_src, fragment_src);
+      loaded_binary = TryLoadBinary();
+    }
+#endif
+    if (!loaded_binary) {
+      vertex_shader_ = Object::New<VertexShaderGL>(vertex_src);
+      fragment_shader_ = Object::New<FragmentShaderGL>(fragment_src);
+      glAttachShader(program_, fragment_shader_->shader());
+      glAttachShader(program_, vertex_shader_->shader());
+      assert(pflags_ & PFLAG_USES_POSITION_ATTR);
+      if (pflags_ & PFLAG_USES_POSITION_ATTR)
+        glBindAttribLocation(program_, kVertexAttrPosition, "position");
+      if (pflags_ & PFLAG_USES_UV_ATTR)
+        glBindAttribLocation(program_, kVertexAttrUV, "uv");
+      if (pflags_ & PFLAG_USES_NORMAL_ATTR)
+        glBindAttribLocation(program_, kVertexAttrNormal, "normal");
+      if (pflags_ & PFLAG_USES_ERODE_ATTR)
+        glBindAttribLocation(program_, kVertexAttrErode, "erode");
+      if (pflags_ & PFLAG_USES_COLOR_ATTR)
+        glBindAttribLocation(program_, kVertexAttrColor, "color");
+      if (pflags_ & PFLAG_USES_SIZE_ATTR)
+        glBindAttribLocation(program_, kVertexAttrSize, "size");
+      if (pflags_ & PFLAG_USES_DIFFUSE_ATTR)
+        glBindAttribLocation(program_, kVertexAttrDiffuse, "diffuse");
+      if (pflags_ & PFLAG_USES_UV2_ATTR)
+        glBindAttribLocation(program_, kVertexAttrUV2, "uv2");
+#if BA_GL_HAVE_PROGRAM_BINARY
+      if (g_program_binary_support) {
+        glProgramParameteri(program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT,
+                            GL_TRUE);
+      }
+#endif
+      glLinkProgram(program_);
+      GLint linkStatus;
+      glGetProgramiv(program_, GL_LINK_STATUS, &linkStatus);
+      if (linkStatus == GL_FALSE) {
+        Log("Link failed for program '" + name_ + "':\n" + GetInfo());
+      } else {
+        assert(linkStatus == GL_TRUE);
+
+        std::string info = GetInfo();
+        if (!info.empty()
+            && (strstr(info.c_str(), "error:")
+                || strstr(info.c_str(), "warning:")
+                || strstr(info.c_str(), "Error:")
+                || strstr(info.c_str(), "Warning:"))) {
+          Log("WARNING: program using frag shader '" + name_
+              + "' returned info:\n" + info);
+        }
+#if BA_GL_HAVE_PROGRAM_BINARY
+        if (g_program_binary_support) {
+          StoreBinary();
+        }
+#endif
       }
     }
 
@@ -1188,8 +1305,13 @@ class RendererGL::ProgramGL {
   virtual ~ProgramGL() {
     assert(InGraphicsThread());
     if (!g_graphics_server->renderer_context_lost()) {
-      glDetachShader(program_, fragment_shader_->shader());
-      glDetachShader(program_, vertex_shader_->shader());
+      // (no shader objects exist if we came from a cached binary)
+      if (fragment_shader_.exists()) {
+        glDetachShader(program_, fragment_shader_->shader());
+      }
+      if (vertex_shader_.exists()) {
+        glDetachShader(program_, vertex_shader_->shader());
+      }
       glDeleteProgram(program_);
       DEBUG_CHECK_GL_ERROR;
     }
@@ -1306,7 +1428,104 @@ class RendererGL::ProgramGL {
   auto renderer() const -> RendererGL* { return renderer_; }
 
  private:
+#if BA_GL_HAVE_PROGRAM_BINARY
+  // On-disk program binaries are only valid for the exact driver that
+  // produced them (and our exact shader source), so fold all of that
+  // into the cache file name; a driver update or code change simply
+  // misses the cache and we fall back to compiling.
+  static auto GetBinaryCachePath(const std::string& vertex_src,
+                                 const std::string& fragment_src)
+      -> std::string {
+    static std::string cache_dir;
+    if (cache_dir.empty()) {
+      cache_dir = g_platform->GetConfigDirectory() + BA_DIRSLASH + "cache"
+                  + BA_DIRSLASH + "gl_programs";
+      g_platform->MakeDir(cache_dir, true);
+    }
+    // 64 bit fnv-1a over driver identity, build number, and sources.
+    uint64_t hash = 0xcbf29ce484222325u;
+    auto feed = [&hash](const char* s) {
+      if (s == nullptr) {
+        return;
+      }
+      while (*s != 0) {
+        hash = (hash ^ static_cast<uint8_t>(*s++)) * 0x100000001b3u;
+      }
+    };
+    feed(reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    feed(reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    feed(reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    feed(std::to_string(kAppBuildNumber).c_str());
+    feed(vertex_src.c_str());
+    feed(fragment_src.c_str());
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.bin",
+             static_cast<unsigned long long>(hash));  // NOLINT
+    return cache_dir + BA_DIRSLASH + name;
+  }
+
+  auto TryLoadBinary() -> bool {
+    assert(!binary_cache_path_.empty());
+    FILE* f = g_platform->FOpen(binary_cache_path_.c_str(), "rb");
+    if (f == nullptr) {
+      return false;
+    }
+    uint32_t format{};
+    uint32_t size{};
+    std::vector<uint8_t> data;
+    bool success = (fread(&format, sizeof(format), 1, f) == 1
+                    && fread(&size, sizeof(size), 1, f) == 1 && size > 0
+                    && size < 16 * 1024 * 1024);
+    if (success) {
+      data.resize(size);
+      success = (fread(data.data(), 1, size, f) == size);
+    }
+    fclose(f);
+    if (!success) {
+      return false;
+    }
+    glProgramBinary(program_, static_cast<GLenum>(format), data.data(),
+                    static_cast<GLsizei>(size));
+
+    // A stale/corrupt binary just shows up as a failed 'link'; treat it
+    // like a miss and compile normally.
+    GLint link_status{};
+    glGetProgramiv(program_, GL_LINK_STATUS, &link_status);
+    while (glGetError() != GL_NO_ERROR) {
+    }
+    return (link_status == GL_TRUE);
+  }
+
+  void StoreBinary() {
+    assert(!binary_cache_path_.empty());
+    GLint size{};
+    glGetProgramiv(program_, GL_PROGRAM_BINARY_LENGTH, &size);
+    if (size <= 0) {
+      return;
+    }
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    GLenum format{};
+    GLsizei written{};
+    glGetProgramBinary(program_, size, &written, &format, data.data());
+    if (written <= 0 || glGetError() != GL_NO_ERROR) {
+      return;
+    }
+    if (FILE* f = g_platform->FOpen(binary_cache_path_.c_str(), "wb")) {
+      auto format32 = static_cast<uint32_t>(format);
+      auto size32 = static_cast<uint32_t>(written);
+      bool success = (fwrite(&format32, sizeof(format32), 1, f) == 1
+                      && fwrite(&size32, sizeof(size32), 1, f) == 1
+                      && fwrite(data.data(), 1, size32, f) == size32);
+      fclose(f);
+      if (!success) {
+        g_platform->Remove(binary_cache_path_.c_str());
+      }
+    }
+  }
+#endif  // BA_GL_HAVE_PROGRAM_BINARY
+
   RendererGL* renderer_{};
+  std::string binary_cache_path_;
   Object::Ref<FragmentShaderGL> fragment_shader_;
   Object::Ref<VertexShaderGL> vertex_shader_;
   std::string name_;
@@ -1339,9 +1558,8 @@ class RendererGL::SimpleProgramGL : public RendererGL::ProgramGL {
 
   SimpleProgramGL(RendererGL* renderer, int flags)
       : RendererGL::ProgramGL(
-          renderer, Object::New<VertexShaderGL>(GetVertexCode(flags)),
-          Object::New<FragmentShaderGL>(GetFragmentCode(flags)), GetName(flags),
-          GetPFlags(flags)),
+          renderer, GetVertexCode(flags), GetFragmentCode(flags),
+          GetName(flags), GetPFlags(flags)),
         flags_(flags) {
     if (flags & SHD_TEXTURE) {
       SetTextureUnit("colorTex", kColorTexUnit);
@@ -1483,7 +1701,8 @@ class RendererGL::SimpleProgramGL : public RendererGL::ProgramGL {
            + std::to_string((flags & SHD_MASKED) != 0) + " maskedUV2:"
            + std::to_string((flags & SHD_MASK_UV2) != 0) + " depthBugTest:"
            + std::to_string((flags & SHD_DEPTH_BUG_TEST) != 0)
-           + " flatness:" + std::to_string((flags & SHD_MASK_UV2) != 0);
+           + " flatness:" + std::to_string((flags & SHD_MASK_UV2) != 0)
+           + " sdf:" + std::to_string((flags & SHD_SDF) != 0);
   }
   auto GetPFlags(int flags) -> int {
     int pflags = PFLAG_USES_POSITION_ATTR;
@@ -1525,6 +1744,12 @@ class RendererGL::SimpleProgramGL : public RendererGL::ProgramGL {
   }
   auto GetFragmentCode(int flags) -> std::string {
     std::string s;
+#if (BA_OSTYPE_IOS_TVOS || BA_OSTYPE_ANDROID)
+    // fwidth() needs an extension directive on es2 (and it must precede
+    // any declarations).
+    if ((flags & SHD_SDF) && g_standard_derivatives_support)
+      s += "#extension GL_OES_standard_derivatives : enable\n";
+#endif
     if (flags & SHD_TEXTURE) s += "uniform " LOWP "sampler2D colorTex;\n";
     if ((flags & SHD_COLORIZE))
       s += "uniform " LOWP
@@ -1575,7 +1800,21 @@ class RendererGL::SimpleProgramGL : public RendererGL::ProgramGL {
         if (flags & SHD_MASKED)
           s += "   " MEDIUMP "vec4 mask = texture2D(maskTex,vUV);";
 
-        if (flags & SHD_MODULATE) {
+        if (flags & SHD_SDF) {
+          // Texture alpha holds a signed distance from the glyph edge;
+          // resolve coverage at this pixel's own scale so edges stay
+          // crisp at any text size. Without derivatives we fall back to
+          // a fixed softness (slightly fuzzy magnified but still
+          // resolution-independent).
+          s += "   " MEDIUMP "float sdfDist = texture2D(colorTex,vUV).a;\n";
+          if (g_standard_derivatives_support) {
+            s += "   " MEDIUMP "float sdfW = fwidth(sdfDist);\n";
+          } else {
+            s += "   " MEDIUMP "float sdfW = 0.06;\n";
+          }
+          s += "   gl_FragColor = color * "
+               "vec4(1.0,1.0,1.0,smoothstep(0.5-sdfW,0.5+sdfW,sdfDist))";
+        } else if (flags & SHD_MODULATE) {
           if (flags & SHD_FLATNESS) {
             s += "   " LOWP
                  "vec4 rawTexColor = texture2D(colorTex,vUV);\n"
@@ -1653,9 +1892,8 @@ class RendererGL::ObjectProgramGL : public RendererGL::ProgramGL {
 
   ObjectProgramGL(RendererGL* renderer, int flags)
       : RendererGL::ProgramGL(
-          renderer, Object::New<VertexShaderGL>(GetVertexCode(flags)),
-          Object::New<FragmentShaderGL>(GetFragmentCode(flags)), GetName(flags),
-          GetPFlags(flags)),
+          renderer, GetVertexCode(flags), GetFragmentCode(flags),
+          GetName(flags), GetPFlags(flags)),
         flags_(flags),
         r_(0),
         g_(0),
@@ -1949,9 +2187,8 @@ class RendererGL::SmokeProgramGL : public RendererGL::ProgramGL {
 
   SmokeProgramGL(RendererGL* renderer, int flags)
       : RendererGL::ProgramGL(
-          renderer, Object::New<VertexShaderGL>(GetVertexCode(flags)),
-          Object::New<FragmentShaderGL>(GetFragmentCode(flags)), GetName(flags),
-          GetPFlags(flags)),
+          renderer, GetVertexCode(flags), GetFragmentCode(flags),
+          GetName(flags), GetPFlags(flags)),
         flags_(flags),
         r_(0),
         g_(0),
@@ -2102,9 +2339,8 @@ class RendererGL::BlurProgramGL : public RendererGL::ProgramGL {
 
   BlurProgramGL(RendererGL* renderer, int flags)
       : RendererGL::ProgramGL(
-          renderer, Object::New<VertexShaderGL>(GetVertexCode(flags)),
-          Object::New<FragmentShaderGL>(GetFragmentCode(flags)), GetName(flags),
-          GetPFlags(flags)),
+          renderer, GetVertexCode(flags), GetFragmentCode(flags),
+          GetName(flags), GetPFlags(flags)),
         flags_(flags),
         pixel_size_x_(0.0f),
         pixel_size_y_(0.0f) {
@@ -2225,9 +2461,8 @@ class RendererGL::ShieldProgramGL : public RendererGL::ProgramGL {
 
   ShieldProgramGL(RendererGL* renderer, int flags)
       : RendererGL::ProgramGL(
-          renderer, Object::New<VertexShaderGL>(GetVertexCode(flags)),
-          Object::New<FragmentShaderGL>(GetFragmentCode(flags)), GetName(flags),
-          GetPFlags(flags)),
+          renderer, GetVertexCode(flags), GetFragmentCode(flags),
+          GetName(flags), GetPFlags(flags)),
         flags_(flags) {
     SetTextureUnit("depthTex", kDepthTexUnit);
   }
@@ -2329,9 +2564,8 @@ class RendererGL::PostProcessProgramGL : public RendererGL::ProgramGL {
 
   PostProcessProgramGL(RendererGL* renderer, int flags)
       : RendererGL::ProgramGL(
-          renderer, Object::New<VertexShaderGL>(GetVertexCode(flags)),
-          Object::New<FragmentShaderGL>(GetFragmentCode(flags)), GetName(flags),
-          GetPFlags(flags)),
+          renderer, GetVertexCode(flags), GetFragmentCode(flags),
+          GetName(flags), GetPFlags(flags)),
         flags_(flags),
         dof_near_min_(0),
         dof_near_max_(0),
@@ -2666,9 +2900,8 @@ class RendererGL::SpriteProgramGL : public RendererGL::ProgramGL {
 
   SpriteProgramGL(RendererGL* renderer, int flags)
       : RendererGL::ProgramGL(
-          renderer, Object::New<VertexShaderGL>(GetVertexCode(flags)),
-          Object::New<FragmentShaderGL>(GetFragmentCode(flags)), GetName(flags),
-          GetPFlags(flags)),
+          renderer, GetVertexCode(flags), GetFragmentCode(flags),
+          GetName(flags), GetPFlags(flags)),
         flags_(flags),
         r_(0),
         g_(0),
@@ -2805,6 +3038,10 @@ class RendererGL::SpriteProgramGL : public RendererGL::ProgramGL {
   int flags_;
 };
 
+// Compressed-chain mips at or below this dimension get uploaded
+// up-front when mip-streaming; bigger ones stream in across frames.
+const int kMipStreamImmediateMaxDim = 64;
+
 class RendererGL::TextureDataGL : public TextureRendererData {
  public:
   TextureDataGL(const TextureData& texture_in, RendererGL* renderer_in)
@@ -2944,8 +3181,41 @@ class RendererGL::TextureDataGL : public TextureRendererData {
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
       glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-      int src_level = base_src_level;
-      int level = 0;
+      // With a compressed chain we can come up rendering from just the
+      // small mip tail and stream the big levels in across frames via
+      // StreamMips() (es2 can't move GL_TEXTURE_BASE_LEVEL so it keeps
+      // the full up-front upload; uncompressed paths hand gl one level
+      // and generate the rest, so they also stay all-at-once).
+      bool compressed_chain;
+      switch (preload_data->formats[base_src_level]) {
+        case TextureFormat::kRGBA_8888:
+        case TextureFormat::kRGBA_4444:
+        case TextureFormat::kRGB_565:
+        case TextureFormat::kRGB_888:
+          compressed_chain = false;
+          break;
+        default:
+          compressed_chain = true;
+      }
+#if BA_OSTYPE_IOS_TVOS || BA_OSTYPE_ANDROID
+      bool can_stream_mips = g_running_es3;
+#else
+      bool can_stream_mips = true;
+#endif
+      int first_src_level = base_src_level;
+      if (can_stream_mips && compressed_chain) {
+        while (first_src_level + 1 < kMaxTextureLevels
+               && preload_data->buffers[first_src_level + 1] != nullptr
+               && (preload_data->widths[first_src_level]
+                       > kMipStreamImmediateMaxDim
+                   || preload_data->heights[first_src_level]
+                          > kMipStreamImmediateMaxDim)) {
+          first_src_level++;
+        }
+      }
+
+      int src_level = first_src_level;
+      int level = first_src_level - base_src_level;
       bool all_levels_handled = false;
       while (preload_data->buffers[src_level] != nullptr
              && !all_levels_handled) {
@@ -3013,6 +3283,16 @@ class RendererGL::TextureDataGL : public TextureRendererData {
         level++;
         DEBUG_CHECK_GL_ERROR;
       }
+
+      // If we deferred big levels, point gl at the first resident one
+      // and remember where streaming picks up.
+      if (first_src_level != base_src_level) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL,
+                        first_src_level - base_src_level);
+        DEBUG_CHECK_GL_ERROR;
+        mip_stream_src_base_ = base_src_level;
+        mip_stream_next_src_level_ = first_src_level - 1;
+      }
       GL_LABEL_OBJECT(GL_TEXTURE, texture_, tex_media_->GetName().c_str());
     } else if (tex_media_->texture_type() == TextureType::kCubeMap) {
       // Cube map.
@@ -3107,10 +3387,51 @@ class RendererGL::TextureDataGL : public TextureRendererData {
     DEBUG_CHECK_GL_ERROR;
   }
 
+  auto fully_loaded() const -> bool override {
+    return mip_stream_next_src_level_ < 0;
+  }
+
+  auto StreamMips(size_t byte_budget) -> bool override {
+    assert(InGraphicsThread());
+    if (mip_stream_next_src_level_ < 0) {
+      return true;
+    }
+    const TexturePreloadData* preload_data = &tex_media_->preload_datas()[0];
+    renderer_->BindTexture(GL_TEXTURE_2D, texture_);
+    size_t bytes_uploaded = 0;
+    while (mip_stream_next_src_level_ >= mip_stream_src_base_) {
+      int src_level = mip_stream_next_src_level_;
+      glCompressedTexImage2D(
+          GL_TEXTURE_2D, src_level - mip_stream_src_base_,
+          GetGLTextureFormat(preload_data->formats[src_level]),
+          preload_data->widths[src_level], preload_data->heights[src_level], 0,
+          static_cast_check_fit<GLsizei>(preload_data->sizes[src_level]),
+          preload_data->buffers[src_level]);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL,
+                      src_level - mip_stream_src_base_);
+      DEBUG_CHECK_GL_ERROR;
+      bytes_uploaded += preload_data->sizes[src_level];
+      mip_stream_next_src_level_--;
+      if (bytes_uploaded >= byte_budget) {
+        break;
+      }
+    }
+    if (mip_stream_next_src_level_ < mip_stream_src_base_) {
+      mip_stream_next_src_level_ = -1;
+      return true;
+    }
+    return false;
+  }
+
  private:
   const TextureData* tex_media_;
   RendererGL* renderer_;
   GLuint texture_;
+
+  // Next (bigger) src level StreamMips() will upload, or -1 once the
+  // full chain is resident.
+  int mip_stream_next_src_level_{-1};
+  int mip_stream_src_base_{};
 };  // TextureDataGL
 
 void RendererGL::SetViewport(GLint x, GLint y, GLsizei width, GLsizei height) {
@@ -3137,11 +3458,63 @@ void RendererGL::SetVertexAttribArrayEnabled(GLuint i, bool enabled) {
   }
 }
 
+void RendererGL::SetVertexAttribPointer(GLuint i, GLuint buffer,
+                                        int elem_count, GLenum elem_type,
+                                        bool normalized, int stride,
+                                        size_t offset) {
+  assert(!g_vao_support);
+  assert(i < kVertexAttrCount);
+  assert(buffer != 0);
+  VertexAttribPointerState& s = vertex_attrib_pointer_states_[i];
+  if (s.buffer == buffer && s.elem_count == elem_count
+      && s.elem_type == elem_type && s.normalized == normalized
+      && s.stride == stride && s.offset == offset) {
+    CountStateFiltered();
+    return;
+  }
+  BindArrayBuffer(buffer);
+  glVertexAttribPointer(i, elem_count, elem_type,
+                        static_cast<GLboolean>(normalized), stride,
+                        reinterpret_cast<void*>(offset));
+  s = {buffer, elem_count, elem_type, normalized, stride, offset};
+  CountStateIssued();
+}
+
+void RendererGL::BindElementArrayBuffer(GLuint b) {
+  if (g_vao_support) {
+    // Element bindings are per-vao state; no global shadow to keep.
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, b);
+    return;
+  }
+  if (static_cast<int>(b) != active_elem_buffer_) {
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, b);
+    active_elem_buffer_ = static_cast<int>(b);
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
+  }
+}
+
+void RendererGL::InvalidateAttribPointerBuffer(GLuint b) {
+  assert(!g_vao_support);
+  for (auto& s : vertex_attrib_pointer_states_) {
+    if (s.buffer == b) {
+      s.buffer = 0;
+    }
+  }
+  if (active_elem_buffer_ == static_cast<int>(b)) {
+    active_elem_buffer_ = -1;
+  }
+}
+
 void RendererGL::BindTextureUnit(uint32_t tex_unit) {
   assert(tex_unit >= 0 && tex_unit < kMaxGLTexUnitsUsed);
   if (active_tex_unit_ != tex_unit) {
     glActiveTexture(GL_TEXTURE0 + tex_unit);
     active_tex_unit_ = tex_unit;
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -3149,6 +3522,9 @@ void RendererGL::BindFramebuffer(GLuint fb) {
   if (active_framebuffer_ != fb) {
     glBindFramebuffer(GL_FRAMEBUFFER, fb);
     active_framebuffer_ = fb;
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -3156,6 +3532,9 @@ void RendererGL::BindArrayBuffer(GLuint b) {
   if (active_array_buffer_ != b) {
     glBindBuffer(GL_ARRAY_BUFFER, b);
     active_array_buffer_ = b;
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -3177,6 +3556,9 @@ void RendererGL::BindTexture(GLuint type, GLuint tex, GLuint tex_unit) {
         BindTextureUnit(tex_unit);
         glBindTexture(type, tex);
         bound_textures_2d_[tex_unit] = tex;
+        CountStateIssued();
+      } else {
+        CountStateFiltered();
       }
       break;
     }
@@ -3185,6 +3567,9 @@ void RendererGL::BindTexture(GLuint type, GLuint tex, GLuint tex_unit) {
         BindTextureUnit(tex_unit);
         glBindTexture(type, tex);
         bound_textures_cube_map_[tex_unit] = tex;
+        CountStateIssued();
+      } else {
+        CountStateFiltered();
       }
       break;
     }
@@ -3197,6 +3582,16 @@ class RendererGL::ModelDataGL : public ModelRendererData {
  public:
   enum BufferType { kVertices, kIndices, kBufferCount };
 
+#if BA_GL_HAVE_PACKED_NORMALS
+  // Squish a 16-bit-per-component normal down to signed 2_10_10_10.
+  static auto PackNormal(const int16_t normal[3]) -> uint32_t {
+    auto x = static_cast<uint32_t>(normal[0] >> 6) & 0x3FFu;
+    auto y = static_cast<uint32_t>(normal[1] >> 6) & 0x3FFu;
+    auto z = static_cast<uint32_t>(normal[2] >> 6) & 0x3FFu;
+    return x | (y << 10u) | (z << 20u);
+  }
+#endif  // BA_GL_HAVE_PACKED_NORMALS
+
   ModelDataGL(const ModelData& model, RendererGL* renderer)
       : renderer_(renderer), fake_vao_(nullptr) {
 #if BA_DEBUG_BUILD
@@ -3223,43 +3618,107 @@ class RendererGL::ModelDataGL : public ModelRendererData {
     // Fill our vertex data buffer.
     renderer_->BindArrayBuffer(vbos_[kVertices]);
     DEBUG_CHECK_GL_ERROR;
-    glBufferData(GL_ARRAY_BUFFER,
-                 static_cast_check_fit<GLsizeiptr>(model.vertices().size()
-                                                   * sizeof(VertexObjectFull)),
-                 &(model.vertices()[0]), GL_STATIC_DRAW);
-    DEBUG_CHECK_GL_ERROR;
 
-    // ..and point our array at its members.
-    if (fake_vao_) {
-      fake_vao_->SetAttribBuffer(vbos_[kVertices], kVertexAttrPosition, 3,
-                                 GL_FLOAT, GL_FALSE, sizeof(VertexObjectFull),
-                                 offsetof(VertexObjectFull, position));
-      fake_vao_->SetAttribBuffer(
-          vbos_[kVertices], kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE,
-          sizeof(VertexObjectFull), offsetof(VertexObjectFull, uv));
-      fake_vao_->SetAttribBuffer(vbos_[kVertices], kVertexAttrNormal, 3,
-                                 GL_SHORT, GL_TRUE, sizeof(VertexObjectFull),
-                                 offsetof(VertexObjectFull, normal));
+#if BA_GL_HAVE_PACKED_NORMALS
+    if (g_packed_normal_support) {
+      // Repack into our compressed format at upload time (the .bob file
+      // format itself is unchanged).
+      std::vector<VertexObjectCompressed> compressed(model.vertices().size());
+      VertexObjectCompressed* dst = compressed.data();
+      for (auto&& src : model.vertices()) {
+        dst->position[0] = src.position[0];
+        dst->position[1] = src.position[1];
+        dst->position[2] = src.position[2];
+        dst->uv[0] = src.uv[0];
+        dst->uv[1] = src.uv[1];
+        dst->normal_packed = PackNormal(src.normal);
+        dst++;
+      }
+      glBufferData(GL_ARRAY_BUFFER,
+                   static_cast_check_fit<GLsizeiptr>(
+                       compressed.size() * sizeof(VertexObjectCompressed)),
+                   &(compressed[0]), GL_STATIC_DRAW);
       DEBUG_CHECK_GL_ERROR;
+
+      // ..and point our array at its members.
+      if (fake_vao_) {
+        fake_vao_->SetAttribBuffer(vbos_[kVertices], kVertexAttrPosition, 3,
+                                   GL_FLOAT, GL_FALSE,
+                                   sizeof(VertexObjectCompressed),
+                                   offsetof(VertexObjectCompressed, position));
+        fake_vao_->SetAttribBuffer(
+            vbos_[kVertices], kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE,
+            sizeof(VertexObjectCompressed),
+            offsetof(VertexObjectCompressed, uv));
+        fake_vao_->SetAttribBuffer(
+            vbos_[kVertices], kVertexAttrNormal, 4, GL_INT_2_10_10_10_REV,
+            GL_TRUE, sizeof(VertexObjectCompressed),
+            offsetof(VertexObjectCompressed, normal_packed));
+        DEBUG_CHECK_GL_ERROR;
+      } else {
+        glVertexAttribPointer(
+            kVertexAttrPosition, 3, GL_FLOAT, GL_FALSE,
+            sizeof(VertexObjectCompressed),
+            reinterpret_cast<void*>(
+                offsetof(VertexObjectCompressed, position)));
+        glEnableVertexAttribArray(kVertexAttrPosition);
+        glVertexAttribPointer(
+            kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE,
+            sizeof(VertexObjectCompressed),
+            reinterpret_cast<void*>(offsetof(VertexObjectCompressed, uv)));
+        glEnableVertexAttribArray(kVertexAttrUV);
+        glVertexAttribPointer(
+            kVertexAttrNormal, 4, GL_INT_2_10_10_10_REV, GL_TRUE,
+            sizeof(VertexObjectCompressed),
+            reinterpret_cast<void*>(
+                offsetof(VertexObjectCompressed, normal_packed)));
+        glEnableVertexAttribArray(kVertexAttrNormal);
+        DEBUG_CHECK_GL_ERROR;
+      }
     } else {
-      glVertexAttribPointer(
-          kVertexAttrPosition, 3, GL_FLOAT, GL_FALSE, sizeof(VertexObjectFull),
-          reinterpret_cast<void*>(offsetof(VertexObjectFull, position)));
-      glEnableVertexAttribArray(kVertexAttrPosition);
-      glVertexAttribPointer(
-          kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE,
-          sizeof(VertexObjectFull),
-          reinterpret_cast<void*>(offsetof(VertexObjectFull, uv)));
-      glEnableVertexAttribArray(kVertexAttrUV);
-      glVertexAttribPointer(
-          kVertexAttrNormal, 3, GL_SHORT, GL_TRUE, sizeof(VertexObjectFull),
-          reinterpret_cast<void*>(offsetof(VertexObjectFull, normal)));
-      glEnableVertexAttribArray(kVertexAttrNormal);
+#else
+    {
+#endif  // BA_GL_HAVE_PACKED_NORMALS
+      glBufferData(GL_ARRAY_BUFFER,
+                   static_cast_check_fit<GLsizeiptr>(
+                       model.vertices().size() * sizeof(VertexObjectFull)),
+                   &(model.vertices()[0]), GL_STATIC_DRAW);
       DEBUG_CHECK_GL_ERROR;
+
+      // ..and point our array at its members.
+      if (fake_vao_) {
+        fake_vao_->SetAttribBuffer(vbos_[kVertices], kVertexAttrPosition, 3,
+                                   GL_FLOAT, GL_FALSE,
+                                   sizeof(VertexObjectFull),
+                                   offsetof(VertexObjectFull, position));
+        fake_vao_->SetAttribBuffer(
+            vbos_[kVertices], kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE,
+            sizeof(VertexObjectFull), offsetof(VertexObjectFull, uv));
+        fake_vao_->SetAttribBuffer(vbos_[kVertices], kVertexAttrNormal, 3,
+                                   GL_SHORT, GL_TRUE, sizeof(VertexObjectFull),
+                                   offsetof(VertexObjectFull, normal));
+        DEBUG_CHECK_GL_ERROR;
+      } else {
+        glVertexAttribPointer(
+            kVertexAttrPosition, 3, GL_FLOAT, GL_FALSE,
+            sizeof(VertexObjectFull),
+            reinterpret_cast<void*>(offsetof(VertexObjectFull, position)));
+        glEnableVertexAttribArray(kVertexAttrPosition);
+        glVertexAttribPointer(
+            kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE,
+            sizeof(VertexObjectFull),
+            reinterpret_cast<void*>(offsetof(VertexObjectFull, uv)));
+        glEnableVertexAttribArray(kVertexAttrUV);
+        glVertexAttribPointer(
+            kVertexAttrNormal, 3, GL_SHORT, GL_TRUE, sizeof(VertexObjectFull),
+            reinterpret_cast<void*>(offsetof(VertexObjectFull, normal)));
+        glEnableVertexAttribArray(kVertexAttrNormal);
+        DEBUG_CHECK_GL_ERROR;
+      }
     }
 
     // fill our index data buffer
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbos_[kIndices]);
+    renderer_->BindElementArrayBuffer(vbos_[kIndices]);
     if (!g_vao_support) {
       assert(fake_vao_);
       fake_vao_->SetElementBuffer(vbos_[kIndices]);
@@ -3322,6 +3781,9 @@ class RendererGL::ModelDataGL : public ModelRendererData {
       if (vbo == renderer_->active_array_buffer_) {
         renderer_->active_array_buffer_ = -1;
       }
+      if (!g_vao_support) {
+        renderer_->InvalidateAttribPointerBuffer(vbo);
+      }
     }
     if (!g_graphics_server->renderer_context_lost()) {
       glDeleteBuffers(kBufferCount, vbos_);
@@ -3410,7 +3872,7 @@ class RendererGL::MeshDataGL : public MeshRendererData {
     }
   }
 
-  void Draw(DrawType draw_type) {
+  virtual void Draw(DrawType draw_type) {
     DEBUG_CHECK_GL_ERROR;
     assert(have_primary_data_);
     assert(have_index_data_ || !uses_index_data_);
@@ -3456,6 +3918,9 @@ class RendererGL::MeshDataGL : public MeshRendererData {
       if (vbos_[i] == renderer_->active_array_buffer_) {
         renderer_->active_array_buffer_ = -1;
       }
+      if (!g_vao_support) {
+        renderer_->InvalidateAttribPointerBuffer(vbos_[i]);
+      }
     }
     if (!g_graphics_server->renderer_context_lost()) {
       glDeleteBuffers(GetBufferCount(), vbos_);
@@ -3472,14 +3937,15 @@ class RendererGL::MeshDataGL : public MeshRendererData {
         assert(fake_vao_);
         fake_vao_->SetElementBuffer(vbos_[kIndexBuffer]);
       }
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbos_[kIndexBuffer]);
+      renderer_->BindElementArrayBuffer(vbos_[kIndexBuffer]);
+      bound_element_vbo_ = vbos_[kIndexBuffer];
       elem_count_ = static_cast<uint32_t>(data->elements.size());
       assert(elem_count_ > 0);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                   static_cast_check_fit<GLsizeiptr>(
-                       data->elements.size() * sizeof(data->elements[0])),
-                   &data->elements[0],
-                   dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+      UploadBufferData(GL_ELEMENT_ARRAY_BUFFER, &buffer_capacities_[kIndexBuffer],
+                       static_cast_check_fit<GLsizeiptr>(
+                           data->elements.size() * sizeof(data->elements[0])),
+                       &data->elements[0],
+                       dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
       index_state_ = data->state;
       have_index_data_ = true;
       BA_LOG_ONCE("GL WARNING - USING 32 BIT INDICES WHICH WONT WORK IN ES2!!");
@@ -3488,6 +3954,33 @@ class RendererGL::MeshDataGL : public MeshRendererData {
   }
   void SetIndexData(MeshIndexBuffer16* data) {
     assert(uses_index_data_);
+    if (data->shared) {
+      // Canonical data; point our vertex array at the one shared device
+      // buffer for it instead of uploading our own copy.
+      if (g_vao_support) {
+        renderer_->BindVertexArray(vao_);
+      }
+      GLuint shared_vbo = renderer_->GetSharedMeshBuffer(
+          data, GL_ELEMENT_ARRAY_BUFFER,
+          static_cast_check_fit<GLsizeiptr>(data->elements.size()
+                                            * sizeof(data->elements[0])),
+          &data->elements[0]);
+      if (bound_element_vbo_ != shared_vbo) {
+        if (g_vao_support) {
+          glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, shared_vbo);
+        } else {
+          assert(fake_vao_);
+          fake_vao_->SetElementBuffer(shared_vbo);
+        }
+        bound_element_vbo_ = shared_vbo;
+      }
+      elem_count_ = static_cast<uint32_t>(data->elements.size());
+      index_type_ = GL_UNSIGNED_SHORT;
+      have_index_data_ = true;
+      // So any later switch to per-mesh data re-uploads.
+      index_state_ = 0;
+      return;
+    }
     if (data->state != index_state_) {
       if (g_vao_support) {
         renderer_->BindVertexArray(vao_);
@@ -3495,14 +3988,15 @@ class RendererGL::MeshDataGL : public MeshRendererData {
         assert(fake_vao_);
         fake_vao_->SetElementBuffer(vbos_[kIndexBuffer]);
       }
-      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbos_[kIndexBuffer]);
+      renderer_->BindElementArrayBuffer(vbos_[kIndexBuffer]);
+      bound_element_vbo_ = vbos_[kIndexBuffer];
       elem_count_ = static_cast<uint32_t>(data->elements.size());
       assert(elem_count_ > 0);
-      glBufferData(GL_ELEMENT_ARRAY_BUFFER,
-                   static_cast_check_fit<GLsizeiptr>(
-                       data->elements.size() * sizeof(data->elements[0])),
-                   &data->elements[0],
-                   dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+      UploadBufferData(GL_ELEMENT_ARRAY_BUFFER, &buffer_capacities_[kIndexBuffer],
+                       static_cast_check_fit<GLsizeiptr>(
+                           data->elements.size() * sizeof(data->elements[0])),
+                       &data->elements[0],
+                       dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
       index_state_ = data->state;
       have_index_data_ = true;
       index_type_ = GL_UNSIGNED_SHORT;
@@ -3516,6 +4010,28 @@ class RendererGL::MeshDataGL : public MeshRendererData {
   auto vao() const -> GLuint { return vao_; }
 
  protected:
+  // Upload to the currently-bound buffer target. For dynamic meshes we
+  // keep the allocation around and orphan it (glBufferData with nullptr)
+  // before refilling via glBufferSubData, so the driver hands us fresh
+  // storage instead of stalling on frames still reading the old data.
+  // (mobile tilers especially - this was our worst frame-time variance
+  // source). Static uploads go straight through like before.
+  void UploadBufferData(GLuint target, GLsizeiptr* capacity, GLsizeiptr size,
+                        const void* data_ptr, GLuint draw_type) {
+    if (draw_type == GL_DYNAMIC_DRAW) {
+      if (size > *capacity) {
+        // Grow with headroom so steadily-growing meshes (particles
+        // ramping up, text changing) don't reallocate every frame.
+        *capacity = size + size / 2;
+      }
+      glBufferData(target, *capacity, nullptr, draw_type);
+      glBufferSubData(target, 0, size, data_ptr);
+    } else {
+      *capacity = size;
+      glBufferData(target, size, data_ptr, draw_type);
+    }
+  }
+
   template <typename T>
   void UpdateBufferData(BufferType buffer_type, MeshBuffer<T>* data,
                         uint32_t* state, bool* have, GLuint draw_type) {
@@ -3535,10 +4051,10 @@ class RendererGL::MeshDataGL : public MeshRendererData {
       if (!uses_index_data_ && buffer_type == kVertexBufferPrimary) {
         elem_count_ = static_cast<uint32_t>(data->elements.size());
       }
-      glBufferData(GL_ARRAY_BUFFER,
-                   static_cast<GLsizeiptr>(data->elements.size()
-                                           * sizeof(data->elements[0])),
-                   &(data->elements[0]), draw_type);
+      UploadBufferData(GL_ARRAY_BUFFER, &buffer_capacities_[buffer_type],
+                       static_cast<GLsizeiptr>(data->elements.size()
+                                               * sizeof(data->elements[0])),
+                       &(data->elements[0]), draw_type);
       DEBUG_CHECK_GL_ERROR;
       *state = data->state;
       *have = true;
@@ -3547,8 +4063,10 @@ class RendererGL::MeshDataGL : public MeshRendererData {
     }
   }
 
-  // FIXME - we should do some sort of ring-buffer system.
   GLuint vbos_[3]{};
+  // Allocated storage per buffer slot; dynamic uploads orphan-and-refill
+  // within this capacity (see UploadBufferData).
+  GLsizeiptr buffer_capacities_[3]{};
   GLuint vao_{};
   auto GetBufferCount() const -> int {
     return uses_secondary_data_ ? 3 : (uses_index_data_ ? 2 : 1);
@@ -3565,6 +4083,9 @@ class RendererGL::MeshDataGL : public MeshRendererData {
   RendererGL* renderer_{};
   uint32_t elem_count_{};
   GLuint index_type_{GL_UNSIGNED_SHORT};
+  // Element buffer our vertex array currently references (ours by
+  // default; can be a renderer-shared one for canonical data).
+  GLuint bound_element_vbo_{};
   FakeVertexArrayObject* fake_vao_{};
 };  // MeshDataGL
 
@@ -3601,8 +4122,30 @@ class RendererGL::MeshDataSimpleSplitGL : public RendererGL::MeshDataGL {
                                 offsetof(VertexSimpleSplitDynamic, position)));
       glEnableVertexAttribArray(kVertexAttrPosition);
     }
+    bound_static_vbo_ = vbos_[kVertexBufferPrimary];
   }
   void SetStaticData(MeshBuffer<VertexSimpleSplitStatic>* data) {
+    if (data->shared) {
+      // Canonical data; aim our uv attribute at the one shared device
+      // buffer for it instead of uploading our own copy.
+      GLuint shared_vbo = renderer_->GetSharedMeshBuffer(
+          data, GL_ARRAY_BUFFER,
+          static_cast<GLsizeiptr>(data->elements.size()
+                                  * sizeof(data->elements[0])),
+          &data->elements[0]);
+      if (bound_static_vbo_ != shared_vbo) {
+        BindStaticAttrs(shared_vbo);
+        primary_state_ = 0;  // So a later per-mesh buffer re-uploads.
+      }
+      have_primary_data_ = true;
+      return;
+    }
+    // Recycled meshes may have been pointing at a shared buffer in a
+    // previous life; aim back at our own before uploading.
+    if (bound_static_vbo_ != vbos_[kVertexBufferPrimary]) {
+      BindStaticAttrs(vbos_[kVertexBufferPrimary]);
+      primary_state_ = 0;
+    }
     UpdateBufferData(kVertexBufferPrimary, data, &primary_state_,
                      &have_primary_data_, GL_STATIC_DRAW);
   }
@@ -3612,6 +4155,26 @@ class RendererGL::MeshDataSimpleSplitGL : public RendererGL::MeshDataGL {
                      &have_secondary_data_,
                      GL_DYNAMIC_DRAW);  // this is *always* dynamic
   }
+
+ private:
+  void BindStaticAttrs(GLuint vbo) {
+    if (fake_vao_) {
+      fake_vao_->SetAttribBuffer(vbo, kVertexAttrUV, 2, GL_UNSIGNED_SHORT,
+                                 GL_TRUE, sizeof(VertexSimpleSplitStatic),
+                                 offsetof(VertexSimpleSplitStatic, uv));
+    } else {
+      renderer_->BindVertexArray(vao_);
+      renderer_->BindArrayBuffer(vbo);
+      glVertexAttribPointer(
+          kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE,
+          sizeof(VertexSimpleSplitStatic),
+          reinterpret_cast<void*>(offsetof(VertexSimpleSplitStatic, uv)));
+    }
+    bound_static_vbo_ = vbo;
+  }
+
+  // Array buffer our uv attribute currently points at.
+  GLuint bound_static_vbo_{};
 };
 
 class RendererGL::MeshDataObjectSplitGL : public RendererGL::MeshDataGL {
@@ -3847,6 +4410,94 @@ class RendererGL::MeshDataSpriteGL : public RendererGL::MeshDataGL {
   }
 };
 
+#if BA_GL_HAVE_INSTANCED_ARRAYS
+
+// Instanced flavor of sprite mesh data: the buffer holds one element per
+// sprite and the gpu expands each to a quad (static shared corner/index
+// buffers plus per-instance position/size/color attrs). Saves the game
+// thread from quadrupling every particle into cpu vertex arrays; only
+// created when g_instanced_arrays_support is set.
+class RendererGL::MeshDataSpriteInstancedGL : public RendererGL::MeshDataGL {
+ public:
+  explicit MeshDataSpriteInstancedGL(RendererGL* renderer)
+      : MeshDataGL(renderer, kUsesIndexBuffer) {
+    // Instancing implies VAO support; no fake-vao fallback here.
+    assert(g_vao_support && g_instanced_arrays_support);
+    renderer_->BindVertexArray(vao());
+
+    // Static quad corners; these feed the uv attr (which the sprite
+    // shaders use for both texture coords and corner offsets).
+    glGenBuffers(1, &corner_vbo_);
+    renderer_->BindArrayBuffer(corner_vbo_);
+    const uint16_t corners[] = {0, 0, 0, 65535, 65535, 0, 65535, 65535};
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    glVertexAttribPointer(kVertexAttrUV, 2, GL_UNSIGNED_SHORT, GL_TRUE, 0,
+                          nullptr);
+    glEnableVertexAttribArray(kVertexAttrUV);
+
+    // Static quad indices (same winding the cpu-expansion path emits).
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, vbos_[kIndexBuffer]);
+    const uint16_t indices[] = {0, 1, 2, 1, 3, 2};
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(indices), indices,
+                 GL_STATIC_DRAW);
+    have_index_data_ = true;
+
+    // Per-instance data from the primary buffer.
+    renderer_->BindArrayBuffer(vbos_[kVertexBufferPrimary]);
+    glVertexAttribPointer(
+        kVertexAttrPosition, 3, GL_FLOAT, GL_FALSE, sizeof(VertexSprite),
+        reinterpret_cast<void*>(offsetof(VertexSprite, position)));
+    glEnableVertexAttribArray(kVertexAttrPosition);
+    glVertexAttribDivisor(kVertexAttrPosition, 1);
+    glVertexAttribPointer(
+        kVertexAttrSize, 1, GL_FLOAT, GL_FALSE, sizeof(VertexSprite),
+        reinterpret_cast<void*>(offsetof(VertexSprite, size)));
+    glEnableVertexAttribArray(kVertexAttrSize);
+    glVertexAttribDivisor(kVertexAttrSize, 1);
+    glVertexAttribPointer(
+        kVertexAttrColor, 4, GL_FLOAT, GL_FALSE, sizeof(VertexSprite),
+        reinterpret_cast<void*>(offsetof(VertexSprite, color)));
+    glEnableVertexAttribArray(kVertexAttrColor);
+    glVertexAttribDivisor(kVertexAttrColor, 1);
+    DEBUG_CHECK_GL_ERROR;
+  }
+
+  ~MeshDataSpriteInstancedGL() override {
+    assert(InGraphicsThread());
+    if (corner_vbo_ == renderer_->active_array_buffer_) {
+      renderer_->active_array_buffer_ = -1;
+    }
+    if (!g_graphics_server->renderer_context_lost()) {
+      glDeleteBuffers(1, &corner_vbo_);
+      DEBUG_CHECK_GL_ERROR;
+    }
+  }
+
+  void SetData(MeshBuffer<VertexSprite>* data) {
+    instance_count_ = static_cast<uint32_t>(data->elements.size());
+    UpdateBufferData(kVertexBufferPrimary, data, &primary_state_,
+                     &have_primary_data_,
+                     dynamic_draw_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+  }
+
+  void Draw(DrawType draw_type) override {
+    DEBUG_CHECK_GL_ERROR;
+    assert(draw_type == DrawType::kTriangles);
+    assert(have_primary_data_);
+    if (instance_count_ > 0) {
+      glDrawElementsInstanced(GL_TRIANGLES, 6, GL_UNSIGNED_SHORT, nullptr,
+                              static_cast<GLsizei>(instance_count_));
+    }
+    DEBUG_CHECK_GL_ERROR;
+  }
+
+ private:
+  GLuint corner_vbo_{};
+  uint32_t instance_count_{};
+};
+
+#endif  // BA_GL_HAVE_INSTANCED_ARRAYS
+
 class RendererGL::RenderTargetGL : public RenderTarget {
  public:
   void Bind() {
@@ -4121,6 +4772,9 @@ void RendererGL::UseProgram(ProgramGL* p) {
   if (p != current_program_) {
     glUseProgram(p->program());
     current_program_ = p;
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -4154,7 +4808,9 @@ void RendererGL::SyncGLState() {
     for (GLuint i = 0; i < kVertexAttrCount; i++) {
       glDisableVertexAttribArray(i);
       vertex_attrib_arrays_enabled_[i] = false;
+      vertex_attrib_pointer_states_[i] = {};  // unknown; re-issue
     }
+    active_elem_buffer_ = -1;
   }
 
   // wack these out so the next call will definitely call glViewport
@@ -4228,6 +4884,30 @@ void RendererGL::SyncGLState() {
   assert(VAR&& VAR == dynamic_cast<TYPE*>(buffer->get())); \
   buffer++
 
+auto RendererGL::GetSharedMeshBuffer(const MeshBufferBase* key, GLuint target,
+                                     GLsizeiptr size, const void* data)
+    -> GLuint {
+  assert(InGraphicsThread());
+  auto i = shared_mesh_buffers_.find(key);
+  if (i != shared_mesh_buffers_.end()) {
+    return i->second;
+  }
+  GLuint vbo;
+  glGenBuffers(1, &vbo);
+  if (target == GL_ARRAY_BUFFER) {
+    BindArrayBuffer(vbo);
+  } else {
+    // Element-array bindings are per-vertex-array state; our caller has
+    // its own vertex array bound so this lands there (it needs that
+    // binding anyway).
+    glBindBuffer(target, vbo);
+  }
+  glBufferData(target, size, data, GL_STATIC_DRAW);
+  DEBUG_CHECK_GL_ERROR;
+  shared_mesh_buffers_[key] = vbo;
+  return vbo;
+}
+
 // Takes all latest mesh data from the client side and applies it
 // to our gl implementations.
 void RendererGL::UpdateMeshes(
@@ -4317,6 +4997,16 @@ void RendererGL::UpdateMeshes(
         m->SetData(data);
         break;
       }
+      case MeshDataType::kSpriteInstanced: {
+#if BA_GL_HAVE_INSTANCED_ARRAYS
+        GET_MESH_DATA(MeshDataSpriteInstancedGL, m);
+        GET_BUFFER(MeshBuffer<VertexSprite>, data);
+        m->SetData(data);
+        break;
+#else
+        throw Exception("Instanced sprite meshes not supported here.");
+#endif
+      }
       default:
         throw Exception("Invalid meshdata type: "
                         + std::to_string(static_cast<int>(mesh_data->type())));
@@ -4442,6 +5132,19 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
             p->SetColorTexture(buffer->GetTexture());
             break;
           }
+          case ShadingType::kSimpleTextureModulatedTransparentSDF: {
+            SetDoubleSided(false);
+            bool premult = static_cast<bool>(buffer->GetInt());
+            SetBlend(true);
+            SetBlendPremult(premult);
+            float r, g, b, a;
+            buffer->GetFloats(&r, &g, &b, &a);
+            SimpleProgramGL* p = simple_tex_mod_sdf_prog_;
+            p->Bind();
+            p->SetColor(r, g, b, a);
+            p->SetColorTexture(buffer->GetTexture());
+            break;
+          }
           case ShadingType::kSimpleTextureModulatedTransFlatness: {
             SetDoubleSided(false);
             bool premult = static_cast<bool>(buffer->GetInt());
@@ -4707,8 +5410,19 @@ void RendererGL::ProcessRenderCommandBuffer(RenderCommandBuffer* buffer,
           }
           case ShadingType::kPostProcessNormalDistort: {
             float distort = buffer->GetFloat();
+            bool low_res = static_cast<bool>(buffer->GetInt());
             PostProcessProgramGL* p = postprocess_distort_prog_;
             StandardPostProcessSetup(p, pass);
+            if (low_res) {
+              // Swap the full-res camera texture out for our first blur
+              // buffer (a half-res copy we generate every frame anyway).
+              // Refracted areas are moving by definition so the softness
+              // is invisible, and on tiled gpus this cuts the resolve
+              // bandwidth of explosion chains way down. Depth still comes
+              // from the full-res buffer so dof classification stays crisp.
+              assert(!blur_buffers_.empty());
+              p->SetColorTexture(blur_buffers_[0]->texture());
+            }
             p->SetDistort(distort);
             break;
           }
@@ -5587,6 +6301,9 @@ void RendererGL::SetDepthWriting(bool enable) {
   if (enable != depth_writing_enabled_) {
     depth_writing_enabled_ = enable;
     glDepthMask(static_cast<GLboolean>(enable));
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -5598,6 +6315,9 @@ void RendererGL::SetDrawAtEqualDepth(bool enable) {
     } else {
       glDepthFunc(GL_LESS);
     }
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -5616,6 +6336,9 @@ void RendererGL::SetDepthTesting(bool enable) {
     } else {
       glDisable(GL_DEPTH_TEST);
     }
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -5624,6 +6347,9 @@ void RendererGL::SetDepthRange(float min, float max) {
     depth_range_min_ = min;
     depth_range_max_ = max;
     glDepthRange(min, max);
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -5647,6 +6373,9 @@ void RendererGL::SetBlend(bool b) {
     } else {
       glDisable(GL_BLEND);
     }
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 void RendererGL::SetBlendPremult(bool b) {
@@ -5666,6 +6395,9 @@ void RendererGL::SetBlendPremult(bool b) {
         glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
       }
     }
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -5674,6 +6406,9 @@ void RendererGL::BindVertexArray(GLuint v) {
   if (v != current_vertex_array_) {
     glBindVertexArray(v);
     current_vertex_array_ = v;
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 void RendererGL::SetDoubleSided(bool d) {
@@ -5684,6 +6419,9 @@ void RendererGL::SetDoubleSided(bool d) {
     } else {
       glEnable(GL_CULL_FACE);
     }
+    CountStateIssued();
+  } else {
+    CountStateFiltered();
   }
 }
 
@@ -5823,6 +6561,10 @@ auto RendererGL::GetDrawsShieldsFunny() -> bool {
 
 void RendererGL::CheckCapabilities() { CheckGLExtensions(); }
 
+auto RendererGL::supports_single_pass_stereo() const -> bool {
+  return g_multiview_support;
+}
+
 #if BA_OSTYPE_ANDROID
 std::string RendererGL::GetAutoAndroidRes() {
   assert(InMainThread());
@@ -5943,9 +6685,47 @@ auto RendererGL::GetAutoGraphicsQuality() -> GraphicsQuality {
   // Elsewhere (desktops and such) we default to higher.
   q = GraphicsQuality::kHigher;
 #endif
+
+  // The above are just guesses based on device lists and api levels; when
+  // we have GPU timers available we trust an actual measurement over them.
+  // Results are keyed to the gpu/driver strings so a driver update or gpu
+  // swap re-runs the calibration.
+#if BA_GL_HAVE_TIMER_QUERY
+  if (g_timer_query_support) {
+    int gpu_key = GetGPUDriverKey();
+    int stored_key =
+        g_platform->GetLowLevelConfigValue("auto_gfx_quality_gpu", 0);
+    int stored_q = g_platform->GetLowLevelConfigValue("auto_gfx_quality", -1);
+    if (stored_key != 0 && stored_key == gpu_key
+        && stored_q >= static_cast<int>(GraphicsQuality::kLow)
+        && stored_q <= static_cast<int>(GraphicsQuality::kHigher)) {
+      q = static_cast<GraphicsQuality>(stored_q);
+    } else {
+      StartAutoQualityCalibration(gpu_key);
+    }
+  }
+#endif  // BA_GL_HAVE_TIMER_QUERY
+
   return q;
 }
 
+auto RendererGL::GetGPUDriverKey() -> int {
+  // Simple fnv-1a over the gl id strings; just needs to be stable across
+  // launches and change when the gpu or driver does.
+  uint32_t h = 2166136261u;
+  for (auto enum_val : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+    if (const char* s =
+            reinterpret_cast<const char*>(glGetString(enum_val))) {
+      while (*s) {
+        h = (h ^ static_cast<uint32_t>(*s++)) * 16777619u;
+      }
+    }
+  }
+  // Zero means 'nothing stored'; stay clear of it.
+  int key = static_cast<int>(h);
+  return key == 0 ? 1 : key;
+}
+
 void RendererGL::RetainShader(ProgramGL* p) { shaders_.emplace_back(p); }
 
 void RendererGL::Load() {
@@ -5996,6 +6776,9 @@ void RendererGL::Load() {
   p = simple_tex_mod_flatness_prog_ =
       new SimpleProgramGL(this, SHD_TEXTURE | SHD_MODULATE | SHD_FLATNESS);
   RetainShader(p);
+  p = simple_tex_mod_sdf_prog_ =
+      new SimpleProgramGL(this, SHD_TEXTURE | SHD_MODULATE | SHD_SDF);
+  RetainShader(p);
   p = simple_tex_mod_shadow_prog_ = new SimpleProgramGL(
       this, SHD_TEXTURE | SHD_MODULATE | SHD_SHADOW | SHD_MASK_UV2);
   RetainShader(p);
@@ -6154,6 +6937,15 @@ void RendererGL::Load() {
   for (int i = 0; i < 2; i++) {
     recycle_mesh_datas_sprite_.push_back(new MeshDataSpriteGL(this));
   }
+#if BA_GL_HAVE_INSTANCED_ARRAYS
+  assert(recycle_mesh_datas_sprite_instanced_.empty());
+  if (g_instanced_arrays_support) {
+    for (int i = 0; i < 2; i++) {
+      recycle_mesh_datas_sprite_instanced_.push_back(
+          new MeshDataSpriteInstancedGL(this));
+    }
+  }
+#endif
 
   // Re-sync with the GL state since we might be dealing with a new context/etc.
   SyncGLState();
@@ -6203,11 +6995,39 @@ void RendererGL::Unload() {
     delete i;
   }
   recycle_mesh_datas_sprite_.clear();
+  for (auto&& i : recycle_mesh_datas_sprite_instanced_) {
+    delete i;
+  }
+  recycle_mesh_datas_sprite_instanced_.clear();
   screen_mesh_.reset();
   if (!g_graphics_server->renderer_context_lost()) {
+    for (auto&& entry : shared_mesh_buffers_) {
+      if (entry.second == static_cast<GLuint>(active_array_buffer_)) {
+        active_array_buffer_ = -1;
+      }
+      glDeleteBuffers(1, &entry.second);
+    }
     glDeleteTextures(1, &random_tex_);
     glDeleteTextures(1, &vignette_tex_);
   }
+  shared_mesh_buffers_.clear();
+#if BA_GL_HAVE_TIMER_QUERY
+  // Our timer queries die with the context.
+  if (!g_graphics_server->renderer_context_lost()) {
+    for (auto&& query : free_timer_queries_) {
+      glDeleteQueries(1, &query);
+    }
+    for (auto&& entry : pending_timer_queries_) {
+      glDeleteQueries(1, &entry.query);
+    }
+  }
+  free_timer_queries_.clear();
+  pending_timer_queries_.clear();
+  active_timer_query_ = 0;
+  frame_gpu_time_accum_ns_ = 0;
+  frame_gpu_time_frame_ = -1;
+  last_frame_gpu_time_ns_ = 0;
+#endif  // BA_GL_HAVE_TIMER_QUERY
   blur_buffers_.clear();
   shaders_.clear();
   simple_color_prog_ = nullptr;
@@ -6215,6 +7035,7 @@ void RendererGL::Unload() {
   simple_tex_dtest_prog_ = nullptr;
   simple_tex_mod_prog_ = nullptr;
   simple_tex_mod_flatness_prog_ = nullptr;
+  simple_tex_mod_sdf_prog_ = nullptr;
   simple_tex_mod_shadow_prog_ = nullptr;
   simple_tex_mod_shadow_flatness_prog_ = nullptr;
   simple_tex_mod_glow_prog_ = nullptr;
@@ -6357,6 +7178,25 @@ auto RendererGL::NewMeshData(MeshDataType mesh_type, MeshDrawType draw_type)
       return data;
       break;
     }
+    case MeshDataType::kSpriteInstanced: {
+#if BA_GL_HAVE_INSTANCED_ARRAYS
+      BA_PRECONDITION(g_instanced_arrays_support);
+      MeshDataSpriteInstancedGL* data;
+      // use a recycled one if we've got one.. otherwise create a new one
+      auto i = recycle_mesh_datas_sprite_instanced_.rbegin();
+      if (i != recycle_mesh_datas_sprite_instanced_.rend()) {
+        data = *i;
+        recycle_mesh_datas_sprite_instanced_.pop_back();
+      } else {
+        data = new MeshDataSpriteInstancedGL(this);
+      }
+      data->set_dynamic_draw(draw_type == MeshDrawType::kDynamic);
+      return data;
+      break;
+#else
+      throw Exception("Instanced sprite meshes not supported here.");
+#endif
+    }
     default:
       throw Exception();
       break;
@@ -6416,6 +7256,16 @@ void RendererGL::DeleteMeshData(MeshRendererData* source_in,
       recycle_mesh_datas_sprite_.push_back(source);
       break;
     }
+#if BA_GL_HAVE_INSTANCED_ARRAYS
+    case MeshDataType::kSpriteInstanced: {
+      auto source = static_cast<MeshDataSpriteInstancedGL*>(source_in);
+      assert(source
+             && source == dynamic_cast<MeshDataSpriteInstancedGL*>(source_in));
+      source->Reset();
+      recycle_mesh_datas_sprite_instanced_.push_back(source);
+      break;
+    }
+#endif
     default:
       throw Exception();
       break;
@@ -6600,6 +7450,56 @@ void RendererGL::VRSyncRenderStates() {
 }
 #endif  // BA_VR_BUILD
 
+void RendererGL::BeginPassGPUTimer(RenderPass::Type type) {
+#if BA_GL_HAVE_TIMER_QUERY
+  // We need timings when the stats overlay is up, when they're steering
+  // dynamic resolution, or while a quality calibration run is measuring.
+  if (!g_timer_query_support
+      || !(g_graphics->show_gpu_stats() || dynamic_resolution()
+           || auto_quality_calibrating())) {
+    return;
+  }
+  // Time-elapsed queries can't nest; passes render sequentially so this
+  // should never still be set.
+  assert(active_timer_query_ == 0);
+  GLuint query;
+  if (!free_timer_queries_.empty()) {
+    query = free_timer_queries_.back();
+    free_timer_queries_.pop_back();
+  } else {
+    glGenQueries(1, &query);
+  }
+  glBeginQuery(GL_TIME_ELAPSED, query);
+  active_timer_query_ = query;
+  DEBUG_CHECK_GL_ERROR;
+#endif  // BA_GL_HAVE_TIMER_QUERY
+}
+
+void RendererGL::EndPassGPUTimer(RenderPass::Type type) {
+#if BA_GL_HAVE_TIMER_QUERY
+  if (active_timer_query_ == 0) {
+    return;
+  }
+  glEndQuery(GL_TIME_ELAPSED);
+  assert(static_cast<int>(type) < kGPUTimerPassTypeCount);
+  pending_timer_queries_.push_back({static_cast<int>(type),
+                                    active_timer_query_,
+                                    total_frames_rendered()});
+  active_timer_query_ = 0;
+  DEBUG_CHECK_GL_ERROR;
+#endif  // BA_GL_HAVE_TIMER_QUERY
+}
+
+auto RendererGL::GetFrameGPUTimeNs() -> uint64_t {
+#if BA_GL_HAVE_TIMER_QUERY
+  uint64_t val = last_frame_gpu_time_ns_;
+  last_frame_gpu_time_ns_ = 0;
+  return val;
+#else
+  return 0;
+#endif  // BA_GL_HAVE_TIMER_QUERY
+}
+
 void RendererGL::RenderFrameDefEnd() {
   // Need to set some states to keep cardboard happy.
 #if BA_CARDBOARD_BUILD
@@ -6608,6 +7508,82 @@ void RendererGL::RenderFrameDefEnd() {
     glEnable(GL_SCISSOR_TEST);
   }
 #endif  // BA_CARDBOARD_BUILD
+
+  // Harvest finished pass timer-queries and periodically ship per-pass
+  // averages over to the game thread for the stats overlay.
+#if BA_GL_HAVE_TIMER_QUERY
+  if (g_timer_query_support) {
+    while (!pending_timer_queries_.empty()) {
+      auto& front = pending_timer_queries_.front();
+      GLuint available{};
+      glGetQueryObjectuiv(front.query, GL_QUERY_RESULT_AVAILABLE, &available);
+      if (!available) {
+        break;
+      }
+      GLuint elapsed_ns{};
+      glGetQueryObjectuiv(front.query, GL_QUERY_RESULT, &elapsed_ns);
+      pass_gpu_time_ns_[front.pass_type] += elapsed_ns;
+
+      // Queries complete in issue order, so hitting a new frame number
+      // means the previous frame's total is final; publish it.
+      if (front.frame != frame_gpu_time_frame_) {
+        if (frame_gpu_time_frame_ >= 0) {
+          last_frame_gpu_time_ns_ = frame_gpu_time_accum_ns_;
+        }
+        frame_gpu_time_frame_ = front.frame;
+        frame_gpu_time_accum_ns_ = 0;
+      }
+      frame_gpu_time_accum_ns_ += elapsed_ns;
+      free_timer_queries_.push_back(front.query);
+      pending_timer_queries_.pop_front();
+    }
+    pass_gpu_time_frames_++;
+    millisecs_t gpu_stats_now = GetRealTime();
+    if (gpu_stats_now - last_pass_gpu_time_push_ > 250) {
+      last_pass_gpu_time_push_ = gpu_stats_now;
+      std::vector<std::pair<RenderPass::Type, float>> times;
+      for (int i = 0; i < kGPUTimerPassTypeCount; i++) {
+        if (pass_gpu_time_ns_[i] > 0) {
+          times.emplace_back(static_cast<RenderPass::Type>(i),
+                             static_cast<float>(pass_gpu_time_ns_[i])
+                                 / (1000000.0f
+                                    * static_cast<float>(
+                                        pass_gpu_time_frames_)));
+        }
+        pass_gpu_time_ns_[i] = 0;
+      }
+      pass_gpu_time_frames_ = 0;
+      // (timings may be running purely for dynamic-res; only ship them
+      // over if the overlay actually wants them)
+      if (!times.empty() && g_graphics->show_gpu_stats()) {
+        g_game->PushCall([times] { g_graphics->SetGPUPassTimes(times); });
+      }
+    }
+    DEBUG_CHECK_GL_ERROR;
+  }
+#endif  // BA_GL_HAVE_TIMER_QUERY
+
+  // Periodically report how many redundant gl state calls our shadow
+  // state filtered out.
+#if BA_DEBUG_BUILD
+  state_count_frames_++;
+  millisecs_t now = GetRealTime();
+  if (now - last_state_count_log_time_ > 5000) {
+    if (last_state_count_log_time_ != 0 && state_count_frames_ > 0) {
+      int total = state_calls_issued_ + state_calls_filtered_;
+      Log("gl state calls: "
+          + std::to_string(state_calls_issued_ / state_count_frames_)
+          + " issued, "
+          + std::to_string(state_calls_filtered_ / state_count_frames_)
+          + " filtered per frame ("
+          + std::to_string(total > 0 ? 100 * state_calls_filtered_ / total : 0)
+          + "% filtered)");
+    }
+    last_state_count_log_time_ = now;
+    state_calls_issued_ = state_calls_filtered_ = 0;
+    state_count_frames_ = 0;
+  }
+#endif  // BA_DEBUG_BUILD
 }
 
 #pragma clang diagnostic pop
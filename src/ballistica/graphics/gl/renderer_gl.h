@@ -3,8 +3,11 @@
 #ifndef BALLISTICA_GRAPHICS_GL_RENDERER_GL_H_
 #define BALLISTICA_GRAPHICS_GL_RENDERER_GL_H_
 
+#include <list>
 #include <memory>
+#include <unordered_map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/ballistica.h"
@@ -32,6 +35,7 @@ class RendererGL : public Renderer {
   class MeshDataDualTextureFullGL;
   class MeshDataSmokeFullGL;
   class MeshDataSpriteGL;
+  class MeshDataSpriteInstancedGL;
   class RenderTargetGL;
   class FramebufferObjectGL;
   class ShaderGL;
@@ -67,6 +71,7 @@ class RendererGL : public Renderer {
   };
 
   void CheckCapabilities() override;
+  auto supports_single_pass_stereo() const -> bool override;
   auto GetAutoGraphicsQuality() -> GraphicsQuality override;
   auto GetAutoTextureQuality() -> TextureQuality override;
 #if BA_OSTYPE_ANDROID
@@ -113,6 +118,9 @@ class RendererGL : public Renderer {
   void CardboardDisableScissor() override;
   void CardboardEnableScissor() override;
   void RenderFrameDefEnd() override;
+  void BeginPassGPUTimer(RenderPass::Type type) override;
+  void EndPassGPUTimer(RenderPass::Type type) override;
+  auto GetFrameGPUTimeNs() -> uint64_t override;
 
 #if BA_VR_BUILD
   void VRSyncRenderStates() override;
@@ -123,6 +131,10 @@ class RendererGL : public Renderer {
 
  private:
   void CheckFunkyDepthIssue();
+
+  // A stable hash of the gl vendor/renderer/version strings; identifies
+  // the gpu/driver combo our stored auto-quality calibration applies to.
+  auto GetGPUDriverKey() -> int;
   auto GetMSAASamplesForFramebuffer(int width, int height) -> int;
   void UpdateMSAAEnabled() override;
   void CheckGLExtensions();
@@ -144,6 +156,21 @@ class RendererGL : public Renderer {
 
   // Note: This is only for use when VAOs aren't supported.
   void SetVertexAttribArrayEnabled(GLuint i, bool enabled);
+
+  // Ditto; specifies an attribute pointer, filtering out respecification
+  // of state the driver already has (fake-vao rebinds are the big
+  // offender).
+  void SetVertexAttribPointer(GLuint i, GLuint buffer, int elem_count,
+                              GLenum elem_type, bool normalized, int stride,
+                              size_t offset);
+
+  // Safe in both modes; shadow-filtered only when VAOs are unsupported
+  // (with them, element bindings are per-vao state).
+  void BindElementArrayBuffer(GLuint b);
+
+  // Drop any attrib-pointer/element shadow state referencing a dying
+  // buffer (its id may get recycled).
+  void InvalidateAttribPointerBuffer(GLuint b);
   void BindTexture(GLuint type, const TextureData* t, GLuint tex_unit = 0);
   void BindTexture(GLuint type, GLuint tex, GLuint tex_unit = 0);
   void BindTextureUnit(uint32_t tex_unit);
@@ -151,6 +178,17 @@ class RendererGL : public Renderer {
   void BindArrayBuffer(GLuint b);
   void SetBlend(bool b);
   void SetBlendPremult(bool b);
+
+  // Track gl state calls we issue vs filter as redundant via our shadow
+  // state (debug builds only; for verifying the dedup win on device).
+  // Tallies get logged periodically from RenderFrameDefEnd().
+#if BA_DEBUG_BUILD
+  void CountStateIssued() { state_calls_issued_++; }
+  void CountStateFiltered() { state_calls_filtered_++; }
+#else
+  void CountStateIssued() {}
+  void CountStateFiltered() {}
+#endif
   millisecs_t dof_update_time_{};
   std::vector<Object::Ref<FramebufferObjectGL> > blur_buffers_;
   bool supports_depth_textures_{};
@@ -191,6 +229,7 @@ class RendererGL : public Renderer {
   SimpleProgramGL* simple_tex_dtest_prog_{};
   SimpleProgramGL* simple_tex_mod_prog_{};
   SimpleProgramGL* simple_tex_mod_flatness_prog_{};
+  SimpleProgramGL* simple_tex_mod_sdf_prog_{};
   SimpleProgramGL* simple_tex_mod_shadow_prog_{};
   SimpleProgramGL* simple_tex_mod_shadow_flatness_prog_{};
   SimpleProgramGL* simple_tex_mod_glow_prog_{};
@@ -239,6 +278,19 @@ class RendererGL : public Renderer {
   std::vector<Rect> scissor_rects_;
   GLuint current_vertex_array_{};
   bool vertex_attrib_arrays_enabled_[kVertexAttrCount]{};
+
+  // Shadow of the attribute pointers we've specified to the driver
+  // (no-vao fallback only). A zero buffer means 'unknown; re-issue'.
+  struct VertexAttribPointerState {
+    GLuint buffer;
+    int elem_count;
+    GLenum elem_type;
+    bool normalized;
+    int stride;
+    size_t offset;
+  };
+  VertexAttribPointerState vertex_attrib_pointer_states_[kVertexAttrCount]{};
+  int active_elem_buffer_{-1};
   int active_tex_unit_{};
   int active_framebuffer_{};
   int active_array_buffer_{};
@@ -247,13 +299,51 @@ class RendererGL : public Renderer {
   bool blend_{};
   bool blend_premult_{};
   std::unique_ptr<MeshDataSimpleFullGL> screen_mesh_;
+
+  // Return (creating/uploading if need be) the single device buffer
+  // backing a canonical shared mesh buffer. Keyed by the buffer object's
+  // identity; shared buffers are immutable and immortal on the game side
+  // so contents never need re-checking. For element-array targets the
+  // caller must have its vertex array bound.
+  auto GetSharedMeshBuffer(const MeshBufferBase* key, GLuint target,
+                           GLsizeiptr size, const void* data) -> GLuint;
+  std::unordered_map<const void*, GLuint> shared_mesh_buffers_;
   std::vector<MeshDataSimpleSplitGL*> recycle_mesh_datas_simple_split_;
   std::vector<MeshDataObjectSplitGL*> recycle_mesh_datas_object_split_;
   std::vector<MeshDataSimpleFullGL*> recycle_mesh_datas_simple_full_;
   std::vector<MeshDataDualTextureFullGL*> recycle_mesh_datas_dual_texture_full_;
   std::vector<MeshDataSmokeFullGL*> recycle_mesh_datas_smoke_full_;
   std::vector<MeshDataSpriteGL*> recycle_mesh_datas_sprite_;
+  std::vector<MeshDataSpriteInstancedGL*> recycle_mesh_datas_sprite_instanced_;
   int error_check_counter_{};
+#if BA_GL_HAVE_TIMER_QUERY
+  // Per-pass GPU timing via timer queries; results come back a frame or
+  // two late so in-flight ones sit in a pending list until available.
+  static constexpr int kGPUTimerPassTypeCount = 16;
+  struct PendingGPUTimerQuery {
+    int pass_type;
+    GLuint query;
+    int frame;
+  };
+  std::vector<GLuint> free_timer_queries_;
+  std::list<PendingGPUTimerQuery> pending_timer_queries_;
+  GLuint active_timer_query_{};
+  uint64_t pass_gpu_time_ns_[kGPUTimerPassTypeCount]{};
+  int pass_gpu_time_frames_{};
+  millisecs_t last_pass_gpu_time_push_{};
+
+  // Whole-frame totals assembled from the per-pass queries as they
+  // complete (feeds dynamic resolution).
+  uint64_t frame_gpu_time_accum_ns_{};
+  int frame_gpu_time_frame_{-1};
+  uint64_t last_frame_gpu_time_ns_{};
+#endif
+#if BA_DEBUG_BUILD
+  int state_calls_issued_{};
+  int state_calls_filtered_{};
+  int state_count_frames_{};
+  millisecs_t last_state_count_log_time_{};
+#endif
 };
 
 }  // namespace ballistica
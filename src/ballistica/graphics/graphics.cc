@@ -3,16 +3,20 @@
 #include "ballistica/graphics/graphics.h"
 
 #include <algorithm>
+#include <memory>
+#include <thread>
 #include <utility>
 #include <vector>
 
 #include "ballistica/app/app.h"
 #include "ballistica/app/app_globals.h"
+#include "ballistica/core/profiler.h"
 #include "ballistica/dynamics/bg/bg_dynamics.h"
 #include "ballistica/game/connection/connection_set.h"
 #include "ballistica/game/connection/connection_to_client.h"
 #include "ballistica/game/connection/connection_to_host.h"
 #include "ballistica/game/session/session.h"
+#include "ballistica/generic/job_pool.h"
 #include "ballistica/generic/utils.h"
 #include "ballistica/graphics/camera.h"
 #include "ballistica/graphics/component/empty_component.h"
@@ -21,11 +25,15 @@
 #include "ballistica/graphics/component/simple_component.h"
 #include "ballistica/graphics/component/special_component.h"
 #include "ballistica/graphics/component/sprite_component.h"
+#include "ballistica/graphics/frame_ledger.h"
 #include "ballistica/graphics/gl/renderer_gl.h"
 #include "ballistica/graphics/graphics_server.h"
+#include "ballistica/graphics/mesh/quad_batch_mesh.h"
 #include "ballistica/graphics/net_graph.h"
 #include "ballistica/graphics/text/text_graphics.h"
 #include "ballistica/input/input.h"
+#include "ballistica/input/input_latency_meter.h"
+#include "ballistica/math/vector4f.h"
 #include "ballistica/platform/platform.h"
 #include "ballistica/python/python.h"
 #include "ballistica/python/python_context_call.h"
@@ -62,6 +70,7 @@ auto Graphics::IsShaderTransparent(ShadingType c) -> bool {
     case ShadingType::kSimpleTexModulatedTransShadowFlatness:
     case ShadingType::kSimpleTextureModulatedTransparentGlow:
     case ShadingType::kSimpleTextureModulatedTransparentGlowMaskUV2:
+    case ShadingType::kSimpleTextureModulatedTransparentSDF:
     case ShadingType::kSpecial:
     case ShadingType::kShield:
     case ShadingType::kSmoke:
@@ -93,6 +102,13 @@ auto Graphics::IsShaderTransparent(ShadingType c) -> bool {
   }
 }
 
+auto Graphics::UseLowResDistortion(const FrameDef* frame_def) -> bool {
+  // Our highest tier keeps the crisp full-res refraction; kHigh (which is
+  // what our tiled-gpu devices run) trades it for the existing half-res
+  // camera copy, which is basically free.
+  return (frame_def->quality() < GraphicsQuality::kHigher);
+}
+
 Graphics::Graphics() = default;
 Graphics::~Graphics() = default;
 
@@ -235,6 +251,27 @@ class Graphics::ScreenMessageEntry {
 };
 
 // Draw controls and things that lie on top of the action.
+void Graphics::SetGPUPassTimes(
+    const std::vector<std::pair<RenderPass::Type, float>>& times) {
+  assert(InGameThread());
+  gpu_pass_times_ = times;
+  float total = 0.0f;
+  for (auto&& entry : times) {
+    total += entry.second;
+  }
+  if (!gpu_time_graph_.exists()) {
+    gpu_time_graph_ = Object::New<NetGraph>();
+  }
+  gpu_time_graph_->AddSample(GetRealTime(), total);
+}
+
+auto Graphics::set_show_frame_ledger(bool val) -> void {
+  show_frame_ledger_ = val;
+
+  // Publishers only pay for clock reads while someone's watching.
+  FrameLedger::set_enabled(val);
+}
+
 void Graphics::DrawMiscOverlays(RenderPass* pass) {
   // Every now and then, update our stats.
   while (GetRealTime() >= next_stat_update_time_) {
@@ -386,6 +423,46 @@ void Graphics::DrawMiscOverlays(RenderPass* pass) {
     }
   }
 
+  // Draw GPU per-pass timing stats (fed to us by renderers with
+  // timer-query support).
+  if (show_gpu_stats_ && gpu_time_graph_.exists()) {
+    gpu_time_graph_->Draw(pass, GetRealTime(), 50.0f, 110.0f, 400.0f, 80.0f);
+    std::string stats_str;
+    char line[128];
+    float total = 0.0f;
+    for (auto&& entry : gpu_pass_times_) {
+      snprintf(line, sizeof(line), "%s %.2fms\n",
+               RenderPass::TypeName(entry.first), entry.second);
+      stats_str += line;
+      total += entry.second;
+    }
+    snprintf(line, sizeof(line), "gpu total %.2fms", total);
+    stats_str += line;
+    if (stats_str != gpu_stats_string_) {
+      gpu_stats_string_ = stats_str;
+      if (!gpu_stats_text_group_.exists()) {
+        gpu_stats_text_group_ = Object::New<TextGroup>();
+      }
+      gpu_stats_text_group_->SetText(gpu_stats_string_);
+    }
+    if (gpu_stats_text_group_.exists()) {
+      SimpleComponent c(pass);
+      c.SetTransparent(true);
+      c.SetColor(0.8f, 0.8f, 0.8f, 1.0f);
+      int text_elem_count = gpu_stats_text_group_->GetElementCount();
+      for (int e = 0; e < text_elem_count; e++) {
+        c.SetTexture(gpu_stats_text_group_->GetElementTexture(e));
+        c.SetFlatness(1.0f);
+        c.PushTransform();
+        c.Translate(460.0f, 110.0f, kScreenMessageZDepth);
+        c.Scale(0.7f, 0.7f);
+        c.DrawMesh(gpu_stats_text_group_->GetElementMesh(e));
+        c.PopTransform();
+      }
+      c.Submit();
+    }
+  }
+
   // Draw debug graphs.
   if (explicit_bool(false)) {
     if (!debug_graph_1_.exists()) {
@@ -398,6 +475,33 @@ void Graphics::DrawMiscOverlays(RenderPass* pass) {
     debug_graph_2_->Draw(pass, GetRealTime(), 50.0f, 160.0f, 500.0f, 100.0f);
   }
 
+  // Frame-ledger HUD: drain this frame's lane tallies into a stacked
+  // graph (values in milliseconds; masked lanes draw as zero-height).
+  if (show_frame_ledger_) {
+    if (!frame_ledger_graph_.exists()) {
+      frame_ledger_graph_ = Object::New<NetGraph>();
+      std::string label;
+      for (int i = 0; i < FrameLedger::kLaneCount; i++) {
+        if (i > 0) {
+          label += "/";
+        }
+        label += FrameLedger::LaneName(static_cast<FrameLedger::Lane>(i));
+      }
+      frame_ledger_graph_->SetLabel(label);
+    }
+    int64_t lanes[FrameLedger::kLaneCount];
+    FrameLedger::Drain(lanes);
+    std::vector<float> values(FrameLedger::kLaneCount);
+    for (int i = 0; i < FrameLedger::kLaneCount; i++) {
+      bool visible = (frame_ledger_lane_mask_ & (1u << i)) != 0;
+      values[i] =
+          visible ? static_cast<float>(lanes[i]) / 1000.0f : 0.0f;
+    }
+    frame_ledger_graph_->AddSamples(GetRealTime(), values);
+    frame_ledger_graph_->Draw(pass, GetRealTime(), 50.0f, 50.0f, 500.0f,
+                              100.0f);
+  }
+
   // Screen messages (bottom).
   {
     // Delete old ones.
@@ -443,7 +547,8 @@ void Graphics::DrawMiscOverlays(RenderPass* pass) {
           break;
       }
 
-      // Shadows.
+      // Shadows. These all share a texture, so runs of consecutive
+      // messages with matching colors get batched into single draws.
       {
         SimpleComponent c(pass);
         c.SetTransparent(true);
@@ -455,6 +560,19 @@ void Graphics::DrawMiscOverlays(RenderPass* pass) {
 
         millisecs_t youngest_age = 9999;
 
+        QuadBatchMesh* batch{};
+        Vector4f batch_color{0.0f, 0.0f, 0.0f, 0.0f};
+        size_t batch_count{};
+        auto flush_batch = [&c, &batch, &batch_color] {
+          if (batch && !batch->empty()) {
+            batch->Commit();
+            c.SetColor(batch_color.x, batch_color.y, batch_color.z,
+                       batch_color.w);
+            c.DrawMesh(batch);
+          }
+          batch = nullptr;
+        };
+
         for (auto i = screen_messages_.rbegin(); i != screen_messages_.rend();
              i++) {
           // Update the translation if need be.
@@ -504,9 +622,20 @@ void Graphics::DrawMiscOverlays(RenderPass* pass) {
           } else {
             fade = std::max(0.0f, (200.0f - age) / 100.0f);
           }
-          c.SetColor(r * fade, g * fade, b * fade, a);
+          Vector4f color{r * fade, g * fade, b * fade, a};
+          if (batch == nullptr || color.x != batch_color.x
+              || color.y != batch_color.y || color.z != batch_color.z
+              || color.w != batch_color.w) {
+            flush_batch();
+            if (batch_count == screen_message_shadow_meshes_.size()) {
+              screen_message_shadow_meshes_.emplace_back(
+                  Object::New<QuadBatchMesh>());
+            }
+            batch = screen_message_shadow_meshes_[batch_count++].get();
+            batch->Reset();
+            batch_color = color;
+          }
 
-          c.PushTransform();
           if (i->v_smoothed == 0.0f) {
             i->v_smoothed = v + v_extra;
           } else {
@@ -514,31 +643,25 @@ void Graphics::DrawMiscOverlays(RenderPass* pass) {
             i->v_smoothed =
                 smoothing * i->v_smoothed + (1.0f - smoothing) * (v + v_extra);
           }
-          c.Translate(screen_width * 0.5f, i->v_smoothed,
-                      vr ? 60 : kScreenMessageZDepth);
           if (vr) {
             // Let's drop down a bit in vr mode.
-            c.Translate(0, -10.0f, 0);
-            c.Scale((str_width + 60) * scale * s_extra,
-                    (str_height + 20) * scale * s_extra);
-
-            // Align our bottom with where we just scaled from.
-            c.Translate(0, 0.5f, 0);
+            float width = (str_width + 60) * scale * s_extra;
+            float height = (str_height + 20) * scale * s_extra;
+            batch->AddQuad(screen_width * 0.5f - width * 0.5f,
+                           i->v_smoothed - 10.0f, 60, width, height);
           } else {
-            c.Scale((str_width + 110) * scale * s_extra,
-                    (str_height + 40) * scale * s_extra);
-
-            // Align our bottom with where we just scaled from.
-            c.Translate(0, 0.5f, 0);
+            float width = (str_width + 110) * scale * s_extra;
+            float height = (str_height + 40) * scale * s_extra;
+            batch->AddQuad(screen_width * 0.5f - width * 0.5f, i->v_smoothed,
+                           kScreenMessageZDepth, width, height);
           }
-          c.DrawModel(g_media->GetModel(SystemModelID::kImage1x1));
-          c.PopTransform();
 
           v += scale * (36 + str_height);
           if (v > g_graphics->screen_virtual_height() + 30) {
             break;
           }
         }
+        flush_batch();
         c.Submit();
       }
 
@@ -893,6 +1016,42 @@ void Graphics::DrawLoadDot(RenderPass* pass) {
   c.Submit();
 }
 
+void Graphics::UpdateEffectLOD(millisecs_t real_time) {
+  // Roughly a 60hz frame plus a bit of slop; if our recent average runs
+  // over this we start shedding nonessential effect work.
+  const float budget{19.0f};
+
+  if (!effect_governor_enabled_) {
+    effect_lod_ = 1.0f;
+    return;
+  }
+  if (last_effect_lod_update_time_ == 0) {
+    last_effect_lod_update_time_ = real_time;
+    return;
+  }
+  auto frame_time =
+      static_cast<float>(real_time - last_effect_lod_update_time_);
+  last_effect_lod_update_time_ = real_time;
+
+  // Ignore huge gaps (app pauses, loads); they're not rendering load.
+  if (frame_time > 250.0f) {
+    return;
+  }
+  if (frame_time_ema_ == 0.0f) {
+    frame_time_ema_ = frame_time;
+  } else {
+    frame_time_ema_ = 0.9f * frame_time_ema_ + 0.1f * frame_time;
+  }
+
+  // Back off quickly when over budget; restore slowly once we've got
+  // clear headroom. The dead zone between keeps us from oscillating.
+  if (frame_time_ema_ > budget) {
+    effect_lod_ = std::max(0.0f, effect_lod_ - 0.05f);
+  } else if (frame_time_ema_ < budget * 0.85f) {
+    effect_lod_ = std::min(1.0f, effect_lod_ + 0.01f);
+  }
+}
+
 void Graphics::UpdateGyro(millisecs_t real_time, millisecs_t elapsed) {
   Vector3f tilt = gyro_vals_;
 
@@ -966,6 +1125,7 @@ void Graphics::DrawWorld(Session* session, FrameDef* frame_def) {
 
   // Lastly draw any blotches that have been building up.
   DrawBlotches(frame_def);
+  DrawScorches(frame_def);
 
   // Add a few explicit things to a few passes.
   DrawBoxingGlovesTest(frame_def);
@@ -974,6 +1134,10 @@ void Graphics::DrawWorld(Session* session, FrameDef* frame_def) {
 void Graphics::BuildAndPushFrameDef() {
   assert(InGameThread());
   assert(camera_.exists());
+  BA_PROFILE_SCOPE("build-frame-def");
+
+  bool ledger = FrameLedger::enabled();
+  int64_t ledger_start = ledger ? Platform::GetCurrentMicroseconds() : 0;
 
   // We should not be building/pushing any frames until after
   // app-launch-commands have been run..
@@ -982,6 +1146,16 @@ void Graphics::BuildAndPushFrameDef() {
   // This should no longer be necessary..
   WaitForRendererToExist();
 
+  // Spin up our frame-def worker pool the first time through. Pass
+  // finalization parallelizes cleanly, so give it a few threads if the
+  // hardware has cores to spare beyond our main game/graphics/etc ones.
+  if (!frame_def_job_pool_) {
+    int worker_count = std::min(
+        3, std::max(0, static_cast<int>(std::thread::hardware_concurrency())
+                           - 2));
+    frame_def_job_pool_ = std::make_unique<JobPool>(worker_count);
+  }
+
   Session* session = g_game->GetForegroundSession();
   bool session_fills_screen = session ? session->DoesFillScreen() : false;
   millisecs_t real_time = GetRealTime();
@@ -993,12 +1167,17 @@ void Graphics::BuildAndPushFrameDef() {
   last_create_frame_def_time_ = net_time;
 
   UpdateGyro(real_time, elapsed);
+  UpdateEffectLOD(real_time);
 
   FrameDef* frame_def = GetEmptyFrameDef();
   frame_def->set_real_time(real_time);
   frame_def->set_base_time(g_game->master_time());
   frame_def->set_base_time_elapsed(elapsed);
   frame_def->set_frame_number(frame_def_count_++);
+  if (InputLatencyMeter::enabled()) {
+    frame_def->set_input_arrival_time(
+        InputLatencyMeter::TakeLatchedInputTime());
+  }
 
   if (!internal_components_inited_) {
     InitInternalComponents(frame_def);
@@ -1086,13 +1265,23 @@ void Graphics::BuildAndPushFrameDef() {
   // Clean up frame_defs awaiting deletion.
   ClearFrameDefDeleteList();
 
-  // Clear our blotches out regardless of whether we rendered them.
+  // Clear our blotches and scorches out regardless of whether we
+  // rendered them.
   blotch_indices_.clear();
   blotch_verts_.clear();
   blotch_soft_indices_.clear();
   blotch_soft_verts_.clear();
   blotch_soft_obj_indices_.clear();
   blotch_soft_obj_verts_.clear();
+  scorch_indices_.clear();
+  scorch_verts_.clear();
+  scorch_big_indices_.clear();
+  scorch_big_verts_.clear();
+
+  if (ledger) {
+    FrameLedger::Add(FrameLedger::Lane::kFrameBuild,
+                     Platform::GetCurrentMicroseconds() - ledger_start);
+  }
 }
 
 auto Graphics::DrawUI(FrameDef* frame_def) -> void { g_ui->Draw(frame_def); }
@@ -1349,14 +1538,31 @@ void Graphics::DrawCursor(RenderPass* pass, millisecs_t real_time) {
   }
 }
 
+// Whether two pod-element vectors hold identical bytes.
+template <typename T>
+static auto BuffersMatch(const std::vector<T>& a, const std::vector<T>& b)
+    -> bool {
+  return a.size() == b.size()
+         && (a.empty() || memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0);
+}
+
 void Graphics::DrawBlotches(FrameDef* frame_def) {
   if (!this->blotch_verts_.empty()) {
     if (!this->shadow_blotch_mesh_.exists())
       this->shadow_blotch_mesh_ = Object::New<SpriteMesh>();
-    this->shadow_blotch_mesh_->SetIndexData(Object::New<MeshIndexBuffer16>(
-        this->blotch_indices_.size(), &this->blotch_indices_[0]));
-    this->shadow_blotch_mesh_->SetData(Object::New<MeshBuffer<VertexSprite>>(
-        this->blotch_verts_.size(), &this->blotch_verts_[0]));
+
+    // Only feed the mesh new data when the geometry actually changed;
+    // static casters commonly produce identical blotches for many
+    // frames straight.
+    if (!BuffersMatch(this->blotch_indices_, this->blotch_indices_uploaded_)
+        || !BuffersMatch(this->blotch_verts_, this->blotch_verts_uploaded_)) {
+      this->shadow_blotch_mesh_->SetIndexData(Object::New<MeshIndexBuffer16>(
+          this->blotch_indices_.size(), &this->blotch_indices_[0]));
+      this->shadow_blotch_mesh_->SetData(Object::New<MeshBuffer<VertexSprite>>(
+          this->blotch_verts_.size(), &this->blotch_verts_[0]));
+      this->blotch_indices_uploaded_ = this->blotch_indices_;
+      this->blotch_verts_uploaded_ = this->blotch_verts_;
+    }
     SpriteComponent c(frame_def->light_shadow_pass());
     c.SetTexture(g_media->GetTexture(SystemTextureID::kLight));
     c.DrawMesh(this->shadow_blotch_mesh_.get());
@@ -1365,11 +1571,19 @@ void Graphics::DrawBlotches(FrameDef* frame_def) {
   if (!this->blotch_soft_verts_.empty()) {
     if (!this->shadow_blotch_soft_mesh_.exists())
       this->shadow_blotch_soft_mesh_ = Object::New<SpriteMesh>();
-    this->shadow_blotch_soft_mesh_->SetIndexData(Object::New<MeshIndexBuffer16>(
-        this->blotch_soft_indices_.size(), &this->blotch_soft_indices_[0]));
-    this->shadow_blotch_soft_mesh_->SetData(
-        Object::New<MeshBuffer<VertexSprite>>(this->blotch_soft_verts_.size(),
-                                              &this->blotch_soft_verts_[0]));
+    if (!BuffersMatch(this->blotch_soft_indices_,
+                      this->blotch_soft_indices_uploaded_)
+        || !BuffersMatch(this->blotch_soft_verts_,
+                         this->blotch_soft_verts_uploaded_)) {
+      this->shadow_blotch_soft_mesh_->SetIndexData(
+          Object::New<MeshIndexBuffer16>(this->blotch_soft_indices_.size(),
+                                         &this->blotch_soft_indices_[0]));
+      this->shadow_blotch_soft_mesh_->SetData(
+          Object::New<MeshBuffer<VertexSprite>>(this->blotch_soft_verts_.size(),
+                                                &this->blotch_soft_verts_[0]));
+      this->blotch_soft_indices_uploaded_ = this->blotch_soft_indices_;
+      this->blotch_soft_verts_uploaded_ = this->blotch_soft_verts_;
+    }
     SpriteComponent c(frame_def->light_shadow_pass());
     c.SetTexture(g_media->GetTexture(SystemTextureID::kLightSoft));
     c.DrawMesh(this->shadow_blotch_soft_mesh_.get());
@@ -1379,13 +1593,20 @@ void Graphics::DrawBlotches(FrameDef* frame_def) {
     if (!this->shadow_blotch_soft_obj_mesh_.exists()) {
       this->shadow_blotch_soft_obj_mesh_ = Object::New<SpriteMesh>();
     }
-    this->shadow_blotch_soft_obj_mesh_->SetIndexData(
-        Object::New<MeshIndexBuffer16>(this->blotch_soft_obj_indices_.size(),
-                                       &this->blotch_soft_obj_indices_[0]));
-    this->shadow_blotch_soft_obj_mesh_->SetData(
-        Object::New<MeshBuffer<VertexSprite>>(
-            this->blotch_soft_obj_verts_.size(),
-            &this->blotch_soft_obj_verts_[0]));
+    if (!BuffersMatch(this->blotch_soft_obj_indices_,
+                      this->blotch_soft_obj_indices_uploaded_)
+        || !BuffersMatch(this->blotch_soft_obj_verts_,
+                         this->blotch_soft_obj_verts_uploaded_)) {
+      this->shadow_blotch_soft_obj_mesh_->SetIndexData(
+          Object::New<MeshIndexBuffer16>(this->blotch_soft_obj_indices_.size(),
+                                         &this->blotch_soft_obj_indices_[0]));
+      this->shadow_blotch_soft_obj_mesh_->SetData(
+          Object::New<MeshBuffer<VertexSprite>>(
+              this->blotch_soft_obj_verts_.size(),
+              &this->blotch_soft_obj_verts_[0]));
+      this->blotch_soft_obj_indices_uploaded_ = this->blotch_soft_obj_indices_;
+      this->blotch_soft_obj_verts_uploaded_ = this->blotch_soft_obj_verts_;
+    }
     SpriteComponent c(frame_def->light_pass());
     c.SetTexture(g_media->GetTexture(SystemTextureID::kLightSoft));
     c.DrawMesh(this->shadow_blotch_soft_obj_mesh_.get());
@@ -1393,6 +1614,51 @@ void Graphics::DrawBlotches(FrameDef* frame_def) {
   }
 }
 
+void Graphics::DrawScorches(FrameDef* frame_def) {
+  if (!this->scorch_verts_.empty()) {
+    if (!this->scorch_mesh_.exists()) {
+      this->scorch_mesh_ = Object::New<SpriteMesh>();
+    }
+
+    // Scorches sit still for their whole lives (only presence fades
+    // move their verts), so this change-detection pays off even more
+    // than it does for blotches.
+    if (!BuffersMatch(this->scorch_indices_, this->scorch_indices_uploaded_)
+        || !BuffersMatch(this->scorch_verts_, this->scorch_verts_uploaded_)) {
+      this->scorch_mesh_->SetIndexData(Object::New<MeshIndexBuffer16>(
+          this->scorch_indices_.size(), &this->scorch_indices_[0]));
+      this->scorch_mesh_->SetData(Object::New<MeshBuffer<VertexSprite>>(
+          this->scorch_verts_.size(), &this->scorch_verts_[0]));
+      this->scorch_indices_uploaded_ = this->scorch_indices_;
+      this->scorch_verts_uploaded_ = this->scorch_verts_;
+    }
+    SpriteComponent c(frame_def->light_shadow_pass());
+    c.SetTexture(g_media->GetTexture(SystemTextureID::kScorch));
+    c.DrawMesh(this->scorch_mesh_.get());
+    c.Submit();
+  }
+  if (!this->scorch_big_verts_.empty()) {
+    if (!this->scorch_big_mesh_.exists()) {
+      this->scorch_big_mesh_ = Object::New<SpriteMesh>();
+    }
+    if (!BuffersMatch(this->scorch_big_indices_,
+                      this->scorch_big_indices_uploaded_)
+        || !BuffersMatch(this->scorch_big_verts_,
+                         this->scorch_big_verts_uploaded_)) {
+      this->scorch_big_mesh_->SetIndexData(Object::New<MeshIndexBuffer16>(
+          this->scorch_big_indices_.size(), &this->scorch_big_indices_[0]));
+      this->scorch_big_mesh_->SetData(Object::New<MeshBuffer<VertexSprite>>(
+          this->scorch_big_verts_.size(), &this->scorch_big_verts_[0]));
+      this->scorch_big_indices_uploaded_ = this->scorch_big_indices_;
+      this->scorch_big_verts_uploaded_ = this->scorch_big_verts_;
+    }
+    SpriteComponent c(frame_def->light_shadow_pass());
+    c.SetTexture(g_media->GetTexture(SystemTextureID::kScorchBig));
+    c.DrawMesh(this->scorch_big_mesh_.get());
+    c.Submit();
+  }
+}
+
 void Graphics::SetSupportsHighQualityGraphics(bool s) {
   supports_high_quality_graphics_ = s;
   has_supports_high_quality_graphics_value_ = true;
@@ -5,12 +5,15 @@
 
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "ballistica/core/object.h"
+#include "ballistica/graphics/render_pass.h"
 #include "ballistica/math/matrix44f.h"
 #include "ballistica/math/rect.h"
 #include "ballistica/math/vector2f.h"
@@ -53,6 +56,13 @@ class Graphics {
   static auto CubeMapFromReflectionType(ReflectionType reflection_type)
       -> SystemCubeMapTextureID;
 
+  // Whether distortion shapes (shields, explosion shockwaves, etc) should
+  // sample a reduced-res copy of the camera buffer instead of the full-res
+  // one. Resolving the full-res buffer per distortion shape is the top
+  // bandwidth cost on tiled gpus, so everything below our highest quality
+  // tier takes the cheap road.
+  static auto UseLowResDistortion(const FrameDef* frame_def) -> bool;
+
   // Given a string, return a reflection type.
   static auto ReflectionTypeFromString(const std::string& s) -> ReflectionType;
 
@@ -122,6 +132,21 @@ class Graphics {
                  r, g, b, a);
   }
 
+  // Draw a scorch splat on terrain. These batch the same way blotches
+  // do; everything sharing a scorch texture lands in one mesh and one
+  // draw per frame. Sprite draws blend premultiplied while scorches
+  // were authored for straight alpha, so we fold the alpha in here.
+  auto DrawScorch(const Vector3f& pos, float size, float r, float g, float b,
+                  float a, bool big) -> void {
+    if (big) {
+      DoDrawBlotch(&scorch_big_indices_, &scorch_big_verts_, pos, size, r * a,
+                   g * a, b * a, a);
+    } else {
+      DoDrawBlotch(&scorch_indices_, &scorch_verts_, pos, size, r * a, g * a,
+                   b * a, a);
+    }
+  }
+
   // Enable progress bar drawing locally.
   auto EnableProgressBar(bool fade_in) -> void;
 
@@ -201,6 +226,22 @@ class Graphics {
   }
   auto SetShadowRange(float lower_bottom, float lower_top, float upper_bottom,
                       float upper_top) -> void;
+
+  // Effect level-of-detail from the frame-time budget governor: 1 when
+  // we've got headroom, sliding toward 0 as the recent frame-time
+  // average runs over budget. Effect draw/emit paths scale or drop
+  // nonessential work based on this; consistent frame times matter more
+  // than peak visuals.
+  auto effect_lod() const -> float {
+    assert(InGameThread());
+    return effect_lod_;
+  }
+  auto effect_governor_enabled() const -> bool {
+    return effect_governor_enabled_;
+  }
+  auto set_effect_governor_enabled(bool val) -> void {
+    effect_governor_enabled_ = val;
+  }
   auto ReleaseFadeEndCommand() -> void;
   auto set_show_fps(bool val) -> void { show_fps_ = val; }
 
@@ -259,15 +300,50 @@ class Graphics {
   auto has_supports_high_quality_graphics_value() const -> bool {
     return has_supports_high_quality_graphics_value_;
   }
+
+  // Whether the renderer can draw SpriteMeshInstanced meshes (gpu quad
+  // expansion); when false, sprite producers must stick to the cpu
+  // expansion path with regular SpriteMeshes.
+  auto supports_sprite_instancing() const -> bool {
+    return supports_sprite_instancing_;
+  }
+  auto set_supports_sprite_instancing(bool val) -> void {
+    supports_sprite_instancing_ = val;
+  }
   auto set_internal_components_inited(bool val) -> void {
     internal_components_inited_ = val;
   }
+
+  // Worker pool used to parallelize frame-def finalization; may be
+  // nullptr (in which case that work simply runs on the game thread).
+  auto frame_def_job_pool() const -> JobPool* {
+    return frame_def_job_pool_.get();
+  }
   auto set_gyro_vals(const Vector3f& vals) -> void { gyro_vals_ = vals; }
   // auto draw_overlay_bounds() const -> bool { return draw_overlay_bounds_; }
   // auto set_draw_overlay_bounds(bool val) -> void { draw_overlay_bounds_ =
   // val; }
   auto show_net_info() const -> bool { return show_net_info_; }
   auto set_show_net_info(bool val) -> void { show_net_info_ = val; }
+  auto show_gpu_stats() const -> bool { return show_gpu_stats_; }
+  auto set_show_gpu_stats(bool val) -> void { show_gpu_stats_ = val; }
+
+  // Per-frame budget HUD (see FrameLedger); the lane mask hides
+  // individual lanes (bit per FrameLedger::Lane; all-on by default).
+  auto show_frame_ledger() const -> bool { return show_frame_ledger_; }
+  auto set_show_frame_ledger(bool val) -> void;
+  auto frame_ledger_lane_mask() const -> uint32_t {
+    return frame_ledger_lane_mask_;
+  }
+  auto set_frame_ledger_lane_mask(uint32_t val) -> void {
+    frame_ledger_lane_mask_ = val;
+  }
+
+  // Called (via PushCall from the graphics thread) by renderers with
+  // GPU timer-query support to feed per-pass times (in milliseconds)
+  // to the stats overlay.
+  auto SetGPUPassTimes(
+      const std::vector<std::pair<RenderPass::Type, float>>& times) -> void;
   auto debug_graph_1() const -> NetGraph* { return debug_graph_1_.get(); }
   auto debug_graph_2() const -> NetGraph* { return debug_graph_2_.get(); }
 
@@ -305,6 +381,7 @@ class Graphics {
   class ScreenMessageEntry;
   auto DrawBoxingGlovesTest(FrameDef* frame_def) -> void;
   auto DrawBlotches(FrameDef* frame_def) -> void;
+  auto DrawScorches(FrameDef* frame_def) -> void;
   auto DrawCursor(RenderPass* pass, millisecs_t real_time) -> void;
   auto DrawFades(FrameDef* frame_def, millisecs_t real_time) -> void;
   auto DrawDebugBuffers(RenderPass* pass) -> void;
@@ -323,12 +400,14 @@ class Graphics {
   auto DrawProgressBar(RenderPass* pass, float opacity) -> void;
   auto UpdateProgressBarProgress(float target) -> void;
   auto UpdateGyro(millisecs_t real_time, millisecs_t elapsed) -> void;
+  auto UpdateEffectLOD(millisecs_t real_time) -> void;
 
   bool drawing_transparent_only_{};
   bool drawing_opaque_only_{};
   std::vector<MeshData*> mesh_data_creates_;
   std::vector<MeshData*> mesh_data_destroys_;
   bool has_supports_high_quality_graphics_value_{};
+  bool supports_sprite_instancing_{};
   bool supports_high_quality_graphics_ = false;
   millisecs_t last_create_frame_def_time_{};
   Vector3f shadow_offset_{0.0f, 0.0f, 0.0f};
@@ -358,11 +437,16 @@ class Graphics {
   Object::Ref<ImageMesh> progress_bar_bottom_mesh_;
   Object::Ref<ImageMesh> progress_bar_top_mesh_;
   Object::Ref<ImageMesh> load_dot_mesh_;
+
+  // Pooled per-color-run batches for screen-message backdrops.
+  std::vector<Object::Ref<QuadBatchMesh>> screen_message_shadow_meshes_;
   Object::Ref<TextGroup> fps_text_group_;
   Object::Ref<TextGroup> net_info_text_group_;
   Object::Ref<SpriteMesh> shadow_blotch_mesh_;
   Object::Ref<SpriteMesh> shadow_blotch_soft_mesh_;
   Object::Ref<SpriteMesh> shadow_blotch_soft_obj_mesh_;
+  Object::Ref<SpriteMesh> scorch_mesh_;
+  Object::Ref<SpriteMesh> scorch_big_mesh_;
   std::string fps_string_;
   std::string net_info_string_;
   std::vector<uint16_t> blotch_indices_;
@@ -371,12 +455,38 @@ class Graphics {
   std::vector<VertexSprite> blotch_soft_verts_;
   std::vector<uint16_t> blotch_soft_obj_indices_;
   std::vector<VertexSprite> blotch_soft_obj_verts_;
+  std::vector<uint16_t> scorch_indices_;
+  std::vector<VertexSprite> scorch_verts_;
+  std::vector<uint16_t> scorch_big_indices_;
+  std::vector<VertexSprite> scorch_big_verts_;
+
+  // Copies of the blotch geometry we last fed to the meshes; while
+  // casters hold still we can skip the per-frame re-uploads (which in
+  // turn lets the renderer reuse its shadow buffers outright).
+  std::vector<uint16_t> blotch_indices_uploaded_;
+  std::vector<VertexSprite> blotch_verts_uploaded_;
+  std::vector<uint16_t> blotch_soft_indices_uploaded_;
+  std::vector<VertexSprite> blotch_soft_verts_uploaded_;
+  std::vector<uint16_t> blotch_soft_obj_indices_uploaded_;
+  std::vector<VertexSprite> blotch_soft_obj_verts_uploaded_;
+  std::vector<uint16_t> scorch_indices_uploaded_;
+  std::vector<VertexSprite> scorch_verts_uploaded_;
+  std::vector<uint16_t> scorch_big_indices_uploaded_;
+  std::vector<VertexSprite> scorch_big_verts_uploaded_;
   bool show_fps_{};
   bool show_net_info_{};
+  bool show_gpu_stats_{};
   bool tv_border_{};
   bool floor_reflection_{};
   Object::Ref<NetGraph> debug_graph_1_;
   Object::Ref<NetGraph> debug_graph_2_;
+  Object::Ref<NetGraph> frame_ledger_graph_;
+  bool show_frame_ledger_{};
+  uint32_t frame_ledger_lane_mask_{0xFFFFFFFFu};
+  Object::Ref<NetGraph> gpu_time_graph_;
+  Object::Ref<TextGroup> gpu_stats_text_group_;
+  std::string gpu_stats_string_;
+  std::vector<std::pair<RenderPass::Type, float>> gpu_pass_times_;
   std::mutex frame_def_delete_list_mutex_;
   std::vector<FrameDef*> frame_def_delete_list_;
   bool debug_draw_{};
@@ -415,6 +525,11 @@ class Graphics {
   bool camera_gyro_explicitly_disabled_{};
   millisecs_t last_cursor_visibility_event_time_{};
   int64_t frame_def_count_{1};
+  bool effect_governor_enabled_{true};
+  millisecs_t last_effect_lod_update_time_{};
+  float frame_time_ema_{};
+  float effect_lod_{1.0f};
+  std::unique_ptr<JobPool> frame_def_job_pool_;
   bool gyro_enabled_{true};
   millisecs_t last_suppress_gyro_time_{};
 };
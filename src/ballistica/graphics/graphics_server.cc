@@ -2,13 +2,18 @@
 
 #include "ballistica/graphics/graphics_server.h"
 
+#include <algorithm>
 #include <list>
 #include <memory>
+#include <thread>
 
+#include "ballistica/core/profiler.h"
 #include "ballistica/core/thread.h"
 #include "ballistica/generic/lambda_runnable.h"
+#include "ballistica/graphics/frame_ledger.h"
 #include "ballistica/graphics/gl/renderer_gl.h"
 #include "ballistica/graphics/renderer.h"
+#include "ballistica/input/input_latency_meter.h"
 #include "ballistica/platform/platform.h"
 #include "ballistica/scene/scene.h"
 
@@ -31,11 +36,23 @@ void GraphicsServer::FullscreenCheck() {
 }
 #endif
 
+// Frame-handoff spin tuning: we start spinning this far ahead of the
+// predicted arrival and give up this far past it (stalled game thread,
+// hitchy frame, etc).
+const int64_t kFrameSpinLeadUs = 500;
+const int64_t kFrameSpinOvershootUs = 2000;
+
 GraphicsServer::GraphicsServer(Thread* thread) : Module("graphics", thread) {
   // We're a singleton.
   assert(g_graphics_server == nullptr);
   g_graphics_server = this;
 
+  // Spinning for imminent frames trades a sliver of cpu for latency;
+  // battery-sensitive configs can turn it off (BA_FRAME_SPIN=0).
+  if (const char* env = getenv("BA_FRAME_SPIN")) {
+    frame_handoff_spin_enabled_ = (atoi(env) != 0);
+  }
+
   // For janky old non-event-push mode, just fall back on a timer for rendering.
   if (!g_platform->IsEventPushMode()) {
     render_timer_ = NewThreadTimer(1000 / 60, true,
@@ -51,14 +68,58 @@ void GraphicsServer::SetRenderHold() {
 }
 
 void GraphicsServer::SetFrameDef(FrameDef* framedef) {
-  // Note: we're just setting the framedef directly here
-  // even though this gets called from the game thread.
-  // Ideally it would seem we should push these to our thread
-  // event list, but currently we spin-lock waiting for new
-  // frames to appear which would prevent that from working;
-  // we would need to change that code.
-  assert(frame_def_ == nullptr);
-  frame_def_ = framedef;
+  // Called from the game thread; our render loop spin-waits on the
+  // queue rather than our thread event list, so a plain mutex handoff
+  // is the simplest thing that works.
+  std::lock_guard<std::mutex> lock(frame_def_mutex_);
+  if (pending_frame_builds_ > 0) {
+    pending_frame_builds_--;
+  }
+
+  // Keep a rough ema of our arrival cadence so the render thread can
+  // tell when the next frame is due imminently (and worth spinning for).
+  int64_t now_us = Platform::GetCurrentMicroseconds();
+  int64_t last_us = last_frame_arrival_us_.load(std::memory_order_relaxed);
+  if (last_us != 0) {
+    int64_t interval = now_us - last_us;
+    if (interval > 0 && interval < 1000000) {
+      int64_t ema = frame_arrival_interval_us_.load(std::memory_order_relaxed);
+      frame_arrival_interval_us_.store(
+          ema == 0 ? interval : (7 * ema + interval) / 8,
+          std::memory_order_relaxed);
+    }
+  }
+  last_frame_arrival_us_.store(now_us, std::memory_order_relaxed);
+
+  frame_defs_.push_back(framedef);
+  auto size = static_cast<int>(frame_defs_.size());
+  assert(size <= frame_queue_depth_.load());
+  if (size > frame_queue_occupancy_max_.load(std::memory_order_relaxed)) {
+    frame_queue_occupancy_max_.store(size, std::memory_order_relaxed);
+  }
+  MaybeRequestFrameDefs();
+}
+
+void GraphicsServer::SetFrameQueueDepth(int depth) {
+  depth = std::min(3, std::max(1, depth));
+  std::lock_guard<std::mutex> lock(frame_def_mutex_);
+  if (depth == frame_queue_depth_.load()) {
+    return;
+  }
+  frame_queue_depth_.store(depth);
+
+  // Deepening takes effect immediately; shallowing just lets the extra
+  // in-flight frames drain through.
+  MaybeRequestFrameDefs();
+}
+
+void GraphicsServer::MaybeRequestFrameDefs() {
+  int depth = frame_queue_depth_.load();
+  while (static_cast<int>(frame_defs_.size()) + pending_frame_builds_
+         < depth) {
+    pending_frame_builds_++;
+    g_game->PushFrameDefRequest();
+  }
 }
 
 auto GraphicsServer::GetRenderFrameDef() -> FrameDef* {
@@ -77,19 +138,30 @@ auto GraphicsServer::GetRenderFrameDef() -> FrameDef* {
 
   // Do some incremental loading every time we try to render.
   g_media->RunPendingGraphicsLoads();
+  g_media->RunTextureMipStreaming();
 
   // Spin and wait for a short bit for a frame_def to appear. If it does, we
   // grab it, render it, and also message the game thread to start generating
-  // another one.
+  // another one (or several, depending on queue depth).
   while (true) {
-    if (frame_def_) {
-      FrameDef* frame_def = frame_def_;
-      frame_def_ = nullptr;
-
-      // Tell the game thread we're ready for the next frame_def so it can start
-      // building it while we render this one.
-      g_game->PushFrameDefRequest();
-      return frame_def;
+    {
+      std::lock_guard<std::mutex> lock(frame_def_mutex_);
+      if (!frame_defs_.empty()) {
+        auto occupancy = static_cast<int>(frame_defs_.size());
+        FrameDef* frame_def = frame_defs_.front();
+        frame_defs_.pop_front();
+
+        // Track occupancy-at-dequeue; fleet tooling differences these
+        // for averages so plain adds are all we need here.
+        frame_queue_dequeues_.fetch_add(1, std::memory_order_relaxed);
+        frame_queue_occupancy_total_.fetch_add(occupancy,
+                                               std::memory_order_relaxed);
+
+        // Top the queue back up so the game thread can start building
+        // while we render this one.
+        MaybeRequestFrameDefs();
+        return frame_def;
+      }
     }
 
     // If there's no frame_def for us, sleep for a bit and wait for it.
@@ -101,6 +173,26 @@ auto GraphicsServer::GetRenderFrameDef() -> FrameDef* {
     if (t >= 1000) {
       break;  // Fail.
     }
+
+    // Sleep wakeup latency lands directly in our frame time here, so if
+    // recent cadence says the next frame is due any microsecond now, spin
+    // (with yields) instead of sleeping. Bounded, so a stalled game
+    // thread costs us at most the overshoot window before we're back to
+    // sleeping like before.
+    if (frame_handoff_spin_enabled_) {
+      int64_t interval =
+          frame_arrival_interval_us_.load(std::memory_order_relaxed);
+      int64_t last_us = last_frame_arrival_us_.load(std::memory_order_relaxed);
+      if (interval > 0 && last_us != 0) {
+        int64_t until_due =
+            last_us + interval - Platform::GetCurrentMicroseconds();
+        if (until_due < kFrameSpinLeadUs
+            && until_due > -kFrameSpinOvershootUs) {
+          std::this_thread::yield();
+          continue;
+        }
+      }
+    }
     Platform::SleepMS(2);
   }
   return nullptr;
@@ -155,14 +247,27 @@ void GraphicsServer::TryRender() {
     // for each FrameDef?... perhaps we should separate mesh updates
     // from FrameDefs? Or change our logic so that frame-defs *always* get
     // rendered.
-    RunFrameDefMeshUpdates(frame_def);
+    {
+      BA_PROFILE_SCOPE("mesh-updates");
+      RunFrameDefMeshUpdates(frame_def);
+    }
 
     // Only actually render if we have a screen and aren't in a hold.
     auto target = renderer()->screen_render_target();
     if (target != nullptr && render_hold_ == 0) {
+      BA_PROFILE_SCOPE("render");
+      bool ledger = FrameLedger::enabled();
+      int64_t ledger_start = ledger ? Platform::GetCurrentMicroseconds() : 0;
       PreprocessRenderFrameDef(frame_def);
       DrawRenderFrameDef(frame_def);
       FinishRenderFrameDef(frame_def);
+      // The swap happens in the app's finish hook, so by this point the
+      // frame is (at least submitted to be) on its way to the screen.
+      InputLatencyMeter::OnFramePresented(frame_def->input_arrival_time());
+      if (ledger) {
+        FrameLedger::Add(FrameLedger::Lane::kRender,
+                         Platform::GetCurrentMicroseconds() - ledger_start);
+      }
     }
 
     // Send this frame_def back to the game thread for deletion.
@@ -689,6 +794,26 @@ void GraphicsServer::PushReloadMediaCall() {
   PushCall([this] { ReloadMedia(); });
 }
 
+void GraphicsServer::PushReapplyAutoGraphicsQualityCall() {
+  PushCall([this] {
+    assert(InGraphicsThread());
+    if (!renderer_ || quality_requested_ != GraphicsQuality::kAuto) {
+      return;
+    }
+    // If re-evaluating lands us back on what we're already running
+    // there's nothing to reload.
+    if (renderer_->GetAutoGraphicsQuality() == quality_actual_) {
+      return;
+    }
+    // This tears down and reloads the renderer the same way a
+    // user-driven quality change does (media reload handshake included).
+    HandleFullContextScreenRebuild(
+        false, fullscreen_enabled(), static_cast<int>(target_res_x_),
+        static_cast<int>(target_res_y_), quality_requested_,
+        texture_quality_requested_);
+  });
+}
+
 void GraphicsServer::PushSetScreenGammaCall(float gamma) {
   PushCall([this, gamma] {
     assert(InGraphicsThread());
@@ -709,6 +834,26 @@ void GraphicsServer::PushSetScreenPixelScaleCall(float pixel_scale) {
   });
 }
 
+void GraphicsServer::PushSetHalfRateWorldModeCall(bool enable) {
+  PushCall([this, enable] {
+    assert(InGraphicsThread());
+    if (!renderer_) {
+      return;
+    }
+    renderer_->set_half_rate_world_mode(enable);
+  });
+}
+
+void GraphicsServer::PushSetDynamicResolutionCall(bool enable) {
+  PushCall([this, enable] {
+    assert(InGraphicsThread());
+    if (!renderer_) {
+      return;
+    }
+    renderer_->set_dynamic_resolution(enable);
+  });
+}
+
 void GraphicsServer::PushSetVSyncCall(bool sync, bool auto_sync) {
   PushCall([this, sync, auto_sync] {
     assert(InGraphicsThread());
@@ -741,13 +886,13 @@ void GraphicsServer::PushSetVSyncCall(bool sync, bool auto_sync) {
 void GraphicsServer::PushComponentUnloadCall(
     const std::vector<Object::Ref<MediaComponentData>*>& components) {
   PushCall([this, components] {
-    // Unload all components we were passed.
+    // Unload all components we were passed and drop the refs right
+    // here (media components count refs atomically, so no need to ship
+    // these back to the game thread just to die).
     for (auto&& i : components) {
       (**i).Unload();
+      delete i;
     }
-    // ..and then ship these pointers back to the game thread so it can free the
-    // references.
-    g_game->PushFreeMediaComponentRefsCall(components);
   });
 }
 
@@ -3,8 +3,10 @@
 #ifndef BALLISTICA_GRAPHICS_GRAPHICS_SERVER_H_
 #define BALLISTICA_GRAPHICS_GRAPHICS_SERVER_H_
 
+#include <atomic>
 #include <list>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -22,6 +24,8 @@ class GraphicsServer : public Module {
   explicit GraphicsServer(Thread* thread);
   auto PushSetScreenGammaCall(float gamma) -> void;
   auto PushSetScreenPixelScaleCall(float pixel_scale) -> void;
+  auto PushSetHalfRateWorldModeCall(bool enable) -> void;
+  auto PushSetDynamicResolutionCall(bool enable) -> void;
   auto PushSetVSyncCall(bool sync, bool auto_sync) -> void;
   auto PushSetScreenCall(bool fullscreen, int width, int height,
                          TextureQuality texture_quality,
@@ -29,6 +33,11 @@ class GraphicsServer : public Module {
                          const std::string& android_res) -> void;
   auto PushReloadMediaCall() -> void;
   auto PushRemoveRenderHoldCall() -> void;
+
+  // Re-evaluate auto graphics quality and reload the renderer if the
+  // answer has changed (no-op when a specific quality is requested).
+  // Used when a calibration run lands a measured preset mid-session.
+  auto PushReapplyAutoGraphicsQualityCall() -> void;
   auto PushComponentUnloadCall(
       const std::vector<Object::Ref<MediaComponentData>*>& components) -> void;
   auto SetRenderHold() -> void;
@@ -37,6 +46,28 @@ class GraphicsServer : public Module {
   // for rendering.
   auto SetFrameDef(FrameDef* framedef) -> void;
 
+  // Frame-queue policy: at depth 1 (the default) the game thread only
+  // builds a frame once the previous one has been picked up for render,
+  // minimizing latency; at depth 2-3 builds run ahead so they overlap
+  // in-flight renders, trading latency for throughput on weak GPUs.
+  // Callable from any thread.
+  auto SetFrameQueueDepth(int depth) -> void;
+  auto frame_queue_depth() const -> int {
+    return frame_queue_depth_.load(std::memory_order_relaxed);
+  }
+
+  // Lifetime queue-occupancy stats (sampled at each dequeue); fleet
+  // tooling polls and differences these for rates/averages.
+  auto frame_queue_dequeues() const -> int64_t {
+    return frame_queue_dequeues_.load(std::memory_order_relaxed);
+  }
+  auto frame_queue_occupancy_total() const -> int64_t {
+    return frame_queue_occupancy_total_.load(std::memory_order_relaxed);
+  }
+  auto frame_queue_occupancy_max() const -> int {
+    return frame_queue_occupancy_max_.load(std::memory_order_relaxed);
+  }
+
   // returns the next frame_def needing to be rendered, waiting for it to arrive
   // if necessary. this can return nullptr if no frame_defs come in within a
   // reasonable amount of time. a frame_def here *must* be rendered and disposed
@@ -319,9 +350,29 @@ class GraphicsServer : public Module {
                  TextureQuality texture_quality,
                  GraphicsQuality graphics_quality,
                  const std::string& android_res) -> void;
+  // Requests another frame build from the game thread whenever the
+  // queue plus builds-in-flight dip below the target depth.
+  // (frame_def_mutex_ must be held.)
+  auto MaybeRequestFrameDefs() -> void;
+
   Timer* render_timer_{};
   Renderer* renderer_{};
-  FrameDef* frame_def_{};
+
+  // Frame-def handoff queue from the game thread (see
+  // SetFrameQueueDepth); guarded by frame_def_mutex_.
+  std::mutex frame_def_mutex_;
+  std::list<FrameDef*> frame_defs_;
+  int pending_frame_builds_{};
+  std::atomic<int> frame_queue_depth_{1};
+  std::atomic<int64_t> frame_queue_dequeues_{};
+  std::atomic<int64_t> frame_queue_occupancy_total_{};
+  std::atomic<int> frame_queue_occupancy_max_{};
+
+  // Frame arrival cadence tracking for the adaptive handoff spin in
+  // GetRenderFrameDef (written by the game thread in SetFrameDef).
+  std::atomic<int64_t> last_frame_arrival_us_{};
+  std::atomic<int64_t> frame_arrival_interval_us_{};
+  bool frame_handoff_spin_enabled_{true};
   bool initial_screen_created_{};
   int render_hold_{};
 #if BA_OSTYPE_MACOS && BA_XCODE_BUILD
@@ -8,10 +8,31 @@ const uint16_t kImageMeshIndices[] = {0, 1, 2, 1, 3, 2};
 const VertexSimpleSplitStatic kImageMeshVerticesStatic[] = {
     {0, 65535}, {65535, 65535}, {0, 0}, {65535, 0}};
 
+// All image meshes draw the exact same unit quad (positions come in via
+// dynamic data), so hand every instance the same canonical index/uv
+// buffers instead of building fresh copies per mesh. These get flagged
+// shared so renderers can also collapse them to one device buffer;
+// hundreds of image meshes can exist at once in menus and each owning
+// identical tiny buffers just fragments driver memory.
+static auto SharedIndexData() -> const Object::Ref<MeshIndexBuffer16>& {
+  static auto* ref = new Object::Ref<MeshIndexBuffer16>(
+      Object::New<MeshIndexBuffer16>(6, kImageMeshIndices));
+  (**ref).shared = true;
+  return *ref;
+}
+
+static auto SharedStaticData()
+    -> const Object::Ref<MeshBuffer<VertexSimpleSplitStatic> >& {
+  static auto* ref = new Object::Ref<MeshBuffer<VertexSimpleSplitStatic> >(
+      Object::New<MeshBuffer<VertexSimpleSplitStatic> >(
+          4, kImageMeshVerticesStatic));
+  (**ref).shared = true;
+  return *ref;
+}
+
 ImageMesh::ImageMesh() {
-  SetIndexData(Object::New<MeshIndexBuffer16>(6, kImageMeshIndices));
-  SetStaticData(Object::New<MeshBuffer<VertexSimpleSplitStatic> >(
-      4, kImageMeshVerticesStatic));
+  SetIndexData(SharedIndexData());
+  SetStaticData(SharedStaticData());
 }
 
 }  // namespace ballistica
@@ -6,6 +6,7 @@
 #include <cstring>
 #include <vector>
 
+#include "ballistica/core/alloc_tracker.h"
 #include "ballistica/graphics/mesh/mesh_buffer_base.h"
 
 namespace ballistica {
@@ -14,13 +15,35 @@ namespace ballistica {
 template <typename T>
 class MeshBuffer : public MeshBufferBase {
  public:
-  MeshBuffer() = default;
-  explicit MeshBuffer(size_t initial_size) : elements(initial_size) {}
+  MeshBuffer() { TrackAlloc(); }
+  explicit MeshBuffer(size_t initial_size) : elements(initial_size) {
+    TrackAlloc();
+  }
   MeshBuffer(size_t initial_size, const T* initial_data)
       : elements(initial_size) {
     memcpy(&elements[0], initial_data, initial_size * sizeof(T));
+    TrackAlloc();
+  }
+#if BA_ALLOC_TRACKING
+  ~MeshBuffer() override {
+    AllocTracker::Remove(AllocTracker::Tag::kMeshBuffers, tracked_bytes_);
   }
+#endif
   std::vector<T> elements;
+
+ private:
+#if BA_ALLOC_TRACKING
+  // Buffers are almost always created at their final size, so capacity
+  // at birth is effectively the footprint (anything grown into elements
+  // afterwards just goes untallied).
+  void TrackAlloc() {
+    tracked_bytes_ = elements.capacity() * sizeof(T);
+    AllocTracker::Add(AllocTracker::Tag::kMeshBuffers, tracked_bytes_);
+  }
+  size_t tracked_bytes_{};
+#else
+  void TrackAlloc() {}
+#endif
 };
 
 }  // namespace ballistica
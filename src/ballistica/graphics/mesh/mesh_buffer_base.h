@@ -14,6 +14,12 @@ namespace ballistica {
 class MeshBufferBase : public Object {
  public:
   uint32_t state;  // which dynamicState value on the mesh this corresponds to
+
+  // Canonical buffers (the unit quad every image mesh uses, etc) get
+  // flagged as shared; renderers can then map all users to a single
+  // device buffer instead of each mesh uploading its own identical copy.
+  // Shared buffers are expected to be immutable and immortal.
+  bool shared{};
 };
 
 }  // namespace ballistica
@@ -22,6 +22,7 @@ class MeshNonIndexed : public Mesh {
 
   // Call this if you have nothing to draw.
   void SetEmpty() { data_.clear(); }
+  auto data() const -> const Object::Ref<MeshBuffer<DATA>>& { return data_; }
   auto IsValid() const -> bool override {
 #if BA_DEBUG_BUILD
     // Make extra sure that we're actually valid in debug mode.
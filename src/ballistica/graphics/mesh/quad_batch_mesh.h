@@ -0,0 +1,68 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_GRAPHICS_MESH_QUAD_BATCH_MESH_H_
+#define BALLISTICA_GRAPHICS_MESH_QUAD_BATCH_MESH_H_
+
+#include <vector>
+
+#include "ballistica/graphics/mesh/mesh_indexed_simple_full.h"
+
+namespace ballistica {
+
+// A mesh for accumulating runs of axis-aligned quads (ui backdrops,
+// icons, etc) into a single draw instead of one draw per quad.
+// Our simple shading uses a uniform color, so everything added between
+// Reset() and Commit() gets drawn with one texture and color; callers
+// should split batches on those.
+class QuadBatchMesh : public MeshIndexedSimpleFull {
+ public:
+  void Reset() {
+    vertices_.clear();
+    indices_.clear();
+  }
+
+  // Add a quad with its lower left corner at (x, y) covering the full
+  // texture (v running top-down to match ImageMesh).
+  void AddQuad(float x, float y, float z, float width, float height) {
+    AddQuad(x, y, z, width, height, 0, 0, 65535, 65535);
+  }
+
+  // Add a quad covering a sub-rect of the texture (16 bit uvs).
+  void AddQuad(float x, float y, float z, float width, float height,
+               uint16_t u_min, uint16_t v_min, uint16_t u_max,
+               uint16_t v_max) {
+    assert(vertices_.size() + 4 <= 65536);
+    auto start = static_cast<uint16_t>(vertices_.size());
+    vertices_.push_back({x, y, z, u_min, v_max});
+    vertices_.push_back({x + width, y, z, u_max, v_max});
+    vertices_.push_back({x, y + height, z, u_min, v_min});
+    vertices_.push_back({x + width, y + height, z, u_max, v_min});
+    uint16_t quad_indices[] = {
+        start,
+        static_cast<uint16_t>(start + 1),
+        static_cast<uint16_t>(start + 2),
+        static_cast<uint16_t>(start + 1),
+        static_cast<uint16_t>(start + 3),
+        static_cast<uint16_t>(start + 2)};
+    indices_.insert(indices_.end(), quad_indices, quad_indices + 6);
+  }
+
+  auto empty() const -> bool { return vertices_.empty(); }
+
+  // Push accumulated quads to the mesh for drawing.
+  void Commit() {
+    assert(!vertices_.empty());
+    SetIndexData(
+        Object::New<MeshIndexBuffer16>(indices_.size(), indices_.data()));
+    SetData(Object::New<MeshBuffer<VertexSimpleFull>>(vertices_.size(),
+                                                      vertices_.data()));
+  }
+
+ private:
+  std::vector<VertexSimpleFull> vertices_;
+  std::vector<uint16_t> indices_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_GRAPHICS_MESH_QUAD_BATCH_MESH_H_
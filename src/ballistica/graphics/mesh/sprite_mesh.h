@@ -4,6 +4,7 @@
 #define BALLISTICA_GRAPHICS_MESH_SPRITE_MESH_H_
 
 #include "ballistica/graphics/mesh/mesh_indexed.h"
+#include "ballistica/graphics/mesh/mesh_non_indexed.h"
 
 namespace ballistica {
 
@@ -12,6 +13,16 @@ class SpriteMesh : public MeshIndexed<VertexSprite, MeshDataType::kSprite> {
   using MeshIndexed::MeshIndexed;  // wheeee c++11 magic
 };
 
+// A sprite-mesh fed one element per sprite; the renderer expands each
+// entry to a quad on the gpu (uv is ignored; corners come from a shared
+// static buffer). Only valid when the renderer reports sprite-instancing
+// support (see Graphics::supports_sprite_instancing()); producers should
+// keep filling a regular SpriteMesh otherwise.
+class SpriteMeshInstanced
+    : public MeshNonIndexed<VertexSprite, MeshDataType::kSpriteInstanced> {
+  using MeshNonIndexed::MeshNonIndexed;
+};
+
 }  // namespace ballistica
 
 #endif  // BALLISTICA_GRAPHICS_MESH_SPRITE_MESH_H_
@@ -42,6 +42,32 @@ void TextMesh::SetText(const std::string& text_in, HAlign alignment_h,
     assert(packer != nullptr);
   }
 
+  // When no packer is involved, our output is a pure function of the
+  // string and style args, so check for a cached shaped copy of this run.
+  // (packer output depends on per-group dynamic texture packing so we
+  // can't cache that). This lets repeated strings (scores, player names,
+  // etc) skip layout and mesh fill entirely.
+  std::string cache_key;
+  if (packer == nullptr) {
+    cache_key = std::to_string(static_cast<int>(alignment_h))
+                + std::to_string(static_cast<int>(alignment_v))
+                + (big ? "1" : "0") + std::to_string(min_val) + ","
+                + std::to_string(max_val) + ","
+                + std::to_string(static_cast<int>(entry_type)) + ":" + text_in;
+    if (TextGraphics::ShapedTextCacheEntry* cached =
+            g_text_graphics->GetCachedShapedText(cache_key)) {
+      if (cached->indices.empty()) {
+        SetEmpty();
+      } else {
+        SetIndexData(Object::New<MeshIndexBuffer16>(cached->indices.size(),
+                                                    cached->indices.data()));
+        SetData(Object::New<MeshBuffer<VertexDualTextureFull>>(
+            cached->vertices.size(), cached->vertices.data()));
+      }
+      return;
+    }
+  }
+
   // Start buffers big enough to handle the worst case
   // (every char being a discrete letter).
   int text_size = static_cast<int>(text_in.size());
@@ -539,6 +565,15 @@ void TextMesh::SetText(const std::string& text_in, HAlign alignment_h,
   }
   vertices->elements.resize(v - (&(vertices->elements[0])));
 
+  // Store the shaped result for reuse by other meshes of this same
+  // string/style (empty results included; those are cheap and common).
+  if (!cache_key.empty() && indices16.exists()) {
+    auto entry(Object::New<TextGraphics::ShapedTextCacheEntry>());
+    entry->vertices = vertices->elements;
+    entry->indices = indices16->elements;
+    g_text_graphics->CacheShapedText(cache_key, entry);
+  }
+
   // Either set data or abort if empty.
   if (index16 && !indices16->elements.empty()) {
     SetIndexData(indices16);
@@ -2,6 +2,7 @@
 
 #include "ballistica/graphics/net_graph.h"
 
+#include <algorithm>
 #include <list>
 #include <utility>
 
@@ -9,13 +10,23 @@
 
 namespace ballistica {
 
+// Lane colors for stacked graphs (lane 0 keeps the classic green so
+// single-series graphs look unchanged).
+static const float kLaneColors[][3] = {
+    {0.0f, 1.0f, 0.0f}, {1.0f, 0.8f, 0.0f}, {0.2f, 0.5f, 1.0f},
+    {1.0f, 0.3f, 1.0f}, {0.5f, 1.0f, 1.0f}, {1.0f, 0.4f, 0.2f},
+};
+static const int kLaneColorCount =
+    sizeof(kLaneColors) / sizeof(kLaneColors[0]);
+
 class NetGraph::Impl {
  public:
-  std::list<std::pair<double, float>> samples;
+  std::list<std::pair<double, std::vector<float>>> samples;
   double duration = 2000.0;
   double v_max_smoothed = 1.0;
+  std::string label;
   ImageMesh bg_mesh;
-  MeshIndexedSimpleFull value_mesh;
+  std::vector<std::unique_ptr<MeshIndexedSimpleFull>> lane_meshes;
   TextGroup max_vel_text;
 };
 
@@ -24,11 +35,15 @@ NetGraph::NetGraph() : impl_(new NetGraph::Impl()) {}
 NetGraph::~NetGraph() = default;
 
 void NetGraph::AddSample(double time, double value) {
-  impl_->samples.emplace_back(time, value);
+  AddSamples(time, {static_cast<float>(value)});
+}
+
+void NetGraph::AddSamples(double time, const std::vector<float>& values) {
+  impl_->samples.emplace_back(time, values);
   double cutoffTime = time - impl_->duration;
 
   // Go ahead and prune old ones here so we don't grow out of control.
-  std::list<std::pair<double, float>>::iterator i;
+  std::list<std::pair<double, std::vector<float>>>::iterator i;
   for (i = impl_->samples.begin(); i != impl_->samples.end();) {
     if (i->first < cutoffTime) {
       auto i_next = i;
@@ -41,6 +56,8 @@ void NetGraph::AddSample(double time, double value) {
   }
 }
 
+void NetGraph::SetLabel(const std::string& label) { impl_->label = label; }
+
 void NetGraph::Draw(RenderPass* pass, double time, double x, double y, double w,
                     double h) {
   impl_->bg_mesh.SetPositionAndSize(
@@ -49,20 +66,31 @@ void NetGraph::Draw(RenderPass* pass, double time, double x, double y, double w,
 
   int num_samples = static_cast<int>(impl_->samples.size());
 
+  // How many lanes we're drawing (samples should agree on this but be
+  // safe and take the max).
+  int lane_count = 0;
+  for (auto&& s : impl_->samples) {
+    lane_count = std::max(lane_count, static_cast<int>(s.second.size()));
+  }
+
   // Draw values (provided we have at least 2 samples)
-  bool draw_values = (num_samples >= 2);
+  bool draw_values = (num_samples >= 2 && lane_count > 0);
   if (draw_values) {
     double t_left = time - impl_->duration;
     double t_right = time;
     double t_width = t_right - t_left;
     double v_bottom = 0.0f;
 
-    // Find the max y value we have and smoothly transition our bounds towards
-    // that.
+    // Find the max stacked total we have and smoothly transition our
+    // bounds towards that.
     double v_max = 0.0;
     for (auto&& s : impl_->samples) {
-      if (s.second > v_max) {
-        v_max = s.second;
+      double total = 0.0;
+      for (float val : s.second) {
+        total += val;
+      }
+      if (total > v_max) {
+        v_max = total;
       }
     }
     double smoothing = 0.95;
@@ -72,64 +100,90 @@ void NetGraph::Draw(RenderPass* pass, double time, double x, double y, double w,
     double v_top = impl_->v_max_smoothed;
     double v_height = v_top - v_bottom;
 
-    // We need 2 verts per sample.
-    auto vertex_buffer(
-        Object::New<MeshBuffer<VertexSimpleFull>>(num_samples * 2));
-    VertexSimpleFull* v = vertex_buffer->elements.data();
-    for (auto&& s : impl_->samples) {
-      double t = s.first;
-      double val = s.second;
-      double vx = x + w * ((t - t_left) / t_width);
-      double vy = y + h * ((val - v_bottom) / v_height);
-      v->position[0] = static_cast<float>(vx);
-      v->position[1] = static_cast<float>(y);
-      v->position[2] = 0.0f;
-      v->uv[0] = v->uv[1] = 0;
-      v++;
-      v->position[0] = static_cast<float>(vx);
-      v->position[1] = static_cast<float>(vy);
-      v->position[2] = 0.0f;
-      v->uv[0] = v->uv[1] = 0;
-      v++;
+    while (static_cast<int>(impl_->lane_meshes.size()) < lane_count) {
+      impl_->lane_meshes.push_back(
+          std::make_unique<MeshIndexedSimpleFull>());
     }
 
-    // We need 2 tris per sample (minus the last).
-    auto index_buffer(Object::New<MeshIndexBuffer16>((num_samples - 1) * 6));
-    uint16_t* i = index_buffer->elements.data();
-    auto s = impl_->samples.begin();
-    int v_count = 0;
-    while (true) {
-      auto s_next = s;
-      ++s_next;
-      if (s_next == impl_->samples.end()) {
-        break;
-      } else {
-        *i++ = static_cast_check_fit<uint16_t>(v_count);
-        *i++ = static_cast_check_fit<uint16_t>(v_count + 2);
-        *i++ = static_cast_check_fit<uint16_t>(v_count + 1);
-        *i++ = static_cast_check_fit<uint16_t>(v_count + 2);
-        *i++ = static_cast_check_fit<uint16_t>(v_count + 3);
-        *i++ = static_cast_check_fit<uint16_t>(v_count + 1);
+    // Build one band mesh per lane; each band sits on the sum of the
+    // lanes below it.
+    for (int lane = 0; lane < lane_count; lane++) {
+      // We need 2 verts per sample.
+      auto vertex_buffer(
+          Object::New<MeshBuffer<VertexSimpleFull>>(num_samples * 2));
+      VertexSimpleFull* v = vertex_buffer->elements.data();
+      for (auto&& s : impl_->samples) {
+        double t = s.first;
+        double band_bottom = 0.0;
+        for (int l = 0; l < lane && l < static_cast<int>(s.second.size());
+             l++) {
+          band_bottom += s.second[l];
+        }
+        double band_top = band_bottom;
+        if (lane < static_cast<int>(s.second.size())) {
+          band_top += s.second[lane];
+        }
+        double vx = x + w * ((t - t_left) / t_width);
+        double vy0 = y + h * ((band_bottom - v_bottom) / v_height);
+        double vy1 = y + h * ((band_top - v_bottom) / v_height);
+        v->position[0] = static_cast<float>(vx);
+        v->position[1] = static_cast<float>(vy0);
+        v->position[2] = 0.0f;
+        v->uv[0] = v->uv[1] = 0;
+        v++;
+        v->position[0] = static_cast<float>(vx);
+        v->position[1] = static_cast<float>(vy1);
+        v->position[2] = 0.0f;
+        v->uv[0] = v->uv[1] = 0;
+        v++;
+      }
+
+      // We need 2 tris per sample (minus the last).
+      auto index_buffer(Object::New<MeshIndexBuffer16>((num_samples - 1) * 6));
+      uint16_t* i = index_buffer->elements.data();
+      auto s = impl_->samples.begin();
+      int v_count = 0;
+      while (true) {
+        auto s_next = s;
+        ++s_next;
+        if (s_next == impl_->samples.end()) {
+          break;
+        } else {
+          *i++ = static_cast_check_fit<uint16_t>(v_count);
+          *i++ = static_cast_check_fit<uint16_t>(v_count + 2);
+          *i++ = static_cast_check_fit<uint16_t>(v_count + 1);
+          *i++ = static_cast_check_fit<uint16_t>(v_count + 2);
+          *i++ = static_cast_check_fit<uint16_t>(v_count + 3);
+          *i++ = static_cast_check_fit<uint16_t>(v_count + 1);
+        }
+        v_count += 2;
+        s = s_next;
       }
-      v_count += 2;
-      s = s_next;
+      impl_->lane_meshes[lane]->SetIndexData(index_buffer);
+      impl_->lane_meshes[lane]->SetData(vertex_buffer);
     }
-    impl_->value_mesh.SetIndexData(index_buffer);
-    impl_->value_mesh.SetData(vertex_buffer);
   }
 
   SimpleComponent c(pass);
   c.SetTransparent(true);
   c.SetColor(0.35f, 0.0f, 0.0f, 0.9f);
   c.DrawMesh(&impl_->bg_mesh);
-  c.SetColor(0.0f, 1.0f, 0.0f, 0.85f);
   if (draw_values) {
-    c.DrawMesh(&impl_->value_mesh);
+    for (int lane = 0; lane < lane_count; lane++) {
+      const float* col = kLaneColors[lane % kLaneColorCount];
+      c.SetColor(col[0], col[1], col[2], 0.85f);
+      c.DrawMesh(impl_->lane_meshes[lane].get());
+    }
   }
   c.Submit();
 
-  char val_str[32];
-  snprintf(val_str, sizeof(val_str), "%.2f", impl_->v_max_smoothed);
+  char val_str[96];
+  if (impl_->label.empty()) {
+    snprintf(val_str, sizeof(val_str), "%.2f", impl_->v_max_smoothed);
+  } else {
+    snprintf(val_str, sizeof(val_str), "%s %.2f", impl_->label.c_str(),
+             impl_->v_max_smoothed);
+  }
   impl_->max_vel_text.SetText(val_str, TextMesh::HAlign::kLeft,
                               TextMesh::VAlign::kTop);
 
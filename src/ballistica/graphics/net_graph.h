@@ -4,6 +4,8 @@
 #define BALLISTICA_GRAPHICS_NET_GRAPH_H_
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "ballistica/core/object.h"
 
@@ -14,6 +16,14 @@ class NetGraph : public Object {
   NetGraph();
   ~NetGraph() override;
   void AddSample(double time, double value);
+
+  // Multi-lane form: one value per lane, drawn stacked (lane 0 at the
+  // bottom). Lane count should stay consistent between calls.
+  void AddSamples(double time, const std::vector<float>& values);
+
+  // Optional tag drawn alongside the max-value readout.
+  void SetLabel(const std::string& label);
+
   void Draw(RenderPass* pass, double time, double x, double y, double w,
             double h);
 
@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_GRAPHICS_RENDER_COMMAND_BUFFER_H_
 #define BALLISTICA_GRAPHICS_RENDER_COMMAND_BUFFER_H_
 
+#include <algorithm>
+#include <type_traits>
 #include <vector>
 
 #include "ballistica/ballistica.h"
@@ -54,180 +56,94 @@ class RenderCommandBuffer {
   };
 
   RenderCommandBuffer() = default;
-  void PutCommand(Command c) {
-    assert(!finalized_);
-    commands_.push_back(c);
-  }
-
-  void PutFloat(float val) {
-    assert(!finalized_);
-    fvals_.push_back(val);
-  }
-
-  void PutFloats(float f1, float f2) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 2);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f = f2;
-  }
-
-  void PutFloats(float f1, float f2, float f3) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 3);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f = f3;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 4);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f = f4;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 5);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f = f5;
-  }
 
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 6);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f = f6;
-  }
+  // A copyable snapshot of a buffer's complete content; used to detect
+  // passes whose commands are unchanged from the previous frame.
+  struct ContentSnapshot {
+    std::vector<Command> commands;
+    std::vector<float> fvals;
+    std::vector<int> ivals;
+    std::vector<ModelData*> models;
+    std::vector<TextureData*> textures;
+    std::vector<MeshData*> mesh_datas;
+  };
 
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7) {
+  void CaptureContent(ContentSnapshot* snapshot) const {
+    snapshot->commands = commands_;
+    snapshot->fvals = fvals_;
+    snapshot->ivals = ivals_;
+    snapshot->models = models_;
+    snapshot->textures = textures_;
+    snapshot->mesh_datas = mesh_datas_;
+  }
+
+  // Whether our content exactly matches a previously captured snapshot.
+  // Note that matching asset pointers only imply matching output if the
+  // assets themselves haven't been updated in the interim; callers need
+  // to rule that out separately (see the frame-def mesh-upload list).
+  auto MatchesContent(const ContentSnapshot& snapshot) const -> bool {
+    return commands_ == snapshot.commands && fvals_ == snapshot.fvals
+           && ivals_ == snapshot.ivals && models_ == snapshot.models
+           && textures_ == snapshot.textures
+           && mesh_datas_ == snapshot.mesh_datas;
+  }
+
+  // Build a sort key for a component's command block. Pass and shader
+  // occupy the high bits so blocks group by shader bind first; texture
+  // bits get folded in automatically as textures are Put (see
+  // PutTexture).
+  static auto MakeSortKey(int pass_type, int shader) -> uint64_t {
+    return (static_cast<uint64_t>(pass_type) << 56u)
+           | (static_cast<uint64_t>(shader) << 40u);
+  }
+
+  // Mark the start of a sortable block of commands (a self-contained
+  // component submission: begins with its own shader bind and leaves
+  // transform/scissor state balanced). At Finalize() time, runs of
+  // consecutive sortable blocks get stably reordered by key so the
+  // renderer sees like shaders/textures together; anything written
+  // outside a block acts as a barrier and never moves.
+  void BeginSortBlock(uint64_t key) {
     assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 7);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f = f7;
+    assert(!block_open_);
+    CloseSegment(0, false);  // Anything since the last block is a barrier.
+    block_open_ = true;
+    block_key_ = key;
+    block_key_has_texture_ = false;
+  }
+
+  void EndSortBlock() {
+    // Tolerate no-block cases (components that never wrote a shader
+    // config don't open one).
+    if (!block_open_) {
+      return;
+    }
+    block_open_ = false;
+    CloseSegment(block_key_, true);
   }
 
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8) {
+  void PutCommand(Command c) {
     assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 8);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f = f8;
+    commands_.push_back(c);
   }
 
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8, float f9) {
+  void PutFloat(float val) {
     assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 9);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f++ = f8;
-    *f = f9;
+    fvals_.push_back(val);
   }
 
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8, float f9, float f10) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 10);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f++ = f8;
-    *f++ = f9;
-    *f = f10;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8, float f9, float f10, float f11,
-                 float f12) {
-    assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 12);
-    float* f = &(fvals_[s]);
-    *f++ = f1;
-    *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f++ = f8;
-    *f++ = f9;
-    *f++ = f10;
-    *f++ = f11;
-    *f = f12;
-  }
-
-  void PutFloats(float f1, float f2, float f3, float f4, float f5, float f6,
-                 float f7, float f8, float f9, float f10, float f11, float f12,
-                 float f13, float f14, float f15) {
+  // Append a run of floats as a single compile-time-sized write; the
+  // buffer grows once and values land unchecked after that.
+  template <typename... ARGS>
+  void PutFloats(float f1, float f2, ARGS... args) {
+    static_assert((std::is_convertible_v<ARGS, float> && ...));
     assert(!finalized_);
-    int s = static_cast<int>(fvals_.size());
-    fvals_.resize(fvals_.size() + 15);
-    float* f = &(fvals_[s]);
+    size_t s = fvals_.size();
+    fvals_.resize(s + 2 + sizeof...(ARGS));
+    float* f = fvals_.data() + s;
     *f++ = f1;
     *f++ = f2;
-    *f++ = f3;
-    *f++ = f4;
-    *f++ = f5;
-    *f++ = f6;
-    *f++ = f7;
-    *f++ = f8;
-    *f++ = f9;
-    *f++ = f10;
-    *f++ = f11;
-    *f++ = f12;
-    *f++ = f13;
-    *f++ = f14;
-    *f = f15;
+    ((*f++ = static_cast<float>(args)), ...);
   }
 
   void PutFloatArray16(const float* f_in) {
@@ -255,6 +171,18 @@ class RenderCommandBuffer {
     ivals_.push_back(val);
   }
 
+  // Append a previously recorded run of commands/values verbatim (see
+  // RenderComponentTemplate). Textures are not handled here; they get
+  // re-Put individually so frame refs and sort-key folding still apply.
+  void PutRecordedRun(const std::vector<Command>& commands,
+                      const std::vector<float>& fvals,
+                      const std::vector<int>& ivals) {
+    assert(!finalized_);
+    commands_.insert(commands_.end(), commands.begin(), commands.end());
+    fvals_.insert(fvals_.end(), fvals.begin(), fvals.end());
+    ivals_.insert(ivals_.end(), ivals.begin(), ivals.end());
+  }
+
   void PutModel(ModelData* model) {
     assert(frame_def_);
     assert(!finalized_);
@@ -267,6 +195,14 @@ class RenderCommandBuffer {
     assert(!finalized_);
     frame_def_->AddComponent(Object::Ref<MediaComponentData>(texture));
     textures_.push_back(texture);
+
+    // Fold the first texture of the open block into its sort key so
+    // same-shader blocks further group by texture.
+    if (block_open_ && !block_key_has_texture_) {
+      block_key_has_texture_ = true;
+      auto hash = reinterpret_cast<uintptr_t>(texture);
+      block_key_ |= static_cast<uint64_t>((hash >> 4u) & 0xFFFFFFFFu) << 8u;
+    }
   }
 
   void PutTexture(const Object::Ref<TextureData>& texture) {
@@ -306,149 +242,17 @@ class RenderCommandBuffer {
     return fvals_[fvals_index_++];
   }
 
-  void GetFloats(float* f1, float* f2) {
-    assert(finalized_);
-    assert(fvals_index_ + 2 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3) {
-    assert(finalized_);
-    assert(fvals_index_ + 3 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4) {
-    assert(finalized_);
-    assert(fvals_index_ + 4 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5) {
-    assert(finalized_);
-    assert(fvals_index_ + 5 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6) {
-    assert(finalized_);
-    assert(fvals_index_ + 6 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7) {
-    assert(finalized_);
-    assert(fvals_index_ + 7 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8) {
-    assert(finalized_);
-    assert(fvals_index_ + 8 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8, float* f9) {
-    assert(finalized_);
-    assert(fvals_index_ + 9 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-    *f9 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8, float* f9, float* f10) {
+  // Read a run of floats with a single compile-time-sized bounds check.
+  template <typename... ARGS>
+  void GetFloats(float* f1, float* f2, ARGS*... args) {
+    static_assert((std::is_same_v<ARGS, float> && ...));
     assert(finalized_);
-    assert(fvals_index_ + 10 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-    *f9 = fvals_[fvals_index_++];
-    *f10 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8, float* f9, float* f10,
-                 float* f11, float* f12) {
-    assert(finalized_);
-    assert(fvals_index_ + 12 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-    *f9 = fvals_[fvals_index_++];
-    *f10 = fvals_[fvals_index_++];
-    *f11 = fvals_[fvals_index_++];
-    *f12 = fvals_[fvals_index_++];
-  }
-
-  void GetFloats(float* f1, float* f2, float* f3, float* f4, float* f5,
-                 float* f6, float* f7, float* f8, float* f9, float* f10,
-                 float* f11, float* f12, float* f13, float* f14, float* f15) {
-    assert(finalized_);
-    assert(fvals_index_ + 15 <= fvals_.size());
-    *f1 = fvals_[fvals_index_++];
-    *f2 = fvals_[fvals_index_++];
-    *f3 = fvals_[fvals_index_++];
-    *f4 = fvals_[fvals_index_++];
-    *f5 = fvals_[fvals_index_++];
-    *f6 = fvals_[fvals_index_++];
-    *f7 = fvals_[fvals_index_++];
-    *f8 = fvals_[fvals_index_++];
-    *f9 = fvals_[fvals_index_++];
-    *f10 = fvals_[fvals_index_++];
-    *f11 = fvals_[fvals_index_++];
-    *f12 = fvals_[fvals_index_++];
-    *f13 = fvals_[fvals_index_++];
-    *f14 = fvals_[fvals_index_++];
-    *f15 = fvals_[fvals_index_++];
+    assert(fvals_index_ + 2 + sizeof...(ARGS) <= fvals_.size());
+    const float* f = fvals_.data() + fvals_index_;
+    fvals_index_ += 2 + sizeof...(ARGS);
+    *f1 = *f++;
+    *f2 = *f++;
+    ((*args = *f++), ...);
   }
 
   auto GetMatrix() -> Matrix44f* {
@@ -504,12 +308,16 @@ class RenderCommandBuffer {
     models_.resize(0);
     textures_.resize(0);
     mesh_datas_.resize(0);
+    segments_.resize(0);
+    block_open_ = false;
     finalized_ = false;
   }
 
   // Call once done writing to buffer.
   void Finalize() {
     assert(!finalized_);
+    assert(!block_open_);
+    SortBlocks();
     finalized_ = true;
   }
 
@@ -555,6 +363,106 @@ class RenderCommandBuffer {
   void set_frame_def(FrameDef* f) { frame_def_ = f; }
 
  private:
+  // A closed contiguous chunk of the stream: either one sortable
+  // component block or the barrier material between blocks. Ranges are
+  // [begin, end) into each of our parallel arrays.
+  struct Segment {
+    uint64_t key{};
+    uint32_t c_begin{}, c_end{};
+    uint32_t f_begin{}, f_end{};
+    uint32_t i_begin{}, i_end{};
+    uint32_t m_begin{}, m_end{};
+    uint32_t t_begin{}, t_end{};
+    uint32_t md_begin{}, md_end{};
+    bool sortable{};
+  };
+
+  // Close off everything written since the last segment end as a new
+  // segment (skipped if that region is empty).
+  void CloseSegment(uint64_t key, bool sortable) {
+    Segment s;
+    if (!segments_.empty()) {
+      const Segment& prev = segments_.back();
+      s.c_begin = prev.c_end;
+      s.f_begin = prev.f_end;
+      s.i_begin = prev.i_end;
+      s.m_begin = prev.m_end;
+      s.t_begin = prev.t_end;
+      s.md_begin = prev.md_end;
+    }
+    s.c_end = static_cast<uint32_t>(commands_.size());
+    s.f_end = static_cast<uint32_t>(fvals_.size());
+    s.i_end = static_cast<uint32_t>(ivals_.size());
+    s.m_end = static_cast<uint32_t>(models_.size());
+    s.t_end = static_cast<uint32_t>(textures_.size());
+    s.md_end = static_cast<uint32_t>(mesh_datas_.size());
+    if (s.c_end == s.c_begin && s.f_end == s.f_begin && s.i_end == s.i_begin
+        && s.m_end == s.m_begin && s.t_end == s.t_begin
+        && s.md_end == s.md_begin) {
+      return;
+    }
+    s.key = key;
+    s.sortable = sortable;
+    segments_.push_back(s);
+  }
+
+  // Stably reorder runs of consecutive sortable segments by key and
+  // rebuild our arrays in the new order. No-op when nothing used the
+  // block api or nothing would move.
+  void SortBlocks() {
+    if (segments_.empty()) {
+      return;
+    }
+    CloseSegment(0, false);  // Trailing barrier material.
+    bool any_reordered = false;
+    size_t i = 0;
+    while (i < segments_.size()) {
+      if (!segments_[i].sortable) {
+        i++;
+        continue;
+      }
+      size_t run_end = i;
+      while (run_end < segments_.size() && segments_[run_end].sortable) {
+        run_end++;
+      }
+      if (run_end - i > 1) {
+        std::stable_sort(
+            segments_.begin() + static_cast<std::ptrdiff_t>(i),
+            segments_.begin() + static_cast<std::ptrdiff_t>(run_end),
+            [](const Segment& a, const Segment& b) { return a.key < b.key; });
+        any_reordered = true;
+      }
+      i = run_end;
+    }
+    if (!any_reordered) {
+      return;
+    }
+    // Rebuild in the new segment order through the frame's scratch
+    // arena rather than freshly-allocated vectors; this runs for every
+    // pass every frame so keeping malloc/free out of it matters. Our
+    // element types are all trivially copyable so plain copies do.
+    static_assert(std::is_trivially_copyable<Command>::value);
+    LinearArena* arena = frame_def()->arena();
+    auto reorder = [arena, this](auto* vec, auto Segment::*begin,
+                                 auto Segment::*end) {
+      using T = typename std::remove_reference<decltype((*vec)[0])>::type;
+      T* scratch = arena->AllocArray<T>(vec->size());
+      T* out = scratch;
+      for (const Segment& s : segments_) {
+        out = std::copy(vec->begin() + (s.*begin), vec->begin() + (s.*end),
+                        out);
+      }
+      assert(out == scratch + vec->size());
+      std::copy(scratch, scratch + vec->size(), vec->begin());
+    };
+    reorder(&commands_, &Segment::c_begin, &Segment::c_end);
+    reorder(&fvals_, &Segment::f_begin, &Segment::f_end);
+    reorder(&ivals_, &Segment::i_begin, &Segment::i_end);
+    reorder(&models_, &Segment::m_begin, &Segment::m_end);
+    reorder(&textures_, &Segment::t_begin, &Segment::t_end);
+    reorder(&mesh_datas_, &Segment::md_begin, &Segment::md_end);
+  }
+
   std::vector<Command> commands_;
   std::vector<float> fvals_;
   std::vector<int> ivals_;
@@ -567,6 +475,10 @@ class RenderCommandBuffer {
   unsigned int models_index_{};
   unsigned int textures_index_{};
   unsigned int mesh_datas_index_{};
+  std::vector<Segment> segments_;
+  uint64_t block_key_{};
+  bool block_open_{};
+  bool block_key_has_texture_{};
   bool finalized_{};
   FrameDef* frame_def_{};
 };
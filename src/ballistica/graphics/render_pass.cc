@@ -38,6 +38,35 @@ RenderPass::RenderPass(RenderPass::Type type_in, FrameDef* frame_def_in)
 
 RenderPass::~RenderPass() = default;
 
+auto RenderPass::TypeName(Type type) -> const char* {
+  switch (type) {
+    case Type::kLightShadowPass:
+      return "lightShadow";
+    case Type::kLightPass:
+      return "light";
+    case Type::kBeautyPass:
+      return "beauty";
+    case Type::kBeautyPassBG:
+      return "beautyBG";
+    case Type::kBlitPass:
+      return "blit";
+    case Type::kOverlayPass:
+      return "overlay";
+    case Type::kOverlayFrontPass:
+      return "overlayFront";
+    case Type::kOverlay3DPass:
+      return "overlay3D";
+    case Type::kOverlayFlatPass:
+      return "overlayFlat";
+    case Type::kVRCoverPass:
+      return "vrCover";
+    case Type::kOverlayFixedPass:
+      return "overlayFixed";
+    default:
+      return "unknown";
+  }
+}
+
 void RenderPass::Render(RenderTarget* render_target, bool transparent) {
   assert(InGraphicsThread());
 
@@ -48,6 +77,8 @@ void RenderPass::Render(RenderTarget* render_target, bool transparent) {
 
   Renderer* renderer = g_graphics_server->renderer();
 
+  renderer->BeginPassGPUTimer(type_);
+
   // Set up camera & depth.
   switch (type()) {
     case Type::kBeautyPass: {
@@ -326,6 +357,7 @@ void RenderPass::Render(RenderTarget* render_target, bool transparent) {
           ShadingType::kSimpleTexModulatedTransShadowFlatness,
           ShadingType::kSimpleTextureModulatedTransparentGlow,
           ShadingType::kSimpleTextureModulatedTransparentGlowMaskUV2,
+          ShadingType::kSimpleTextureModulatedTransparentSDF,
           ShadingType::kSmoke,
           ShadingType::kSprite};
 
@@ -363,6 +395,8 @@ void RenderPass::Render(RenderTarget* render_target, bool transparent) {
                                            render_target);
     }
   }
+
+  renderer->EndPassGPUTimer(type_);
 }
 
 void RenderPass::SetCamera(
@@ -383,6 +417,48 @@ void RenderPass::SetCamera(
   cam_fov_b_tan_ = fov_tan_b;
   cam_fov_t_tan_ = fov_tan_t;
   cam_area_of_interest_points_ = area_of_interest_points;
+  UpdateFrustumPlanes();
+}
+
+void RenderPass::UpdateFrustumPlanes() {
+  frustum_plane_count_ = 0;
+
+  // Only our perspective world passes get planes; everything else
+  // reports all spheres as visible.
+  if (type_ != Type::kBeautyPass && type_ != Type::kBeautyPassBG) {
+    return;
+  }
+  Vector3f forward = (cam_target_ - cam_pos_).Normalized();
+  Vector3f right = Vector3f::Cross(forward, cam_up_).Normalized();
+  Vector3f up = Vector3f::Cross(right, forward);
+  float tan_l, tan_r, tan_t, tan_b;
+  if (cam_use_fov_tangents_) {
+    tan_l = cam_fov_l_tan_;
+    tan_r = cam_fov_r_tan_;
+    tan_t = cam_fov_t_tan_;
+    tan_b = cam_fov_b_tan_;
+  } else {
+    tan_t = tan_b = tanf((cam_fov_y_ / 2.0f) * kPiDeg);
+    if (cam_fov_x_ > 0.0f) {
+      tan_l = tan_r = tanf((cam_fov_x_ / 2.0f) * kPiDeg);
+    } else {
+      tan_l = tan_r = tan_t * GetPhysicalAspectRatio();
+    }
+  }
+  auto add_plane = [this](const Vector3f& normal, float dist) {
+    frustum_plane_normals_[frustum_plane_count_] = normal;
+    frustum_plane_dists_[frustum_plane_count_] = dist;
+    frustum_plane_count_++;
+  };
+
+  // The four side planes pass through the camera position; near and far
+  // sit along the forward axis.
+  add_plane(Vector3f::Cross(forward - right * tan_l, up).Normalized(), 0.0f);
+  add_plane(Vector3f::Cross(up, forward + right * tan_r).Normalized(), 0.0f);
+  add_plane(Vector3f::Cross(forward + up * tan_t, right).Normalized(), 0.0f);
+  add_plane(Vector3f::Cross(right, forward - up * tan_b).Normalized(), 0.0f);
+  add_plane(forward, -cam_near_clip_);
+  add_plane(-forward, cam_far_clip_);
 }
 
 void RenderPass::Reset() {
@@ -398,6 +474,7 @@ void RenderPass::Reset() {
   cam_far_clip_ = kCamFarClip;
   cam_fov_x_ = -1.0f;
   cam_fov_y_ = 40.0f;
+  frustum_plane_count_ = 0;
   tex_project_matrix_ = kMatrix44fIdentity;
 
   Renderer* renderer = g_graphics_server->renderer();
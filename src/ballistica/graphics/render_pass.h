@@ -48,6 +48,9 @@ class RenderPass {
 
   auto type() const -> Type { return type_; }
 
+  // A short human-readable name for a pass type (for stats/debugging).
+  static auto TypeName(Type type) -> const char*;
+
   // The physical size of the drawing surface.
   auto physical_width() const -> float { return physical_width_; }
   auto physical_height() const -> float { return physical_height_; }
@@ -123,8 +126,24 @@ class RenderPass {
     return cam_area_of_interest_points_;
   }
 
+  // Conservative test of a world-space sphere against this pass's view
+  // frustum (usable on the game thread at submission time). Passes
+  // without a perspective camera always return true, so this is safe
+  // to query against any pass.
+  auto IsSphereInFrustum(const Vector3f& center, float radius) const -> bool {
+    for (int i = 0; i < frustum_plane_count_; i++) {
+      if (frustum_plane_normals_[i].Dot(center - cam_pos_)
+              + frustum_plane_dists_[i]
+          < -radius) {
+        return false;
+      }
+    }
+    return true;
+  }
+
  private:
   void SetFrustum(float near_val, float far_val);
+  void UpdateFrustumPlanes();
 
   // Our pass holds sets of draw-commands bucketed by section and
   // component-type.
@@ -147,6 +166,12 @@ class RenderPass {
   float cam_fov_t_tan_{1.0f};
   float cam_fov_b_tan_{1.0f};
   std::vector<Vector3f> cam_area_of_interest_points_;
+
+  // World-space frustum planes relative to cam_pos_ (normals point
+  // inward); zero count for passes where culling doesn't apply.
+  Vector3f frustum_plane_normals_[6]{};
+  float frustum_plane_dists_[6]{};
+  int frustum_plane_count_{};
   Type type_{};
 
   // For lights/shadows.
@@ -5,9 +5,11 @@
 #include <algorithm>
 #include <vector>
 
+#include "ballistica/graphics/graphics.h"
 #include "ballistica/graphics/graphics_server.h"
 #include "ballistica/graphics/text/text_packer.h"
 #include "ballistica/graphics/vr_graphics.h"
+#include "ballistica/platform/platform.h"
 
 // FIXME: Clear out conditional stuff.
 #if BA_OSTYPE_MACOS && BA_SDL_BUILD && !BA_SDL2_BUILD
@@ -66,6 +68,17 @@ void Renderer::PreprocessFrameDef(FrameDef* frame_def) {
   HandleFunkyMacGammaIssue(frame_def);
 #endif
 
+  // Pull the latest whole-frame GPU time measurement (if any); both the
+  // dynamic-resolution controller and auto-quality calibration feed off
+  // it and each measurement is only handed out once.
+  uint64_t frame_gpu_ns = GetFrameGPUTimeNs();
+
+  // Nudge our dynamic-resolution scale based on recent GPU frame times.
+  UpdateDynamicResolution(frame_def, frame_gpu_ns);
+
+  // And feed any in-progress auto-quality calibration run.
+  UpdateAutoQualityCalibration(frame_gpu_ns);
+
   // In some cases we draw to a lower-res backing buffer instead of native
   // screen res.
   UpdatePixelScaleAndBackingBuffer(frame_def);
@@ -85,11 +98,26 @@ void Renderer::PreprocessFrameDef(FrameDef* frame_def) {
   UpdateMeshes(frame_def->meshes(), frame_def->mesh_index_sizes(),
                frame_def->mesh_buffers());
 
+  // Note which meshes got new contents (for cached-pass reuse tests).
+  CollectMeshBufferStates(frame_def);
+
   // Ensure all media used by this frame_def is loaded.
   LoadMedia(frame_def);
 
+  // In half-rate-world mode we only re-render the world (and the light
+  // buffers feeding it) every other frame, reusing the camera buffer's
+  // contents in between. The camera buffer is shared between eyes in VR
+  // mode so we can't pull this trick there.
+  world_buffer_reuse_this_frame_ =
+      (half_rate_world_mode_ && !IsVRMode() && camera_render_target_.exists()
+       && world_buffer_valid_ && (frames_rendered_count_ % 2 == 1));
+
   // Draw our light/shadow textures.
-  RenderLightAndShadowPasses(frame_def);
+  // (their output only feeds the world passes, so skip them on
+  // world-reuse frames)
+  if (!world_buffer_reuse_this_frame_) {
+    RenderLightAndShadowPasses(frame_def);
+  }
 
   // In vr mode we draw our UI into a buffer.
 #if BA_VR_BUILD
@@ -116,7 +144,13 @@ void Renderer::RenderFrameDef(FrameDef* frame_def) {
   // which we'll later render into the backing buffer with depth-of-field
   // and other stuff added.
   if (camera_render_target_.exists()) {
-    DrawWorldToCameraBuffer(frame_def);
+    if (world_buffer_reuse_this_frame_) {
+      // The camera buffer already holds last frame's world; we'll just
+      // re-composite it below while the overlays draw fresh.
+    } else {
+      DrawWorldToCameraBuffer(frame_def);
+      world_buffer_valid_ = true;
+    }
   }
 
   // ..now draw everything into our backing target; either our camera
@@ -274,6 +308,9 @@ void Renderer::VRPreprocess(FrameDef* frame_def) {
         false,  // msaa
         true    // alpha
     );          // NOLINT(whitespace/parens)
+
+    // Fresh target; whatever we had cached in the old one is gone.
+    overlay_flat_cache_valid_ = false;
   }
   auto* vrgraphics = VRGraphics::get();
 
@@ -391,6 +428,12 @@ void Renderer::VRDrawOverlayFlatPass(FrameDef* frame_def) {
     // The overlay-flat pass should generally only have commands in it
     // when UI is visible; skip rendering it if not.
     if (frame_def->overlay_flat_pass()->HasDrawCommands()) {
+      // If the UI emitted exactly what it did last frame, the target
+      // already holds the right pixels; an idle widget tree then costs
+      // just the textured quad it gets composited with.
+      if (OverlayFlatPassUnchanged(frame_def)) {
+        return;
+      }
       PushGroupMarker("VR Overlay Flat Pass");
       SetDepthWriting(true);
       SetDepthTesting(true);
@@ -408,10 +451,48 @@ void Renderer::VRDrawOverlayFlatPass(FrameDef* frame_def) {
       SetDepthWriting(false);
       SetDepthTesting(false);
       SetDrawAtEqualDepth(false);
+
+      frame_def->overlay_flat_pass()->commands_flat()->CaptureContent(
+          &overlay_flat_cache_opaque_);
+      frame_def->overlay_flat_pass()->commands_flat_transparent()
+          ->CaptureContent(&overlay_flat_cache_transparent_);
+      overlay_flat_cache_valid_ = true;
+    } else {
+      overlay_flat_cache_valid_ = false;
     }
   }
 }
 
+auto Renderer::OverlayFlatPassUnchanged(FrameDef* frame_def) -> bool {
+  if (!overlay_flat_cache_valid_) {
+    return false;
+  }
+  RenderPass* pass = frame_def->overlay_flat_pass();
+  if (!pass->commands_flat()->MatchesContent(overlay_flat_cache_opaque_)
+      || !pass->commands_flat_transparent()->MatchesContent(
+          overlay_flat_cache_transparent_)) {
+    return false;
+  }
+
+  // Cursor translates sample the live cursor position at execution time,
+  // so buffers containing them are never static.
+  for (const RenderCommandBuffer::ContentSnapshot* snapshot :
+       {&overlay_flat_cache_opaque_, &overlay_flat_cache_transparent_}) {
+    for (auto&& command : snapshot->commands) {
+      if (command == RenderCommandBuffer::Command::kCursorTranslate) {
+        return false;
+      }
+    }
+
+    // Matching mesh pointers only mean matching output if none of those
+    // meshes got fresh data uploaded this frame.
+    if (!MeshContentsUnchanged(snapshot->mesh_datas)) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void Renderer::VRTransformToRightHand() {
   g_graphics_server->MultMatrix(vr_transform_right_hand_);
 }
@@ -436,6 +517,7 @@ void Renderer::UpdateSizesQualitiesAndColors(FrameDef* frame_def) {
     camera_render_target_.Clear();
     camera_msaa_render_target_.Clear();
     backing_render_target_.Clear();
+    world_buffer_valid_ = false;
     screen_size_dirty_ = false;
   }
 
@@ -443,6 +525,7 @@ void Renderer::UpdateSizesQualitiesAndColors(FrameDef* frame_def) {
   if (last_render_quality_ != frame_def->quality()) {
     light_render_target_.Clear();
     light_shadow_render_target_.Clear();
+    light_shadow_cache_valid_ = false;
     if (IsVRMode()) {
       vr_overlay_flat_render_target_.Clear();
     }
@@ -513,6 +596,13 @@ void Renderer::RenderLightAndShadowPasses(FrameDef* frame_def) {
   float light_tz = -22;
   SetLight(light_pitch, light_heading, light_tz);
 
+  // The light buffers persist between frames, so when every caster and
+  // the shadow projection are unchanged from the last frame we rendered,
+  // they already hold the right pixels.
+  if (LightShadowPassesUnchanged(frame_def)) {
+    return;
+  }
+
   // Draw our light/shadow buffers.
   SetDepthWriting(false);
   SetDepthTesting(false);
@@ -529,6 +619,93 @@ void Renderer::RenderLightAndShadowPasses(FrameDef* frame_def) {
                       1.0f);
   frame_def->light_shadow_pass()->Render(r_target, true);
   PopGroupMarker();
+
+  // Remember what we just rendered (light passes are transparent-only;
+  // see ConfigForShading's debug checks).
+  frame_def->light_pass()->commands_flat_transparent()->CaptureContent(
+      &light_cache_commands_);
+  frame_def->light_shadow_pass()->commands_flat_transparent()->CaptureContent(
+      &light_shadow_cache_commands_);
+  light_shadow_cache_offset_ = shadow_offset_;
+  light_shadow_cache_scale_x_ = shadow_scale_x_;
+  light_shadow_cache_scale_z_ = shadow_scale_z_;
+  light_shadow_cache_ortho_ = shadow_ortho_;
+  light_shadow_cache_valid_ = true;
+}
+
+auto Renderer::LightShadowPassesUnchanged(FrameDef* frame_def) -> bool {
+  if (!light_shadow_cache_valid_) {
+    return false;
+  }
+
+  // The shadow projection is baked into the buffers; any light or camera
+  // movement shifts it.
+  if (!(light_shadow_cache_offset_ == shadow_offset_)
+      || light_shadow_cache_scale_x_ != shadow_scale_x_
+      || light_shadow_cache_scale_z_ != shadow_scale_z_
+      || light_shadow_cache_ortho_ != shadow_ortho_) {
+    return false;
+  }
+  if (!frame_def->light_pass()->commands_flat_transparent()->MatchesContent(
+          light_cache_commands_)
+      || !frame_def->light_shadow_pass()
+              ->commands_flat_transparent()
+              ->MatchesContent(light_shadow_cache_commands_)) {
+    return false;
+  }
+
+  // Matching mesh pointers only mean matching output if none of those
+  // meshes got fresh contents this frame (casters that hold still skip
+  // their re-uploads, so this commonly holds).
+  return MeshContentsUnchanged(light_cache_commands_.mesh_datas)
+         && MeshContentsUnchanged(light_shadow_cache_commands_.mesh_datas);
+}
+
+void Renderer::CollectMeshBufferStates(FrameDef* frame_def) {
+  mesh_buffer_states_prev_.swap(mesh_buffer_states_now_);
+  mesh_buffer_states_now_.clear();
+  auto buffer = frame_def->mesh_buffers().begin();
+  for (auto&& handle : frame_def->meshes()) {
+    // Buffer counts here mirror FrameDef::AddMesh.
+    int buffer_count;
+    switch (handle->mesh_data->type()) {
+      case MeshDataType::kIndexedSimpleSplit:
+      case MeshDataType::kIndexedObjectSplit:
+        buffer_count = 3;
+        break;
+      case MeshDataType::kSpriteInstanced:
+        buffer_count = 1;
+        break;
+      default:
+        buffer_count = 2;
+        break;
+    }
+    uint32_t state{};
+    for (int i = 0; i < buffer_count; i++) {
+      assert(buffer != frame_def->mesh_buffers().end());
+      state = std::max(state, (*buffer)->state);
+      buffer++;
+    }
+    mesh_buffer_states_now_[handle->mesh_data] = state;
+  }
+  assert(buffer == frame_def->mesh_buffers().end());
+}
+
+auto Renderer::MeshContentsUnchanged(const std::vector<MeshData*>& mesh_datas)
+    -> bool {
+  for (MeshData* mesh_data : mesh_datas) {
+    auto now = mesh_buffer_states_now_.find(mesh_data);
+    if (now == mesh_buffer_states_now_.end()) {
+      // Not referenced this frame; its last-uploaded contents persist.
+      continue;
+    }
+    auto prev = mesh_buffer_states_prev_.find(mesh_data);
+    if (prev == mesh_buffer_states_prev_.end()
+        || prev->second != now->second) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void Renderer::UpdateCameraRenderTargets(FrameDef* frame_def) {
@@ -582,6 +759,7 @@ void Renderer::UpdateCameraRenderTargets(FrameDef* frame_def) {
           false,  // msaa
           false   // alpha
           ));     // NOLINT(whitespace/parens)
+      world_buffer_valid_ = false;
 
       // If screen size just changed or whatnot,
       // update whether we should do msaa.
@@ -610,27 +788,141 @@ void Renderer::UpdateCameraRenderTargets(FrameDef* frame_def) {
     camera_render_target_.Clear();
     camera_msaa_render_target_.Clear();
     blur_res_count_ = 0;
+    world_buffer_valid_ = false;
+  }
+}
+
+void Renderer::UpdateDynamicResolution(FrameDef* frame_def, uint64_t gpu_ns) {
+  if (!dynamic_res_enabled_ || IsVRMode()) {
+    dynamic_res_scale_ = 1.0f;
+    dynamic_res_gpu_avg_ms_ = 0.0f;
+    return;
+  }
+
+  // How much GPU work did the last completed frame take? (0 means no
+  // gpu-timer support or no fresh measurement; just coast in that case).
+  if (gpu_ns == 0) {
+    return;
+  }
+  float gpu_ms = static_cast<float>(gpu_ns) / 1000000.0f;
+  if (dynamic_res_gpu_avg_ms_ == 0.0f) {
+    dynamic_res_gpu_avg_ms_ = gpu_ms;
+  } else {
+    dynamic_res_gpu_avg_ms_ = 0.9f * dynamic_res_gpu_avg_ms_ + 0.1f * gpu_ms;
+  }
+
+  // We aim to keep GPU time comfortably inside a 60hz frame; scale
+  // changes rebuild render-targets so rate-limit them and require clear
+  // headroom before scaling back up (hysteresis; otherwise we'd bounce
+  // between two scales forever).
+  millisecs_t now = GetRealTime();
+  if (now - dynamic_res_last_change_time_ < 500) {
+    return;
+  }
+  float new_scale = dynamic_res_scale_;
+  if (dynamic_res_gpu_avg_ms_ > 15.0f) {
+    new_scale = std::max(0.5f, dynamic_res_scale_ - 0.1f);
+  } else if (dynamic_res_gpu_avg_ms_ < 11.0f) {
+    new_scale = std::min(1.0f, dynamic_res_scale_ + 0.1f);
+  }
+  if (new_scale != dynamic_res_scale_) {
+    dynamic_res_scale_ = new_scale;
+    dynamic_res_last_change_time_ = now;
+
+    // Timings from the old resolution don't apply anymore.
+    dynamic_res_gpu_avg_ms_ = 0.0f;
+  }
+}
+
+void Renderer::StartAutoQualityCalibration(int gpu_key) {
+  // (re)starting with a different key is fine; results just land under
+  // the new one.
+  auto_quality_calibrating_ = true;
+  auto_quality_gpu_key_ = gpu_key;
+  auto_quality_warmup_frames_left_ = 120;
+  auto_quality_sample_count_ = 0;
+  auto_quality_sample_total_ms_ = 0.0;
+}
+
+void Renderer::UpdateAutoQualityCalibration(uint64_t gpu_ns) {
+  if (!auto_quality_calibrating_) {
+    return;
+  }
+
+  // Only count frames we actually got a measurement for; early frames are
+  // full of shader compiles and texture uploads (and progress-bar frames
+  // cost next to nothing) so we burn a warmup period before sampling.
+  if (gpu_ns == 0) {
+    return;
+  }
+  if (auto_quality_warmup_frames_left_ > 0) {
+    auto_quality_warmup_frames_left_--;
+    return;
+  }
+  auto_quality_sample_total_ms_ +=
+      static_cast<double>(gpu_ns) / 1000000.0;
+  auto_quality_sample_count_++;
+  if (auto_quality_sample_count_ < 150) {
+    return;
+  }
+
+  // Done measuring. We can't know what a quality we're *not* running
+  // would cost, so we simply nudge off the heuristic guess we launched
+  // with: lots of headroom bumps us up a notch; a blown frame budget
+  // knocks us down one (or two if things are really dire).
+  auto avg_ms = static_cast<float>(auto_quality_sample_total_ms_
+                                   / auto_quality_sample_count_);
+  auto quality = g_graphics_server->quality();
+  int q = static_cast<int>(quality);
+  if (avg_ms > 25.0f) {
+    q -= 2;
+  } else if (avg_ms > 15.0f) {
+    q -= 1;
+  } else if (avg_ms < 7.0f) {
+    q += 1;
+  }
+  q = std::max(q, static_cast<int>(GraphicsQuality::kLow));
+  int max_q = g_graphics->supports_high_quality_graphics()
+                  ? static_cast<int>(GraphicsQuality::kHigher)
+                  : static_cast<int>(GraphicsQuality::kMedium);
+  q = std::min(q, max_q);
+
+  // Store the result keyed to this gpu/driver; GetAutoGraphicsQuality()
+  // returns it from here on out (until a driver update or gpu swap
+  // changes the key and triggers a fresh calibration).
+  g_platform->SetLowLevelConfigValue("auto_gfx_quality_gpu",
+                                     auto_quality_gpu_key_);
+  g_platform->SetLowLevelConfigValue("auto_gfx_quality", q);
+  auto_quality_calibrating_ = false;
+
+  if (static_cast<GraphicsQuality>(q) != quality) {
+    Log("Graphics calibration: measured " + std::to_string(avg_ms)
+        + "ms gpu frames; switching auto quality preset.");
+    g_graphics_server->PushReapplyAutoGraphicsQualityCall();
   }
 }
 
 void Renderer::UpdatePixelScaleAndBackingBuffer(FrameDef* frame_def) {
+  // Our effective scale is the user-requested pixel-scale times whatever
+  // the dynamic-resolution controller currently wants.
+  float scale_request =
+      std::min(1.0f, std::max(0.1f, pixel_scale_requested_))
+      * dynamic_res_scale_;
+
   // If our pixel-scale is changing its essentially the same as a resolution
   // change, so we wanna rebuild our light/shadow buffers and all that.
-  if (pixel_scale_requested_ != pixel_scale_) {
+  if (scale_request != pixel_scale_) {
     ScreenSizeChanged();
   }
 
   // Create or destroy our backing render-target as necessary.
   // We need our backing buffer for non-1.0 pixel-scales.
-  if (pixel_scale_requested_ != 1.0f) {
-    if (pixel_scale_requested_ != pixel_scale_
-        || !backing_render_target_.exists()) {
-      float pixel_scale_fin =
-          std::min(1.0f, std::max(0.1f, pixel_scale_requested_));
+  if (scale_request != 1.0f) {
+    if (scale_request != pixel_scale_ || !backing_render_target_.exists()) {
       int w = static_cast<int>(screen_render_target_->physical_width()
-                               * pixel_scale_fin);
+                               * scale_request);
       int h = static_cast<int>(screen_render_target_->physical_height()
-                               * pixel_scale_fin);
+                               * scale_request);
       backing_render_target_ =
           NewFramebufferRenderTarget(w, h,
                                      true,   // linear interp
@@ -648,7 +940,7 @@ void Renderer::UpdatePixelScaleAndBackingBuffer(FrameDef* frame_def) {
       backing_render_target_.Clear();
     }
   }
-  pixel_scale_ = pixel_scale_requested_;
+  pixel_scale_ = scale_request;
 }
 
 void Renderer::LoadMedia(FrameDef* frame_def) {
@@ -773,6 +1065,7 @@ void Renderer::CheckCapabilities() {}
 void Renderer::Unload() {
   light_render_target_.Clear();
   light_shadow_render_target_.Clear();
+  light_shadow_cache_valid_ = false;
   vr_overlay_flat_render_target_.Clear();
   screen_render_target_.Clear();
   backing_render_target_.Clear();
@@ -5,6 +5,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/core/object.h"
@@ -87,11 +88,44 @@ class Renderer {
   void set_debug_draw_mode(bool debugModeIn) { debug_draw_mode_ = debugModeIn; }
   auto debug_draw_mode() -> bool { return debug_draw_mode_; }
 
+  // In half-rate-world mode, the world (beauty/light) passes only
+  // re-render every other frame; overlay/UI passes still run at the full
+  // display rate. Only kicks in when the world is drawn through the
+  // camera buffer (high-quality modes).
+  void set_half_rate_world_mode(bool enable) {
+    half_rate_world_mode_ = enable;
+  }
+  auto half_rate_world_mode() const -> bool { return half_rate_world_mode_; }
+
+  // With dynamic resolution enabled, the scale of the backing buffer the
+  // scene renders through adjusts on the fly based on measured GPU frame
+  // times, trading resolution to hold the display rate when a scene
+  // overloads the GPU. Requires a backend with GPU timers; a no-op
+  // otherwise.
+  void set_dynamic_resolution(bool enable) {
+    dynamic_res_enabled_ = enable;
+  }
+  auto dynamic_resolution() const -> bool { return dynamic_res_enabled_; }
+
+  // While an auto-graphics-quality calibration run is active, backends
+  // should keep their GPU pass timers on so we get real frame costs to
+  // work with (see UpdateAutoQualityCalibration()).
+  auto auto_quality_calibrating() const -> bool {
+    return auto_quality_calibrating_;
+  }
+
   // Used when recreating contexts.
   virtual void Unload();
   virtual void Load();
   virtual void PostLoad();
   virtual void CheckCapabilities();
+
+  // Whether the backend can render both VR eyes in a single pass
+  // (OVR_multiview2 or equivalent). The platform VR layer checks this when
+  // setting up its swapchain; hardware without it keeps the classic
+  // one-pass-per-eye flow.
+  virtual auto supports_single_pass_stereo() const -> bool { return false; }
+
   virtual auto GetAutoGraphicsQuality() -> GraphicsQuality = 0;
   virtual auto GetAutoTextureQuality() -> TextureQuality = 0;
 
@@ -163,7 +197,26 @@ class Renderer {
   virtual void SetDepthRange(float min, float max) = 0;
   virtual void FlipCullFace() = 0;
 
+  // Hooks bracketing each render-pass execution; backends with GPU
+  // timer-query support use these to gather per-pass GPU-time stats.
+  virtual void BeginPassGPUTimer(RenderPass::Type type) {}
+  virtual void EndPassGPUTimer(RenderPass::Type type) {}
+
+  // Total measured GPU time for the most recently completed frame, in
+  // nanoseconds, or 0 if no new measurement is available. Feeds the
+  // dynamic-resolution controller; each measurement is handed out once.
+  virtual auto GetFrameGPUTimeNs() -> uint64_t { return 0; }
+
  protected:
+  // Kick off a measured auto-quality calibration run. Called by backends
+  // from GetAutoGraphicsQuality() when they have GPU timer support but no
+  // stored measurement for the current gpu/driver combo (identified by
+  // gpu_key). The run quietly measures real frame costs for the first few
+  // seconds of play, stores a quality preset derived from them, and
+  // reloads the renderer if that differs from the heuristic guess we
+  // launched with.
+  void StartAutoQualityCalibration(int gpu_key);
+
   virtual void DrawDebug() = 0;
   virtual void CheckForErrors() = 0;
   virtual void UpdateVignetteTex(bool force) = 0;
@@ -207,12 +260,25 @@ class Renderer {
   void UpdateSizesQualitiesAndColors(FrameDef* frame_def);
   void DrawWorldToCameraBuffer(FrameDef* frame_def);
   void UpdatePixelScaleAndBackingBuffer(FrameDef* frame_def);
+  void UpdateDynamicResolution(FrameDef* frame_def, uint64_t gpu_ns);
+  void UpdateAutoQualityCalibration(uint64_t gpu_ns);
   void UpdateCameraRenderTargets(FrameDef* frame_def);
 #if BA_OSTYPE_MACOS && BA_SDL_BUILD && !BA_SDL2_BUILD
   void HandleFunkyMacGammaIssue(FrameDef* frame_def);
 #endif
   void LoadMedia(FrameDef* frame_def);
   void UpdateDOFParams(FrameDef* frame_def);
+  auto OverlayFlatPassUnchanged(FrameDef* frame_def) -> bool;
+  auto LightShadowPassesUnchanged(FrameDef* frame_def) -> bool;
+
+  // Record the buffer states of every mesh referenced by this frame-def
+  // (swapping out last frame's record); lets cached passes detect when
+  // a referenced mesh got fresh contents.
+  void CollectMeshBufferStates(FrameDef* frame_def);
+
+  // Whether none of the given mesh-datas received new buffer contents
+  // this frame.
+  auto MeshContentsUnchanged(const std::vector<MeshData*>& mesh_datas) -> bool;
 #if BA_VR_BUILD
   void VRPreprocess(FrameDef* frame_def);
   void VRUpdateForEyeRender(FrameDef* frame_def);
@@ -288,6 +354,50 @@ class Renderer {
   bool debug_draw_mode_{};
   int frames_rendered_count_{};
 
+  // Dynamic-resolution state; the current scale multiplies the
+  // user-requested pixel-scale (see UpdateDynamicResolution()).
+  bool dynamic_res_enabled_{};
+  float dynamic_res_scale_{1.0f};
+  float dynamic_res_gpu_avg_ms_{};
+  millisecs_t dynamic_res_last_change_time_{};
+
+  // Auto-quality calibration state (see StartAutoQualityCalibration()).
+  bool auto_quality_calibrating_{};
+  int auto_quality_gpu_key_{};
+  int auto_quality_warmup_frames_left_{};
+  int auto_quality_sample_count_{};
+  double auto_quality_sample_total_ms_{};
+
+  // Half-rate-world mode state; reuse is only safe while the camera
+  // buffer holds a fully-rendered world from a previous frame.
+  bool half_rate_world_mode_{};
+  bool world_buffer_valid_{};
+  bool world_buffer_reuse_this_frame_{};
+
+  // Snapshot of the overlay-flat pass's last-rendered commands; when a
+  // frame's UI matches it, the target already holds the right pixels and
+  // the re-render gets skipped.
+  bool overlay_flat_cache_valid_{};
+  RenderCommandBuffer::ContentSnapshot overlay_flat_cache_opaque_;
+  RenderCommandBuffer::ContentSnapshot overlay_flat_cache_transparent_;
+
+  // Mesh buffer states for this frame and the previous one (see
+  // CollectMeshBufferStates).
+  std::unordered_map<MeshData*, uint32_t> mesh_buffer_states_now_;
+  std::unordered_map<MeshData*, uint32_t> mesh_buffer_states_prev_;
+
+  // Snapshot of the last-rendered light/shadow pass commands plus the
+  // projection params baked into that result; while all of it matches,
+  // the light buffers already hold the right pixels and re-rendering
+  // them gets skipped.
+  bool light_shadow_cache_valid_{};
+  RenderCommandBuffer::ContentSnapshot light_cache_commands_;
+  RenderCommandBuffer::ContentSnapshot light_shadow_cache_commands_;
+  Vector3f light_shadow_cache_offset_{0.0f, 0.0f, 0.0f};
+  float light_shadow_cache_scale_x_{};
+  float light_shadow_cache_scale_z_{};
+  bool light_shadow_cache_ortho_{};
+
   // The *actual* current quality (set based on the
   // currently-rendering frame_def)
   GraphicsQuality last_render_quality_{GraphicsQuality::kLow};
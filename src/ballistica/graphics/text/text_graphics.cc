@@ -5,7 +5,9 @@
 #include <cstdio>
 #include <utility>
 
+#include "ballistica/app/app.h"
 #include "ballistica/ballistica.h"
+#include "ballistica/game/game.h"
 #include "ballistica/generic/utils.h"
 #include "ballistica/graphics/text/font_page_map_data.h"
 #include "ballistica/platform/platform.h"
@@ -30,6 +32,16 @@ void TextGraphics::Init() {
 }
 
 TextGraphics::TextGraphics() {
+  // Our text caches rebuild on demand so they're only worth dropping
+  // when things get dire.
+  App::AddMemoryPressureCallback(
+      MemoryPressureLevel::kCritical, [](MemoryPressureLevel level) {
+        if (g_game == nullptr) {
+          return;
+        }
+        g_game->PushCall([] { g_text_graphics->TrimCaches(); });
+      });
+
   // Init glyph values for our custom font pages
   // (just a 5x5 array currently).
   for (int page = 0; page < 4; page++) {
@@ -1044,6 +1056,47 @@ void TextGraphics::GetOSTextSpanBoundsAndWidth(const std::string& s, Rect* r,
   }
 }
 
+auto TextGraphics::GetCachedShapedText(const std::string& key)
+    -> ShapedTextCacheEntry* {
+  assert(InGameThread());
+  auto i = shaped_text_cache_map_.find(key);
+  if (i == shaped_text_cache_map_.end()) {
+    return nullptr;
+  }
+  Object::Ref<ShapedTextCacheEntry> entry = i->second;
+
+  // Send this entry to the back of the list since we used it.
+  shaped_text_cache_.erase(entry->list_iterator_);
+  entry->list_iterator_ =
+      shaped_text_cache_.insert(shaped_text_cache_.end(), entry);
+  return entry.get();
+}
+
+void TextGraphics::CacheShapedText(
+    const std::string& key, const Object::Ref<ShapedTextCacheEntry>& entry) {
+  assert(InGameThread());
+  assert(entry.exists());
+  assert(shaped_text_cache_map_.find(key) == shaped_text_cache_map_.end());
+  entry->list_iterator_ =
+      shaped_text_cache_.insert(shaped_text_cache_.end(), entry);
+  entry->map_iterator_ =
+      shaped_text_cache_map_.insert(std::make_pair(key, entry)).first;
+
+  // Keep cache from growing too large.
+  while (shaped_text_cache_.size() > 300) {
+    shaped_text_cache_map_.erase(shaped_text_cache_.front()->map_iterator_);
+    shaped_text_cache_.pop_front();
+  }
+}
+
+void TextGraphics::TrimCaches() {
+  assert(InGameThread());
+  shaped_text_cache_map_.clear();
+  shaped_text_cache_.clear();
+  text_span_bounds_cache_map_.clear();
+  text_span_bounds_cache_.clear();
+}
+
 auto TextGraphics::GetStringWidth(const char* text, bool big) -> float {
   assert(Utils::IsValidUTF8(text));
 
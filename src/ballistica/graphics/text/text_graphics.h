@@ -46,6 +46,30 @@ class TextGraphics {
     float tex_max_y;
   };
 
+  // Shaped mesh data for a single (string, style) combo, cached so that
+  // repeated strings (scores, player names, etc) can skip glyph layout and
+  // mesh fill entirely (see TextMesh::SetText).
+  class ShapedTextCacheEntry : public Object {
+   public:
+    std::vector<VertexDualTextureFull> vertices;
+    std::vector<uint16_t> indices;
+    std::unordered_map<std::string, Object::Ref<ShapedTextCacheEntry>>::iterator
+        map_iterator_;
+    std::list<Object::Ref<ShapedTextCacheEntry>>::iterator list_iterator_;
+  };
+
+  // Returns cached shaped mesh data for a key or nullptr if uncached.
+  // The returned pointer is only valid until the next cache call.
+  auto GetCachedShapedText(const std::string& key) -> ShapedTextCacheEntry*;
+
+  // Adds shaped mesh data to the cache (pruning old entries as needed).
+  void CacheShapedText(const std::string& key,
+                       const Object::Ref<ShapedTextCacheEntry>& entry);
+
+  // Drops the shaped-text and text-span-bounds caches (everything in
+  // them rebuilds on demand); used under memory pressure.
+  void TrimCaches();
+
   static auto GetBigCharIndex(int c) -> int;
 
   // Returns a glyph or nullptr if it is unavailable.
@@ -101,6 +125,11 @@ class TextGraphics {
 
   // List of entries for sorting by last-use-time
   std::list<Object::Ref<TextSpanBoundsCacheEntry> > text_span_bounds_cache_;
+
+  // Shaped-text cache (same map + last-use-list setup as above).
+  std::unordered_map<std::string, Object::Ref<ShapedTextCacheEntry> >
+      shaped_text_cache_map_;
+  std::list<Object::Ref<ShapedTextCacheEntry> > shaped_text_cache_;
   std::mutex glyph_load_mutex_;
   Glyph glyphs_extras_[100]{};
   Glyph glyphs_big_[64]{};
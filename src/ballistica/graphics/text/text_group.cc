@@ -16,11 +16,23 @@ namespace ballistica {
 void TextGroup::SetText(const std::string& text, TextMesh::HAlign alignment_h,
                         TextMesh::VAlign alignment_v, bool big,
                         float resolution_scale) {
-  text_ = text;
-
   // In order to *actually* draw big, all our letters
   // must be available in the big font.
-  big_ = (big && TextGraphics::HaveBigChars(text));
+  bool big_use = (big && TextGraphics::HaveBigChars(text));
+
+  // Widgets and nodes tend to re-push their text on any state change;
+  // if nothing affecting our meshes has changed we can keep what we have.
+  if (have_built_ && text == text_ && big_use == big_
+      && alignment_h == alignment_h_ && alignment_v == alignment_v_
+      && resolution_scale == resolution_scale_) {
+    return;
+  }
+  text_ = text;
+  big_ = big_use;
+  alignment_h_ = alignment_h;
+  alignment_v_ = alignment_v;
+  resolution_scale_ = resolution_scale;
+  have_built_ = true;
 
   // If we had an OS texture for custom drawing, release it.
   // (it should stick around for a while; we'll be able to re-grab
@@ -78,6 +78,13 @@ class TextGroup : public Object {
   std::vector<std::unique_ptr<TextMeshEntry>> entries_;
   std::string text_;
   bool big_;
+
+  // Args from our last SetText() call so we can skip redundant rebuilds.
+  // (widgets and nodes tend to re-push text on any state change)
+  TextMesh::HAlign alignment_h_{TextMesh::HAlign::kLeft};
+  TextMesh::VAlign alignment_v_{TextMesh::VAlign::kNone};
+  float resolution_scale_{};
+  bool have_built_{};
 };
 
 }  // namespace ballistica
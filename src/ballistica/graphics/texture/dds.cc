@@ -5,6 +5,7 @@
 #include <algorithm>
 
 #include "ballistica/ballistica.h"
+#include "ballistica/media/media.h"
 #include "ballistica/platform/platform.h"
 
 #if BA_ENABLE_OPENGL
@@ -42,7 +43,7 @@ void LoadDDS(const std::string& file_name, unsigned char** buffers, int* widths,
              TextureQuality texture_quality, int min_quality, int* base_level) {
   (*base_level) = 0;
 
-  FILE* f = g_platform->FOpen(file_name.c_str(), "rb");
+  FILE* f = Media::FOpenMediaFile(file_name);
   if (!f) throw Exception("can't open file: \"" + file_name + "\"");
 
   DDS_header hdr{};
@@ -2,6 +2,7 @@
 
 #include "ballistica/graphics/texture/ktx.h"
 
+#include "ballistica/media/media.h"
 #include "ballistica/platform/platform.h"
 
 #if !BA_HEADLESS_BUILD
@@ -71,7 +72,7 @@ typedef struct KTX_header_t {
 void LoadKTX(const std::string& file_name, unsigned char** buffers, int* widths,
              int* heights, TextureFormat* formats, size_t* sizes,
              TextureQuality texture_quality, int min_quality, int* base_level) {
-  FILE* f = g_platform->FOpen(file_name.c_str(), "rb");
+  FILE* f = Media::FOpenMediaFile(file_name);
   if (!f) throw Exception("can't open file: \"" + file_name + "\"");
 
   KTX_header_t header{};
@@ -7,6 +7,7 @@
 #include <cstdio>
 
 #include "ballistica/ballistica.h"
+#include "ballistica/media/media.h"
 #include "ballistica/platform/platform.h"
 
 namespace ballistica {
@@ -51,7 +52,7 @@ void LoadPVR(const std::string& file_name, unsigned char** buffers, int* widths,
              TextureQuality texture_quality, int min_quality, int* base_level) {
   (*base_level) = 0;
 
-  FILE* f = g_platform->FOpen(file_name.c_str(), "rb");
+  FILE* f = Media::FOpenMediaFile(file_name);
   if (!f) throw Exception("can't open file: \"" + file_name + "\"");
 
   TextureFormat internal_format;
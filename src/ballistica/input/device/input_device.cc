@@ -172,6 +172,10 @@ void InputDevice::AttachToRemotePlayer(ConnectionToHost* connection_to_host,
   }
   remote_player_ = connection_to_host;
   remote_player_id_ = remote_player_id;
+
+  // Make sure the first analog values we queue for this player go out
+  // regardless of what we last sent for a previous one.
+  last_remote_up_down_ = last_remote_left_right_ = last_remote_run_ = -999.0f;
 }
 
 void InputDevice::RemoveRemotePlayerFromGame() {
@@ -280,6 +284,30 @@ void InputDevice::InputCommand(InputType type, float value) {
   if (Player* p = player_.get()) {
     p->InputCommand(type, value);
   } else if (remote_player_.exists()) {
+    // Repeated analog values are common (sticks pegged at their limits,
+    // d-pads mapped to axes) and are redundant on the wire; drop them
+    // here before they take up buffer space.
+    float* last_value{};
+    switch (type) {
+      case InputType::kUpDown:
+        last_value = &last_remote_up_down_;
+        break;
+      case InputType::kLeftRight:
+        last_value = &last_remote_left_right_;
+        break;
+      case InputType::kRun:
+        last_value = &last_remote_run_;
+        break;
+      default:
+        break;
+    }
+    if (last_value) {
+      if (*last_value == value) {
+        return;
+      }
+      *last_value = value;
+    }
+
     // Add to existing buffer of input-commands.
     {
       size_t size = remote_input_commands_buffer_.size();
@@ -68,6 +68,12 @@ class InputDevice : public Object {
   /// Return the overall device index; unique to all devices.
   auto index() const -> int { return index_; }
 
+  /// Ask the physical device to rumble, if supported. Intensities range
+  /// from 0 to 1; duration is in milliseconds. Safe to call from any
+  /// thread; default implementation does nothing.
+  virtual void SetRumble(float low_intensity, float high_intensity,
+                         millisecs_t duration) {}
+
   /// Read new control values from config.
   virtual void UpdateMapping() {}
 
@@ -159,6 +165,12 @@ class InputDevice : public Object {
   millisecs_t last_remote_input_commands_send_time_ = 0;
   std::vector<uint8_t> remote_input_commands_buffer_;
 
+  // Last analog values queued for a remote player; used to drop repeats
+  // before they hit the wire (see InputCommand).
+  float last_remote_up_down_ = -999.0f;
+  float last_remote_left_right_ = -999.0f;
+  float last_remote_run_ = -999.0f;
+
   // note: this is in base-net-time
   millisecs_t last_input_time_ = 0;
 
@@ -57,9 +57,10 @@ Joystick::Joystick(int sdl_joystick_id, const std::string& custom_device_name,
   // Non-negative values here mean its an SDL joystick.
   if (sdl_joystick_id != -1) {
 #if BA_ENABLE_SDL_JOYSTICKS
-    // Standard SDL joysticks should be getting created in the main thread.
+    // Standard SDL joysticks get opened in the media worker thread on
+    // hot-plug (opening can block for a while on some bluetooth pads).
     // Custom joysticks can come from anywhere.
-    assert(InMainThread());
+    assert(InMainThread() || InMediaThread());
 
     sdl_joystick_ = SDL_JoystickOpen(sdl_joystick_id);
     assert(sdl_joystick_);
@@ -398,6 +399,39 @@ auto Joystick::GetCalibratedValue(float raw, float neutral) const -> int32_t {
   return val;
 }
 
+void Joystick::SetRumble(float low_intensity, float high_intensity,
+                         millisecs_t duration) {
+  // Clamp and pack everything into our single atomic command slot; bit
+  // 63 marks the slot occupied so a stop command (all zeros) is
+  // distinguishable from an empty slot.
+  auto low = static_cast<uint64_t>(
+      std::min(1.0f, std::max(0.0f, low_intensity)) * 65535.0f);
+  auto high = static_cast<uint64_t>(
+      std::min(1.0f, std::max(0.0f, high_intensity)) * 65535.0f);
+  auto dur = static_cast<uint64_t>(
+      std::min(static_cast<millisecs_t>(0xFFFFFFFF),
+               std::max(millisecs_t{0}, duration)));
+  pending_rumble_.store((1ull << 63u) | (dur << 32u) | (high << 16u) | low,
+                        std::memory_order_release);
+}
+
+void Joystick::ApplyPendingRumble() {
+  assert(InMainThread());
+  uint64_t cmd = pending_rumble_.exchange(0, std::memory_order_acquire);
+  if (cmd == 0) {
+    return;
+  }
+#if BA_SDL2_BUILD
+#if SDL_VERSION_ATLEAST(2, 0, 9)
+  if (sdl_joystick_) {
+    SDL_JoystickRumble(sdl_joystick_, static_cast<uint16_t>(cmd & 0xFFFFu),
+                       static_cast<uint16_t>((cmd >> 16u) & 0xFFFFu),
+                       static_cast<uint32_t>(cmd >> 32u));
+  }
+#endif
+#endif  // BA_SDL2_BUILD
+}
+
 void Joystick::Update() {
   InputDevice::Update();
 
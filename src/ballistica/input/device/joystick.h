@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_INPUT_DEVICE_JOYSTICK_H_
 #define BALLISTICA_INPUT_DEVICE_JOYSTICK_H_
 
+#include <atomic>
 #include <set>
 #include <string>
 
@@ -35,6 +36,17 @@ class Joystick : public InputDevice {
   void Update() override;
   void ResetHeldStates() override;
 
+  // Queue a rumble command for the physical device. This just stores
+  // the command in a lock-free slot (newer commands replace ones that
+  // haven't gone out yet); the main thread issues it to the hardware on
+  // its next event pump since SDL requires joystick access from there.
+  void SetRumble(float low_intensity, float high_intensity,
+                 millisecs_t duration) override;
+
+  // Issue any queued rumble command to the hardware.
+  // Called regularly by the main thread.
+  void ApplyPendingRumble();
+
   auto sdl_joystick_id() const -> int { return sdl_joystick_id_; }
   auto sdl_joystick() const -> SDL_Joystick* { return sdl_joystick_; }
 
@@ -110,6 +122,10 @@ class Joystick : public InputDevice {
   //  constructor)
   SDL_Joystick* sdl_joystick_{};
 
+  // Pending rumble command; bit 63 marks the slot occupied, the rest is
+  // packed low/high intensity and duration (see SetRumble).
+  std::atomic<uint64_t> pending_rumble_{};
+
   bool is_test_input_{};
   bool is_remote_control_{};
   bool is_remote_app_{};
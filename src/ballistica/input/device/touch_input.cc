@@ -350,8 +350,35 @@ void TouchInput::UpdateDPad() {
   CircleToBoxCoords(&x, &y);
 
   float remap = 1.0f;
-  InputCommand(InputType::kLeftRight, x * remap);
-  InputCommand(InputType::kUpDown, y * remap);
+
+  // Don't ship these downstream here; touch events arrive at whatever
+  // rate the digitizer feels like and each movement command fans out
+  // into node-attr sets. We just note the latest values and ship one
+  // resampled pair per update tick (see Update).
+  pending_move_x_ = x * remap;
+  pending_move_y_ = y * remap;
+  have_pending_move_ = true;
+}
+
+void TouchInput::Update() {
+  InputDevice::Update();
+
+  // Ship at most one movement command pair per tick, with a light
+  // low-pass to take the jitter out of diagonal swipes. Touch releases
+  // snap immediately (see HandleTouchUp) so this only eases in-flight
+  // direction changes by a tick or two.
+  if (have_pending_move_) {
+    smoothed_move_x_ += 0.6f * (pending_move_x_ - smoothed_move_x_);
+    smoothed_move_y_ += 0.6f * (pending_move_y_ - smoothed_move_y_);
+    if (std::abs(pending_move_x_ - smoothed_move_x_) < 0.005f
+        && std::abs(pending_move_y_ - smoothed_move_y_) < 0.005f) {
+      smoothed_move_x_ = pending_move_x_;
+      smoothed_move_y_ = pending_move_y_;
+      have_pending_move_ = false;
+    }
+    InputCommand(InputType::kLeftRight, smoothed_move_x_);
+    InputCommand(InputType::kUpDown, smoothed_move_y_);
+  }
 }
 
 void TouchInput::Draw(FrameDef* frame_def) {
@@ -1026,6 +1053,14 @@ auto TouchInput::HandleTouchUp(void* touch, float x, float y) -> bool {
     d_pad_y_ = d_pad_base_y_;
     d_pad_touch_ = nullptr;
     UpdateDPad();
+
+    // Ship the stop right now; movement is normally resampled at tick
+    // boundaries but releases need to feel instant.
+    smoothed_move_x_ = pending_move_x_;
+    smoothed_move_y_ = pending_move_y_;
+    have_pending_move_ = false;
+    InputCommand(InputType::kLeftRight, smoothed_move_x_);
+    InputCommand(InputType::kUpDown, smoothed_move_y_);
   }
   return true;
 }
@@ -25,6 +25,7 @@ class TouchInput : public InputDevice {
   auto editing() const -> bool { return editing_; }
   auto IsTouchScreen() -> bool override { return true; }
   void UpdateMapping() override;
+  void Update() override;
   enum class MovementControlType { kJoystick, kSwipe };
   enum class ActionControlType { kButtons, kSwipe };
 
@@ -54,6 +55,15 @@ class TouchInput : public InputDevice {
   float d_pad_x_{};
   float d_pad_y_{};
 
+  // Movement values pending delivery; raw touch events just update
+  // these and we ship one (lightly smoothed) movement command pair per
+  // update tick instead of a pair per event (see UpdateDPad/Update).
+  bool have_pending_move_{};
+  float pending_move_x_{};
+  float pending_move_y_{};
+  float smoothed_move_x_{};
+  float smoothed_move_y_{};
+
   // Button coordinates are provided in virtual screen space.
   float buttons_default_frac_x_{};
   float buttons_default_frac_y_{};
@@ -13,6 +13,7 @@
 #include "ballistica/input/device/keyboard_input.h"
 #include "ballistica/input/device/test_input.h"
 #include "ballistica/input/device/touch_input.h"
+#include "ballistica/input/input_latency_meter.h"
 #include "ballistica/python/python.h"
 #include "ballistica/ui/console.h"
 #include "ballistica/ui/root_ui.h"
@@ -1097,9 +1098,35 @@ void Input::PushTextInputEvent(const std::string& text) {
 
 auto Input::PushJoystickEvent(const SDL_Event& event, InputDevice* input_device)
     -> void {
-  g_game->PushCall([this, event, input_device] {
-    HandleJoystickEvent(event, input_device);
-  });
+  InputLatencyMeter::OnInputEvent();
+
+  // Joysticks can generate large bursts of events (high-polling-rate
+  // controllers especially), so instead of a game-thread call per event
+  // we accumulate them and push a single flush call per burst. Only the
+  // first event landing in an empty buffer needs to wake the game thread.
+  bool need_flush_call;
+  {
+    std::lock_guard<std::mutex> lock(pending_joystick_events_mutex_);
+    need_flush_call = pending_joystick_events_.empty();
+    pending_joystick_events_.push_back({event, input_device, GetRealTime()});
+  }
+  if (need_flush_call) {
+    g_game->PushCall([this] { FlushJoystickEvents(); });
+  }
+}
+
+auto Input::FlushJoystickEvents() -> void {
+  assert(InGameThread());
+  assert(flushing_joystick_events_.empty());
+  {
+    std::lock_guard<std::mutex> lock(pending_joystick_events_mutex_);
+    pending_joystick_events_.swap(flushing_joystick_events_);
+  }
+  for (auto&& e : flushing_joystick_events_) {
+    last_joystick_event_latency_ = GetRealTime() - e.queue_time;
+    HandleJoystickEvent(e.event, e.device);
+  }
+  flushing_joystick_events_.clear();
 }
 
 void Input::HandleJoystickEvent(const SDL_Event& event,
@@ -1129,10 +1156,12 @@ void Input::HandleJoystickEvent(const SDL_Event& event,
 }
 
 void Input::PushKeyPressEvent(const SDL_Keysym& keysym) {
+  InputLatencyMeter::OnInputEvent();
   g_game->PushCall([this, keysym] { HandleKeyPress(&keysym); });
 }
 
 void Input::PushKeyReleaseEvent(const SDL_Keysym& keysym) {
+  InputLatencyMeter::OnInputEvent();
   g_game->PushCall([this, keysym] { HandleKeyRelease(&keysym); });
 }
 
@@ -1492,6 +1521,7 @@ auto Input::HandleMouseMotion(const Vector2f& position) -> void {
 }
 
 auto Input::PushMouseDownEvent(int button, const Vector2f& position) -> void {
+  InputLatencyMeter::OnInputEvent();
   g_game->PushCall(
       [this, button, position] { HandleMouseDown(button, position); });
 }
@@ -1569,6 +1599,7 @@ auto Input::HandleMouseDown(int button, const Vector2f& position) -> void {
 }
 
 auto Input::PushMouseUpEvent(int button, const Vector2f& position) -> void {
+  InputLatencyMeter::OnInputEvent();
   g_game->PushCall(
       [this, button, position] { HandleMouseUp(button, position); });
 }
@@ -1618,6 +1649,7 @@ auto Input::HandleMouseUp(int button, const Vector2f& position) -> void {
 }
 
 void Input::PushTouchEvent(const TouchEvent& e) {
+  InputLatencyMeter::OnInputEvent();
   g_game->PushCall([e, this] { HandleTouchEvent(e); });
 }
 
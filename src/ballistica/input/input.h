@@ -4,12 +4,14 @@
 #define BALLISTICA_INPUT_INPUT_H_
 
 #include <list>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "ballistica/core/object.h"
+#include "ballistica/platform/min_sdl.h"
 
 namespace ballistica {
 
@@ -120,6 +122,12 @@ class Input {
   auto PushMouseScrollEvent(const Vector2f& amount) -> void;
   auto PushJoystickEvent(const SDL_Event& event, InputDevice* input_device)
       -> void;
+
+  // Delay between a joystick event getting queued on its source thread
+  // and the game thread handling it, as of the last flushed batch.
+  auto last_joystick_event_latency() const -> millisecs_t {
+    return last_joystick_event_latency_;
+  }
   auto PushAddInputDeviceCall(InputDevice* input_device, bool standard_message)
       -> void;
   auto PushRemoveInputDeviceCall(InputDevice* input_device,
@@ -144,6 +152,7 @@ class Input {
   auto HandleSmoothMouseScroll(const Vector2f& velocity, bool momentum) -> void;
   auto HandleJoystickEvent(const SDL_Event& event, InputDevice* input_device)
       -> void;
+  auto FlushJoystickEvents() -> void;
   auto HandleTouchEvent(const TouchEvent& e) -> void;
   auto ShowStandardInputDeviceConnectedMessage(InputDevice* j) -> void;
   auto ShowStandardInputDeviceDisconnectedMessage(InputDevice* j) -> void;
@@ -190,6 +199,19 @@ class Input {
   millisecs_t stress_test_time_{};
   millisecs_t stress_test_last_leave_time_{};
   void* single_touch_{};
+
+  // High-polling-rate controllers can generate hundreds of events per
+  // frame; they get batched here (with queue timestamps) and drained by
+  // a single game-thread call per batch instead of a call per event.
+  struct PendingJoystickEvent {
+    SDL_Event event;
+    InputDevice* device;
+    millisecs_t queue_time;
+  };
+  std::mutex pending_joystick_events_mutex_;
+  std::vector<PendingJoystickEvent> pending_joystick_events_;
+  std::vector<PendingJoystickEvent> flushing_joystick_events_;
+  millisecs_t last_joystick_event_latency_{};
 };
 
 }  // namespace ballistica
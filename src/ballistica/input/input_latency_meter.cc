@@ -0,0 +1,139 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/input/input_latency_meter.h"
+
+#include "ballistica/game/game.h"
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+
+std::atomic<bool> InputLatencyMeter::enabled_{false};
+std::atomic<int64_t> InputLatencyMeter::pending_arrival_{-1};
+int64_t InputLatencyMeter::latched_arrival_{-1};
+std::atomic<int64_t> InputLatencyMeter::buckets_[kBucketCount]{};
+std::atomic<int64_t> InputLatencyMeter::sample_count_{0};
+std::atomic<int64_t> InputLatencyMeter::total_usecs_{0};
+std::atomic<int64_t> InputLatencyMeter::min_usecs_{0};
+std::atomic<int64_t> InputLatencyMeter::max_usecs_{0};
+
+void InputLatencyMeter::set_enabled(bool val) {
+  // Start each tracking run from a clean slate.
+  if (val && !enabled()) {
+    Reset();
+  }
+  enabled_.store(val, std::memory_order_relaxed);
+}
+
+void InputLatencyMeter::OnInputEvent() {
+  if (!enabled()) {
+    return;
+  }
+  // Only claim the slot if it's empty; an older unconsumed arrival
+  // bounds latency better than a newer one.
+  int64_t expected = -1;
+  pending_arrival_.compare_exchange_strong(
+      expected, Platform::GetCurrentMicroseconds(), std::memory_order_relaxed);
+}
+
+void InputLatencyMeter::LatchPendingInput() {
+  assert(InGameThread());
+  if (!enabled()) {
+    return;
+  }
+  int64_t pending = pending_arrival_.exchange(-1, std::memory_order_relaxed);
+  if (pending >= 0 && (latched_arrival_ < 0 || pending < latched_arrival_)) {
+    latched_arrival_ = pending;
+  }
+}
+
+auto InputLatencyMeter::TakeLatchedInputTime() -> int64_t {
+  assert(InGameThread());
+  int64_t val = latched_arrival_;
+  latched_arrival_ = -1;
+  return val;
+}
+
+void InputLatencyMeter::OnFramePresented(int64_t input_arrival_time_usecs) {
+  if (!enabled() || input_arrival_time_usecs < 0) {
+    return;
+  }
+  int64_t latency =
+      Platform::GetCurrentMicroseconds() - input_arrival_time_usecs;
+  if (latency < 0) {
+    latency = 0;
+  }
+  auto bucket = static_cast<int>(latency / kBucketWidthUsecs);
+  if (bucket >= kBucketCount) {
+    bucket = kBucketCount - 1;
+  }
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  sample_count_.fetch_add(1, std::memory_order_relaxed);
+  total_usecs_.fetch_add(latency, std::memory_order_relaxed);
+
+  // These races are harmless; only the graphics thread writes samples.
+  int64_t prev_min = min_usecs_.load(std::memory_order_relaxed);
+  if (prev_min == 0 || latency < prev_min) {
+    min_usecs_.store(latency, std::memory_order_relaxed);
+  }
+  if (latency > max_usecs_.load(std::memory_order_relaxed)) {
+    max_usecs_.store(latency, std::memory_order_relaxed);
+  }
+}
+
+auto InputLatencyMeter::SampleCount() -> int64_t {
+  return sample_count_.load(std::memory_order_relaxed);
+}
+
+auto InputLatencyMeter::AverageUsecs() -> int64_t {
+  int64_t count = SampleCount();
+  return count > 0 ? total_usecs_.load(std::memory_order_relaxed) / count : 0;
+}
+
+auto InputLatencyMeter::PercentileUsecs(float percentile) -> int64_t {
+  int64_t count = SampleCount();
+  if (count <= 0) {
+    return 0;
+  }
+  auto target = static_cast<int64_t>(
+      static_cast<double>(count) * static_cast<double>(percentile) * 0.01);
+  if (target >= count) {
+    target = count - 1;
+  }
+  int64_t seen = 0;
+  for (int i = 0; i < kBucketCount; i++) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen > target) {
+      // Report the top edge of the bucket; good enough at 4ms grain.
+      return (i + 1) * kBucketWidthUsecs;
+    }
+  }
+  return kBucketCount * kBucketWidthUsecs;
+}
+
+void InputLatencyMeter::GetBuckets(int64_t* out) {
+  for (int i = 0; i < kBucketCount; i++) {
+    out[i] = buckets_[i].load(std::memory_order_relaxed);
+  }
+}
+
+auto InputLatencyMeter::MinUsecs() -> int64_t {
+  return min_usecs_.load(std::memory_order_relaxed);
+}
+
+auto InputLatencyMeter::MaxUsecs() -> int64_t {
+  return max_usecs_.load(std::memory_order_relaxed);
+}
+
+void InputLatencyMeter::Reset() {
+  pending_arrival_.store(-1, std::memory_order_relaxed);
+  latched_arrival_ = -1;
+  for (auto& bucket : buckets_) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  sample_count_.store(0, std::memory_order_relaxed);
+  total_usecs_.store(0, std::memory_order_relaxed);
+  min_usecs_.store(0, std::memory_order_relaxed);
+  max_usecs_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace ballistica
@@ -0,0 +1,86 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_INPUT_INPUT_LATENCY_METER_H_
+#define BALLISTICA_INPUT_INPUT_LATENCY_METER_H_
+
+#include <atomic>
+#include <string>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+/// Measures end-to-end input-to-photon latency: from a raw input event
+/// arriving on the main thread, through the game tick that consumes it,
+/// into the frame-def built from that tick, and out the far side once
+/// the render for that frame-def (including swap) completes.
+///
+/// Flow: event push paths call OnInputEvent() (any thread); the game
+/// thread latches pending arrivals at the top of each update so events
+/// landing mid-tick wait for the next one; BuildAndPushFrameDef() stamps
+/// the latched arrival onto the frame-def it builds; and the graphics
+/// thread feeds the stamp back via OnFramePresented() after the swap.
+/// Only the first event per tick is tracked (it bounds the worst case)
+/// and everything is gated on enabled() so it costs nothing when off.
+class InputLatencyMeter {
+ public:
+  // Histogram covers 0..256ms in 4ms buckets; the last bucket absorbs
+  // anything slower.
+  static const int kBucketCount = 64;
+  static const int64_t kBucketWidthUsecs = 4000;
+
+  static auto enabled() -> bool {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+  static void set_enabled(bool val);
+
+  /// Call when a raw input event arrives (any thread). Only the oldest
+  /// unconsumed arrival is kept.
+  static void OnInputEvent();
+
+  /// Move pending arrivals into the latched slot; call from the game
+  /// thread at the top of each update.
+  static void LatchPendingInput();
+
+  /// Take (and clear) the latched arrival time for stamping onto a
+  /// frame-def; returns -1 if no input landed since the last take.
+  /// Game thread only.
+  static auto TakeLatchedInputTime() -> int64_t;
+
+  /// Feed a completed frame's input stamp back in once its swap is done
+  /// (graphics thread).
+  static void OnFramePresented(int64_t input_arrival_time_usecs);
+
+  /// Total samples recorded since enable/reset.
+  static auto SampleCount() -> int64_t;
+
+  /// Average latency in microseconds (0 if no samples).
+  static auto AverageUsecs() -> int64_t;
+
+  /// Latency at a given percentile (0-100), in microseconds, estimated
+  /// from the histogram (0 if no samples).
+  static auto PercentileUsecs(float percentile) -> int64_t;
+
+  /// Copy raw bucket counts into out (must hold kBucketCount entries).
+  static void GetBuckets(int64_t* out);
+
+  /// Min/max observed latencies in microseconds (0 if no samples).
+  static auto MinUsecs() -> int64_t;
+  static auto MaxUsecs() -> int64_t;
+
+  static void Reset();
+
+ private:
+  static std::atomic<bool> enabled_;
+  static std::atomic<int64_t> pending_arrival_;
+  static int64_t latched_arrival_;
+  static std::atomic<int64_t> buckets_[kBucketCount];
+  static std::atomic<int64_t> sample_count_;
+  static std::atomic<int64_t> total_usecs_;
+  static std::atomic<int64_t> min_usecs_;
+  static std::atomic<int64_t> max_usecs_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_INPUT_INPUT_LATENCY_METER_H_
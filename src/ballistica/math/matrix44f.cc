@@ -103,6 +103,47 @@ auto Matrix44fFrustum(float left, float right, float bottom, float top,
   return Matrix44f(m_persp);
 }
 
+auto Matrix44f::TransformPoints(const Vector3f* in_points,
+                                Vector3f* out_points, size_t count) const
+    -> void {
+  // One matrix across many points; hoist the columns out of the loop
+  // and run the same column-combine as the single-point operator.
+#if defined(__SSE2__)
+  __m128 c0 = _mm_loadu_ps(m + 0);
+  __m128 c1 = _mm_loadu_ps(m + 4);
+  __m128 c2 = _mm_loadu_ps(m + 8);
+  __m128 c3 = _mm_loadu_ps(m + 12);
+  for (size_t i = 0; i < count; i++) {
+    __m128 t = _mm_mul_ps(_mm_set1_ps(in_points[i].x), c0);
+    t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(in_points[i].y), c1));
+    t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(in_points[i].z), c2));
+    t = _mm_add_ps(t, c3);
+    float prod[4];
+    _mm_storeu_ps(prod, t);
+    float div = 1.0f / prod[3];
+    out_points[i] = {prod[0] * div, prod[1] * div, prod[2] * div};
+  }
+#elif defined(__ARM_NEON)
+  float32x4_t c0 = vld1q_f32(m + 0);
+  float32x4_t c1 = vld1q_f32(m + 4);
+  float32x4_t c2 = vld1q_f32(m + 8);
+  float32x4_t c3 = vld1q_f32(m + 12);
+  for (size_t i = 0; i < count; i++) {
+    float32x4_t t = vmlaq_n_f32(c3, c0, in_points[i].x);
+    t = vmlaq_n_f32(t, c1, in_points[i].y);
+    t = vmlaq_n_f32(t, c2, in_points[i].z);
+    float prod[4];
+    vst1q_f32(prod, t);
+    float div = 1.0f / prod[3];
+    out_points[i] = {prod[0] * div, prod[1] * div, prod[2] * div};
+  }
+#else
+  for (size_t i = 0; i < count; i++) {
+    out_points[i] = (*this) * in_points[i];
+  }
+#endif
+}
+
 auto Matrix44f::Transpose() const -> Matrix44f {
   Matrix44f tmp;  // NOLINT: uninitialized on purpose.
   for (int i = 0; i < 4; i++) {
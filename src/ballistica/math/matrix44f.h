@@ -5,6 +5,12 @@
 
 #include <cstring>  // for memcpy
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 #include "ballistica/math/vector3f.h"
 
 namespace ballistica {
@@ -56,8 +62,37 @@ class Matrix44f {
 #pragma clang diagnostic pop
 
   // Matrix multiplication.
+  // Each product column is a combination of the other matrix's columns
+  // weighted by our own column entries, which maps straight onto 4-wide
+  // SIMD. Unaligned loads/stores since matrices also get read out of
+  // plain float buffers (see RenderCommandBuffer::GetMatrix()).
   auto operator*(const Matrix44f& other) const -> Matrix44f {
     Matrix44f prod;  // NOLINT: uninitialized on purpose.
+#if defined(__SSE2__)
+    __m128 oc0 = _mm_loadu_ps(other.m + 0);
+    __m128 oc1 = _mm_loadu_ps(other.m + 4);
+    __m128 oc2 = _mm_loadu_ps(other.m + 8);
+    __m128 oc3 = _mm_loadu_ps(other.m + 12);
+    for (int c = 0; c < 4; c++) {
+      __m128 t = _mm_mul_ps(_mm_set1_ps(m[c * 4 + 0]), oc0);
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(m[c * 4 + 1]), oc1));
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(m[c * 4 + 2]), oc2));
+      t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(m[c * 4 + 3]), oc3));
+      _mm_storeu_ps(prod.m + c * 4, t);
+    }
+#elif defined(__ARM_NEON)
+    float32x4_t oc0 = vld1q_f32(other.m + 0);
+    float32x4_t oc1 = vld1q_f32(other.m + 4);
+    float32x4_t oc2 = vld1q_f32(other.m + 8);
+    float32x4_t oc3 = vld1q_f32(other.m + 12);
+    for (int c = 0; c < 4; c++) {
+      float32x4_t t = vmulq_n_f32(oc0, m[c * 4 + 0]);
+      t = vmlaq_n_f32(t, oc1, m[c * 4 + 1]);
+      t = vmlaq_n_f32(t, oc2, m[c * 4 + 2]);
+      t = vmlaq_n_f32(t, oc3, m[c * 4 + 3]);
+      vst1q_f32(prod.m + c * 4, t);
+    }
+#else
     for (int c = 0; c < 4; c++) {
       for (int r = 0; r < 4; r++) {
         prod.set(c, r,
@@ -66,6 +101,7 @@ class Matrix44f {
                      + get(c, 3) * other.get(3, r));
       }
     }
+#endif
     return prod;
   }
 
@@ -109,6 +145,12 @@ class Matrix44f {
     return m2 * val;
   }
 
+  // Transform an array of points through this matrix; batched flavor of
+  // the vector-transform operator for code paths pushing many points
+  // through a single transform.
+  auto TransformPoints(const Vector3f* in_points, Vector3f* out_points,
+                       size_t count) const -> void;
+
   // Equality operator.
   auto operator==(const Matrix44f& other) const -> bool {
     return !memcmp(m, other.m, sizeof(m));
@@ -2,6 +2,7 @@
 
 #include "ballistica/math/random.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <memory>
@@ -541,4 +542,80 @@ void Random::GenList3D(float (*list)[3], int size) {
   }
 }
 
+
+// Counter-based per-thread uniform streams. Each value is a hash of
+// (stream key, counter), so there's no sequential state to contend
+// over and a stream replays exactly from any point; the straight-line
+// 4-wide fill loop below also auto-vectorizes nicely.
+
+const int kUniformBatchSize = 256;
+
+struct ThreadRandomState {
+  uint64_t key{};
+  uint64_t counter{};
+  int buffer_left{};
+  float buffer[kUniformBatchSize];
+};
+
+// splitmix64-style avalanche; full 64-bit mix folded to 32 bits.
+static inline auto MixToUint32(uint64_t z) -> uint32_t {
+  z = (z ^ (z >> 30u)) * 0xbf58476d1ce4e5b9u;
+  z = (z ^ (z >> 27u)) * 0x94d049bb133111ebu;
+  return static_cast<uint32_t>(z ^ (z >> 31u));
+}
+
+static inline auto UniformFromCounter(uint64_t key, uint64_t counter)
+    -> float {
+  uint32_t v = MixToUint32(key + counter * 0x9e3779b97f4a7c15u);
+  // Top 24 bits -> [0, 1); matches float mantissa width.
+  return static_cast<float>(v >> 8u) * (1.0f / 16777216.0f);
+}
+
+static auto GetThreadRandomState() -> ThreadRandomState* {
+  // Distinct default keys per thread, but not randomized across runs
+  // (the rand() this replaces was effectively fixed-seed too).
+  static std::atomic<uint64_t> next_stream_id{1};
+  thread_local ThreadRandomState* state = [] {
+    auto* s = new ThreadRandomState();
+    s->key = next_stream_id.fetch_add(1) * 0x9e3779b97f4a7c15u;
+    return s;
+  }();
+  return state;
+}
+
+void Random::FillUniform(float* dst, size_t n) {
+  ThreadRandomState* state = GetThreadRandomState();
+  uint64_t key = state->key;
+  uint64_t counter = state->counter;
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    dst[i] = UniformFromCounter(key, counter);
+    dst[i + 1] = UniformFromCounter(key, counter + 1);
+    dst[i + 2] = UniformFromCounter(key, counter + 2);
+    dst[i + 3] = UniformFromCounter(key, counter + 3);
+    counter += 4;
+  }
+  for (; i < n; i++) {
+    dst[i] = UniformFromCounter(key, counter++);
+  }
+  state->counter = counter;
+}
+
+auto Random::UniformFloat() -> float {
+  ThreadRandomState* state = GetThreadRandomState();
+  if (state->buffer_left == 0) {
+    FillUniform(state->buffer, kUniformBatchSize);
+    state->buffer_left = kUniformBatchSize;
+  }
+  return state->buffer[--state->buffer_left];
+}
+
+void Random::SeedThreadStream(uint64_t seed) {
+  ThreadRandomState* state = GetThreadRandomState();
+  state->key = seed * 0x9e3779b97f4a7c15u + 0x9e3779b97f4a7c15u;
+  state->counter = 0;
+  state->buffer_left = 0;
+}
+
+auto RandomFloat() -> float { return Random::UniformFloat(); }
 }  // namespace ballistica
@@ -3,6 +3,9 @@
 #ifndef BALLISTICA_MATH_RANDOM_H_
 #define BALLISTICA_MATH_RANDOM_H_
 
+#include <cstddef>
+#include <cstdint>
+
 namespace ballistica {
 
 class Random {
@@ -10,6 +13,22 @@ class Random {
   static void GenList1D(float* list, int size);
   static void GenList2D(float (*list)[2], int size);
   static void GenList3D(float (*list)[3], int size);
+
+  /// Fill dst with n uniform floats in [0, 1). Values come off a
+  /// counter-based per-thread stream: cheap enough for per-particle
+  /// use, safe from any thread, and value i of a stream is a pure
+  /// function of (seed, i) so sequences replay exactly no matter how
+  /// they get batched. Particle loops should grab blocks with this
+  /// rather than drawing one value at a time.
+  static void FillUniform(float* dst, size_t n);
+
+  /// A single value off the calling thread's stream (buffered in
+  /// batches internally; this is what RandomFloat() uses).
+  static auto UniformFloat() -> float;
+
+  /// Restart the calling thread's stream at a known point, for
+  /// deterministic replay or testing.
+  static void SeedThreadStream(uint64_t seed);
 };
 
 }  // namespace ballistica
@@ -18,7 +18,7 @@ CollideModelData::CollideModelData(const std::string& file_name_in)
 void CollideModelData::DoPreload() {
   assert(!file_name_.empty());
 
-  FILE* f = g_platform->FOpen(file_name_full_.c_str(), "rb");
+  FILE* f = Media::FOpenMediaFile(file_name_full_);
   uint32_t i_vals[2];
   if (!f) {
     throw Exception("Can't open collide model: '" + file_name_full_ + "'");
@@ -29,9 +29,18 @@ class CollideModelData : public MediaComponentData {
       return "invalid CollideModel";
     }
   }
+  auto GetApproxMemoryUse() const -> size_t override {
+    return vertices_.size() * sizeof(dReal) + indices_.size() * 4
+           + normals_.size() * sizeof(dReal);
+  }
   auto GetMeshData() -> dTriMeshDataID;
   auto GetBGMeshData() -> dTriMeshDataID;
 
+  // Raw triangle soup (xyz triples / index triples); used for baking
+  // things like the audio occlusion grid. Valid once preloaded.
+  auto vertices() const -> const std::vector<dReal>& { return vertices_; }
+  auto indices() const -> const std::vector<uint32_t>& { return indices_; }
+
  private:
   std::string file_name_;
   std::string file_name_full_;
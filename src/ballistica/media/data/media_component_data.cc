@@ -8,6 +8,11 @@ MediaComponentData::MediaComponentData() {
   assert(InGameThread());
   assert(g_media);
   last_used_time_ = GetRealTime();
+
+  // Our refs travel with pending-load lists through the media/graphics/
+  // audio threads, so count atomically; that way whichever thread ends
+  // up holding the last one can simply drop it.
+  EnableAtomicReferencing();
 }
 
 MediaComponentData::~MediaComponentData() {
@@ -54,6 +59,11 @@ void MediaComponentData::Load(bool already_locked) {
     load_end_time_ = GetRealTime();
     BA_DEBUG_FUNCTION_TIMER_END_THREAD_EX(50, GetName());
     loaded_ = true;
+#if BA_ALLOC_TRACKING
+    alloc_tracked_bytes_ = GetApproxMemoryUse();
+    AllocTracker::Add(AllocTracker::TagForMediaType(GetMediaType()),
+                      alloc_tracked_bytes_);
+#endif
   }
 }
 
@@ -77,6 +87,11 @@ void MediaComponentData::Unload(bool already_locked) {
     DoUnload();
     preloaded_ = false;
     loaded_ = false;
+#if BA_ALLOC_TRACKING
+    AllocTracker::Remove(AllocTracker::TagForMediaType(GetMediaType()),
+                         alloc_tracked_bytes_);
+    alloc_tracked_bytes_ = 0;
+#endif
   }
 }
 
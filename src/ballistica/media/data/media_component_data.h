@@ -6,6 +6,7 @@
 #include <mutex>
 #include <string>
 
+#include "ballistica/core/alloc_tracker.h"
 #include "ballistica/core/object.h"
 #include "ballistica/platform/platform.h"
 
@@ -65,6 +66,27 @@ class MediaComponentData : public Object {
   // Used by the renderer when adding component refs to frame_defs.
   auto last_frame_def_num() const -> int64_t { return last_frame_def_num_; }
   void set_last_frame_def_num(int64_t last) { last_frame_def_num_ = last; }
+  // Approximate number of bytes DoLoad() will hand off to the underlying
+  // api (gl, al, etc). Used to pace per-frame load batches so big
+  // late-loading components don't all hit the driver in one frame.
+  // 0 means no estimate is available.
+  virtual auto GetApproxLoadSize() const -> size_t { return 0; }
+
+  // Approximate bytes the component occupies while resident (cpu-side
+  // buffers plus whatever got handed to the underlying api). Used for
+  // byte-budgeted cache trimming. 0 means no estimate is available.
+  virtual auto GetApproxMemoryUse() const -> size_t { return 0; }
+
+  // Load-scheduling hints. Background components don't hold up the
+  // level-load progress bar (the pending-load counts skip them) and
+  // pending loads run highest-priority-first, so scripts can have
+  // spawn-area media block the load screen while far-off media streams
+  // in behind it.
+  auto load_priority() const -> float { return load_priority_; }
+  void set_load_priority(float val) { load_priority_ = val; }
+  auto loads_in_background() const -> bool { return loads_in_background_; }
+  void set_loads_in_background(bool val) { loads_in_background_ = val; }
+
   auto preload_time() const -> millisecs_t {
     return preload_end_time_ - preload_start_time_;
   }
@@ -125,8 +147,14 @@ class MediaComponentData : public Object {
   // we only include a single reference to ourself in it.
   int64_t last_frame_def_num_ = 0;
   millisecs_t last_used_time_ = 0;
+  float load_priority_{};
+  bool loads_in_background_{};
   bool preloaded_ = false;
   bool loaded_ = false;
+#if BA_ALLOC_TRACKING
+  // What we last reported to the alloc tracker; removal has to match.
+  size_t alloc_tracked_bytes_{};
+#endif
   std::mutex mutex_;
   BA_DISALLOW_CLASS_COPIES(MediaComponentData);
 };
@@ -2,6 +2,7 @@
 
 #include "ballistica/media/data/model_data.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -11,19 +12,42 @@
 
 namespace ballistica {
 
+// Distance at which we switch from the full model to its first LOD,
+// and the additional distance per step down the chain after that.
+const float kModelLODStartDistance = 30.0f;
+const float kModelLODStepDistance = 15.0f;
+
 ModelData::ModelData(const std::string& file_name_in)
     : file_name_(file_name_in) {
   file_name_full_ =
       g_media->FindMediaFile(Media::FileType::kModel, file_name_in);
+
+  // If a lower-detail sibling of ourself exists, pull it in too. These
+  // chain naturally; its own constructor will probe for the next step.
+  // (we're created under the media-lists-lock so nested fetches are ok).
+  std::string lod_name = file_name_in + "_lod1";
+  if (g_media->HaveMediaFile(Media::FileType::kModel, lod_name)) {
+    lod_model_ = g_media->GetModelData(lod_name);
+  }
   valid_ = true;
 }
 
+auto ModelData::GetLODForDistance(float distance) -> ModelData* {
+  ModelData* m = this;
+  float threshold = kModelLODStartDistance;
+  while (m->lod_model_.exists() && distance >= threshold) {
+    m = m->lod_model_.get();
+    threshold += kModelLODStepDistance;
+  }
+  return m;
+}
+
 void ModelData::DoPreload() {
   // In headless, don't load anything.
 #if !BA_HEADLESS_BUILD
 
   assert(!file_name_.empty());
-  FILE* f = g_platform->FOpen(file_name_full_.c_str(), "rb");
+  FILE* f = Media::FOpenMediaFile(file_name_full_);
   if (!f) {
     throw Exception("Can't open model: '" + file_name_full_ + "'");
   }
@@ -100,6 +124,16 @@ void ModelData::DoPreload() {
 
   fclose(f);
 
+  // Calc our model-space bounding radius for visibility culling.
+  float radius_squared = 0.0f;
+  for (auto&& v : vertices_) {
+    float len_squared = v.position[0] * v.position[0]
+                        + v.position[1] * v.position[1]
+                        + v.position[2] * v.position[2];
+    radius_squared = std::max(radius_squared, len_squared);
+  }
+  radius_ = sqrtf(radius_squared);
+
 #endif  // BA_HEADLESS_BUILD
 }
 
@@ -30,12 +30,29 @@ class ModelData : public MediaComponentData {
     assert(renderer_data_.exists());
     return renderer_data_.get();
   }
+
+  // Model-space bounding radius (max vertex distance from the origin);
+  // zero until preloaded. For conservative visibility culling.
+  auto radius() const -> float { return radius_; }
+
+  /// Next (lower detail) model in our LOD chain, or nullptr if this is
+  /// the last one. Chains are built from sibling files: "<name>_lod1",
+  /// "<name>_lod1_lod1", etc.
+  auto lod_model() const -> ModelData* { return lod_model_.get(); }
+
+  /// Return the model in our LOD chain appropriate for drawing at the
+  /// given world-space distance from the camera.
+  auto GetLODForDistance(float distance) -> ModelData*;
   auto vertices() const -> const std::vector<VertexObjectFull>& {
     return vertices_;
   }
   auto indices8() const -> const std::vector<uint8_t>& { return indices8_; }
   auto indices16() const -> const std::vector<uint16_t>& { return indices16_; }
   auto indices32() const -> const std::vector<uint32_t>& { return indices32_; }
+  auto GetApproxMemoryUse() const -> size_t override {
+    return vertices_.size() * sizeof(VertexObjectFull) + indices8_.size()
+           + indices16_.size() * 2 + indices32_.size() * 4;
+  }
   auto GetIndexSize() const -> int {
     switch (format_) {
       case MeshFormat::kUV16N8Index8:
@@ -51,9 +68,11 @@ class ModelData : public MediaComponentData {
 
  private:
   Object::Ref<ModelRendererData> renderer_data_;
+  Object::Ref<ModelData> lod_model_;
   std::string file_name_;
   std::string file_name_full_;
   MeshFormat format_{};
+  float radius_{};
   std::vector<VertexObjectFull> vertices_;
   std::vector<uint8_t> indices8_;
   std::vector<uint16_t> indices16_;
@@ -14,7 +14,10 @@
 #endif
 #endif  // BA_ENABLE_AUDIO
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "ballistica/audio/audio_server.h"
@@ -29,6 +32,14 @@
 
 namespace ballistica {
 
+struct SoundDecodeBuffer {
+  std::vector<char> pcm;
+#if BA_ENABLE_AUDIO
+  ALenum format{};
+  ALsizei freq{};
+#endif
+};
+
 #if BA_ENABLE_AUDIO
 
 const int kReadBufferSize = 32768;  // 32 KB buffers
@@ -61,7 +72,7 @@ static auto LoadOgg(const char* file_name, std::vector<char>* buffer,
   bool fallback = false;
 
   // Open for binary reading.
-  f = g_platform->FOpen(file_name, "rb");
+  f = Media::FOpenMediaFile(file_name);
   if (f == nullptr) {
     fallback = true;
     Log(std::string("Error: Can't open sound file '") + file_name
@@ -168,12 +179,18 @@ static void LoadCachedOgg(const char* file_name, std::vector<char>* buffer,
     g_platform->MakeDir(sound_cache_dir);
     made_sound_cache_dir = true;
   }
-  std::vector<char> b(strlen(file_name) + 1);
-  memcpy(b.data(), file_name, b.size());
-  for (char* c = &b[0]; *c != 0; c++) {
-    if ((*c) == '/') *c = '_';
+  // Key the cache file on a hash of the source path; mangled paths ran
+  // into name-length limits and collided on odd package layouts.
+  uint64_t path_hash = 14695981039346656037u;
+  for (const char* c = file_name; *c != 0; c++) {
+    path_hash ^= static_cast<uint8_t>(*c);
+    path_hash *= 1099511628211u;
   }
-  std::string cache_file_name = sound_cache_dir + "/" + &b[0] + ".cache";
+  char hash_name[32];
+  snprintf(hash_name, sizeof(hash_name), "%016llx",
+           static_cast<unsigned long long>(path_hash));  // NOLINT
+  std::string cache_file_name =
+      sound_cache_dir + "/" + hash_name + ".cache";
 
   // If we have a cache file and it matches the mod time on the ogg, attempt to
   // load it.
@@ -246,6 +263,45 @@ static void LoadCachedOgg(const char* file_name, std::vector<char>* buffer,
   }
 }
 
+// Live decoded buffers by full file name; identical sounds preloading
+// around the same window share one decode instead of each running the
+// ogg (or cache-file read) themselves.
+static std::mutex g_decoded_pcm_mutex;
+static std::unordered_map<std::string, std::weak_ptr<SoundDecodeBuffer> >
+    g_decoded_pcm;
+
+static auto GetDecodedPCM(const char* file_name)
+    -> std::shared_ptr<SoundDecodeBuffer> {
+  {
+    std::lock_guard<std::mutex> lock(g_decoded_pcm_mutex);
+    auto i = g_decoded_pcm.find(file_name);
+    if (i != g_decoded_pcm.end()) {
+      if (auto existing = i->second.lock()) {
+        return existing;
+      }
+    }
+  }
+
+  // Decode outside the lock; two threads racing on the same file just
+  // means one throwaway decode.
+  auto buffer = std::make_shared<SoundDecodeBuffer>();
+  LoadCachedOgg(file_name, &buffer->pcm, &buffer->format, &buffer->freq);
+  {
+    std::lock_guard<std::mutex> lock(g_decoded_pcm_mutex);
+
+    // Tidy any expired entries while we're here.
+    for (auto i = g_decoded_pcm.begin(); i != g_decoded_pcm.end();) {
+      if (i->second.expired()) {
+        i = g_decoded_pcm.erase(i);
+      } else {
+        ++i;
+      }
+    }
+    g_decoded_pcm[file_name] = buffer;
+  }
+  return buffer;
+}
+
 #endif  // BA_ENABLE_AUDIO
 
 SoundData::SoundData(const std::string& file_name_in)
@@ -270,7 +326,9 @@ void SoundData::DoPreload() {
     is_streamed_ = true;
   } else if (strstr(file_name_full_.c_str(), ".ogg")) {
     is_streamed_ = false;
-    LoadCachedOgg(file_name_full_.c_str(), &load_buffer_, &format_, &freq_);
+    load_buffer_ = GetDecodedPCM(file_name_full_.c_str());
+    format_ = load_buffer_->format;
+    freq_ = load_buffer_->freq;
   } else {
     throw Exception("Unsupported sound file (needs to end in .ogg): '"
                     + file_name_full_ + "'");
@@ -293,19 +351,25 @@ void SoundData::DoLoad() {
     CHECK_AL_ERROR;
 
     // Preload pulled data into our load-buffer, and send that along to openal.
-    alBufferData(buffer_, format_, &load_buffer_[0],
-                 static_cast<ALsizei>(load_buffer_.size()), freq_);
+    alBufferData(buffer_, format_, load_buffer_->pcm.data(),
+                 static_cast<ALsizei>(load_buffer_->pcm.size()), freq_);
 
     CHECK_AL_ERROR;
 
-    // Done with load buffer; clear its used memory.
-    std::vector<char>().swap(load_buffer_);
+    // Done with the decode buffer; drop our share of it (remembering
+    // its size for memory accounting).
+    approx_memory_use_ = load_buffer_->pcm.size();
+    load_buffer_.reset();
   }
 
   CHECK_AL_ERROR;
 #endif  // BA_ENABLE_AUDIO
 }
 
+auto SoundData::GetApproxMemoryUse() const -> size_t {
+  return load_buffer_ ? load_buffer_->pcm.size() : approx_memory_use_;
+}
+
 void SoundData::DoUnload() {
   assert(valid_);
   assert(InAudioThread());
@@ -3,6 +3,7 @@
 #ifndef BALLISTICA_MEDIA_DATA_SOUND_DATA_H_
 #define BALLISTICA_MEDIA_DATA_SOUND_DATA_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -11,6 +12,10 @@
 
 namespace ballistica {
 
+// A decoded PCM payload, shared between identical sounds so each file
+// decodes at most once no matter how many components reference it.
+struct SoundDecodeBuffer;
+
 class SoundData : public MediaComponentData {
  public:
   SoundData() = default;
@@ -29,12 +34,16 @@ class SoundData : public MediaComponentData {
   }
 #if BA_ENABLE_AUDIO
   auto format() const -> ALenum { return format_; }
+  auto freq() const -> ALsizei { return freq_; }
   auto buffer() const -> ALuint {
     assert(!is_streamed_);
     return buffer_;
   }
 #endif  // BA_ENABLE_AUDIO
   auto is_streamed() const -> bool { return is_streamed_; }
+
+  // Post-load, al is holding roughly what our decode buffer held.
+  auto GetApproxMemoryUse() const -> size_t override;
   auto file_name() const -> const std::string& { return file_name_; }
   auto file_name_full() const -> const std::string& { return file_name_full_; }
   void UpdatePlayTime() { last_play_time_ = GetRealTime(); }
@@ -49,7 +58,8 @@ class SoundData : public MediaComponentData {
   ALenum format_{};
   ALsizei freq_{};
 #endif  // BA_ENABLE_AUDIO
-  std::vector<char> load_buffer_;
+  std::shared_ptr<SoundDecodeBuffer> load_buffer_;
+  size_t approx_memory_use_{};
   millisecs_t last_play_time_{};
 };
 
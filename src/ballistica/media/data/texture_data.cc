@@ -435,8 +435,50 @@ void TextureData::DoLoad() {
   assert(!preload_datas_.empty());
   base_level_ = preload_datas_[0].base_level;
 
-  // If we're done, kill our preload data.
-  preload_datas_.clear();
+  // If we're done, kill our preload data (remembering its size for
+  // memory accounting; gl is holding roughly that much for us now).
+  approx_memory_use_ = GetApproxLoadSize();
+  if (renderer_data_->fully_loaded()) {
+    preload_datas_.clear();
+  } else {
+    // The renderer kept just our small mip tail; hold on to the preload
+    // buffers and let the graphics thread stream the big levels in over
+    // upcoming frames (see Media::RunTextureMipStreaming()).
+    g_media->AddTextureForMipStreaming(this);
+  }
+}
+
+auto TextureData::StreamMips(size_t byte_budget) -> bool {
+  assert(InGraphicsThread());
+
+  // If we got unloaded mid-stream there's nothing left to do (a reload
+  // starts the whole dance over).
+  if (!renderer_data_.exists()) {
+    return true;
+  }
+  if (renderer_data_->StreamMips(byte_budget)) {
+    preload_datas_.clear();
+    return true;
+  }
+  return false;
+}
+
+auto TextureData::GetApproxLoadSize() const -> size_t {
+  // Tally up what our preload stage produced; that's (roughly) what
+  // DoLoad() will be handing to gl.
+  size_t total{};
+  for (auto&& preload_data : preload_datas_) {
+    for (size_t size : preload_data.sizes) {
+      total += size;
+    }
+  }
+  return total;
+}
+
+auto TextureData::GetApproxMemoryUse() const -> size_t {
+  // Pre-load our data lives cpu-side; post-load gl holds about as much.
+  size_t preload_size = GetApproxLoadSize();
+  return preload_size != 0 ? preload_size : approx_memory_use_;
 }
 
 void TextureData::DoUnload() {
@@ -34,6 +34,11 @@ class TextureData : public MediaComponentData {
   void DoPreload() override;
   void DoLoad() override;
   void DoUnload() override;
+
+  // Hand pending mip levels to the renderer (graphics thread; see
+  // Media::RunTextureMipStreaming()). Returns whether we're fully
+  // resident (and thus done streaming).
+  auto StreamMips(size_t byte_budget) -> bool;
   auto texture_type() const -> TextureType { return type_; }
   auto is_qr_code() const -> bool { return is_qr_code_; }
   auto preload_datas() const -> const std::vector<TexturePreloadData>& {
@@ -44,6 +49,8 @@ class TextureData : public MediaComponentData {
     return renderer_data_.get();
   }
   auto base_level() const -> int { return base_level_; }
+  auto GetApproxLoadSize() const -> size_t override;
+  auto GetApproxMemoryUse() const -> size_t override;
 
  private:
   Object::Ref<TextPacker> packer_;
@@ -55,6 +62,7 @@ class TextureData : public MediaComponentData {
   TextureMinQuality min_quality_ = TextureMinQuality::kLow;
   Object::Ref<TextureRendererData> renderer_data_;
   int base_level_ = 0;
+  size_t approx_memory_use_{};
 };
 
 }  // namespace ballistica
@@ -4,9 +4,11 @@
 
 #include <algorithm>
 #include <cstring>
+#include <string>
 
 #include "ballistica/graphics/texture/ktx.h"
 #include "ballistica/media/component/texture.h"
+#include "ballistica/platform/platform.h"
 
 namespace ballistica {
 
@@ -410,6 +412,13 @@ void TexturePreloadData::ConvertToUncompressed(TextureData* texture) {
   for (int i = 0; i < kMaxTextureLevels; i++) {
     // Convert all non-empty texture slots.
     if (formats[i] != TextureFormat::kNone) {
+      // Check the disk cache first; entries are keyed by source content
+      // and build number, so anything stale is simply a miss.
+      std::string transcode_cache_path = GetTranscodeCachePath(
+          i, texture->texture_type() == TextureType::kCubeMap);
+      if (LoadCachedTranscode(transcode_cache_path, i)) {
+        break;
+      }
       if (formats[i] == TextureFormat::kDXT1) {
         // Lets go 32 bit for now.
         uint8_t* old_buffer = buffers[i];
@@ -559,11 +568,123 @@ void TexturePreloadData::ConvertToUncompressed(TextureData* texture) {
       // and is hopefully faster too..
       // HMMM actually the quality argument may be iffy in cases where
       // we're dithering.. (or maybe not?)
+      StoreCachedTranscode(transcode_cache_path, i);
       break;
     }
   }
 }
 
+auto TexturePreloadData::GetTranscodeCachePath(int level,
+                                               bool is_cube_map) const
+    -> std::string {
+  // Thread-safe since c++11; preloads can run from multiple threads.
+  static const std::string cache_dir = [] {
+    std::string dir = g_platform->GetConfigDirectory() + BA_DIRSLASH + "cache"
+                      + BA_DIRSLASH + "tex_transcode";
+    g_platform->MakeDir(dir, true);
+    return dir;
+  }();
+
+  // 64 bit fnv-1a over target params, build number, and source bytes.
+  uint64_t hash = 0xcbf29ce484222325u;
+  auto feed_bytes = [&hash](const void* data, size_t size) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ bytes[i]) * 0x100000001b3u;
+    }
+  };
+  int32_t meta[] = {static_cast<int32_t>(formats[level]), widths[level],
+                    heights[level], is_cube_map ? 1 : 0, kAppBuildNumber};
+  feed_bytes(meta, sizeof(meta));
+  feed_bytes(buffers[level], sizes[level]);
+  char name[32];
+  snprintf(name, sizeof(name), "%016llx.tex",
+           static_cast<unsigned long long>(hash));  // NOLINT
+  return cache_dir + BA_DIRSLASH + name;
+}
+
+auto TexturePreloadData::LoadCachedTranscode(const std::string& path,
+                                             int level) -> bool {
+  FILE* f = g_platform->FOpen(path.c_str(), "rb");
+  if (f == nullptr) {
+    return false;
+  }
+  uint32_t format32{};
+  int32_t width{};
+  int32_t height{};
+  uint32_t size32{};
+  bool success = (fread(&format32, sizeof(format32), 1, f) == 1
+                  && fread(&width, sizeof(width), 1, f) == 1
+                  && fread(&height, sizeof(height), 1, f) == 1
+                  && fread(&size32, sizeof(size32), 1, f) == 1 && size32 > 0
+                  && size32 < 64 * 1024 * 1024);
+  uint8_t* data = nullptr;
+  if (success) {
+    data = static_cast<uint8_t*>(malloc(size32));
+    success = (data != nullptr && fread(data, 1, size32, f) == size32);
+  }
+  fclose(f);
+  if (!success) {
+    if (data) {
+      free(data);
+    }
+    return false;
+  }
+  free(buffers[level]);
+  buffers[level] = data;
+  sizes[level] = size32;
+  formats[level] = static_cast<TextureFormat>(format32);
+  widths[level] = width;
+  heights[level] = height;
+  return true;
+}
+
+void TexturePreloadData::StoreCachedTranscode(const std::string& path,
+                                              int level) const {
+  if (buffers[level] == nullptr) {
+    return;
+  }
+
+  // Note that sizes[] only tracks compressed source data, so figure out
+  // our output size from the converted format.
+  size_t pixel_count =
+      static_cast<size_t>(widths[level]) * static_cast<size_t>(heights[level]);
+  size_t out_size;
+  switch (formats[level]) {
+    case TextureFormat::kRGBA_8888:
+      out_size = pixel_count * 4u;
+      break;
+    case TextureFormat::kRGB_888:
+      out_size = pixel_count * 3u;
+      break;
+    case TextureFormat::kRGBA_4444:
+    case TextureFormat::kRGB_565:
+      out_size = pixel_count * 2u;
+      break;
+    default:
+      // Only cache formats whose size we know.
+      return;
+  }
+  if (out_size == 0) {
+    return;
+  }
+  if (FILE* f = g_platform->FOpen(path.c_str(), "wb")) {
+    auto format32 = static_cast<uint32_t>(formats[level]);
+    auto width = static_cast<int32_t>(widths[level]);
+    auto height = static_cast<int32_t>(heights[level]);
+    auto size32 = static_cast<uint32_t>(out_size);
+    bool success = (fwrite(&format32, sizeof(format32), 1, f) == 1
+                    && fwrite(&width, sizeof(width), 1, f) == 1
+                    && fwrite(&height, sizeof(height), 1, f) == 1
+                    && fwrite(&size32, sizeof(size32), 1, f) == 1
+                    && fwrite(buffers[level], 1, size32, f) == size32);
+    fclose(f);
+    if (!success) {
+      g_platform->Remove(path.c_str());
+    }
+  }
+}
+
 TexturePreloadData::~TexturePreloadData() {
   for (auto& buffer : buffers) {
     if (buffer) {
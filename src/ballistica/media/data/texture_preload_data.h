@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_MEDIA_DATA_TEXTURE_PRELOAD_DATA_H_
 #define BALLISTICA_MEDIA_DATA_TEXTURE_PRELOAD_DATA_H_
 
+#include <string>
+
 #include "ballistica/ballistica.h"
 
 namespace ballistica {
@@ -27,6 +29,12 @@ class TexturePreloadData {
   ~TexturePreloadData();
   void ConvertToUncompressed(TextureData* texture);
 
+  // Disk cache of ConvertToUncompressed results, keyed by source content
+  // and target params; warm launches skip the software decompressors.
+  auto GetTranscodeCachePath(int level, bool is_cube_map) const -> std::string;
+  auto LoadCachedTranscode(const std::string& path, int level) -> bool;
+  void StoreCachedTranscode(const std::string& path, int level) const;
+
   uint8_t* buffers[kMaxTextureLevels]{};
   size_t sizes[kMaxTextureLevels]{};
   TextureFormat formats[kMaxTextureLevels]{};
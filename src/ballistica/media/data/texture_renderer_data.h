@@ -20,6 +20,17 @@ class TextureRendererData : public Object {
   // if incremental is true, return whether the load was completed
   // (non-incremental loads should always complete)
   virtual void Load() = 0;
+
+  // Whether all mip levels are resident. Renderers that stream large
+  // mips in after Load() (see StreamMips()) return false until the
+  // full chain has been handed to the api.
+  virtual auto fully_loaded() const -> bool { return true; }
+
+  // Upload pending higher mip levels, stopping once roughly byte_budget
+  // compressed bytes have gone to the api. Returns whether the texture
+  // is now fully resident. Default loads everything up-front in Load()
+  // so there is never anything to do here.
+  virtual auto StreamMips(size_t byte_budget) -> bool { return true; }
 };
 
 }  // namespace ballistica
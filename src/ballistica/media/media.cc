@@ -6,20 +6,35 @@
 #include <sys/stat.h>
 #endif
 
+#include <algorithm>
+#include <map>
 #include <set>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "ballistica/app/app.h"
 #include "ballistica/audio/audio_server.h"
+#include "ballistica/core/profiler.h"
 #include "ballistica/game/game.h"
+#include "ballistica/game/host_activity.h"
+#include "ballistica/game/session/host_session.h"
+#include "ballistica/generic/json.h"
 #include "ballistica/generic/timer.h"
 #include "ballistica/graphics/graphics_server.h"
 #include "ballistica/graphics/text/text_packer.h"
 #include "ballistica/media/component/collide_model.h"
 #include "ballistica/media/component/data.h"
 #include "ballistica/media/component/model.h"
+#include "ballistica/media/component/sound.h"
 #include "ballistica/media/component/texture.h"
 #include "ballistica/media/data/data_data.h"
 #include "ballistica/media/data/sound_data.h"
+#include "ballistica/media/data/texture_preload_data.h"
+#include "ballistica/media/media_pack_file.h"
+#include "ballistica/scene/node/node.h"
+#include "ballistica/scene/node/node_type.h"
+#include "ballistica/scene/scene.h"
 #include "ballistica/media/media_server.h"
 #include "ballistica/python/python_sys.h"
 
@@ -41,6 +56,18 @@ namespace ballistica {
 // How long we should spend loading media in each runPendingLoads() call.
 #define PENDING_LOAD_PROCESS_TIME 5
 
+// Max bytes we hand to the underlying api (gl, al, etc) per
+// runPendingLoads() call. The time limit above is only checked *after*
+// each load, so without this a few multi-MB textures finishing at once
+// can still blow a frame; we always run at least one load per call
+// though so big components can't stall the queue.
+#define PENDING_LOAD_BYTE_BUDGET (4 * 1024 * 1024)
+
+// Max compressed bytes of big mip levels we stream to the renderer per
+// frame once a texture is up and rendering from its small mip tail
+// (see RunTextureMipStreaming()).
+#define MIP_STREAM_BYTE_BUDGET (2 * 1024 * 1024)
+
 void Media::Init() {
   // Just create our singleton.
   assert(g_media == nullptr);
@@ -49,9 +76,32 @@ void Media::Init() {
 
 Media::Media() {
   media_paths_.emplace_back("ba_data");
+
+  // Mount a packed media archive if one's present; FindMediaFile() then
+  // answers out of its index with no syscalls and loaders read straight
+  // from the mapping. Loose files still work as the dev/fallback path.
+  pack_file_ = MediaPackFile::Open(media_paths_.front() + "/media.bapack");
+
   for (bool& have_pending_load : have_pending_loads_) {
     have_pending_load = false;
   }
+
+  // When the OS warns us about memory, prune aggressively; at critical
+  // levels also drop any unreferenced preloads outright (system media
+  // always has refs from the system lists so it stays put).
+  App::AddMemoryPressureCallback(
+      MemoryPressureLevel::kModerate, [](MemoryPressureLevel level) {
+        if (g_game == nullptr) {
+          return;
+        }
+        g_game->PushCall([level] {
+          bool critical{level == MemoryPressureLevel::kCritical};
+          g_media->Prune(critical ? 3 : 2);
+          if (critical) {
+            g_media->TrimMediaMemory(0);
+          }
+        });
+      });
 }
 
 void Media::LoadSystemTexture(SystemTextureID id, const char* name) {
@@ -447,36 +497,113 @@ void Media::UnloadRendererBits(bool do_textures, bool do_models) {
 
 auto Media::GetModelData(const std::string& file_name)
     -> Object::Ref<ModelData> {
-  return GetComponentData(file_name, &models_);
+  return GetComponentData(FileType::kModel, file_name, &models_,
+                          &models_by_content_);
 }
 
 auto Media::GetSoundData(const std::string& file_name)
     -> Object::Ref<SoundData> {
-  return GetComponentData(file_name, &sounds_);
+  return GetComponentData(FileType::kSound, file_name, &sounds_,
+                          &sounds_by_content_);
 }
 
 auto Media::GetDataData(const std::string& file_name) -> Object::Ref<DataData> {
-  return GetComponentData(file_name, &datas_);
+  return GetComponentData(FileType::kData, file_name, &datas_,
+                          &datas_by_content_);
 }
 
 auto Media::GetCollideModelData(const std::string& file_name)
     -> Object::Ref<CollideModelData> {
-  return GetComponentData(file_name, &collide_models_);
+  return GetComponentData(FileType::kCollisionModel, file_name,
+                          &collide_models_, &collide_models_by_content_);
+}
+
+// FNV-1a over a file's bytes. 0 means 'no hash' (unreadable or too big
+// to be worth scanning).
+static auto HashFileContents(const std::string& path) -> uint64_t {
+  FILE* f = Media::FOpenMediaFile(path);
+  if (f == nullptr) {
+    return 0;
+  }
+  uint64_t hash = 14695981039346656037u;
+  size_t total_bytes = 0;
+
+  // Music and suchlike can get big; cap what we're willing to scan.
+  const size_t kMaxHashFileBytes = 16 * 1024 * 1024;
+  char buffer[16384];
+  while (true) {
+    size_t count = fread(buffer, 1, sizeof(buffer), f);
+    for (size_t i = 0; i < count; i++) {
+      hash = (hash ^ static_cast<uint8_t>(buffer[i])) * 1099511628211u;
+    }
+    total_bytes += count;
+    if (total_bytes > kMaxHashFileBytes) {
+      fclose(f);
+      return 0;
+    }
+    if (count < sizeof(buffer)) {
+      break;
+    }
+  }
+  bool ok = (ferror(f) == 0 && total_bytes > 0);
+  fclose(f);
+  if (!ok) {
+    return 0;
+  }
+  // Reserve 0 as our 'no hash' value.
+  return hash != 0 ? hash : 1;
+}
+
+auto Media::GetMediaFileContentHash(FileType file_type,
+                                    const std::string& file_name) -> uint64_t {
+  assert(InGameThread());
+  std::string full_path;
+  try {
+    full_path = FindMediaFile(file_type, file_name);
+  } catch (const std::exception&) {
+    return 0;
+  }
+  auto i = media_file_content_hashes_.find(full_path);
+  if (i != media_file_content_hashes_.end()) {
+    return i->second;
+  }
+  uint64_t hash = HashFileContents(full_path);
+  media_file_content_hashes_[full_path] = hash;
+  return hash;
 }
 
 template <class T>
 auto Media::GetComponentData(
-    const std::string& file_name,
-    std::unordered_map<std::string, Object::Ref<T> >* c_list)
+    FileType file_type, const std::string& file_name,
+    FlatHashMap<Symbol, Object::Ref<T> >* c_list,
+    std::unordered_map<uint64_t, Object::WeakRef<T> >* content_map)
     -> Object::Ref<T> {
   assert(InGameThread());
   assert(media_lists_locked_);
-  auto i = c_list->find(file_name);
+  Symbol key(file_name);
+  auto i = c_list->find(key);
   if (i != c_list->end()) {
     return Object::Ref<T>(i->second.get());
   } else {
+    // First sight of this name. If its file's bytes match a component
+    // we've already got, alias the name to that one instead of loading
+    // the same payload twice.
+    uint64_t content_hash = GetMediaFileContentHash(file_type, file_name);
+    if (content_hash != 0) {
+      auto j = content_map->find(content_hash);
+      if (j != content_map->end() && j->second.exists()) {
+        Object::Ref<T> d(j->second.get());
+        (*c_list)[key] = d;
+        d->set_last_used_time(GetRealTime());
+        return d;
+      }
+    }
+
     auto d(Object::New<T>(file_name));
-    (*c_list)[file_name] = d;
+    (*c_list)[key] = d;
+    if (content_hash != 0) {
+      (*content_map)[content_hash] = Object::WeakRef<T>(d.get());
+    }
     {
       MediaComponentData::LockGuard lock(d.get());
       have_pending_loads_[static_cast<int>(d->GetMediaType())] = true;
@@ -533,13 +660,14 @@ auto Media::GetCubeMapTextureData(const std::string& file_name)
     -> Object::Ref<TextureData> {
   assert(InGameThread());
   assert(media_lists_locked_);
-  auto i = textures_.find(file_name);
+  Symbol key(file_name);
+  auto i = textures_.find(key);
   if (i != textures_.end()) {
     return Object::Ref<TextureData>(i->second.get());
   } else {
     auto d(Object::New<TextureData>(file_name, TextureType::kCubeMap,
                                     TextureMinQuality::kLow));
-    textures_[file_name] = d;
+    textures_[key] = d;
     {
       MediaComponentData::LockGuard lock(d.get());
       have_pending_loads_[static_cast<int>(d->GetMediaType())] = true;
@@ -556,10 +684,27 @@ auto Media::GetTextureData(const std::string& file_name)
     -> Object::Ref<TextureData> {
   assert(InGameThread());
   assert(media_lists_locked_);
-  auto i = textures_.find(file_name);
+  Symbol key(file_name);
+  auto i = textures_.find(key);
   if (i != textures_.end()) {
     return Object::Ref<TextureData>(i->second.get());
   } else {
+    // First sight of this name. If its file's bytes match a texture we
+    // already have, alias the name to it (workshop maps love shipping
+    // the same texture under several names).
+    uint64_t content_hash =
+        GetMediaFileContentHash(FileType::kTexture, file_name);
+    if (content_hash != 0) {
+      auto j = textures_by_content_.find(content_hash);
+      if (j != textures_by_content_.end() && j->second.exists()
+          && j->second.get()->texture_type() == TextureType::k2D) {
+        Object::Ref<TextureData> d(j->second.get());
+        textures_[key] = d;
+        d->set_last_used_time(GetRealTime());
+        return d;
+      }
+    }
+
     static std::set<std::string>* quality_map_medium = nullptr;
     static std::set<std::string>* quality_map_high = nullptr;
     static bool quality_maps_inited = false;
@@ -595,7 +740,11 @@ auto Media::GetTextureData(const std::string& file_name)
     }
 
     auto d(Object::New<TextureData>(file_name, TextureType::k2D, min_quality));
-    textures_[file_name] = d;
+    textures_[key] = d;
+    if (content_hash != 0) {
+      textures_by_content_[content_hash] =
+          Object::WeakRef<TextureData>(d.get());
+    }
     {
       MediaComponentData::LockGuard lock(d.get());
       have_pending_loads_[static_cast<int>(d->GetMediaType())] = true;
@@ -614,8 +763,8 @@ void Media::MarkComponentForLoad(MediaComponentData* c) {
   // *allocate* a reference as a standalone pointer so we can be
   // sure this guy sticks around until it's been sent all the way
   // through the preload/load cycle. (since other threads will be touching it)
-  // once it makes it back to us we can delete the ref (in
-  // ClearPendingLoadsDoneList)
+  // whichever thread finishes the load deletes the ref there (see
+  // RunPendingLoadList).
 
   auto media_ptr = new Object::Ref<MediaComponentData>(c);
   g_media_server->PushRunnable(Object::NewDeferred<PreloadRunnable>(media_ptr));
@@ -702,16 +851,19 @@ auto Media::GetPendingLoadCount() -> int {
          + GetCollideModelPendingLoadCount();
 }
 
-template <class T>
-auto Media::GetComponentPendingLoadCount(
-    std::unordered_map<std::string, Object::Ref<T> >* t_list, MediaType type)
-    -> int {
+template <class MAP>
+auto Media::GetComponentPendingLoadCount(MAP* t_list, MediaType type) -> int {
   assert(InGameThread());
   assert(media_lists_locked_);
 
   int c = 0;
   for (auto&& i : (*t_list)) {
     if (i.second.exists()) {
+      // Background-tagged components stream in behind the scenes; they
+      // shouldn't hold up load screens.
+      if (i.second->loads_in_background()) {
+        continue;
+      }
       if (i.second->TryLock()) {
         MediaComponentData::LockGuard lock(
             i.second.get(), MediaComponentData::LockGuard::Type::kInheritLock);
@@ -738,6 +890,31 @@ auto Media::RunPendingGraphicsLoads() -> bool {
   return RunPendingLoadList(&pending_loads_graphics_);
 }
 
+void Media::AddTextureForMipStreaming(TextureData* t) {
+  assert(InGraphicsThread());
+  assert(t);
+  mip_stream_textures_.emplace_back(t);
+}
+
+void Media::RunTextureMipStreaming() {
+  assert(InGraphicsThread());
+
+  // Stream at most one budget's worth per frame; simple fifo order.
+  // (textures that died or got unloaded mid-stream just fall off).
+  while (!mip_stream_textures_.empty()) {
+    TextureData* t = mip_stream_textures_.front().get();
+    bool done = (t == nullptr) || t->StreamMips(MIP_STREAM_BYTE_BUDGET);
+    if (done) {
+      mip_stream_textures_.erase(mip_stream_textures_.begin());
+      // A dead entry cost us nothing; keep looking for a live one.
+      if (t == nullptr) {
+        continue;
+      }
+    }
+    break;
+  }
+}
+
 // Runs the pending loads that run in the main thread.  Also clears the list of
 // done loads.
 auto Media::RunPendingLoadsGameThread() -> bool {
@@ -771,17 +948,40 @@ auto Media::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
     l.swap(*c_list);
   }
 
+  // (scoped here rather than at the top so empty passes cost nothing)
+  BA_PROFILE_SCOPE("media-loads");
+
+  // Run higher-priority components first so blocking spawn-area media
+  // beats background-streamed media to the api.
+  std::stable_sort(l.begin(), l.end(),
+                   [](Object::Ref<T>* a, Object::Ref<T>* b) {
+                     return (**a).load_priority() > (**b).load_priority();
+                   });
+
   // Run loads on our list until either the list is empty or we're out of time
   // (don't want to block here for very long...)
   // We should also think about the fact that even if a load is quick here it
   // may add work on the graphics thread/etc so maybe we should add other
   // restrictions.
   bool out_of_time = false;
+  size_t bytes_loaded = 0;
+  bool ran_a_load = false;
   if (!l.empty()) {
     while (true) {
       for (auto i = l.begin(); i != l.end(); i++) {
         if (!out_of_time) {
+          // If starting this load would blow our byte budget for this
+          // call, defer it (and everything after it) to a later call.
+          size_t load_size = (***i).GetApproxLoadSize();
+          if (ran_a_load && !flush
+              && bytes_loaded + load_size > PENDING_LOAD_BYTE_BUDGET) {
+            out_of_time = true;
+            l_unfinished.push_back(*i);
+            continue;
+          }
           (***i).Load(false);
+          ran_a_load = true;
+          bytes_loaded += load_size;
 
           // If the load finished, pop it on our "done-loading" list.. otherwise
           // keep it around.
@@ -802,27 +1002,64 @@ auto Media::RunPendingLoadList(std::vector<Object::Ref<T>*>* c_list) -> bool {
     }
   }
 
-  // Now add unfinished ones back onto the original list and finished ones into
-  // the done list.
+  // Now add unfinished ones back onto the original list.
   {
     std::lock_guard<std::mutex> lock(pending_load_list_mutex_);
     for (auto&& i : l) {
       c_list->push_back(i);
     }
-    for (auto&& i : l_finished) {
-      pending_loads_done_.push_back(i);
-    }
   }
 
-  // if we dumped anything on the pending loads done list, shake the game thread
-  // to tell it to kill the reference..
-  if (!l_finished.empty()) {
-    assert(g_game);
-    g_game->PushHavePendingLoadsDoneCall();
+  // Finished ones are simply done with their trip through the load
+  // cycle; media components use atomic referencing so we can drop these
+  // refs right here instead of bouncing them back to the game thread
+  // just to die. (anyone needing the component alive holds their own
+  // ref.)
+  for (auto&& i : l_finished) {
+    delete i;
   }
   return (!l.empty());
 }
 
+void Media::PinSessionMedia(FileType type, const std::string& name) {
+  assert(InGameThread());
+
+  // Key includes the type so a model and texture sharing a name don't
+  // collide.
+  std::string key = std::to_string(static_cast<int>(type)) + ":" + name;
+  if (!session_pinned_keys_.insert(key).second) {
+    return;  // Already pinned.
+  }
+  MediaListsLock lock;
+  MediaComponentData* data;
+  switch (type) {
+    case FileType::kTexture:
+      data = GetTextureData(name).get();
+      break;
+    case FileType::kModel:
+      data = GetModelData(name).get();
+      break;
+    case FileType::kCollisionModel:
+      data = GetCollideModelData(name).get();
+      break;
+    case FileType::kSound:
+      data = GetSoundData(name).get();
+      break;
+    case FileType::kData:
+      data = GetDataData(name).get();
+      break;
+    default:
+      throw Exception("Invalid media type for pinning.", PyExcType::kValue);
+  }
+  session_pinned_media_.emplace_back(data);
+}
+
+void Media::ClearSessionPinnedMedia() {
+  assert(InGameThread());
+  session_pinned_media_.clear();
+  session_pinned_keys_.clear();
+}
+
 void Media::Prune(int level) {
   assert(InGameThread());
   millisecs_t current_time = GetRealTime();
@@ -1059,6 +1296,319 @@ void Media::Prune(int level) {
 #endif  // SHOW_PRUNING_INFO
 }
 
+auto Media::GetTotalMediaMemoryUse() -> size_t {
+  assert(InGameThread());
+  MediaListsLock lock;
+  size_t total{};
+  for (auto&& i : textures_) {
+    total += i.second->GetApproxMemoryUse();
+  }
+  for (auto&& i : text_textures_) {
+    total += i.second->GetApproxMemoryUse();
+  }
+  for (auto&& i : qr_textures_) {
+    total += i.second->GetApproxMemoryUse();
+  }
+  for (auto&& i : models_) {
+    total += i.second->GetApproxMemoryUse();
+  }
+  for (auto&& i : collide_models_) {
+    total += i.second->GetApproxMemoryUse();
+  }
+  for (auto&& i : sounds_) {
+    total += i.second->GetApproxMemoryUse();
+  }
+  return total;
+}
+
+static auto TextureFormatName(TextureFormat format) -> const char* {
+  switch (format) {
+    case TextureFormat::kNone:
+      return "none";
+    case TextureFormat::kRGBA_8888:
+      return "rgba8888";
+    case TextureFormat::kRGB_888:
+      return "rgb888";
+    case TextureFormat::kRGBA_4444:
+      return "rgba4444";
+    case TextureFormat::kRGB_565:
+      return "rgb565";
+    case TextureFormat::kDXT1:
+      return "dxt1";
+    case TextureFormat::kDXT5:
+      return "dxt5";
+    case TextureFormat::kETC1:
+      return "etc1";
+    case TextureFormat::kPVR2:
+      return "pvr2";
+    case TextureFormat::kPVR4:
+      return "pvr4";
+    case TextureFormat::kETC2_RGB:
+      return "etc2rgb";
+    case TextureFormat::kETC2_RGBA:
+      return "etc2rgba";
+  }
+  return "unknown";
+}
+
+static auto TextureReportJson(TextureData* data) -> cJSON* {
+  cJSON* t = cJSON_CreateObject();
+  cJSON_AddStringToObject(t, "name", data->GetName().c_str());
+  if (!data->preload_datas().empty()) {
+    const TexturePreloadData& pd = data->preload_datas().front();
+    int level = data->base_level();
+    if (level < 0 || level >= kMaxTextureLevels) {
+      level = 0;
+    }
+    if (pd.widths[level] > 0) {
+      cJSON_AddNumberToObject(t, "width", pd.widths[level]);
+      cJSON_AddNumberToObject(t, "height", pd.heights[level]);
+      cJSON_AddStringToObject(t, "format",
+                              TextureFormatName(pd.formats[level]));
+    }
+  }
+  cJSON_AddNumberToObject(t, "bytes",
+                          static_cast<double>(data->GetApproxMemoryUse()));
+  cJSON_AddBoolToObject(t, "loaded", data->loaded());
+  return t;
+}
+
+static auto ModelReportJson(ModelData* data) -> cJSON* {
+  cJSON* m = cJSON_CreateObject();
+  cJSON_AddStringToObject(m, "name", data->GetName().c_str());
+  cJSON_AddNumberToObject(m, "verts",
+                          static_cast<double>(data->vertices().size()));
+  cJSON_AddNumberToObject(
+      m, "indices",
+      static_cast<double>(data->indices8().size() + data->indices16().size()
+                          + data->indices32().size()));
+  cJSON_AddNumberToObject(m, "bytes",
+                          static_cast<double>(data->GetApproxMemoryUse()));
+  return m;
+}
+
+static auto SimpleReportJson(MediaComponentData* data) -> cJSON* {
+  cJSON* c = cJSON_CreateObject();
+  cJSON_AddStringToObject(c, "name", data->GetName().c_str());
+  cJSON_AddNumberToObject(c, "bytes",
+                          static_cast<double>(data->GetApproxMemoryUse()));
+  return c;
+}
+
+static auto SceneNodeCountsJson(Scene* scene) -> cJSON* {
+  std::map<std::string, int> counts;
+  for (auto&& node : scene->nodes()) {
+    counts[node->type()->name()]++;
+  }
+  cJSON* nodes = cJSON_CreateObject();
+  for (auto&& i : counts) {
+    cJSON_AddNumberToObject(nodes, i.first.c_str(), i.second);
+  }
+  return nodes;
+}
+
+// Per-session/activity group: node counts from its scene plus whatever
+// media its weak lists are still holding onto.
+template <typename T>
+static auto GroupReportJson(const std::string& label, Scene* scene,
+                            const T& context_target) -> cJSON* {
+  cJSON* group = cJSON_CreateObject();
+  cJSON_AddStringToObject(group, "name", label.c_str());
+  if (scene != nullptr) {
+    cJSON_AddItemToObject(group, "nodes", SceneNodeCountsJson(scene));
+  }
+  cJSON* texs = cJSON_CreateArray();
+  for (auto&& i : context_target.textures()) {
+    if (i.second.exists() && i.second->texture_data() != nullptr) {
+      cJSON_AddItemToArray(texs, TextureReportJson(i.second->texture_data()));
+    }
+  }
+  cJSON_AddItemToObject(group, "textures", texs);
+  cJSON* models = cJSON_CreateArray();
+  for (auto&& i : context_target.models()) {
+    if (i.second.exists() && i.second->model_data() != nullptr) {
+      cJSON_AddItemToArray(models, ModelReportJson(i.second->model_data()));
+    }
+  }
+  cJSON_AddItemToObject(group, "models", models);
+  cJSON* sounds = cJSON_CreateArray();
+  for (auto&& i : context_target.sounds()) {
+    if (i.second.exists() && i.second->GetSoundData() != nullptr) {
+      cJSON_AddItemToArray(sounds,
+                           SimpleReportJson(i.second->GetSoundData()));
+    }
+  }
+  cJSON_AddItemToObject(group, "sounds", sounds);
+  return group;
+}
+
+auto Media::GetSceneMemoryReport() -> std::string {
+  assert(InGameThread());
+  cJSON* root = cJSON_CreateObject();
+
+  // Global section: everything currently in the media lists, owned or
+  // not (system media, ui, etc).
+  {
+    MediaListsLock lock;
+    cJSON* global = cJSON_CreateObject();
+    cJSON* texs = cJSON_CreateArray();
+    for (auto&& i : textures_) {
+      cJSON_AddItemToArray(texs, TextureReportJson(i.second.get()));
+    }
+    for (auto&& i : text_textures_) {
+      cJSON_AddItemToArray(texs, TextureReportJson(i.second.get()));
+    }
+    for (auto&& i : qr_textures_) {
+      cJSON_AddItemToArray(texs, TextureReportJson(i.second.get()));
+    }
+    cJSON_AddItemToObject(global, "textures", texs);
+    cJSON* models = cJSON_CreateArray();
+    for (auto&& i : models_) {
+      cJSON_AddItemToArray(models, ModelReportJson(i.second.get()));
+    }
+    cJSON_AddItemToObject(global, "models", models);
+    cJSON* collide_models = cJSON_CreateArray();
+    for (auto&& i : collide_models_) {
+      cJSON_AddItemToArray(collide_models, SimpleReportJson(i.second.get()));
+    }
+    cJSON_AddItemToObject(global, "collide_models", collide_models);
+    cJSON* sounds = cJSON_CreateArray();
+    for (auto&& i : sounds_) {
+      cJSON_AddItemToArray(sounds, SimpleReportJson(i.second.get()));
+    }
+    cJSON_AddItemToObject(global, "sounds", sounds);
+    cJSON_AddNumberToObject(global, "total_bytes",
+                            static_cast<double>(GetTotalMediaMemoryUse()));
+    cJSON_AddItemToObject(root, "global", global);
+  }
+
+  // Attribution groups: one per host session plus one per activity
+  // within it (client sessions hold no media of their own).
+  cJSON* groups = cJSON_CreateArray();
+  int session_num = 0;
+  for (auto&& s : g_game->sessions()) {
+    if (auto* host_session = dynamic_cast<HostSession*>(s.get())) {
+      std::string label = "session " + std::to_string(session_num);
+      cJSON_AddItemToArray(
+          groups,
+          GroupReportJson(label, host_session->scene(), *host_session));
+      for (auto&& a : host_session->host_activities()) {
+        cJSON* group = GroupReportJson(
+            label + " / " + a->GetObjectDescription(), a->scene(), *a);
+
+        // Collide models only live at the activity level.
+        cJSON* collide_models = cJSON_CreateArray();
+        for (auto&& i : a->collide_models()) {
+          if (i.second.exists() && i.second->collide_model_data() != nullptr) {
+            cJSON_AddItemToArray(
+                collide_models,
+                SimpleReportJson(i.second->collide_model_data()));
+          }
+        }
+        cJSON_AddItemToObject(group, "collide_models", collide_models);
+        cJSON_AddItemToArray(groups, group);
+      }
+    }
+    session_num++;
+  }
+  cJSON_AddItemToObject(root, "groups", groups);
+
+  char* out = cJSON_PrintUnformatted(root);
+  std::string result = out;
+  free(out);
+  cJSON_Delete(root);
+  return result;
+}
+
+void Media::TrimMediaMemory(size_t max_bytes) {
+  assert(InGameThread());
+  MediaListsLock lock;
+
+  // Tally usage and gather eviction candidates (preloaded components
+  // nothing else references) in one pass. System media always has refs
+  // from the system lists so it never shows up here.
+  size_t total{};
+  std::vector<std::pair<millisecs_t, MediaComponentData*> > candidates;
+  auto tally = [&total, &candidates](MediaComponentData* c, bool evictable) {
+    total += c->GetApproxMemoryUse();
+    if (evictable && c->preloaded() && c->object_strong_ref_count() <= 1) {
+      candidates.emplace_back(c->last_used_time(), c);
+    }
+  };
+  for (auto&& i : textures_) {
+    tally(i.second.get(), true);
+  }
+  for (auto&& i : text_textures_) {
+    tally(i.second.get(), true);
+  }
+  for (auto&& i : qr_textures_) {
+    tally(i.second.get(), true);
+  }
+  for (auto&& i : models_) {
+    tally(i.second.get(), true);
+  }
+  for (auto&& i : collide_models_) {
+    tally(i.second.get(), true);
+  }
+
+  // Sounds count toward the total but stay resident for now; see the
+  // disabled block in Prune() regarding openal buffer lifetimes.
+  for (auto&& i : sounds_) {
+    tally(i.second.get(), false);
+  }
+  if (total <= max_bytes) {
+    return;
+  }
+
+  // Least-recently-used first.
+  std::sort(candidates.begin(), candidates.end(),
+            [](const std::pair<millisecs_t, MediaComponentData*>& a,
+               const std::pair<millisecs_t, MediaComponentData*>& b) {
+              return a.first < b.first;
+            });
+  std::unordered_set<MediaComponentData*> evicts;
+  for (auto&& candidate : candidates) {
+    if (total <= max_bytes) {
+      break;
+    }
+    total -= std::min(total, candidate.second->GetApproxMemoryUse());
+    evicts.insert(candidate.second);
+  }
+
+  // Sweep the chosen ones out of our lists. Graphics components need
+  // the graphics thread to unload them, so those get kept alive by an
+  // extra ref until that goes through (same as Prune()).
+  std::vector<Object::Ref<MediaComponentData>*> graphics_thread_unloads;
+  auto sweep_graphics_list = [&graphics_thread_unloads,
+                              &evicts](auto* component_list) {
+    for (auto i = component_list->begin(); i != component_list->end();) {
+      if (evicts.find(i->second.get()) != evicts.end()) {
+        graphics_thread_unloads.push_back(
+            new Object::Ref<MediaComponentData>(i->second.get()));
+        i = component_list->erase(i);
+      } else {
+        i++;
+      }
+    }
+  };
+  sweep_graphics_list(&textures_);
+  sweep_graphics_list(&text_textures_);
+  sweep_graphics_list(&qr_textures_);
+  sweep_graphics_list(&models_);
+  for (auto i = collide_models_.begin(); i != collide_models_.end();) {
+    if (evicts.find(i->second.get()) != evicts.end()) {
+      // These unload in the game thread, so we can do it in place.
+      i->second->Unload();
+      i = collide_models_.erase(i);
+    } else {
+      i++;
+    }
+  }
+  if (!graphics_thread_unloads.empty()) {
+    g_graphics_server->PushComponentUnloadCall(graphics_thread_unloads);
+  }
+}
+
 auto Media::FindMediaFile(FileType type, const std::string& name)
     -> std::string {
   std::string file_out;
@@ -1129,6 +1679,23 @@ auto Media::FindMediaFile(FileType type, const std::string& name)
       break;
   }
 
+  // If a pack archive is mounted, answer from its index when possible;
+  // that's a hash lookup with no stat calls involved.
+  if (pack_file_ != nullptr) {
+    std::string entry_name = std::string(prefix) + name + ext;
+
+    // '#' denotes a cube map texture (six entries); probe one face.
+    if (strchr(entry_name.c_str(), '#')) {
+      std::string probe = entry_name;
+      probe.replace(probe.find('#'), 1, "_+x");
+      if (pack_file_->HasEntry(probe)) {
+        return kMediaPackPathPrefix + entry_name;
+      }
+    } else if (pack_file_->HasEntry(entry_name)) {
+      return kMediaPackPathPrefix + entry_name;
+    }
+  }
+
   const std::vector<std::string>& media_paths_used = media_paths_;
 
   for (auto&& i : media_paths_used) {
@@ -1166,6 +1733,22 @@ auto Media::FindMediaFile(FileType type, const std::string& name)
   // return file_out;
 }
 
+auto Media::HaveMediaFile(FileType type, const std::string& name) -> bool {
+  assert(InGameThread());
+#if BA_HEADLESS_BUILD
+  // FindMediaFile() returns dummy paths unconditionally in headless builds,
+  // so there's nothing meaningful to probe.
+  return false;
+#else   // BA_HEADLESS_BUILD
+  try {
+    FindMediaFile(type, name);
+    return true;
+  } catch (const std::exception&) {
+    return false;
+  }
+#endif  // BA_HEADLESS_BUILD
+}
+
 void Media::AddPendingLoad(Object::Ref<MediaComponentData>* c) {
   switch ((**c).GetMediaType()) {
     case MediaType::kTexture:
@@ -1196,22 +1779,6 @@ void Media::AddPendingLoad(Object::Ref<MediaComponentData>* c) {
   }
 }
 
-void Media::ClearPendingLoadsDoneList() {
-  assert(InGameThread());
-
-  std::lock_guard<std::mutex> lock(pending_load_list_mutex_);
-
-  // Our explicitly-allocated reference pointer has made it back to us here in
-  // the game thread.
-  // We can now kill the reference knowing that it's safe for this component
-  // to die at any time (anyone needing it to be alive now should be holding a
-  // reference themselves).
-  for (Object::Ref<MediaComponentData>* i : pending_loads_done_) {
-    delete i;
-  }
-  pending_loads_done_.clear();
-}
-
 void Media::PreloadRunnable::Run() {
   assert(InMediaThread());
 
@@ -1225,6 +1792,15 @@ void Media::PreloadRunnable::Run() {
   g_media_server->process_timer_->SetLength(0);
 }
 
+auto Media::FOpenMediaFile(const std::string& path) -> FILE* {
+  size_t prefix_len = strlen(kMediaPackPathPrefix);
+  if (g_media != nullptr && g_media->pack_file_ != nullptr
+      && path.compare(0, prefix_len, kMediaPackPathPrefix) == 0) {
+    return g_media->pack_file_->FOpenEntry(path.substr(prefix_len));
+  }
+  return g_platform->FOpen(path.c_str(), "rb");
+}
+
 void Media::AddPackage(const std::string& name, const std::string& path) {
   // we don't protect package-path access so make sure its always from here..
   assert(InGameThread());
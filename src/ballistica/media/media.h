@@ -3,13 +3,18 @@
 #ifndef BALLISTICA_MEDIA_MEDIA_H_
 #define BALLISTICA_MEDIA_MEDIA_H_
 
+#include <cstdio>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "ballistica/core/context.h"
 #include "ballistica/core/module.h"
 #include "ballistica/core/object.h"
+#include "ballistica/generic/flat_hash_map.h"
+#include "ballistica/generic/symbol.h"
 
 namespace ballistica {
 
@@ -45,6 +50,30 @@ class Media {
   void AddPackage(const std::string& name, const std::string& path);
   void Prune(int level = 0);
 
+  /// Approximate bytes currently held across all component lists.
+  auto GetTotalMediaMemoryUse() -> size_t;
+
+  /// Build a json diagnostic report walking the live scene and media
+  /// lists: per-texture dimensions/format/bytes, model vertex/index
+  /// counts, collide-model and sound sizes, and node counts by type,
+  /// grouped by owning session/activity plus a global section covering
+  /// everything loaded. For bouncing oversized community content with
+  /// data rather than vibes.
+  auto GetSceneMemoryReport() -> std::string;
+
+  /// Evict least-recently-used unreferenced components until total
+  /// media memory is at or under max_bytes. System media stays pinned
+  /// (the system lists hold refs to it, so it never counts as
+  /// unreferenced); level media whose refs are gone is fair game even
+  /// if it hasn't aged out of the normal Prune() window yet.
+  void TrimMediaMemory(size_t max_bytes);
+
+  /// Open a media file path for binary reading. Paths handed out by
+  /// FindMediaFile() may point into the mounted pack archive, in which
+  /// case this returns a stream over the mapped bytes; anything else
+  /// falls through to a regular file open. Callable from any thread.
+  static auto FOpenMediaFile(const std::string& path) -> FILE*;
+
   /// Finish loading any media that has been preloaded but still needs to be
   /// loaded by the proper thread.
   auto RunPendingLoadsGameThread() -> bool;
@@ -54,7 +83,14 @@ class Media {
 
   /// Return true if graphics loads remain to be done.
   auto RunPendingGraphicsLoads() -> bool;
-  void ClearPendingLoadsDoneList();
+
+  /// Register a texture that came up with only its small mip tail
+  /// resident (graphics thread only).
+  void AddTextureForMipStreaming(TextureData* t);
+
+  /// Stream pending big mip levels to the renderer within a per-frame
+  /// byte budget (graphics thread; called each render).
+  void RunTextureMipStreaming();
   template <class T>
   auto RunPendingLoadList(std::vector<Object::Ref<T>*>* cList) -> bool;
 
@@ -66,6 +102,23 @@ class Media {
   auto FindMediaFile(FileType fileType, const std::string& file_in)
       -> std::string;
 
+  /// Return whether a media file exists on disk without throwing or
+  /// falling back to a substitute. Only meaningful for types with no
+  /// fallback (models, collision-models, data); always false in headless
+  /// builds since those hand back dummy paths unconditionally.
+  auto HaveMediaFile(FileType fileType, const std::string& file_in) -> bool;
+
+  /// Pin a named piece of media at session scope: we hold a strong ref
+  /// to its underlying data, so Prune()/TrimMediaMemory() leave it
+  /// resident while scenes come and go. Used for the common set (spaz
+  /// bits, standard bombs, etc) that every map would otherwise reload
+  /// on rotation. Repinning an already-pinned item is a no-op.
+  void PinSessionMedia(FileType type, const std::string& name);
+
+  /// Drop all session pins; runs at session teardown so a pin can
+  /// never outlive the session that asked for it.
+  void ClearSessionPinnedMedia();
+
   /// Unload renderer-specific bits only (gl display lists, etc) - used when
   /// recreating/adjusting the renderer.
   void UnloadRendererBits(bool textures, bool models);
@@ -164,18 +217,25 @@ class Media {
   void LoadSystemData(SystemDataID id, const char* name);
   void LoadSystemModel(SystemModelID id, const char* name);
 
-  template <class T>
-  auto GetComponentPendingLoadCount(
-      std::unordered_map<std::string, Object::Ref<T> >* t_list, MediaType type)
-      -> int;
+  template <class MAP>
+  auto GetComponentPendingLoadCount(MAP* t_list, MediaType type) -> int;
 
   template <class T>
-  auto GetComponentData(
-      const std::string& file_name,
-      std::unordered_map<std::string, Object::Ref<T> >* c_list)
-      -> Object::Ref<T>;
+  auto GetComponentData(FileType file_type, const std::string& file_name,
+                        FlatHashMap<Symbol, Object::Ref<T> >* c_list,
+                        std::unordered_map<uint64_t, Object::WeakRef<T> >*
+                            content_map) -> Object::Ref<T>;
+
+  // Content-hash for a media file (cached per resolved path). 0 means
+  // 'no hash available' (unreadable or too big to be worth scanning).
+  auto GetMediaFileContentHash(FileType file_type,
+                               const std::string& file_name) -> uint64_t;
 
   std::vector<std::string> media_paths_;
+
+  // Mounted packed media archive, if present. Set once at construction
+  // and read-only after, so loader threads need no locking.
+  std::unique_ptr<MediaPackFile> pack_file_;
   bool have_pending_loads_[static_cast<int>(MediaType::kLast)]{};
   std::unordered_map<std::string, std::string> packages_;
 
@@ -186,6 +246,10 @@ class Media {
   // during any media list access.
   bool media_lists_locked_{};
 
+  // Session-scope pins; see PinSessionMedia().
+  std::vector<Object::Ref<MediaComponentData> > session_pinned_media_;
+  std::unordered_set<std::string> session_pinned_keys_;
+
   // 'hard-wired' internal media
   bool system_media_loaded_{};
   std::vector<Object::Ref<TextureData> > system_textures_;
@@ -194,15 +258,33 @@ class Media {
   std::vector<Object::Ref<DataData> > system_datas_;
   std::vector<Object::Ref<ModelData> > system_models_;
 
-  // All existing media by filename (including internal).
-  std::unordered_map<std::string, Object::Ref<TextureData> > textures_;
+  // All existing media by filename (including internal). Filenames are
+  // a bounded set so they key by interned Symbol in flat maps; text/qr
+  // textures key by raw string since their keys (text hashes, urls)
+  // are open-ended.
+  FlatHashMap<Symbol, Object::Ref<TextureData> > textures_;
   std::unordered_map<std::string, Object::Ref<TextureData> > text_textures_;
   std::unordered_map<std::string, Object::Ref<TextureData> > qr_textures_;
-  std::unordered_map<std::string, Object::Ref<ModelData> > models_;
-  std::unordered_map<std::string, Object::Ref<SoundData> > sounds_;
-  std::unordered_map<std::string, Object::Ref<DataData> > datas_;
-  std::unordered_map<std::string, Object::Ref<CollideModelData> >
-      collide_models_;
+  FlatHashMap<Symbol, Object::Ref<ModelData> > models_;
+  FlatHashMap<Symbol, Object::Ref<SoundData> > sounds_;
+  FlatHashMap<Symbol, Object::Ref<DataData> > datas_;
+  FlatHashMap<Symbol, Object::Ref<CollideModelData> > collide_models_;
+
+  // Content-hash aliasing: workshop maps often ship byte-identical media
+  // under different names, so on first sight of a name we hash its file
+  // and point the name at any live component with the same bytes (one
+  // component and one gl texture/vbo instead of two). Weak refs since
+  // pruning can drop components out from under us.
+  std::unordered_map<std::string, uint64_t> media_file_content_hashes_;
+  std::unordered_map<uint64_t, Object::WeakRef<TextureData> >
+      textures_by_content_;
+  std::unordered_map<uint64_t, Object::WeakRef<ModelData> >
+      models_by_content_;
+  std::unordered_map<uint64_t, Object::WeakRef<SoundData> >
+      sounds_by_content_;
+  std::unordered_map<uint64_t, Object::WeakRef<DataData> > datas_by_content_;
+  std::unordered_map<uint64_t, Object::WeakRef<CollideModelData> >
+      collide_models_by_content_;
 
   // Components that have been preloaded but need to be loaded.
   std::mutex pending_load_list_mutex_;
@@ -210,7 +292,10 @@ class Media {
   std::vector<Object::Ref<MediaComponentData>*> pending_loads_sounds_;
   std::vector<Object::Ref<MediaComponentData>*> pending_loads_datas_;
   std::vector<Object::Ref<MediaComponentData>*> pending_loads_other_;
-  std::vector<Object::Ref<MediaComponentData>*> pending_loads_done_;
+
+  // Textures with big mip levels still to be streamed in (graphics
+  // thread only). Weak refs since unloads can kill these mid-stream.
+  std::vector<Object::WeakRef<TextureData> > mip_stream_textures_;
 };
 
 }  // namespace ballistica
@@ -0,0 +1,170 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/media/media_pack_file.h"
+
+#include <cstring>
+
+#include "ballistica/platform/mapped_file.h"
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+
+auto MediaPackFile::Open(const std::string& path)
+    -> std::unique_ptr<MediaPackFile> {
+#if BA_OSTYPE_WINDOWS
+  // MapFile has no mapping path there yet; windows builds keep using
+  // loose files.
+  return nullptr;
+#else
+  auto mapping = g_platform->MapFile(path);
+  if (!mapping || mapping->size() < 12) {
+    return nullptr;
+  }
+  auto size = mapping->size();
+
+  std::unique_ptr<MediaPackFile> pack(new MediaPackFile());
+  pack->path_ = path;
+  pack->mapping_ = std::move(mapping);
+  pack->data_ = pack->mapping_->data();
+  pack->data_size_ = size;
+
+  // Walk the index; any truncation or garbage means we reject the whole
+  // thing and the caller falls back to loose files.
+  const uint8_t* p = pack->data_;
+  const uint8_t* p_end = pack->data_ + size;
+  auto read_bytes = [&p, p_end](void* dst, size_t len) -> bool {
+    if (static_cast<size_t>(p_end - p) < len) {
+      return false;
+    }
+    memcpy(dst, p, len);
+    p += len;
+    return true;
+  };
+  uint32_t file_id{};
+  uint32_t version{};
+  uint32_t entry_count{};
+  if (!read_bytes(&file_id, 4) || !read_bytes(&version, 4)
+      || !read_bytes(&entry_count, 4)
+      || file_id != static_cast<uint32_t>(kPakFileID)
+      || version != kVersion) {
+    return nullptr;
+  }
+  for (uint32_t i = 0; i < entry_count; i++) {
+    uint16_t name_len{};
+    if (!read_bytes(&name_len, 2)) {
+      return nullptr;
+    }
+    if (static_cast<size_t>(p_end - p) < name_len) {
+      return nullptr;
+    }
+    std::string name(reinterpret_cast<const char*>(p), name_len);
+    p += name_len;
+    Entry entry;
+    if (!read_bytes(&entry.offset, 8) || !read_bytes(&entry.size, 8)
+        || entry.offset + entry.size > size) {
+      return nullptr;
+    }
+    pack->entries_[name] = entry;
+  }
+  return pack;
+#endif  // BA_OSTYPE_WINDOWS
+}
+
+MediaPackFile::~MediaPackFile() = default;
+
+auto MediaPackFile::FOpenEntry(const std::string& name) const -> FILE* {
+#if BA_OSTYPE_WINDOWS
+  return nullptr;
+#else
+  auto i = entries_.find(name);
+  if (i == entries_.end()) {
+    return nullptr;
+  }
+
+  // Get the entry's pages faulting in now; the loader will be parsing
+  // headers while the rest streams in behind it.
+  mapping_->Prefetch(static_cast<size_t>(i->second.offset),
+                     static_cast<size_t>(i->second.size));
+
+  // Read-only stream over the mapped span; loaders fread from it just
+  // like a real file and fclose it when done.
+  return fmemopen(const_cast<uint8_t*>(data_ + i->second.offset),
+                  static_cast<size_t>(i->second.size), "rb");
+#endif  // BA_OSTYPE_WINDOWS
+}
+
+auto MediaPackFile::Write(
+    const std::string& path,
+    const std::vector<std::pair<std::string, std::string> >& entries) -> bool {
+  FILE* out = g_platform->FOpen(path.c_str(), "wb");
+  if (!out) {
+    return false;
+  }
+
+  // Index size is known up front, so entry offsets can be laid out
+  // before any data gets written.
+  size_t header_size = 12;
+  for (auto&& entry : entries) {
+    header_size += 2 + entry.first.size() + 16;
+  }
+  std::vector<Entry> layouts(entries.size());
+  uint64_t offset = header_size;
+  for (size_t i = 0; i < entries.size(); i++) {
+    offset = (offset + kAlignment - 1) & ~static_cast<uint64_t>(kAlignment - 1);
+    FILE* in = g_platform->FOpen(entries[i].second.c_str(), "rb");
+    if (!in) {
+      fclose(out);
+      return false;
+    }
+    fseek(in, 0, SEEK_END);
+    layouts[i].offset = offset;
+    layouts[i].size = static_cast<uint64_t>(ftell(in));
+    fclose(in);
+    offset += layouts[i].size;
+  }
+
+  bool success = true;
+  auto write_bytes = [out, &success](const void* src, size_t len) {
+    if (success && len > 0 && fwrite(src, len, 1, out) != 1) {
+      success = false;
+    }
+  };
+  auto file_id = static_cast<uint32_t>(kPakFileID);
+  uint32_t version = kVersion;
+  auto entry_count = static_cast<uint32_t>(entries.size());
+  write_bytes(&file_id, 4);
+  write_bytes(&version, 4);
+  write_bytes(&entry_count, 4);
+  for (size_t i = 0; i < entries.size(); i++) {
+    auto name_len = static_cast<uint16_t>(entries[i].first.size());
+    write_bytes(&name_len, 2);
+    write_bytes(entries[i].first.data(), name_len);
+    write_bytes(&layouts[i].offset, 8);
+    write_bytes(&layouts[i].size, 8);
+  }
+  std::vector<uint8_t> buffer;
+  for (size_t i = 0; i < entries.size(); i++) {
+    // Zero-pad up to the entry's aligned offset.
+    long pos = success ? ftell(out) : 0;  // NOLINT: ftell API.
+    while (success && static_cast<uint64_t>(pos) < layouts[i].offset) {
+      uint8_t zero{};
+      write_bytes(&zero, 1);
+      pos++;
+    }
+    FILE* in = g_platform->FOpen(entries[i].second.c_str(), "rb");
+    if (!in) {
+      success = false;
+      break;
+    }
+    buffer.resize(static_cast<size_t>(layouts[i].size));
+    if (!buffer.empty() && fread(buffer.data(), buffer.size(), 1, in) != 1) {
+      success = false;
+    }
+    fclose(in);
+    write_bytes(buffer.data(), buffer.size());
+  }
+  fclose(out);
+  return success;
+}
+
+}  // namespace ballistica
@@ -0,0 +1,80 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_MEDIA_MEDIA_PACK_FILE_H_
+#define BALLISTICA_MEDIA_MEDIA_PACK_FILE_H_
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// Prefix marking media paths that resolve into the mounted pack archive
+// (see Media::FOpenMediaFile()).
+const char* const kMediaPackPathPrefix = "%pack%/";
+
+// A packed media archive: one file holding many media entries behind a
+// content index, with each entry's data page-aligned. The whole archive
+// gets memory-mapped once at mount time (via Platform::MapFile), so a
+// level load issues a single open instead of hundreds, entry bytes stay
+// file-backed instead of being copied to the heap, and opening an entry
+// issues a prefetch hint so its pages are faulting in while the loader
+// parses headers.
+//
+// Layout (all little-endian):
+//   uint32 kPakFileID
+//   uint32 version
+//   uint32 entry-count
+//   per entry: uint16 name-length, name bytes, uint64 offset, uint64 size
+//   entry data, each starting on a kAlignment boundary
+class MediaPackFile {
+ public:
+  static constexpr uint32_t kVersion = 1;
+  static constexpr size_t kAlignment = 4096;
+
+  // Maps and indexes a pack; returns nullptr if the file can't be
+  // opened or isn't a valid pack (callers then fall back to loose
+  // files).
+  static auto Open(const std::string& path) -> std::unique_ptr<MediaPackFile>;
+
+  // Writes a pack containing the given (entry-name, source-file-path)
+  // pairs. Used by pipeline tooling; the engine itself only reads.
+  static auto Write(
+      const std::string& path,
+      const std::vector<std::pair<std::string, std::string> >& entries)
+      -> bool;
+
+  ~MediaPackFile();
+
+  auto HasEntry(const std::string& name) const -> bool {
+    return entries_.find(name) != entries_.end();
+  }
+
+  // Returns a read-only FILE* over an entry's bytes (so existing
+  // fread-based loaders work unchanged), or nullptr if no such entry.
+  auto FOpenEntry(const std::string& name) const -> FILE*;
+
+  auto path() const -> const std::string& { return path_; }
+  auto entry_count() const -> size_t { return entries_.size(); }
+
+ private:
+  struct Entry {
+    uint64_t offset{};
+    uint64_t size{};
+  };
+  MediaPackFile() = default;
+  std::string path_;
+  std::unordered_map<std::string, Entry> entries_;
+  std::unique_ptr<MappedFile> mapping_;
+  const uint8_t* data_{};
+  size_t data_size_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_MEDIA_MEDIA_PACK_FILE_H_
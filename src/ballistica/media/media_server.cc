@@ -2,10 +2,19 @@
 
 #include "ballistica/media/media_server.h"
 
+#if !BA_OSTYPE_WINDOWS
+#include <unistd.h>
+#endif
+
+#include <algorithm>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "ballistica/core/profiler.h"
 #include "ballistica/generic/huffman.h"
+#include "ballistica/generic/job_pool.h"
+#include "ballistica/generic/lzss.h"
 #include "ballistica/generic/timer.h"
 #include "ballistica/generic/utils.h"
 #include "ballistica/graphics/graphics_server.h"
@@ -15,6 +24,12 @@
 
 namespace ballistica {
 
+// How often the replay writer syncs landed data all the way to disk
+// (each flushed chunk already goes to the kernel immediately; this
+// additionally covers machine-level failures without paying for an
+// fsync per flush).
+const millisecs_t kReplaySyncIntervalMillisecs = 10000;
+
 MediaServer::MediaServer(Thread* thread)
     : Module("media", thread),
       writing_replay_(false),
@@ -41,40 +56,59 @@ void MediaServer::PushBeginWriteReplayCall() {
     // case
     if (writing_replay_) {
       Log("MediaServer got BeginWriteReplayCall while already writing");
-      WriteReplayMessages();
-      if (replay_out_file_) {
-        fclose(replay_out_file_);
-      }
-      replay_out_file_ = nullptr;
+      replay_messages_.clear();
+      replay_message_bytes_ = 0;
+      g_platform->PushFileIOCall([this] {
+        if (replay_out_file_) {
+          fclose(replay_out_file_);
+          replay_out_file_ = nullptr;
+        }
+      });
       replays_broken_ = true;
       return;
     }
     writing_replay_ = true;
+    replay_write_failed_ = false;
 
-    std::string f_name = "__lastReplay";
-    assert(g_platform);
-    std::string file_path =
-        g_platform->GetReplaysDir() + BA_DIRSLASH + f_name + ".brp";
-    replay_out_file_ = g_platform->FOpen(file_path.c_str(), "wb");
-    replay_bytes_written_ = 0;
+    // All actual disk access happens over on the platform's file-io
+    // thread; its calls run in submission order so the open, writes,
+    // and close stay correctly sequenced and we never block here.
+    g_platform->PushFileIOCall([this] {
+      std::string f_name = "__lastReplay";
+      assert(g_platform);
+      std::string file_path =
+          g_platform->GetReplaysDir() + BA_DIRSLASH + f_name + ".brp";
+      replay_out_file_ = g_platform->FOpen(file_path.c_str(), "wb");
+      replay_bytes_written_ = 0;
 
-    if (!replay_out_file_) {
-      Log("ERROR: unable to open output-stream file: '" + file_path + "'");
-    } else {
-      // write file id and protocol-version
-      // NOTE - we always write replays in our host protocol version
-      // no matter what the client stream is
-      uint32_t file_id = kBrpFileID;
-      uint16_t version = kProtocolVersion;
-      if ((fwrite(&file_id, sizeof(file_id), 1, replay_out_file_) != 1)
-          || (fwrite(&version, sizeof(version), 1, replay_out_file_) != 1)) {
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
-        Log("error writing replay file header: "
-            + g_platform->GetErrnoString());
+      if (!replay_out_file_) {
+        Log("ERROR: unable to open output-stream file: '" + file_path + "'");
+        replay_write_failed_ = true;
+      } else {
+        // write file id and protocol-version
+        // NOTE - we always write replays in our host protocol version
+        // no matter what the client stream is
+        uint32_t file_id = kBrpFileID;
+        uint16_t version = kProtocolVersion;
+        if ((fwrite(&file_id, sizeof(file_id), 1, replay_out_file_) != 1)
+            || (fwrite(&version, sizeof(version), 1, replay_out_file_)
+                != 1)) {
+          fclose(replay_out_file_);
+          replay_out_file_ = nullptr;
+          Log("error writing replay file header: "
+              + g_platform->GetErrnoString());
+          replay_write_failed_ = true;
+        }
+        replay_bytes_written_ = 5;
+        if (replay_out_file_) {
+          // Get the header out to the kernel right away so even an
+          // immediately-killed session leaves a well-formed (if empty)
+          // replay on disk.
+          fflush(replay_out_file_);
+        }
+        replay_last_sync_time_ = Platform::GetCurrentMilliseconds();
       }
-      replay_bytes_written_ = 5;
-    }
+    });
 
     // trigger our process timer to go off immediately
     // (we may need to wake it up)
@@ -96,13 +130,18 @@ void MediaServer::PushAddMessageToReplayCall(const std::vector<uint8_t>& data) {
     }
 
     // just add it to our list
-    if (replay_out_file_) {
+    if (!replay_write_failed_) {
       // if we've got too much data built up (lets go with 10 megs for now),
       // abort
       if (replay_message_bytes_ > 10000000) {
         Log("replay output buffer exceeded 10 megs; aborting replay");
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
+        g_platform->PushFileIOCall([this] {
+          if (replay_out_file_) {
+            fclose(replay_out_file_);
+            replay_out_file_ = nullptr;
+          }
+        });
+        replay_write_failed_ = true;
         replay_message_bytes_ = 0;
         replay_messages_.clear();
         return;
@@ -128,72 +167,202 @@ void MediaServer::PushEndWriteReplayCall() {
     WriteReplayMessages();
 
     // whether or not we actually have a file has no impact on our
-    // writing_replay_ status..
-    if (replay_out_file_) {
+    // writing_replay_ status.. (the close lands after any writes still
+    // queued on the file-io thread)
+    g_platform->PushFileIOCall([this] {
+      bool completed = (replay_out_file_ != nullptr);
+      if (replay_out_file_) {
+        fclose(replay_out_file_);
+        replay_out_file_ = nullptr;
+      }
+
+      // Fleet boxes archiving replays can have us recompress finished
+      // files in-process (set BA_REPLAY_RECOMPRESS=1) instead of their
+      // archive pipeline re-reading and re-compressing them
+      // out-of-process. Runs on its own low-priority thread; we're a
+      // hundred-meg job at the leisurely end of the priority ladder.
+      if (completed && getenv("BA_REPLAY_RECOMPRESS") != nullptr) {
+        std::string path = g_platform->GetReplaysDir() + BA_DIRSLASH
+                           + "__lastReplay.brp";
+        std::thread([path] {
+          g_platform->SetCurrentThreadClass(ThreadClass::kBulkLoader);
+          RecompressReplay(path);
+        }).detach();
+      }
+    });
+    writing_replay_ = false;
+  });
+}
+
+void MediaServer::WriteReplayMessages() {
+  if (replay_write_failed_) {
+    // Disk side is dead; just drop whatever we've built up.
+    replay_messages_.clear();
+    replay_message_bytes_ = 0;
+    return;
+  }
+  if (replay_messages_.empty()) {
+    return;
+  }
+
+  // Compression and framing happen here in our thread; the result then
+  // goes out as a single contiguous write on the file-io thread.
+  std::vector<uint8_t> chunk;
+  for (auto&& i : replay_messages_) {
+    std::vector<uint8_t> data_compressed = g_utils->huffman()->compress(i);
+
+    // If message length is < 254, write length as one byte.
+    // If its between 254 and 65535, write 254 and then 2 length bytes
+    // otherwise write 255 and then 4 length bytes.
+    auto len32 = static_cast<uint32_t>(data_compressed.size());
+    {
+      uint8_t len8;
+      if (len32 < 254) {
+        len8 = static_cast_check_fit<uint8_t>(len32);
+      } else if (len32 < 65535) {
+        len8 = 254;
+      } else {
+        len8 = 255;
+      }
+      chunk.push_back(len8);
+    }
+    // write 16 bit val if need be..
+    if (len32 >= 254) {
+      if (len32 <= 65535) {
+        auto len16 = static_cast_check_fit<uint16_t>(len32);
+        auto* p = reinterpret_cast<uint8_t*>(&len16);
+        chunk.insert(chunk.end(), p, p + sizeof(len16));
+      } else {
+        auto* p = reinterpret_cast<uint8_t*>(&len32);
+        chunk.insert(chunk.end(), p, p + sizeof(len32));
+      }
+    }
+    // the buffer itself
+    chunk.insert(chunk.end(), data_compressed.begin(), data_compressed.end());
+  }
+  replay_messages_.clear();
+  replay_message_bytes_ = 0;
+
+  g_platform->PushFileIOCall([this, chunk{std::move(chunk)}] {
+    if (!replay_out_file_) {
+      return;
+    }
+    if (fwrite(&(chunk[0]), chunk.size(), 1, replay_out_file_) != 1) {
       fclose(replay_out_file_);
       replay_out_file_ = nullptr;
+      Log("error writing replay file: " + g_platform->GetErrnoString());
+      replay_write_failed_ = true;
+      return;
     }
-    writing_replay_ = false;
+    replay_bytes_written_ += chunk.size();
+
+    // Make each flush durable as it lands: hand it to the kernel now
+    // (so an OOM kill mid-session can only cost us in-flight data, not
+    // the whole file) and sync to disk every so often. Since we always
+    // flush whole framed chunks, a recovered partial file ends on a
+    // message boundary and plays back like a normal short replay.
+    fflush(replay_out_file_);
+#if !BA_OSTYPE_WINDOWS
+    millisecs_t now = Platform::GetCurrentMilliseconds();
+    if (now - replay_last_sync_time_ >= kReplaySyncIntervalMillisecs) {
+      replay_last_sync_time_ = now;
+      fsync(fileno(replay_out_file_));
+    }
+#endif
   });
 }
 
-void MediaServer::WriteReplayMessages() {
-  if (replay_out_file_) {
-    for (auto&& i : replay_messages_) {
-      std::vector<uint8_t> data_compressed = g_utils->huffman()->compress(i);
-
-      // If message length is < 254, write length as one byte.
-      // If its between 254 and 65535, write 254 and then 2 length bytes
-      // otherwise write 255 and then 4 length bytes.
-      auto len32 = static_cast<uint32_t>(data_compressed.size());
-      {
-        uint8_t len8;
-        if (len32 < 254) {
-          len8 = static_cast_check_fit<uint8_t>(len32);
-        } else if (len32 < 65535) {
-          len8 = 254;
-        } else {
-          len8 = 255;
-        }
-        if (fwrite(&len8, 1, 1, replay_out_file_) != 1) {
-          fclose(replay_out_file_);
-          replay_out_file_ = nullptr;
-          Log("error writing replay file: " + g_platform->GetErrnoString());
-          return;
-        }
+// How much raw replay we squeeze per block. Blocks compress
+// independently so we never hold a whole hour-long file in memory;
+// the window resets each block but at this size that costs almost
+// nothing in ratio.
+const size_t kReplayRecompressBlockSize = 4 * 1024 * 1024;
+
+// Recompress a finished raw replay into the lzss-block .brpz container,
+// removing the raw file on success. The raw byte stream (including the
+// v2 seek-index footer) is preserved exactly, so expanding the blocks
+// yields a byte-identical .brp. Runs on a throwaway low-priority thread;
+// touches no instance state.
+void MediaServer::RecompressReplay(const std::string& path) {
+  FILE* in = g_platform->FOpen(path.c_str(), "rb");
+  if (in == nullptr) {
+    return;
+  }
+  std::string out_path = path + "z";  // .brp -> .brpz
+  FILE* out = g_platform->FOpen(out_path.c_str(), "wb");
+  if (out == nullptr) {
+    Log("replay recompress: can't open '" + out_path + "'");
+    fclose(in);
+    return;
+  }
+  bool success{};
+  uint64_t raw_total{};
+  uint64_t compressed_total{};
+  uint32_t file_id = kBrpzFileID;
+  if (fwrite(&file_id, sizeof(file_id), 1, out) == 1) {
+    success = true;
+    std::vector<uint8_t> raw(kReplayRecompressBlockSize);
+    while (true) {
+      size_t amt = fread(&raw[0], 1, kReplayRecompressBlockSize, in);
+      if (amt == 0) {
+        break;
       }
-      // write 16 bit val if need be..
-      if (len32 >= 254) {
-        if (len32 <= 65535) {
-          auto len16 = static_cast_check_fit<uint16_t>(len32);
-          if (fwrite(&len16, 2, 1, replay_out_file_) != 1) {
-            fclose(replay_out_file_);
-            replay_out_file_ = nullptr;
-            Log("error writing replay file: " + g_platform->GetErrnoString());
-            return;
-          }
-        } else {
-          if (fwrite(&len32, 4, 1, replay_out_file_) != 1) {
-            fclose(replay_out_file_);
-            replay_out_file_ = nullptr;
-            Log("error writing replay file: " + g_platform->GetErrnoString());
-            return;
-          }
-        }
+      raw.resize(amt);
+      std::vector<uint8_t> compressed = LZSS::Compress(raw);
+
+      // Cheap insurance before we go deleting originals: make sure
+      // this block actually expands back to what we read.
+      if (LZSS::Decompress(compressed, raw.size()) != raw) {
+        Log("replay recompress: verify failed; keeping raw file.");
+        success = false;
+        break;
       }
-      // write buffer
-      size_t result = fwrite(&(data_compressed[0]), data_compressed.size(), 1,
-                             replay_out_file_);
-      if (result != 1) {
-        fclose(replay_out_file_);
-        replay_out_file_ = nullptr;
-        Log("error writing replay file: " + g_platform->GetErrnoString());
-        return;
+
+      // Incompressible blocks get stored as-is (flagged by equal
+      // sizes).
+      std::vector<uint8_t>& payload =
+          (compressed.size() < raw.size()) ? compressed : raw;
+      auto raw_len = static_cast<uint32_t>(raw.size());
+      auto payload_len = static_cast<uint32_t>(payload.size());
+      if (fwrite(&raw_len, sizeof(raw_len), 1, out) != 1
+          || fwrite(&payload_len, sizeof(payload_len), 1, out) != 1
+          || fwrite(&payload[0], payload.size(), 1, out) != 1) {
+        Log("replay recompress: write failed: "
+            + g_platform->GetErrnoString());
+        success = false;
+        break;
+      }
+      raw_total += raw.size();
+      compressed_total += payload.size();
+      if (amt < kReplayRecompressBlockSize) {
+        break;
       }
-      replay_bytes_written_ += data_compressed.size() + 2;
+      raw.resize(kReplayRecompressBlockSize);
     }
-    replay_messages_.clear();
-    replay_message_bytes_ = 0;
+    if (ferror(in)) {
+      success = false;
+    }
+  } else {
+    success = false;
+  }
+  fclose(in);
+
+  // Make the new file durable before the raw one goes away.
+  if (success) {
+    fflush(out);
+#if !BA_OSTYPE_WINDOWS
+    fsync(fileno(out));
+#endif
+  }
+  if (fclose(out) != 0) {
+    success = false;
+  }
+  if (success) {
+    g_platform->Remove(path.c_str());
+    Log("replay recompressed: " + std::to_string(raw_total) + " -> "
+        + std::to_string(compressed_total) + " bytes.");
+  } else {
+    g_platform->Remove(out_path.c_str());
   }
 }
 
@@ -206,19 +375,41 @@ void MediaServer::Process() {
     return;
   }
 
-  // process exactly 1 preload item.. empty out our non-audio list first
-  // (audio is less likely to cause noticeable hitches if it needs to be loaded
-  // on-demand, so that's a lower priority for us)
-  if (!pending_preloads_.empty()) {
-    (**pending_preloads_.back()).Preload();
-    // pass the ref-pointer along to the load queue
-    g_media->AddPendingLoad(pending_preloads_.back());
-    pending_preloads_.pop_back();
-  } else if (!pending_preloads_audio_.empty()) {
-    (**pending_preloads_audio_.back()).Preload();
-    // pass the ref-pointer along to the load queue
-    g_media->AddPendingLoad(pending_preloads_audio_.back());
-    pending_preloads_audio_.pop_back();
+  // Fan accumulated preloads out across our worker pool; each decode is
+  // self-contained (components carry their own locks and DoPreload is
+  // explicitly any-thread) and completions funnel through the existing
+  // mutex-protected pending-load lists, so the game/graphics/audio-side
+  // consumers see no difference. Non-audio items queue first since
+  // audio is less likely to cause noticeable hitches if it ends up
+  // loading on-demand.
+  if (!pending_preloads_.empty() || !pending_preloads_audio_.empty()) {
+    BA_PROFILE_SCOPE("media-preloads");
+    if (!preload_job_pool_) {
+      // Decode wants throughput; leave a couple cores for the rest of
+      // the engine but otherwise scale with the machine.
+      int worker_count = std::min(
+          8, std::max(1, static_cast<int>(std::thread::hardware_concurrency())
+                             - 2));
+      preload_job_pool_ = std::make_unique<JobPool>(worker_count);
+    }
+    for (auto&& p : pending_preloads_) {
+      preload_job_pool_->AddJob([p] {
+        (**p).Preload();
+        // Pass the ref-pointer along to the load queue.
+        g_media->AddPendingLoad(p);
+      });
+    }
+    pending_preloads_.clear();
+    for (auto&& p : pending_preloads_audio_) {
+      preload_job_pool_->AddJob([p] {
+        (**p).Preload();
+        g_media->AddPendingLoad(p);
+      });
+    }
+    pending_preloads_audio_.clear();
+
+    // Pitch in on the decode work ourself until the batch is done.
+    preload_job_pool_->Wait();
   }
 
   // if we're writing a replay, dump anything we've got built up..
@@ -3,7 +3,10 @@
 #ifndef BALLISTICA_MEDIA_MEDIA_SERVER_H_
 #define BALLISTICA_MEDIA_MEDIA_SERVER_H_
 
+#include <atomic>
 #include <list>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "ballistica/core/module.h"
@@ -21,13 +24,25 @@ class MediaServer : public Module {
  private:
   void Process();
   void WriteReplayMessages();
+  static void RecompressReplay(const std::string& path);
+
+  // Replay disk access all happens via the platform's file-io thread
+  // (whose calls run in submission order); these two are only touched
+  // from there once writing begins.
   FILE* replay_out_file_{};
   size_t replay_bytes_written_{};
+  millisecs_t replay_last_sync_time_{};
+
+  // Set by the file-io thread on any write error so we stop buffering.
+  std::atomic<bool> replay_write_failed_{};
   bool writing_replay_{};
   bool replays_broken_{};
   std::list<std::vector<uint8_t> > replay_messages_;
   size_t replay_message_bytes_{};
   Timer* process_timer_{};
+
+  // Workers for fanning out preload decodes; spun up on first use.
+  std::unique_ptr<JobPool> preload_job_pool_;
   std::vector<Object::Ref<MediaComponentData>*> pending_preloads_;
   std::vector<Object::Ref<MediaComponentData>*> pending_preloads_audio_;
   friend struct PreloadRunnable;
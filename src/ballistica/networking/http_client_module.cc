@@ -0,0 +1,307 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/networking/http_client_module.h"
+
+#include <cstring>
+#include <vector>
+
+#include "ballistica/networking/networking_sys.h"
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+
+// Keep responses bounded; nothing we talk to legitimately sends more.
+const size_t kHttpMaxResponseBytes = 16 * 1024 * 1024;
+const size_t kHttpMaxHeaderBytes = 64 * 1024;
+
+// Blocking send/recv timeout so a wedged server can't hang our thread
+// forever.
+const int kHttpTimeoutSeconds = 30;
+
+HttpClientModule::HttpClientModule(Thread* thread)
+    : Module("httpclient", thread) {
+  assert(g_http_client_module == nullptr);
+  g_http_client_module = this;
+}
+
+void HttpClientModule::PushRequestCall(const Request& request,
+                                       Module* callback_module,
+                                       ResponseCallback callback) {
+  assert(callback_module);
+  PushCall([this, request, callback_module, callback] {
+    Response response = DoRequest(request);
+    callback_module->PushCall([callback, response] { callback(response); });
+  });
+}
+
+auto HttpClientModule::DoRequest(const Request& request) -> Response {
+  Response response;
+
+  // Pull scheme/host/port/path out of the url.
+  if (request.url.compare(0, 7, "http://") != 0) {
+    // (https would mean pulling in a tls stack; callers needing that
+    // stay on the python path for now)
+    response.error = "unsupported url scheme: '" + request.url + "'";
+    return response;
+  }
+  std::string rest = request.url.substr(7);
+  size_t slash = rest.find('/');
+  std::string host_port = (slash == std::string::npos)
+                              ? rest
+                              : rest.substr(0, slash);
+  std::string path =
+      (slash == std::string::npos) ? "/" : rest.substr(slash);
+  int port = 80;
+  std::string host = host_port;
+  size_t colon = host_port.find(':');
+  if (colon != std::string::npos) {
+    host = host_port.substr(0, colon);
+    port = atoi(host_port.substr(colon + 1).c_str());
+  }
+  if (host.empty() || port <= 0 || port > 65535) {
+    response.error = "invalid url: '" + request.url + "'";
+    return response;
+  }
+
+  std::string request_text =
+      request.method + " " + path + " HTTP/1.1\r\nHost: " + host_port
+      + "\r\nConnection: keep-alive\r\nAccept-Encoding: identity\r\n";
+  if (!request.data.empty()) {
+    request_text += "Content-Type: " + request.content_type
+                    + "\r\nContent-Length: "
+                    + std::to_string(request.data.size()) + "\r\n";
+  }
+  request_text += "\r\n" + request.data;
+
+  // A kept-alive connection can have gone stale under us; if the send
+  // or response-read over a reused one fails, reconnect fresh and try
+  // once more.
+  std::string key = host_port;
+  for (int attempt = 0; attempt < 2; attempt++) {
+    bool reused = (connections_.find(key) != connections_.end());
+    int sd = GetConnection(host, port, &response.error);
+    if (sd == -1) {
+      return response;
+    }
+    if (!SendAll(sd, request_text.c_str(), request_text.size())) {
+      DropConnection(key);
+      if (reused) {
+        continue;
+      }
+      response.error = "send failed for '" + request.url + "'";
+      return response;
+    }
+    response.body.clear();
+    bool keep = ReadResponse(sd, &response);
+    if (!response.success && reused && attempt == 0) {
+      DropConnection(key);
+      continue;
+    }
+    if (!keep) {
+      DropConnection(key);
+    }
+    return response;
+  }
+  return response;
+}
+
+auto HttpClientModule::GetConnection(const std::string& host, int port,
+                                     std::string* error) -> int {
+  std::string key = host + ":" + std::to_string(port);
+  auto existing = connections_.find(key);
+  if (existing != connections_.end()) {
+    return existing->second;
+  }
+
+  // We're on our own thread; blocking resolves are fine.
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  addrinfo* results{};
+  if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints,
+                  &results) != 0
+      || results == nullptr) {
+    *error = "can't resolve host: '" + host + "'";
+    return -1;
+  }
+  int sd = -1;
+  for (addrinfo* i = results; i != nullptr; i = i->ai_next) {
+    sd = static_cast<int>(
+        socket(i->ai_family, i->ai_socktype, i->ai_protocol));
+    if (sd == -1) {
+      continue;
+    }
+    if (connect(sd, i->ai_addr, static_cast<int>(i->ai_addrlen)) == 0) {
+      break;
+    }
+    g_platform->CloseSocket(sd);
+    sd = -1;
+  }
+  freeaddrinfo(results);
+  if (sd == -1) {
+    *error = "can't connect to '" + key + "'";
+    return -1;
+  }
+
+#if BA_OSTYPE_WINDOWS
+  DWORD timeout = kHttpTimeoutSeconds * 1000;
+  setsockopt(sd, SOL_SOCKET, SO_RCVTIMEO,
+             reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+  setsockopt(sd, SOL_SOCKET, SO_SNDTIMEO,
+             reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#else
+  timeval timeout{};
+  timeout.tv_sec = kHttpTimeoutSeconds;
+  setsockopt(sd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  setsockopt(sd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#endif
+
+  connections_[key] = sd;
+  return sd;
+}
+
+void HttpClientModule::DropConnection(const std::string& key) {
+  auto i = connections_.find(key);
+  if (i != connections_.end()) {
+    g_platform->CloseSocket(i->second);
+    connections_.erase(i);
+  }
+}
+
+auto HttpClientModule::SendAll(int sd, const char* buf, size_t len) -> bool {
+  size_t sent = 0;
+  while (sent < len) {
+    auto result = send(sd, buf + sent, static_cast<int>(len - sent), 0);
+    if (result <= 0) {
+      return false;
+    }
+    sent += static_cast<size_t>(result);
+  }
+  return true;
+}
+
+auto HttpClientModule::ReadResponse(int sd, Response* response) -> bool {
+  // Accumulate until we've got the full header block.
+  std::string buffer;
+  size_t header_end;
+  while (true) {
+    header_end = buffer.find("\r\n\r\n");
+    if (header_end != std::string::npos) {
+      break;
+    }
+    if (buffer.size() > kHttpMaxHeaderBytes) {
+      response->error = "oversized response header";
+      return false;
+    }
+    char chunk[4096];
+    auto result = recv(sd, chunk, sizeof(chunk), 0);
+    if (result <= 0) {
+      response->error = "connection lost reading response";
+      return false;
+    }
+    buffer.append(chunk, static_cast<size_t>(result));
+  }
+  std::string headers = buffer.substr(0, header_end);
+  std::string remainder = buffer.substr(header_end + 4);
+
+  // Status line: "HTTP/1.1 200 OK".
+  size_t space = headers.find(' ');
+  if (space == std::string::npos) {
+    response->error = "malformed response status line";
+    return false;
+  }
+  response->status_code = atoi(headers.c_str() + space + 1);
+
+  // The few headers we care about (case-insensitively).
+  std::string headers_lower = headers;
+  for (char& c : headers_lower) {
+    c = static_cast<char>(tolower(c));
+  }
+  bool keep_alive = (headers_lower.find("connection: close")
+                     == std::string::npos);
+  bool chunked = (headers_lower.find("transfer-encoding: chunked")
+                  != std::string::npos);
+  size_t content_length = 0;
+  bool have_content_length = false;
+  size_t cl_pos = headers_lower.find("content-length:");
+  if (cl_pos != std::string::npos) {
+    content_length = static_cast<size_t>(
+        strtoul(headers_lower.c_str() + cl_pos + 15, nullptr, 10));
+    have_content_length = true;
+  }
+  if (content_length > kHttpMaxResponseBytes) {
+    response->error = "oversized response body";
+    return false;
+  }
+
+  // Helper: pull more bytes into remainder.
+  auto read_more = [&remainder, sd]() -> bool {
+    char chunk[16384];
+    auto result = recv(sd, chunk, sizeof(chunk), 0);
+    if (result <= 0) {
+      return false;
+    }
+    remainder.append(chunk, static_cast<size_t>(result));
+    return true;
+  };
+
+  if (chunked) {
+    // Decode chunks: hex-size line, data, repeat until a zero chunk.
+    while (true) {
+      size_t line_end = remainder.find("\r\n");
+      if (line_end == std::string::npos) {
+        if (!read_more()) {
+          response->error = "connection lost reading chunked body";
+          return false;
+        }
+        continue;
+      }
+      size_t chunk_size =
+          static_cast<size_t>(strtoul(remainder.c_str(), nullptr, 16));
+      if (response->body.size() + chunk_size > kHttpMaxResponseBytes) {
+        response->error = "oversized response body";
+        return false;
+      }
+      while (remainder.size() < line_end + 2 + chunk_size + 2) {
+        if (!read_more()) {
+          response->error = "connection lost reading chunked body";
+          return false;
+        }
+      }
+      response->body.append(remainder, line_end + 2, chunk_size);
+      remainder.erase(0, line_end + 2 + chunk_size + 2);
+      if (chunk_size == 0) {
+        break;
+      }
+    }
+  } else if (have_content_length) {
+    while (remainder.size() < content_length) {
+      if (!read_more()) {
+        response->error = "connection lost reading response body";
+        return false;
+      }
+    }
+    response->body = remainder.substr(0, content_length);
+  } else {
+    // No length info; body runs to connection close.
+    response->body = remainder;
+    char chunk[16384];
+    while (true) {
+      auto result = recv(sd, chunk, sizeof(chunk), 0);
+      if (result <= 0) {
+        break;
+      }
+      response->body.append(chunk, static_cast<size_t>(result));
+      if (response->body.size() > kHttpMaxResponseBytes) {
+        response->error = "oversized response body";
+        return false;
+      }
+    }
+    keep_alive = false;
+  }
+
+  response->success = true;
+  return keep_alive;
+}
+
+}  // namespace ballistica
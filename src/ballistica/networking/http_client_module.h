@@ -0,0 +1,65 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_NETWORKING_HTTP_CLIENT_MODULE_H_
+#define BALLISTICA_NETWORKING_HTTP_CLIENT_MODULE_H_
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+#include "ballistica/core/module.h"
+
+namespace ballistica {
+
+// A native http client running in its own thread; master-server
+// heartbeats, stat posts, and other telemetry can go through here
+// without waking Python at all. Connections are kept alive per
+// host so a server's once-a-minute traffic reuses one socket
+// instead of re-handshaking every time.
+class HttpClientModule : public Module {
+ public:
+  explicit HttpClientModule(Thread* thread);
+
+  struct Request {
+    std::string url;  // Currently http:// only.
+    std::string method{"GET"};
+    std::string data;  // Body; sent for POST/PUT.
+    std::string content_type{"application/x-www-form-urlencoded"};
+  };
+
+  struct Response {
+    bool success{};
+    int status_code{};
+    std::string body;
+    std::string error;  // Set when success is false.
+  };
+
+  typedef std::function<void(const Response&)> ResponseCallback;
+
+  // Run a request on our thread and deliver the response to
+  // callback_module via a pushed call; blocking connects/reads never
+  // touch the caller's thread.
+  void PushRequestCall(const Request& request, Module* callback_module,
+                       ResponseCallback callback);
+
+ private:
+  auto DoRequest(const Request& request) -> Response;
+
+  // Return a connected socket for host:port (reusing a kept-alive one
+  // when possible); -1 on failure with *error set.
+  auto GetConnection(const std::string& host, int port, std::string* error)
+      -> int;
+  void DropConnection(const std::string& key);
+  static auto SendAll(int sd, const char* buf, size_t len) -> bool;
+
+  // Read a full http response off the socket. Returns whether the
+  // socket is still good for another request afterwards.
+  auto ReadResponse(int sd, Response* response) -> bool;
+
+  // Open keep-alive connections by "host:port".
+  std::unordered_map<std::string, int> connections_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_NETWORKING_HTTP_CLIENT_MODULE_H_
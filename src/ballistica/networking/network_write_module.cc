@@ -0,0 +1,168 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/networking/network_write_module.h"
+
+#include <utility>
+
+#include "ballistica/game/load_test.h"
+#include "ballistica/graphics/frame_ledger.h"
+#include "ballistica/networking/network_reader.h"
+#include "ballistica/networking/networking.h"
+#include "ballistica/platform/platform.h"
+
+namespace ballistica {
+
+NetworkWriteModule::NetworkWriteModule(Thread* thread)
+    : Module("networkwrite", thread) {
+  assert(g_network_write_module == nullptr);
+  g_network_write_module = this;
+}
+
+void NetworkWriteModule::PushSendToCall(const std::vector<uint8_t>& msg,
+                                        const SockAddr& addr) {
+  // Packets aimed at a running load test's fake endpoints loop back
+  // in-process instead of hitting the wire (no-op when none's running).
+  if (LoadTest::InterceptOutgoingPacket(msg, addr)) {
+    return;
+  }
+  bool need_flush;
+  {
+    std::lock_guard<std::mutex> lock(gather_mutex_);
+    gather_.push_back(GatherEntry{msg, addr});
+
+    // A single queued flush drains everything accumulated by the time it
+    // runs, so we only ever need one in flight.
+    need_flush = !flush_pending_;
+    flush_pending_ = true;
+  }
+  if (need_flush) {
+    PushCall([this] { DoFlush(); });
+  }
+}
+
+void NetworkWriteModule::PushResolveCall(const std::string& hostname, int port,
+                                         Module* callback_module,
+                                         ResolveCallback callback) {
+  assert(callback_module);
+  PushCall([hostname, port, callback_module, callback] {
+    // First see if this is already a numeric address; SockAddr's string
+    // constructor handles those without hitting the network.
+    try {
+      SockAddr addr(hostname, port);
+      callback_module->PushCall([callback, addr] { callback(true, addr); });
+      return;
+    } catch (const std::exception&) {
+    }
+
+    // Fall back to a real (potentially slow) dns lookup. We're on the
+    // network-write thread here so blocking is fine.
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_DGRAM;
+    addrinfo* results{};
+    int result = getaddrinfo(hostname.c_str(), std::to_string(port).c_str(),
+                             &hints, &results);
+    if (result != 0 || results == nullptr) {
+      callback_module->PushCall([callback] { callback(false, SockAddr()); });
+      return;
+    }
+
+    // Prefer ipv4 results when both families come back; that matches
+    // the bias of our existing socket setup.
+    addrinfo* best{};
+    for (addrinfo* i = results; i != nullptr; i = i->ai_next) {
+      if (i->ai_family == AF_INET || i->ai_family == AF_INET6) {
+        if (best == nullptr || (best->ai_family == AF_INET6
+                                && i->ai_family == AF_INET)) {
+          best = i;
+        }
+      }
+    }
+    if (best == nullptr) {
+      freeaddrinfo(results);
+      callback_module->PushCall([callback] { callback(false, SockAddr()); });
+      return;
+    }
+    sockaddr_storage ss{};
+    memcpy(&ss, best->ai_addr, best->ai_addrlen);
+    freeaddrinfo(results);
+    SockAddr addr(ss);
+    callback_module->PushCall([callback, addr] { callback(true, addr); });
+  });
+}
+
+void NetworkWriteModule::DoFlush() {
+  bool ledger = FrameLedger::enabled();
+  int64_t ledger_start = ledger ? Platform::GetCurrentMicroseconds() : 0;
+
+  std::vector<GatherEntry> entries;
+  {
+    std::lock_guard<std::mutex> lock(gather_mutex_);
+    entries.swap(gather_);
+    flush_pending_ = false;
+  }
+  if (entries.empty()) {
+    return;
+  }
+
+#if BA_OSTYPE_LINUX
+  // Group by socket (ipv4/ipv6) and hand each group to the kernel in
+  // one sendmmsg() call.
+  std::lock_guard<std::mutex> lock(g_network_reader->sd_mutex());
+  for (int pass = 0; pass < 2; pass++) {
+    bool v6 = (pass == 1);
+    int sd = v6 ? g_network_reader->sd6() : g_network_reader->sd4();
+    if (sd == -1) {
+      // Socket is down (paused/shutting-down); drop these like the
+      // per-packet path would.
+      continue;
+    }
+    std::vector<mmsghdr> msgs;
+    std::vector<iovec> iovs;
+    msgs.reserve(entries.size());
+    iovs.reserve(entries.size());
+    for (auto& entry : entries) {
+      if (entry.addr.IsV6() != v6) {
+        continue;
+      }
+      iovec iov{};
+      iov.iov_base = entry.data.data();
+      iov.iov_len = entry.data.size();
+      iovs.push_back(iov);
+      mmsghdr msg{};
+      msg.msg_hdr.msg_name =
+          const_cast<sockaddr*>(entry.addr.GetSockAddr());
+      msg.msg_hdr.msg_namelen = entry.addr.GetSockAddrLen();
+      msgs.push_back(msg);
+    }
+    for (size_t i = 0; i < msgs.size(); i++) {
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    size_t sent = 0;
+    while (sent < msgs.size()) {
+      auto count = static_cast<unsigned int>(msgs.size() - sent);
+      int result =
+          static_cast<int>(sendmmsg(sd, msgs.data() + sent, count, 0));
+      if (result <= 0) {
+        // Same non-response to errors as the per-packet path; UDP sends
+        // can fail for all sorts of transient reasons.
+        break;
+      }
+      sent += static_cast<size_t>(result);
+    }
+  }
+#else
+  // No batched syscall available; send them out one at a time.
+  for (auto& entry : entries) {
+    Networking::SendTo(entry.data, entry.addr);
+  }
+#endif
+
+  if (ledger) {
+    FrameLedger::Add(FrameLedger::Lane::kNet,
+                     Platform::GetCurrentMicroseconds() - ledger_start);
+  }
+}
+
+}  // namespace ballistica
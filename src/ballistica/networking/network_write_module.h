@@ -3,9 +3,13 @@
 #ifndef BALLISTICA_NETWORKING_NETWORK_WRITE_MODULE_H_
 #define BALLISTICA_NETWORKING_NETWORK_WRITE_MODULE_H_
 
+#include <functional>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "ballistica/core/module.h"
+#include "ballistica/networking/sockaddr.h"
 
 namespace ballistica {
 
@@ -13,7 +17,38 @@ namespace ballistica {
 class NetworkWriteModule : public Module {
  public:
   void PushSendToCall(const std::vector<uint8_t>& msg, const SockAddr& addr);
+
+  // Invoked with the result of an async hostname resolution; addr is
+  // only meaningful when success is true.
+  typedef std::function<void(bool success, SockAddr addr)> ResolveCallback;
+
+  // Resolve a hostname on our thread and deliver the result to
+  // callback_module via a pushed call, so blocking getaddrinfo() lookups
+  // (which can take seconds on flaky DNS) never run on the game thread.
+  void PushResolveCall(const std::string& hostname, int port,
+                       Module* callback_module, ResolveCallback callback);
+
   explicit NetworkWriteModule(Thread* thread);
+
+ private:
+  struct GatherEntry {
+    std::vector<uint8_t> data;
+    SockAddr addr;
+  };
+
+  // Send out everything accumulated in our gather list. On Linux this
+  // goes out as a single sendmmsg() syscall per socket; elsewhere it
+  // falls back to one sendto() per packet.
+  void DoFlush();
+
+  // Outgoing (payload, addr) pairs accumulated since the last flush.
+  // Callers in other threads append here under the mutex; a single
+  // queued flush call drains the whole list at once, so a burst of
+  // packets (a server tick's worth of client state, say) costs one
+  // cross-thread call and one syscall instead of one per packet.
+  std::mutex gather_mutex_;
+  std::vector<GatherEntry> gather_;
+  bool flush_pending_{};
 };
 
 }  // namespace ballistica
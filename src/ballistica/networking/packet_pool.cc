@@ -0,0 +1,30 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/networking/packet_pool.h"
+
+namespace ballistica {
+
+std::mutex PacketPool::mutex_;
+std::vector<std::vector<uint8_t> > PacketPool::buffers_;
+
+auto PacketPool::AcquireBuffer() -> std::vector<uint8_t> {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!buffers_.empty()) {
+      std::vector<uint8_t> buffer(std::move(buffers_.back()));
+      buffers_.pop_back();
+      buffer.resize(kMaxPacketSize);
+      return buffer;
+    }
+  }
+  return std::vector<uint8_t>(kMaxPacketSize);
+}
+
+auto PacketPool::ReleaseBuffer(std::vector<uint8_t> buffer) -> void {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (buffers_.size() < kMaxPooledBuffers) {
+    buffers_.push_back(std::move(buffer));
+  }
+}
+
+}  // namespace ballistica
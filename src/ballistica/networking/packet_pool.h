@@ -0,0 +1,43 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_NETWORKING_PACKET_POOL_H_
+#define BALLISTICA_NETWORKING_PACKET_POOL_H_
+
+#include <mutex>
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// A small thread-safe pool of packet payload buffers.
+// The network-reader thread fills one of these directly from recvfrom()
+// and then moves it through the packet-handling chain (cross-thread call
+// into the game thread, connection layer, huffman decompress) so the
+// payload bytes are never copied along the way; whoever ends up with the
+// buffer returns it here when done so its allocation can be reused for a
+// future packet.
+class PacketPool {
+ public:
+  // Grab a buffer sized for a max-size packet. The buffer arrives with
+  // size() == kMaxPacketSize; callers should resize() down to the actual
+  // payload length after filling it.
+  static auto AcquireBuffer() -> std::vector<uint8_t>;
+
+  // Return a buffer to the pool. The buffer's contents are irrelevant;
+  // only its allocation is recycled. Buffers beyond our depth limit are
+  // simply dropped (freed).
+  static auto ReleaseBuffer(std::vector<uint8_t> buffer) -> void;
+
+ private:
+  // How many idle buffers we keep around. Enough to cover packets
+  // in-flight between the network-reader and game threads during a busy
+  // server tick without holding memory forever.
+  static const int kMaxPooledBuffers = 64;
+  static std::mutex mutex_;
+  static std::vector<std::vector<uint8_t> > buffers_;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_NETWORKING_PACKET_POOL_H_
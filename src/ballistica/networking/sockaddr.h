@@ -46,6 +46,25 @@ class SockAddr {
     }
   }
 
+  auto Port() const -> int {
+    switch (addr_.ss_family) {
+      case AF_INET:
+        return ntohs(
+            reinterpret_cast<const sockaddr_in*>(&addr_)->sin_port);
+      case AF_INET6:
+        return ntohs(
+            reinterpret_cast<const sockaddr_in6*>(&addr_)->sin6_port);
+      default:
+        throw Exception();
+    }
+  }
+
+  auto IsLoopbackV4() const -> bool {
+    return addr_.ss_family == AF_INET
+           && reinterpret_cast<const sockaddr_in*>(&addr_)->sin_addr.s_addr
+                  == htonl(INADDR_LOOPBACK);
+  }
+
  private:
   sockaddr_storage addr_{};
 };
@@ -0,0 +1,223 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/networking/socket_event_loop.h"
+
+#include <fcntl.h>
+
+#include "ballistica/networking/networking_sys.h"
+
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+#include <sys/epoll.h>
+#elif BA_OSTYPE_MACOS || BA_OSTYPE_IOS_TVOS
+#include <sys/event.h>
+#endif
+
+namespace ballistica {
+
+SocketEventLoop::SocketEventLoop() {
+#if BA_OSTYPE_WINDOWS
+  // No pipe() there; a wakeup would need a loopback socket pair. Nothing
+  // uses this on windows builds yet.
+#error SocketEventLoop is posix-only for now.
+#else
+  if (pipe(wake_fds_) != 0) {
+    Log("Error: SocketEventLoop unable to create wake pipe; errno "
+        + std::to_string(errno));
+  }
+  // Non-blocking on both ends: a full pipe just means a wake is already
+  // pending, and drains mustn't block once the pipe runs dry.
+  for (int fd : wake_fds_) {
+    if (fd != -1) {
+      fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    }
+  }
+#endif
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+  epoll_fd_ = epoll_create1(0);
+  if (epoll_fd_ < 0) {
+    Log("Error: SocketEventLoop epoll_create1 failed; errno "
+        + std::to_string(errno));
+  }
+  epoll_event ev{};
+  ev.events = EPOLLIN;
+  ev.data.fd = wake_fds_[0];
+  epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fds_[0], &ev);
+#elif BA_OSTYPE_MACOS || BA_OSTYPE_IOS_TVOS
+  kqueue_fd_ = kqueue();
+  if (kqueue_fd_ < 0) {
+    Log("Error: SocketEventLoop kqueue failed; errno "
+        + std::to_string(errno));
+  }
+  struct kevent ev {};
+  EV_SET(&ev, wake_fds_[0], EVFILT_READ, EV_ADD, 0, 0, nullptr);
+  kevent(kqueue_fd_, &ev, 1, nullptr, 0, nullptr);
+#endif
+  thread_ = new std::thread(RunThreadStatic, this);
+}
+
+SocketEventLoop::~SocketEventLoop() {
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    done_ = true;
+  }
+  Wake();
+  thread_->join();
+  delete thread_;
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+  if (epoll_fd_ != -1) {
+    close(epoll_fd_);
+  }
+#elif BA_OSTYPE_MACOS || BA_OSTYPE_IOS_TVOS
+  if (kqueue_fd_ != -1) {
+    close(kqueue_fd_);
+  }
+#endif
+  for (int fd : wake_fds_) {
+    if (fd != -1) {
+      close(fd);
+    }
+  }
+}
+
+void SocketEventLoop::AddSocket(int sd, ReadCallback callback) {
+  assert(sd >= 0);
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    PendingOp op;
+    op.sd = sd;
+    op.add = true;
+    op.callback = std::move(callback);
+    pending_ops_.push_back(std::move(op));
+  }
+  Wake();
+}
+
+void SocketEventLoop::RemoveSocket(int sd) {
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    PendingOp op;
+    op.sd = sd;
+    op.add = false;
+    pending_ops_.push_back(std::move(op));
+  }
+  Wake();
+}
+
+void SocketEventLoop::Wake() {
+  char byte = 0;
+  if (wake_fds_[1] != -1) {
+    if (write(wake_fds_[1], &byte, 1) != 1) {
+      // Pipe full just means a wake is already pending; fine.
+    }
+  }
+}
+
+void SocketEventLoop::ApplyPendingOps() {
+  std::vector<PendingOp> ops;
+  {
+    std::lock_guard<std::mutex> lock(pending_mutex_);
+    ops.swap(pending_ops_);
+  }
+  for (auto&& op : ops) {
+    if (op.add) {
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+      epoll_event ev{};
+      ev.events = EPOLLIN;
+      ev.data.fd = op.sd;
+      epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, op.sd, &ev);
+#elif BA_OSTYPE_MACOS || BA_OSTYPE_IOS_TVOS
+      struct kevent ev {};
+      EV_SET(&ev, op.sd, EVFILT_READ, EV_ADD, 0, 0, nullptr);
+      kevent(kqueue_fd_, &ev, 1, nullptr, 0, nullptr);
+#endif
+      callbacks_[op.sd] = std::move(op.callback);
+    } else {
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, op.sd, nullptr);
+#elif BA_OSTYPE_MACOS || BA_OSTYPE_IOS_TVOS
+      struct kevent ev {};
+      EV_SET(&ev, op.sd, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+      kevent(kqueue_fd_, &ev, 1, nullptr, 0, nullptr);
+#endif
+      callbacks_.erase(op.sd);
+    }
+  }
+}
+
+void SocketEventLoop::RunThread() {
+  while (true) {
+    ApplyPendingOps();
+    {
+      std::lock_guard<std::mutex> lock(pending_mutex_);
+      if (done_) {
+        break;
+      }
+    }
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+    epoll_event events[16];
+    int count = epoll_wait(epoll_fd_, events, 16, -1);
+    for (int i = 0; i < count; i++) {
+      int fd = events[i].data.fd;
+      if (fd == wake_fds_[0]) {
+        char drain[64];
+        while (read(wake_fds_[0], drain, sizeof(drain)) == sizeof(drain)) {
+        }
+        continue;
+      }
+      auto it = callbacks_.find(fd);
+      if (it != callbacks_.end()) {
+        it->second(fd);
+      }
+    }
+#elif BA_OSTYPE_MACOS || BA_OSTYPE_IOS_TVOS
+    struct kevent events[16];
+    int count = kevent(kqueue_fd_, nullptr, 0, events, 16, nullptr);
+    for (int i = 0; i < count; i++) {
+      int fd = static_cast<int>(events[i].ident);
+      if (fd == wake_fds_[0]) {
+        char drain[64];
+        while (read(wake_fds_[0], drain, sizeof(drain)) == sizeof(drain)) {
+        }
+        continue;
+      }
+      auto it = callbacks_.find(fd);
+      if (it != callbacks_.end()) {
+        it->second(fd);
+      }
+    }
+#else
+    // Generic select() fallback.
+    fd_set read_set;
+    FD_ZERO(&read_set);
+    FD_SET(wake_fds_[0], &read_set);
+    int max_fd = wake_fds_[0];
+    for (auto&& entry : callbacks_) {
+      FD_SET(entry.first, &read_set);
+      if (entry.first > max_fd) {
+        max_fd = entry.first;
+      }
+    }
+    int count = select(max_fd + 1, &read_set, nullptr, nullptr, nullptr);
+    if (count <= 0) {
+      continue;
+    }
+    if (FD_ISSET(wake_fds_[0], &read_set)) {
+      char drain[64];
+      while (read(wake_fds_[0], drain, sizeof(drain)) == sizeof(drain)) {
+      }
+    }
+    // (iterate over a copy; callbacks may add/remove sockets)
+    std::vector<std::pair<int, ReadCallback> > ready;
+    for (auto&& entry : callbacks_) {
+      if (FD_ISSET(entry.first, &read_set)) {
+        ready.push_back(entry);
+      }
+    }
+    for (auto&& entry : ready) {
+      entry.second(entry.first);
+    }
+#endif
+  }
+}
+
+}  // namespace ballistica
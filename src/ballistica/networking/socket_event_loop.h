@@ -0,0 +1,67 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_NETWORKING_SOCKET_EVENT_LOOP_H_
+#define BALLISTICA_NETWORKING_SOCKET_EVENT_LOOP_H_
+
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// An event-driven network front end: one service thread watching any
+// number of sockets for read-readiness and invoking callbacks as data
+// arrives. Uses epoll on Linux/Android and kqueue on Apple platforms,
+// falling back to select() elsewhere, so idle sockets cost zero wakeups
+// and the game UDP sockets, telnet listener, and anything added later
+// can all share one thread instead of each parking a blocking thread of
+// their own.
+class SocketEventLoop {
+ public:
+  // Called on the service thread when the socket is read-ready; the
+  // callback should drain it without blocking.
+  typedef std::function<void(int)> ReadCallback;
+
+  SocketEventLoop();
+  ~SocketEventLoop();
+
+  // Thread-safe; take effect before the next wait.
+  void AddSocket(int sd, ReadCallback callback);
+  void RemoveSocket(int sd);
+
+ private:
+  void RunThread();
+  static auto RunThreadStatic(void* self) -> int {
+    static_cast<SocketEventLoop*>(self)->RunThread();
+    return 0;
+  }
+  void ApplyPendingOps();
+  void Wake();
+
+  struct PendingOp {
+    int sd{};
+    bool add{};
+    ReadCallback callback;
+  };
+
+  std::thread* thread_{};
+  std::mutex pending_mutex_;
+  std::vector<PendingOp> pending_ops_;
+  std::unordered_map<int, ReadCallback> callbacks_;
+  // Self-pipe used to interrupt waits for add/remove/shutdown.
+  int wake_fds_[2]{-1, -1};
+  bool done_{};
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+  int epoll_fd_{-1};
+#elif BA_OSTYPE_MACOS || BA_OSTYPE_IOS_TVOS
+  int kqueue_fd_{-1};
+#endif
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_NETWORKING_SOCKET_EVENT_LOOP_H_
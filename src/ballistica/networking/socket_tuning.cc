@@ -0,0 +1,139 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/networking/socket_tuning.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "ballistica/networking/networking_sys.h"
+
+namespace ballistica {
+
+// Defaults when the env vars are unset. A meg of receive buffer rides
+// out multi-client bursts without being noticeable memory-wise even at
+// dozens of instances per box.
+const int kDefaultUDPReceiveBufferSize = 1024 * 1024;
+const int kDefaultUDPSendBufferSize = 512 * 1024;
+
+static auto GetEnvInt(const char* name, int default_val) -> int {
+  const char* val = getenv(name);
+  if (val == nullptr || val[0] == 0) {
+    return default_val;
+  }
+  return atoi(val);
+}
+
+static void SetBufferSize(int sd, int opt, const char* opt_name, int size) {
+  if (size <= 0) {
+    return;
+  }
+  setsockopt(sd, SOL_SOCKET, opt, reinterpret_cast<const char*>(&size),
+             sizeof(size));
+
+  // The kernel silently clamps to its configured max (net.core.rmem_max
+  // and friends on linux); make that visible since fleet operators
+  // asking for big buffers generally mean it.
+  int actual{};
+  socklen_t actual_size{sizeof(actual)};
+  if (getsockopt(sd, SOL_SOCKET, opt, reinterpret_cast<char*>(&actual),
+                 &actual_size)
+          == 0
+      && actual < size) {
+    BA_LOG_ONCE("Requested " + std::to_string(size) + " byte " + opt_name
+                + " but kernel allowed " + std::to_string(actual)
+                + "; raise the system socket buffer limits to use more.");
+  }
+}
+
+void SocketTuning::TuneUDPSocket(int sd) {
+  SetBufferSize(sd, SO_RCVBUF, "SO_RCVBUF",
+                GetEnvInt("BA_NET_RCVBUF", kDefaultUDPReceiveBufferSize));
+  SetBufferSize(sd, SO_SNDBUF, "SO_SNDBUF",
+                GetEnvInt("BA_NET_SNDBUF", kDefaultUDPSendBufferSize));
+}
+
+auto SocketTuning::EnableReusePort(int sd) -> bool {
+#ifdef SO_REUSEPORT
+  int on{1};
+  return (setsockopt(sd, SOL_SOCKET, SO_REUSEPORT,
+                     reinterpret_cast<const char*>(&on), sizeof(on))
+          == 0);
+#else
+  return false;
+#endif
+}
+
+auto SocketTuning::ReaderShardCount() -> int {
+  int count = GetEnvInt("BA_NET_SHARDS", 1);
+  if (count < 1) {
+    count = 1;
+  }
+  // More shards than cores just adds wakeups.
+  if (count > 16) {
+    count = 16;
+  }
+#ifndef SO_REUSEPORT
+  if (count > 1) {
+    BA_LOG_ONCE(
+        "BA_NET_SHARDS set but SO_REUSEPORT is unavailable here;"
+        " running a single reader socket.");
+    count = 1;
+  }
+#endif
+  return count;
+}
+
+auto SocketTuning::GetUDPDropCount() -> int64_t {
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+  // /proc/net/snmp carries a header line naming the udp fields followed
+  // by a line of values; InErrors counts receives dropped for lack of
+  // buffer space (among other local errors).
+  FILE* f = fopen("/proc/net/snmp", "r");
+  if (f == nullptr) {
+    return -1;
+  }
+  char header[512];
+  char values[512];
+  int64_t result{-1};
+  while (fgets(header, sizeof(header), f)) {
+    if (strncmp(header, "Udp:", 4) != 0) {
+      continue;
+    }
+    if (fgets(values, sizeof(values), f) == nullptr) {
+      break;
+    }
+    // Find which column InErrors is, then pull that token from the
+    // values line.
+    int column{};
+    bool found{};
+    for (char* tok = strtok(header, " \n"); tok != nullptr;
+         tok = strtok(nullptr, " \n")) {
+      if (strcmp(tok, "InErrors") == 0) {
+        found = true;
+        break;
+      }
+      column++;
+    }
+    if (!found) {
+      break;
+    }
+    int i{};
+    for (char* tok = strtok(values, " \n"); tok != nullptr;
+         tok = strtok(nullptr, " \n")) {
+      if (i == column) {
+        result = strtoll(tok, nullptr, 10);
+        break;
+      }
+      i++;
+    }
+    break;
+  }
+  fclose(f);
+  return result;
+#else
+  return -1;
+#endif
+}
+
+}  // namespace ballistica
@@ -0,0 +1,42 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_NETWORKING_SOCKET_TUNING_H_
+#define BALLISTICA_NETWORKING_SOCKET_TUNING_H_
+
+#include "ballistica/ballistica.h"
+
+namespace ballistica {
+
+// Socket-level tuning knobs for server fleets. Server boxes running
+// dozens of headless instances configure these per-instance through env
+// vars (same pattern as BA_CPU_AFFINITY); defaults are tuned for normal
+// client play. Plain static helpers so anything owning a game socket
+// (the network-reader, scanners, etc) can share them.
+class SocketTuning {
+ public:
+  // Apply SO_RCVBUF/SO_SNDBUF sizes to a game udp socket, from the
+  // BA_NET_RCVBUF/BA_NET_SNDBUF env vars (bytes) when set. Bigger
+  // receive buffers are the difference between riding out a packet
+  // burst and dropping (which shows up as resend traffic).
+  static void TuneUDPSocket(int sd);
+
+  // Ask for SO_REUSEPORT so several reader sockets can shard one port
+  // by flow hash. Must be called before bind(); returns whether the
+  // option took (not every platform has it).
+  static auto EnableReusePort(int sd) -> bool;
+
+  // How many reader sockets a port should be sharded across (the
+  // BA_NET_SHARDS env var; for proxy-fronted fleet configs where one
+  // process sees many flows). Always 1 where SO_REUSEPORT is
+  // unavailable or the var is unset.
+  static auto ReaderShardCount() -> int;
+
+  // Process-wide udp receive drops as reported by the kernel; -1 where
+  // unsupported. Fleet monitoring samples this and watches deltas to
+  // tell buffer-exhaustion drops from network loss.
+  static auto GetUDPDropCount() -> int64_t;
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_NETWORKING_SOCKET_TUNING_H_
@@ -3,11 +3,21 @@
 #include "ballistica/networking/telnet_server.h"
 
 #include <string>
+#include <vector>
 
 #include "ballistica/app/app_globals.h"
 #include "ballistica/ballistica.h"
+#include "ballistica/core/alloc_tracker.h"
 #include "ballistica/core/context.h"
+#include "ballistica/core/profiler.h"
+#include "ballistica/game/connection/connection_set.h"
+#include "ballistica/game/connection/connection_to_client.h"
 #include "ballistica/game/game.h"
+#include "ballistica/graphics/frame_ledger.h"
+#include "ballistica/graphics/graphics.h"
+#include "ballistica/graphics/graphics_server.h"
+#include "ballistica/input/input_latency_meter.h"
+#include "ballistica/media/media.h"
 #include "ballistica/networking/networking.h"
 #include "ballistica/networking/networking_sys.h"
 #include "ballistica/platform/platform.h"
@@ -141,6 +151,17 @@ auto TelnetServer::RunThread() -> int {
               if (result > 1 && (buffer[result - 2] == '\r'))
                 buffer[result - 2] = 0;
             }
+            // A line ending in a tab is a completion request (works for
+            // the perf namespace); echo matches and re-show the line.
+            size_t line_len = strlen(buffer);
+            if (line_len > 0 && buffer[line_len - 1] == '\t'
+                && user_has_granted_access_ && !reading_password_) {
+              buffer[line_len - 1] = 0;
+              if (g_game) {
+                PushPrint(GetPerfCompletions(buffer) + prompt + buffer);
+              }
+              continue;
+            }
             if (g_game) {
               if (user_has_granted_access_) {
                 if (reading_password_) {
@@ -185,6 +206,14 @@ void TelnetServer::PushTelnetScriptCommand(const std::string& command) {
     return;
   }
   g_game->PushCall([this, command] {
+    // The structured perf namespace gets handled natively; everything
+    // else goes to Python as always.
+    if (command == "perf" || command.rfind("perf ", 0) == 0) {
+      Print(HandlePerfCommand(command));
+      Print("ballisticacore> ");
+      return;
+    }
+
     // These are always run in whichever context is 'visible'.
     ScopedSetContext cp(g_game->GetForegroundContext());
     if (!g_app_globals->user_ran_commands) {
@@ -210,6 +239,302 @@ void TelnetServer::PushTelnetScriptCommand(const std::string& command) {
   });
 }
 
+// Counter names as shown by 'perf list' (kept static so completion can
+// run off-thread).
+static const char* kPerfCounterNames[] = {
+    "ledger.step.total_us",   "ledger.fbuild.total_us",
+    "ledger.render.total_us", "ledger.audio.total_us",
+    "ledger.bgdyn.total_us",  "ledger.net.total_us",
+    "conn.clients",           "conn.bytes_out_per_sec",
+    "conn.bytes_in_per_sec",  "conn.resend_bytes_per_sec",
+    "conn.avg_ping_ms",       "media.total_bytes",
+    "effect.lod",             "effect.governor_enabled",
+    "latency.i2p_count",      "latency.i2p_avg_ms",
+    "latency.i2p_p99_ms",     "gfx.queue_depth",
+    "gfx.queue_dequeues",     "gfx.queue_occ_total",
+    "gfx.queue_occ_max",      "time.real_ms",
+};
+
+static const char* kPerfVerbs[] = {
+    "counters", "flight",  "get",   "governor", "help",
+    "list",     "memreport", "trace", "trim",
+};
+
+// Gather every counter as name/value pairs (game thread).
+static auto GatherPerfCounters()
+    -> std::vector<std::pair<std::string, std::string>> {
+  assert(InGameThread());
+  std::vector<std::pair<std::string, std::string>> counters;
+  int64_t lanes[FrameLedger::kLaneCount];
+  FrameLedger::GetTotals(lanes);
+  for (int i = 0; i < FrameLedger::kLaneCount; i++) {
+    counters.emplace_back(
+        std::string("ledger.")
+            + FrameLedger::LaneName(static_cast<FrameLedger::Lane>(i))
+            + ".total_us",
+        std::to_string(lanes[i]));
+  }
+  int64_t bytes_out{};
+  int64_t bytes_in{};
+  int64_t resend_bytes{};
+  float ping_total{};
+  int client_count{};
+  for (auto&& c : g_game->connections()->GetConnectionsToClients()) {
+    bytes_out += c->GetBytesOutPerSecond();
+    bytes_in += c->GetBytesInPerSecond();
+    resend_bytes += c->GetBytesResentPerSecond();
+    ping_total += c->average_ping();
+    client_count++;
+  }
+  counters.emplace_back("conn.clients", std::to_string(client_count));
+  counters.emplace_back("conn.bytes_out_per_sec", std::to_string(bytes_out));
+  counters.emplace_back("conn.bytes_in_per_sec", std::to_string(bytes_in));
+  counters.emplace_back("conn.resend_bytes_per_sec",
+                        std::to_string(resend_bytes));
+  counters.emplace_back(
+      "conn.avg_ping_ms",
+      std::to_string(client_count > 0 ? ping_total / client_count : 0.0f));
+  counters.emplace_back("media.total_bytes",
+                        std::to_string(g_media->GetTotalMediaMemoryUse()));
+  counters.emplace_back("effect.lod", std::to_string(g_graphics->effect_lod()));
+  counters.emplace_back(
+      "effect.governor_enabled",
+      g_graphics->effect_governor_enabled() ? "1" : "0");
+  counters.emplace_back("latency.i2p_count",
+                        std::to_string(InputLatencyMeter::SampleCount()));
+  counters.emplace_back(
+      "latency.i2p_avg_ms",
+      std::to_string(0.001
+                     * static_cast<double>(InputLatencyMeter::AverageUsecs())));
+  counters.emplace_back(
+      "latency.i2p_p99_ms",
+      std::to_string(
+          0.001 * static_cast<double>(InputLatencyMeter::PercentileUsecs(99))));
+  if (g_graphics_server) {
+    counters.emplace_back(
+        "gfx.queue_depth",
+        std::to_string(g_graphics_server->frame_queue_depth()));
+    counters.emplace_back(
+        "gfx.queue_dequeues",
+        std::to_string(g_graphics_server->frame_queue_dequeues()));
+    counters.emplace_back(
+        "gfx.queue_occ_total",
+        std::to_string(g_graphics_server->frame_queue_occupancy_total()));
+    counters.emplace_back(
+        "gfx.queue_occ_max",
+        std::to_string(g_graphics_server->frame_queue_occupancy_max()));
+  }
+  if (AllocTracker::enabled()) {
+    for (int i = 0; i < AllocTracker::kTagCount; i++) {
+      auto tag = static_cast<AllocTracker::Tag>(i);
+      counters.emplace_back(
+          std::string("mem.") + AllocTracker::TagName(tag) + ".bytes",
+          std::to_string(AllocTracker::Bytes(tag)));
+      counters.emplace_back(
+          std::string("mem.") + AllocTracker::TagName(tag) + ".count",
+          std::to_string(AllocTracker::Count(tag)));
+    }
+  }
+  counters.emplace_back("time.real_ms", std::to_string(GetRealTime()));
+  return counters;
+}
+
+auto TelnetServer::HandlePerfCommand(const std::string& command)
+    -> std::string {
+  assert(InGameThread());
+
+  // Tokenize (whitespace-separated).
+  std::vector<std::string> args;
+  std::string token;
+  for (char c : command) {
+    if (c == ' ' || c == '\t') {
+      if (!token.empty()) {
+        args.push_back(token);
+        token.clear();
+      }
+    } else {
+      token += c;
+    }
+  }
+  if (!token.empty()) {
+    args.push_back(token);
+  }
+
+  std::string verb = args.size() > 1 ? args[1] : "help";
+  if (verb == "counters") {
+    std::string out;
+    for (auto&& c : GatherPerfCounters()) {
+      out += c.first + " " + c.second + "\n";
+    }
+    return out;
+  }
+  if (verb == "get") {
+    if (args.size() < 3) {
+      return "usage: perf get <counter>\n";
+    }
+    for (auto&& c : GatherPerfCounters()) {
+      if (c.first == args[2]) {
+        return c.second + "\n";
+      }
+    }
+    return "unknown counter: " + args[2] + "\n";
+  }
+  if (verb == "list") {
+    std::string out;
+    for (auto&& c : GatherPerfCounters()) {
+      out += c.first + "\n";
+    }
+    return out;
+  }
+  if (verb == "trace") {
+    if (args.size() >= 3 && args[2] == "start") {
+      std::string path = args.size() >= 4
+                             ? args[3]
+                             : g_platform->GetConfigDirectory()
+                                   + BA_DIRSLASH + "ballistica_trace.json";
+      return FrameLedger::StartTrace(path)
+                 ? "trace capture started: " + path + "\n"
+                 : "trace already running.\n";
+    }
+    if (args.size() >= 3 && args[2] == "stop") {
+      std::string path = FrameLedger::StopTrace();
+      return path.empty() ? "no trace running (or write failed).\n"
+                          : "trace written: " + path + "\n";
+    }
+    return "usage: perf trace start [path] | perf trace stop\n";
+  }
+  if (verb == "profile") {
+    if (args.size() >= 3 && args[2] == "start") {
+      std::string path = args.size() >= 4
+                             ? args[3]
+                             : g_platform->GetConfigDirectory()
+                                   + BA_DIRSLASH + "ballistica_profile.json";
+      return Profiler::StartCapture(path)
+                 ? "profile capture started: " + path + "\n"
+                 : "profile capture already running.\n";
+    }
+    if (args.size() >= 3 && args[2] == "stop") {
+      std::string path = Profiler::StopCapture();
+      return path.empty() ? "no profile capture running (or write failed).\n"
+                          : "profile written: " + path + "\n";
+    }
+    return "usage: perf profile start [path] | perf profile stop\n";
+  }
+  if (verb == "flight") {
+    if (args.size() >= 3 && args[2] == "arm") {
+      int threshold_ms = args.size() >= 4 ? atoi(args[3].c_str()) : 50;
+      int window_ms = args.size() >= 5 ? atoi(args[4].c_str()) : 500;
+      if (threshold_ms <= 0 || window_ms <= 0) {
+        return "invalid threshold/window.\n";
+      }
+      std::string prefix =
+          g_platform->GetConfigDirectory() + BA_DIRSLASH + "ballistica_flight";
+      return FrameLedger::ArmFlightRecorder(prefix, threshold_ms, window_ms)
+                 ? "flight recorder armed (threshold "
+                       + std::to_string(threshold_ms) + "ms, window "
+                       + std::to_string(window_ms) + "ms); captures land at "
+                       + prefix + "_spikeN.json\n"
+                 : "flight recorder already armed.\n";
+    }
+    if (args.size() >= 3 && args[2] == "disarm") {
+      FrameLedger::DisarmFlightRecorder();
+      return "flight recorder disarmed.\n";
+    }
+    return "usage: perf flight arm [threshold_ms] [window_ms] "
+           "| perf flight disarm\n";
+  }
+  if (verb == "memreport") {
+    return g_media->GetSceneMemoryReport() + "\n";
+  }
+  if (verb == "trim") {
+    // Same staged trim the memory-pressure path uses.
+    g_media->Prune(3);
+    g_media->TrimMediaMemory(0);
+    return "media trim triggered.\n";
+  }
+  if (verb == "governor") {
+    if (args.size() >= 3 && (args[2] == "on" || args[2] == "off")) {
+      g_graphics->set_effect_governor_enabled(args[2] == "on");
+      return "effect governor " + args[2] + ".\n";
+    }
+    return "usage: perf governor on|off\n";
+  }
+  return std::string("perf commands:\n")
+         + "  perf counters            dump all counters (name value)\n"
+         + "  perf get <counter>       read one counter\n"
+         + "  perf list                list counter names\n"
+         + "  perf trace start [path]  begin chrome-trace capture\n"
+         + "  perf trace stop          end capture and write the file\n"
+         + "  perf profile start [path]  begin scoped-profiler capture\n"
+         + "  perf profile stop        end capture and write the file\n"
+         + "  perf flight arm [ms] [ms]  arm spike capture (threshold,"
+         " window)\n"
+         + "  perf flight disarm       disarm spike capture\n"
+         + "  perf memreport           dump scene/media memory json\n"
+         + "  perf trim                trigger a media trim\n"
+         + "  perf governor on|off     toggle the effect-lod governor\n";
+}
+
+auto TelnetServer::GetPerfCompletions(const std::string& line) -> std::string {
+  // Complete the token being typed from whichever static table applies
+  // to its position ('perf <verb> <counter...>').
+  std::vector<std::string> args;
+  std::string token;
+  for (char c : line) {
+    if (c == ' ') {
+      if (!token.empty()) {
+        args.push_back(token);
+        token.clear();
+      }
+    } else {
+      token += c;
+    }
+  }
+  bool mid_token = !token.empty();
+  if (mid_token) {
+    args.push_back(token);
+  }
+  std::string out;
+  if (args.empty() || (args.size() == 1 && mid_token)) {
+    std::string prefix = args.empty() ? "" : args[0];
+    if (std::string("perf").rfind(prefix, 0) == 0) {
+      out += "perf\n";
+    }
+    return out;
+  }
+  if (args[0] != "perf") {
+    return out;
+  }
+  size_t arg_index = args.size() - (mid_token ? 1 : 0);
+  std::string prefix = mid_token ? args.back() : "";
+  if (arg_index == 1) {
+    for (auto&& verb : kPerfVerbs) {
+      if (std::string(verb).rfind(prefix, 0) == 0) {
+        out += std::string(verb) + "\n";
+      }
+    }
+  } else if (arg_index == 2 && args[1] == "get") {
+    for (auto&& name : kPerfCounterNames) {
+      if (std::string(name).rfind(prefix, 0) == 0) {
+        out += std::string(name) + "\n";
+      }
+    }
+  } else if (arg_index == 2 && args[1] == "trace") {
+    for (const char* sub : {"start", "stop"}) {
+      if (std::string(sub).rfind(prefix, 0) == 0) {
+        out += std::string(sub) + "\n";
+      }
+    }
+  } else if (arg_index == 2 && args[1] == "governor") {
+    for (const char* sub : {"on", "off"}) {
+      if (std::string(sub).rfind(prefix, 0) == 0) {
+        out += std::string(sub) + "\n";
+      }
+    }
+  }
+  return out;
+}
+
 void TelnetServer::PushPrint(const std::string& s) {
   assert(g_game);
   g_game->PushCall([this, s] { Print(s); });
@@ -26,6 +26,14 @@ class TelnetServer {
  private:
   auto RunThread() -> int;
   auto Print(const std::string& s) -> void;
+
+  // Structured perf namespace (counters + control verbs); runs in the
+  // game thread, returns the text to send back.
+  auto HandlePerfCommand(const std::string& command) -> std::string;
+
+  // Best-effort tab completion for the perf namespace (any thread;
+  // works from static name tables only).
+  static auto GetPerfCompletions(const std::string& line) -> std::string;
   static auto RunThreadStatic(void* self) -> int {
     return static_cast<TelnetServer*>(self)->RunThread();
   }
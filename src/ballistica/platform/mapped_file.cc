@@ -0,0 +1,87 @@
+// Released under the MIT License. See LICENSE for details.
+
+#include "ballistica/platform/mapped_file.h"
+
+#include <algorithm>
+
+#if !BA_OSTYPE_WINDOWS
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ballistica {
+
+auto MappedFile::Map(const std::string& path) -> std::unique_ptr<MappedFile> {
+#if BA_OSTYPE_WINDOWS
+  // No mapping path here yet; windows callers fall back to reads.
+  return nullptr;
+#else
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat stats {};
+  if (fstat(fd, &stats) != 0 || stats.st_size <= 0) {
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(stats.st_size);
+  void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // The mapping keeps its own reference to the file.
+  close(fd);
+  if (mapping == MAP_FAILED) {
+    return nullptr;
+  }
+  std::unique_ptr<MappedFile> f(new MappedFile());
+  f->data_ = static_cast<const uint8_t*>(mapping);
+  f->size_ = size;
+  return f;
+#endif  // BA_OSTYPE_WINDOWS
+}
+
+MappedFile::~MappedFile() {
+#if !BA_OSTYPE_WINDOWS
+  if (data_ != nullptr) {
+    munmap(const_cast<uint8_t*>(data_), size_);
+  }
+#endif
+}
+
+void MappedFile::Advise(size_t offset, size_t length, int advice) const {
+#if !BA_OSTYPE_WINDOWS
+  if (data_ == nullptr || offset >= size_) {
+    return;
+  }
+  length = std::min(length, size_ - offset);
+
+  // madvise wants page alignment; round the range outwards.
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  size_t begin = offset & ~(page_size - 1);
+  size_t end = (offset + length + page_size - 1) & ~(page_size - 1);
+  end = std::min(end, (size_ + page_size - 1) & ~(page_size - 1));
+  madvise(const_cast<uint8_t*>(data_ + begin), end - begin, advice);
+#endif  // BA_OSTYPE_WINDOWS
+}
+
+void MappedFile::Prefetch(size_t offset, size_t length) const {
+#if !BA_OSTYPE_WINDOWS
+  Advise(offset, length, MADV_WILLNEED);
+#endif
+}
+
+void MappedFile::Release(size_t offset, size_t length) const {
+#if !BA_OSTYPE_WINDOWS
+  Advise(offset, length, MADV_DONTNEED);
+#endif
+}
+
+void MappedFile::AdviseSequential() const {
+#if !BA_OSTYPE_WINDOWS
+  Advise(0, size_, MADV_SEQUENTIAL);
+#endif
+}
+
+}  // namespace ballistica
@@ -0,0 +1,50 @@
+// Released under the MIT License. See LICENSE for details.
+
+#ifndef BALLISTICA_PLATFORM_MAPPED_FILE_H_
+#define BALLISTICA_PLATFORM_MAPPED_FILE_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace ballistica {
+
+// A read-only memory-mapped view of a file. Pages stay file-backed, so
+// large read-only assets (the media pack archive, etc.) never get
+// copied onto the heap and the OS can silently drop and re-fault them
+// under memory pressure. Prefetch/Release are advisory paging hints;
+// they never affect correctness, only when pages are resident.
+class MappedFile {
+ public:
+  // Map a whole file; returns nullptr if it can't be opened/mapped or
+  // on platforms without mapping support (callers should fall back to
+  // regular reads).
+  static auto Map(const std::string& path) -> std::unique_ptr<MappedFile>;
+
+  ~MappedFile();
+
+  auto data() const -> const uint8_t* { return data_; }
+  auto size() const -> size_t { return size_; }
+
+  // Hint that a range is about to be read, so the OS can start paging
+  // it in ahead of the first access.
+  void Prefetch(size_t offset, size_t length) const;
+
+  // Hint that a range won't be needed again soon; its pages become
+  // first in line for reclaim (they remain valid to touch).
+  void Release(size_t offset, size_t length) const;
+
+  // Hint that the whole mapping will be read front-to-back, enabling
+  // aggressive read-ahead.
+  void AdviseSequential() const;
+
+ private:
+  MappedFile() = default;
+  void Advise(size_t offset, size_t length, int advice) const;
+  const uint8_t* data_{};
+  size_t size_{};
+};
+
+}  // namespace ballistica
+
+#endif  // BALLISTICA_PLATFORM_MAPPED_FILE_H_
@@ -15,14 +15,23 @@
 #endif
 #include <cxxabi.h>
 #include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/stat.h>
 #include <unistd.h>
 #endif
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+#include <sys/syscall.h>
+#endif
 
 #include <cerrno>
+#include <condition_variable>
 #include <csignal>
 #include <cstdio>
 #include <cstring>
+#include <mutex>
+#include <thread>
 
 #include "ballistica/app/app.h"
 #include "ballistica/app/headless_app.h"
@@ -40,6 +49,7 @@
 #include "ballistica/input/input.h"
 #include "ballistica/input/std_input_module.h"
 #include "ballistica/networking/networking_sys.h"
+#include "ballistica/platform/mapped_file.h"
 #include "ballistica/platform/sdl/sdl_app.h"
 #include "ballistica/python/python.h"
 
@@ -505,6 +515,26 @@ void Platform::SleepMS(millisecs_t ms) {
   std::this_thread::sleep_for(std::chrono::milliseconds(ms));
 }
 
+void Platform::AdviseHugePages(void* buffer, size_t size) {
+#if BA_OSTYPE_LINUX && defined(MADV_HUGEPAGE)
+  // Only bother for buffers spanning at least one huge page.
+  const size_t kHugePageSize = 2u * 1024u * 1024u;
+  if (buffer == nullptr || size < kHugePageSize) {
+    return;
+  }
+
+  // madvise wants page alignment; shrink the range inwards since the
+  // edges of someone else's allocation are not ours to advise on.
+  auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  auto addr = reinterpret_cast<uintptr_t>(buffer);
+  uintptr_t begin = (addr + page_size - 1) & ~(page_size - 1);
+  uintptr_t end = (addr + size) & ~(page_size - 1);
+  if (begin < end) {
+    madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+  }
+#endif  // BA_OSTYPE_LINUX && defined(MADV_HUGEPAGE)
+}
+
 // General one-time initialization stuff
 static void Init() {
   // Sanity check: make sure asserts are stripped out of release builds
@@ -993,6 +1023,23 @@ void Platform::RunEvents() {}
 
 auto Platform::GetMemUsageInfo() -> std::string { return "0,0,0"; }
 
+auto Platform::GetCurrentRSSBytes() -> int64_t {
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+  // Second field of /proc/self/statm is resident pages.
+  if (FILE* f = fopen("/proc/self/statm", "r")) {
+    long size{};      // NOLINT
+    long resident{};  // NOLINT
+    int result = fscanf(f, "%ld %ld", &size, &resident);
+    fclose(f);
+    if (result == 2) {
+      return static_cast<int64_t>(resident)
+             * static_cast<int64_t>(sysconf(_SC_PAGESIZE));
+    }
+  }
+#endif
+  return 0;
+}
+
 void Platform::OnAppPause() {}
 void Platform::OnAppResume() {}
 
@@ -1141,6 +1188,104 @@ void Platform::SetCurrentThreadName(const std::string& name) {
 #endif
 }
 
+void Platform::SetCurrentThreadClass(ThreadClass thread_class) {
+#if !BA_OSTYPE_WINDOWS
+  switch (thread_class) {
+    case ThreadClass::kRealtimeAudio: {
+      // Ask for round-robin realtime scheduling at the lowest rt
+      // priority. Unprivileged processes often can't have this;
+      // that's fine - we just stay at default in that case.
+      sched_param param{};
+      param.sched_priority = sched_get_priority_min(SCHED_RR);
+      pthread_setschedparam(pthread_self(), SCHED_RR, &param);
+      break;
+    }
+    case ThreadClass::kLatencySensitiveNetwork: {
+#if BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID
+      // Not realtime, just a nice boost over everything else here
+      // so pending packets go out promptly. (per-thread nice values
+      // are a linux-ism; elsewhere we leave these at default).
+      setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), -5);
+#endif
+      break;
+    }
+    case ThreadClass::kBulkLoader: {
+#if (BA_OSTYPE_LINUX || BA_OSTYPE_ANDROID) && defined(SCHED_BATCH)
+      // Throughput over latency; happily yields to everything above.
+      sched_param param{};
+      pthread_setschedparam(pthread_self(), SCHED_BATCH, &param);
+#endif
+      break;
+    }
+    case ThreadClass::kStandard:
+      break;
+  }
+#endif  // !BA_OSTYPE_WINDOWS
+}
+
+auto Platform::MapFile(const std::string& path)
+    -> std::unique_ptr<MappedFile> {
+  return MappedFile::Map(path);
+}
+
+// Background file-io internals: one lazily-started thread runs queued
+// calls strictly in submission order. State is intentionally leaked
+// (like our deferred-log rings) so in-flight io never races process
+// teardown.
+static std::mutex g_file_io_mutex;
+static std::condition_variable g_file_io_cv;
+static std::list<std::function<void()> >* g_file_io_calls{};
+
+static void FileIOThreadMain() {
+  while (true) {
+    std::function<void()> call;
+    {
+      std::unique_lock<std::mutex> lock(g_file_io_mutex);
+      g_file_io_cv.wait(lock, [] { return !g_file_io_calls->empty(); });
+      call = std::move(g_file_io_calls->front());
+      g_file_io_calls->pop_front();
+    }
+    call();
+  }
+}
+
+void Platform::PushFileIOCall(std::function<void()> call) {
+  {
+    std::lock_guard<std::mutex> lock(g_file_io_mutex);
+    if (g_file_io_calls == nullptr) {
+      g_file_io_calls = new std::list<std::function<void()> >();
+      auto* io_thread = new std::thread(FileIOThreadMain);
+      io_thread->detach();
+    }
+    g_file_io_calls->push_back(std::move(call));
+  }
+  g_file_io_cv.notify_all();
+}
+
+void Platform::ReadFileAsync(
+    const std::string& path,
+    std::function<void(bool success, std::vector<uint8_t> data)> completion) {
+  PushFileIOCall([this, path, completion] {
+    std::vector<uint8_t> data;
+    bool success{};
+    if (FILE* f = FOpen(path.c_str(), "rb")) {
+      if (fseek(f, 0, SEEK_END) == 0) {
+        long size = ftell(f);  // NOLINT: ftell gives us a long.
+        if (size >= 0 && fseek(f, 0, SEEK_SET) == 0) {
+          data.resize(static_cast<size_t>(size));
+          success =
+              (size == 0 || fread(&(data[0]), data.size(), 1, f) == 1);
+        }
+      }
+      fclose(f);
+    }
+    if (!success) {
+      data.clear();
+    }
+    completion(success, std::move(data));
+  });
+}
+
 void Platform::Unlink(const char* path) {
   // This covers all but windows.
 #if BA_OSTYPE_WINDOWS
@@ -1348,7 +1493,15 @@ auto Platform::SetDebugKey(const std::string& key, const std::string& value)
 auto Platform::HandleDebugLog(const std::string& msg) -> void {}
 
 auto Platform::GetCurrentMilliseconds() -> millisecs_t {
-  return std::chrono::time_point_cast<std::chrono::milliseconds>(
+  return GetCurrentNanoseconds() / 1000000;
+}
+
+auto Platform::GetCurrentMicroseconds() -> int64_t {
+  return GetCurrentNanoseconds() / 1000;
+}
+
+auto Platform::GetCurrentNanoseconds() -> int64_t {
+  return std::chrono::time_point_cast<std::chrono::nanoseconds>(
              std::chrono::steady_clock::now())
       .time_since_epoch()
       .count();
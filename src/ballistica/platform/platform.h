@@ -5,7 +5,10 @@
 
 #include <sys/stat.h>
 
+#include <functional>
 #include <list>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -105,6 +108,29 @@ class Platform {
   // Unlink a file.
   virtual void Unlink(const char* path);
 
+  /// Queue a call to run on the platform's background file-io thread;
+  /// submission never blocks on disk. Calls run strictly in submission
+  /// order, so a sequence of writes against a single file can simply be
+  /// submitted as individual calls. The thread spins up lazily on first
+  /// use. All async file work funnels through this one queue, so it is
+  /// also the seam where a fancier submission backend (io_uring on
+  /// linux server builds, etc.) could slot in later.
+  void PushFileIOCall(std::function<void()> call);
+
+  /// Map a file read-only into memory (see MappedFile). Returns nullptr
+  /// if the file can't be mapped or the platform has no mapping support;
+  /// callers should fall back to regular reads in that case.
+  virtual auto MapFile(const std::string& path)
+      -> std::unique_ptr<MappedFile>;
+
+  /// Read an entire file on the background file-io thread. The
+  /// completion callback runs on that thread with the file's bytes
+  /// (success false and empty data on any error); push a call back to
+  /// your own thread from within it if you need results there.
+  void ReadFileAsync(
+      const std::string& path,
+      std::function<void(bool success, std::vector<uint8_t> data)> completion);
+
 #pragma mark PRINTING/LOGGING --------------------------------------------------
 
   // Send a message to the default platform handler.
@@ -333,6 +359,10 @@ class Platform {
   // Called during stress testing.
   virtual auto GetMemUsageInfo() -> std::string;
 
+  // Current resident-set size in bytes, or 0 where unsupported. Used
+  // for leak/drift detection (see SoakTest).
+  virtual auto GetCurrentRSSBytes() -> int64_t;
+
   // Optionally override fatal error reporting. If true is returned, default
   // fatal error reporting will not run.
   virtual auto ReportFatalError(const std::string& message,
@@ -383,6 +413,7 @@ class Platform {
   static auto SetLastPyCall(const std::string& name) {
     if (g_platform) {
       g_platform->py_call_num_++;
+      g_platform->py_call_counts_[name]++;
       g_platform->SetDebugKey(
           "LastPyCall" + std::to_string(g_platform->py_call_num_ % 10),
           std::to_string(g_platform->py_call_num_) + ":" + name + "@"
@@ -390,6 +421,13 @@ class Platform {
     }
   }
 
+  /// Per-method counts of native Python calls made; used to find which
+  /// bindings are hot enough to deserve fast-path treatment.
+  /// (protected by the GIL, like the calls themselves).
+  auto py_call_counts() const -> const std::map<std::string, int64_t>& {
+    return py_call_counts_;
+  }
+
 #pragma mark MISC --------------------------------------------------------------
 
   // Return a monotonic time measurement in milliseconds since launch.
@@ -399,10 +437,24 @@ class Platform {
 
   // A raw milliseconds value (not relative to launch time).
   static auto GetCurrentMilliseconds() -> millisecs_t;
+  static auto GetCurrentMicroseconds() -> int64_t;
+
+  // Raw nanoseconds off the monotonic clock; the unified high-res time
+  // source the coarser calls above quantize from. On the platforms we
+  // ship on this resolves to a userspace TSC/CNTVCT read via the vDSO
+  // (no syscall), so it's fine to call at very high frequency.
+  static auto GetCurrentNanoseconds() -> int64_t;
   static auto GetCurrentSeconds() -> int64_t;
 
   static void SleepMS(millisecs_t ms);
 
+  /// Hint that a big long-lived buffer should be backed by transparent
+  /// huge pages where the OS supports it (fewer TLB misses on server
+  /// boxes running many instances). Purely advisory: interior page
+  /// alignment is handled here, and it's a no-op for small ranges or on
+  /// platforms without support.
+  static void AdviseHugePages(void* buffer, size_t size);
+
   // Pop up a text edit dialog.
   virtual void EditText(const std::string& title, const std::string& value,
                         int max_chars);
@@ -456,6 +508,12 @@ class Platform {
   // Set the name of the current thread (for debugging).
   virtual void SetCurrentThreadName(const std::string& name);
 
+  // Apply a scheduling class to the current thread (best effort; the
+  // base version maps these to posix priorities and subclasses can
+  // substitute platform QoS classes). Keeps the OS from scheduling
+  // our audio thread like a bulk loader and vice versa.
+  virtual void SetCurrentThreadClass(ThreadClass thread_class);
+
   // If display-resolution can be directly set on this platform,
   // return true and set the native full res here.  Otherwise return false;
   virtual auto GetDisplayResolution(int* x, int* y) -> bool;
@@ -495,6 +553,7 @@ class Platform {
 
  private:
   int py_call_num_{};
+  std::map<std::string, int64_t> py_call_counts_;
   bool using_custom_app_python_dir_{};
   bool have_config_dir_{};
   bool have_has_touchscreen_value_{};
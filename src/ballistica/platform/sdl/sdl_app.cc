@@ -13,6 +13,7 @@
 #include "ballistica/graphics/graphics_server.h"
 #include "ballistica/input/device/joystick.h"
 #include "ballistica/input/input.h"
+#include "ballistica/media/media_server.h"
 #include "ballistica/platform/platform.h"
 #include "ballistica/python/python.h"
 
@@ -357,6 +358,15 @@ void SDLApp::RunEvents() {
   while (SDL_PollEvent(&event) && (!done())) {
     HandleSDLEvent(event);
   }
+
+  // Push any queued rumble commands out to the hardware. SDL requires
+  // joystick access from this thread, so this is the soonest we can get
+  // them there.
+  for (auto* joystick : sdl_joysticks_) {
+    if (joystick != nullptr) {
+      joystick->ApplyPendingRumble();
+    }
+  }
 }
 
 void SDLApp::DidFinishRenderingFrame(FrameDef* frame) {
@@ -519,18 +529,25 @@ void SDLApp::SDLJoystickConnected(int device_index) {
     return;
   }
 
-  // Create the joystick here in the main thread and then pass it over to the
-  // game thread to be added to the game.
   if (g_buildconfig.ostype_ios_tvos()) {
     BA_LOG_ONCE("WTF GOT SDL-JOY-CONNECTED ON IOS");
   } else {
-    auto* j = Object::NewDeferred<Joystick>(device_index);
-    if (g_buildconfig.sdl2_build() && g_buildconfig.enable_sdl_joysticks()) {
-      int instance_id = SDL_JoystickInstanceID(j->sdl_joystick());
-      get()->AddSDLInputDevice(j, instance_id);
-    } else {
-      get()->AddSDLInputDevice(j, device_index);
-    }
+    // Opening the device interrogates its capabilities, which can block
+    // for hundreds of ms on some bluetooth pads; do it in the media
+    // worker thread and hand the finished device back to the main
+    // thread so hot-plug never touches a frame.
+    g_media_server->PushCall([device_index] {
+      auto* j = Object::NewDeferred<Joystick>(device_index);
+      g_app->PushCall([j, device_index] {
+        if (g_buildconfig.sdl2_build()
+            && g_buildconfig.enable_sdl_joysticks()) {
+          int instance_id = SDL_JoystickInstanceID(j->sdl_joystick());
+          get()->AddSDLInputDevice(j, instance_id);
+        } else {
+          get()->AddSDLInputDevice(j, device_index);
+        }
+      });
+    });
   }
 }
 
@@ -563,7 +580,11 @@ void SDLApp::RemoveSDLInputDevice(int index) {
   assert(InMainThread());
   assert(index >= 0);
   Joystick* j = GetSDLJoyStickInput(index);
-  assert(j);
+  if (j == nullptr) {
+    // Can happen if the device vanished while its background open was
+    // still in flight; in that case there's nothing to remove yet.
+    return;
+  }
   if (static_cast_check_fit<int>(sdl_joysticks_.size()) > index) {
     sdl_joysticks_[index] = nullptr;
   } else {
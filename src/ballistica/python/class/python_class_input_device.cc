@@ -399,6 +399,31 @@ auto PythonClassInputDevice::GetButtonName(PythonClassInputDevice* self,
   BA_PYTHON_CATCH;
 }
 
+auto PythonClassInputDevice::Rumble(PythonClassInputDevice* self,
+                                    PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  assert(InGameThread());
+  float low_intensity{};
+  float high_intensity{};
+  float duration{};
+  static const char* kwlist[] = {"low_intensity", "high_intensity", "duration",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "fff",
+                                   const_cast<char**>(kwlist), &low_intensity,
+                                   &high_intensity, &duration)) {
+    return nullptr;
+  }
+  InputDevice* input_device = self->input_device_->get();
+  if (!input_device) {
+    throw Exception(PyExcType::kInputDeviceNotFound);
+  }
+  input_device->SetRumble(low_intensity, high_intensity,
+                          static_cast<millisecs_t>(duration * 1000.0f));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
 PyTypeObject PythonClassInputDevice::type_obj;
 PyMethodDef PythonClassInputDevice::tp_methods[] = {
     {"remove_remote_player_from_game", (PyCFunction)RemoveRemotePlayerFromGame,
@@ -447,6 +472,16 @@ PyMethodDef PythonClassInputDevice::tp_methods[] = {
      "get_player_profiles() -> dict\n"
      "\n"
      "(internal)"},
+    // NOLINTNEXTLINE (signed bitwise ops)
+    {"rumble", (PyCFunction)Rumble, METH_VARARGS | METH_KEYWORDS,
+     "rumble(low_intensity: float, high_intensity: float,\n"
+     "  duration: float) -> None\n"
+     "\n"
+     "Ask the physical device to rumble, if it supports doing so.\n"
+     "\n"
+     "Intensities range from 0 to 1 and duration is in seconds.\n"
+     "A new rumble call replaces any still in progress; intensities of 0\n"
+     "stop rumbling early."},
     {nullptr}};  // namespace ballistica
 
 #pragma clang diagnostic pop
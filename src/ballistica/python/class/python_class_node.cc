@@ -6,6 +6,7 @@
 #include <string>
 
 #include "ballistica/game/game_stream.h"
+#include "ballistica/math/vector3f.h"
 #include "ballistica/python/python.h"
 #include "ballistica/scene/scene.h"
 
@@ -18,6 +19,19 @@ namespace ballistica {
 
 PyNumberMethods PythonClassNode::as_number_;
 
+// How many recycled weak-refs we keep around for reuse.
+static const size_t kMaxFreeRefs = 64;
+
+void PythonClassNode::RecycleRef(Object::WeakRef<Node>* ref) {
+  assert(InGameThread());
+  if (s_free_refs_.size() < kMaxFreeRefs) {
+    ref->Clear();
+    s_free_refs_.push_back(ref);
+  } else {
+    delete ref;
+  }
+}
+
 void PythonClassNode::SetupType(PyTypeObject* obj) {
   PythonClass::SetupType(obj);
   obj->tp_repr = (reprfunc)tp_repr;
@@ -98,7 +112,12 @@ auto PythonClassNode::tp_new(PyTypeObject* type, PyObject* args,
             "ba.Node(None) to get an invalid reference.");
       }
     }
-    self->node_ = new Object::WeakRef<Node>();
+    if (!s_free_refs_.empty()) {
+      self->node_ = s_free_refs_.back();
+      s_free_refs_.pop_back();
+    } else {
+      self->node_ = new Object::WeakRef<Node>();
+    }
     BA_PYTHON_NEW_CATCH;
   }
   return reinterpret_cast<PyObject*>(self);
@@ -106,13 +125,13 @@ auto PythonClassNode::tp_new(PyTypeObject* type, PyObject* args,
 
 void PythonClassNode::tp_dealloc(PythonClassNode* self) {
   BA_PYTHON_TRY;
-  // These have to be deleted in the game thread; send the ptr along if need
+  // These have to be recycled in the game thread; send the ptr along if need
   // be; otherwise do it immediately.
   if (!InGameThread()) {
     Object::WeakRef<Node>* n = self->node_;
-    g_game->PushCall([n] { delete n; });
+    g_game->PushCall([n] { RecycleRef(n); });
   } else {
-    delete self->node_;
+    RecycleRef(self->node_);
   }
   BA_PYTHON_DEALLOC_CATCH;
   Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
@@ -337,6 +356,27 @@ auto PythonClassNode::ConnectAttr(PythonClassNode* self, PyObject* args)
   BA_PYTHON_CATCH;
 }
 
+auto PythonClassNode::GetRewoundPosition(PythonClassNode* self, PyObject* args,
+                                         PyObject* keywds) -> PyObject* {
+  BA_PYTHON_TRY;
+  Node* node = self->node_->get();
+  if (!node) {
+    throw Exception(PyExcType::kNodeNotFound);
+  }
+  double delay;
+  static const char* kwlist[] = {"delay", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "d",
+                                   const_cast<char**>(kwlist), &delay)) {
+    return nullptr;
+  }
+  if (delay < 0.0) {
+    throw Exception("delay can't be negative", PyExcType::kValue);
+  }
+  Vector3f p = node->GetRewoundPosition(static_cast<millisecs_t>(delay));
+  return Py_BuildValue("(fff)", p.x, p.y, p.z);
+  BA_PYTHON_CATCH;
+}
+
 auto PythonClassNode::Dir(PythonClassNode* self) -> PyObject* {
   BA_PYTHON_TRY;
 
@@ -446,10 +486,23 @@ PyMethodDef PythonClassNode::tp_methods[] = {
      "light = ba.newnode('light')\n"
      "loc = ba.newnode('locator', attrs={'position': (0,10,0)})\n"
      "loc.connectattr('position', light, 'position')"},
+    {"get_rewound_position", (PyCFunction)GetRewoundPosition,
+     METH_VARARGS | METH_KEYWORDS,
+     "get_rewound_position(delay: float) -> tuple[float, float, float]\n"
+     "\n"
+     "Return the position of the node's first rigid body as it was\n"
+     "'delay' milliseconds ago (lag compensation).\n"
+     "\n"
+     "Use this to evaluate hits/grabs at an acting client's view time;\n"
+     "pass the client's ping as the delay. History is bounded (about half\n"
+     "a second); longer delays clamp to the oldest recorded position.\n"
+     "Raises a ba.NodeNotFoundError for nonexistent nodes and a ValueError\n"
+     "for nodes with no rigid bodies."},
     {"__dir__", (PyCFunction)Dir, METH_NOARGS,
      "allows inclusion of our custom attrs in standard python dir()"},
     {nullptr}};
 
+std::vector<Object::WeakRef<Node>*> PythonClassNode::s_free_refs_;
 bool PythonClassNode::s_create_empty_ = false;
 PyTypeObject PythonClassNode::type_obj;
 
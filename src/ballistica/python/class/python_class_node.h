@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_PYTHON_CLASS_PYTHON_CLASS_NODE_H_
 #define BALLISTICA_PYTHON_CLASS_PYTHON_CLASS_NODE_H_
 
+#include <vector>
+
 #include "ballistica/core/object.h"
 #include "ballistica/python/class/python_class.h"
 #include "ballistica/scene/node/node_type.h"
@@ -39,8 +41,16 @@ class PythonClassNode : public PythonClass {
   static auto AddDeathAction(PythonClassNode* self, PyObject* args)
       -> PyObject*;
   static auto ConnectAttr(PythonClassNode* self, PyObject* args) -> PyObject*;
+  static auto GetRewoundPosition(PythonClassNode* self, PyObject* args,
+                                 PyObject* keywds) -> PyObject*;
   static auto Dir(PythonClassNode* self) -> PyObject*;
   static auto nb_bool(PythonClassNode* self) -> int;
+
+  /// Clear a wrapper's weak-ref and park it for reuse (or delete it if
+  /// the freelist is full). Node wrappers come and go constantly during
+  /// play so this saves a heap cycle per wrapper. Game thread only.
+  static void RecycleRef(Object::WeakRef<Node>* ref);
+  static std::vector<Object::WeakRef<Node>*> s_free_refs_;
   static bool s_create_empty_;
   static PyMethodDef tp_methods[];
   Object::WeakRef<Node>* node_;
@@ -24,6 +24,19 @@ auto PythonClassSessionPlayer::nb_bool(PythonClassSessionPlayer* self) -> int {
 
 PyNumberMethods PythonClassSessionPlayer::as_number_;
 
+// How many recycled weak-refs we keep around for reuse.
+static const size_t kMaxFreeRefs = 32;
+
+void PythonClassSessionPlayer::RecycleRef(Object::WeakRef<Player>* ref) {
+  assert(InGameThread());
+  if (s_free_refs_.size() < kMaxFreeRefs) {
+    ref->Clear();
+    s_free_refs_.push_back(ref);
+  } else {
+    delete ref;
+  }
+}
+
 // Attrs we expose through our custom getattr/setattr.
 #define ATTR_IN_GAME "in_game"
 #define ATTR_SESSIONTEAM "sessionteam"
@@ -173,7 +186,12 @@ auto PythonClassSessionPlayer::tp_new(PyTypeObject* type, PyObject* args,
             "Can't instantiate SessionPlayers. To create an invalid"
             " SessionPlayer reference, call ba.SessionPlayer(None).");
     }
-    self->player_ = new Object::WeakRef<Player>();
+    if (!s_free_refs_.empty()) {
+      self->player_ = s_free_refs_.back();
+      s_free_refs_.pop_back();
+    } else {
+      self->player_ = new Object::WeakRef<Player>();
+    }
     BA_PYTHON_NEW_CATCH;
   }
   return reinterpret_cast<PyObject*>(self);
@@ -182,13 +200,13 @@ auto PythonClassSessionPlayer::tp_new(PyTypeObject* type, PyObject* args,
 void PythonClassSessionPlayer::tp_dealloc(PythonClassSessionPlayer* self) {
   BA_PYTHON_TRY;
 
-  // These have to be deleted in the game thread - send the ptr along if need
+  // These have to be recycled in the game thread - send the ptr along if need
   // be; otherwise do it immediately.
   if (!InGameThread()) {
     Object::WeakRef<Player>* p = self->player_;
-    g_game->PushCall([p] { delete p; });
+    g_game->PushCall([p] { RecycleRef(p); });
   } else {
-    delete self->player_;
+    RecycleRef(self->player_);
   }
   BA_PYTHON_DEALLOC_CATCH;
   Py_TYPE(self)->tp_free(reinterpret_cast<PyObject*>(self));
@@ -670,6 +688,7 @@ auto PythonClassSessionPlayer::Dir(PythonClassSessionPlayer* self)
   BA_PYTHON_CATCH;
 }
 
+std::vector<Object::WeakRef<Player>*> PythonClassSessionPlayer::s_free_refs_;
 bool PythonClassSessionPlayer::s_create_empty_ = false;
 PyTypeObject PythonClassSessionPlayer::type_obj;
 PyMethodDef PythonClassSessionPlayer::tp_methods[] = {
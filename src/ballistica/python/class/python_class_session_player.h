@@ -3,6 +3,8 @@
 #ifndef BALLISTICA_PYTHON_CLASS_PYTHON_CLASS_SESSION_PLAYER_H_
 #define BALLISTICA_PYTHON_CLASS_PYTHON_CLASS_SESSION_PLAYER_H_
 
+#include <vector>
+
 #include "ballistica/core/object.h"
 #include "ballistica/python/class/python_class.h"
 
@@ -54,6 +56,11 @@ class PythonClassSessionPlayer : public PythonClass {
   static auto Dir(PythonClassSessionPlayer* self) -> PyObject*;
   Object::WeakRef<Player>* player_;
   static auto nb_bool(PythonClassSessionPlayer* self) -> int;
+
+  /// Clear a wrapper's weak-ref and park it for reuse (or delete it if
+  /// the freelist is full). Game thread only.
+  static void RecycleRef(Object::WeakRef<Player>* ref);
+  static std::vector<Object::WeakRef<Player>*> s_free_refs_;
   static PyNumberMethods as_number_;
 };
 
@@ -2,6 +2,7 @@
 
 #include "ballistica/python/methods/python_methods_app.h"
 
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -14,10 +15,12 @@
 #include "ballistica/game/session/host_session.h"
 #include "ballistica/game/session/replay_client_session.h"
 #include "ballistica/graphics/graphics.h"
+#include "ballistica/input/input_latency_meter.h"
 #include "ballistica/media/component/texture.h"
 #include "ballistica/python/class/python_class_activity_data.h"
 #include "ballistica/python/class/python_class_session_data.h"
 #include "ballistica/python/python.h"
+#include "ballistica/python/python_context_call.h"
 #include "ballistica/python/python_context_call_runnable.h"
 #include "ballistica/scene/scene.h"
 
@@ -640,6 +643,112 @@ auto PyBless(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
 }
 #endif  // BA_DEBUG_BUILD
 
+auto PyInProcessRestart(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("in_process_restart");
+  g_game->PushInProcessRestartCall();
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PyLoadTestStart(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("load_test_start");
+  int client_count{8};
+  int latency_ms{0};
+  int jitter_ms{0};
+  float loss_percent{0.0f};
+  if (!PyArg_ParseTuple(args, "|iiif", &client_count, &latency_ms, &jitter_ms,
+                        &loss_percent)) {
+    return nullptr;
+  }
+  g_game->PushCall([client_count, latency_ms, jitter_ms, loss_percent] {
+    g_game->StartLoadTest(client_count, latency_ms, jitter_ms, loss_percent);
+  });
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PyLoadTestStop(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("load_test_stop");
+  g_game->PushCall([] { g_game->StopLoadTest(); });
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PyReplayBenchmark(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("replay_benchmark");
+  const char* file_name;
+  if (!PyArg_ParseTuple(args, "s", &file_name)) {
+    return nullptr;
+  }
+  std::string file_name_s = file_name;
+  g_game->PushCall(
+      [file_name_s] { g_game->StartReplayBenchmark(file_name_s); });
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PySoakTestStart(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("soak_test_start");
+  int cycles{20};
+  int client_count{4};
+  int play_secs{30};
+  int idle_secs{5};
+  if (!PyArg_ParseTuple(args, "|iiii", &cycles, &client_count, &play_secs,
+                        &idle_secs)) {
+    return nullptr;
+  }
+  g_game->PushCall([cycles, client_count, play_secs, idle_secs] {
+    g_game->StartSoakTest(cycles, client_count, play_secs, idle_secs);
+  });
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PySoakTestStop(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("soak_test_stop");
+  g_game->PushCall([] { g_game->StopSoakTest(); });
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PyGetInputLatencyInfo(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("get_input_latency_info");
+  int64_t buckets[InputLatencyMeter::kBucketCount];
+  InputLatencyMeter::GetBuckets(buckets);
+  PythonRef histogram(PyTuple_New(InputLatencyMeter::kBucketCount),
+                      PythonRef::kSteal);
+  for (int i = 0; i < InputLatencyMeter::kBucketCount; ++i) {
+    PyTuple_SET_ITEM(histogram.get(), i, PyLong_FromLongLong(buckets[i]));
+  }
+  PythonRef results(
+      Py_BuildValue(
+          "{sOsLsdsdsdsdsdsdsdsO}", "enabled",
+          InputLatencyMeter::enabled() ? Py_True : Py_False, "count",
+          InputLatencyMeter::SampleCount(), "avg_ms",
+          0.001 * static_cast<double>(InputLatencyMeter::AverageUsecs()),
+          "min_ms", 0.001 * static_cast<double>(InputLatencyMeter::MinUsecs()),
+          "max_ms", 0.001 * static_cast<double>(InputLatencyMeter::MaxUsecs()),
+          "p50_ms",
+          0.001 * static_cast<double>(InputLatencyMeter::PercentileUsecs(50)),
+          "p90_ms",
+          0.001 * static_cast<double>(InputLatencyMeter::PercentileUsecs(90)),
+          "p99_ms",
+          0.001 * static_cast<double>(InputLatencyMeter::PercentileUsecs(99)),
+          "bucket_width_ms",
+          0.001 * static_cast<double>(InputLatencyMeter::kBucketWidthUsecs),
+          "buckets", histogram.get()),
+      PythonRef::kSteal);
+  return results.NewRef();
+  BA_PYTHON_CATCH;
+}
+
 auto PyApplyConfig(PyObject* self, PyObject* args) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("apply_config");
@@ -651,6 +760,70 @@ auto PyApplyConfig(PyObject* self, PyObject* args) -> PyObject* {
   BA_PYTHON_CATCH;
 }
 
+// Coalesced async config persistence: commit_config parks the newest
+// serialized config here and queues at most one write job on the
+// platform's file-io thread. The job grabs whatever is newest when it
+// actually runs, so a burst of settings changes (fullscreen toggles
+// etc.) collapses into a single disk write and the game thread never
+// blocks on one.
+static std::mutex g_config_commit_mutex;
+static std::string g_config_commit_pending;
+static bool g_config_commit_queued{};
+
+// The temp-write/backup/rename dance; file-io thread. Errors get logged
+// here rather than raised since the committing call has long returned.
+static void WriteConfigFile(const std::string& final_str) {
+  std::string path = g_platform->GetConfigFilePath();
+  std::string path_temp = path + ".tmp";
+  std::string path_prev = path + ".prev";
+  FILE* f_out = g_platform->FOpen(path_temp.c_str(), "wb");
+  if (f_out == nullptr) {
+    Log("Error opening config file for writing: '" + path_temp
+        + "': " + g_platform->GetErrnoString());
+    return;
+  }
+
+  // Write to temp file.
+  size_t result = fwrite(&final_str[0], final_str.size(), 1, f_out);
+  if (result != 1) {
+    fclose(f_out);
+    Log("Error writing config file to '" + path_temp
+        + "': " + g_platform->GetErrnoString());
+    return;
+  }
+  fclose(f_out);
+
+  // Now backup any existing config to .prev.
+  if (g_platform->FilePathExists(path)) {
+    // On windows, rename doesn't overwrite existing files.. need to kill
+    // the old explicitly.
+    // (hmm; should we just do this everywhere for consistency?)
+    if (g_buildconfig.ostype_windows()) {
+      if (g_platform->FilePathExists(path_prev)) {
+        int result2 = g_platform->Remove(path_prev.c_str());
+        if (result2 != 0) {
+          Log("Error removing prev config file '" + path_prev
+              + "': " + g_platform->GetErrnoString());
+          return;
+        }
+      }
+    }
+    int result2 = g_platform->Rename(path.c_str(), path_prev.c_str());
+    if (result2 != 0) {
+      Log("Error backing up config file to '" + path_prev
+          + "': " + g_platform->GetErrnoString());
+      return;
+    }
+  }
+
+  // Now move temp into place.
+  int result2 = g_platform->Rename(path_temp.c_str(), path.c_str());
+  if (result2 != 0) {
+    Log("Error renaming temp config file to final '" + path
+        + "': " + g_platform->GetErrnoString());
+  }
+}
+
 auto PyCommitConfig(PyObject* self, PyObject* args, PyObject* keywds)
     -> PyObject* {
   BA_PYTHON_TRY;
@@ -665,51 +838,21 @@ auto PyCommitConfig(PyObject* self, PyObject* args, PyObject* keywds)
     throw Exception("ERROR ON JSON DUMP");
   }
   std::string final_str = Python::GetPyString(config_obj);
-  std::string path = g_platform->GetConfigFilePath();
-  std::string path_temp = path + ".tmp";
-  std::string path_prev = path + ".prev";
-  if (explicit_bool(true)) {
-    FILE* f_out = g_platform->FOpen(path_temp.c_str(), "wb");
-    if (f_out == nullptr) {
-      throw Exception("Error opening config file for writing: '" + path_temp
-                      + "': " + g_platform->GetErrnoString());
-    }
-
-    // Write to temp file.
-    size_t result = fwrite(&final_str[0], final_str.size(), 1, f_out);
-    if (result != 1) {
-      fclose(f_out);
-      throw Exception("Error writing config file to '" + path_temp
-                      + "': " + g_platform->GetErrnoString());
-    }
-    fclose(f_out);
-
-    // Now backup any existing config to .prev.
-    if (g_platform->FilePathExists(path)) {
-      // On windows, rename doesn't overwrite existing files.. need to kill
-      // the old explicitly.
-      // (hmm; should we just do this everywhere for consistency?)
-      if (g_buildconfig.ostype_windows()) {
-        if (g_platform->FilePathExists(path_prev)) {
-          int result2 = g_platform->Remove(path_prev.c_str());
-          if (result2 != 0) {
-            throw Exception("Error removing prev config file '" + path_prev
-                            + "': " + g_platform->GetErrnoString());
-          }
+  {
+    std::lock_guard<std::mutex> lock(g_config_commit_mutex);
+    g_config_commit_pending = std::move(final_str);
+    if (!g_config_commit_queued) {
+      g_config_commit_queued = true;
+      g_platform->PushFileIOCall([] {
+        std::string to_write;
+        {
+          std::lock_guard<std::mutex> lock(g_config_commit_mutex);
+          to_write = std::move(g_config_commit_pending);
+          g_config_commit_pending.clear();
+          g_config_commit_queued = false;
         }
-      }
-      int result2 = g_platform->Rename(path.c_str(), path_prev.c_str());
-      if (result2 != 0) {
-        throw Exception("Error backing up config file to '" + path_prev
-                        + "': " + g_platform->GetErrnoString());
-      }
-    }
-
-    // Now move temp into place.
-    int result2 = g_platform->Rename(path_temp.c_str(), path.c_str());
-    if (result2 != 0) {
-      throw Exception("Error renaming temp config file to final '" + path
-                      + "': " + g_platform->GetErrnoString());
+        WriteConfigFile(to_write);
+      });
     }
   }
   Py_RETURN_NONE;
@@ -885,6 +1028,28 @@ auto PyTimeFormatCheck(PyObject* self, PyObject* args, PyObject* keywds)
   BA_PYTHON_CATCH;
 }
 
+auto PyGetPyCallTimings(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("get_py_call_timings");
+  PythonRef results(PyDict_New(), PythonRef::kSteal);
+  for (auto&& i : PythonContextCall::call_timings()) {
+    const auto& timings = i.second;
+    constexpr int bucket_count =
+        PythonContextCall::CallTimings::kNumHistogramBuckets;
+    PythonRef histogram(PyTuple_New(bucket_count), PythonRef::kSteal);
+    for (int j = 0; j < bucket_count; ++j) {
+      PyTuple_SET_ITEM(histogram.get(), j,
+                       PyLong_FromLongLong(timings.histogram[j]));
+    }
+    PythonRef val(Py_BuildValue("(LLLO)", timings.count, timings.total_usecs,
+                                timings.max_usecs, histogram.get()),
+                  PythonRef::kSteal);
+    PyDict_SetItemString(results.get(), i.first.c_str(), val.get());
+  }
+  return results.NewRef();
+  BA_PYTHON_CATCH;
+}
+
 PyMethodDef PythonMethodsApp::methods_def[] = {
     {"appname", (PyCFunction)PyAppName, METH_NOARGS,
      "appname() -> str\n"
@@ -919,6 +1084,18 @@ PyMethodDef PythonMethodsApp::methods_def[] = {
      "(for helping with the transition from milliseconds-based time calls\n"
      "to seconds-based ones)"},
 
+    {"get_py_call_timings", (PyCFunction)PyGetPyCallTimings, METH_NOARGS,
+     "get_py_call_timings() -> dict\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Return accumulated run timings for natively-fired Python callbacks\n"
+     "(timers, input calls, etc), keyed by the file/line the callback was\n"
+     "created at. Values are tuples of (count, total-microseconds,\n"
+     "max-microseconds, histogram); histogram buckets cover runs under\n"
+     "0.1ms and double from there, with the last holding everything\n"
+     "longer.\n"},
+
     {"log", (PyCFunction)PyLog, METH_VARARGS | METH_KEYWORDS,
      "log(message: str, to_stdout: bool = True,\n"
      "    to_server: bool = True) -> None\n"
@@ -970,6 +1147,65 @@ PyMethodDef PythonMethodsApp::methods_def[] = {
      "\n"
      "(internal)"},
 
+    {"in_process_restart", PyInProcessRestart, METH_VARARGS,
+     "in_process_restart() -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Soft-reset the engine to a clean between-match state without\n"
+     "restarting the process; much faster than a full binary restart."},
+
+    {"load_test_start", PyLoadTestStart, METH_VARARGS,
+     "load_test_start(client_count=8, latency_ms=0, jitter_ms=0,\n"
+     "  loss_percent=0.0) -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Spin up synthetic clients speaking the real protocol against the\n"
+     "local host session, with optional latency/jitter/loss injection."},
+
+    {"load_test_stop", PyLoadTestStop, METH_VARARGS,
+     "load_test_stop() -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Stop a running load test and log its tick-time distribution."},
+
+    {"replay_benchmark", PyReplayBenchmark, METH_VARARGS,
+     "replay_benchmark(file_name: str) -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Play a replay back unthrottled, timing scene-step, frame-build,\n"
+     "and huffman-decode; logs a json report when the replay ends."},
+
+    {"soak_test_start", PySoakTestStart, METH_VARARGS,
+     "soak_test_start(cycles=20, client_count=4, play_secs=30,\n"
+     "  idle_secs=5) -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Cycle synthetic clients through join/play/leave loops, snapshot\n"
+     "object/media/rss metrics each cycle, and flag monotonic growth."},
+
+    {"soak_test_stop", PySoakTestStop, METH_VARARGS,
+     "soak_test_stop() -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Stop a running soak test."},
+
+    {"get_input_latency_info", (PyCFunction)PyGetInputLatencyInfo,
+     METH_NOARGS,
+     "get_input_latency_info() -> dict\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Return input-to-photon latency stats gathered while tracking is on\n"
+     "(toggle via value_test('inputLatencyTracking', absolute=1)): sample\n"
+     "count, avg/min/max and percentile latencies in milliseconds, plus\n"
+     "the raw histogram."},
+
 #if BA_DEBUG_BUILD
     {"bless", (PyCFunction)PyBless, METH_VARARGS | METH_KEYWORDS,
      "bless() -> None\n"
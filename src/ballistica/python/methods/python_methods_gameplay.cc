@@ -21,9 +21,11 @@
 #include "ballistica/input/device/input_device.h"
 #include "ballistica/media/component/sound.h"
 #include "ballistica/platform/platform.h"
+#include "ballistica/python/class/python_class_node.h"
 #include "ballistica/python/python.h"
 #include "ballistica/python/python_context_call_runnable.h"
 #include "ballistica/scene/node/node.h"
+#include "ballistica/scene/node/node_attribute.h"
 #include "ballistica/scene/node/node_type.h"
 #include "ballistica/scene/scene.h"
 
@@ -44,6 +46,80 @@ auto PyNewNode(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
   BA_PYTHON_CATCH;
 }
 
+auto PySetNodeAttrs(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+                    PyObject* kwnames) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("set_node_attrs");
+  static const char* kwlist[] = {"nodes", "attrs", nullptr};
+  static PyObject* interned[2];
+  PyObject* slots[2]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 2, "set_node_attrs")) {
+    return nullptr;
+  }
+  PyObject* nodes_obj = slots[0];
+  PyObject* attrs_obj = slots[1];
+  if (nodes_obj == nullptr || attrs_obj == nullptr) {
+    throw Exception("Expected nodes and attrs args.", PyExcType::kType);
+  }
+  if (!PyDict_Check(attrs_obj)) {
+    throw Exception("Expected a dict of attr values.", PyExcType::kType);
+  }
+
+  // Accept either a single node or a sequence of them.
+  if (PythonClassNode::Check(nodes_obj)) {
+    Node* node = Python::GetPyNode(nodes_obj);
+    Python::SetNodeAttrs(node, attrs_obj);
+  } else {
+    std::vector<Node*> nodes = Python::GetPyNodes(nodes_obj);
+    for (auto&& node : nodes) {
+      Python::SetNodeAttrs(node, attrs_obj);
+    }
+  }
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PyOscillateNodeAttr(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("oscillate_node_attr");
+  assert(InGameThread());
+  PyObject* node_obj{};
+  const char* attr_name{};
+  float base{};
+  float amplitude{};
+  long long period{};  // NOLINT (need long long for python parsing)
+  const char* style_str = "sine";
+  static const char* kwlist[] = {"node",   "attr",   "base", "amplitude",
+                                 "period", "style", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "OsffL|s",
+                                   const_cast<char**>(kwlist), &node_obj,
+                                   &attr_name, &base, &amplitude, &period,
+                                   &style_str)) {
+    return nullptr;
+  }
+  Node* node = Python::GetPyNode(node_obj);
+  NodeAttribute attr = node->GetAttribute(attr_name);
+  AttrRepeaterStyle style;
+  if (!strcmp(style_str, "sine")) {
+    style = AttrRepeaterStyle::kSine;
+  } else if (!strcmp(style_str, "square")) {
+    style = AttrRepeaterStyle::kSquare;
+  } else if (!strcmp(style_str, "triangle")) {
+    style = AttrRepeaterStyle::kTriangle;
+  } else if (!strcmp(style_str, "sawtooth")) {
+    style = AttrRepeaterStyle::kSawtooth;
+  } else {
+    throw Exception("Invalid style: '" + std::string(style_str) + "'.",
+                    PyExcType::kValue);
+  }
+  node->scene()->AddAttrRepeater(node, attr.index(), base, amplitude,
+                                 static_cast<millisecs_t>(period), style);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
 auto PyPrintNodes(PyObject* self, PyObject* args) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("print_nodes");
@@ -185,41 +261,46 @@ auto PyGetCollisionInfo(PyObject* self, PyObject* args) -> PyObject* {
   BA_PYTHON_CATCH;
 }
 
-auto PyCameraShake(PyObject* self, PyObject* args, PyObject* keywds)
-    -> PyObject* {
+auto PyCameraShake(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+                   PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("camera_shake");
   assert(InGameThread());
-  float intensity = 1.0f;
   static const char* kwlist[] = {"intensity", nullptr};
-  if (!PyArg_ParseTupleAndKeywords(args, keywds, "|f",
-                                   const_cast<char**>(kwlist), &intensity)) {
+  static PyObject* interned[1];
+  PyObject* slots[1]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 1, "camerashake")) {
     return nullptr;
   }
+  float intensity = slots[0] ? Python::GetPyFloat(slots[0]) : 1.0f;
   g_graphics->LocalCameraShake(intensity);
   Py_RETURN_NONE;
   BA_PYTHON_CATCH;
 }
 
-auto PyPlaySound(PyObject* self, PyObject* args, PyObject* keywds)
-    -> PyObject* {
+auto PyPlaySound(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+                 PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("play_sound");
 
   assert(InGameThread());
-  PyObject* sound_obj;
-  float volume = 1.0f;
-  int host_only = 0;
-  PyObject* pos_obj = Py_None;
   static const char* kwlist[] = {"sound", "volume", "position", "host_only",
                                  nullptr};
-  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|fOp",
-                                   const_cast<char**>(kwlist), &sound_obj,
-                                   &volume, &pos_obj, &host_only)) {
+  static PyObject* interned[4];
+  PyObject* slots[4]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 4, "playsound")) {
     return nullptr;
   }
+  if (slots[0] == nullptr) {
+    throw Exception("Expected a sound.", PyExcType::kType);
+  }
+  float volume = slots[1] ? Python::GetPyFloat(slots[1]) : 1.0f;
+  PyObject* pos_obj = slots[2] ? slots[2] : Py_None;
+  bool host_only = slots[3] ? Python::GetPyBool(slots[3]) : false;
 
-  Sound* sound = Python::GetPySound(sound_obj);
+  Sound* sound = Python::GetPySound(slots[0]);
 
   // Can play sounds in a host scene context.
   if (Scene* scene = Context::current().GetMutableScene()) {
@@ -248,25 +329,34 @@ auto PyPlaySound(PyObject* self, PyObject* args, PyObject* keywds)
   BA_PYTHON_CATCH;
 }
 
-auto PyEmitFx(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
+auto PyEmitFx(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+              PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("emit_fx");
   static const char* kwlist[] = {"position",  "velocity",     "count",
                                  "scale",     "spread",       "chunk_type",
                                  "emit_type", "tendril_type", nullptr};
-  PyObject* pos_obj = Py_None;
-  PyObject* vel_obj = Py_None;
-  int count = 10;
-  float scale = 1.0f;
-  float spread = 1.0f;
-  const char* chunk_type_str = "rock";
-  const char* emit_type_str = "chunks";
-  const char* tendril_type_str = "smoke";
+  static PyObject* interned[8];
+  PyObject* slots[8]{};
   assert(InGameThread());
-  if (!PyArg_ParseTupleAndKeywords(
-          args, keywds, "O|Oiffsss", const_cast<char**>(kwlist), &pos_obj,
-          &vel_obj, &count, &scale, &spread, &chunk_type_str, &emit_type_str,
-          &tendril_type_str)) {
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 8, "emitfx")) {
+    return nullptr;
+  }
+  if (slots[0] == nullptr) {
+    throw Exception("Expected a position.", PyExcType::kType);
+  }
+  PyObject* pos_obj = slots[0];
+  PyObject* vel_obj = slots[1] ? slots[1] : Py_None;
+  int count = slots[2] ? static_cast<int>(Python::GetPyInt64(slots[2])) : 10;
+  float scale = slots[3] ? Python::GetPyFloat(slots[3]) : 1.0f;
+  float spread = slots[4] ? Python::GetPyFloat(slots[4]) : 1.0f;
+  const char* chunk_type_str = slots[5] ? PyUnicode_AsUTF8(slots[5]) : "rock";
+  const char* emit_type_str = slots[6] ? PyUnicode_AsUTF8(slots[6]) : "chunks";
+  const char* tendril_type_str =
+      slots[7] ? PyUnicode_AsUTF8(slots[7]) : "smoke";
+  if (chunk_type_str == nullptr || emit_type_str == nullptr
+      || tendril_type_str == nullptr) {
     return nullptr;
   }
   float x, y, z;
@@ -542,6 +632,38 @@ auto PySetDebugSpeedExponent(PyObject* self, PyObject* args) -> PyObject* {
   BA_PYTHON_CATCH;
 }
 
+auto PySetStepChecksumsEnabled(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("set_step_checksums_enabled");
+  int enable;
+  if (!PyArg_ParseTuple(args, "p", &enable)) {
+    return nullptr;
+  }
+  Scene* scene = Context::current().GetMutableScene();
+  if (!scene) {
+    throw Exception(PyExcType::kContext);
+  }
+  scene->set_step_checksums_enabled(static_cast<bool>(enable));
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PyGetStepChecksum(PyObject* self, PyObject* args) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("get_step_checksum");
+  Scene* scene = Context::current().GetMutableScene();
+  if (!scene) {
+    throw Exception(PyExcType::kContext);
+  }
+  if (!scene->step_checksums_enabled()) {
+    throw Exception("Step checksums are not enabled for this scene.");
+  }
+  return Py_BuildValue("(LK)", static_cast<long long>(scene->stepnum()),
+                       static_cast<unsigned long long>(
+                           scene->last_step_checksum()));
+  BA_PYTHON_CATCH;
+}
+
 auto PyGetReplaySpeedExponent(PyObject* self, PyObject* args) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("get_replay_speed_exponent");
@@ -636,6 +758,24 @@ PyMethodDef PythonMethodsGameplay::methods_def[] = {
      "Returns current replay speed value. Actual displayed speed is "
      "pow(2,speed)."},
 
+    {"set_step_checksums_enabled", PySetStepChecksumsEnabled, METH_VARARGS,
+     "set_step_checksums_enabled(enable: bool) -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Enable per-step sim-state checksums for the current scene context.\n"
+     "Same-input runs on the same build must produce identical checksum\n"
+     "sequences; use for determinism verification of replays/refactors."},
+
+    {"get_step_checksum", PyGetStepChecksum, METH_VARARGS,
+     "get_step_checksum() -> tuple[int, int]\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Return (stepnum, checksum) for the current scene context's most\n"
+     "recently completed sim step. Checksums must be enabled via\n"
+     "set_step_checksums_enabled()."},
+
     {"set_debug_speed_exponent", PySetDebugSpeedExponent, METH_VARARGS,
      "set_debug_speed_exponent(speed: int) -> None\n"
      "\n"
@@ -674,7 +814,8 @@ PyMethodDef PythonMethodsGameplay::methods_def[] = {
      "Set map bounds. Generally nodes that go outside of this box are "
      "killed."},
 
-    {"emitfx", (PyCFunction)PyEmitFx, METH_VARARGS | METH_KEYWORDS,
+    {"emitfx", (PyCFunction)(void (*)())PyEmitFx,
+     METH_FASTCALL | METH_KEYWORDS,
      "emitfx(position: Sequence[float],\n"
      "  velocity: Optional[Sequence[float]] = None,\n"
      "  count: int = 10, scale: float = 1.0, spread: float = 1.0,\n"
@@ -690,7 +831,8 @@ PyMethodDef PythonMethodsGameplay::methods_def[] = {
      "Note that the actual amount emitted may vary depending on graphics\n"
      "settings, exiting element counts, or other factors."},
 
-    {"playsound", (PyCFunction)PyPlaySound, METH_VARARGS | METH_KEYWORDS,
+    {"playsound", (PyCFunction)(void (*)())PyPlaySound,
+     METH_FASTCALL | METH_KEYWORDS,
      "playsound(sound: Sound, volume: float = 1.0,\n"
      "  position: Sequence[float] = None, host_only: bool = False) -> None\n"
      "\n"
@@ -701,7 +843,8 @@ PyMethodDef PythonMethodsGameplay::methods_def[] = {
      "If position is not provided, the sound will be at a constant volume\n"
      "everywhere.  Position should be a float tuple of size 3."},
 
-    {"camerashake", (PyCFunction)PyCameraShake, METH_VARARGS | METH_KEYWORDS,
+    {"camerashake", (PyCFunction)(void (*)())PyCameraShake,
+     METH_FASTCALL | METH_KEYWORDS,
      "camerashake(intensity: float = 1.0) -> None\n"
      "\n"
      "Shake the camera.\n"
@@ -723,14 +866,14 @@ PyMethodDef PythonMethodsGameplay::methods_def[] = {
      "depth, nodes involved, etc. Only call this in the handler of a\n"
      "collision-triggered callback or message"},
 
-    {"getnodes", PyGetNodes, METH_VARARGS,
+    {"getnodes", PyGetNodes, METH_NOARGS,
      "getnodes() -> list\n"
      "\n"
      "Return all nodes in the current ba.Context."
      "\n"
      "Category: Gameplay Functions"},
 
-    {"printnodes", PyPrintNodes, METH_VARARGS,
+    {"printnodes", PyPrintNodes, METH_NOARGS,
      "printnodes() -> None\n"
      "\n"
      "Print various info about existing nodes; useful for debugging.\n"
@@ -760,6 +903,31 @@ PyMethodDef PythonMethodsGameplay::methods_def[] = {
      "if 'owner' is provided, the node will be automatically killed when that\n"
      "object dies. 'owner' can be another node or a ba.Actor"},
 
+    {"oscillate_node_attr", (PyCFunction)PyOscillateNodeAttr,
+     METH_VARARGS | METH_KEYWORDS,
+     "oscillate_node_attr(node: ba.Node, attr: str, base: float,\n"
+     "  amplitude: float, period: int, style: str = 'sine') -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Drive a float node attr natively from scene stepping instead of a\n"
+     "Python timer: value = base + amplitude * wave(scene_time / period).\n"
+     "Styles are 'sine', 'square', 'triangle', and 'sawtooth'. Calling\n"
+     "again for the same node/attr replaces the repeater; a period of 0\n"
+     "removes it. Repeaters go away with their node."},
+
+    {"set_node_attrs", (PyCFunction)(void (*)())PySetNodeAttrs,
+     METH_FASTCALL | METH_KEYWORDS,
+     "set_node_attrs(nodes: Union[ba.Node, Sequence[ba.Node]],\n"
+     "  attrs: dict) -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Set multiple attributes on a node (or on each of a sequence of nodes)\n"
+     "in a single call. The target nodes are validated once up front, so\n"
+     "this is noticeably cheaper than setting attrs one at a time when\n"
+     "updating many values per tick."},
+
     {nullptr, nullptr, 0, nullptr}};
 
 #pragma clang diagnostic pop
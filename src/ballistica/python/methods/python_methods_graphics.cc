@@ -17,15 +17,21 @@ namespace ballistica {
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "hicpp-signed-bitwise"
 
-auto PyCharStr(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
+auto PyCharStr(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+               PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("charstr");
-  PyObject* name_obj;
   static const char* kwlist[] = {"name", nullptr};
-  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
-                                   const_cast<char**>(kwlist), &name_obj)) {
+  static PyObject* interned[1];
+  PyObject* slots[1]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 1, "charstr")) {
     return nullptr;
   }
+  PyObject* name_obj = slots[0];
+  if (name_obj == nullptr) {
+    throw Exception("Expected a name.", PyExcType::kType);
+  }
   assert(g_game);
   auto id(Python::GetPyEnum_SpecialChar(name_obj));
   assert(Utils::IsValidUTF8(g_game->CharStr(id)));
@@ -33,19 +39,23 @@ auto PyCharStr(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
   BA_PYTHON_CATCH;
 }
 
-auto PySafeColor(PyObject* self, PyObject* args, PyObject* keywds)
-    -> PyObject* {
+auto PySafeColor(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+                 PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("safecolor");
-  PyObject* color_obj;
   float red, green, blue;
-  float target_intensity = 0.6f;
   static const char* kwlist[] = {"color", "target_intensity", nullptr};
-  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|f",
-                                   const_cast<char**>(kwlist), &color_obj,
-                                   &target_intensity)) {
+  static PyObject* interned[2];
+  PyObject* slots[2]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 2, "safecolor")) {
     return nullptr;
   }
+  PyObject* color_obj = slots[0];
+  if (color_obj == nullptr) {
+    throw Exception("Expected a color.", PyExcType::kType);
+  }
+  float target_intensity = slots[1] ? Python::GetPyFloat(slots[1]) : 0.6f;
   if (!PySequence_Check(color_obj)) {
     throw Exception("Expected a sequence.", PyExcType::kType);
   }
@@ -84,14 +94,22 @@ auto PyGetMaxGraphicsQuality(PyObject* self, PyObject* args) -> PyObject* {
   BA_PYTHON_CATCH;
 }
 
-auto PyEvaluateLstr(PyObject* self, PyObject* args, PyObject* keywds)
-    -> PyObject* {
+auto PyEvaluateLstr(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+                    PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("evaluate_lstr");
-  const char* value;
   static const char* kwlist[] = {"value", nullptr};
-  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s",
-                                   const_cast<char**>(kwlist), &value)) {
+  static PyObject* interned[1];
+  PyObject* slots[1]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 1, "evaluate_lstr")) {
+    return nullptr;
+  }
+  if (slots[0] == nullptr || !PyUnicode_Check(slots[0])) {
+    throw Exception("Expected a string value.", PyExcType::kType);
+  }
+  const char* value = PyUnicode_AsUTF8(slots[0]);
+  if (value == nullptr) {
     return nullptr;
   }
   return PyUnicode_FromString(
@@ -99,19 +117,23 @@ auto PyEvaluateLstr(PyObject* self, PyObject* args, PyObject* keywds)
   BA_PYTHON_CATCH;
 }
 
-auto PyGetStringHeight(PyObject* self, PyObject* args, PyObject* keywds)
-    -> PyObject* {
+auto PyGetStringHeight(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+                       PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("get_string_height");
   std::string s;
-  int suppress_warning = 0;
-  PyObject* s_obj;
   static const char* kwlist[] = {"string", "suppress_warning", nullptr};
-  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i",
-                                   const_cast<char**>(kwlist), &s_obj,
-                                   &suppress_warning)) {
+  static PyObject* interned[2];
+  PyObject* slots[2]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 2, "get_string_height")) {
     return nullptr;
   }
+  PyObject* s_obj = slots[0];
+  if (s_obj == nullptr) {
+    throw Exception("Expected a string.", PyExcType::kType);
+  }
+  bool suppress_warning = slots[1] ? Python::GetPyBool(slots[1]) : false;
   if (!suppress_warning) {
     BA_LOG_PYTHON_TRACE(
         "get_string_height() use is heavily discouraged as it reduces "
@@ -130,19 +152,23 @@ auto PyGetStringHeight(PyObject* self, PyObject* args, PyObject* keywds)
   BA_PYTHON_CATCH;
 }
 
-auto PyGetStringWidth(PyObject* self, PyObject* args, PyObject* keywds)
-    -> PyObject* {
+auto PyGetStringWidth(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+                      PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("get_string_width");
   std::string s;
-  PyObject* s_obj;
-  int suppress_warning = 0;
   static const char* kwlist[] = {"string", "suppress_warning", nullptr};
-  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|i",
-                                   const_cast<char**>(kwlist), &s_obj,
-                                   &suppress_warning)) {
+  static PyObject* interned[2];
+  PyObject* slots[2]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 2, "get_string_width")) {
     return nullptr;
   }
+  PyObject* s_obj = slots[0];
+  if (s_obj == nullptr) {
+    throw Exception("Expected a string.", PyExcType::kType);
+  }
+  bool suppress_warning = slots[1] ? Python::GetPyBool(slots[1]) : false;
   if (!suppress_warning) {
     BA_LOG_PYTHON_TRACE(
         "get_string_width() use is heavily discouraged as it reduces "
@@ -161,18 +187,22 @@ auto PyGetStringWidth(PyObject* self, PyObject* args, PyObject* keywds)
   BA_PYTHON_CATCH;
 }
 
-auto PyHaveChars(PyObject* self, PyObject* args, PyObject* keywds)
-    -> PyObject* {
+auto PyHaveChars(PyObject* self, PyObject* const* args, Py_ssize_t nargs,
+                 PyObject* kwnames) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("have_chars");
   std::string text;
-  PyObject* text_obj;
   static const char* kwlist[] = {"text", nullptr};
-  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O",
-                                   const_cast<char**>(kwlist), &text_obj)) {
+  static PyObject* interned[1];
+  PyObject* slots[1]{};
+  if (!PythonCollectFastcallArgs(args, nargs, kwnames, kwlist, interned,
+                                 slots, 1, "have_chars")) {
     return nullptr;
   }
-  text = Python::GetPyString(text_obj);
+  if (slots[0] == nullptr) {
+    throw Exception("Expected a text arg.", PyExcType::kType);
+  }
+  text = Python::GetPyString(slots[0]);
   if (TextGraphics::HaveChars(text)) {
     Py_RETURN_TRUE;
   } else {
@@ -224,7 +254,7 @@ auto PyGetDisplayResolution(PyObject* self, PyObject* args) -> PyObject* {
 }
 
 PyMethodDef PythonMethodsGraphics::methods_def[] = {
-    {"get_display_resolution", PyGetDisplayResolution, METH_VARARGS,
+    {"get_display_resolution", PyGetDisplayResolution, METH_NOARGS,
      "get_display_resolution() -> Optional[Tuple[int, int]]\n"
      "\n"
      "(internal)\n"
@@ -232,7 +262,7 @@ PyMethodDef PythonMethodsGraphics::methods_def[] = {
      "Return the currently selected display resolution for fullscreen\n"
      "display. Returns None if resolutions cannot be directly set."},
 
-    {"has_gamma_control", PyHasGammaControl, METH_VARARGS,
+    {"has_gamma_control", PyHasGammaControl, METH_NOARGS,
      "has_gamma_control() -> bool\n"
      "\n"
      "(internal)\n"
@@ -249,13 +279,14 @@ PyMethodDef PythonMethodsGraphics::methods_def[] = {
      "been rendered. Useful for queueing things to load in the background\n"
      "without elongating any current progress-bar-load."},
 
-    {"have_chars", (PyCFunction)PyHaveChars, METH_VARARGS | METH_KEYWORDS,
+    {"have_chars", (PyCFunction)(void (*)())PyHaveChars,
+     METH_FASTCALL | METH_KEYWORDS,
      "have_chars(text: str) -> bool\n"
      "\n"
      "(internal)"},
 
-    {"get_string_width", (PyCFunction)PyGetStringWidth,
-     METH_VARARGS | METH_KEYWORDS,
+    {"get_string_width", (PyCFunction)(void (*)())PyGetStringWidth,
+     METH_FASTCALL | METH_KEYWORDS,
      "get_string_width(string: str, suppress_warning: bool = False) -> float\n"
      "\n"
      "(internal)\n"
@@ -263,8 +294,8 @@ PyMethodDef PythonMethodsGraphics::methods_def[] = {
      "Given a string, returns its width using the standard small app\n"
      "font."},
 
-    {"get_string_height", (PyCFunction)PyGetStringHeight,
-     METH_VARARGS | METH_KEYWORDS,
+    {"get_string_height", (PyCFunction)(void (*)())PyGetStringHeight,
+     METH_FASTCALL | METH_KEYWORDS,
      "get_string_height(string: str, suppress_warning: bool = False) -> float\n"
      "\n"
      "(internal)\n"
@@ -272,19 +303,21 @@ PyMethodDef PythonMethodsGraphics::methods_def[] = {
      "Given a string, returns its height using the standard small app\n"
      "font."},
 
-    {"evaluate_lstr", (PyCFunction)PyEvaluateLstr, METH_VARARGS | METH_KEYWORDS,
+    {"evaluate_lstr", (PyCFunction)(void (*)())PyEvaluateLstr,
+     METH_FASTCALL | METH_KEYWORDS,
      "evaluate_lstr(value: str) -> str\n"
      "\n"
      "(internal)"},
 
-    {"get_max_graphics_quality", PyGetMaxGraphicsQuality, METH_VARARGS,
+    {"get_max_graphics_quality", PyGetMaxGraphicsQuality, METH_NOARGS,
      "get_max_graphics_quality() -> str\n"
      "\n"
      "(internal)\n"
      "\n"
      "Return the max graphics-quality supported on the current hardware."},
 
-    {"safecolor", (PyCFunction)PySafeColor, METH_VARARGS | METH_KEYWORDS,
+    {"safecolor", (PyCFunction)(void (*)())PySafeColor,
+     METH_FASTCALL | METH_KEYWORDS,
      "safecolor(color: Sequence[float], target_intensity: float = 0.6)\n"
      "  -> Tuple[float, ...]\n"
      "\n"
@@ -295,7 +328,8 @@ PyMethodDef PythonMethodsGraphics::methods_def[] = {
      "Accepts tuples of length 3 or 4. This will slightly brighten very\n"
      "dark colors, etc."},
 
-    {"charstr", (PyCFunction)PyCharStr, METH_VARARGS | METH_KEYWORDS,
+    {"charstr", (PyCFunction)(void (*)())PyCharStr,
+     METH_FASTCALL | METH_KEYWORDS,
      "charstr(char_id: ba.SpecialChar) -> str\n"
      "\n"
      "Get a unicode string representing a special character.\n"
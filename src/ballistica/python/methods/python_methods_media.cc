@@ -15,6 +15,13 @@
 #include "ballistica/media/component/model.h"
 #include "ballistica/media/component/sound.h"
 #include "ballistica/media/component/texture.h"
+#include "ballistica/media/data/sound_data.h"
+#include "ballistica/media/media.h"
+#include "ballistica/python/class/python_class_collide_model.h"
+#include "ballistica/python/class/python_class_data.h"
+#include "ballistica/python/class/python_class_model.h"
+#include "ballistica/python/class/python_class_sound.h"
+#include "ballistica/python/class/python_class_texture.h"
 #include "ballistica/python/python.h"
 #include "ballistica/ui/ui.h"
 
@@ -362,7 +369,156 @@ auto PyIsOSPlayingMusic(PyObject* self, PyObject* args, PyObject* keywds)
   BA_PYTHON_CATCH;
 }
 
+auto PySetMediaLoadHints(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("setmedialoadhints");
+  PyObject* media_obj;
+  float priority = 0.0f;
+  int in_background = 1;
+  static const char* kwlist[] = {"media", "priority", "in_background",
+                                 nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "O|fp",
+                                   const_cast<char**>(kwlist), &media_obj,
+                                   &priority, &in_background)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(InGameThread());
+
+  // Accept either a single media object or a sequence of them.
+  PyObject* seq = PySequence_Fast(media_obj, "expected a media object "
+                                             "or sequence of media objects");
+  if (seq == nullptr) {
+    PyErr_Clear();
+    seq = Py_BuildValue("(O)", media_obj);
+    BA_PRECONDITION(seq != nullptr);
+  }
+  Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+  for (Py_ssize_t i = 0; i < count; i++) {
+    PyObject* o = PySequence_Fast_GET_ITEM(seq, i);
+    MediaComponentData* data{};
+    if (PythonClassTexture::Check(o)) {
+      data = ((PythonClassTexture*)o)->GetTexture()->texture_data();
+    } else if (PythonClassModel::Check(o)) {
+      data = ((PythonClassModel*)o)->GetModel()->model_data();
+    } else if (PythonClassSound::Check(o)) {
+      data = ((PythonClassSound*)o)->GetSound()->GetSoundData();
+    } else if (PythonClassCollideModel::Check(o)) {
+      data = ((PythonClassCollideModel*)o)
+                 ->GetCollideModel()
+                 ->collide_model_data();
+    } else if (PythonClassData::Check(o)) {
+      data = ((PythonClassData*)o)->GetData()->data_data();
+    } else {
+      Py_DECREF(seq);
+      throw Exception("Object is not a media component.");
+    }
+    if (data) {
+      data->set_load_priority(priority);
+      data->set_loads_in_background(static_cast<bool>(in_background));
+    }
+  }
+  Py_DECREF(seq);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
+auto PyTrimMediaCaches(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("trimmediacaches");
+  long long max_bytes;  // NOLINT: python wants long long.
+  static const char* kwlist[] = {"max_bytes", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "L",
+                                   const_cast<char**>(kwlist), &max_bytes)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(InGameThread());
+  assert(g_media);
+  if (max_bytes < 0) {
+    max_bytes = 0;
+  }
+  {
+    // Unloading media is engine-side work; no need to hold the GIL.
+    ScopedAllowThreads allow_threads;
+    g_media->TrimMediaMemory(static_cast<size_t>(max_bytes));
+  }
+  return PyLong_FromUnsignedLongLong(g_media->GetTotalMediaMemoryUse());
+  BA_PYTHON_CATCH;
+}
+
+auto PyPinSessionMedia(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("pin_session_media");
+  const char* media_type;
+  const char* name;
+  static const char* kwlist[] = {"media_type", "name", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "ss",
+                                   const_cast<char**>(kwlist), &media_type,
+                                   &name)) {
+    return nullptr;
+  }
+  BA_PRECONDITION(InGameThread());
+  assert(g_media);
+  Media::FileType file_type;
+  if (!strcmp(media_type, "texture")) {
+    file_type = Media::FileType::kTexture;
+  } else if (!strcmp(media_type, "model")) {
+    file_type = Media::FileType::kModel;
+  } else if (!strcmp(media_type, "collide_model")) {
+    file_type = Media::FileType::kCollisionModel;
+  } else if (!strcmp(media_type, "sound")) {
+    file_type = Media::FileType::kSound;
+  } else if (!strcmp(media_type, "data")) {
+    file_type = Media::FileType::kData;
+  } else {
+    throw Exception(
+        "Invalid media_type: '" + std::string(media_type) + "'.",
+        PyExcType::kValue);
+  }
+  g_media->PinSessionMedia(file_type, name);
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
 PyMethodDef PythonMethodsMedia::methods_def[] = {
+    {"pin_session_media", (PyCFunction)PyPinSessionMedia,
+     METH_VARARGS | METH_KEYWORDS,
+     "pin_session_media(media_type: str, name: str) -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Keep a named piece of media loaded for the rest of the current\n"
+     "session. Pinned media survives map rotation instead of unloading\n"
+     "with each activity's scene, so sets common to every map (character\n"
+     "models, standard bomb textures, ui sounds) skip the between-round\n"
+     "reload. media_type must be one of 'texture', 'model',\n"
+     "'collide_model', 'sound' or 'data'. All pins release when the\n"
+     "session ends."},
+    {"set_media_load_hints", (PyCFunction)PySetMediaLoadHints,
+     METH_VARARGS | METH_KEYWORDS,
+     "set_media_load_hints(media: Any, priority: float = 0.0,\n"
+     "  in_background: bool = True) -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Tag a media component (or sequence of them) for streaming.\n"
+     "Background-tagged media doesn't hold up the level-load screen and\n"
+     "loads behind the scenes; higher priority values load sooner, so\n"
+     "scripts can order far-off media by distance to the action while\n"
+     "leaving spawn-area media blocking as usual."},
+
+    {"trim_media_caches", (PyCFunction)PyTrimMediaCaches,
+     METH_VARARGS | METH_KEYWORDS,
+     "trim_media_caches(max_bytes: int) -> int\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Evict least-recently-used unreferenced media until the total\n"
+     "estimated media memory is at or under max_bytes. System media is\n"
+     "never evicted. Returns the remaining estimated byte count."},
+
     {"is_os_playing_music", (PyCFunction)PyIsOSPlayingMusic,
      METH_VARARGS | METH_KEYWORDS,
      "is_os_playing_music() -> bool\n"
@@ -10,17 +10,23 @@
 #include "ballistica/app/app.h"
 #include "ballistica/app/app_config.h"
 #include "ballistica/app/app_globals.h"
+#include "ballistica/core/alloc_tracker.h"
 #include "ballistica/game/game_stream.h"
 #include "ballistica/game/host_activity.h"
 #include "ballistica/game/session/host_session.h"
 #include "ballistica/game/session/replay_client_session.h"
 #include "ballistica/graphics/camera.h"
 #include "ballistica/graphics/graphics.h"
+#include "ballistica/graphics/graphics_server.h"
 #include "ballistica/input/input.h"
+#include "ballistica/input/input_latency_meter.h"
+#include "ballistica/game/game.h"
 #include "ballistica/media/component/texture.h"
 #include "ballistica/media/media.h"
+#include "ballistica/networking/http_client_module.h"
 #include "ballistica/platform/platform.h"
 #include "ballistica/python/python.h"
+#include "ballistica/python/python_context_call.h"
 #include "ballistica/python/python_context_call_runnable.h"
 #include "ballistica/scene/scene.h"
 
@@ -268,6 +274,64 @@ auto PyValueTest(PyObject* self, PyObject* args, PyObject* keywds)
       g_graphics->set_show_net_info(static_cast<bool>(absolute));
     }
     return_val = g_graphics->show_net_info();
+  } else if (!strcmp(arg, "showGPUStats")) {
+    if (have_change && change > 0.5f) {
+      g_graphics->set_show_gpu_stats(true);
+    }
+    if (have_change && change < -0.5f) {
+      g_graphics->set_show_gpu_stats(false);
+    }
+    if (have_absolute) {
+      g_graphics->set_show_gpu_stats(static_cast<bool>(absolute));
+    }
+    return_val = g_graphics->show_gpu_stats();
+  } else if (!strcmp(arg, "showFrameLedger")) {
+    if (have_change && change > 0.5f) {
+      g_graphics->set_show_frame_ledger(true);
+    }
+    if (have_change && change < -0.5f) {
+      g_graphics->set_show_frame_ledger(false);
+    }
+    if (have_absolute) {
+      g_graphics->set_show_frame_ledger(static_cast<bool>(absolute));
+    }
+    return_val = g_graphics->show_frame_ledger();
+  } else if (!strcmp(arg, "frameLedgerLanes")) {
+    // Bitmask of visible lanes (bit per FrameLedger::Lane); relative
+    // changes toggle the lane whose index is the change's magnitude.
+    if (have_change) {
+      auto lane = static_cast<uint32_t>(std::abs(change));
+      g_graphics->set_frame_ledger_lane_mask(
+          g_graphics->frame_ledger_lane_mask() ^ (1u << lane));
+    }
+    if (have_absolute) {
+      g_graphics->set_frame_ledger_lane_mask(
+          static_cast<uint32_t>(absolute));
+    }
+    return_val = g_graphics->frame_ledger_lane_mask();
+  } else if (!strcmp(arg, "inputLatencyTracking")) {
+    if (have_change && change > 0.5f) {
+      InputLatencyMeter::set_enabled(true);
+    }
+    if (have_change && change < -0.5f) {
+      InputLatencyMeter::set_enabled(false);
+    }
+    if (have_absolute) {
+      InputLatencyMeter::set_enabled(static_cast<bool>(absolute));
+    }
+    return_val = InputLatencyMeter::enabled();
+  } else if (!strcmp(arg, "frameQueueDepth")) {
+    if (g_graphics_server) {
+      if (have_change) {
+        g_graphics_server->SetFrameQueueDepth(
+            g_graphics_server->frame_queue_depth()
+            + (change > 0.0f ? 1 : -1));
+      }
+      if (have_absolute) {
+        g_graphics_server->SetFrameQueueDepth(static_cast<int>(absolute));
+      }
+      return_val = g_graphics_server->frame_queue_depth();
+    }
   } else if (!strcmp(arg, "allowCameraMovement")) {
     Camera* camera = g_graphics->camera();
     if (camera) {
@@ -346,6 +410,32 @@ auto PyPrintLoadInfo(PyObject* self, PyObject* args, PyObject* keywds)
   BA_PYTHON_CATCH;
 }
 
+auto PyGetSceneMemoryReport(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("get_scene_memory_report");
+  return PyUnicode_FromString(g_media->GetSceneMemoryReport().c_str());
+  BA_PYTHON_CATCH;
+}
+
+auto PyGetAllocTallies(PyObject* self) -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("get_alloc_tallies");
+  if (!AllocTracker::enabled()) {
+    Py_RETURN_NONE;
+  }
+  PyObject* dict = PyDict_New();
+  for (int i = 0; i < AllocTracker::kTagCount; i++) {
+    auto tag = static_cast<AllocTracker::Tag>(i);
+    PyObject* entry = Py_BuildValue(
+        "{sLsL}", "bytes", static_cast<long long>(AllocTracker::Bytes(tag)),
+        "count", static_cast<long long>(AllocTracker::Count(tag)));
+    PyDict_SetItemString(dict, AllocTracker::TagName(tag), entry);
+    Py_DECREF(entry);
+  }
+  return dict;
+  BA_PYTHON_CATCH;
+}
+
 auto PyGetReplaysDir(PyObject* self, PyObject* args, PyObject* keywds)
     -> PyObject* {
   BA_PYTHON_TRY;
@@ -515,6 +605,9 @@ auto PyGetLog(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
   Platform::SetLastPyCall("get_log");
   std::string log_fin;
   {
+    // The log can be sizable and the mutex contended; don't make other
+    // Python threads wait on the copy.
+    ScopedAllowThreads allow_threads;
     std::lock_guard<std::mutex> lock(g_app_globals->log_mutex);
     log_fin = g_app_globals->log;
   }
@@ -717,6 +810,21 @@ auto PyPrintObjects(PyObject* self, PyObject* args, PyObject* keywds)
   BA_PYTHON_CATCH;
 }
 
+auto PyGetPyCallCounts(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("get_py_call_counts");
+  PyObject* dict = PyDict_New();
+  if (g_platform) {
+    for (auto&& i : g_platform->py_call_counts()) {
+      PythonRef count(PyLong_FromLongLong(i.second), PythonRef::kSteal);
+      PyDict_SetItemString(dict, i.first.c_str(), count.get());
+    }
+  }
+  return dict;
+  BA_PYTHON_CATCH;
+}
+
 auto PyDoOnce(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("do_once");
@@ -727,6 +835,61 @@ auto PyDoOnce(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
   BA_PYTHON_CATCH;
 }
 
+auto PyHTTPRequest(PyObject* self, PyObject* args, PyObject* keywds)
+    -> PyObject* {
+  BA_PYTHON_TRY;
+  Platform::SetLastPyCall("http_request");
+  assert(InGameThread());
+  const char* url;
+  const char* method = "GET";
+  const char* data = "";
+  PyObject* callback_obj = Py_None;
+  static const char* kwlist[] = {"url", "callback", "method", "data", nullptr};
+  if (!PyArg_ParseTupleAndKeywords(args, keywds, "s|Oss",
+                                   const_cast<char**>(kwlist), &url,
+                                   &callback_obj, &method, &data)) {
+    return nullptr;
+  }
+  HttpClientModule::Request request;
+  request.url = url;
+  request.method = method;
+  request.data = data;
+  if (callback_obj == Py_None) {
+    g_http_client_module->PushRequestCall(
+        request, g_game, [](const HttpClientModule::Response&) {});
+  } else {
+    // Refs to the context-call can only be created/destroyed in the game
+    // thread, so hand the lambda a raw heap pointer and free it when the
+    // callback fires back here.
+    auto* call_ref = new Object::Ref<PythonContextCall>(
+        Object::New<PythonContextCall>(callback_obj));
+    g_http_client_module->PushRequestCall(
+        request, g_game,
+        [call_ref](const HttpClientModule::Response& response) {
+          assert(InGameThread());
+          PythonRef result(PyDict_New(), PythonRef::kSteal);
+          PythonRef success(
+              PyBool_FromLong(response.success ? 1 : 0), PythonRef::kSteal);
+          PyDict_SetItemString(result.get(), "success", success.get());
+          PythonRef status(PyLong_FromLong(response.status_code),
+                           PythonRef::kSteal);
+          PyDict_SetItemString(result.get(), "status_code", status.get());
+          PythonRef body(PyBytes_FromStringAndSize(
+                             response.body.data(),
+                             static_cast<Py_ssize_t>(response.body.size())),
+                         PythonRef::kSteal);
+          PyDict_SetItemString(result.get(), "body", body.get());
+          PythonRef error(PyUnicode_FromString(response.error.c_str()),
+                          PythonRef::kSteal);
+          PyDict_SetItemString(result.get(), "error", error.get());
+          (**call_ref).RunWithArg(result.get());
+          delete call_ref;
+        });
+  }
+  Py_RETURN_NONE;
+  BA_PYTHON_CATCH;
+}
+
 auto PyApp(PyObject* self, PyObject* args, PyObject* keywds) -> PyObject* {
   BA_PYTHON_TRY;
   Platform::SetLastPyCall("app");
@@ -751,6 +914,15 @@ PyMethodDef PythonMethodsSystem::methods_def[] = {
      "This call only functions in debug builds of the game.\n"
      "It prints various info about the current object count, etc."},
 
+    {"get_py_call_counts", (PyCFunction)PyGetPyCallCounts,
+     METH_VARARGS | METH_KEYWORDS,
+     "get_py_call_counts() -> Dict[str, int]\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Return per-method call counts for our native bindings; used to\n"
+     "find which ones are hot enough to deserve fast-path treatment."},
+
     {"do_once", (PyCFunction)PyDoOnce, METH_VARARGS | METH_KEYWORDS,
      "do_once() -> bool\n"
      "\n"
@@ -773,6 +945,17 @@ PyMethodDef PythonMethodsSystem::methods_def[] = {
      "\n"
      "(internal)"},
 
+    {"http_request", (PyCFunction)PyHTTPRequest, METH_VARARGS | METH_KEYWORDS,
+     "http_request(url: str, callback: Callable = None,\n"
+     "  method: str = 'GET', data: str = '') -> None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Run an http request on the native http-client thread. The callback\n"
+     "fires in the game thread with a dict containing 'success',\n"
+     "'status_code', 'body', and 'error'. Only http:// urls are\n"
+     "supported; use the standard Python machinery for https."},
+
     {"android_media_scan_file", (PyCFunction)PyAndroidMediaScanFile,
      METH_VARARGS | METH_KEYWORDS,
      "android_media_scan_file(file_name: str) -> None\n"
@@ -919,6 +1102,28 @@ PyMethodDef PythonMethodsSystem::methods_def[] = {
      "\n"
      "Category: General Utility Functions"},
 
+    {"get_scene_memory_report", (PyCFunction)PyGetSceneMemoryReport,
+     METH_NOARGS,
+     "get_scene_memory_report() -> str\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Return a json report walking the live scene and media lists:\n"
+     "per-texture dimensions/format/bytes, model vertex/index counts,\n"
+     "collide-model and sound sizes, and node counts by type, grouped\n"
+     "by owning session/activity plus a global section."},
+
+    {"get_alloc_tallies", (PyCFunction)PyGetAllocTallies, METH_NOARGS,
+     "get_alloc_tallies() -> dict | None\n"
+     "\n"
+     "(internal)\n"
+     "\n"
+     "Return live per-subsystem allocation tallies as\n"
+     "{tag: {'bytes': int, 'count': int}}, or None on builds without\n"
+     "alloc tracking compiled in. Unlike get_scene_memory_report this\n"
+     "walks nothing; it's cheap enough to poll every few seconds in\n"
+     "production to watch for creep and trigger trims."},
+
     {"print_context", (PyCFunction)PyPrintContext, METH_VARARGS | METH_KEYWORDS,
      "print_context() -> None\n"
      "\n"
@@ -11,6 +11,7 @@
 #include "ballistica/audio/audio.h"
 #include "ballistica/dynamics/material/material.h"
 #include "ballistica/game/account.h"
+#include "ballistica/game/connection/connection_stats.h"
 #include "ballistica/game/friend_score_set.h"
 #include "ballistica/game/game_stream.h"
 #include "ballistica/game/host_activity.h"
@@ -593,10 +594,138 @@ auto Python::GetPyDouble(PyObject* o) -> double {
       PyExcType::kType);
 }
 
+// Bulk-copy a contiguous 1-d buffer of numeric values into a vector,
+// converting item-by-item only at the raw-memory level (no Python
+// object round trips). Returns false for formats/shapes we don't
+// handle, in which case callers fall back to the sequence path.
+template <typename T>
+static auto GetNumericBufferValues(const Py_buffer* view, std::vector<T>* vals)
+    -> bool {
+  if (view->ndim > 1 || view->itemsize <= 0) {
+    return false;
+  }
+  const char* fmt = view->format;
+  if (fmt == nullptr) {
+    return false;
+  }
+  // Skip a byte-order prefix if it's native-order.
+  if (*fmt == '@' || *fmt == '=') {
+    fmt++;
+  }
+  if (fmt[0] == '\0' || fmt[1] != '\0') {
+    return false;
+  }
+  auto count = static_cast<size_t>(view->len / view->itemsize);
+  vals->resize(count);
+  const char* src = static_cast<const char*>(view->buf);
+  switch (*fmt) {
+    case 'f':
+      for (size_t i = 0; i < count; i++) {
+        (*vals)[i] =
+            static_cast<T>(reinterpret_cast<const float*>(src)[i]);
+      }
+      return true;
+    case 'd':
+      for (size_t i = 0; i < count; i++) {
+        (*vals)[i] =
+            static_cast<T>(reinterpret_cast<const double*>(src)[i]);
+      }
+      return true;
+    case 'b':
+      for (size_t i = 0; i < count; i++) {
+        (*vals)[i] =
+            static_cast<T>(reinterpret_cast<const int8_t*>(src)[i]);
+      }
+      return true;
+    case 'B':
+      for (size_t i = 0; i < count; i++) {
+        (*vals)[i] =
+            static_cast<T>(reinterpret_cast<const uint8_t*>(src)[i]);
+      }
+      return true;
+    case 'h':
+      for (size_t i = 0; i < count; i++) {
+        (*vals)[i] =
+            static_cast<T>(reinterpret_cast<const int16_t*>(src)[i]);
+      }
+      return true;
+    case 'H':
+      for (size_t i = 0; i < count; i++) {
+        (*vals)[i] =
+            static_cast<T>(reinterpret_cast<const uint16_t*>(src)[i]);
+      }
+      return true;
+    case 'i':
+    case 'l':
+    case 'q': {
+      switch (view->itemsize) {
+        case 4:
+          for (size_t i = 0; i < count; i++) {
+            (*vals)[i] =
+                static_cast<T>(reinterpret_cast<const int32_t*>(src)[i]);
+          }
+          return true;
+        case 8:
+          for (size_t i = 0; i < count; i++) {
+            (*vals)[i] =
+                static_cast<T>(reinterpret_cast<const int64_t*>(src)[i]);
+          }
+          return true;
+        default:
+          return false;
+      }
+    }
+    case 'I':
+    case 'L':
+    case 'Q': {
+      switch (view->itemsize) {
+        case 4:
+          for (size_t i = 0; i < count; i++) {
+            (*vals)[i] =
+                static_cast<T>(reinterpret_cast<const uint32_t*>(src)[i]);
+          }
+          return true;
+        case 8:
+          for (size_t i = 0; i < count; i++) {
+            (*vals)[i] =
+                static_cast<T>(reinterpret_cast<const uint64_t*>(src)[i]);
+          }
+          return true;
+        default:
+          return false;
+      }
+    }
+    default:
+      return false;
+  }
+}
+
+// Try pulling values out of an object via the buffer protocol; numpy
+// arrays, array.array, and memoryviews land here and skip the
+// per-element Python conversions entirely.
+template <typename T>
+static auto GetPyValuesViaBuffer(PyObject* o, std::vector<T>* vals) -> bool {
+  if (!PyObject_CheckBuffer(o)) {
+    return false;
+  }
+  Py_buffer view;
+  if (PyObject_GetBuffer(o, &view, PyBUF_CONTIG_RO | PyBUF_FORMAT) != 0) {
+    PyErr_Clear();
+    return false;
+  }
+  bool success = GetNumericBufferValues(&view, vals);
+  PyBuffer_Release(&view);
+  return success;
+}
+
 auto Python::GetPyFloats(PyObject* o) -> std::vector<float> {
   assert(HaveGIL());
   BA_PRECONDITION_FATAL(o != nullptr);
 
+  std::vector<float> buffer_vals;
+  if (GetPyValuesViaBuffer(o, &buffer_vals)) {
+    return buffer_vals;
+  }
   if (!PySequence_Check(o)) {
     throw Exception("Object is not a sequence.", PyExcType::kType);
   }
@@ -636,6 +765,10 @@ auto GetPyIntsT(PyObject* o) -> std::vector<T> {
   assert(Python::HaveGIL());
   BA_PRECONDITION_FATAL(o != nullptr);
 
+  std::vector<T> buffer_vals;
+  if (GetPyValuesViaBuffer(o, &buffer_vals)) {
+    return buffer_vals;
+  }
   if (!PySequence_Check(o)) {
     throw Exception("Object is not a sequence.", PyExcType::kType);
   }
@@ -930,6 +1063,18 @@ void Python::Reset(bool do_init) {
 
     AppInternalInitModule();
 
+#if BA_ENABLE_FROZEN_PYTHON
+    // Bake the core script tree into the binary as frozen modules so boot
+    // doesn't pay for stat/read/unmarshal traffic across the whole ba/bs
+    // package (over a second on some mobile hardware). The table comes out
+    // of the build from the same script set that would otherwise ship as
+    // .py files. Builds without this flag keep importing from the
+    // filesystem, which is what we want for dev where scripts should stay
+    // editable in place.
+#include "generated/ballistica/frozen_modules.inc"
+    PyImport_FrozenModules = ballistica_frozen_modules;
+#endif  // BA_ENABLE_FROZEN_PYTHON
+
     Py_Initialize();
 
     PyObject* m;
@@ -1155,6 +1300,51 @@ void Python::HandleLocalChatMessage(const std::string& message) {
   obj(ObjID::kHandleLocalChatMessageCall).Call(args);
 }
 
+void Python::HandleClientConnectionStats(const ConnectionStats& stats,
+                                         const std::string& peer_desc) {
+  assert(InGameThread());
+  if (!objexists(ObjID::kClientConnectionStatsCall)) {
+    return;
+  }
+  ScopedSetContext cp(g_game->GetUIContext());
+
+  // Sparse dicts for the per-type byte tallies; most types never fire.
+  PythonRef msg_bytes(PyDict_New(), PythonRef::kSteal);
+  for (int i = 0; i < ConnectionStats::kMessageTypeCount; i++) {
+    if (int64_t bytes = stats.message_bytes_for_type(i)) {
+      PythonRef key(PyLong_FromLong(i), PythonRef::kSteal);
+      PythonRef val(PyLong_FromLongLong(bytes), PythonRef::kSteal);
+      PyDict_SetItem(msg_bytes.get(), key.get(), val.get());
+    }
+  }
+  PythonRef cmd_bytes(PyDict_New(), PythonRef::kSteal);
+  for (int i = 0; i < ConnectionStats::kSessionCommandCount; i++) {
+    if (int64_t bytes = stats.session_command_bytes(i)) {
+      PythonRef key(PyLong_FromLong(i), PythonRef::kSteal);
+      PythonRef val(PyLong_FromLongLong(bytes), PythonRef::kSteal);
+      PyDict_SetItem(cmd_bytes.get(), key.get(), val.get());
+    }
+  }
+  PythonRef info(
+      Py_BuildValue(
+          "{sssLsfsfsfsfsLsfsLsLsfsLsLsLsLsOsO}", "peer", peer_desc.c_str(),
+          "rtt_samples", stats.rtt_sample_count(), "rtt_avg_ms",
+          static_cast<double>(stats.GetAverageRtt()), "rtt_p50_ms",
+          static_cast<double>(stats.GetRttPercentile(50)), "rtt_p95_ms",
+          static_cast<double>(stats.GetRttPercentile(95)), "rtt_max_ms",
+          static_cast<double>(stats.rtt_max_ms()), "reorder_count",
+          stats.reorder_count(), "loss", stats.GetLossEstimate(),
+          "packets_out", stats.packets_out(), "packets_in", stats.packets_in(),
+          "compression_ratio", stats.GetCompressionRatio(), "bytes_out",
+          stats.bytes_out(), "bytes_in", stats.bytes_in(), "bytes_resent",
+          stats.bytes_resent(), "packets_resent", stats.packets_resent(),
+          "msg_bytes_by_type", msg_bytes.get(), "stream_bytes_by_command",
+          cmd_bytes.get()),
+      PythonRef::kSteal);
+  PythonRef args(Py_BuildValue("(O)", info.get()), PythonRef::kSteal);
+  obj(ObjID::kClientConnectionStatsCall).Call(args);
+}
+
 void Python::DispatchScoresToBeatResponse(
     bool success, const std::list<ScoreToBeat>& scores_to_beat,
     void* callback_in) {
@@ -1599,6 +1789,86 @@ void Python::SetNodeAttr(Node* node, const char* attr_name,
   }
 }
 
+void Python::SetNodeAttrs(Node* node, PyObject* attrs_dict) {
+  assert(node);
+  assert(PyDict_Check(attrs_dict));
+
+  // The win here over individual sets is that the node only gets
+  // validated/looked-up once for the whole batch; each value still
+  // goes through the usual per-type path above.
+  PyObject* key{};
+  PyObject* value{};
+  Py_ssize_t pos{};
+  while (PyDict_Next(attrs_dict, &pos, &key, &value)) {
+    if (!PyUnicode_Check(key)) {
+      throw Exception("Attr names must be strings.", PyExcType::kType);
+    }
+    SetNodeAttr(node, PyUnicode_AsUTF8(key), value);
+  }
+}
+
+auto PythonCollectFastcallArgs(PyObject* const* args, Py_ssize_t nargs,
+                               PyObject* kwnames, const char* const* kwlist,
+                               PyObject** interned_cache, PyObject** slots,
+                               int slot_count, const char* fname) -> bool {
+  assert(Python::HaveGIL());
+  if (nargs > slot_count) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s() takes at most %d arguments (%zd given)", fname,
+                 slot_count, nargs);
+    return false;
+  }
+  for (Py_ssize_t i = 0; i < nargs; i++) {
+    slots[i] = args[i];
+  }
+  if (kwnames == nullptr) {
+    return true;
+  }
+
+  // One-time intern of our keyword names (we hold the refs forever).
+  if (interned_cache[0] == nullptr) {
+    for (int i = 0; i < slot_count; i++) {
+      assert(kwlist[i] != nullptr);
+      interned_cache[i] = PyUnicode_InternFromString(kwlist[i]);
+      BA_PRECONDITION(interned_cache[i] != nullptr);
+    }
+  }
+  Py_ssize_t kwcount = PyTuple_GET_SIZE(kwnames);
+  for (Py_ssize_t i = 0; i < kwcount; i++) {
+    PyObject* name = PyTuple_GET_ITEM(kwnames, i);
+    int slot = -1;
+    for (int j = 0; j < slot_count; j++) {
+      if (name == interned_cache[j]) {
+        slot = j;
+        break;
+      }
+    }
+    if (slot == -1) {
+      // Fall back to string compares for oddball callers whose keyword
+      // names didn't come through interned.
+      for (int j = 0; j < slot_count; j++) {
+        if (PyUnicode_CompareWithASCIIString(name, kwlist[j]) == 0) {
+          slot = j;
+          break;
+        }
+      }
+    }
+    if (slot == -1) {
+      PyErr_Format(PyExc_TypeError,
+                   "%s() got an unexpected keyword argument '%U'", fname,
+                   name);
+      return false;
+    }
+    if (slot < nargs || slots[slot] != nullptr) {
+      PyErr_Format(PyExc_TypeError,
+                   "%s() got multiple values for argument '%U'", fname, name);
+      return false;
+    }
+    slots[slot] = args[nargs + i];
+  }
+  return true;
+}
+
 static auto CompareAttrIndices(
     const std::pair<NodeAttributeUnbound*, PyObject*>& first,
     const std::pair<NodeAttributeUnbound*, PyObject*>& second) -> bool {
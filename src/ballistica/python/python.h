@@ -119,6 +119,11 @@ class Python {
   /// Pass a chat message along to the python UI layer for handling..
   void HandleLocalChatMessage(const std::string& message);
 
+  /// Hand a dying connection's accumulated quality telemetry to the
+  /// python layer (no-op if no hook is registered).
+  void HandleClientConnectionStats(const ConnectionStats& stats,
+                                   const std::string& peer_desc);
+
   void DispatchScoresToBeatResponse(
       bool success, const std::list<ScoreToBeat>& scores_to_beat,
       void* PyCallback);
@@ -227,6 +232,7 @@ class Python {
   static auto GetNodeAttr(Node* node, const char* attribute_name) -> PyObject*;
   static void SetNodeAttr(Node* node, const char* attr_name,
                           PyObject* value_obj);
+  static void SetNodeAttrs(Node* node, PyObject* attrs_dict);
 
   static void SetPythonException(PyExcType exctype, const char* description);
 
@@ -341,6 +347,7 @@ class Python {
     kPlayerClass,
     kGetPlayerIconCall,
     kLstrFromJsonCall,
+    kClientConnectionStatsCall,
     kLast  // Sentinel; must be at end.
   };
 
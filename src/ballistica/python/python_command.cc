@@ -2,6 +2,7 @@
 
 #include "ballistica/python/python_command.h"
 
+#include <unordered_map>
 #include <utility>
 
 #include "ballistica/python/python.h"
@@ -20,6 +21,28 @@ namespace ballistica {
 
 PythonCommand* PythonCommand::current_command_ = nullptr;
 
+// Compiled code objects shared between all commands with identical
+// source; saves re-running Py_CompileString when the same string fires
+// repeatedly through fresh PythonCommand instances. Protected by the
+// GIL. Cleared wholesale if it somehow balloons (console spam, etc).
+static std::unordered_map<std::string, PythonRef> g_compile_cache;
+const int kCompileCacheMaxEntries = 256;
+
+static auto GetCachedCompile(const std::string& key) -> PyObject* {
+  auto i = g_compile_cache.find(key);
+  if (i == g_compile_cache.end()) {
+    return nullptr;
+  }
+  return i->second.NewRef();
+}
+
+static void SetCachedCompile(const std::string& key, PyObject* code) {
+  if (g_compile_cache.size() >= kCompileCacheMaxEntries) {
+    g_compile_cache.clear();
+  }
+  g_compile_cache[key].Acquire(code);
+}
+
 PythonCommand::PythonCommand() = default;
 
 PythonCommand::PythonCommand(std::string command_in)
@@ -50,6 +73,11 @@ auto PythonCommand::operator=(const std::string& src) -> PythonCommand& {
 void PythonCommand::CompileForExec() {
   assert(Python::HaveGIL());
   assert(file_code_obj_.get() == nullptr);
+  std::string cache_key = "exec\n" + file_name_ + "\n" + command_;
+  if (PyObject* cached = GetCachedCompile(cache_key)) {
+    file_code_obj_.Steal(cached);
+    return;
+  }
   PyObject* o =
       Py_CompileString(command_.c_str(), file_name_.c_str(), Py_file_input);
   if (o == nullptr) {
@@ -58,13 +86,19 @@ void PythonCommand::CompileForExec() {
     // (nodes, actors existing after their games have ended)
     PyErr_PrintEx(0);
   } else {
-    file_code_obj_.Acquire(o);
+    SetCachedCompile(cache_key, o);
+    file_code_obj_.Steal(o);
   }
 }
 
 void PythonCommand::CompileForEval(bool print_errors) {
   assert(Python::HaveGIL());
   assert(eval_code_obj_.get() == nullptr);
+  std::string cache_key = "eval\n" + file_name_ + "\n" + command_;
+  if (PyObject* cached = GetCachedCompile(cache_key)) {
+    eval_code_obj_.Steal(cached);
+    return;
+  }
   PyObject* o =
       Py_CompileString(command_.c_str(), file_name_.c_str(), Py_eval_input);
   if (o == nullptr) {
@@ -76,7 +110,8 @@ void PythonCommand::CompileForEval(bool print_errors) {
     }
     PyErr_Clear();
   } else {
-    eval_code_obj_.Acquire(o);
+    SetCachedCompile(cache_key, o);
+    eval_code_obj_.Steal(o);
   }
 }
 
@@ -2,6 +2,8 @@
 
 #include "ballistica/python/python_context_call.h"
 
+#include <chrono>
+
 #include "ballistica/game/host_activity.h"
 #include "ballistica/game/session/host_session.h"
 #include "ballistica/python/python.h"
@@ -12,6 +14,9 @@ namespace ballistica {
 // FIXME - should be static member var
 PythonContextCall* PythonContextCall::current_call_ = nullptr;
 
+std::map<std::string, PythonContextCall::CallTimings>
+    PythonContextCall::call_timings_ = {};
+
 PythonContextCall::PythonContextCall(PyObject* obj_in) {
   assert(InGameThread());
   // as a sanity test, store the current context ptr just to make sure it
@@ -44,7 +49,9 @@ PythonContextCall::PythonContextCall(PyObject* obj_in) {
 PythonContextCall::~PythonContextCall() {
   // lets set up context while we take our stuff down
   // (we may be holding refs to actors or whatnot)
-  ScopedSetContext cp(context_);
+  // (our context_ member trivially outlives this scope, so the raw
+  // version is fine)
+  ScopedSetContextRaw cp(&context_);
   object_.Release();
 }
 
@@ -90,8 +97,10 @@ void PythonContextCall::Run(PyObject* args) {
   }
 #endif  // BA_DEBUG_BUILD
 
-  // Restore the context from when we were made.
-  ScopedSetContext cp(context_);
+  // Restore the context from when we were made. Our context_ member
+  // outlives this scope (we hold a ref to ourself below) so the cheap
+  // non-owning switch is safe here.
+  ScopedSetContextRaw cp(&context_);
 
   // Hold a ref to this call throughout this process
   // so we know it'll still exist if we need to report
@@ -101,11 +110,35 @@ void PythonContextCall::Run(PyObject* args) {
   PythonContextCall* prev_call = current_call_;
   current_call_ = this;
   assert(Python::HaveGIL());
+
+  // Callsite timings live across our lifetime so each call only pays
+  // for the map lookup once (std::map entries never move).
+  if (timings_entry_ == nullptr) {
+    timings_entry_ = &call_timings_[file_loc_];
+  }
+  auto start_time = std::chrono::steady_clock::now();
+
   PyObject* o = PyObject_Call(
       object_.get(),
       args ? args : g_python->obj(Python::ObjID::kEmptyTuple).get(), nullptr);
   current_call_ = prev_call;
 
+  auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - start_time)
+                      .count();
+  timings_entry_->count++;
+  timings_entry_->total_usecs += duration;
+  if (duration > timings_entry_->max_usecs) {
+    timings_entry_->max_usecs = duration;
+  }
+  int bucket = 0;
+  int64_t cutoff = 100;  // 0.1ms.
+  while (bucket < CallTimings::kNumHistogramBuckets - 1 && duration >= cutoff) {
+    bucket++;
+    cutoff *= 2;
+  }
+  timings_entry_->histogram[bucket]++;
+
   if (o) {
     Py_DECREF(o);
   } else {
@@ -124,6 +157,22 @@ void PythonContextCall::Run(PyObject* args) {
   }
 }
 
+void PythonContextCall::RunWithArg(PyObject* arg) {
+  assert(Python::HaveGIL());
+  assert(arg);
+  if (arg_tuple_.exists() && Py_REFCNT(arg_tuple_.get()) == 1) {
+    // Nobody held on to our tuple during the last fire, so we can
+    // quietly recycle it in place.
+    PyObject* old = PyTuple_GET_ITEM(arg_tuple_.get(), 0);
+    Py_INCREF(arg);
+    PyTuple_SET_ITEM(arg_tuple_.get(), 0, arg);
+    Py_XDECREF(old);
+  } else {
+    arg_tuple_.Steal(Py_BuildValue("(O)", arg));
+  }
+  Run(arg_tuple_.get());
+}
+
 void PythonContextCall::LogContext() {
   assert(InGameThread());
   std::string s = std::string("  root call: ") + object().Str();
@@ -81,4 +81,38 @@
   }                                                                       \
   ((void)0)
 
+namespace ballistica {
+
+/// Scope that releases the GIL around a blocking engine call which
+/// touches no Python state, so background Python threads can run.
+/// Exception-safe (unlike raw Py_BEGIN_ALLOW_THREADS): the GIL gets
+/// re-acquired even if the engine call throws.
+class ScopedAllowThreads {
+ public:
+  ScopedAllowThreads() {
+    assert(PyGILState_Check());
+    state_ = PyEval_SaveThread();
+  }
+  ~ScopedAllowThreads() { PyEval_RestoreThread(state_); }
+  ScopedAllowThreads(const ScopedAllowThreads&) = delete;
+  auto operator=(const ScopedAllowThreads&) -> ScopedAllowThreads& = delete;
+
+ private:
+  PyThreadState* state_;
+};
+
+/// Map METH_FASTCALL args plus keyword names onto a slot array laid out
+/// per a kwlist, avoiding tuple/dict construction. Call sites pass a
+/// static interned-name cache sized to the kwlist so repeat calls
+/// resolve keywords with pointer compares (CPython interns keyword
+/// names at call sites). Slots must start out null; ones not provided
+/// by the caller are left that way. Returns false with a Python error
+/// set on bad args.
+auto PythonCollectFastcallArgs(PyObject* const* args, Py_ssize_t nargs,
+                               PyObject* kwnames, const char* const* kwlist,
+                               PyObject** interned_cache, PyObject** slots,
+                               int slot_count, const char* fname) -> bool;
+
+}  // namespace ballistica
+
 #endif  // BALLISTICA_PYTHON_PYTHON_SYS_H_
@@ -8,6 +8,8 @@
 
 namespace ballistica {
 
+BA_NODE_POOLED_ALLOC_IMPL(BombNode)
+
 const float kFuseOffset = 0.35f;
 
 // Returns noise value between 0 and 1.
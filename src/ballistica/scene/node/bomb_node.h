@@ -11,6 +11,7 @@ namespace ballistica {
 class BombNode : public PropNode {
  public:
   static auto InitType() -> NodeType*;
+  BA_NODE_POOLED_ALLOC();
   explicit BombNode(Scene* scene);
   void Step() override;
   void Draw(FrameDef* frame_def) override;
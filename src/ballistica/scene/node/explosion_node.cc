@@ -14,6 +14,8 @@
 
 namespace ballistica {
 
+BA_NODE_POOLED_ALLOC_IMPL(ExplosionNode)
+
 class ExplosionNodeType : public NodeType {
  public:
 #define BA_NODE_TYPE_CLASS ExplosionNode
@@ -43,7 +45,9 @@ auto ExplosionNode::InitType() -> NodeType* {
 ExplosionNode* gExplosionDistortLock = nullptr;
 
 ExplosionNode::ExplosionNode(Scene* scene)
-    : Node(scene, node_type), birth_time_(scene->time()) {}
+    : Node(scene, node_type), birth_time_(scene->time()) {
+  set_needs_step(true);
+}
 
 ExplosionNode::~ExplosionNode() {
   if (draw_distortion_ && have_distortion_lock_) {
@@ -125,12 +129,30 @@ void ExplosionNode::Draw(FrameDef* frame_def) {
         }
       }
     }
+    // Distortion is pure eye-candy; it's the first thing to go when the
+    // effect budget governor says frames are running long. (big
+    // explosions hang on a little longer than small ones.)
+    float effect_lod = g_graphics->effect_lod();
+    if (draw_distortion_ && effect_lod < (big_ ? 0.25f : 0.5f)) {
+      draw_distortion_ = false;
+      if (have_distortion_lock_) {
+        assert(gExplosionDistortLock == this);
+        gExplosionDistortLock = nullptr;
+        have_distortion_lock_ = false;
+      }
+    }
     if (draw_distortion_) {
       float age = scene()->time() - static_cast<float>(birth_time_);
       float amt = (1.0f - 0.00265f * age);
-      if (amt > 0.0001f) {
+
+      // The shock wave grows over time; skip the draw entirely once its
+      // (generous) bounds leave the view frustum.
+      bool wave_visible = frame_def->beauty_pass()->IsSphereInFrustum(
+          Vector3f(position_[0], position_[1], position_[2]),
+          3.0f * (1.0f + 0.02f * age));
+      if (amt > 0.0001f && wave_visible) {
         amt = pow(amt, 2.2f);
-        amt *= 2.0f;
+        amt *= 2.0f * effect_lod;
         if (big_) {
           amt *= 4.0f;
         } else {
@@ -216,12 +238,16 @@ void ExplosionNode::Draw(FrameDef* frame_def) {
     c.Scale(0.9f * s, 0.9f * s, 0.9f * s);
     c.DrawModel(g_media->GetModel(SystemModelID::kShield),
                 kModelDrawFlagNoReflection);
-    c.Scale(0.6f, 0.6f, 0.6f);
-    c.Rotate(33, 0, 1, 0);
-    c.SetColor(o * 7.0f * color_[0], o * 7.0f * color_[1], o * 7.0f * color_[2],
-               0);
-    c.DrawModel(g_media->GetModel(SystemModelID::kShield),
-                kModelDrawFlagNoReflection);
+
+    // The inner core layer gets dropped under heavy load.
+    if (g_graphics->effect_lod() >= 0.35f) {
+      c.Scale(0.6f, 0.6f, 0.6f);
+      c.Rotate(33, 0, 1, 0);
+      c.SetColor(o * 7.0f * color_[0], o * 7.0f * color_[1],
+                 o * 7.0f * color_[2], 0);
+      c.DrawModel(g_media->GetModel(SystemModelID::kShield),
+                  kModelDrawFlagNoReflection);
+    }
     c.PopTransform();
     c.Submit();
   }
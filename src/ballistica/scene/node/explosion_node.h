@@ -12,6 +12,7 @@ namespace ballistica {
 class ExplosionNode : public Node {
  public:
   static auto InitType() -> NodeType*;
+  BA_NODE_POOLED_ALLOC();
   explicit ExplosionNode(Scene* scene);
   ~ExplosionNode() override;
   void Draw(FrameDef* frame_def) override;
@@ -91,6 +91,7 @@ auto FlagNode::InitType() -> NodeType* {
 enum FlagBodyType { kPoleBodyID };
 
 FlagNode::FlagNode(Scene* scene) : Node(scene, node_type), part_(this) {
+  set_needs_step(true);
   body_ = Object::New<RigidBody>(
       kPoleBodyID, &part_, RigidBody::Type::kBody, RigidBody::Shape::kCapsule,
       RigidBody::kCollideActive, RigidBody::kCollideAll);
@@ -394,9 +395,6 @@ void FlagNode::Step() {
   // update our area-of-interest if we have one
   UpdateAreaOfInterest();
 
-  // FIXME: This should probably happen for RBDs automatically?
-  body_->UpdateBlending();
-
   // Update our shadow objects.
   dBodyID b = body_->body();
   assert(b);
@@ -5,12 +5,15 @@
 #include <vector>
 
 #include "ballistica/graphics/component/object_component.h"
+#include "ballistica/graphics/graphics.h"
 #include "ballistica/graphics/renderer.h"
 #include "ballistica/scene/node/node_attribute.h"
 #include "ballistica/scene/node/node_type.h"
 
 namespace ballistica {
 
+BA_NODE_POOLED_ALLOC_IMPL(FlashNode)
+
 class FlashNodeType : public NodeType {
  public:
 #define BA_NODE_TYPE_CLASS FlashNode
@@ -51,7 +54,11 @@ void FlashNode::Draw(FrameDef* frame_def) {
   c.SetColor(color_[0], color_[1], color_[2], 1.0f);
   c.PushTransform();
   c.Translate(position_[0], position_[1], position_[2]);
-  c.Scale(size_, size_, size_);
+
+  // Shrink a bit under load; overdraw from big overlapping flashes is
+  // exactly what the effect budget governor is trying to shed.
+  float s = size_ * (0.5f + 0.5f * g_graphics->effect_lod());
+  c.Scale(s, s, s);
   c.Rotate(RandomFloat() * 360.0f, 1, 1, 0);
   c.DrawModel(g_media->GetModel(SystemModelID::kFlash));
   c.PopTransform();
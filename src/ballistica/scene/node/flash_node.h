@@ -12,6 +12,7 @@ namespace ballistica {
 class FlashNode : public Node {
  public:
   static auto InitType() -> NodeType*;
+  BA_NODE_POOLED_ALLOC();
   explicit FlashNode(Scene* scene);
   ~FlashNode() override;
   void Draw(FrameDef* frame_def) override;
@@ -41,7 +41,9 @@ auto LightNode::InitType() -> NodeType* {
   return node_type;
 }
 
-LightNode::LightNode(Scene* scene) : Node(scene, node_type) {}
+LightNode::LightNode(Scene* scene) : Node(scene, node_type) {
+  set_needs_step(true);
+}
 
 auto LightNode::GetVolumeLightIntensity() -> float {
   return intensity_ * volume_intensity_scale_ * 0.02f;
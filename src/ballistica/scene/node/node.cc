@@ -20,6 +20,13 @@ NodeType::~NodeType() {
 
 Node::Node(Scene* scene_in, NodeType* node_type)
     : node_type_(node_type), scene_(scene_in) {}
+
+void Node::set_needs_step(bool val) {
+  needs_step_ = val;
+  if (scene_) {
+    scene_->MarkStepListDirty();
+  }
+}
 void Node::AddToScene(Scene* scene) {
   // we should have already set our scene ptr in our constructor;
   // now we add ourself to its lists..
@@ -37,6 +44,14 @@ void Node::AddToScene(Scene* scene) {
 }
 
 Node::~Node() {
+#if BA_ALLOC_TRACKING
+  // (anything not built through a BA_NODE_CREATE_CALL never got added)
+  if (alloc_tracked_bytes_ != 0) {
+    AllocTracker::Remove(AllocTracker::Tag::kSceneNodes,
+                         alloc_tracked_bytes_);
+  }
+#endif
+
   // Kill any incoming/outgoing attr connections.
   for (auto& i : attribute_connections_incoming_) {
     NodeAttributeConnection* a = i.second.get();
@@ -178,6 +193,13 @@ void Node::ConnectAttribute(NodeAttributeUnbound* src_attr, Node* dst_node,
   a->src_attr_index = src_attr->index();
   a->dst_node = dst_node;
   a->dst_attr_index = dst_attr->index();
+  a->src_attr = src_attr;
+  a->dst_attr = dst_attr;
+  a->apply = NodeAttributeConnection::SelectApply(dst_attr->type());
+
+  // We may have just gained our first outgoing connection, in which case
+  // the scene needs to start touching us each step.
+  scene()->MarkStepListDirty();
   a->Update();
 }
 
@@ -391,6 +413,21 @@ void Node::UpdatePartBirthTimes() {
   }
 }
 
+auto Node::GetRewoundPosition(millisecs_t delay) -> Vector3f {
+  assert(InGameThread());
+  for (auto&& part : parts_) {
+    for (auto&& body : part->rigid_bodies()) {
+      // Round to the nearest step; half a step of quantization is
+      // noise next to the pings we're compensating for.
+      auto steps_back = static_cast<int>(
+          (delay + kGameStepMilliseconds / 2) / kGameStepMilliseconds);
+      return body->GetRewoundPosition(steps_back);
+    }
+  }
+  throw Exception("node has no rigid bodies; can't rewind position",
+                  PyExcType::kValue);
+}
+
 void Node::CheckBodies() {
   for (auto&& i : parts_) {
     i->CheckBodies();
@@ -405,6 +442,102 @@ auto NodeType::GetAttributeNames() const -> std::vector<std::string> {
   return names;
 }
 
+void NodeType::CaptureDefaultAttrValues(Node* node) {
+  assert(node && node->type() == this);
+  assert(!have_default_attr_values_);
+  default_attr_values_.resize(attributes_by_index_.size());
+  for (auto&& i : attributes_by_index_) {
+    if (i->is_read_only()) {
+      continue;
+    }
+    DefaultAttrValue& val = default_attr_values_[i->index()];
+    switch (i->type()) {
+      case NodeAttributeType::kFloat:
+        val.float_val = i->GetAsFloat(node);
+        break;
+      case NodeAttributeType::kInt:
+        val.int_val = i->GetAsInt(node);
+        break;
+      case NodeAttributeType::kBool:
+        val.bool_val = i->GetAsBool(node);
+        break;
+      case NodeAttributeType::kFloatArray:
+        val.floats_val = i->GetAsFloats(node);
+        break;
+      case NodeAttributeType::kIntArray:
+        val.ints_val = i->GetAsInts(node);
+        break;
+      case NodeAttributeType::kString:
+        val.string_val = i->GetAsString(node);
+        break;
+      default:
+        // Reference types can't be non-default on a fresh instance;
+        // nothing to store.
+        break;
+    }
+  }
+  have_default_attr_values_ = true;
+}
+
+auto NodeType::IsDefaultAttrValue(const NodeAttribute& attr) const -> bool {
+  assert(attr.node_type() == this);
+  switch (attr.type()) {
+    // Value types compare against our pristine-instance snapshot.
+    // Exact float compares are what we want here; an untouched attr is
+    // bit-identical to the snapshot.
+    case NodeAttributeType::kFloat:
+      return have_default_attr_values_
+             && attr.GetAsFloat()
+                    == default_attr_values_[attr.index()].float_val;
+    case NodeAttributeType::kInt:
+      return have_default_attr_values_
+             && attr.GetAsInt() == default_attr_values_[attr.index()].int_val;
+    case NodeAttributeType::kBool:
+      return have_default_attr_values_
+             && attr.GetAsBool() == default_attr_values_[attr.index()].bool_val;
+    case NodeAttributeType::kFloatArray:
+      return have_default_attr_values_
+             && attr.GetAsFloats()
+                    == default_attr_values_[attr.index()].floats_val;
+    case NodeAttributeType::kIntArray:
+      return have_default_attr_values_
+             && attr.GetAsInts() == default_attr_values_[attr.index()].ints_val;
+    case NodeAttributeType::kString:
+      return have_default_attr_values_
+             && attr.GetAsString()
+                    == default_attr_values_[attr.index()].string_val;
+
+    // Reference attrs on a fresh instance are always null/empty, so
+    // current null/empty means default regardless of snapshot state.
+    case NodeAttributeType::kNode:
+      return attr.GetAsNode() == nullptr;
+    case NodeAttributeType::kNodeArray:
+      return attr.GetAsNodes().empty();
+    case NodeAttributeType::kPlayer:
+      return attr.GetAsPlayer() == nullptr;
+    case NodeAttributeType::kMaterialArray:
+      return attr.GetAsMaterials().empty();
+    case NodeAttributeType::kTexture:
+      return attr.GetAsTexture() == nullptr;
+    case NodeAttributeType::kTextureArray:
+      return attr.GetAsTextures().empty();
+    case NodeAttributeType::kSound:
+      return attr.GetAsSound() == nullptr;
+    case NodeAttributeType::kSoundArray:
+      return attr.GetAsSounds().empty();
+    case NodeAttributeType::kModel:
+      return attr.GetAsModel() == nullptr;
+    case NodeAttributeType::kModelArray:
+      return attr.GetAsModels().empty();
+    case NodeAttributeType::kCollideModel:
+      return attr.GetAsCollideModel() == nullptr;
+    case NodeAttributeType::kCollideModelArray:
+      return attr.GetAsCollideModels().empty();
+    default:
+      return false;
+  }
+}
+
 void Node::ListAttributes(std::list<std::string>* attrs) {
   attrs->clear();
 
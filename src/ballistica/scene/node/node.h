@@ -9,16 +9,48 @@
 #include <vector>
 
 #include "ballistica/ballistica.h"
+#include "ballistica/core/alloc_tracker.h"
 #include "ballistica/core/context.h"
 #include "ballistica/core/object.h"
 #include "ballistica/python/python_ref.h"
 
 namespace ballistica {
 
-// Define a static creation call for this node type
-#define BA_NODE_CREATE_CALL(FUNC)                       \
-  static auto FUNC(Scene* sg)->Node* {                  \
-    return Object::NewDeferred<BA_NODE_TYPE_CLASS>(sg); \
+// Define a static creation call for this node type. (This is also where
+// the concrete type's size is known, so alloc tracking hooks in here.)
+#define BA_NODE_CREATE_CALL(FUNC)                             \
+  static auto FUNC(Scene* sg)->Node* {                        \
+    Node* node = Object::NewDeferred<BA_NODE_TYPE_CLASS>(sg); \
+    node->RecordAllocSize(sizeof(BA_NODE_TYPE_CLASS));        \
+    return node;                                              \
+  }
+
+// Give a node type pooled storage: blocks get recycled through a
+// per-type free list (in the same vein as Collision records) so
+// high-churn types - bombs, explosions, flashes - skip the heap
+// allocator on create/destroy and instances of a type stay clustered.
+// Use in the class body; pair with BA_NODE_POOLED_ALLOC_IMPL in the
+// type's .cc file. Game thread only, like all node lifecycle work.
+#define BA_NODE_POOLED_ALLOC()                 \
+  auto operator new(size_t size) -> void*;     \
+  auto operator delete(void* ptr) -> void
+
+#define BA_NODE_POOLED_ALLOC_IMPL(CLS)                                \
+  static void* g_##CLS##_free_list{};                                 \
+  auto CLS::operator new(size_t size) -> void* {                      \
+    assert(InGameThread());                                           \
+    assert(size == sizeof(CLS));                                      \
+    if (g_##CLS##_free_list != nullptr) {                             \
+      void* block = g_##CLS##_free_list;                              \
+      g_##CLS##_free_list = *static_cast<void**>(block);              \
+      return block;                                                   \
+    }                                                                 \
+    return ::operator new(size);                                      \
+  }                                                                   \
+  auto CLS::operator delete(void* ptr) -> void {                      \
+    assert(InGameThread());                                           \
+    *static_cast<void**>(ptr) = g_##CLS##_free_list;                  \
+    g_##CLS##_free_list = ptr;                                        \
   }
 
 typedef std::list<Object::Ref<Node> > NodeList;
@@ -28,6 +60,18 @@ class Node : public Object {
  public:
   Node(Scene* scene, NodeType* node_type);
   ~Node() override;
+
+#if BA_ALLOC_TRACKING
+  // Called by the per-type create calls (the only spots that know the
+  // concrete type's size).
+  void RecordAllocSize(size_t size) {
+    alloc_tracked_bytes_ = size;
+    AllocTracker::Add(AllocTracker::Tag::kSceneNodes, size);
+  }
+#else
+  void RecordAllocSize(size_t size) {}
+#endif
+
   auto id() const -> int64_t {
     return id_;
   }                                     // Return the node's id in its scene.
@@ -76,6 +120,12 @@ class Node : public Object {
   // a new location.
   void UpdatePartBirthTimes();
 
+  // Return the position of the node's first rigid body as of delay
+  // milliseconds ago (clamped to recorded history), for testing
+  // hits/grabs at a lagged client's view time.  Throws if the node has
+  // no rigid bodies.
+  auto GetRewoundPosition(millisecs_t delay) -> Vector3f;
+
   // Retrieve an existing part from a node.
   auto GetPart(unsigned int id) -> Part* {
     assert(id < parts_.size());
@@ -145,6 +195,13 @@ class Node : public Object {
   void UpdateConnections();
   auto iterator() -> NodeList::iterator { return iterator_; }
 
+  // Whether this node has per-step sim work. Node types overriding Step()
+  // must call set_needs_step(true) in their constructor; the scene skips
+  // Step() calls for everyone else. (Nodes with outgoing attr connections
+  // still get their connections pumped each step regardless.)
+  auto needs_step() const -> bool { return needs_step_; }
+  void set_needs_step(bool val);
+
   void CheckBodies();
 
 #if BA_DEBUG_BUILD
@@ -202,10 +259,14 @@ class Node : public Object {
   Context context_;
   Scene* scene_{};
   std::string label_;
+  bool needs_step_{};
   std::vector<Object::WeakRef<Node> > dependent_nodes_;
   std::vector<Part*> parts_;
   int64_t id_{};
   NodeList::iterator iterator_;
+#if BA_ALLOC_TRACKING
+  size_t alloc_tracked_bytes_{};
+#endif
 
   // Put this stuff at the bottom so it gets killed first
   PythonRef delegate_;
@@ -7,6 +7,7 @@
 #include "ballistica/scene/node/node.h"
 #include "ballistica/scene/node/node_attribute_connection.h"
 #include "ballistica/scene/node/node_type.h"
+#include "ballistica/scene/scene.h"
 
 namespace ballistica {
 
@@ -64,7 +65,7 @@ NodeAttributeUnbound::NodeAttributeUnbound(NodeType* node_type,
       name_(std::move(name)),
       flags_(flags) {
   assert(node_type);
-  node_type->attributes_by_name_[name_] = this;
+  node_type->attributes_by_name_[Symbol(name_)] = this;
   index_ = static_cast<int>(node_type->attributes_by_index_.size());
   node_type->attributes_by_index_.push_back(this);
 }
@@ -91,8 +92,10 @@ void NodeAttributeUnbound::DisconnectIncoming(Node* node) {
 
     assert(a && a->src_node.exists());
 
-    // Remove from src node's outgoing list.
+    // Remove from src node's outgoing list. The src node may now have
+    // nothing to do each step; let the scene re-evaluate.
     a->src_node->attribute_connections_.erase(a->src_iterator);
+    a->src_node->scene()->MarkStepListDirty();
 
     // Remove from our incoming list; this should kill the connection.
     node->attribute_connections_incoming_.erase(i);
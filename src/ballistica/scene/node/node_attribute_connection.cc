@@ -10,9 +10,131 @@
 
 namespace ballistica {
 
+// One tight routine per supported attr type; the right one is picked at
+// connect time so steady-state updates are a single indirect call with no
+// type switching.
+namespace {
+void ApplyFloat(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsFloat(c->src_node.get()));
+}
+void ApplyInt(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsInt(c->src_node.get()));
+}
+void ApplyBool(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsBool(c->src_node.get()));
+}
+void ApplyString(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsString(c->src_node.get()));
+}
+void ApplyInts(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsInts(c->src_node.get()));
+}
+void ApplyFloats(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsFloats(c->src_node.get()));
+}
+void ApplyNode(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsNode(c->src_node.get()));
+}
+void ApplyNodes(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsNodes(c->src_node.get()));
+}
+void ApplyPlayer(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsPlayer(c->src_node.get()));
+}
+void ApplyMaterials(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsMaterials(c->src_node.get()));
+}
+void ApplyTexture(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsTexture(c->src_node.get()));
+}
+void ApplyTextures(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsTextures(c->src_node.get()));
+}
+void ApplySound(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsSound(c->src_node.get()));
+}
+void ApplySounds(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsSounds(c->src_node.get()));
+}
+void ApplyModel(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsModel(c->src_node.get()));
+}
+void ApplyModels(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsModels(c->src_node.get()));
+}
+void ApplyCollideModel(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsCollideModel(c->src_node.get()));
+}
+void ApplyCollideModels(NodeAttributeConnection* c) {
+  c->dst_attr->Set(c->dst_node.get(),
+                   c->src_attr->GetAsCollideModels(c->src_node.get()));
+}
+}  // namespace
+
+auto NodeAttributeConnection::SelectApply(NodeAttributeType type) -> ApplyFn {
+  switch (type) {
+    case NodeAttributeType::kFloat:
+      return ApplyFloat;
+    case NodeAttributeType::kInt:
+      return ApplyInt;
+    case NodeAttributeType::kBool:
+      return ApplyBool;
+    case NodeAttributeType::kString:
+      return ApplyString;
+    case NodeAttributeType::kIntArray:
+      return ApplyInts;
+    case NodeAttributeType::kFloatArray:
+      return ApplyFloats;
+    case NodeAttributeType::kNode:
+      return ApplyNode;
+    case NodeAttributeType::kNodeArray:
+      return ApplyNodes;
+    case NodeAttributeType::kPlayer:
+      return ApplyPlayer;
+    case NodeAttributeType::kMaterialArray:
+      return ApplyMaterials;
+    case NodeAttributeType::kTexture:
+      return ApplyTexture;
+    case NodeAttributeType::kTextureArray:
+      return ApplyTextures;
+    case NodeAttributeType::kSound:
+      return ApplySound;
+    case NodeAttributeType::kSoundArray:
+      return ApplySounds;
+    case NodeAttributeType::kModel:
+      return ApplyModel;
+    case NodeAttributeType::kModelArray:
+      return ApplyModels;
+    case NodeAttributeType::kCollideModel:
+      return ApplyCollideModel;
+    case NodeAttributeType::kCollideModelArray:
+      return ApplyCollideModels;
+    default:
+      throw Exception("FIXME: unimplemented for attr type: '"
+                      + NodeAttributeUnbound::GetNodeAttributeTypeName(type)
+                      + "'");
+  }
+}
+
 void NodeAttributeConnection::Update() {
   assert(src_node.exists() && dst_node.exists());
-  auto* src_node_p{src_node.get()};
 
   // We no longer update after errors now.
   // (the constant stream of exceptions slows things down too much)
@@ -21,81 +143,20 @@ void NodeAttributeConnection::Update() {
   }
 
   try {
-    // Pull data from the src to match the dst type.
-    NodeAttributeUnbound* src_attr =
-        src_node->type()->GetAttribute(src_attr_index);
-    assert(src_attr);
-    NodeAttributeUnbound* dst_attr =
-        dst_node->type()->GetAttribute(dst_attr_index);
-    assert(dst_attr);
-    switch (dst_attr->type()) {
-      case NodeAttributeType::kFloat:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsFloat(src_node_p));
-        break;
-      case NodeAttributeType::kInt:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsInt(src_node_p));
-        break;
-      case NodeAttributeType::kBool:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsBool(src_node_p));
-        break;
-      case NodeAttributeType::kString:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsString(src_node_p));
-        break;
-      case NodeAttributeType::kIntArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsInts(src_node_p));
-        break;
-      case NodeAttributeType::kFloatArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsFloats(src_node_p));
-        break;
-      case NodeAttributeType::kNode:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsNode(src_node_p));
-        break;
-      case NodeAttributeType::kNodeArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsNodes(src_node_p));
-        break;
-      case NodeAttributeType::kPlayer:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsPlayer(src_node_p));
-        break;
-      case NodeAttributeType::kMaterialArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsMaterials(src_node_p));
-        break;
-      case NodeAttributeType::kTexture:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsTexture(src_node_p));
-        break;
-      case NodeAttributeType::kTextureArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsTextures(src_node_p));
-        break;
-      case NodeAttributeType::kSound:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsSound(src_node_p));
-        break;
-      case NodeAttributeType::kSoundArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsSounds(src_node_p));
-        break;
-      case NodeAttributeType::kModel:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsModel(src_node_p));
-        break;
-      case NodeAttributeType::kModelArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsModels(src_node_p));
-        break;
-      case NodeAttributeType::kCollideModel:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsCollideModel(src_node_p));
-        break;
-      case NodeAttributeType::kCollideModelArray:
-        dst_attr->Set(dst_node.get(), src_attr->GetAsCollideModels(src_node_p));
-        break;
-      default:
-        throw Exception("FIXME: unimplemented for attr type: '"
-                        + dst_attr->GetTypeName() + "'");
-    }
+    // Pull data from the src to match the dst type. The attrs and the
+    // apply routine were resolved when the connection was made; just
+    // sanity-check that they match the stored indices.
+    assert(src_attr != nullptr
+           && src_attr == src_node->type()->GetAttribute(src_attr_index));
+    assert(dst_attr != nullptr
+           && dst_attr == dst_node->type()->GetAttribute(dst_attr_index));
+    assert(apply != nullptr);
+    apply(this);
   } catch (const std::exception& e) {
     // Print errors only once per connection to avoid overwhelming the logs.
     // (though we now stop updating after an error so this is redundant).
     if (!have_error) {
       have_error = true;
-      NodeAttributeUnbound* src_attr =
-          src_node->type()->GetAttribute(src_attr_index);
-      NodeAttributeUnbound* dst_attr =
-          dst_node->type()->GetAttribute(dst_attr_index);
       Log("ERROR: attribute connection update: " + std::string(e.what())
           + "; srcAttr='" + src_attr->name() + "', src_node='"
           + src_node->type()->name() + "', srcNodeName='" + src_node->label()
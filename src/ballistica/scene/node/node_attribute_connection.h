@@ -11,12 +11,27 @@ namespace ballistica {
 
 class NodeAttributeConnection : public Object {
  public:
+  using ApplyFn = void (*)(NodeAttributeConnection* c);
+
   NodeAttributeConnection() = default;
   void Update();
+
+  // Return the type-specialized routine pulling a value of the given type
+  // from the src attr and pushing it to the dst attr. Selected once at
+  // connect time so per-step updates skip all type dispatch; throws for
+  // types without connection support.
+  static auto SelectApply(NodeAttributeType type) -> ApplyFn;
   Object::WeakRef<Node> src_node;
   int src_attr_index{};
   Object::WeakRef<Node> dst_node;
   int dst_attr_index{};
+
+  // Resolved once at connect time; node-type attr tables are static so
+  // these stay valid for the life of the process. Saves per-step lookups
+  // since connections update every sim step.
+  NodeAttributeUnbound* src_attr{};
+  NodeAttributeUnbound* dst_attr{};
+  ApplyFn apply{};
   bool have_error{};
   std::list<Object::Ref<NodeAttributeConnection> >::iterator src_iterator;
 };
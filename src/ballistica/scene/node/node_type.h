@@ -9,6 +9,8 @@
 #include <vector>
 
 #include "ballistica/ballistica.h"
+#include "ballistica/generic/flat_hash_map.h"
+#include "ballistica/generic/symbol.h"
 
 namespace ballistica {
 
@@ -23,7 +25,12 @@ class NodeType {
   /// or returns nullptr.
   auto GetAttribute(const std::string& name, bool throw_if_missing = true) const
       -> NodeAttributeUnbound* {
-    auto i = attributes_by_name_.find(name);
+    // Attr names get interned at registration, so anything the table
+    // has never seen can't be one of ours; on hits the map probe is
+    // all pointer ops.
+    Symbol symbol = Symbol::Find(name.c_str());
+    auto i = symbol.exists() ? attributes_by_name_.find(symbol)
+                             : attributes_by_name_.end();
     if (i == attributes_by_name_.end()) {
       if (throw_if_missing) {
         throw Exception("Attribute not found: '" + name + "'");
@@ -67,12 +74,42 @@ class NodeType {
     return attributes_by_index_;
   }
 
+  /// Whether a pristine-instance attr snapshot has been captured for this
+  /// type yet (see CaptureDefaultAttrValues()).
+  auto have_default_attr_values() const -> bool {
+    return have_default_attr_values_;
+  }
+
+  /// Capture default attr values from a freshly constructed node of this
+  /// type. Stream dumps can then skip attrs still at their defaults, since
+  /// clients recreate nodes through these same constructors.
+  void CaptureDefaultAttrValues(Node* node);
+
+  /// Return whether a bound attr currently holds its default value.
+  /// Value-type attrs always count as non-default if no snapshot
+  /// has been captured for the type.
+  auto IsDefaultAttrValue(const NodeAttribute& attr) const -> bool;
+
  private:
+  // Snapshot of a single writable attr's value on a pristine instance.
+  // Reference-type attrs (nodes, media, etc.) are always null/empty on a
+  // fresh instance so nothing needs storing for them.
+  struct DefaultAttrValue {
+    float float_val{};
+    int64_t int_val{};
+    bool bool_val{};
+    std::string string_val;
+    std::vector<float> floats_val;
+    std::vector<int64_t> ints_val;
+  };
+
   NodeCreateFunc* create_call_;
   int id_;
   std::string name_;
-  std::unordered_map<std::string, NodeAttributeUnbound*> attributes_by_name_;
+  FlatHashMap<Symbol, NodeAttributeUnbound*> attributes_by_name_;
   std::vector<NodeAttributeUnbound*> attributes_by_index_;
+  std::vector<DefaultAttrValue> default_attr_values_;
+  bool have_default_attr_values_{};
   friend class NodeAttributeUnbound;
   friend class Node;
 };
@@ -11,6 +11,7 @@
 #include "ballistica/graphics/component/object_component.h"
 #include "ballistica/graphics/component/simple_component.h"
 #include "ballistica/graphics/graphics.h"
+#include "ballistica/graphics/render_pass.h"
 #include "ballistica/graphics/renderer.h"
 #include "ballistica/scene/scene.h"
 #include "ode/ode_joint.h"
@@ -39,7 +40,9 @@ auto PropNode::InitType() -> NodeType* {
 
 PropNode::PropNode(Scene* scene, NodeType* override_node_type)
     : Node(scene, override_node_type ? override_node_type : node_type),
-      part_(this) {}
+      part_(this) {
+  set_needs_step(true);
+}
 
 PropNode::~PropNode() {
   if (area_of_interest_) {
@@ -110,6 +113,24 @@ void PropNode::Draw(FrameDef* frame_def) {
     return;
   }
 
+  // Skip all submission if there's no way the camera can see us.
+  // (pad our model's bounding sphere generously to cover our blob shadow)
+  float cam_dist;
+  {
+    const dReal* p = dGeomGetPosition(body_->geom());
+    Vector3f center{static_cast<float>(p[0]) + body_->blend_offset().x,
+                    static_cast<float>(p[1]) + body_->blend_offset().y,
+                    static_cast<float>(p[2]) + body_->blend_offset().z};
+    float radius = model_->model_data()->radius() * model_scale_
+                   * extra_model_scale_;
+    if (!frame_def->beauty_pass()->IsSphereInFrustum(center, radius + 2.0f)) {
+      return;
+    }
+    float cx, cy, cz;
+    g_graphics->camera()->get_position(&cx, &cy, &cz);
+    cam_dist = (center - Vector3f(cx, cy, cz)).Length();
+  }
+
   ObjectComponent c(frame_def->beauty_pass());
   c.SetTexture(color_texture_);
   c.SetLightShadow(LightShadowType::kObject);
@@ -125,7 +146,7 @@ void PropNode::Draw(FrameDef* frame_def) {
   c.TransformToBody(*body_);
   float s = model_scale_ * extra_model_scale_;
   c.Scale(s, s, s);
-  c.DrawModel(model_->model_data());
+  c.DrawModel(model_->model_data()->GetLODForDistance(cam_dist));
   c.PopTransform();
   c.Submit();
 
@@ -440,9 +461,6 @@ void PropNode::Step() {
 
   assert(body_.exists());
 
-  // FIXME - this should probably happen for RBDs automatically?...
-  body_->UpdateBlending();
-
   // on happy thoughts, keep us on the 2d plane..
   if (g_graphics->camera()->happy_thoughts_mode() && body_.exists()) {
     dBodyID b;
@@ -36,7 +36,9 @@ auto RegionNode::InitType() -> NodeType* {
 }
 
 RegionNode::RegionNode(Scene* scene)
-    : Node(scene, node_type), part_(this, false) {}
+    : Node(scene, node_type), part_(this, false) {
+  set_needs_step(true);
+}
 
 void RegionNode::Draw(FrameDef* frame_def) {
   if (g_graphics_server->renderer()->debug_draw_mode()) {
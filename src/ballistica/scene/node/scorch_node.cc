@@ -4,9 +4,7 @@
 
 #include <vector>
 
-#include "ballistica/generic/utils.h"
-#include "ballistica/graphics/component/simple_component.h"
-#include "ballistica/graphics/renderer.h"
+#include "ballistica/graphics/graphics.h"
 #include "ballistica/scene/node/node_attribute.h"
 #include "ballistica/scene/node/node_type.h"
 
@@ -66,19 +64,16 @@ void ScorchNode::Draw(FrameDef* frame_def) {
   float o = presence_;
   // modulate opacity by local shadow density
   o *= g_graphics->GetShadowDensity(position_[0], position_[1], position_[2]);
-  SimpleComponent c(frame_def->light_shadow_pass());
-  c.SetTransparent(true);
-  c.SetColor(color_[0], color_[1], color_[2], o * 0.35f);
-  c.SetTexture(g_media->GetTexture(big_ ? SystemTextureID::kScorchBig
-                                        : SystemTextureID::kScorch));
-  c.PushTransform();
-  c.Translate(position_[0], position_[1], position_[2]);
-  c.Scale(o * size_ * rand_size_[0], o * size_ * rand_size_[1],
-          o * size_ * rand_size_[2]);
-  c.Rotate(Utils::precalc_rands_1[id() % kPrecalcRandsCount] * 360.0f, 0, 1, 0);
-  c.DrawModel(g_media->GetModel(SystemModelID::kScorch));
-  c.PopTransform();
-  c.Submit();
+
+  // We feed the shared scorch batches instead of submitting our own
+  // model draw; everything using our texture then goes down in a
+  // single draw call. The sprite path expands a flat ground-plane
+  // quad spanning its size, which is the shape our old unit model had
+  // at double the scale.
+  g_graphics->DrawScorch(
+      Vector3f(position_[0], position_[1], position_[2]),
+      o * size_ * (rand_size_[0] + rand_size_[2]), color_[0], color_[1],
+      color_[2], o * 0.35f, big_);
 }
 
 }  // namespace ballistica
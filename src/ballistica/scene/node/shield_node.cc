@@ -53,6 +53,7 @@ ShieldNode::ShieldNode(Scene* scene)
       shadow_(0.2f)
 #endif  // !BA_HEADLESS_BUILD
 {
+  set_needs_step(true);
   last_hurt_change_time_ = scene->time();
 }
 
@@ -255,8 +256,14 @@ void ShieldNode::Draw(FrameDef* frame_def) {
     c.PopTransform();
     c.Submit();
 
+    // Our depth-texture effects below are expensive enough that it's
+    // worth skipping them completely when our bounds aren't in view
+    // (the distortion covers a lot of screen when it runs).
+    bool effects_visible = frame_def->beauty_pass()->IsSphereInFrustum(
+        Vector3f(position_[0], position_[1], position_[2]), radius_ * 1.5f);
+
     // Nifty intersection effects in fancy graphics mode.
-    if (frame_def->has_depth_texture()) {
+    if (frame_def->has_depth_texture() && effects_visible) {
       ShieldComponent c2(frame_def->overlay_3d_pass());
       c2.PushTransform();
       c2.MultMatrix((om * m).m);
@@ -268,7 +275,7 @@ void ShieldNode::Draw(FrameDef* frame_def) {
       c2.PopTransform();
       c2.Submit();
     }
-    if (frame_def->has_depth_texture()) {
+    if (frame_def->has_depth_texture() && effects_visible) {
       PostProcessComponent c2(frame_def->blit_pass());
       c2.setNormalDistort(distort);
       c2.PushTransform();
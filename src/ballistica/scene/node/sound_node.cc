@@ -40,7 +40,9 @@ auto SoundNode::InitType() -> NodeType* {
   return node_type;
 }
 
-SoundNode::SoundNode(Scene* scene) : Node(scene, node_type) {}
+SoundNode::SoundNode(Scene* scene) : Node(scene, node_type) {
+  set_needs_step(true);
+}
 
 SoundNode::~SoundNode() {
   if (playing_) {
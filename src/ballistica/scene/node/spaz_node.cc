@@ -18,6 +18,7 @@
 #include "ballistica/graphics/component/object_component.h"
 #include "ballistica/graphics/component/post_process_component.h"
 #include "ballistica/graphics/component/simple_component.h"
+#include "ballistica/graphics/component/template_component.h"
 #include "ballistica/graphics/graphics.h"
 #include "ballistica/graphics/graphics_server.h"
 #include "ballistica/graphics/text/text_graphics.h"
@@ -608,6 +609,8 @@ SpazNode::SpazNode(Scene* scene)
       roller_part_(this, true),
       limbs_part_upper_(this, true),
       limbs_part_lower_(this, true) {
+  set_needs_step(true);
+
   // Head
   body_head_ =
       Object::New<RigidBody>(kHeadBodyID, &spaz_part_, RigidBody::Type::kBody,
@@ -1860,38 +1863,11 @@ void SpazNode::DoFlyPress() {
 void SpazNode::Step() {
   BA_DEBUG_CHECK_BODIES();
 
-  // update our body blending values
-  {
-    Object::Ref<RigidBody>* bodies[] = {&body_head_,
-                                        &body_torso_,
-                                        &body_pelvis_,
-                                        &body_roller_,
-                                        &stand_body_,
-                                        &upper_right_arm_body_,
-                                        &lower_right_arm_body_,
-                                        &upper_left_arm_body_,
-                                        &lower_left_arm_body_,
-                                        &upper_right_leg_body_,
-                                        &lower_right_leg_body_,
-                                        &upper_left_leg_body_,
-                                        &lower_left_leg_body_,
-                                        &left_toes_body_,
-                                        &right_toes_body_,
-                                        &hair_front_right_body_,
-                                        &hair_front_left_body_,
-                                        &hair_ponytail_top_body_,
-                                        &hair_ponytail_bottom_body_,
-                                        nullptr};
-
-    for (Object::Ref<RigidBody>** body = bodies; *body != nullptr; body++) {
-      if (RigidBody* bodyptr = (**body).get()) {
-        bodyptr->UpdateBlending();
-      }
-    }
-  }
-
   step_count_++;
 
+  // Scene time is constant for the duration of the step; grab it once.
+  millisecs_t scene_time = scene()->time();
+
   const dReal* p_head = dGeomGetPosition(body_head_->geom());
   const dReal* p_torso = dGeomGetPosition(body_torso_->geom());
 
@@ -1905,7 +1881,7 @@ void SpazNode::Step() {
   }
 
   // move our smoothed hurt value a short time after we get hit
-  if (scene()->time() - last_hurt_change_time_ > 400) {
+  if (scene_time - last_hurt_change_time_ > 400) {
     if (hurt_smoothed_ < hurt_) {
       hurt_smoothed_ = std::min(hurt_, hurt_smoothed_ + 0.03f);
     } else {
@@ -1962,7 +1938,7 @@ void SpazNode::Step() {
     // determine if we're running..
     running_ = ((run_ > 0.0f) && !hold_position_pressed_ && !holding_something_
                 && !hockey_ && (std::abs(lr_) > 0 || std::abs(ud_) > 0)
-                && (!have_thrown_ || (scene()->time() - throw_start_ > 200)));
+                && (!have_thrown_ || (scene_time - throw_start_ > 200)));
 
     if (running_) {
       float run_target = sqrtf(run_);
@@ -2093,7 +2069,7 @@ void SpazNode::Step() {
       punch_momentum_linear_ *= 0.9f + 0.1f * (vel_length / 5.0f);
     }
 
-    millisecs_t since_last_punch = scene()->time() - last_punch_time_;
+    millisecs_t since_last_punch = scene_time - last_punch_time_;
     if (since_last_punch < 200) {
       punch_power_ = (0.5f
                       + 0.5f
@@ -2147,7 +2123,7 @@ void SpazNode::Step() {
     Vector3f p_wing_l = {0.0f, 0.0f, 0.0f};
     Vector3f p_wing_r = {0.0f, 0.0f, 0.0f};
     float x, y, z;
-    millisecs_t cur_time = scene()->time();
+    millisecs_t cur_time = scene_time;
 
     // Left wing.
     if ((flapping_ || jump_ > 0 || running_) && !frozen_ && !knockout_) {
@@ -2188,7 +2164,7 @@ void SpazNode::Step() {
   // efficiency 93 to 123.
 
   // Always on for punches or frozen.
-  bool always_on = (frozen_ || (scene()->time() - last_punch_time_ < 500));
+  bool always_on = (frozen_ || (scene_time - last_punch_time_ < 500));
 
   if (always_on) {
     upper_left_arm_joint_->angularEnabled = true;
@@ -2338,7 +2314,7 @@ void SpazNode::Step() {
     jolt_head_vel_[1] = head_vel[1];
     jolt_head_vel_[2] = head_vel[2];
 
-    millisecs_t cur_time = scene()->time();
+    millisecs_t cur_time = scene_time;
 
     // If we're jolting and have just been touched in the head and haven't been
     // pushed on by anything external recently (explosion, punch, etc), lets add
@@ -2374,7 +2350,7 @@ void SpazNode::Step() {
   bool head_turning = false;
 
   // If we're punching.
-  millisecs_t scenetime = scene()->time();
+  millisecs_t scenetime = scene_time;
   millisecs_t since_last_punch = scenetime - last_punch_time_;
 
   // Breathing when not moving.
@@ -3761,11 +3737,11 @@ void SpazNode::Step() {
                           + p_head_vel[2] * p_head_vel[2];
 
   float scream_speed = can_fly_ ? 160.0f : 100.0f;
-  if ((force_scream_ && scene()->time() - last_force_scream_time_ < 3000)
-      || (scene()->time() - last_fly_time_ > 1000
+  if ((force_scream_ && scene_time - last_force_scream_time_ < 3000)
+      || (scene_time - last_fly_time_ > 1000
           && vel_mag_squared > scream_speed && !footing_
           && std::abs(p_head_vel[1]) > 0.3f && !dead_)) {
-    if (scene()->time() - last_fall_time_ > 1000) {
+    if (scene_time - last_fall_time_ > 1000) {
       // If we're not still screaming, start one up.
       if (!(voice_play_id_ == fall_play_id_
             && g_audio->IsSoundPlaying(fall_play_id_))) {
@@ -3779,7 +3755,7 @@ void SpazNode::Step() {
           }
         }
       }
-      last_fall_time_ = scene()->time();
+      last_fall_time_ = scene_time;
     }
   }
 
@@ -3788,7 +3764,7 @@ void SpazNode::Step() {
   if (voice_play_id_ == fall_play_id_) {
     if ((footing_ && !force_scream_)
         || (force_scream_
-            && scene()->time() - last_force_scream_time_ > 2000)) {
+            && scene_time - last_force_scream_time_ > 2000)) {
       g_audio->PushSourceStopSoundCall(voice_play_id_);
       voice_play_id_ = 0xFFFFFFFF;
     } else {
@@ -3812,7 +3788,7 @@ void SpazNode::Step() {
   // If we're in the process of throwing something
   // ( we need to check have_thrown_ because otherwise we'll always think
   //   we're throwing at game-time 0 since throw_start_ inits to that.)
-  if (have_thrown_ && scene()->time() - throw_start_ < 50) {
+  if (have_thrown_ && scene_time - throw_start_ < 50) {
     Node* a = hold_node_.get();
     if (a) {
       RigidBody* b = a->GetRigidBody(hold_body_);
@@ -3975,7 +3951,7 @@ void SpazNode::Step() {
     const dReal* p = dBodyGetPosition(body_head_->body());
     if (scene()->IsOutOfBounds(p[0], p[1], p[2])) {
       scene()->AddOutOfBoundsNode(this);
-      last_out_of_bounds_time_ = scene()->time();
+      last_out_of_bounds_time_ = scene_time;
     }
   }
   BA_DEBUG_CHECK_BODIES();
@@ -4132,6 +4108,10 @@ void SpazNode::DrawEyeLids(RenderComponent* c, float death_fade,
   c->FlipCullFace();  // back to normal
 }
 
+auto SpazNode::LODModel(ModelData* model) const -> ModelData* {
+  return model->GetLODForDistance(draw_lod_distance_);
+}
+
 void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
                              float death_scale, float* add_color) {
   // Set up shading.
@@ -4178,7 +4158,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, death_scale);
   }
   if (head_model_.exists()) {
-    c->DrawModel(head_model_->model_data());
+    c->DrawModel(LODModel(head_model_->model_data()));
   }
   c->PopTransform();
 
@@ -4245,7 +4225,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, death_scale);
   }
   if (torso_model_.exists()) {
-    c->DrawModel(torso_model_->model_data());
+    c->DrawModel(LODModel(torso_model_->model_data()));
   }
   c->PopTransform();
 
@@ -4256,7 +4236,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, death_scale);
   }
   if (pelvis_model_.exists()) {
-    c->DrawModel(pelvis_model_->model_data());
+    c->DrawModel(LODModel(pelvis_model_->model_data()));
   }
   c->PopTransform();
 
@@ -4294,7 +4274,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
   }
   if (upper_arm_model_.exists()) {
-    c->DrawModel(upper_arm_model_->model_data());
+    c->DrawModel(LODModel(upper_arm_model_->model_data()));
   }
   c->PopTransform();
 
@@ -4309,7 +4289,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
   }
   if (forearm_model_.exists() && !flippers_) {
-    c->DrawModel(forearm_model_->model_data());
+    c->DrawModel(LODModel(forearm_model_->model_data()));
   }
   c->PopTransform();
   if (!have_boxing_gloves_) {
@@ -4323,7 +4303,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
       c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
     }
     if (hand_model_.exists() && !flippers_) {
-      c->DrawModel(hand_model_->model_data());
+      c->DrawModel(LODModel(hand_model_->model_data()));
     }
   }
   c->PopTransform();
@@ -4352,7 +4332,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
   }
   if (upper_leg_model_.exists()) {
-    c->DrawModel(upper_leg_model_->model_data());
+    c->DrawModel(LODModel(upper_leg_model_->model_data()));
   }
   c->PopTransform();
 
@@ -4363,7 +4343,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
   }
   if (lower_leg_model_.exists()) {
-    c->DrawModel(lower_leg_model_->model_data());
+    c->DrawModel(LODModel(lower_leg_model_->model_data()));
   }
   c->PopTransform();
 
@@ -4373,7 +4353,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, death_scale);
   }
   if (toes_model_.exists()) {
-    c->DrawModel(toes_model_->model_data());
+    c->DrawModel(LODModel(toes_model_->model_data()));
   }
   c->PopTransform();
 
@@ -4409,7 +4389,9 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
   if (death_scale != 1.0f) {
     c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
   }
-  if (upper_arm_model_.exists()) c->DrawModel(upper_arm_model_->model_data());
+  if (upper_arm_model_.exists()) {
+    c->DrawModel(LODModel(upper_arm_model_->model_data()));
+  }
   c->PopTransform();
 
   // Left lower arm.
@@ -4424,7 +4406,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
     c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
   }
   if (forearm_model_.exists() && !flippers_) {
-    c->DrawModel(forearm_model_->model_data());
+    c->DrawModel(LODModel(forearm_model_->model_data()));
   }
   c->PopTransform();
   if (!have_boxing_gloves_) {
@@ -4438,7 +4420,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
       c->Scale(death_scale, death_scale, death_scale);
     }
     if (hand_model_.exists() && !flippers_) {
-      c->DrawModel(hand_model_->model_data());
+      c->DrawModel(LODModel(hand_model_->model_data()));
     }
   }
   c->PopTransform();
@@ -4464,7 +4446,9 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
   }
   if (death_scale != 1.0f)
     c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
-  if (upper_leg_model_.exists()) c->DrawModel(upper_leg_model_->model_data());
+  if (upper_leg_model_.exists()) {
+    c->DrawModel(LODModel(upper_leg_model_->model_data()));
+  }
   c->PopTransform();
 
   // Lower leg.
@@ -4474,7 +4458,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
   if (death_scale != 1.0f)
     c->Scale(death_scale, death_scale, 0.5f + death_scale * 0.5f);
   if (lower_leg_model_.exists()) {
-    c->DrawModel(lower_leg_model_->model_data());
+    c->DrawModel(LODModel(lower_leg_model_->model_data()));
   }
   c->PopTransform();
 
@@ -4483,7 +4467,7 @@ void SpazNode::DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
   c->TransformToBody(*left_toes_body_);
   c->Scale(-1, 1, 1);
   if (death_scale != 1.0f) c->Scale(death_scale, death_scale, death_scale);
-  if (toes_model_.exists()) c->DrawModel(toes_model_->model_data());
+  if (toes_model_.exists()) c->DrawModel(LODModel(toes_model_->model_data()));
   c->PopTransform();
 
   // RESTORE CULL
@@ -4504,6 +4488,19 @@ static void DrawRadialMeter(MeshIndexedSimpleFull* m, SimpleComponent* c,
 void SpazNode::Draw(FrameDef* frame_def) {
 #if !BA_HEADLESS_BUILD
 
+  // Update our camera distance once up front; LODModel() uses this to
+  // pick detail levels for our various body-part draws.
+  if (body_torso_.exists()) {
+    float cx, cy, cz;
+    g_graphics->camera()->get_position(&cx, &cy, &cz);
+    const dReal* p = dBodyGetPosition(body_torso_->body());
+    draw_lod_distance_ = (Vector3f(static_cast<float>(p[0]),
+                                   static_cast<float>(p[1]),
+                                   static_cast<float>(p[2]))
+                          - Vector3f(cx, cy, cz))
+                             .Length();
+  }
+
 #if BA_OSTYPE_MACOS
   if (g_graphics_server->renderer()->debug_draw_mode()) {
     SimpleComponent c(frame_def->overlay_3d_pass());
@@ -4867,9 +4864,16 @@ void SpazNode::Draw(FrameDef* frame_def) {
   /// draw our counter
   if (!counter_text_.empty() && !dead_) {
     {  // icon
-      SimpleComponent c(frame_def->overlay_3d_pass());
-      c.SetTransparent(true);
-      c.SetTexture(counter_texture_);
+      // Config only changes when our texture attr does (which
+      // invalidates the template); replay it with just the transform.
+      if (!counter_icon_template_.valid()) {
+        SimpleComponent c(frame_def->overlay_3d_pass());
+        c.SetTransparent(true);
+        c.SetTexture(counter_texture_);
+        c.RecordTemplate(&counter_icon_template_);
+      }
+      TemplateComponent c(frame_def->overlay_3d_pass(),
+                          counter_icon_template_);
       c.PushTransform();
       c.Translate(torso_pos[0] - 0.3f, torso_pos[1] + 1.47f,
                   torso_pos[2] - 0.2f);
@@ -8,6 +8,7 @@
 
 #include "ballistica/dynamics/part.h"
 #include "ballistica/game/player.h"
+#include "ballistica/graphics/component/render_component_template.h"
 #include "ballistica/graphics/renderer.h"
 #include "ballistica/scene/node/node.h"
 
@@ -113,7 +114,10 @@ class SpazNode : public Node {
   auto billboard_opacity() const -> float { return billboard_opacity_; }
   void set_billboard_opacity(float val) { billboard_opacity_ = val; }
   auto counter_texture() const -> Texture* { return counter_texture_.get(); }
-  void set_counter_texture(Texture* val) { counter_texture_ = val; }
+  void set_counter_texture(Texture* val) {
+    counter_texture_ = val;
+    counter_icon_template_.Invalidate();
+  }
   auto invincible() const -> bool { return invincible_; }
   void set_invincible(bool val) { invincible_ = val; }
   auto name_color() const -> std::vector<float> { return name_color_; }
@@ -248,6 +252,10 @@ class SpazNode : public Node {
     kLowerRightArmJointBroken = 1u << 9u
   };
   void PlayHurtSound();
+
+  // Return the right model from a body-part's LOD chain for our current
+  // camera distance (updated once per Draw()).
+  auto LODModel(ModelData* model) const -> ModelData*;
   void DrawBodyParts(ObjectComponent* c, bool shading, float death_fade,
                      float death_scale, float* add_color);
   void SetupEyeLidShading(ObjectComponent* c, float death_fade,
@@ -371,7 +379,9 @@ class SpazNode : public Node {
   Object::Ref<Texture> billboard_texture_;
   float billboard_opacity_{};
   float area_of_interest_radius_{5.0f};
+  float draw_lod_distance_{};
   Object::Ref<Texture> counter_texture_;
+  RenderComponentTemplate counter_icon_template_;
   Object::Ref<Texture> mini_billboard_1_texture_;
   millisecs_t mini_billboard_1_start_time_{};
   millisecs_t mini_billboard_1_end_time_{};
@@ -2,9 +2,11 @@
 
 #include "ballistica/scene/node/terrain_node.h"
 
+#include "ballistica/audio/audio.h"
 #include "ballistica/dynamics/bg/bg_dynamics.h"
 #include "ballistica/dynamics/material/material.h"
 #include "ballistica/graphics/component/object_component.h"
+#include "ballistica/graphics/component/template_component.h"
 #include "ballistica/graphics/renderer.h"
 #include "ballistica/media/component/collide_model.h"
 #include "ballistica/media/component/model.h"
@@ -100,6 +102,7 @@ TerrainNode::~TerrainNode() {
   // without our reference.
   if (collide_model_.exists()) {
     collide_model_->collide_model_data()->set_last_used_time(GetRealTime());
+    g_audio->RemoveOcclusionGeometry(collide_model_->collide_model_data());
   }
 }
 
@@ -118,6 +121,7 @@ void TerrainNode::SetCollideModel(CollideModel* val) {
   // if we had an old one, mark its last-used time so caching works properly..
   if (collide_model_.exists()) {
     collide_model_->collide_model_data()->set_last_used_time(GetRealTime());
+    g_audio->RemoveOcclusionGeometry(collide_model_->collide_model_data());
   }
   collide_model_ = val;
 
@@ -138,12 +142,21 @@ void TerrainNode::SetCollideModel(CollideModel* val) {
     if (!bumper_ && affect_bg_dynamics_) {
       AddToBGDynamics();
     }
+
+    // and to the audio occlusion bake (bumpers are invisible walls;
+    // sound shouldn't duck across those).
+    if (!bumper_) {
+      g_audio->AddOcclusionGeometry(collide_model_->collide_model_data());
+    }
   } else {
     body_.Clear();
   }
 }
 
-void TerrainNode::SetColorTexture(Texture* val) { color_texture_ = val; }
+void TerrainNode::SetColorTexture(Texture* val) {
+  color_texture_ = val;
+  draw_template_.Invalidate();
+}
 
 void TerrainNode::SetReflectionScale(const std::vector<float>& vals) {
   if (vals.size() != 1 && vals.size() != 3) {
@@ -159,6 +172,7 @@ void TerrainNode::SetReflectionScale(const std::vector<float>& vals) {
     reflection_scale_g_ = reflection_scale_[1];
     reflection_scale_b_ = reflection_scale_[2];
   }
+  draw_template_.Invalidate();
 }
 
 void TerrainNode::SetColor(const std::vector<float>& vals) {
@@ -174,6 +188,7 @@ void TerrainNode::SetColor(const std::vector<float>& vals) {
     color_g_ = color_[1];
     color_b_ = color_[2];
   }
+  draw_template_.Invalidate();
 }
 
 auto TerrainNode::GetReflection() const -> std::string {
@@ -181,9 +196,13 @@ auto TerrainNode::GetReflection() const -> std::string {
 }
 void TerrainNode::SetReflection(const std::string& val) {
   reflection_ = Graphics::ReflectionTypeFromString(val);
+  draw_template_.Invalidate();
 }
 
 void TerrainNode::SetBumper(bool val) {
+  if (val == bumper_) {
+    return;
+  }
   bumper_ = val;
   if (body_.exists()) {
     uint32_t is_bumper{RigidBody::kIsBumper};
@@ -193,6 +212,16 @@ void TerrainNode::SetBumper(bool val) {
       body_->set_flags(body_->flags() & ~is_bumper);  // off
     }
   }
+
+  // Keep the audio occlusion bake in line (it only includes
+  // non-bumpers).
+  if (collide_model_.exists()) {
+    if (bumper_) {
+      g_audio->RemoveOcclusionGeometry(collide_model_->collide_model_data());
+    } else {
+      g_audio->AddOcclusionGeometry(collide_model_->collide_model_data());
+    }
+  }
 }
 
 void TerrainNode::AddToBGDynamics() {
@@ -221,37 +250,49 @@ void TerrainNode::Draw(FrameDef* frame_def) {
   if (vr_only_ && !IsVRMode()) {
     return;
   }
-  ObjectComponent c(overlay_      ? frame_def->overlay_3d_pass()
-                    : background_ ? frame_def->beauty_pass_bg()
-                                  : frame_def->beauty_pass());
-  c.SetWorldSpace(true);
-  c.SetTexture(color_texture_);
-  if (lighting_) {
-    c.SetLightShadow(LightShadowType::kTerrain);
-  } else {
-    c.SetLightShadow(LightShadowType::kNone);
-  }
-  if (reflection_ != ReflectionType::kNone) {
-    c.SetReflection(reflection_);
-    c.SetReflectionScale(reflection_scale_r_, reflection_scale_g_,
-                         reflection_scale_b_);
-  }
-  float opacity;
-  if (frame_def->quality() <= GraphicsQuality::kHigh
-      && opacity_in_low_or_medium_quality_ >= 0.0f) {
-    opacity = opacity_in_low_or_medium_quality_;
-  } else {
-    opacity = opacity_;
-  }
+  RenderPass* pass = overlay_      ? frame_def->overlay_3d_pass()
+                     : background_ ? frame_def->beauty_pass_bg()
+                                   : frame_def->beauty_pass();
 
-  // these options currently don't have a world-space-optimized version..
-  if (opacity < 1.0f || overlay_) {
-    c.SetTransparent(true);
-    c.SetWorldSpace(false);
-    c.SetColor(color_r_, color_g_, color_b_, opacity);
-  } else {
-    c.SetColor(color_r_, color_g_, color_b_, 1.0f);
+  // Our full config only changes when an attr does (which invalidates
+  // the template) or when graphics quality shifts our opacity choice;
+  // re-record it then and just replay it on all the frames in between.
+  if (!draw_template_.valid()
+      || frame_def->quality() != draw_template_quality_) {
+    ObjectComponent c(pass);
+    c.SetWorldSpace(true);
+    c.SetTexture(color_texture_);
+    if (lighting_) {
+      c.SetLightShadow(LightShadowType::kTerrain);
+    } else {
+      c.SetLightShadow(LightShadowType::kNone);
+    }
+    if (reflection_ != ReflectionType::kNone) {
+      c.SetReflection(reflection_);
+      c.SetReflectionScale(reflection_scale_r_, reflection_scale_g_,
+                           reflection_scale_b_);
+    }
+    float opacity;
+    if (frame_def->quality() <= GraphicsQuality::kHigh
+        && opacity_in_low_or_medium_quality_ >= 0.0f) {
+      opacity = opacity_in_low_or_medium_quality_;
+    } else {
+      opacity = opacity_;
+    }
+
+    // these options currently don't have a world-space-optimized version..
+    if (opacity < 1.0f || overlay_) {
+      c.SetTransparent(true);
+      c.SetWorldSpace(false);
+      c.SetColor(color_r_, color_g_, color_b_, opacity);
+    } else {
+      c.SetColor(color_r_, color_g_, color_b_, 1.0f);
+    }
+    c.RecordTemplate(&draw_template_);
+    draw_template_quality_ = frame_def->quality();
   }
+
+  TemplateComponent c(pass, draw_template_);
   uint32_t drawFlags = 0;
   if (!visible_in_reflections_) {
     drawFlags |= kModelDrawFlagNoReflection;
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "ballistica/dynamics/part.h"
+#include "ballistica/graphics/component/render_component_template.h"
 #include "ballistica/scene/node/node.h"
 
 namespace ballistica {
@@ -26,16 +27,26 @@ class TerrainNode : public Node {
   auto bumper() const -> bool { return bumper_; }
   void SetBumper(bool val);
   auto background() const -> bool { return background_; }
-  void set_background(bool val) { background_ = val; }
+  void set_background(bool val) {
+    background_ = val;
+    draw_template_.Invalidate();
+  }
   auto overlay() const -> bool { return overlay_; }
-  void set_overlay(bool val) { overlay_ = val; }
+  void set_overlay(bool val) {
+    overlay_ = val;
+    draw_template_.Invalidate();
+  }
   auto opacity() const -> float { return opacity_; }
-  void set_opacity(float val) { opacity_ = val; }
+  void set_opacity(float val) {
+    opacity_ = val;
+    draw_template_.Invalidate();
+  }
   auto opacity_in_low_or_medium_quality() const -> float {
     return opacity_in_low_or_medium_quality_;
   }
   void set_opacity_in_low_or_medium_quality(float val) {
     opacity_in_low_or_medium_quality_ = val;
+    draw_template_.Invalidate();
   }
   auto GetReflection() const -> std::string;
   void SetReflection(const std::string& val);
@@ -44,7 +55,10 @@ class TerrainNode : public Node {
   }
   void SetReflectionScale(const std::vector<float>& vals);
   auto getLighting() const -> bool { return lighting_; }
-  void setLighting(bool val) { lighting_ = val; }
+  void setLighting(bool val) {
+    lighting_ = val;
+    draw_template_.Invalidate();
+  }
   auto color() const -> const std::vector<float>& { return color_; }
   void SetColor(const std::vector<float>& vals);
   auto model() const -> Model* { return model_.get(); }
@@ -82,6 +96,11 @@ class TerrainNode : public Node {
   float reflection_scale_r_, reflection_scale_g_, reflection_scale_b_;
   std::vector<float> color_;
   float color_r_, color_g_, color_b_;
+
+  // Recorded draw config; terrain state rarely changes, so most frames
+  // just replay this instead of re-writing the full config.
+  RenderComponentTemplate draw_template_;
+  GraphicsQuality draw_template_quality_{GraphicsQuality::kAuto};
 };
 
 }  // namespace ballistica
@@ -32,7 +32,9 @@ auto TextureSequenceNode::InitType() -> NodeType* {
 }
 
 TextureSequenceNode::TextureSequenceNode(Scene* scene)
-    : Node(scene, node_type), index_(0), rate_(1000), sleep_count_(0) {}
+    : Node(scene, node_type), index_(0), rate_(1000), sleep_count_(0) {
+  set_needs_step(true);
+}
 
 auto TextureSequenceNode::input_textures() const -> std::vector<Texture*> {
   return RefsToPointers(input_textures_);
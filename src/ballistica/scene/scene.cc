@@ -2,6 +2,7 @@
 
 #include "ballistica/scene/scene.h"
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
 
@@ -12,11 +13,14 @@
 #include "ballistica/dynamics/part.h"
 #include "ballistica/game/game_stream.h"
 #include "ballistica/game/player.h"
+#include "ballistica/game/replay_benchmark.h"
+#include "ballistica/generic/utils.h"
 #include "ballistica/graphics/camera.h"
 #include "ballistica/graphics/graphics.h"
 #include "ballistica/input/device/input_device.h"
 #include "ballistica/media/component/sound.h"
 #include "ballistica/networking/networking.h"
+#include "ballistica/platform/platform.h"
 #include "ballistica/python/python_context_call.h"
 #include "ballistica/scene/node/anim_curve_node.h"
 #include "ballistica/scene/node/bomb_node.h"
@@ -106,6 +110,10 @@ void Scene::SetupNodeMessageType(const std::string& name, NodeMessageType val,
   assert(g_app_globals != nullptr);
   g_app_globals->node_message_types[name] = val;
   assert(static_cast<int>(val) >= 0);
+
+  // Make sure the hashed dispatch in GetNodeMessageType stays in sync
+  // with what gets registered here.
+  assert(GetNodeMessageType(name) == val);
   if (g_app_globals->node_message_formats.size() <= static_cast<size_t>(val)) {
     g_app_globals->node_message_formats.resize(static_cast<size_t>(val) + 1);
   }
@@ -185,6 +193,12 @@ auto Scene::IsOutOfBounds(float x, float y, float z) -> bool {
 }
 
 void Scene::Draw(FrameDef* frame_def) {
+  // Update how far into the current sim step this frame lands so body
+  // transforms can interpolate between the last two steps.
+  draw_interp_fraction_ = std::min(
+      1.0f, static_cast<float>(GetRealTime() - last_step_real_time_)
+                / static_cast<float>(kGameStepMilliseconds));
+
   // Draw our nodes.
   for (auto&& i : nodes_) {
     g_graphics->PreNodeDraw();
@@ -197,12 +211,59 @@ void Scene::Draw(FrameDef* frame_def) {
 }
 
 auto Scene::GetNodeMessageType(const std::string& type) -> NodeMessageType {
-  assert(g_app_globals != nullptr);
-  auto i = g_app_globals->node_message_types.find(type);
-  if (i == g_app_globals->node_message_types.end()) {
-    throw Exception("Invalid node-message type: '" + type + "'");
+  // Scripts send these at high rates, so dispatch on a hashed name
+  // rather than a map probe. The equality check on each hit makes a
+  // hash collision with an unknown name harmless, and a collision
+  // between two known names can't happen (duplicate case labels
+  // wouldn't compile). SetupNodeMessageType round-trip-verifies this
+  // list against registration in debug builds.
+  switch (Utils::ConstHash(type.c_str())) {
+    case Utils::ConstHash("flash"):
+      if (type == "flash") return NodeMessageType::kFlash;
+      break;
+    case Utils::ConstHash("footing"):
+      if (type == "footing") return NodeMessageType::kFooting;
+      break;
+    case Utils::ConstHash("impulse"):
+      if (type == "impulse") return NodeMessageType::kImpulse;
+      break;
+    case Utils::ConstHash("kick_back"):
+      if (type == "kick_back") return NodeMessageType::kKickback;
+      break;
+    case Utils::ConstHash("celebrate"):
+      if (type == "celebrate") return NodeMessageType::kCelebrate;
+      break;
+    case Utils::ConstHash("celebrate_l"):
+      if (type == "celebrate_l") return NodeMessageType::kCelebrateL;
+      break;
+    case Utils::ConstHash("celebrate_r"):
+      if (type == "celebrate_r") return NodeMessageType::kCelebrateR;
+      break;
+    case Utils::ConstHash("knockout"):
+      if (type == "knockout") return NodeMessageType::kKnockout;
+      break;
+    case Utils::ConstHash("hurt_sound"):
+      if (type == "hurt_sound") return NodeMessageType::kHurtSound;
+      break;
+    case Utils::ConstHash("picked_up"):
+      if (type == "picked_up") return NodeMessageType::kPickedUp;
+      break;
+    case Utils::ConstHash("jump_sound"):
+      if (type == "jump_sound") return NodeMessageType::kJumpSound;
+      break;
+    case Utils::ConstHash("attack_sound"):
+      if (type == "attack_sound") return NodeMessageType::kAttackSound;
+      break;
+    case Utils::ConstHash("scream_sound"):
+      if (type == "scream_sound") return NodeMessageType::kScreamSound;
+      break;
+    case Utils::ConstHash("stand"):
+      if (type == "stand") return NodeMessageType::kStand;
+      break;
+    default:
+      break;
   }
-  return i->second;
+  throw Exception("Invalid node-message type: '" + type + "'");
 }
 
 auto Scene::GetNodeMessageTypeName(NodeMessageType t) -> std::string {
@@ -225,16 +286,113 @@ auto Scene::GetPlayerNode(int id) -> PlayerNode* {
   return nullptr;
 }
 
+void Scene::AddAttrRepeater(Node* node, int attr_index, float base,
+                            float amplitude, millisecs_t period,
+                            AttrRepeaterStyle style) {
+  assert(node);
+
+  // Re-registering an attr replaces its repeater; non-positive periods
+  // simply remove.
+  for (auto i = attr_repeaters_.begin(); i != attr_repeaters_.end(); ++i) {
+    if (i->node.get() == node && i->attr_index == attr_index) {
+      attr_repeaters_.erase(i);
+      break;
+    }
+  }
+  if (period <= 0) {
+    return;
+  }
+
+  // Anything previously driving this attr loses out, same as with a
+  // direct set.
+  NodeAttribute attr = node->GetAttribute(attr_index);
+  if (attr.type() != NodeAttributeType::kFloat) {
+    throw Exception("Attr '" + attr.name() + "' is not a float attr.",
+                    PyExcType::kValue);
+  }
+  attr.DisconnectIncoming();
+
+  AttrRepeater r;
+  r.node = node;
+  r.attr_index = attr_index;
+  r.base = base;
+  r.amplitude = amplitude;
+  r.period = period;
+  r.style = style;
+  attr_repeaters_.push_back(r);
+}
+
+void Scene::StepAttrRepeaters() {
+  if (attr_repeaters_.empty()) {
+    return;
+  }
+  GameStream* out_stream = GetGameStream();
+  for (auto i = attr_repeaters_.begin(); i != attr_repeaters_.end();) {
+    Node* node = i->node.get();
+    if (!node) {
+      i = attr_repeaters_.erase(i);
+      continue;
+    }
+    auto phase = static_cast<float>(time_ % i->period)
+                 / static_cast<float>(i->period);
+    float val;
+    switch (i->style) {
+      case AttrRepeaterStyle::kSquare:
+        val = (phase < 0.5f) ? 1.0f : -1.0f;
+        break;
+      case AttrRepeaterStyle::kTriangle:
+        val = (phase < 0.5f) ? (4.0f * phase - 1.0f) : (3.0f - 4.0f * phase);
+        break;
+      case AttrRepeaterStyle::kSawtooth:
+        val = 2.0f * phase - 1.0f;
+        break;
+      default:
+        val = sinf(phase * 2.0f * 3.1415926535f);
+        break;
+    }
+    val = i->base + i->amplitude * val;
+    NodeAttribute attr = node->GetAttribute(i->attr_index);
+    if (out_stream) {
+      out_stream->SetNodeAttr(attr, val);
+    }
+    attr.Set(val);
+    ++i;
+  }
+}
+
 void Scene::Step() {
+  // Per-step timing for replay benchmarks; free when none's running.
+  ReplayBenchmark* bench = ReplayBenchmark::Active();
+  int64_t bench_start = bench ? Platform::GetCurrentMicroseconds() : 0;
+
   out_of_bounds_nodes_.clear();
 
-  // Step all our nodes.
+  // Advance native attr repeaters first so nodes step with this tick's
+  // values in place.
+  StepAttrRepeaters();
+
+  // Rebuild our list of nodes needing per-step attention if anything
+  // membership-related changed. Quiescent nodes (no Step() logic and no
+  // outgoing attr connections) stay off the list and cost us nothing.
+  if (step_list_dirty_) {
+    step_nodes_.clear();
+    for (auto&& i : nodes_) {
+      Node* node = i.get();
+      if (node->needs_step() || !node->attribute_connections().empty()) {
+        step_nodes_.push_back(node);
+      }
+    }
+    step_list_dirty_ = false;
+  }
+
+  // Step all our nodes (well, the ones with something to do).
   {
     in_step_ = true;
     last_step_real_time_ = GetRealTime();
-    for (auto&& i : nodes_) {
-      Node* node = i.get();
-      node->Step();
+    for (Node* node : step_nodes_) {
+      if (node->needs_step()) {
+        node->Step();
+      }
 
       // Now that it's stepped, pump new values to any nodes it's connected to.
       node->UpdateConnections();
@@ -260,8 +418,53 @@ void Scene::Step() {
   // Lastly step our sim.
   dynamics_->process();
 
+  if (step_checksums_enabled_) {
+    UpdateStepChecksum();
+  }
+
   time_ += kGameStepMilliseconds;
   stepnum_++;
+
+  if (bench) {
+    bench->SampleSceneStep(Platform::GetCurrentMicroseconds() - bench_start);
+  }
+}
+
+// Fold bytes into a 64-bit FNV-1a hash.
+static void HashBytes(uint64_t* h, const void* data, size_t size) {
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < size; i++) {
+    *h ^= bytes[i];
+    *h *= 0x100000001B3u;
+  }
+}
+
+void Scene::UpdateStepChecksum() {
+  uint64_t h{0xCBF29CE484222325u};
+  HashBytes(&h, &stepnum_, sizeof(stepnum_));
+
+  // Nodes are walked in creation order, which is replicated exactly on
+  // clients and replays via the stream; the body walk below is likewise
+  // order-stable. Note that this is a same-build verification tool:
+  // float bytes can legitimately differ across platforms/compilers.
+  for (auto&& i : nodes_) {
+    Node* node = i.get();
+    int64_t node_id = node->id();
+    HashBytes(&h, &node_id, sizeof(node_id));
+    for (auto&& part : node->parts()) {
+      for (auto&& body : part->rigid_bodies()) {
+        if (dBodyID b = body->body()) {
+          HashBytes(&h, dBodyGetPosition(b), 3 * sizeof(dReal));
+          HashBytes(&h, dBodyGetQuaternion(b), 4 * sizeof(dReal));
+          HashBytes(&h, dBodyGetLinearVel(b), 3 * sizeof(dReal));
+          HashBytes(&h, dBodyGetAngularVel(b), 3 * sizeof(dReal));
+        } else {
+          HashBytes(&h, dGeomGetPosition(body->geom()), 3 * sizeof(dReal));
+        }
+      }
+    }
+  }
+  last_step_checksum_ = h;
 }
 
 void Scene::DeleteNode(Node* node) {
@@ -291,6 +494,10 @@ void Scene::DeleteNode(Node* node) {
   Object::Ref<Node> temp_ref(node);
   nodes_.erase(node->iterator());
 
+  // Drop any raw step-list entry for it (and for src nodes whose outgoing
+  // connections died with it).
+  MarkStepListDirty();
+
   temp_ref.Clear();
 
   // Sanity test: at this point the node should be dead.
@@ -362,6 +569,12 @@ auto Scene::NewNode(const std::string& type_string, const std::string& name,
   }
   auto node = Object::MakeRefCounted<Node>(i->second->Create(this));
   assert(node.exists());
+
+  // The first instance of each type we create doubles as the type's
+  // default attr snapshot; stream dumps use it to skip unchanged values.
+  if (!i->second->have_default_attr_values()) {
+    i->second->CaptureDefaultAttrValues(node.get());
+  }
   node->AddToScene(this);
   node->set_label(name);
   node->SetDelegate(delegate);
@@ -400,14 +613,18 @@ void Scene::DumpNodes(GameStream* out) {
     Node* node = i1.get();
     assert(node);
 
-    // Now we need to set *all* of its attrs in order.
-    // FIXME: Could be nice to send only ones that have changed from
-    //  defaults; would need to add that functionality to NodeType.
+    // Now we need to set its attrs in order, skipping any still at their
+    // type defaults (clients recreate nodes through the same constructors
+    // so defaults match). On long-running servers most nodes sit mostly
+    // at defaults, so this cuts late-joiner snapshots down dramatically.
     NodeType* node_type = node->type();
     for (auto&& i2 : node_type->attributes_by_index()) {
       NodeAttribute attr;
       attr.assign(node, i2);
       if (!attr.is_read_only()) {
+        if (node_type->IsDefaultAttrValue(attr)) {
+          continue;
+        }
         switch (attr.type()) {
           case NodeAttributeType::kFloat: {
             out->SetNodeAttr(attr, attr.GetAsFloat());
@@ -626,6 +843,7 @@ auto Scene::AddNode(Node* node, int64_t* node_id, NodeList::iterator* i)
   assert(node && node_id && i);
   *node_id = next_node_id_++;
   *i = nodes_.insert(nodes_.end(), Object::Ref<Node>(node));
+  MarkStepListDirty();
 }
 
 }  // namespace ballistica
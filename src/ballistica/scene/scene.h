@@ -81,12 +81,47 @@ class Scene : public Object {
   auto last_step_real_time() const -> millisecs_t {
     return last_step_real_time_;
   }
+
+  // How far real time has progressed into the current sim step as of the
+  // frame being drawn (0-1); used to interpolate body transforms so the
+  // fixed-rate sim stays smooth at higher refresh rates.
+  auto draw_interp_fraction() const -> float { return draw_interp_fraction_; }
   auto globals_node() const -> GlobalsNode* { return globals_node_; }
   auto set_globals_node(GlobalsNode* node) -> void { globals_node_ = node; }
 
+  /// Native repeaters for float node attrs; these run in Step() so
+  /// mechanical per-tick updates (cooldown flashes, pulsing lights,
+  /// etc.) don't each need a Python timer fire. Re-registering the
+  /// same node/attr replaces the old repeater; a zero or negative
+  /// period removes it. Repeaters die with their node.
+  auto AddAttrRepeater(Node* node, int attr_index, float base,
+                       float amplitude, millisecs_t period,
+                       AttrRepeaterStyle style) -> void;
+  auto StepAttrRepeaters() -> void;
+
+  /// Inform the scene that the set of nodes needing per-step attention
+  /// may have changed (a node was added/removed or gained/lost outgoing
+  /// attr connections). The step list is rebuilt lazily next Step().
+  auto MarkStepListDirty() -> void { step_list_dirty_ = true; }
+
+  /// Determinism-verification support: when enabled, a 64-bit FNV-1a
+  /// checksum over core sim state (node ids plus rigid-body transforms
+  /// and velocities, walked in fixed node order) is computed at the end
+  /// of each Step(). Same-input runs must yield identical checksum
+  /// sequences, so comparing them across a host and its replays catches
+  /// divergence and makes sim refactors verifiable.
+  auto set_step_checksums_enabled(bool val) -> void {
+    step_checksums_enabled_ = val;
+  }
+  auto step_checksums_enabled() const -> bool {
+    return step_checksums_enabled_;
+  }
+  auto last_step_checksum() const -> uint64_t { return last_step_checksum_; }
+
  private:
   static auto SetupNodeMessageType(const std::string& name, NodeMessageType val,
                                    const std::string& format) -> void;
+  auto UpdateStepChecksum() -> void;
 
   GlobalsNode* globals_node_{};  // Current globals node (if any).
   std::unordered_map<int, Object::WeakRef<PlayerNode> > player_nodes_;
@@ -101,12 +136,30 @@ class Scene : public Object {
 
   // For globals real_time attr (so is consistent through the step.)
   millisecs_t last_step_real_time_{};
+  float draw_interp_fraction_{1.0f};
   int bg_cover_count_{};
   bool shutting_down_{};
   float bounds_min_[3]{};
   float bounds_max_[3]{};
   std::vector<Object::WeakRef<Node> > out_of_bounds_nodes_;
+  struct AttrRepeater {
+    Object::WeakRef<Node> node;
+    int attr_index{};
+    float base{};
+    float amplitude{};
+    millisecs_t period{};
+    AttrRepeaterStyle style{};
+  };
+  std::vector<AttrRepeater> attr_repeaters_;
   NodeList nodes_;
+
+  // Subset of nodes_ (in node order) with actual per-step work: a Step()
+  // override or outgoing attr connections. Static scenery such as text,
+  // images, and terrain stays out of the step loop entirely.
+  std::vector<Node*> step_nodes_;
+  bool step_list_dirty_{true};
+  bool step_checksums_enabled_{};
+  uint64_t last_step_checksum_{};
   Object::Ref<Dynamics> dynamics_;
 };
 
@@ -24,6 +24,7 @@ const int kActivateKey2 = SDLK_F2;
 
 Console::Console() {
   assert(InGameThread());
+  lines_.resize(kConsoleLineLimit);
   std::string title = std::string("BallisticaCore ") + kAppVersion + " ("
                       + std::to_string(kAppBuildNumber) + ")";
   if (g_buildconfig.debug_build()) {
@@ -113,7 +114,7 @@ auto Console::HandleKeyPress(const SDL_Keysym* keysym) -> bool {
       input_history_position_ = 0;
       if (input_string_ == "clear") {
         last_line_.clear();
-        lines_.clear();
+        lines_count_ = 0;
       } else {
         g_game->PushInGameConsoleScriptCommand(input_string_);
       }
@@ -184,6 +185,16 @@ auto Console::HandleKeyRelease(const SDL_Keysym* keysym) -> bool {
   return state_ != State::kInactive;
 }
 
+void Console::AppendLine(Message m) {
+  // Overwrite the oldest ring slot; its old string storage gets reused
+  // where capacities allow instead of a fresh list node per line.
+  lines_[lines_next_] = std::move(m);
+  lines_next_ = (lines_next_ + 1) % lines_.size();
+  if (lines_count_ < lines_.size()) {
+    lines_count_++;
+  }
+}
+
 void Console::Print(const std::string& sIn) {
   assert(InGameThread());
   std::string s = Utils::GetValidUTF8(sIn.c_str(), "cspr");
@@ -194,8 +205,7 @@ void Console::Print(const std::string& sIn) {
 
   // Spit out all completed lines and keep the last one as lastline.
   for (size_t i = 0; i < broken_up.size() - 1; i++) {
-    lines_.emplace_back(broken_up[i], GetRealTime());
-    if (lines_.size() > kConsoleLineLimit) lines_.pop_front();
+    AppendLine(Message(broken_up[i], GetRealTime()));
   }
   last_line_ = broken_up[broken_up.size() - 1];
   last_line_mesh_dirty_ = true;
@@ -341,14 +351,26 @@ void Console::Draw(RenderPass* pass) {
         }
         v += 14;
       }
-      for (auto i = lines_.rbegin(); i != lines_.rend(); i++) {
-        int elem_count = i->getText().GetElementCount();
+      // Building text meshes for a big backlog of lines in one go can
+      // hitch the frame right as the console comes up, so cap fresh
+      // builds per draw; older lines fill in over the next few frames.
+      int mesh_builds_remaining{8};
+      for (size_t k = 0; k < lines_count_; k++) {
+        Message& line =
+            lines_[(lines_next_ + lines_.size() - 1 - k) % lines_.size()];
+        if (!line.has_mesh()) {
+          if (mesh_builds_remaining == 0) {
+            break;
+          }
+          mesh_builds_remaining--;
+        }
+        int elem_count = line.getText().GetElementCount();
         for (int e = 0; e < elem_count; e++) {
-          c.SetTexture(i->getText().GetElementTexture(e));
+          c.SetTexture(line.getText().GetElementTexture(e));
           c.PushTransform();
           c.Translate(h, v + 2, kConsoleZDepth);
           c.Scale(draw_scale, draw_scale);
-          c.DrawMesh(i->getText().GetElementMesh(e));
+          c.DrawMesh(line.getText().GetElementMesh(e));
           c.PopTransform();
         }
         v += 14;
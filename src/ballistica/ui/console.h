@@ -6,6 +6,7 @@
 #include <list>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "ballistica/core/object.h"
 #include "ballistica/graphics/renderer.h"
@@ -41,10 +42,12 @@ class Console {
 
   class Message {
    public:
+    Message() = default;
     Message(std::string s_in, millisecs_t c)
         : creation_time(c), s(std::move(s_in)) {}
-    millisecs_t creation_time;
+    millisecs_t creation_time{};
     std::string s;
+    auto has_mesh() const -> bool { return s_mesh_.exists(); }
     auto getText() -> TextGroup& {
       if (!s_mesh_.exists()) {
         s_mesh_ = Object::New<TextGroup>();
@@ -56,10 +59,22 @@ class Console {
    private:
     Object::Ref<TextGroup> s_mesh_;
   };
+
+  // Oldest line in the ring; valid only while lines_count_ > 0.
+  auto lines_start() const -> size_t {
+    assert(lines_count_ <= lines_.size());
+    return (lines_next_ + lines_.size() - lines_count_) % lines_.size();
+  }
+  void AppendLine(Message m);
   std::string input_string_;
   std::list<std::string> input_history_;
   int input_history_position_{};
-  std::list<Message> lines_;
+
+  // Fixed-size ring of completed console lines; lines_next_ is where
+  // the next one lands and lines_count_ how many are valid.
+  std::vector<Message> lines_;
+  size_t lines_next_{};
+  size_t lines_count_{};
   std::string last_line_;
   Object::Ref<TextGroup> last_line_mesh_group_;
   bool last_line_mesh_dirty_{true};
@@ -36,20 +36,56 @@ auto ColumnWidget::HandleMessage(const WidgetMessage& m) -> bool {
 void ColumnWidget::UpdateLayout() {
   BA_DEBUG_UI_READ_LOCK;
 
+  // Selection changes dirty entire ancestor chains, so most of our
+  // layout passes arrive with nothing actually moved. Compare each
+  // child's extent (and position) against our last full layout; if it
+  // all matches and our borders/margins haven't changed, the translates
+  // we already applied are still correct and we can skip the rest.
+  bool unchanged =
+      (widgets().size() == layout_records_.size() && border_ == layout_border_
+       && margin_ == layout_margin_ && left_border_ == layout_left_border_
+       && top_border_ == layout_top_border_
+       && bottom_border_ == layout_bottom_border_);
+  if (unchanged) {
+    size_t n{};
+    for (const auto& i : widgets()) {
+      const LayoutRecord& r = layout_records_[n++];
+      if (&(*i) != r.widget || (*i).GetHeight() * (*i).scale() != r.extent
+          || (*i).ty() != r.ty) {
+        unchanged = false;
+        break;
+      }
+    }
+  }
+  if (unchanged) {
+    return;
+  }
+  layout_border_ = border_;
+  layout_margin_ = margin_;
+  layout_left_border_ = left_border_;
+  layout_top_border_ = top_border_;
+  layout_bottom_border_ = bottom_border_;
+  layout_records_.resize(widgets().size());
+
   float total_height{2.0f * margin_};
-  for (const auto& i : widgets()) {
-    float wh = (*i).GetHeight() * (*i).scale();
-    total_height += 2.0f * border_ + wh + top_border_ + bottom_border_;
+  {
+    size_t n{};
+    for (const auto& i : widgets()) {
+      float wh = (*i).GetHeight() * (*i).scale();
+      layout_records_[n].widget = &(*i);
+      layout_records_[n].extent = wh;
+      n++;
+      total_height += 2.0f * border_ + wh + top_border_ + bottom_border_;
+    }
   }
   float b{total_height - margin_};
   float l{border_ + left_border_ + margin_};
-  for (auto&& i : widgets()) {
-    float w_scale = (*i).scale();
-    float wh = (*i).GetHeight() * w_scale;
+  for (auto&& i : layout_records_) {
     b -= border_;
     b -= top_border_;
-    b -= wh;
-    (*i).set_translate(l, b);
+    b -= i.extent;
+    i.widget->set_translate(l, b);
+    i.ty = b;
     b -= bottom_border_;
     b -= border_;
   }
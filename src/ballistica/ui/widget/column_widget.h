@@ -4,6 +4,7 @@
 #define BALLISTICA_UI_WIDGET_COLUMN_WIDGET_H_
 
 #include <string>
+#include <vector>
 
 #include "ballistica/ui/widget/container_widget.h"
 
@@ -35,6 +36,23 @@ class ColumnWidget : public ContainerWidget {
   float left_border_{};
   float top_border_{};
   float bottom_border_{};
+
+ private:
+  // Per-child placement as of our last full layout; lets UpdateLayout
+  // skip repositioning when nothing has moved (see note there). The
+  // applied ty is included so a new child reusing a dead one's address
+  // can't masquerade as unchanged.
+  struct LayoutRecord {
+    Widget* widget{};
+    float extent{};
+    float ty{};
+  };
+  std::vector<LayoutRecord> layout_records_;
+  float layout_border_{-1.0f};
+  float layout_margin_{-1.0f};
+  float layout_left_border_{-1.0f};
+  float layout_top_border_{-1.0f};
+  float layout_bottom_border_{-1.0f};
 };
 
 }  // namespace ballistica
@@ -125,13 +125,13 @@ void ContainerWidget::DrawChildren(RenderPass* pass, bool draw_transparent,
   float cull_offset_h = 0.0f;
 
   // FIXME: need to test/update this to support scaling.
-  if (pw && pw->simple_culling_v() >= 0.0f) {
+  if (pw && pw->simple_culling_v() >= 0.0f && transition_scale_ == 1.0f) {
     doing_culling_v = true;
     cull_top = pw->simple_culling_top() - ty();
     cull_bottom = pw->simple_culling_bottom() - ty();
     cull_offset_v = pw->simple_culling_v();
   }
-  if (pw && pw->simple_culling_h() >= 0.0f) {
+  if (pw && pw->simple_culling_h() >= 0.0f && transition_scale_ == 1.0f) {
     doing_culling_h = true;
     cull_right = pw->simple_culling_right() - tx();
     cull_left = pw->simple_culling_left() - tx();
@@ -285,6 +285,51 @@ void ContainerWidget::DrawChildren(RenderPass* pass, bool draw_transparent,
   }
 }
 
+auto ContainerWidget::IsChildScrolledOff(Widget* w) -> bool {
+  Widget* pw = parent_widget();
+  if (pw == nullptr) {
+    return false;
+  }
+  if (pw->simple_culling_v() >= 0.0f) {
+    float cull_top = pw->simple_culling_top() - ty();
+    float cull_bottom = pw->simple_culling_bottom() - ty();
+    float margin = pw->simple_culling_v();
+    if (w->ty() > cull_top + margin
+        || w->ty() + w->scale() * w->GetHeight() < cull_bottom - margin) {
+      return true;
+    }
+  }
+  if (pw->simple_culling_h() >= 0.0f) {
+    float cull_left = pw->simple_culling_left() - tx();
+    float cull_right = pw->simple_culling_right() - tx();
+    float margin = pw->simple_culling_h();
+    if (w->tx() > cull_right + margin
+        || w->tx() + w->scale() * w->GetWidth() < cull_left - margin) {
+      return true;
+    }
+  }
+  return false;
+}
+
+auto ContainerWidget::CanSkipMouseMove(Widget* w, float x, float y, float px,
+                                       float py) -> bool {
+  // Containers can have children poking out past their nominal bounds;
+  // always pass moves along to them.
+  if (w->HasChildren()) {
+    return false;
+  }
+
+  // Extra slop covering widgets' touch-overlap hit regions.
+  float margin = 60.0f;
+  float ww = w->GetWidth();
+  float wh = w->GetHeight();
+  if (x >= -margin && x < ww + margin && y >= -margin && y < wh + margin) {
+    return false;
+  }
+  return !(px >= -margin && px < ww + margin && py >= -margin
+           && py < wh + margin);
+}
+
 auto ContainerWidget::HandleMessage(const WidgetMessage& m) -> bool {
   BA_DEBUG_UI_READ_LOCK;
 
@@ -466,14 +511,34 @@ auto ContainerWidget::HandleMessage(const WidgetMessage& m) -> bool {
         break;
       }
 
+      float px = prev_pointer_x_;
+      float py = prev_pointer_y_;
+      prev_pointer_x_ = x;
+      prev_pointer_y_ = y;
+
       if (!root_selectable_) {
         // Go through all widgets backwards until one claims the cursor position
         // (we still send it to other widgets even then though in case they
         // case).
         for (auto i = widgets_.rbegin(); i != widgets_.rend(); i++) {
+          // Children scrolled out of view can't be under the cursor;
+          // don't bother them (big scroll lists can have hundreds).
+          if (IsChildScrolledOff(&(**i))) {
+            continue;
+          }
           float cx = x;
           float cy = y;
           TransformPointToChild(&cx, &cy, **i);
+
+          // Touch devices flood this path; leaf widgets the cursor is
+          // nowhere near (at either the current or previous position)
+          // have no hover state to update and can be skipped.
+          float pcx = px;
+          float pcy = py;
+          TransformPointToChild(&pcx, &pcy, **i);
+          if (CanSkipMouseMove(&(**i), cx, cy, pcx, pcy)) {
+            continue;
+          }
           if ((**i).HandleMessage(
                   WidgetMessage(m.type, nullptr, cx, cy, claimed))) {
             claimed = true;
@@ -522,6 +587,9 @@ auto ContainerWidget::HandleMessage(const WidgetMessage& m) -> bool {
 
       // Go through all widgets backwards until one claims the wheel.
       for (auto i = widgets_.rbegin(); i != widgets_.rend(); i++) {
+        if (IsChildScrolledOff(&(**i))) {
+          continue;
+        }
         float cx = x;
         float cy = y;
         TransformPointToChild(&cx, &cy, ((**i)));
@@ -555,6 +623,11 @@ auto ContainerWidget::HandleMessage(const WidgetMessage& m) -> bool {
       float y = m.fval2;
       auto click_count = static_cast<int>(m.fval3);
 
+      // Touch taps can arrive without a preceding move; track them too
+      // so the next move's near-pointer test sees where they landed.
+      prev_pointer_x_ = x;
+      prev_pointer_y_ = y;
+
       float l = 0;
       float r = width_;
       float b = 0;
@@ -563,6 +636,9 @@ auto ContainerWidget::HandleMessage(const WidgetMessage& m) -> bool {
       if (!root_selectable_) {
         // Go through all widgets backwards until one claims the click.
         for (auto i = widgets_.rbegin(); i != widgets_.rend(); i++) {
+          if (IsChildScrolledOff(&(**i))) {
+            continue;
+          }
           float cx = x;
           float cy = y;
           TransformPointToChild(&cx, &cy, **i);
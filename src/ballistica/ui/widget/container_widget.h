@@ -196,6 +196,17 @@ class ContainerWidget : public Widget {
   auto GetClosestRightWidget(float x, float y, Widget* ignoreWidget) -> Widget*;
   auto GetClosestLeftWidget(float x, float y, Widget* ignoreWidget) -> Widget*;
   auto GetMult(millisecs_t current_time, bool for_glow = false) const -> float;
+
+  // Whether a child lies fully outside our parent's scroll cull window
+  // and thus can't currently be visible or under the cursor.
+  auto IsChildScrolledOff(Widget* w) -> bool;
+
+  // Whether a childless widget can safely be skipped for a mouse-move
+  // at (x, y) in its local coords given the previous pointer position
+  // (px, py): hover state can only change when the cursor is near the
+  // widget at one of the two points.
+  auto CanSkipMouseMove(Widget* w, float x, float y, float px, float py)
+      -> bool;
   void PrintExitListInstructions(millisecs_t old_last_prev_next_time);
   std::vector<Object::Ref<Widget> > widgets_;
   float width_{};
@@ -226,6 +237,10 @@ class ContainerWidget : public Widget {
   millisecs_t transition_start_time_{};
   float transition_target_offset_{};
   float drag_x_{}, drag_y_{};
+
+  // Pointer position as of our last mouse move/down; lets move events
+  // skip widgets the cursor is nowhere near (see CanSkipMouseMove).
+  float prev_pointer_x_{-99999.0f}, prev_pointer_y_{-99999.0f};
   float transition_offset_x_{};
   float transition_offset_x_vel_{};
   float transition_offset_x_smoothed_{};
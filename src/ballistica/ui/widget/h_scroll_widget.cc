@@ -594,6 +594,10 @@ void HScrollWidget::Draw(RenderPass* pass, bool draw_transparent) {
   set_simple_culling_left(l + border_width_);
   set_simple_culling_right(l + (width() - border_height_));
 
+  // Enables child culling against the window above (the value is extra
+  // margin). Big lists only pay for the columns actually on screen.
+  set_simple_culling_h(20.0f);
+
   // Draw all our widgets at our z level.
   DrawChildren(pass, draw_transparent, l + extra_offs_x, b + extra_offs_y,
                1.0f);
@@ -34,12 +34,38 @@ auto RowWidget::HandleMessage(const WidgetMessage& m) -> bool {
 void RowWidget::UpdateLayout() {
   BA_DEBUG_UI_READ_LOCK;
   float border = 2;
+
+  // Same memoization as ColumnWidget::UpdateLayout: if no child has
+  // changed size or moved since our last full layout, current
+  // translates are still correct.
+  bool unchanged = (widgets().size() == layout_records_.size());
+  if (unchanged) {
+    size_t n{};
+    for (const auto& i : widgets()) {
+      const LayoutRecord& r = layout_records_[n++];
+      if (&(*i) != r.widget || (*i).GetWidth() != r.extent
+          || (*i).tx() != r.tx) {
+        unchanged = false;
+        break;
+      }
+    }
+  }
+  if (unchanged) {
+    return;
+  }
+  layout_records_.resize(widgets().size());
+
   float b = border;
   float l = 0;
+  size_t n{};
   for (const auto& i : widgets()) {
     float ww = (*i).GetWidth();
     l += border;
     (*i).set_translate(l, b);
+    layout_records_[n].widget = &(*i);
+    layout_records_[n].extent = ww;
+    layout_records_[n].tx = l;
+    n++;
     l += ww + border;
   }
   set_width(l);
@@ -4,6 +4,7 @@
 #define BALLISTICA_UI_WIDGET_ROW_WIDGET_H_
 
 #include <string>
+#include <vector>
 
 #include "ballistica/ui/widget/container_widget.h"
 
@@ -19,6 +20,16 @@ class RowWidget : public ContainerWidget {
 
  protected:
   void UpdateLayout() override;
+
+ private:
+  // Per-child placement as of our last full layout; mirrors the
+  // memoization in ColumnWidget::UpdateLayout.
+  struct LayoutRecord {
+    Widget* widget{};
+    float extent{};
+    float tx{};
+  };
+  std::vector<LayoutRecord> layout_records_;
 };
 
 }  // namespace ballistica
@@ -666,6 +666,10 @@ void ScrollWidget::Draw(RenderPass* pass, bool draw_transparent) {
   set_simple_culling_bottom(b + border_height_ + 1);
   set_simple_culling_top(b + (height() - border_height_) - 1);
 
+  // Enables child culling against the window above (the value is extra
+  // margin). Big lists only pay for the rows actually on screen.
+  set_simple_culling_v(20.0f);
+
   // draw all our widgets at our z level
   DrawChildren(pass, draw_transparent, l + extra_offs_x, b + extra_offs_y,
                1.0f);
@@ -11,6 +11,7 @@
 #include "ballistica/generic/utils.h"
 #include "ballistica/graphics/component/empty_component.h"
 #include "ballistica/graphics/component/simple_component.h"
+#include "ballistica/graphics/component/template_component.h"
 #include "ballistica/graphics/graphics.h"
 #include "ballistica/graphics/renderer.h"
 #include "ballistica/graphics/text/text_graphics.h"
@@ -204,10 +205,16 @@ void TextWidget::Draw(RenderPass* pass, bool draw_transparent) {
         outline_center_y_ = b - b_border + outline_height_ * 0.5f;
         outline_dirty_ = false;
       }
-      SimpleComponent c(pass);
-      c.SetTransparent(true);
-      c.SetColor(1, 1, 1, 1);
-      c.SetTexture(g_media->GetTexture(SystemTextureID::kUIAtlas));
+      // Our config here never changes, so record it once and replay it;
+      // only the transform varies per frame.
+      if (!outline_template_.valid()) {
+        SimpleComponent c(pass);
+        c.SetTransparent(true);
+        c.SetColor(1, 1, 1, 1);
+        c.SetTexture(g_media->GetTexture(SystemTextureID::kUIAtlas));
+        c.RecordTemplate(&outline_template_);
+      }
+      TemplateComponent c(pass, outline_template_);
       c.PushTransform();
       c.Translate(outline_center_x_, outline_center_y_, 0.1f);
       c.Scale(outline_width_, outline_height_);
@@ -393,9 +400,18 @@ void TextWidget::Draw(RenderPass* pass, bool draw_transparent) {
         if (carat_position_ > str_size) {
           carat_position_ = str_size;
         }
-        float h, v;
-        text_group_->GetCaratPts(text_raw_, align_h, align_v, carat_position_,
-                                 &h, &v);
+        // The carat draws every frame while we're selected but only
+        // moves on edits; cache its computed position.
+        if (carat_position_ != carat_pts_cache_position_
+            || text_raw_ != carat_pts_cache_text_) {
+          text_group_->GetCaratPts(text_raw_, align_h, align_v,
+                                   carat_position_, &carat_pts_cache_x_,
+                                   &carat_pts_cache_y_);
+          carat_pts_cache_position_ = carat_position_;
+          carat_pts_cache_text_ = text_raw_;
+        }
+        float h = carat_pts_cache_x_;
+        float v = carat_pts_cache_y_;
         SimpleComponent c(pass);
         c.SetPremultiplied(true);
         c.SetTransparent(true);
@@ -600,7 +616,9 @@ auto TextWidget::HandleMessage(const WidgetMessage& m) -> bool {
   if (m.has_keysym && !ShouldUseStringEditDialog()) {
     last_carat_change_time_ = g_game->master_time();
 
-    text_group_dirty_ = true;
+    // Note: no need to dirty our text-group here; the cases below that
+    // actually modify text dirty the translation, which cascades to the
+    // group. Carat-only keys (arrows etc.) shouldn't touch the mesh.
     bool claimed = false;
     switch (m.keysym.sym) {
       case SDLK_UP:
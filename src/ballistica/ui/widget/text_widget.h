@@ -5,6 +5,7 @@
 
 #include <string>
 
+#include "ballistica/graphics/component/render_component_template.h"
 #include "ballistica/ui/widget/widget.h"
 
 namespace ballistica {
@@ -28,12 +29,14 @@ class TextWidget : public Widget {
   void set_halign(HAlign a) {
     if (alignment_h_ != a) {
       text_group_dirty_ = true;
+      carat_pts_cache_position_ = -1;
     }
     alignment_h_ = a;
   }
   void set_valign(VAlign a) {
     if (alignment_v_ != a) {
       text_group_dirty_ = true;
+      carat_pts_cache_position_ = -1;
     }
     alignment_v_ = a;
   }
@@ -114,6 +117,7 @@ class TextWidget : public Widget {
   float outline_height_{};
   float outline_center_x_{};
   float outline_center_y_{};
+  RenderComponentTemplate outline_template_;
   float text_width_{};
   float text_height_{};
   float rotate_{};
@@ -133,6 +137,13 @@ class TextWidget : public Widget {
   bool pressed_activate_{};
   bool always_highlight_{};
   int carat_position_{9999};
+
+  // Cached result of GetCaratPts; computing it walks the whole string
+  // and the carat draws every frame while we're selected.
+  int carat_pts_cache_position_{-1};
+  std::string carat_pts_cache_text_;
+  float carat_pts_cache_x_{};
+  float carat_pts_cache_y_{};
   bool editable_{};
   bool selectable_{};
   float width_{50.0f};
@@ -123,4 +123,5 @@ def get_binding_values() -> object:
         _player.Player,  # kPlayerClass
         _hooks.get_player_icon,  # kGetPlayerIconCall
         _language.Lstr.from_json,  # kLstrFromJsonCall
+        _hooks.client_connection_stats,  # kClientConnectionStatsCall
     )  # yapf: disable
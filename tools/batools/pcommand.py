@@ -142,6 +142,18 @@ def resize_image() -> None:
     efrotools.run(f'convert "{src}" -resize {width}x{height} "{dst}"')
 
 
+def make_ui_atlas() -> None:
+    """Bake a directory of loose ui pngs into one atlas texture.
+
+    args: src_dir, out_tex_png, out_meta_json
+    """
+    from efro.error import CleanError
+    import batools.uiatlas
+    if len(sys.argv) != 5:
+        raise CleanError('Expected 3 args (src_dir, out_tex, out_meta).')
+    batools.uiatlas.build_atlas(sys.argv[2], sys.argv[3], sys.argv[4])
+
+
 def check_clean_safety() -> None:
     """Ensure all files are are added to git or in gitignore.
 
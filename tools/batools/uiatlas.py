@@ -0,0 +1,145 @@
+# Released under the MIT License. See LICENSE for details.
+#
+"""Functionality for baking loose UI textures into a single atlas.
+
+Small interface textures (button backgrounds, icons, etc) are cheapest
+when they share one texture; each loose file otherwise costs its own
+texture bind during the overlay pass plus its own padded allocation.
+This module packs a directory of pngs into one power-of-two atlas and
+emits a json table mapping each source name to its pixel rect and uv
+coords within it.
+"""
+from __future__ import annotations
+
+import json
+import os
+import subprocess
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    from typing import Dict, List, Tuple
+
+# Pixels of clear space around each packed image; keeps bilinear
+# filtering (and lower mip levels) from bleeding neighbors together.
+DEFAULT_PADDING = 2
+
+
+def _image_size(path: str) -> Tuple[int, int]:
+    """Return (width, height) for an image via imagemagick."""
+    result = subprocess.run(['identify', '-format', '%w %h', path],
+                            capture_output=True,
+                            check=True)
+    width, height = result.stdout.decode().split()
+    return int(width), int(height)
+
+
+def _next_pow_2(val: int) -> int:
+    out = 1
+    while out < val:
+        out *= 2
+    return out
+
+
+def _shelf_pack(sizes: Dict[str, Tuple[int, int]], atlas_width: int,
+                padding: int) -> Tuple[Dict[str, Tuple[int, int]], int]:
+    """Place images onto shelves; return positions and used height.
+
+    Images are sorted tallest-first so shelves stay dense, with name as
+    a tiebreaker so repeat bakes of the same sources are byte-identical.
+    """
+    order = sorted(sizes, key=lambda name: (-sizes[name][1], name))
+    positions: Dict[str, Tuple[int, int]] = {}
+    shelf_x = padding
+    shelf_y = padding
+    shelf_height = 0
+    for name in order:
+        width, height = sizes[name]
+        if shelf_x + width + padding > atlas_width:
+            shelf_y += shelf_height + padding
+            shelf_x = padding
+            shelf_height = 0
+        positions[name] = (shelf_x, shelf_y)
+        shelf_x += width + padding
+        shelf_height = max(shelf_height, height)
+    return positions, shelf_y + shelf_height + padding
+
+
+def build_atlas(src_dir: str,
+                out_tex: str,
+                out_meta: str,
+                padding: int = DEFAULT_PADDING,
+                max_size: int = 2048) -> None:
+    """Pack all pngs under src_dir into out_tex plus a json uv table."""
+    from efro.error import CleanError
+
+    names = sorted(name for name in os.listdir(src_dir)
+                   if name.endswith('.png'))
+    if not names:
+        raise CleanError(f'No pngs found under "{src_dir}".')
+
+    sizes: Dict[str, Tuple[int, int]] = {}
+    for name in names:
+        width, height = _image_size(os.path.join(src_dir, name))
+        if width + 2 * padding > max_size or height + 2 * padding > max_size:
+            raise CleanError(f'"{name}" ({width}x{height}) is too large'
+                             f' to atlas at max size {max_size}.')
+        sizes[name] = (width, height)
+
+    # Try increasing power-of-two widths and take the first (ie: most
+    # square-ish from below) that fits within max size; wide shelves
+    # waste less than tall skinny ones.
+    atlas_width = 0
+    atlas_height = 0
+    used_height = 0
+    positions: Dict[str, Tuple[int, int]] = {}
+    width_try = _next_pow_2(max(size[0] for size in sizes.values())
+                            + 2 * padding)
+    while width_try <= max_size:
+        positions, used_height = _shelf_pack(sizes, width_try, padding)
+        if _next_pow_2(used_height) <= width_try * 2:
+            atlas_width = width_try
+            atlas_height = min(max_size, _next_pow_2(used_height))
+            break
+        width_try *= 2
+    if atlas_width == 0 or atlas_height < _next_pow_2(used_height):
+        raise CleanError(f'Images under "{src_dir}" do not fit in a'
+                         f' {max_size}x{max_size} atlas.')
+
+    # One big composite; imagemagick handles the actual pixel work
+    # (same as our resize_image snippet).
+    cmd: List[str] = [
+        'convert', '-size', f'{atlas_width}x{atlas_height}', 'xc:none'
+    ]
+    for name in names:
+        pos_x, pos_y = positions[name]
+        cmd += [
+            os.path.join(src_dir, name), '-geometry', f'+{pos_x}+{pos_y}',
+            '-composite'
+        ]
+    cmd.append(out_tex)
+    subprocess.run(cmd, check=True)
+
+    entries = {}
+    for name in names:
+        width, height = sizes[name]
+        pos_x, pos_y = positions[name]
+        entries[os.path.splitext(name)[0]] = {
+            'x': pos_x,
+            'y': pos_y,
+            'w': width,
+            'h': height,
+            'uv': [
+                pos_x / atlas_width, pos_y / atlas_height,
+                (pos_x + width) / atlas_width,
+                (pos_y + height) / atlas_height
+            ]
+        }
+    meta = {
+        'texture': os.path.basename(out_tex),
+        'size': [atlas_width, atlas_height],
+        'images': entries
+    }
+    with open(out_meta, 'w') as outfile:
+        json.dump(meta, outfile, indent=1, sort_keys=True)
+    print(f'Baked {len(names)} images into'
+          f' {atlas_width}x{atlas_height} atlas: {out_tex}')